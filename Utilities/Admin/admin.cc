@@ -52,6 +52,7 @@ static struct option longopts[] =
     { "getTimeChange", required_argument, 0, 't' },
     { "oinfo", required_argument, 0, 'p' },
     { "sinfo", required_argument, 0, 'j' },
+    { "latency", required_argument, 0, 'L' },
     { "apiRequest", required_argument, 0, 'a' },
     { "verbose", no_argument, 0, 'v' },
     { "quiet", no_argument, 0, 'q' },
@@ -120,6 +121,8 @@ static void usage()
     print_help(36, "-p|--oinfo id1@node1,id2@node2,id3,... [userparam]", "Получить информацию об объектах (SimpleInfo). \n");
     print_help(36, "", "userparam - необязательный параметр передаваемый в getInfo() каждому объекту\n");
     print_help(36, "-j|--sinfo id1@node1,id2@node2,id3,...", "Получить информацию о датчиках.\n");
+    print_help(36, "-L|--latency id1@node1,id2@node2,id3,... [reset]", "Статистика задержек прохождения изменений датчиков (--uniset-latency-trace).\n");
+    print_help(36, "", "reset - сбросить статистику после вывода\n");
     cout << endl;
     print_help(36, "-a|--apiRequest id1@node1,id2@node2,id3,... query", "Вызов REST API для каждого объекта\n");
     print_help(36, "", "query - Запрос вида: /api/VERSION/query[?param1&param2...]\n");
@@ -171,7 +174,7 @@ int main(int argc, char** argv)
 
         while(1)
         {
-            opt = getopt_long(argc, argv, "hk:beosfur:l:i::x:g:w:y:p:vqz:a:m:n:z:j:t:d:", longopts, &optindex);
+            opt = getopt_long(argc, argv, "hk:beosfur:l:i::x:g:w:y:p:vqz:a:m:n:z:j:t:d:L:", longopts, &optindex);
 
             if( opt == -1 )
                 break;
@@ -292,6 +295,21 @@ int main(int argc, char** argv)
                 }
                 break;
 
+                case 'L':  //--latency
+                {
+                    auto conf = uniset_init(argc, argv, conffile);
+                    UInterface ui(conf);
+                    ui.initBackId(uniset::AdminID);
+
+                    bool reset = false;
+
+                    if( checkArg(optind, argc, argv) )
+                        reset = ( string(argv[optind]) == "reset" );
+
+                    return oinfo(optarg, ui, reset ? "latency:reset" : "latency");
+                }
+                break;
+
                 case 'j':  //--sinfo
                 {
                     auto conf = uniset_init(argc, argv, conffile);
@@ -0,0 +1,418 @@
+// --------------------------------------------------------------------------
+#include <cmath>
+#include <chrono>
+#include <thread>
+#include <random>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+#include "Exceptions.h"
+#include "UInterface.h"
+#include "LoadGenerator.h"
+// --------------------------------------------------------------------------
+using namespace std;
+using namespace uniset;
+// --------------------------------------------------------------------------
+LatencyHistogram::LatencyHistogram():
+    buckets((64 - subBits + 1) * subCount, 0)
+{
+}
+// --------------------------------------------------------------------------
+size_t LatencyHistogram::index( uint64_t v ) noexcept
+{
+    if( v < subCount )
+        return v;
+
+    const size_t e = 63 - __builtin_clzll(v);
+    const uint64_t m = v >> (e - subBits); // [subCount, 2*subCount)
+    return (e - subBits + 1) * subCount + (m - subCount);
+}
+// --------------------------------------------------------------------------
+uint64_t LatencyHistogram::value( size_t idx ) noexcept
+{
+    if( idx < subCount )
+        return idx;
+
+    const size_t e = idx / subCount - 1 + subBits;
+    const uint64_t m = idx % subCount + subCount;
+    const uint64_t width = uint64_t(1) << (e - subBits);
+    return (m << (e - subBits)) + width / 2;
+}
+// --------------------------------------------------------------------------
+void LatencyHistogram::add( uint64_t usec ) noexcept
+{
+    buckets[index(usec)]++;
+    total++;
+    sum += usec;
+    vmin = std::min(vmin, usec);
+    vmax = std::max(vmax, usec);
+}
+// --------------------------------------------------------------------------
+void LatencyHistogram::merge( const LatencyHistogram& h ) noexcept
+{
+    for( size_t i = 0; i < buckets.size(); i++ )
+        buckets[i] += h.buckets[i];
+
+    total += h.total;
+    sum += h.sum;
+    vmin = std::min(vmin, h.vmin);
+    vmax = std::max(vmax, h.vmax);
+}
+// --------------------------------------------------------------------------
+uint64_t LatencyHistogram::percentile( double q ) const noexcept
+{
+    if( total == 0 )
+        return 0;
+
+    const uint64_t target = std::max<uint64_t>(1, (uint64_t)std::ceil(q * total));
+    uint64_t n = 0;
+
+    for( size_t i = 0; i < buckets.size(); i++ )
+    {
+        n += buckets[i];
+
+        if( n >= target )
+            return std::max(vmin, std::min(vmax, value(i)));
+    }
+
+    return vmax;
+}
+// --------------------------------------------------------------------------
+double LatencyHistogram::mean() const noexcept
+{
+    return total ? (double)sum / total : 0.0;
+}
+// --------------------------------------------------------------------------
+bool LoadGenerator::patternFromString( const std::string& s, Pattern& p )
+{
+    if( s == "saw" )
+        p = Pattern::Saw;
+    else if( s == "sin" )
+        p = Pattern::Sin;
+    else if( s == "random" )
+        p = Pattern::Random;
+    else if( s == "toggle" )
+        p = Pattern::Toggle;
+    else
+        return false;
+
+    return true;
+}
+// --------------------------------------------------------------------------
+std::string LoadGenerator::to_string( Pattern p )
+{
+    switch( p )
+    {
+        case Pattern::Saw:
+            return "saw";
+
+        case Pattern::Sin:
+            return "sin";
+
+        case Pattern::Random:
+            return "random";
+
+        case Pattern::Toggle:
+            return "toggle";
+    }
+
+    return "";
+}
+// --------------------------------------------------------------------------
+LoadGenerator::LoadGenerator( const std::shared_ptr<uniset::Configuration>& conf,
+                              const std::vector<IOController_i::SensorInfo>& sensors,
+                              const Params& p ):
+    conf(conf),
+    sensors(sensors),
+    prm(p)
+{
+    prm.threads = std::max<size_t>(1, std::min(prm.threads, sensors.size()));
+    prm.batch = std::max<size_t>(1, prm.batch);
+
+    if( prm.vmin > prm.vmax )
+        std::swap(prm.vmin, prm.vmax);
+
+    prm.vstep = std::max(1L, prm.vstep);
+}
+// --------------------------------------------------------------------------
+void LoadGenerator::stop() noexcept
+{
+    terminated = true;
+}
+// --------------------------------------------------------------------------
+long LoadGenerator::patternValue( const Params& p, Pattern pat, uint64_t round, size_t k ) noexcept
+{
+    const uint64_t span = (uint64_t)(p.vmax - p.vmin) + 1;
+
+    switch( pat )
+    {
+        case Pattern::Saw:
+            return p.vmin + (long)((round * (uint64_t)p.vstep + k) % span);
+
+        case Pattern::Sin:
+        {
+            const uint64_t period = std::max<uint64_t>(4, 2 * (span - 1) / (uint64_t)p.vstep);
+            const double ph = 2.0 * M_PI * (double)((round + k) % period) / (double)period;
+            const double mid = ((double)p.vmin + (double)p.vmax) / 2.0;
+            const double amp = ((double)p.vmax - (double)p.vmin) / 2.0;
+            return std::lround(mid + amp * std::sin(ph));
+        }
+
+        case Pattern::Toggle:
+            return ((round + k) % 2) ? p.vmax : p.vmin;
+
+        case Pattern::Random:
+            break;
+    }
+
+    return p.vmin;
+}
+// --------------------------------------------------------------------------
+void LoadGenerator::work( Worker* w, size_t tnum )
+{
+    UInterface ui(conf);
+    std::mt19937 gen(prm.seed + tnum);
+    std::uniform_int_distribution<long> rnd(prm.vmin, prm.vmax);
+
+    const size_t nitems = w->items.size();
+    const size_t batch = std::min(prm.batch, nitems);
+
+    // темп: каждый поток пишет свою долю от общей скорости
+    const double trate = (double)prm.rate / prm.threads;
+    const auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                              std::chrono::duration<double>( trate > 0 ? batch / trate : 0.0 ));
+
+    // если поток не успевает, "долг" больше этого не накапливаем (иначе потом будет всплеск)
+    const auto maxLag = std::chrono::milliseconds(100);
+
+    IOController_i::OutSeq seq;
+    std::vector<long> values(batch);
+    size_t pos = 0;
+    uint64_t round = 0;
+    auto next = std::chrono::steady_clock::now();
+
+    // расписание без учёта сброса "долга": задержка записи считается от него
+    // (иначе время, на которое поток отстал от темпа, в замеры не попадает)
+    auto planned = next;
+    auto sched = next;
+
+    while( !terminated )
+    {
+        if( trate > 0 )
+        {
+            auto now = std::chrono::steady_clock::now();
+
+            if( now < next )
+                std::this_thread::sleep_until(next);
+            else if( now - next > maxLag )
+                next = now;
+
+            next += interval;
+            sched = planned;
+            planned += interval;
+        }
+
+        // очередная пачка датчиков (по кругу)
+        const size_t beg = pos;
+
+        for( size_t i = 0; i < batch; i++ )
+        {
+            const size_t k = w->items[(beg + i) % nitems];
+            values[i] = ( prm.pattern == Pattern::Random ) ? rnd(gen) : patternValue(prm, prm.pattern, round, k);
+        }
+
+        pos += batch;
+
+        if( pos >= nitems )
+        {
+            pos -= nitems;
+            round++;
+        }
+
+        // пишем, разбивая пачку по узлам (один setOutputSeq на узел)
+        size_t i = 0;
+
+        while( i < batch )
+        {
+            const auto& first = sensors[w->items[(beg + i) % nitems]];
+            size_t n = 1;
+
+            if( prm.batch > 1 )
+            {
+                while( i + n < batch && sensors[w->items[(beg + i + n) % nitems]].node == first.node )
+                    n++;
+            }
+
+            const auto t0 = std::chrono::steady_clock::now();
+            uint64_t bad = 0;
+
+            try
+            {
+                if( prm.batch == 1 )
+                    ui.setValue(first, values[i], DefaultObjectId);
+                else
+                {
+                    seq.length(n);
+
+                    for( size_t j = 0; j < n; j++ )
+                    {
+                        seq[j].si = sensors[w->items[(beg + i + j) % nitems]];
+                        seq[j].value = values[i + j];
+                    }
+
+                    uniset::IDSeq_var badlist = ui.setOutputSeq(seq, DefaultObjectId);
+                    bad = badlist->length();
+                }
+            }
+            catch( const uniset::Exception& ex )
+            {
+                bad = n;
+
+                if( w->errors == 0 )
+                    cerr << endl << "(simitator): write error: " << ex << endl;
+            }
+            catch( const std::exception& ex )
+            {
+                bad = n;
+
+                if( w->errors == 0 )
+                    cerr << endl << "(simitator): write error: " << ex.what() << endl;
+            }
+
+            const auto t1 = std::chrono::steady_clock::now();
+            w->latency.add( std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count() );
+
+            if( trate > 0 )
+                w->delay.add( std::chrono::duration_cast<std::chrono::microseconds>(t1 - sched).count() );
+
+            w->calls++;
+            w->updates += n - bad;
+            w->errors += bad;
+            i += n;
+        }
+    }
+}
+// --------------------------------------------------------------------------
+LoadGenerator::Result LoadGenerator::run()
+{
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    for( size_t t = 0; t < prm.threads; t++ )
+        workers.emplace_back(new Worker());
+
+    // датчики распределяем между потоками по очереди
+    for( size_t k = 0; k < sensors.size(); k++ )
+        workers[k % prm.threads]->items.push_back(k);
+
+    terminated = false;
+    const auto tstart = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+
+    for( size_t t = 0; t < prm.threads; t++ )
+        threads.emplace_back(&LoadGenerator::work, this, workers[t].get(), t);
+
+    uint64_t lastUpdates = 0;
+    auto lastReport = tstart;
+    auto nextReport = tstart + std::chrono::seconds(prm.report);
+
+    while( !terminated )
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        const auto now = std::chrono::steady_clock::now();
+
+        if( prm.duration > 0 && now - tstart >= std::chrono::seconds(prm.duration) )
+            break;
+
+        if( prm.report > 0 && now >= nextReport )
+        {
+            uint64_t updates = 0;
+            uint64_t errors = 0;
+
+            for( const auto& w : workers )
+            {
+                updates += w->updates;
+                errors += w->errors;
+            }
+
+            const double dt = std::chrono::duration<double>(now - lastReport).count();
+            const double elapsed = std::chrono::duration<double>(now - tstart).count();
+
+            cout << "\r t=" << std::fixed << std::setprecision(0) << elapsed << "s"
+                 << " rate=" << (updates - lastUpdates) / dt << " upd/sec"
+                 << " total=" << updates << " errors=" << errors << "     " << flush;
+
+            lastUpdates = updates;
+            lastReport = now;
+            nextReport += std::chrono::seconds(prm.report);
+        }
+    }
+
+    terminated = true;
+
+    for( auto&& t : threads )
+        t.join();
+
+    Result r;
+    r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - tstart).count();
+
+    for( const auto& w : workers )
+    {
+        r.updates += w->updates;
+        r.calls += w->calls;
+        r.errors += w->errors;
+        r.latency.merge(w->latency);
+        r.delay.merge(w->delay);
+    }
+
+    if( prm.report > 0 )
+        cout << endl;
+
+    return r;
+}
+// --------------------------------------------------------------------------
+void LoadGenerator::printResult( std::ostream& os, const Params& p, size_t nsensors, const Result& r )
+{
+    const auto& h = r.latency;
+    const double sec = r.seconds > 0 ? r.seconds : 1.0;
+
+    os << endl << "------------------------------" << endl;
+    os << std::fixed << std::setprecision(1);
+    os << "  sensors: " << nsensors << " threads: " << p.threads << " batch: " << p.batch
+       << " pattern: " << to_string(p.pattern) << endl;
+    os << "  target rate: ";
+
+    if( p.rate > 0 )
+        os << p.rate << " upd/sec" << endl;
+    else
+        os << "max" << endl;
+
+    os << "  duration: " << r.seconds << " sec" << endl;
+    os << "  updates: " << r.updates << " (" << r.updates / sec << " upd/sec)" << endl;
+    os << "  calls: " << r.calls << " (" << r.calls / sec << " calls/sec)" << endl;
+    os << "  errors: " << r.errors << endl;
+    os << "  latency per call, usec:"
+       << " min=" << h.min()
+       << " avg=" << h.mean()
+       << " p50=" << h.percentile(0.5)
+       << " p90=" << h.percentile(0.9)
+       << " p99=" << h.percentile(0.99)
+       << " p99.9=" << h.percentile(0.999)
+       << " max=" << h.max() << endl;
+
+    if( p.rate > 0 )
+    {
+        const auto& d = r.delay;
+        os << "  delay from schedule, usec:"
+           << " min=" << d.min()
+           << " avg=" << d.mean()
+           << " p50=" << d.percentile(0.5)
+           << " p90=" << d.percentile(0.9)
+           << " p99=" << d.percentile(0.99)
+           << " p99.9=" << d.percentile(0.999)
+           << " max=" << d.max() << endl;
+    }
+
+    os << "------------------------------" << endl;
+}
+// --------------------------------------------------------------------------
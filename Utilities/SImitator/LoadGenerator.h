@@ -0,0 +1,150 @@
+// --------------------------------------------------------------------------
+#ifndef LoadGenerator_H_
+#define LoadGenerator_H_
+// --------------------------------------------------------------------------
+#include <string>
+#include <ostream>
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include "Configuration.h"
+#include "IOController_i.hh"
+// --------------------------------------------------------------------------
+/*! Гистограмма времени вызовов (мкс).
+ * Логарифмическая шкала: 32 интервала на каждую степень двойки (погрешность ~3%),
+ * поэтому память не зависит от количества замеров (можно работать сколь угодно долго).
+ */
+class LatencyHistogram
+{
+    public:
+        LatencyHistogram();
+
+        void add( uint64_t usec ) noexcept;
+        void merge( const LatencyHistogram& h ) noexcept;
+
+        //! q = 0..1
+        uint64_t percentile( double q ) const noexcept;
+
+        inline uint64_t count() const noexcept
+        {
+            return total;
+        }
+        inline uint64_t min() const noexcept
+        {
+            return total ? vmin : 0;
+        }
+        inline uint64_t max() const noexcept
+        {
+            return vmax;
+        }
+        double mean() const noexcept;
+
+    private:
+        static const size_t subBits = 5;
+        static const size_t subCount = 1 << subBits;
+
+        static size_t index( uint64_t v ) noexcept;
+        static uint64_t value( size_t idx ) noexcept;
+
+        std::vector<uint64_t> buckets;
+        uint64_t total = { 0 };
+        uint64_t sum = { 0 };
+        uint64_t vmin = { UINT64_MAX };
+        uint64_t vmax = { 0 };
+};
+// --------------------------------------------------------------------------
+/*! Генератор нагрузки на SharedMemory (режим --load у uniset2-simitator).
+ *
+ * Датчики делятся между потоками записи (каждый со своим UInterface).
+ * Каждый поток записывает значения пачками (setOutputSeq, по --batch датчиков за вызов,
+ * отдельно для каждого узла) с заданной суммарной скоростью (обновлений в секунду)
+ * и замеряет время каждого вызова. По окончании выводится достигнутая скорость
+ * и распределение времени вызовов (перцентили).
+ *
+ * При заданной скорости дополнительно замеряется задержка от момента, когда пачка должна была
+ * быть записана по расписанию, до окончания вызова. Если SM не успевает, время вызова
+ * выглядит нормальным (поток просто реже пишет), а задержка от расписания растёт
+ * (т.е. учитывается и время ожидания "отставших" записей).
+ *
+ * Значения задаются шаблоном (Pattern) в пределах [vmin, vmax]. Шаблон зависит только
+ * от номера датчика и номера прохода по датчикам (для random - от seed),
+ * поэтому последовательность записей воспроизводима.
+ */
+class LoadGenerator
+{
+    public:
+
+        enum class Pattern
+        {
+            Saw,    /*!< пила: vmin..vmax с шагом step (у каждого датчика свой сдвиг) */
+            Sin,    /*!< синусоида */
+            Random, /*!< случайные значения */
+            Toggle  /*!< попеременно vmin/vmax */
+        };
+
+        //! \return false если шаблон неизвестен
+        static bool patternFromString( const std::string& s, Pattern& p );
+        static std::string to_string( Pattern p );
+
+        struct Params
+        {
+            size_t rate = { 1000 };    /*!< суммарная скорость, обновлений в секунду (0 - максимально возможная) */
+            size_t threads = { 1 };    /*!< количество потоков записи */
+            size_t batch = { 100 };    /*!< датчиков в одном вызове (1 - setValue() по одному) */
+            size_t duration = { 10 };  /*!< длительность, сек (0 - до остановки) */
+            size_t report = { 1 };     /*!< период вывода текущей скорости, сек (0 - не выводить) */
+            Pattern pattern = { Pattern::Saw };
+            long vmin = { 0 };
+            long vmax = { 100 };
+            long vstep = { 1 };
+            unsigned int seed = { 1 };
+        };
+
+        struct Result
+        {
+            double seconds = { 0.0 };
+            uint64_t updates = { 0 };  /*!< успешно записано значений */
+            uint64_t calls = { 0 };
+            uint64_t errors = { 0 };   /*!< значений, которые не удалось записать */
+            LatencyHistogram latency;  /*!< время одного вызова, мкс */
+            LatencyHistogram delay;    /*!< от запланированного момента записи до окончания вызова, мкс (только при rate > 0) */
+        };
+
+        LoadGenerator( const std::shared_ptr<uniset::Configuration>& conf,
+                       const std::vector<IOController_i::SensorInfo>& sensors,
+                       const Params& p );
+
+        //! запустить и ждать окончания (duration или stop())
+        Result run();
+
+        //! остановить (можно вызывать из обработчика сигнала)
+        void stop() noexcept;
+
+        //! значение датчика k на проходе round (для Pattern::Random не используется)
+        static long patternValue( const Params& p, Pattern pat, uint64_t round, size_t k ) noexcept;
+
+        static void printResult( std::ostream& os, const Params& p, size_t nsensors, const Result& r );
+
+    private:
+
+        struct Worker
+        {
+            std::vector<size_t> items; /*!< индексы датчиков этого потока */
+            std::atomic<uint64_t> updates = { 0 };
+            std::atomic<uint64_t> calls = { 0 };
+            std::atomic<uint64_t> errors = { 0 };
+            LatencyHistogram latency;
+            LatencyHistogram delay;
+        };
+
+        void work( Worker* w, size_t tnum );
+
+        std::shared_ptr<uniset::Configuration> conf;
+        std::vector<IOController_i::SensorInfo> sensors;
+        Params prm;
+        std::atomic<bool> terminated = { false };
+};
+// --------------------------------------------------------------------------
+#endif // LoadGenerator_H_
+// --------------------------------------------------------------------------
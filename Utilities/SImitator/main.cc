@@ -2,8 +2,11 @@
 #include <cmath>
 #include <random>
 #include <functional>
+#include <algorithm>
+#include <csignal>
 #include "Exceptions.h"
 #include "UInterface.h"
+#include "LoadGenerator.h"
 // -----------------------------------------------------------------------------
 using namespace std;
 using namespace uniset;
@@ -24,6 +27,15 @@ void help_print()
     cout << "--step val              - Шаг датчика. По умолчанию 1" << endl;
     cout << "--pause msec            - Пауза. По умолчанию 200 мсек" << endl << endl;
     cout << "--func [cos|sin|random] - Функция модификации значения. По умолчания не используется." << endl << endl;
+    cout << "Режим генератора нагрузки:" << endl;
+    cout << "--load                  - Писать датчики с заданной скоростью и вывести статистику (--pause и --func не используются)" << endl;
+    cout << "--rate num              - Суммарная скорость, обновлений в секунду. 0 - максимально возможная. По умолчанию 1000" << endl;
+    cout << "--threads num           - Количество потоков записи. По умолчанию 1" << endl;
+    cout << "--batch num             - Датчиков в одном вызове (setOutputSeq). 1 - писать по одному (setValue). По умолчанию 100" << endl;
+    cout << "--pattern [saw|sin|random|toggle] - Шаблон значений в пределах [min,max]. По умолчанию saw" << endl;
+    cout << "--duration sec          - Длительность теста. 0 - до остановки (Ctrl+C). По умолчанию 10 сек" << endl;
+    cout << "--report sec            - Период вывода текущей скорости. 0 - не выводить. По умолчанию 1 сек" << endl;
+    cout << "--seed num              - Начальное значение для --pattern random. По умолчанию 1" << endl << endl;
     cout << uniset::Configuration::help() << endl;
 }
 // -----------------------------------------------------------------------------
@@ -45,6 +57,59 @@ long mf_cos( long v )
 {
     return v * cos(v);
 }
+// -----------------------------------------------------------------------------
+static std::shared_ptr<LoadGenerator> lgen;
+
+static void terminate_load( int signo )
+{
+    if( lgen )
+        lgen->stop();
+}
+// -----------------------------------------------------------------------------
+static int run_load( const std::shared_ptr<uniset::Configuration>& conf, const std::list<ExtInfo>& sensors,
+                     long amin, long amax, long astep )
+{
+    LoadGenerator::Params prm;
+    prm.vmin = amin;
+    prm.vmax = amax;
+    prm.vstep = astep;
+    prm.rate = std::max(0, conf->getArgPInt("--rate", 1000));
+    prm.threads = std::max(0, conf->getArgPInt("--threads", 1));
+    prm.batch = std::max(0, conf->getArgPInt("--batch", 100));
+    prm.duration = std::max(0, conf->getArgPInt("--duration", 10));
+    prm.report = std::max(0, conf->getArgPInt("--report", 1));
+    prm.seed = std::max(0, conf->getArgPInt("--seed", 1));
+
+    const string pname = conf->getArg2Param("--pattern", "saw");
+
+    if( !LoadGenerator::patternFromString(pname, prm.pattern) )
+    {
+        cerr << "Unknown pattern '" << pname << "'. Must be [saw,sin,random,toggle]" << endl;
+        return 1;
+    }
+
+    std::vector<IOController_i::SensorInfo> slist;
+    slist.reserve(sensors.size());
+
+    for( const auto& it : sensors )
+        slist.push_back(it.si);
+
+    lgen = std::make_shared<LoadGenerator>(conf, slist, prm);
+
+    std::signal(SIGINT, terminate_load);
+    std::signal(SIGTERM, terminate_load);
+
+    cout << endl << "------------------------------" << endl;
+    cout << " load: " << slist.size() << " sensors, rate=" << prm.rate
+         << " threads=" << prm.threads << " batch=" << prm.batch
+         << " pattern=" << pname << " [" << amin << ".." << amax << "]"
+         << " duration=" << prm.duration << endl;
+    cout << "------------------------------" << endl << endl;
+
+    auto res = lgen->run();
+    LoadGenerator::printResult(cout, prm, slist.size(), res);
+    return ( res.errors > 0 ) ? 1 : 0;
+}
 
 // -----------------------------------------------------------------------------
 int main( int argc, char** argv )
@@ -189,6 +254,9 @@ int main( int argc, char** argv )
             return 1;
         }
 
+        if( findArgParam("--load", conf->getArgc(), conf->getArgv()) != -1 )
+            return run_load(conf, sensors, amin, amax, astep);
+
         int amsec = conf->getArgInt("--pause", "200");
 
         if(amsec <= 10)
@@ -133,25 +133,16 @@ void <xsl:value-of select="$CLASSNAME"/>_SK::callback() noexcept
 // -----------------------------------------------------------------------------
 void <xsl:value-of select="$CLASSNAME"/>_SK::preSensorInfo( const uniset::SensorMessage* _sm )
 {
-	<xsl:for-each select="//sensors/item/consumers/consumer">
-	<xsl:if test="normalize-space(../../@msg)!='1'">
-	<xsl:if test="normalize-space(@name)=$OID">	
-	<xsl:if test="normalize-space(@vartype)='in'">
-    <xsl:if test="normalize-space(@loglevel)=''">
-	if( _sm->id == <xsl:value-of select="../../@name"/> )
-		priv_<xsl:call-template name="setprefix"/><xsl:value-of select="../../@name"/> = _sm->value;
-    </xsl:if>
-    <xsl:if test="normalize-space(@loglevel)!=''">
-	if( _sm->id == <xsl:value-of select="../../@name"/> )
+	for( const auto&amp; _s : sensorIndex.find(_sm->id) )
 	{
-		priv_<xsl:call-template name="setprefix"/><xsl:value-of select="../../@name"/> = _sm->value;
-        mylog->level( Debug::type(_sm->value) );
-    }
-    </xsl:if>
-	</xsl:if>
-	</xsl:if>
-	</xsl:if>
-	</xsl:for-each>
+		if( !_s.in )
+			continue;
+
+		*_s.in = _sm->value;
+
+		if( _s.loglevel )
+			mylog->level( Debug::type(_sm->value) );
+	}
 
 	sensorInfo(_sm);
 }
@@ -209,29 +200,17 @@ void <xsl:value-of select="$CLASSNAME"/>_SK::preAskSensors( UniversalIO::UIOComm
 		mycrit &lt;&lt; myname
 			&lt;&lt; "(preAskSensors): ************* don`t activated?! ************" &lt;&lt; endl;
 
-	while( !canceled )
-	{
-		try
-		{
-		<xsl:for-each select="//sensors/item/consumers/consumer">
-		<xsl:if test="normalize-space(@name)=$OID">
-		<xsl:if test="normalize-space(@vartype)='in'">
-			ui->askRemoteSensor(<xsl:value-of select="../../@name"/>,_cmd,node_<xsl:value-of select="../../@name"/>, getId());
-		</xsl:if>
-		</xsl:if>
-		</xsl:for-each>
-			return;
-		}
-		catch( const uniset::Exception&amp; ex )
-		{
-            mycrit &lt;&lt; myname &lt;&lt; "(preAskSensors): " &lt;&lt; ex &lt;&lt; endl;
-		}
-    	catch( const std::exception&amp;ex )
-	    {
-	    mycrit &lt;&lt; myname &lt;&lt; "(execute): catch " &lt;&lt; ex.what()  &lt;&lt;   endl;
-	    }
-    	msleep(askPause);
-	}
+	// заказываем датчики списками (по узлам)
+	AskMap _lst;
+	<xsl:for-each select="//sensors/item/consumers/consumer">
+	<xsl:if test="normalize-space(@name)=$OID">
+	<xsl:if test="normalize-space(@vartype)='in'">
+	_lst[node_<xsl:value-of select="../../@name"/>].add(<xsl:value-of select="../../@name"/>);
+	</xsl:if>
+	</xsl:if>
+	</xsl:for-each>
+
+	askSensorsByNode(_lst, _cmd);
 }
 // -----------------------------------------------------------------------------
 void <xsl:value-of select="$CLASSNAME"/>_SK::setValue( uniset::ObjectId _sid, long _val )
@@ -269,17 +248,10 @@ long <xsl:value-of select="$CLASSNAME"/>_SK::getValue( uniset::ObjectId _sid )
 {
 	try
 	{
-	<xsl:for-each select="//sensors/item/consumers/consumer">
-	<xsl:if test="normalize-space(@name)=$OID">
-	<xsl:if test="normalize-space(../../@msg)!='1'">
-		if( _sid == <xsl:value-of select="../../@name"/> )
-		{
-		<xsl:if test="normalize-space(@vartype)='in'">/*		<xsl:text>		</xsl:text>priv_<xsl:call-template name="setprefix"/><xsl:value-of select="../../@name"/> = ui->getValue(<xsl:value-of select="../../@name"/>); */</xsl:if>
-			return <xsl:call-template name="setprefix"/><xsl:value-of select="../../@name"/>;
-		}
-	</xsl:if>
-	</xsl:if>
-	</xsl:for-each>
+		auto _s = sensorIndex.get(_sid);
+
+		if( _s )
+			return *_s->value;
 
 		return ui->getValue(_sid);
 	}
@@ -301,8 +273,10 @@ void <xsl:value-of select="$CLASSNAME"/>_SK::updateOutputs( bool _force )
 	if( _force || prev_<xsl:call-template name="setprefix"/><xsl:value-of select="../../@name"/> != <xsl:call-template name="setprefix"/><xsl:value-of select="../../@name"/> )
 	</xsl:if>
 	{
-		<xsl:call-template name="setdata"/>
-		prev_<xsl:call-template name="setprefix"/><xsl:value-of select="../../@name"/> = <xsl:call-template name="setprefix"/><xsl:value-of select="../../@name"/>;
+		if( <xsl:value-of select="../../@name"/> != DefaultObjectId ) // -V547
+			addOutput(<xsl:value-of select="../../@name"/>, node_<xsl:value-of select="../../@name"/>, <xsl:call-template name="setprefix"/><xsl:value-of select="../../@name"/>, &amp;prev_<xsl:call-template name="setprefix"/><xsl:value-of select="../../@name"/>);
+		else
+			prev_<xsl:call-template name="setprefix"/><xsl:value-of select="../../@name"/> = <xsl:call-template name="setprefix"/><xsl:value-of select="../../@name"/>;
 	}
 	</xsl:when>
 	</xsl:choose>
@@ -310,6 +284,9 @@ void <xsl:value-of select="$CLASSNAME"/>_SK::updateOutputs( bool _force )
 	</xsl:if>
 </xsl:for-each>
 
+	// изменившиеся выходы пишутся одним вызовом (на каждый узел)
+	flushOutputs();
+
 <xsl:for-each select="//sensors/item/consumers/consumer">
 <xsl:if test="normalize-space(@name)=$OID">
 <xsl:if test="normalize-space(../../@msg)='1'">
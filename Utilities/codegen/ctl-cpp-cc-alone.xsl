@@ -81,13 +81,7 @@ void <xsl:value-of select="$CLASSNAME"/>_SK::callback() noexept
 		}
 
 		// обработка сообщений (таймеров и т.п.)
-		for( unsigned int i=0; i&lt;<xsl:call-template name="settings-alone"><xsl:with-param name="varname" select="'msg-count'"/></xsl:call-template>; i++ )
-		{
-			auto m = receiveMessage();
-			if( !m )
-				break;
-			processingMessage(m.get());
-		}
+		processMessages(<xsl:call-template name="settings-alone"><xsl:with-param name="varname" select="'msg-count'"/></xsl:call-template>);
 
 		// Проверка изменения состояния датчиков
 		checkSensors();
@@ -219,14 +213,10 @@ void <xsl:value-of select="$CLASSNAME"/>_SK::setValue( uniset::ObjectId _sid, lo
 // -----------------------------------------------------------------------------
 long <xsl:value-of select="$CLASSNAME"/>_SK::getValue( uniset::ObjectId _sid )
 {
-	<xsl:for-each select="//sensors/item/consumers/consumer">
-	<xsl:if test="normalize-space(../../@msg)!='1'">
-	<xsl:if test="normalize-space(@name)=$OID">
-	if( _sid == <xsl:value-of select="../../@name"/> )
-		return <xsl:call-template name="setprefix"/><xsl:value-of select="../../@name"/>;
-	</xsl:if>
-	</xsl:if>
-	</xsl:for-each>
+	auto _s = sensorIndex.get(_sid);
+
+	if( _s )
+		return *_s->value;
 
 	return ui->getValue(_sid);
 }
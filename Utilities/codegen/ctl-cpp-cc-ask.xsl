@@ -160,12 +160,17 @@ void <xsl:value-of select="$CLASSNAME"/>_SK::updateOutputs( bool _force )
 	if( _force || prev_<xsl:call-template name="setprefix"/><xsl:value-of select="@name"/> != <xsl:call-template name="setprefix"/><xsl:value-of select="@name"/> )
 	</xsl:if>
 	{
-		<xsl:call-template name="setdata"/>
-		prev_<xsl:call-template name="setprefix"/><xsl:value-of select="@name"/> = <xsl:call-template name="setprefix"/><xsl:value-of select="@name"/>;
+		if( <xsl:value-of select="@name"/> != DefaultObjectId ) // -V547
+			addOutput(<xsl:value-of select="@name"/>, node_<xsl:value-of select="@name"/>, <xsl:call-template name="setprefix"/><xsl:value-of select="@name"/>, &amp;prev_<xsl:call-template name="setprefix"/><xsl:value-of select="@name"/>);
+		else
+			prev_<xsl:call-template name="setprefix"/><xsl:value-of select="@name"/> = <xsl:call-template name="setprefix"/><xsl:value-of select="@name"/>;
 	}
 	</xsl:if>
 	</xsl:for-each>
 
+	// изменившиеся выходы пишутся одним вызовом (на каждый узел)
+	flushOutputs();
+
 <!--
 // update messages
 <xsl:for-each select="//msgmap/item">
@@ -201,22 +206,17 @@ void <xsl:value-of select="$CLASSNAME"/>_SK::initFromSM()
 // -----------------------------------------------------------------------------
 void <xsl:value-of select="$CLASSNAME"/>_SK::preSensorInfo( const uniset::SensorMessage* _sm )
 {
-	<xsl:for-each select="//smap/item">
-	<xsl:if test="normalize-space(@vartype)='in'">
-	<xsl:if test="normalize-space(@loglevel)=''">
-	if( _sm->id == <xsl:value-of select="@name"/> )
-		priv_<xsl:call-template name="setprefix"/><xsl:value-of select="@name"/> = _sm->value;
-	</xsl:if>
-	<xsl:if test="normalize-space(@loglevel)!=''">
-	if( _sm->id == <xsl:value-of select="@name"/> )
+	for( const auto&amp; _s : sensorIndex.find(_sm->id) )
 	{
-		priv_<xsl:call-template name="setprefix"/><xsl:value-of select="@name"/> = _sm->value;
-		mylog->level( Debug::type(_sm->value) );
+		if( !_s.in )
+			continue;
+
+		*_s.in = _sm->value;
+
+		if( _s.loglevel )
+			mylog->level( Debug::type(_sm->value) );
 	}
-	</xsl:if>
-	</xsl:if>
-	</xsl:for-each>
-	
+
 	sensorInfo(_sm);
 }
 // -----------------------------------------------------------------------------
@@ -229,13 +229,13 @@ long <xsl:value-of select="$CLASSNAME"/>_SK::getValue( uniset::ObjectId _sid )
 {
 	try
 	{
-<xsl:for-each select="//smap/item">
-		if( _sid == <xsl:value-of select="@name"/> &amp;&amp; <xsl:value-of select="@name"/> != DefaultObjectId )
+		if( _sid != DefaultObjectId )
 		{
-		<xsl:if test="normalize-space(@vartype)='in'">/* <xsl:text>		</xsl:text>priv_<xsl:call-template name="setprefix"/><xsl:value-of select="@name"/> = ui->getValue(<xsl:value-of select="@name"/>, node_<xsl:value-of select="@name"/>); */</xsl:if>
-			return <xsl:call-template name="setprefix"/><xsl:value-of select="@name"/>;
+			auto _s = sensorIndex.get(_sid);
+
+			if( _s )
+				return *_s->value;
 		}
-</xsl:for-each>
 
 		return ui->getValue(_sid);
 	}
@@ -262,29 +262,16 @@ void <xsl:value-of select="$CLASSNAME"/>_SK::preAskSensors( UniversalIO::UIOComm
 		mycrit &lt;&lt; myname
 			&lt;&lt; "(preAskSensors): ************* don`t activated?! ************" &lt;&lt; endl;
 
-	while( !canceled )
-	{
-		try
-		{
-		<xsl:for-each select="//smap/item">
-		<xsl:if test="normalize-space(@vartype)='in'">
-			if( <xsl:value-of select="@name"/> != DefaultObjectId )
-				ui->askRemoteSensor(<xsl:value-of select="@name"/>,_cmd,node_<xsl:value-of select="@name"/>,getId());
-		</xsl:if> 
-		</xsl:for-each>
-			return;
-		}
-		catch( const uniset::Exception&amp; ex )
-		{
-            mycrit &lt;&lt; myname &lt;&lt; "(preAskSensors): " &lt;&lt; ex &lt;&lt; endl;
-		}
-	    catch( const std::exception&amp;ex )
-    	{
-		mycrit &lt;&lt; myname &lt;&lt; "(execute): catch " &lt;&lt; ex.what()  &lt;&lt;   endl;
-	    }
+	// заказываем датчики списками (по узлам)
+	AskMap _lst;
+	<xsl:for-each select="//smap/item">
+	<xsl:if test="normalize-space(@vartype)='in'">
+	if( <xsl:value-of select="@name"/> != DefaultObjectId )
+		_lst[node_<xsl:value-of select="@name"/>].add(<xsl:value-of select="@name"/>);
+	</xsl:if>
+	</xsl:for-each>
 
-		msleep(askPause);
-	}
+	askSensorsByNode(_lst, _cmd);
 }
 // -----------------------------------------------------------------------------
 <!-- END CC-FILE -->
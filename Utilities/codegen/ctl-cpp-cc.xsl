@@ -84,13 +84,7 @@ void <xsl:value-of select="$CLASSNAME"/>_SK::callback() noexept
 		}
 
 		// обработка сообщений (таймеров и т.п.)
-		for( unsigned int i=0; i&lt;<xsl:call-template name="settings"><xsl:with-param name="varname" select="'msg-count'"/></xsl:call-template>; i++ )
-		{
-			auto m = receiveMessage();
-			if( !m )
-				break;
-			processingMessage(m.get());
-		}
+		processMessages(<xsl:call-template name="settings"><xsl:with-param name="varname" select="'msg-count'"/></xsl:call-template>);
 
 		// Выполнение шага программы
 		step();
@@ -196,10 +190,10 @@ void <xsl:value-of select="$CLASSNAME"/>_SK::askSensor( uniset::ObjectId sid, Un
 // -----------------------------------------------------------------------------
 long <xsl:value-of select="$CLASSNAME"/>_SK::getValue( uniset::ObjectId _sid )
 {
-	<xsl:for-each select="//smap/item">
-	if( _sid == <xsl:value-of select="@name"/> )
-		return <xsl:call-template name="setprefix"/><xsl:value-of select="@name"/>;
-	</xsl:for-each>
+	auto _s = sensorIndex.get(_sid);
+
+	if( _s )
+		return *_s->value;
 
 	return ui->getValue(_sid);
 }
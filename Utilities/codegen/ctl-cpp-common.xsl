@@ -383,6 +383,39 @@
 		void preSensorInfo( const uniset::SensorMessage* sm );
 		void preTimerInfo( const uniset::TimerMessage* tm );
 		// --------------------------------------------
+		struct SensorSlot
+		{
+			long* in;			/*!&lt; priv_in_ переменная (только для входов) */
+			const long* value;	/*!&lt; переменная хранящая значение (in_, out_) */
+			bool loglevel;		/*!&lt; вход задаёт уровень логов (loglevel="1") */
+		};
+
+		/*! быстрый поиск переменных по id датчика (см. preSensorInfo(), getValue()), строится в конструкторе */
+		uniset::IdLookupTable&lt;SensorSlot&gt; sensorIndex;
+
+		// --------------------------------------------
+		// пакетная запись выходов и заказ датчиков
+		struct OutputItem
+		{
+			uniset::ObjectId id;
+			uniset::ObjectId node;
+			long value;
+			long* prev;	/*!&lt; prev_ переменная (обновляется после успешной записи) */
+		};
+
+		std::vector&lt;OutputItem&gt; outBatch; /*!&lt; выходы, изменившиеся на текущем шаге */
+
+		void addOutput( uniset::ObjectId _sid, uniset::ObjectId _node, long _val, long* _prev );
+		void flushOutputs(); /*!&lt; запись накопленных выходов (один вызов setOutputSeq на каждый узел) */
+
+		typedef std::unordered_map&lt;uniset::ObjectId, uniset::IDList&gt; AskMap; /*!&lt; node -&gt; список датчиков */
+		void askSensorsByNode( AskMap&amp; _lst, UniversalIO::UIOCommand _cmd );
+
+		uniset::timeout_t askTime = { 0 }; /*!&lt; время заказа датчиков (последнего), мсек */
+		size_t askCalls = { 0 };	/*!&lt; количество вызовов askRemoteSensorsSeq при заказе */
+		size_t outWrites = { 0 };	/*!&lt; количество выходов, записанных на последнем шаге */
+		size_t outCalls = { 0 };	/*!&lt; количество вызовов setOutputSeq на последнем шаге */
+		size_t outErrors = { 0 };	/*!&lt; количество ошибок записи выходов (всего) */
 		<xsl:if test="normalize-space($VARMAP)='1'">
 		class PtrMapHashFn
 		{
@@ -459,6 +492,9 @@ void <xsl:value-of select="$CLASSNAME"/>_SK::processingMessage( const uniset::Vo
 				smStat[sm->id] += 1;
 				</xsl:if>
 				preSensorInfo(sm);
+
+				if( sm->trace_tm &amp;&amp; sm->node == uniset::LatencyTrace::localNode() )
+					uniset::LatencyTrace::hop(uniset::LatencyTrace::Handled, sm->trace_tm);
 			}
 			break;
 
@@ -634,6 +670,9 @@ uniset::SimpleInfo* <xsl:value-of select="$CLASSNAME"/>_SK::getInfo( const char*
 	inf &lt;&lt; dumpIO() &lt;&lt; endl;
 	inf &lt;&lt; endl;
 </xsl:if>
+	inf &lt;&lt; "exchange: askTime=" &lt;&lt; askTime &lt;&lt; " msec askCalls=" &lt;&lt; askCalls
+		&lt;&lt; " outputWrites=" &lt;&lt; outWrites &lt;&lt; " outputCalls=" &lt;&lt; outCalls
+		&lt;&lt; " outputErrors=" &lt;&lt; outErrors &lt;&lt; endl;
 	auto timers = getTimersList();
 	inf &lt;&lt; "Timers[" &lt;&lt; timers.size() &lt;&lt; "]:" &lt;&lt; endl;
 	for( const auto&amp; t: timers )
@@ -697,6 +736,13 @@ Poco::JSON::Object::Ptr <xsl:value-of select="$CLASSNAME"/>_SK::httpRequest( con
 		for( const auto&amp; v: vlist )
 			jvmon->set(v.first,v.second);
 
+		auto jexch = uniset::json::make_child(jdata,"Exchange");
+		jexch->set("askTime_msec", askTime);
+		jexch->set("askCalls", askCalls);
+		jexch->set("outputWrites", outWrites);
+		jexch->set("outputCalls", outCalls);
+		jexch->set("outputErrors", outErrors);
+
 		<xsl:if test="normalize-space($STAT)='1'">
 		auto jstat = uniset::json::make_child(jdata,"Statistics");
 		jstat->set("processingMessageCatchCount", processingMessageCatchCount);
@@ -1009,6 +1055,162 @@ bool <xsl:value-of select="$CLASSNAME"/>_SK::waitSM( int wait_msec, ObjectId _te
 	return true;
 }
 // ----------------------------------------------------------------------------
+void <xsl:value-of select="$CLASSNAME"/>_SK::addOutput( uniset::ObjectId _sid, uniset::ObjectId _node, long _val, long* _prev )
+{
+	outBatch.push_back({ _sid, _node, _val, _prev });
+}
+// ----------------------------------------------------------------------------
+void <xsl:value-of select="$CLASSNAME"/>_SK::flushOutputs()
+{
+	outWrites = 0;
+	outCalls = 0;
+
+	if( outBatch.empty() )
+		return;
+
+	// группируем по узлам (порядок выходов внутри узла сохраняется)
+	std::stable_sort(outBatch.begin(), outBatch.end(), []( const OutputItem&amp; a, const OutputItem&amp; b )
+	{
+		return a.node &lt; b.node;
+	});
+
+	std::exception_ptr _err;
+	size_t _beg = 0;
+
+	while( _beg &lt; outBatch.size() )
+	{
+		size_t _end = _beg + 1;
+
+		while( _end &lt; outBatch.size() &amp;&amp; outBatch[_end].node == outBatch[_beg].node )
+			_end++;
+
+		IOController_i::OutSeq _seq;
+		_seq.length(_end - _beg);
+
+		for( size_t i = _beg; i &lt; _end; i++ )
+		{
+			_seq[i - _beg].si.id = outBatch[i].id;
+			_seq[i - _beg].si.node = outBatch[i].node;
+			_seq[i - _beg].value = outBatch[i].value;
+		}
+
+		try
+		{
+			outCalls++;
+			uniset::IDSeq_var _bad = ui->setOutputSeq(_seq, getId());
+
+			for( size_t i = _beg; i &lt; _end; i++ )
+			{
+				bool _ok = true;
+
+				for( size_t k = 0; k &lt; _bad-&gt;length(); k++ )
+				{
+					if( _bad[k] == outBatch[i].id )
+					{
+						_ok = false;
+						break;
+					}
+				}
+
+				if( _ok )
+				{
+					*outBatch[i].prev = outBatch[i].value;
+					outWrites++;
+					continue;
+				}
+
+				// prev_ не обновляем, запись повторится на следующем шаге
+				outErrors++;
+				mycrit &lt;&lt; myname &lt;&lt; "(updateOutputs): write '" &lt;&lt; uniset_conf()-&gt;oind-&gt;getShortName(outBatch[i].id)
+					   &lt;&lt; "' (node=" &lt;&lt; outBatch[i].node &lt;&lt; ") failed" &lt;&lt; endl;
+			}
+		}
+		catch( const uniset::Exception&amp; ex )
+		{
+			for( size_t i = _beg; i &lt; _end; i++ )
+			{
+				outErrors++;
+				mycrit &lt;&lt; myname &lt;&lt; "(updateOutputs): write '" &lt;&lt; uniset_conf()-&gt;oind-&gt;getShortName(outBatch[i].id)
+					   &lt;&lt; "' (node=" &lt;&lt; outBatch[i].node &lt;&lt; "): " &lt;&lt; ex &lt;&lt; endl;
+			}
+
+			if( !_err )
+				_err = std::current_exception();
+		}
+
+		_beg = _end;
+	}
+
+	outBatch.clear();
+
+	// как и раньше (при поштучной записи) ошибка прерывает текущий шаг
+	if( _err )
+		std::rethrow_exception(_err);
+}
+// ----------------------------------------------------------------------------
+void <xsl:value-of select="$CLASSNAME"/>_SK::askSensorsByNode( AskMap&amp; _lst, UniversalIO::UIOCommand _cmd )
+{
+	PassiveTimer _ptAsk;
+	askCalls = 0;
+
+	while( !canceled )
+	{
+		for( auto it = _lst.begin(); it != _lst.end(); )
+		{
+			if( it-&gt;second.empty() )
+			{
+				it = _lst.erase(it);
+				continue;
+			}
+
+			try
+			{
+				askCalls++;
+				uniset::IDSeq_var _bad = ui-&gt;askRemoteSensorsSeq(it-&gt;second, _cmd, it-&gt;first, getId());
+
+				if( _bad-&gt;length() == 0 )
+				{
+					it = _lst.erase(it);
+					continue;
+				}
+
+				// повторять будем только для тех, кого не удалось заказать
+				uniset::IDList _rest;
+				_rest.node = it-&gt;first;
+
+				for( size_t k = 0; k &lt; _bad-&gt;length(); k++ )
+				{
+					mycrit &lt;&lt; myname &lt;&lt; "(preAskSensors): ask '" &lt;&lt; uniset_conf()-&gt;oind-&gt;getShortName(_bad[k])
+						   &lt;&lt; "' (node=" &lt;&lt; it-&gt;first &lt;&lt; ") failed" &lt;&lt; endl;
+					_rest.add(_bad[k]);
+				}
+
+				it-&gt;second = _rest;
+			}
+			catch( const uniset::Exception&amp; ex )
+			{
+				for( const auto&amp; _id : it-&gt;second.ref() )
+					mycrit &lt;&lt; myname &lt;&lt; "(preAskSensors): ask '" &lt;&lt; uniset_conf()-&gt;oind-&gt;getShortName(_id)
+						   &lt;&lt; "' (node=" &lt;&lt; it-&gt;first &lt;&lt; "): " &lt;&lt; ex &lt;&lt; endl;
+			}
+			catch( const std::exception&amp; ex )
+			{
+				mycrit &lt;&lt; myname &lt;&lt; "(preAskSensors): node=" &lt;&lt; it-&gt;first &lt;&lt; " catch " &lt;&lt; ex.what() &lt;&lt; endl;
+			}
+
+			++it;
+		}
+
+		if( _lst.empty() )
+			break;
+
+		msleep(askPause);
+	}
+
+	askTime = _ptAsk.getCurrent();
+	myinfo &lt;&lt; myname &lt;&lt; "(preAskSensors): ask time " &lt;&lt; askTime &lt;&lt; " msec, calls: " &lt;&lt; askCalls &lt;&lt; endl;
+}
+// ----------------------------------------------------------------------------
 std::string <xsl:value-of select="$CLASSNAME"/>_SK::help() const noexcept
 {
 	ostringstream s;
@@ -1043,6 +1245,16 @@ std::string <xsl:value-of select="$CLASSNAME"/>_SK::help() const noexcept
 // ----------------------------------------------------------------------------
 </xsl:template>
 
+<xsl:template name="add-sensor-slot">
+<xsl:param name="varname" select="@name"/>
+<xsl:choose>
+	<xsl:when test="normalize-space(@vartype)='in'">
+	sensorIndex.add(<xsl:value-of select="normalize-space($varname)"/>, { &amp;priv_in_<xsl:value-of select="$varname"/>, &amp;priv_in_<xsl:value-of select="$varname"/>, <xsl:if test="normalize-space(@loglevel)!=''">true</xsl:if><xsl:if test="normalize-space(@loglevel)=''">false</xsl:if> });</xsl:when>
+	<xsl:when test="normalize-space(@vartype)!='io'">
+	sensorIndex.add(<xsl:value-of select="normalize-space($varname)"/>, { nullptr, &amp;<xsl:call-template name="setprefix"/><xsl:value-of select="$varname"/>, false });</xsl:when>
+</xsl:choose>
+</xsl:template>
+
 <xsl:template name="COMMON-ID-LIST">
 <xsl:if test="normalize-space($SIMPLEPROC)=''">
 	if( uniset::findArgParam("--print-id-list",uniset_conf()->getArgc(),uniset_conf()->getArgv()) != -1 )
@@ -1127,6 +1339,7 @@ std::string <xsl:value-of select="$CLASSNAME"/>_SK::help() const noexcept
 #include <xsl:call-template name="preinclude"/>LogServer.h<xsl:call-template name="postinclude"/>
 #include <xsl:call-template name="preinclude"/>DebugStream.h<xsl:call-template name="postinclude"/>
 #include <xsl:call-template name="preinclude"/>LogAgregator.h<xsl:call-template name="postinclude"/>
+#include <xsl:call-template name="preinclude"/>LatencyTrace.h<xsl:call-template name="postinclude"/>
 #include "<xsl:value-of select="$SK_H_FILENAME"/>"
 
 // -----------------------------------------------------------------------------
@@ -1334,6 +1547,12 @@ end_private(false)
 
 </xsl:for-each>
 
+	// таблица для быстрого поиска переменных по id датчика
+<xsl:for-each select="//smap/item">
+	<xsl:call-template name="add-sensor-slot"/>
+</xsl:for-each>
+	sensorIndex.build();
+
 <xsl:for-each select="//msgmap/item">
 	if( <xsl:value-of select="normalize-space(@name)"/> == uniset::DefaultObjectId )
 	{
@@ -1892,6 +2111,16 @@ askPause(uniset_conf()->getPIntProp(cnode,"askPause",2000))
 	</xsl:call-template>
 </xsl:for-each>
 
+	// таблица для быстрого поиска переменных по id датчика
+<xsl:for-each select="//sensors/item/consumers/consumer">
+	<xsl:if test="normalize-space(../../@msg)!='1'">
+	<xsl:if test="normalize-space(@name)=$OID">
+	<xsl:call-template name="add-sensor-slot"><xsl:with-param name="varname" select="../../@name"/></xsl:call-template>
+	</xsl:if>
+	</xsl:if>
+</xsl:for-each>
+	sensorIndex.build();
+
 	UniXML::iterator it(cnode);
 
 	// ------- init logserver ---
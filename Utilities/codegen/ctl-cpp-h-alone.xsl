@@ -52,6 +52,7 @@
 #include <xsl:call-template name="preinclude"/>DebugStream.h<xsl:call-template name="postinclude"/>
 #include <xsl:call-template name="preinclude"/>LogAgregator.h<xsl:call-template name="postinclude"/>
 #include <xsl:call-template name="preinclude"/>VMonitor.h<xsl:call-template name="postinclude"/>
+#include <xsl:call-template name="preinclude"/>IdLookupTable.h<xsl:call-template name="postinclude"/>
 // -----------------------------------------------------------------------------
 class <xsl:value-of select="$CLASSNAME"/>_SK:
 <xsl:choose>
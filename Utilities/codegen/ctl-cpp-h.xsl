@@ -51,6 +51,7 @@
 #include <xsl:call-template name="preinclude"/>LogServer.h<xsl:call-template name="postinclude"/>
 #include <xsl:call-template name="preinclude"/>LogAgregator.h<xsl:call-template name="postinclude"/>
 #include <xsl:call-template name="preinclude"/>VMonitor.h<xsl:call-template name="postinclude"/>
+#include <xsl:call-template name="preinclude"/>IdLookupTable.h<xsl:call-template name="postinclude"/>
 // -----------------------------------------------------------------------------
 class <xsl:value-of select="$CLASSNAME"/>_SK:
 <xsl:choose>
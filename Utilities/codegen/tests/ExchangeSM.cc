@@ -0,0 +1,126 @@
+#include <memory>
+#include "Configuration.h"
+#include "IOConfig_XML.h"
+#include "ExchangeSM.h"
+// --------------------------------------------------------------------------------
+using namespace uniset;
+using namespace std;
+// --------------------------------------------------------------------------------
+ExchangeSM::ExchangeSM( ObjectId id, const std::string& datfile ):
+    IONotifyController(id)
+{
+    auto r = make_shared<IOConfig_XML>(datfile, uniset_conf());
+    restorer = std::static_pointer_cast<IOConfig>(r);
+}
+// --------------------------------------------------------------------------------
+ExchangeSM::~ExchangeSM()
+{
+}
+// --------------------------------------------------------------------------------
+IDSeq* ExchangeSM::setOutputSeq( const IOController_i::OutSeq& lst, ObjectId sup_id )
+{
+    IOController_i::OutSeq accepted;
+    IDList badlist;
+    Call call;
+
+    {
+        std::lock_guard<std::mutex> l(mut);
+
+        for( size_t i = 0; i < lst.length(); i++ )
+        {
+            call.push_back(lst[i].si.id);
+
+            auto it = rejectOut.find(lst[i].si.id);
+
+            if( it != rejectOut.end() && it->second )
+            {
+                badlist.add(lst[i].si.id);
+                continue;
+            }
+
+            const size_t k = accepted.length();
+            accepted.length(k + 1);
+            accepted[k] = lst[i];
+        }
+
+        outCalls.push_back(call);
+    }
+
+    IDSeq_var bad = IONotifyController::setOutputSeq(accepted, sup_id);
+
+    for( size_t i = 0; i < bad->length(); i++ )
+        badlist.add(bad[i]);
+
+    return badlist.getIDSeq();
+}
+// --------------------------------------------------------------------------------
+IDSeq* ExchangeSM::askSensorsSeq( const uniset::IDSeq& lst,
+                                  const uniset::ConsumerInfo& ci, UniversalIO::UIOCommand cmd )
+{
+    uniset::IDSeq accepted;
+    IDList badlist;
+    Call call;
+
+    {
+        std::lock_guard<std::mutex> l(mut);
+
+        for( size_t i = 0; i < lst.length(); i++ )
+        {
+            call.push_back(lst[i]);
+
+            auto it = rejectAskNum.find(lst[i]);
+
+            if( it != rejectAskNum.end() && it->second > 0 )
+            {
+                it->second--;
+                badlist.add(lst[i]);
+                continue;
+            }
+
+            const size_t k = accepted.length();
+            accepted.length(k + 1);
+            accepted[k] = lst[i];
+        }
+
+        askCalls.push_back(call);
+    }
+
+    IDSeq_var bad = IONotifyController::askSensorsSeq(accepted, ci, cmd);
+
+    for( size_t i = 0; i < bad->length(); i++ )
+        badlist.add(bad[i]);
+
+    return badlist.getIDSeq();
+}
+// --------------------------------------------------------------------------------
+void ExchangeSM::rejectOutput( ObjectId sid, bool reject )
+{
+    std::lock_guard<std::mutex> l(mut);
+    rejectOut[sid] = reject;
+}
+// --------------------------------------------------------------------------------
+void ExchangeSM::rejectAsk( ObjectId sid, size_t num )
+{
+    std::lock_guard<std::mutex> l(mut);
+    rejectAskNum[sid] = num;
+}
+// --------------------------------------------------------------------------------
+std::vector<ExchangeSM::Call> ExchangeSM::getOutputCalls()
+{
+    std::lock_guard<std::mutex> l(mut);
+    return outCalls;
+}
+// --------------------------------------------------------------------------------
+std::vector<ExchangeSM::Call> ExchangeSM::getAskCalls()
+{
+    std::lock_guard<std::mutex> l(mut);
+    return askCalls;
+}
+// --------------------------------------------------------------------------------
+void ExchangeSM::clearCalls()
+{
+    std::lock_guard<std::mutex> l(mut);
+    outCalls.clear();
+    askCalls.clear();
+}
+// --------------------------------------------------------------------------------
@@ -0,0 +1,51 @@
+// --------------------------------------------------------------------------
+#ifndef ExchangeSM_H_
+#define ExchangeSM_H_
+// --------------------------------------------------------------------------
+#include <string>
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+#include "IONotifyController.h"
+// --------------------------------------------------------------------------
+/*! "SM" для проверки пакетного обмена процесса, созданного uniset2-codegen.
+ * Запоминает списки датчиков в каждом вызове setOutputSeq/askSensorsSeq
+ * и умеет отклонять запись (заказ) заданных датчиков.
+ */
+class ExchangeSM:
+    public uniset::IONotifyController
+{
+    public:
+        ExchangeSM( uniset::ObjectId id, const std::string& datfile );
+        virtual ~ExchangeSM();
+
+        virtual uniset::IDSeq* setOutputSeq( const IOController_i::OutSeq& lst, uniset::ObjectId sup_id ) override;
+
+        virtual uniset::IDSeq* askSensorsSeq( const uniset::IDSeq& lst,
+                                              const uniset::ConsumerInfo& ci, UniversalIO::UIOCommand cmd ) override;
+
+        typedef std::vector<uniset::ObjectId> Call; /*!< датчики одного вызова */
+
+        //! отклонять запись датчика (пока не вызван с reject=false)
+        void rejectOutput( uniset::ObjectId sid, bool reject = true );
+
+        //! отклонить заказ датчика num раз
+        void rejectAsk( uniset::ObjectId sid, size_t num );
+
+        std::vector<Call> getOutputCalls();
+        std::vector<Call> getAskCalls();
+        void clearCalls();
+
+    protected:
+        virtual void logging( uniset::SensorMessage& sm ) override {};
+
+    private:
+        std::mutex mut;
+        std::unordered_map<uniset::ObjectId, bool> rejectOut;
+        std::unordered_map<uniset::ObjectId, size_t> rejectAskNum;
+        std::vector<Call> outCalls;
+        std::vector<Call> askCalls;
+};
+// --------------------------------------------------------------------------
+#endif // ExchangeSM_H_
+// --------------------------------------------------------------------------
@@ -0,0 +1,47 @@
+// -----------------------------------------------------------------------------
+#include <sstream>
+#include "TestExchange.h"
+// -----------------------------------------------------------------------------
+using namespace std;
+using namespace uniset;
+// -----------------------------------------------------------------------------
+TestExchange::TestExchange( uniset::ObjectId id, xmlNode* confnode ):
+    TestGenExchange_SK(id, confnode)
+{
+}
+// -----------------------------------------------------------------------------
+TestExchange::~TestExchange()
+{
+}
+// -----------------------------------------------------------------------------
+void TestExchange::setOutputs( long v1, long v2 )
+{
+    out_out1_c = v1;
+    out_out2_c = v2;
+}
+// -----------------------------------------------------------------------------
+void TestExchange::writeOutputs( bool force )
+{
+    updateOutputs(force);
+}
+// -----------------------------------------------------------------------------
+void TestExchange::askInputs()
+{
+    preAskSensors(UniversalIO::UIONotify);
+}
+// -----------------------------------------------------------------------------
+std::string TestExchange::exchangeInfo()
+{
+    SimpleInfo_var i = getInfo("");
+    istringstream inf(string(i->info));
+    string line;
+
+    while( getline(inf, line) )
+    {
+        if( line.find("exchange:") == 0 )
+            return line;
+    }
+
+    return "";
+}
+// -----------------------------------------------------------------------------
@@ -0,0 +1,32 @@
+// -----------------------------------------------------------------------------
+#ifndef TestExchange_H_
+#define TestExchange_H_
+// -----------------------------------------------------------------------------
+#include <string>
+#include "TestGenExchange_SK.h"
+// -----------------------------------------------------------------------------
+/*! Процесс, созданный uniset2-codegen (см. testgen-exchange.src.xml).
+ * Не активируется: шаги обмена (запись выходов, заказ датчиков)
+ * вызываются из теста напрямую.
+ */
+class TestExchange:
+    public TestGenExchange_SK
+{
+    public:
+        TestExchange( uniset::ObjectId id, xmlNode* confnode );
+        virtual ~TestExchange();
+
+        void setOutputs( long v1, long v2 );
+
+        //! запись изменившихся (force=true - всех) выходов, как в конце шага процесса
+        void writeOutputs( bool force = false );
+
+        //! заказ датчиков (как при запуске процесса)
+        void askInputs();
+
+        //! строка "exchange: ..." из getInfo()
+        std::string exchangeInfo();
+};
+// -----------------------------------------------------------------------------
+#endif // TestExchange_H_
+// -----------------------------------------------------------------------------
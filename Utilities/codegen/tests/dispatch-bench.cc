@@ -0,0 +1,138 @@
+// -----------------------------------------------------------------------------
+// Проверка скорости обработки SensorMessage (preSensorInfo) в процессе,
+// созданном uniset2-codegen, с большим количеством входов (см. gen-dispatch-test.sh).
+// Для сравнения измеряется и поиск последовательным перебором всех входов
+// (так работал код, генерировавшийся раньше: цепочка "if( _sm->id == X )").
+// -----------------------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <vector>
+#include "Configuration.h"
+#include "TestGenDispatch_SK.h"
+// -----------------------------------------------------------------------------
+using namespace std;
+using namespace uniset;
+// -----------------------------------------------------------------------------
+class DispatchBench:
+    public TestGenDispatch_SK
+{
+    public:
+        DispatchBench( ObjectId id, xmlNode* cnode ):
+            TestGenDispatch_SK(id, cnode)
+        {
+            // входы процесса (для последовательного перебора)
+            auto conf = uniset_conf();
+            UniXML::iterator it(cnode);
+
+            for( size_t i = 1; ; i++ )
+            {
+                const string prop = "in" + std::to_string(i) + "_s";
+                const string sname = it.getProp(prop);
+
+                if( sname.empty() )
+                    break;
+
+                inputs.emplace_back(conf->getSensorID(sname), 0);
+            }
+        }
+
+        virtual ~DispatchBench() {}
+
+        size_t countInputs() const noexcept
+        {
+            return inputs.size();
+        }
+
+        // обработка сообщений кодом, созданным uniset2-codegen
+        double runGenerated( const std::vector<SensorMessage>& msgs, size_t repeat )
+        {
+            auto t0 = std::chrono::steady_clock::now();
+
+            for( size_t r = 0; r < repeat; r++ )
+            {
+                for( const auto& m : msgs )
+                    processingMessage( reinterpret_cast<const VoidMessage*>(&m) );
+            }
+
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        }
+
+        // последовательный перебор (как в старом коде)
+        double runLinear( const std::vector<SensorMessage>& msgs, size_t repeat )
+        {
+            auto t0 = std::chrono::steady_clock::now();
+
+            for( size_t r = 0; r < repeat; r++ )
+            {
+                for( const auto& m : msgs )
+                {
+                    for( auto&& in : inputs )
+                    {
+                        if( m.id == in.first )
+                            in.second = m.value;
+                    }
+
+                    sensorInfo(&m);
+                }
+            }
+
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        }
+
+    protected:
+        virtual void step() override {}
+        virtual void sensorInfo( const SensorMessage* sm ) override {}
+
+    private:
+        std::vector<std::pair<ObjectId, long>> inputs;
+};
+// -----------------------------------------------------------------------------
+int main( int argc, const char** argv )
+{
+    try
+    {
+        auto conf = uniset_init(argc, argv, "dispatch-configure.xml");
+
+        const size_t count = std::max(conf->getArgPInt("--count", 100000), 1);
+        const size_t repeat = std::max(conf->getArgPInt("--repeat", 20), 1);
+
+        auto obj = make_shared<DispatchBench>(conf->getObjectID("TestGenDispatch"), conf->getNode("TestGenDispatch"));
+
+        // сообщения по входам процесса и ~10% по "чужим" датчикам
+        // (id входов идут подряд, см. gen-dispatch-test.sh)
+        const ObjectId foreign = conf->getSensorID("Foreign_S");
+        const ObjectId first = conf->getSensorID("In1_S");
+        std::mt19937 gen(1);
+        std::vector<SensorMessage> msgs;
+        msgs.reserve(count);
+
+        for( size_t i = 0; i < count; i++ )
+        {
+            const size_t k = gen() % (obj->countInputs() + obj->countInputs() / 10 + 1);
+            const ObjectId sid = ( k < obj->countInputs() ) ? first + k : foreign;
+            msgs.emplace_back(sid, (long)gen());
+        }
+
+        const double tlin = obj->runLinear(msgs, repeat);
+        const double tgen = obj->runGenerated(msgs, repeat);
+        const double total = (double)count * repeat;
+
+        cout << "inputs: " << obj->countInputs() << " messages: " << total << endl;
+        cout << setw(12) << std::left << "linear" << ": " << (total / tlin) << " msg/sec" << endl;
+        cout << setw(12) << std::left << "codegen" << ": " << (total / tgen) << " msg/sec" << endl;
+        return 0;
+    }
+    catch( const uniset::Exception& ex )
+    {
+        cerr << "(dispatch-bench): " << ex << endl;
+    }
+    catch( const std::exception& ex )
+    {
+        cerr << "(dispatch-bench): " << ex.what() << endl;
+    }
+
+    return 1;
+}
+// -----------------------------------------------------------------------------
@@ -0,0 +1,91 @@
+#!/bin/sh
+# Генерирование исходного файла (testgen-dispatch.src.xml) и конфигурации (dispatch-configure.xml)
+# для проверки скорости обработки SensorMessage в коде, созданном uniset2-codegen
+# (процесс с большим количеством входов).
+# Использование: gen-dispatch-test.sh [количество входов]
+
+N=${1:-1000}
+SRC=testgen-dispatch.src.xml
+CONF=dispatch-configure.xml
+
+# --- src.xml для uniset2-codegen
+{
+	echo '<?xml version="1.0" encoding="utf-8"?>'
+	echo '<TestDispatch>'
+	echo '  <settings>'
+	echo '    <set name="class-name" val="TestGenDispatch"/>'
+	echo '    <set name="msg-count" val="100"/>'
+	echo '    <set name="sleep-msec" val="150"/>'
+	echo '  </settings>'
+	echo '  <variables/>'
+	echo '  <smap>'
+	i=1
+	while [ $i -le $N ]; do
+		echo "    <item name=\"in${i}_s\" vartype=\"in\" comment=\"input ${i}\"/>"
+		i=$((i+1))
+	done
+	echo '    <item name="out1_c" vartype="out" comment="output 1"/>'
+	echo '  </smap>'
+	echo '  <msgmap/>'
+	echo '</TestDispatch>'
+} > $SRC
+
+# --- конфигурация
+{
+	echo '<?xml version="1.0" encoding="utf-8"?>'
+	echo '<UNISETPLC>'
+	echo '  <UserData/>'
+	echo '  <UniSet>'
+	echo '    <NameService host="localhost" port="2809"/>'
+	echo '    <LocalNode name="localhost"/>'
+	echo '    <RootSection name="UNISET_DISPATCH"/>'
+	echo '    <CountOfNet name="1"/>'
+	echo '    <RepeatCount name="3"/>'
+	echo '    <RepeatTimeoutMS name="50"/>'
+	echo '    <WatchDogTime name="0"/>'
+	echo '    <PingNodeTime name="0"/>'
+	echo '    <AutoStartUpTime name="1"/>'
+	echo '    <DumpStateTime name="10"/>'
+	echo '    <SleepTickMS name="500"/>'
+	echo '    <UniSetDebug levels="" name="ulog"/>'
+	echo '    <ConfDir name="./"/>'
+	echo '    <DataDir name="./"/>'
+	echo '    <BinDir name="./"/>'
+	echo '    <LogDir name="./"/>'
+	echo '    <DocDir name="./"/>'
+	echo '    <LockDir name="./"/>'
+	echo '    <Services/>'
+	echo '  </UniSet>'
+	echo '  <dlog name="dlog"/>'
+	echo '  <settings>'
+	printf '    <TestGenDispatch name="TestGenDispatch" out1_c="Out1_C"'
+	i=1
+	while [ $i -le $N ]; do
+		printf ' in%d_s="In%d_S"' $i $i
+		i=$((i+1))
+	done
+	echo '/>'
+	echo '  </settings>'
+	echo '  <ObjectsMap idfromfile="1">'
+	echo '    <nodes port="2809">'
+	echo '      <item id="3000" ip="127.0.0.1" name="localhost" textname="Локальный узел"/>'
+	echo '    </nodes>'
+	echo '    <sensors name="Sensors">'
+	i=1
+	while [ $i -le $N ]; do
+		echo "      <item id=\"$((i+1000))\" iotype=\"AI\" name=\"In${i}_S\" textname=\"In${i}\"/>"
+		i=$((i+1))
+	done
+	echo "      <item id=\"$((N+1001))\" iotype=\"AO\" name=\"Out1_C\" textname=\"Out1\"/>"
+	echo "      <item id=\"$((N+1002))\" iotype=\"AI\" name=\"Foreign_S\" textname=\"not used by process\"/>"
+	echo '    </sensors>'
+	echo '    <thresholds name="thresholds"/>'
+	echo '    <controllers name="Controllers"/>'
+	echo '    <services name="Services"/>'
+	echo '    <objects name="UniObjects">'
+	echo '      <item id="6000" name="TestGenDispatch"/>'
+	echo '    </objects>'
+	echo '  </ObjectsMap>'
+	echo '  <messages idfromfile="1" name="messages"/>'
+	echo '</UNISETPLC>'
+} > $CONF
@@ -0,0 +1,163 @@
+#include <catch.hpp>
+// -----------------------------------------------------------------------------
+#include <memory>
+#include <string>
+#include "UniSetTypes.h"
+#include "UInterface.h"
+#include "ExchangeSM.h"
+#include "TestExchange.h"
+// -----------------------------------------------------------------------------
+using namespace std;
+using namespace uniset;
+// -----------------------------------------------------------------------------
+// Пакетный обмен процесса, созданного uniset2-codegen:
+// flushOutputs() (запись выходов) и askSensorsByNode() (заказ датчиков)
+// -----------------------------------------------------------------------------
+static shared_ptr<UInterface> ui;
+extern shared_ptr<ExchangeSM> sm;
+extern shared_ptr<TestExchange> obj;
+
+static ObjectId in1 = DefaultObjectId;
+static ObjectId in2 = DefaultObjectId;
+static ObjectId in3 = DefaultObjectId;
+static ObjectId out1 = DefaultObjectId;
+static ObjectId out2 = DefaultObjectId;
+// -----------------------------------------------------------------------------
+static void InitTest()
+{
+    auto conf = uniset_conf();
+    REQUIRE( conf != nullptr );
+    REQUIRE( sm != nullptr );
+    REQUIRE( obj != nullptr );
+
+    if( !ui )
+    {
+        ui = make_shared<UInterface>(obj->getId());
+        in1 = conf->getSensorID("In1_S");
+        in2 = conf->getSensorID("In2_S");
+        in3 = conf->getSensorID("In3_S");
+        out1 = conf->getSensorID("Out1_C");
+        out2 = conf->getSensorID("Out2_C");
+    }
+
+    REQUIRE( in1 != DefaultObjectId );
+    REQUIRE( in2 != DefaultObjectId );
+    REQUIRE( in3 != DefaultObjectId );
+    REQUIRE( out1 != DefaultObjectId );
+    REQUIRE( out2 != DefaultObjectId );
+}
+// -----------------------------------------------------------------------------
+// значение счётчика из строки "exchange: askTime=.. msec askCalls=.. outputWrites=.. ..."
+static long counter( const std::string& info, const std::string& name )
+{
+    const string key = " " + name + "=";
+    auto pos = info.find(key);
+
+    if( pos == string::npos )
+        return -1;
+
+    return uni_atoi(info.substr(pos + key.size()));
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("[codegen]: outputs (setOutputSeq)", "[codegen][exchange][outputs]")
+{
+    InitTest();
+
+    // начальное состояние (prev_ = текущим значениям)
+    obj->setOutputs(0, 0);
+    REQUIRE_NOTHROW( obj->writeOutputs(true) );
+
+    sm->clearCalls();
+    sm->rejectOutput(out2);
+
+    const long errors = counter(obj->exchangeInfo(), "outputErrors");
+    REQUIRE( errors >= 0 );
+
+    // оба выхода одним вызовом, Out2_C отклонён
+    obj->setOutputs(10, 20);
+    REQUIRE_NOTHROW( obj->writeOutputs() );
+
+    auto calls = sm->getOutputCalls();
+    REQUIRE( calls.size() == 1 );
+    CHECK( calls[0] == ExchangeSM::Call({ out1, out2 }) );
+    CHECK( ui->getValue(out1) == 10 );
+    CHECK( ui->getValue(out2) != 20 );
+
+    string info = obj->exchangeInfo();
+    CHECK( counter(info, "outputCalls") == 1 );
+    CHECK( counter(info, "outputWrites") == 1 );
+    CHECK( counter(info, "outputErrors") == errors + 1 );
+
+    // значения не менялись: prev_ для Out2_C не обновлялся, поэтому запись повторяется,
+    // а записанный Out1_C повторно не пишется
+    REQUIRE_NOTHROW( obj->writeOutputs() );
+    calls = sm->getOutputCalls();
+    REQUIRE( calls.size() == 2 );
+    CHECK( calls[1] == ExchangeSM::Call({ out2 }) );
+    CHECK( counter(obj->exchangeInfo(), "outputErrors") == errors + 2 );
+
+    // запись разрешили
+    sm->rejectOutput(out2, false);
+    REQUIRE_NOTHROW( obj->writeOutputs() );
+    calls = sm->getOutputCalls();
+    REQUIRE( calls.size() == 3 );
+    CHECK( calls[2] == ExchangeSM::Call({ out2 }) );
+    CHECK( ui->getValue(out2) == 20 );
+
+    info = obj->exchangeInfo();
+    CHECK( counter(info, "outputCalls") == 1 );
+    CHECK( counter(info, "outputWrites") == 1 );
+    CHECK( counter(info, "outputErrors") == errors + 2 );
+
+    // изменений нет - вызовов нет
+    REQUIRE_NOTHROW( obj->writeOutputs() );
+    CHECK( sm->getOutputCalls().size() == 3 );
+
+    info = obj->exchangeInfo();
+    CHECK( counter(info, "outputCalls") == 0 );
+    CHECK( counter(info, "outputWrites") == 0 );
+
+    // изменился только Out1_C
+    obj->setOutputs(11, 20);
+    REQUIRE_NOTHROW( obj->writeOutputs() );
+    calls = sm->getOutputCalls();
+    REQUIRE( calls.size() == 4 );
+    CHECK( calls[3] == ExchangeSM::Call({ out1 }) );
+    CHECK( ui->getValue(out1) == 11 );
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("[codegen]: ask sensors (askRemoteSensorsSeq)", "[codegen][exchange][ask]")
+{
+    InitTest();
+
+    sm->clearCalls();
+
+    // все датчики заказаны с первого раза
+    REQUIRE_NOTHROW( obj->askInputs() );
+
+    auto calls = sm->getAskCalls();
+    REQUIRE( calls.size() == 1 );
+    CHECK( calls[0] == ExchangeSM::Call({ in1, in2, in3 }) );
+    CHECK( counter(obj->exchangeInfo(), "askCalls") == 1 );
+
+    // In2_S не заказывается один раз, In3_S - два:
+    // повторяются только они (одним вызовом на узел), остальные повторно не заказываются
+    sm->clearCalls();
+    sm->rejectAsk(in2, 1);
+    sm->rejectAsk(in3, 2);
+
+    REQUIRE_NOTHROW( obj->askInputs() );
+
+    calls = sm->getAskCalls();
+    REQUIRE( calls.size() == 3 );
+    CHECK( calls[0] == ExchangeSM::Call({ in1, in2, in3 }) );
+    CHECK( calls[1] == ExchangeSM::Call({ in2, in3 }) );
+    CHECK( calls[2] == ExchangeSM::Call({ in3 }) );
+
+    const string info = obj->exchangeInfo();
+    CHECK( counter(info, "askCalls") == 3 );
+
+    // между повторами пауза askPause (50 мсек, см. exchange-configure.xml)
+    CHECK( counter(info, "askTime") >= 100 );
+}
+// -----------------------------------------------------------------------------
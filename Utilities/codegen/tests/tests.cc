@@ -0,0 +1,94 @@
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <string>
+#include "Debug.h"
+#include "UniSetActivator.h"
+#include "PassiveTimer.h"
+#include "ExchangeSM.h"
+#include "TestExchange.h"
+// --------------------------------------------------------------------------
+using namespace std;
+using namespace uniset;
+// --------------------------------------------------------------------------
+std::shared_ptr<ExchangeSM> sm;
+std::shared_ptr<TestExchange> obj;
+// --------------------------------------------------------------------------
+int main(int argc, const char* argv[] )
+{
+    try
+    {
+        Catch::Session session;
+
+        if( argc > 1 && ( strcmp(argv[1], "--help") == 0 || strcmp(argv[1], "-h") == 0 ) )
+        {
+            cout << "--confile    - Использовать указанный конф. файл. По умолчанию configure.xml" << endl;
+            cout << endl << endl << "--------------- CATCH HELP --------------" << endl;
+            session.showHelp();
+            return 0;
+        }
+
+        int returnCode = session.applyCommandLine( argc, argv );
+
+        //        if( returnCode != 0 ) // Indicates a command line error
+        //            return returnCode;
+
+        auto conf = uniset_init(argc, argv);
+
+        ObjectId sm_id = conf->getControllerID("ExchangeSM");
+
+        if( sm_id == DefaultObjectId )
+        {
+            cerr << "Not found ID for 'ExchangeSM'" << endl;
+            return 1;
+        }
+
+        sm = make_shared<ExchangeSM>(sm_id, conf->getConfFileName());
+
+        auto act = UniSetActivator::Instance();
+        act->add(sm);
+
+        // процесс не активируется (обмен вызывается из тестов)
+        ObjectId o_id = conf->getObjectID("TestGenExchange");
+
+        if( o_id == DefaultObjectId )
+        {
+            cerr << "Not found ID for 'TestGenExchange'" << endl;
+            return 1;
+        }
+
+        obj = make_shared<TestExchange>(o_id, conf->getNode("TestGenExchange"));
+
+        SystemMessage msg(SystemMessage::StartUp);
+        act->broadcast( msg.transport_msg() );
+        act->run(true);
+
+        int tout = 6000;
+        PassiveTimer pt(tout);
+
+        while( !pt.checkTime() && !sm->exist() )
+            msleep(100);
+
+        if( !sm->exist() )
+        {
+            cerr << "(tests): ExchangeSM not exist! (timeout=" << tout << ")" << endl;
+            return 1;
+        }
+
+        return session.run();
+    }
+    catch( const uniset::Exception& ex )
+    {
+        cerr << "(tests): " << ex << endl;
+    }
+    catch( const std::exception& e )
+    {
+        cerr << "(tests): " << e.what() << endl;
+    }
+    catch(...)
+    {
+        cerr << "(tests): catch(...)" << endl;
+    }
+
+    return 1;
+}
@@ -0,0 +1,10 @@
+#!/bin/sh
+
+./uniset2-start.sh -f ./uniset2-admin --confile ./exchange-configure.xml --create
+./uniset2-start.sh -f ./uniset2-admin --confile ./exchange-configure.xml --exist | grep -q UNISET_CODEGEN/Controllers || exit 1
+
+./uniset2-start.sh -f ./tests $* -- --confile ./exchange-configure.xml --exch-activate-timeout 1 \
+--ulog-add-levels crit
+
+#--ulog-add-levels crit,warn --dlog-add-levels any
+#--TestGenExchange-log-add-levels any
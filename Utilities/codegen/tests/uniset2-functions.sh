@@ -0,0 +1 @@
+../../scripts/uniset2-functions.sh
\ No newline at end of file
@@ -0,0 +1 @@
+../../scripts/uniset2-start.sh
\ No newline at end of file
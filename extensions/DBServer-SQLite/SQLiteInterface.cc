@@ -158,6 +158,49 @@ bool SQLiteInterface::insert( const string& q )
     return true;
 }
 // -----------------------------------------------------------------------------------------
+sqlite3_stmt* SQLiteInterface::prepare( const std::string& q )
+{
+    if( !db )
+        return nullptr;
+
+    sqlite3_stmt* pStmt = nullptr;
+
+    if( sqlite3_prepare_v2(db, q.c_str(), -1, &pStmt, NULL) != SQLITE_OK )
+    {
+        lastE = "prepare '" + q + "' error: " + string(sqlite3_errmsg(db));
+        sqlite3_finalize(pStmt);
+        return nullptr;
+    }
+
+    return pStmt;
+}
+// -----------------------------------------------------------------------------------------
+bool SQLiteInterface::execute( sqlite3_stmt* stmt )
+{
+    if( !db || !stmt )
+        return false;
+
+    int rc = sqlite3_step(stmt);
+
+    queryok = ( rc == SQLITE_DONE || rc == SQLITE_ROW );
+
+    if( !queryok && !checkResult(rc) )
+        queryok = wait(stmt, SQLITE_DONE);
+
+    if( !queryok )
+        lastE = sqlite3_errmsg(db);
+
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+    return queryok;
+}
+// -----------------------------------------------------------------------------------------
+void SQLiteInterface::finalize( sqlite3_stmt* stmt )
+{
+    if( stmt )
+        sqlite3_finalize(stmt);
+}
+// -----------------------------------------------------------------------------------------
 bool SQLiteInterface::checkResult( int rc )
 {
     if( rc == SQLITE_BUSY || rc == SQLITE_LOCKED || rc == SQLITE_INTERRUPT || rc == SQLITE_IOERR )
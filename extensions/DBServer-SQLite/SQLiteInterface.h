@@ -118,6 +118,18 @@ namespace uniset
             virtual bool insert( const std::string& q ) override;
             virtual double insert_id() override;
 
+            /*! Подготовленный запрос (для многократного выполнения, например вставки пачки записей в одной транзакции).
+             * Параметры задаются через sqlite3_bind_xxx().
+             * \return nullptr - ошибка (см. error())
+             */
+            sqlite3_stmt* prepare( const std::string& q );
+
+            //! выполнить подготовленный запрос (после выполнения он готов к повторному использованию)
+            bool execute( sqlite3_stmt* stmt );
+
+            //! освободить подготовленный запрос (должно быть вызвано до close())
+            void finalize( sqlite3_stmt* stmt );
+
             virtual const std::string error() override;
 
         protected:
@@ -187,6 +187,9 @@ namespace uniset
         vmonit(force);
         vmonit(force_out);
 
+        noAIBlock = conf->getArgInt("--" + prefix + "-no-ai-block", it.getProp("noAIBlock"));
+        vmonit(noAIBlock);
+
         filtersize = conf->getArgPInt("--" + prefix + "-filtersize", it.getProp("filterSize"), 1);
 
         filterT = atof(conf->getArgParam("--" + prefix + "-filterT", it.getProp("filterT")).c_str());
@@ -367,6 +370,7 @@ namespace uniset
 
         // чтение параметров по входам-выходам
         initIOCard();
+        initAIBlock();
 
         bool skip_iout = uniset_conf()->getArgInt("--" + prefix + "-skip-init-output");
 
@@ -495,6 +499,21 @@ namespace uniset
         if( testmode == tmOffPoll )
             return;
 
+        // Аналоговые входы копятся в aiblock и обрабатываются в конце цикла.
+        // В тестовом режиме часть входов может не опрашиваться, поэтому обрабатываем каждый вход отдельно.
+        const bool blk = ( testmode == tmNone && ( aiblock.size() > 0 || aiblock.thresholds() > 0 ) );
+
+        // состояние фильтров хранится либо в aiblock, либо в IOBase::df - переносим его при смене режима
+        if( blk != aiblockCycle )
+        {
+            if( blk )
+                aiblock.loadFilters();
+            else
+                aiblock.saveFilters();
+        }
+
+        aiblockCycle = blk;
+
         // Опрос приоритетной очереди
         for( const auto& it : pmap )
         {
@@ -518,7 +537,8 @@ namespace uniset
             if( io->ignore )
                 continue;
 
-            IOBase::processingThreshold(io.get(), shm, force);
+            if( !aiblockCycle || !io->blkThreshold )
+                IOBase::processingThreshold(io.get(), shm, force);
 
             ioread(io);
 
@@ -551,6 +571,14 @@ namespace uniset
                 IOBase::processingThreshold( iomap[it.index].get(), shm, force );
             }
         }
+
+        if( aiblockCycle && !cancelled )
+        {
+            aiblock.process(shm, force);
+
+            // пороги считаются после обновления входов (в этом же цикле)
+            aiblock.processThresholds(shm, force);
+        }
     }
     // --------------------------------------------------------------------------------
     void IOControl::ioread( std::shared_ptr<IOInfo>& it )
@@ -606,7 +634,10 @@ namespace uniset
                        << " val=" << val
                        << endl;
 
-                IOBase::processingAsAI( ib, val, shm, force );
+                if( aiblockCycle && it->blkIndex >= 0 )
+                    aiblock.setRaw(it->blkIndex, val);
+                else
+                    IOBase::processingAsAI( ib, val, shm, force );
             }
             else if( it->stype == UniversalIO::DI )
             {
@@ -904,6 +935,63 @@ namespace uniset
         return true;
     }
     // ------------------------------------------------------------------------------------------
+    void IOControl::initAIBlock()
+    {
+        aiblock.clear();
+
+        for( auto&& it : iomap )
+        {
+            if( it )
+            {
+                it->blkIndex = -1;
+                it->blkThreshold = false;
+            }
+        }
+
+        if( noAIBlock || noCards )
+            return;
+
+        // приоритетные входы опрашиваются несколько раз за цикл, поэтому обрабатываются сразу (не через блок)
+        std::vector<bool> prior(iomap.size(), false);
+
+        for( const auto& p : pmap )
+        {
+            if( p.index < prior.size() )
+                prior[p.index] = true;
+        }
+
+        for( size_t i = 0; i < iomap.size(); i++ )
+        {
+            auto& it = iomap[i];
+
+            if( !it || prior[i] || it->ignore || it->si.id == DefaultObjectId )
+                continue;
+
+            if( it->t_ai != DefaultObjectId )
+            {
+                aiblock.addThreshold(it.get());
+                it->blkThreshold = true;
+            }
+
+            if( it->stype != UniversalIO::AI )
+                continue;
+
+            // в блок попадают только реально опрашиваемые входы (см. ioread)
+            if( it->ncard == defCardNum || !cards.getCard(it->ncard)
+                    || it->subdev == IOBase::DefaultSubdev || it->channel == IOBase::DefaultChannel )
+                continue;
+
+            if( !IOBlock::isBlockable(it.get()) )
+                continue;
+
+            it->blkIndex = aiblock.add(it.get());
+        }
+
+        ioinfo << myname << "(init): AI block size=" << aiblock.size()
+               << " blocks=" << aiblock.blocks()
+               << " thresholds=" << aiblock.thresholds() << endl;
+    }
+    // ------------------------------------------------------------------------------------------
 
     bool IOControl::activateObject()
     {
@@ -1289,6 +1377,7 @@ namespace uniset
         cout << "--prefix-heartbeat-max     - Максимальное значение heartbeat-счётчика для данного процесса. По умолчанию 10." << endl;
         cout << "--prefix-force             - Сохранять значения в SM, независимо от, того менялось ли значение" << endl;
         cout << "--prefix-force-out         - Обновлять выходы принудительно (не по заказу)" << endl;
+        cout << "--prefix-no-ai-block 1     - Отключить пакетную обработку аналоговых входов (каждый вход обрабатывается отдельно)" << endl;
         cout << "--prefix-skip-init-output  - Не инициализировать 'выходы' при старте" << endl;
         cout << "--prefix-sm-test-sid - Использовать указанный датчик, для проверки готовности SharedMemory" << endl;
         cout << "--prefix-sm-ready-timeout     - Время ожидания готовности SM к работе, мсек. (-1 - ждать 'вечно')" << endl;
@@ -1331,6 +1420,12 @@ namespace uniset
             << " blink3=" << ptBlink3.getInterval()
             << endl;
 
+        inf << "AI block: size=" << aiblock.size()
+            << " blocks=" << aiblock.blocks()
+            << " thresholds=" << aiblock.thresholds()
+            << " noAIBlock=" << noAIBlock
+            << endl;
+
         inf << endl;
 
         for( size_t i = 0; i < cards.size(); i++ )
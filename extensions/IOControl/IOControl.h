@@ -35,6 +35,7 @@
 #include "SMInterface.h"
 #include "IOController.h"
 #include "IOBase.h"
+#include "IOBlock.h"
 #include "SharedMemory.h"
 #include "LogServer.h"
 #include "DebugStream.h"
@@ -93,6 +94,7 @@ namespace uniset
         <br>\b --io-ready-timeout    - Время ожидания готовности SM к работе, мсек. (-1 - ждать 'вечно')
         <br>\b --io-force            - Сохранять значения в SM, независимо от, того менялось ли значение
         <br>\b --io-force-out        - Обновлять выходы принудительно (не по заказу)
+        <br>\b --io-no-ai-block 1    - Отключить пакетную обработку аналоговых входов (см. IOBlock), обрабатывать каждый вход отдельно
 
         <br>\b --io-skip-init-output    - Не инициализировать 'выходы' при старте
         <br>\b --io-sm-ready-test-sid - Использовать указанный датчик, для проверки готовности SharedMemory
@@ -138,6 +140,8 @@ namespace uniset
         <br>\b caldiagram      - Имя калибровочной диаграммы из секции <Calibrations>.
         <br>\b cal_cachesize   - Размер кэша в калибровочной диаграмме (Calibration.h)
         <br>\b cal_cacheresort - Количество циклов обращения к кэшу, для вызова принудительной пересортировки. (Calibration.h)
+        <br>\b cal_lookup      - Максимальный размер таблицы для поиска значений в калибровочной диаграмме за O(1)
+                          (вместо кэша). 0 - не использовать (по умолчанию). См. Calibration::buildLookupTable().
 
         <br>\b threshold_aid   - идентификатор аналогового датчика по которому формируется порог.
                           Используется для DI.
@@ -292,6 +296,8 @@ namespace uniset
                 bool no_testlamp = { false };      /*!< флаг исключения из 'проверки ламп' */
                 bool enable_testmode = { false };  /*!< флаг для режима тестирования tmConfigEnable */
                 bool disable_testmode = { false }; /*!< флаг для режима тестирования tmConfigDisable */
+                long blkIndex = { -1 };            /*!< индекс в блоке аналоговых входов (-1 - обрабатывается отдельно) */
+                bool blkThreshold = { false };     /*!< пороговый датчик обрабатывается в блоке аналоговых входов */
 
                 friend std::ostream& operator<<(std::ostream& os, const IOInfo& inf );
                 friend std::ostream& operator<<(std::ostream& os, const std::shared_ptr<IOInfo>& inf );
@@ -339,6 +345,9 @@ namespace uniset
             // инициализация карты (каналов в/в)
             void initIOCard();
 
+            // формирование блока аналоговых входов (см. IOBlock)
+            void initAIBlock();
+
             // чтение файла конфигурации
             void readConfiguration();
             bool initIOItem( UniXML::iterator& it );
@@ -404,6 +413,9 @@ namespace uniset
 
             bool force = { false };            /*!< флаг, означающий, что надо сохранять в SM, даже если значение не менялось */
             bool force_out = { false };        /*!< флаг, включающий принудительное чтения выходов */
+            bool noAIBlock = { false };        /*!< отключить пакетную обработку аналоговых входов */
+            IOBlock aiblock;                   /*!< аналоговые входы, обрабатываемые пакетно */
+            bool aiblockCycle = { false };     /*!< в текущем цикле опроса входы обрабатываются через aiblock */
             timeout_t smReadyTimeout = { 15000 };    /*!< время ожидания готовности SM к работе, мсек */
             ssize_t defCardNum = { -1 };        /*!< номер карты по умолчанию */
             size_t maxCardNum = { 10 };        /*! максимально разрешённый номер для карты */
@@ -5,6 +5,7 @@
 #include <unordered_set>
 #include <Poco/Net/NetException.h>
 #include "UniSetTypes.h"
+#include "PassiveTimer.h"
 #include "FakeIOControl.h"
 // -----------------------------------------------------------------------------
 using namespace std;
@@ -189,3 +190,44 @@ TEST_CASE("IOControl: test lamp", "[iocontrol][testlamp]")
 
 }
 // -----------------------------------------------------------------------------
+TEST_CASE("IOControl: AI (filters)", "[iocontrol][ai][filter]")
+{
+    InitTest();
+
+    auto card = ioc->fcard;
+
+    auto waitValue = []( ObjectId sid, long value, timeout_t msec )
+    {
+        PassiveTimer pt(msec);
+
+        while( !pt.checkTime() )
+        {
+            if( ui->getValue(sid) == value )
+                return true;
+
+            msleep(polltime / 2);
+        }
+
+        return false;
+    };
+
+    // рекурсивный фильтр: небольшие изменения сглаживаются
+    card->chInputs[14] = 100;
+    msleep(polltime + 10);
+    REQUIRE( ui->getValue(1014) < 100 );
+    REQUIRE( waitValue(1014, 100, 5000) );
+
+    // изменение больше порога (iir_thr) проходит сразу
+    card->chInputs[14] = 5000;
+    msleep(polltime * 2 + 10);
+    REQUIRE( ui->getValue(1014) == 5000 );
+
+    // RC-фильтр: значение "тянется" к входному
+    card->chInputs[15] = 1000;
+    msleep(polltime + 10);
+    long v = ui->getValue(1015);
+    REQUIRE( v > 0 );
+    REQUIRE( v < 1000 );
+    REQUIRE( waitValue(1015, 1000, 10000) );
+}
+// -----------------------------------------------------------------------------
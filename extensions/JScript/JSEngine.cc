@@ -658,6 +658,32 @@ void JSEngine::updateOutputs()
     }
 }
 // ----------------------------------------------------------------------------
+std::vector<uniset::ObjectId> JSEngine::getInputs() const
+{
+    std::vector<uniset::ObjectId> ret;
+    ret.reserve(inputs.size());
+
+    for( const auto& i : inputs )
+        ret.push_back(i.first);
+
+    return ret;
+}
+// ----------------------------------------------------------------------------
+void JSEngine::runGC()
+{
+    if( rt )
+        JS_RunGC(rt);
+}
+// ----------------------------------------------------------------------------
+bool JSEngine::getMemoryUsage( JSMemoryUsage& mu )
+{
+    if( !rt )
+        return false;
+
+    JS_ComputeMemoryUsage(rt, &mu);
+    return true;
+}
+// ----------------------------------------------------------------------------
 bool JSEngine::jsSensor::set( JSContext* ctx, JSValue& global, int64_t v )
 {
     int ret = JS_SetPropertyStr(ctx, global, name.c_str(), JS_NewInt64(ctx, v));
@@ -15,6 +15,7 @@
  */
 // --------------------------------------------------------------------------
 #ifndef JSEngine_H_
+#define JSEngine_H_
 // --------------------------------------------------------------------------
 #include <unordered_map>
 extern "C" {
@@ -80,6 +81,15 @@ namespace uniset
             void updateOutputs();
             void step();
 
+            /*! список входов, объявленных скриптом (uniset_inputs) */
+            std::vector<uniset::ObjectId> getInputs() const;
+
+            /*! принудительный запуск сборщика мусора JS */
+            void runGC();
+
+            /*! статистика использования памяти JS runtime */
+            bool getMemoryUsage( JSMemoryUsage& mu );
+
         protected:
             void initJS();
             void freeJS();
@@ -34,10 +34,14 @@ JSProxy::JSProxy( uniset::ObjectId id, xmlNode* confnode, const std::string& _pr
     USingleProcess(confnode, uniset_conf()->getArgc(), uniset_conf()->getArgv(), ""),
     JSProxy_SK( id, confnode, string(_prefix + "-") )
 {
-    if( file.empty() )
+    auto conf = uniset_conf();
+
+    UniXML::iterator sit(confnode);
+    bool multiMode = sit.find("scripts") && sit.goChildren();
+
+    if( file.empty() && !multiMode )
         throw SystemError("JS file undefined");
 
-    auto conf = uniset_conf();
     auto jdir = conf->getDataDir();
 
     if( !jdir.empty() && jdir[jdir.size() - 1] == '/' )
@@ -78,34 +82,89 @@ JSProxy::JSProxy( uniset::ObjectId id, xmlNode* confnode, const std::string& _pr
     opts.httpMaxThreads = httpMaxThreads;
     opts.httpMaxRequestQueue = httpMaxRequestQueue;
 
-    js = make_shared<JSEngine>(file, searchPaths, ui, opts);
+    if( !multiMode )
+    {
+        js = make_shared<JSEngine>(file, searchPaths, ui, opts);
+
+        if( !js )
+            throw SystemError("Can't create JSEngine");
+
+        initLogs(js, "");
+        return;
+    }
+
+    // режим нескольких runtime в одном процессе
+    UniXML::iterator wit(confnode);
+    size_t numWorkers = conf->getArgPInt("--" + argprefix + "workers", wit.getProp("workers"), 2);
+    pool = make_shared<JSRuntimePool>(numWorkers, searchPaths, ui, opts);
+    pool->setMaxPending(conf->getArgPInt("--" + argprefix + "max-pending", wit.getProp("maxPending"), 10000));
+
+    if( !file.empty() )
+    {
+        auto e = pool->add("main", file, sleep_msec);
+        initLogs(e, "main-");
+    }
+
+    for( ; sit; sit++ )
+    {
+        auto sfile = sit.getProp("file");
+
+        if( sfile.empty() )
+            throw SystemError("(JSProxy): undefined 'file' for script in <scripts> section");
+
+        auto sname = sit.getProp2("name", sfile);
+        auto stepMsec = sit.getPIntProp("step_msec", sleep_msec);
+        auto gcSteps = sit.getPIntProp("gc_steps", 0);
+
+        // шаги планируются из step() объекта, чаще чем раз в sleep_msec они вызываться не могут
+        if( stepMsec < sleep_msec )
+        {
+            mywarn << "(init): script '" << sname << "' step_msec=" << stepMsec
+                   << " less than sleep_msec=" << sleep_msec << ". Use step_msec=" << sleep_msec << endl;
+            stepMsec = sleep_msec;
+        }
+
+        auto e = pool->add(sname, sfile, stepMsec, gcSteps);
+        initLogs(e, sname + "-");
+
+        myinfo << "(init): add js runtime '" << sname << "' file=" << sfile
+               << " step_msec=" << stepMsec << " gc_steps=" << gcSteps << endl;
+    }
 
-    if( !js )
-        throw SystemError("Can't create JSEngine");
+    if( pool->size() == 0 )
+        throw SystemError("(JSProxy): <scripts> section is empty");
 
-    loga->add(js->log());
-    loga->add(js->js_log());
-    js->log()->addLevel(log()->level());
+    myinfo << "(init): js runtimes: " << pool->size() << " workers: " << pool->workers() << endl;
+}
+// -------------------------------------------------------------------------
+void JSProxy::initLogs( const std::shared_ptr<JSEngine>& e, const std::string& suffix )
+{
+    auto conf = uniset_conf();
+
+    loga->add(e->log());
+    loga->add(e->js_log());
+    e->log()->addLevel(log()->level());
 
-    loga->add(js->http_log());
-    js->http_log()->addLevel(log()->level());
+    loga->add(e->http_log());
+    e->http_log()->addLevel(log()->level());
 
     {
         ostringstream s;
-        s << argprefix << "script-log";
-        conf->initLogStream(js->js_log(), s.str());
+        s << argprefix << suffix << "script-log";
+        conf->initLogStream(e->js_log(), s.str());
     }
 
     {
         ostringstream s;
-        s << argprefix << "http-log";
-        conf->initLogStream(js->http_log(), s.str());
+        s << argprefix << suffix << "http-log";
+        conf->initLogStream(e->http_log(), s.str());
     }
 }
 // -------------------------------------------------------------------------
 JSProxy::~JSProxy()
 {
     js = nullptr;
+    pool = nullptr;
 }
 // ----------------------------------------------------------------------------
 void JSProxy::help_print()
@@ -122,6 +181,11 @@ void JSProxy::help_print()
     cout << "--js-sleep-msec msec      - Пауза между вызовами uniset_on_step(). По умолчанию 150" << endl;
     cout << "--js-loopCount num        - количество JS событий обрабатываемых за один раз. По умолчанию 5" << endl;
     cout << endl;
+    cout << "Multi-runtime mode (<scripts> section):" << endl;
+    cout << "--js-workers num          - количество потоков для выполнения скриптов. По умолчанию 2" << endl;
+    cout << "--js-max-pending num      - максимальная очередь уведомлений для одного скрипта. По умолчанию 10000" << endl;
+    cout << "--js-NAME-script-log-...  - log control для скрипта NAME" << endl;
+    cout << endl;
     cout << "Logs:" << endl;
     cout << "--js-log-...            - log control" << endl;
     cout << "             add-levels ...  " << endl;
@@ -177,7 +241,19 @@ std::shared_ptr<JSProxy> JSProxy::init( int argc, const char* const* argv, const
 // ----------------------------------------------------------------------------
 void JSProxy::callback() noexcept
 {
-    if( !js->isActive() )
+    if( pool && !pool->isActive() )
+    {
+        try
+        {
+            pool->init();
+        }
+        catch( std::exception& ex )
+        {
+            mycrit << "(init): " << ex.what() << endl;
+            uterminate();
+        }
+    }
+    else if( js && !js->isActive() )
     {
         try
         {
@@ -195,16 +271,28 @@ void JSProxy::callback() noexcept
 // ----------------------------------------------------------------------------
 void JSProxy::askSensors( UniversalIO::UIOCommand cmd )
 {
-    js->askSensors(cmd);
+    if( pool )
+        pool->askSensors(cmd);
+    else
+        js->askSensors(cmd);
 }
 // ----------------------------------------------------------------------------
 void JSProxy::sensorInfo( const uniset::SensorMessage* sm )
 {
-    js->sensorInfo(sm);
+    if( pool )
+        pool->sensorInfo(sm);
+    else
+        js->sensorInfo(sm);
 }
 // -------------------------------------------------------------------------
 void JSProxy::step()
 {
+    if( pool )
+    {
+        pool->poll();
+        return;
+    }
+
     js->step();
     js->updateOutputs();
 }
@@ -214,12 +302,37 @@ void JSProxy::sysCommand(const uniset::SystemMessage* sm )
     JSProxy_SK::sysCommand(sm);
 
     if( sm->command == SystemMessage::StartUp )
-        js->start();
+    {
+        if( pool )
+            pool->start();
+        else
+            js->start();
+    }
 }
 // -------------------------------------------------------------------------
 bool JSProxy::deactivateObject()
 {
-    js->stop();
+    if( pool )
+        pool->stop();
+    else
+        js->stop();
+
     return JSProxy_SK::deactivateObject();
 }
 // -------------------------------------------------------------------------
+std::string JSProxy::getMonitInfo() const
+{
+    if( pool )
+        return pool->getMonitInfo();
+
+    return "";
+}
+// -------------------------------------------------------------------------
+#ifndef DISABLE_REST_API
+void JSProxy::httpGetUserData( Poco::JSON::Object::Ptr& jdata )
+{
+    if( pool )
+        jdata->set("jsRuntimes", pool->httpGetInfo());
+}
+#endif
+// -------------------------------------------------------------------------
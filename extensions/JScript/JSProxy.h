@@ -25,6 +25,7 @@
 // --------------------------------------------------------------------------
 #include "JSProxy_SK.h"
 #include "JSEngine.h"
+#include "JSRuntimePool.h"
 #include "USingleProcess.h"
 // --------------------------------------------------------------------------
 namespace uniset
@@ -51,10 +52,15 @@ namespace uniset
             virtual bool deactivateObject() override;
             virtual void askSensors( UniversalIO::UIOCommand cmd) override;
             virtual void sensorInfo(const uniset::SensorMessage* sm) override;
-            //            virtual std::string getMonitInfo() const override;
+            virtual std::string getMonitInfo() const override;
+#ifndef DISABLE_REST_API
+            virtual void httpGetUserData( Poco::JSON::Object::Ptr& jdata ) override;
+#endif
+            void initLogs( const std::shared_ptr<JSEngine>& e, const std::string& suffix );
 
         private:
             std::shared_ptr<JSEngine> js;
+            std::shared_ptr<JSRuntimePool> pool; // режим нескольких скриптов (секция <scripts>)
     };
     // ----------------------------------------------------------------------
 } // end of namespace uniset
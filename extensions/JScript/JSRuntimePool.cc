@@ -0,0 +1,489 @@
+/*
+ * Copyright (c) 2025 Pavel Vainerman.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, version 2.1.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+// -------------------------------------------------------------------------
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <algorithm>
+#include "Exceptions.h"
+#include "ujson.h"
+#include "JSRuntimePool.h"
+// -------------------------------------------------------------------------
+using namespace std;
+using namespace uniset;
+// -------------------------------------------------------------------------
+namespace
+{
+    inline uint64_t usec_since( const std::chrono::steady_clock::time_point& t0 )
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t0).count();
+    }
+}
+// -------------------------------------------------------------------------
+JSRuntimePool::JSRuntimePool( size_t numWorkers,
+                              const std::vector<std::string>& _searchPaths,
+                              std::shared_ptr<UInterface>& _ui,
+                              const JSOptions& _opts ):
+    searchPaths(_searchPaths),
+    ui(_ui),
+    opts(_opts)
+{
+    if( numWorkers == 0 )
+        numWorkers = 1;
+
+    for( size_t i = 0; i < numWorkers; i++ )
+    {
+        auto w = std::make_unique<Worker>();
+        w->thr = std::thread(&JSRuntimePool::workerThread, this, w.get());
+        wpool.emplace_back(std::move(w));
+    }
+}
+// -------------------------------------------------------------------------
+JSRuntimePool::~JSRuntimePool()
+{
+    // runtime-ы освобождаем в "их" потоках
+    for( auto&& r : runtimes )
+    {
+        Runtime* rp = r.get();
+
+        try
+        {
+            post(rp->worker, [rp]()
+            {
+                rp->js = nullptr;
+            }).wait();
+        }
+        catch( ... ) {}
+    }
+
+    terminated = true;
+
+    for( auto&& w : wpool )
+    {
+        {
+            std::lock_guard<std::mutex> l(w->mut);
+        }
+        w->cv.notify_all();
+    }
+
+    for( auto&& w : wpool )
+    {
+        if( w->thr.joinable() )
+            w->thr.join();
+    }
+}
+// -------------------------------------------------------------------------
+std::shared_ptr<JSEngine> JSRuntimePool::add( const std::string& name,
+        const std::string& jsfile,
+        timeout_t stepMsec,
+        size_t gcSteps )
+{
+    if( active )
+        throw SystemError("(JSRuntimePool): can't add runtime '" + name + "' after init");
+
+    for( const auto& r : runtimes )
+    {
+        if( r->name == name )
+            throw SystemError("(JSRuntimePool): runtime '" + name + "' already exists");
+    }
+
+    auto r = std::make_unique<Runtime>();
+    r->name = name;
+    r->jsfile = jsfile;
+    r->worker = runtimes.size() % wpool.size();
+    r->gcSteps = gcSteps;
+    r->ptStep.setTiming(stepMsec);
+    r->js = make_shared<JSEngine>(jsfile, searchPaths, ui, opts);
+    r->js->log()->setLogName("JSEngine-" + name);
+    r->js->js_log()->setLogName("JSLog-" + name);
+
+    auto js = r->js;
+    runtimes.emplace_back(std::move(r));
+    return js;
+}
+// -------------------------------------------------------------------------
+size_t JSRuntimePool::size() const noexcept
+{
+    return runtimes.size();
+}
+// -------------------------------------------------------------------------
+size_t JSRuntimePool::workers() const noexcept
+{
+    return wpool.size();
+}
+// -------------------------------------------------------------------------
+bool JSRuntimePool::isActive() const noexcept
+{
+    return active;
+}
+// -------------------------------------------------------------------------
+void JSRuntimePool::setMaxPending( size_t sz ) noexcept
+{
+    maxPending = std::max(sz, (size_t)1);
+}
+// -------------------------------------------------------------------------
+void JSRuntimePool::workerThread( Worker* w )
+{
+    while( true )
+    {
+        std::shared_ptr<std::packaged_task<void()>> task;
+
+        {
+            std::unique_lock<std::mutex> l(w->mut);
+            w->cv.wait(l, [&]()
+            {
+                return terminated || !w->tasks.empty();
+            });
+
+            if( w->tasks.empty() )
+                return;
+
+            task = w->tasks.front();
+            w->tasks.pop();
+        }
+
+        // исключения сохраняются в future
+        (*task)();
+    }
+}
+// -------------------------------------------------------------------------
+std::future<void> JSRuntimePool::post( size_t worker, std::function<void()> fn )
+{
+    auto task = std::make_shared<std::packaged_task<void()>>(std::move(fn));
+    auto ret = task->get_future();
+    auto& w = wpool[worker];
+
+    {
+        std::lock_guard<std::mutex> l(w->mut);
+        w->tasks.push(task);
+    }
+
+    w->cv.notify_one();
+    return ret;
+}
+// -------------------------------------------------------------------------
+void JSRuntimePool::runAll( const std::function<void( Runtime* )>& fn )
+{
+    std::vector<std::future<void>> results;
+    results.reserve(runtimes.size());
+
+    for( auto&& r : runtimes )
+    {
+        Runtime* rp = r.get();
+        results.emplace_back(post(rp->worker, [rp, &fn]()
+        {
+            fn(rp);
+        }));
+    }
+
+    // дожидаемся всех, а потом пробрасываем первую ошибку
+    std::exception_ptr err;
+
+    for( auto&& f : results )
+    {
+        try
+        {
+            f.get();
+        }
+        catch( ... )
+        {
+            if( !err )
+                err = std::current_exception();
+        }
+    }
+
+    if( err )
+        std::rethrow_exception(err);
+}
+// -------------------------------------------------------------------------
+void JSRuntimePool::init()
+{
+    if( active )
+        return;
+
+    runAll([](Runtime * r)
+    {
+        try
+        {
+            r->js->init();
+        }
+        catch( std::exception& ex )
+        {
+            throw SystemError("(JSRuntimePool): runtime '" + r->name + "' init failed: " + ex.what());
+        }
+
+        r->inputs = r->js->getInputs();
+    });
+
+    smap.clear();
+
+    for( auto&& r : runtimes )
+    {
+        for( const auto& sid : r->inputs )
+            smap[sid].push_back(r.get());
+    }
+
+    active = true;
+}
+// -------------------------------------------------------------------------
+void JSRuntimePool::start()
+{
+    runAll([](Runtime * r)
+    {
+        r->js->start();
+        r->ptStep.reset();
+    });
+}
+// -------------------------------------------------------------------------
+void JSRuntimePool::stop()
+{
+    runAll([](Runtime * r)
+    {
+        r->js->stop();
+    });
+}
+// -------------------------------------------------------------------------
+void JSRuntimePool::askSensors( UniversalIO::UIOCommand cmd )
+{
+    // каждый датчик заказываем один раз, независимо от количества "подписчиков"
+    for( const auto& s : smap )
+    {
+        try
+        {
+            ui->askSensor(s.first, cmd);
+        }
+        catch( std::exception& ex )
+        {
+            auto r = s.second.front();
+            auto log = r->js->log();
+
+            if( log->debugging(Debug::CRIT) )
+                log->crit() << "(JSRuntimePool::askSensors): " << ex.what() << endl;
+        }
+    }
+}
+// -------------------------------------------------------------------------
+void JSRuntimePool::sensorInfo( const uniset::SensorMessage* sm )
+{
+    auto it = smap.find(sm->id);
+
+    if( it == smap.end() )
+        return;
+
+    for( auto&& r : it->second )
+    {
+        std::lock_guard<std::mutex> l(r->pmut);
+
+        if( r->pending.size() >= maxPending )
+        {
+            r->pending.pop_front();
+            r->lostMessages++;
+        }
+
+        r->pending.push_back(*sm);
+    }
+}
+// -------------------------------------------------------------------------
+void JSRuntimePool::poll()
+{
+    if( !active )
+        return;
+
+    for( auto&& r : runtimes )
+    {
+        if( !r->ptStep.checkTime() )
+            continue;
+
+        if( r->busy )
+        {
+            std::lock_guard<std::mutex> l(r->smut);
+            r->overrunCount++;
+            continue;
+        }
+
+        r->busy = true;
+        r->ptStep.reset();
+        Runtime* rp = r.get();
+        post(rp->worker, [this, rp]()
+        {
+            stepRuntime(rp);
+        });
+    }
+}
+// -------------------------------------------------------------------------
+void JSRuntimePool::stepRuntime( Runtime* r )
+{
+    std::deque<uniset::SensorMessage> msgs;
+
+    {
+        std::lock_guard<std::mutex> l(r->pmut);
+        msgs.swap(r->pending);
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::string err;
+
+    try
+    {
+        for( const auto& sm : msgs )
+            r->js->sensorInfo(&sm);
+
+        r->js->step();
+        r->js->updateOutputs();
+    }
+    catch( std::exception& ex )
+    {
+        err = ex.what();
+    }
+
+    uint64_t dt = usec_since(t0);
+
+    bool needGC = false;
+    {
+        std::lock_guard<std::mutex> l(r->smut);
+        r->stepCount++;
+        r->lastStep_usec = dt;
+        r->totalStep_usec += dt;
+
+        if( dt > r->maxStep_usec )
+            r->maxStep_usec = dt;
+
+        if( !err.empty() )
+            r->lastError = err;
+
+        needGC = ( r->gcSteps > 0 && (r->stepCount % r->gcSteps) == 0 );
+    }
+
+    if( needGC )
+    {
+        auto g0 = std::chrono::steady_clock::now();
+        r->js->runGC();
+        uint64_t gdt = usec_since(g0);
+
+        std::lock_guard<std::mutex> l(r->smut);
+        r->gcCount++;
+        r->lastGC_usec = gdt;
+
+        if( gdt > r->maxGC_usec )
+            r->maxGC_usec = gdt;
+    }
+
+    // подсчёт памяти - дорогая операция (обход всей кучи),
+    // поэтому делаем его только по запросу (см. httpGetInfo)
+    if( r->memRequest.exchange(false) )
+    {
+        JSMemoryUsage mu;
+
+        if( r->js->getMemoryUsage(mu) )
+        {
+            std::lock_guard<std::mutex> l(r->smut);
+            r->mem = mu;
+        }
+    }
+
+    if( !err.empty() )
+    {
+        auto log = r->js->log();
+
+        if( log->debugging(Debug::CRIT) )
+            log->crit() << "(JSRuntimePool): runtime '" << r->name << "' step error: " << err << endl;
+    }
+
+    r->busy = false;
+}
+// -------------------------------------------------------------------------
+#ifndef DISABLE_REST_API
+Poco::JSON::Object::Ptr JSRuntimePool::httpGetInfo()
+{
+    Poco::JSON::Object::Ptr jret = new Poco::JSON::Object();
+    jret->set("workers", wpool.size());
+    jret->set("count", runtimes.size());
+
+    auto jarr = uniset::json::make_child_array(jret, "runtimes");
+
+    for( auto&& r : runtimes )
+    {
+        Poco::JSON::Object::Ptr jr = new Poco::JSON::Object();
+        jr->set("name", r->name);
+        jr->set("file", r->jsfile);
+        jr->set("worker", r->worker);
+        jr->set("step_msec", r->ptStep.getInterval());
+        jr->set("inputs", r->inputs.size());
+        jr->set("busy", r->busy.load());
+
+        {
+            std::lock_guard<std::mutex> l(r->pmut);
+            jr->set("pending", r->pending.size());
+            jr->set("lostMessages", r->lostMessages);
+        }
+
+        {
+            std::lock_guard<std::mutex> l(r->smut);
+            auto jstep = uniset::json::make_child(jr, "step");
+            jstep->set("count", r->stepCount);
+            jstep->set("overrun", r->overrunCount);
+            jstep->set("last_usec", r->lastStep_usec);
+            jstep->set("max_usec", r->maxStep_usec);
+            jstep->set("avg_usec", r->stepCount > 0 ? r->totalStep_usec / r->stepCount : 0);
+
+            auto jgc = uniset::json::make_child(jr, "gc");
+            jgc->set("every_steps", r->gcSteps);
+            jgc->set("count", r->gcCount);
+            jgc->set("last_usec", r->lastGC_usec);
+            jgc->set("max_usec", r->maxGC_usec);
+
+            auto jmem = uniset::json::make_child(jr, "memory");
+            jmem->set("malloc_size", r->mem.malloc_size);
+            jmem->set("malloc_limit", r->mem.malloc_limit);
+            jmem->set("memory_used_size", r->mem.memory_used_size);
+            jmem->set("obj_count", r->mem.obj_count);
+            jmem->set("str_count", r->mem.str_count);
+            jmem->set("atom_count", r->mem.atom_count);
+
+            if( !r->lastError.empty() )
+                jr->set("lastError", r->lastError);
+        }
+
+        // обновим данные по памяти на следующем шаге
+        r->memRequest = true;
+        jarr->add(jr);
+    }
+
+    return jret;
+}
+#endif
+// -------------------------------------------------------------------------
+std::string JSRuntimePool::getMonitInfo()
+{
+    ostringstream inf;
+    inf << "JS runtimes: " << runtimes.size() << " workers: " << wpool.size() << endl;
+
+    for( auto&& r : runtimes )
+    {
+        std::lock_guard<std::mutex> l(r->smut);
+        inf << "  " << setw(20) << r->name
+            << " step_msec=" << setw(5) << r->ptStep.getInterval()
+            << " steps=" << setw(8) << r->stepCount
+            << " overrun=" << setw(5) << r->overrunCount
+            << " last_usec=" << setw(7) << r->lastStep_usec
+            << " max_usec=" << setw(7) << r->maxStep_usec
+            << " gc=" << r->gcCount
+            << endl;
+    }
+
+    return inf.str();
+}
+// -------------------------------------------------------------------------
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2025 Pavel Vainerman.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, version 2.1.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+// --------------------------------------------------------------------------
+#ifndef JSRuntimePool_H_
+#define JSRuntimePool_H_
+// --------------------------------------------------------------------------
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <queue>
+#include <deque>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include "PassiveTimer.h"
+#include "JSEngine.h"
+#ifndef DISABLE_REST_API
+#include <Poco/JSON/Object.h>
+#endif
+// --------------------------------------------------------------------------
+namespace uniset
+{
+    // ----------------------------------------------------------------------
+    /*! Набор изолированных JS runtime (по одному QuickJS runtime на скрипт),
+     * работающих в одном процессе.
+     *
+     * Каждый runtime имеет свой скрипт, свой период шага и свой набор входов/выходов.
+     * Runtime-ы "закреплены" за потоками пула (runtime N обслуживается потоком N % workers),
+     * т.к. QuickJS runtime нельзя использовать одновременно из нескольких потоков,
+     * а init/step/stop одного runtime должны выполняться в одном и том же потоке.
+     *
+     * Связь с SharedMemory (UInterface) и заказ датчиков общие: каждый датчик заказывается
+     * один раз, а пришедшее уведомление раздаётся всем runtime, у которых он объявлен входом.
+     * Уведомления копятся в очереди runtime и обрабатываются в его потоке перед очередным шагом.
+     */
+    class JSRuntimePool
+    {
+        public:
+            JSRuntimePool( size_t numWorkers,
+                           const std::vector<std::string>& searchPaths,
+                           std::shared_ptr<UInterface>& ui,
+                           const JSOptions& opts );
+            ~JSRuntimePool();
+
+            /*! добавить runtime.
+             * \param name - имя (используется в логах и HTTP API)
+             * \param jsfile - запускаемый скрипт
+             * \param stepMsec - период вызова uniset_on_step()
+             * \param gcSteps - через сколько шагов принудительно вызывать GC (0 - не вызывать)
+             */
+            std::shared_ptr<JSEngine> add( const std::string& name,
+                                           const std::string& jsfile,
+                                           timeout_t stepMsec,
+                                           size_t gcSteps = 0 );
+
+            size_t size() const noexcept;
+            size_t workers() const noexcept;
+            bool isActive() const noexcept;
+
+            // все функции ниже выполняются в потоках runtime-ов,
+            // вызывающий ждёт их завершения
+            void init();
+            void start();
+            void stop();
+
+            void askSensors( UniversalIO::UIOCommand cmd );
+            void sensorInfo( const uniset::SensorMessage* sm );
+
+            /*! планирование шагов: запускает runtime-ы, у которых истёк период.
+             * Вызывается из потока объекта (step()), поэтому реальный период шага runtime
+             * не может быть меньше периода вызова poll() (sleep_msec объекта).
+             */
+            void poll();
+
+            // максимальный размер очереди необработанных уведомлений у одного runtime
+            void setMaxPending( size_t sz ) noexcept;
+
+#ifndef DISABLE_REST_API
+            Poco::JSON::Object::Ptr httpGetInfo();
+#endif
+            std::string getMonitInfo();
+
+        protected:
+
+            struct Runtime
+            {
+                std::string name;
+                std::string jsfile;
+                size_t worker = { 0 };
+                size_t gcSteps = { 0 };
+                std::shared_ptr<JSEngine> js;
+                PassiveTimer ptStep;
+                std::vector<uniset::ObjectId> inputs;
+                std::atomic_bool busy = { false };
+
+                std::mutex pmut;
+                std::deque<uniset::SensorMessage> pending; // при переполнении отбрасываются самые старые
+                size_t lostMessages = { 0 };
+
+                // статистика (защищена smut)
+                std::mutex smut;
+                size_t stepCount = { 0 };
+                size_t overrunCount = { 0 }; // шаг не успел завершиться к началу следующего
+                uint64_t lastStep_usec = { 0 };
+                uint64_t maxStep_usec = { 0 };
+                uint64_t totalStep_usec = { 0 };
+                size_t gcCount = { 0 };
+                uint64_t lastGC_usec = { 0 };
+                uint64_t maxGC_usec = { 0 };
+                std::atomic_bool memRequest = { true };
+                JSMemoryUsage mem = {};
+                std::string lastError;
+            };
+
+            struct Worker
+            {
+                std::thread thr;
+                std::mutex mut;
+                std::condition_variable cv;
+                std::queue<std::shared_ptr<std::packaged_task<void()>>> tasks;
+            };
+
+            std::future<void> post( size_t worker, std::function<void()> fn );
+            void runAll( const std::function<void( Runtime* )>& fn );
+            void workerThread( Worker* w );
+            void stepRuntime( Runtime* r );
+
+        private:
+            std::vector<std::string> searchPaths;
+            std::shared_ptr<UInterface> ui;
+            JSOptions opts;
+            size_t maxPending = { 10000 };
+            std::atomic_bool active = { false };
+            std::atomic_bool terminated = { false };
+
+            std::vector<std::unique_ptr<Runtime>> runtimes;
+            std::vector<std::unique_ptr<Worker>> wpool;
+
+            // sensor id -> runtime-ы, у которых он объявлен входом
+            std::unordered_map<uniset::ObjectId, std::vector<Runtime*>> smap;
+    };
+    // ----------------------------------------------------------------------
+} // end of namespace uniset
+// --------------------------------------------------------------------------
+#endif
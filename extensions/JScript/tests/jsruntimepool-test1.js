@@ -0,0 +1,27 @@
+// скрипт N1 для тестов JSRuntimePool (несколько runtime в одном процессе)
+uniset_inputs = [
+    { name: "JSPool_In1_S" },
+    { name: "JSPool_Common_S" }
+];
+
+uniset_outputs = [
+    { name: "JSPool_Out1_C" },
+    { name: "JSPool_Common1_C" },
+    { name: "JSPool_Count1_C" }
+];
+
+// количество обработанных уведомлений по JSPool_In1_S
+let inputCount = 0;
+
+function uniset_on_sensor(id, value, name)
+{
+    if( id === JSPool_In1_S )
+        inputCount++;
+}
+
+function uniset_on_step()
+{
+    out_JSPool_Out1_C = in_JSPool_In1_S;
+    out_JSPool_Common1_C = in_JSPool_Common_S;
+    out_JSPool_Count1_C = inputCount;
+}
@@ -0,0 +1,27 @@
+// скрипт N2 для тестов JSRuntimePool (несколько runtime в одном процессе)
+uniset_inputs = [
+    { name: "JSPool_In2_S" },
+    { name: "JSPool_Common_S" }
+];
+
+uniset_outputs = [
+    { name: "JSPool_Out2_C" },
+    { name: "JSPool_Common2_C" },
+    { name: "JSPool_Count2_C" }
+];
+
+// количество обработанных уведомлений по JSPool_In2_S
+let inputCount = 0;
+
+function uniset_on_sensor(id, value, name)
+{
+    if( id === JSPool_In2_S )
+        inputCount++;
+}
+
+function uniset_on_step()
+{
+    out_JSPool_Out2_C = in_JSPool_In2_S;
+    out_JSPool_Common2_C = in_JSPool_Common_S;
+    out_JSPool_Count2_C = inputCount;
+}
@@ -0,0 +1,164 @@
+#include <catch.hpp>
+// -----------------------------------------------------------------------------
+#include <memory>
+#include "UInterface.h"
+#include "PassiveTimer.h"
+#include "JSRuntimePool.h"
+// -----------------------------------------------------------------------------
+using namespace std;
+using namespace uniset;
+// -----------------------------------------------------------------------------
+static shared_ptr<UInterface> ui;
+// -----------------------------------------------------------------------------
+const ObjectId sidPoolIn1_S = 1015;
+const ObjectId sidPoolIn2_S = 1016;
+const ObjectId sidPoolCommon_S = 1017;
+const ObjectId sidPoolOut1_C = 1018;
+const ObjectId sidPoolOut2_C = 1019;
+const ObjectId sidPoolCommon1_C = 1020;
+const ObjectId sidPoolCommon2_C = 1021;
+const ObjectId sidPoolCount1_C = 1022;
+const ObjectId sidPoolCount2_C = 1023;
+// -----------------------------------------------------------------------------
+// Создание пула из двух скриптов (jsruntimepool-test1.js, jsruntimepool-test2.js).
+// Пул не заказывает датчики (askSensors), уведомления подаются в тестах напрямую.
+static std::shared_ptr<JSRuntimePool> initPool( size_t workers, size_t maxPending = 10000 )
+{
+    if( !ui )
+        ui = make_shared<UInterface>(uniset::AdminID);
+
+    for( ObjectId sid = sidPoolIn1_S; sid <= sidPoolCount2_C; sid++ )
+        ui->setValue(sid, 0);
+
+    JSOptions opts;
+    auto pool = make_shared<JSRuntimePool>(workers, std::vector<std::string>{ "." }, ui, opts);
+    pool->setMaxPending(maxPending);
+    pool->add("pool1", "jsruntimepool-test1.js", 10);
+    pool->add("pool2", "jsruntimepool-test2.js", 10);
+    pool->init();
+    pool->start();
+    return pool;
+}
+// -----------------------------------------------------------------------------
+static void sendSensor( const std::shared_ptr<JSRuntimePool>& pool, ObjectId sid, long value )
+{
+    SensorMessage sm(sid, value);
+    pool->sensorInfo(&sm);
+}
+// -----------------------------------------------------------------------------
+// poll() вызывается как из step() объекта, пока выход не получит нужное значение
+static bool waitValue( const std::shared_ptr<JSRuntimePool>& pool, ObjectId sid, long value, timeout_t msec = 3000 )
+{
+    PassiveTimer pt(msec);
+
+    while( !pt.checkTime() )
+    {
+        pool->poll();
+
+        if( ui->getValue(sid) == value )
+            return true;
+
+        msleep(10);
+    }
+
+    return false;
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("[JSRuntimePool]: dispatch to several runtimes", "[jsruntimepool]")
+{
+    auto pool = initPool(2);
+    REQUIRE( pool->size() == 2 );
+    REQUIRE( pool->workers() == 2 );
+    REQUIRE( pool->isActive() );
+
+    // уведомление получает только runtime, у которого датчик объявлен входом
+    sendSensor(pool, sidPoolIn1_S, 10);
+    REQUIRE( waitValue(pool, sidPoolOut1_C, 10) );
+    REQUIRE( waitValue(pool, sidPoolCount1_C, 1) );
+    msleep(100);
+    REQUIRE( ui->getValue(sidPoolOut2_C) == 0 );
+    REQUIRE( ui->getValue(sidPoolCount2_C) == 0 );
+
+    sendSensor(pool, sidPoolIn2_S, 20);
+    REQUIRE( waitValue(pool, sidPoolOut2_C, 20) );
+    REQUIRE( waitValue(pool, sidPoolCount2_C, 1) );
+    REQUIRE( ui->getValue(sidPoolOut1_C) == 10 );
+    REQUIRE( ui->getValue(sidPoolCount1_C) == 1 );
+
+    // общий вход раздаётся обоим runtime
+    sendSensor(pool, sidPoolCommon_S, 33);
+    REQUIRE( waitValue(pool, sidPoolCommon1_C, 33) );
+    REQUIRE( waitValue(pool, sidPoolCommon2_C, 33) );
+
+    pool->stop();
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("[JSRuntimePool]: worker pool", "[jsruntimepool]")
+{
+    SECTION("one worker for several runtimes")
+    {
+        auto pool = initPool(1);
+        REQUIRE( pool->workers() == 1 );
+
+        sendSensor(pool, sidPoolIn1_S, 11);
+        sendSensor(pool, sidPoolIn2_S, 22);
+        REQUIRE( waitValue(pool, sidPoolOut1_C, 11) );
+        REQUIRE( waitValue(pool, sidPoolOut2_C, 22) );
+        pool->stop();
+    }
+
+    SECTION("runtimes are pinned to workers")
+    {
+        auto pool = initPool(2);
+
+#ifndef DISABLE_REST_API
+        auto jret = pool->httpGetInfo();
+        REQUIRE( jret->get("workers").convert<size_t>() == 2 );
+        auto jarr = jret->getArray("runtimes");
+        REQUIRE( jarr );
+        REQUIRE( jarr->size() == 2 );
+        REQUIRE( jarr->getObject(0)->get("worker").convert<size_t>() == 0 );
+        REQUIRE( jarr->getObject(1)->get("worker").convert<size_t>() == 1 );
+#endif
+
+        // шаги runtime-ов выполняются независимо
+        for( long v = 1; v <= 5; v++ )
+        {
+            sendSensor(pool, sidPoolIn1_S, v);
+            sendSensor(pool, sidPoolIn2_S, 100 + v);
+            REQUIRE( waitValue(pool, sidPoolOut1_C, v) );
+            REQUIRE( waitValue(pool, sidPoolOut2_C, 100 + v) );
+        }
+
+        REQUIRE( waitValue(pool, sidPoolCount1_C, 5) );
+        REQUIRE( waitValue(pool, sidPoolCount2_C, 5) );
+        pool->stop();
+    }
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("[JSRuntimePool]: queue overflow", "[jsruntimepool]")
+{
+    auto pool = initPool(2, 3);
+
+    // шаги ещё не запускались (poll не вызывался), все уведомления копятся в очереди
+    for( long v = 101; v <= 110; v++ )
+        sendSensor(pool, sidPoolIn1_S, v);
+
+    // отбрасываются самые старые, последнее значение доходит
+    REQUIRE( waitValue(pool, sidPoolOut1_C, 110) );
+    REQUIRE( waitValue(pool, sidPoolCount1_C, 3) );
+    msleep(100);
+    pool->poll();
+    REQUIRE( ui->getValue(sidPoolCount1_C) == 3 );
+
+#ifndef DISABLE_REST_API
+    auto jret = pool->httpGetInfo();
+    auto jr = jret->getArray("runtimes")->getObject(0);
+    REQUIRE( jr->get("name").toString() == "pool1" );
+    REQUIRE( jr->get("lostMessages").convert<size_t>() == 7 );
+    REQUIRE( jr->get("pending").convert<size_t>() == 0 );
+#endif
+
+    pool->stop();
+}
+// -----------------------------------------------------------------------------
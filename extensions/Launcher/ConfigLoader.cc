@@ -115,6 +115,15 @@ namespace uniset
         if (lit.getProp("httpPort").length() > 0)
             config.httpPort = lit.getIntProp("httpPort");
 
+        if (lit.getProp("startParallel").length() > 0)
+            config.startParallel = std::max(lit.getIntProp("startParallel"), 1);
+
+        if (lit.getProp("telemetryInterval").length() > 0)
+            config.telemetryInterval_msec = std::max(lit.getIntProp("telemetryInterval"), 0);
+
+        if (lit.getProp("telemetryHistory").length() > 0)
+            config.telemetryHistory = std::max(lit.getIntProp("telemetryHistory"), 1);
+
         // Default ready check for processes without explicit one
         config.defaultReadyCheck = lit.getProp("defaultReadyCheck");
 
@@ -436,6 +445,18 @@ namespace uniset
         if (it.getProp("oneshotTimeout").length() > 0)
             proc.oneshotTimeout_msec = it.getIntProp("oneshotTimeout");
 
+        // Resource limits (used when telemetry is enabled)
+        if (it.getProp("cpuLimit").length() > 0)
+            proc.cpuLimit = std::max(it.getIntProp("cpuLimit"), 0);
+
+        if (it.getProp("rssLimit").length() > 0)
+            proc.rssLimit_kb = static_cast<size_t>(std::max(it.getIntProp("rssLimit"), 0)) * 1024;
+
+        proc.limitRestart = it.getProp("limitAction") == "restart";
+
+        if (it.getProp("limitFailThreshold").length() > 0)
+            proc.limitFailThreshold = std::max(it.getIntProp("limitFailThreshold"), 1);
+
         // Environment variables for this process
         UniXML::iterator eit(processNode);
 
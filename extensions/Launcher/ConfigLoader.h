@@ -52,6 +52,9 @@ namespace uniset
                 size_t restartWindow_msec = 60000;
                 int maxRestarts = 0;  // 0 = infinite restarts
                 int httpPort = 0;  // 0 = disabled
+                size_t startParallel = 1;  // Max processes started concurrently (1 = sequential)
+                size_t telemetryInterval_msec = 0;  // Resource sampling interval (0 = disabled)
+                size_t telemetryHistory = 120;      // Samples kept per process
 
                 std::vector<std::string> commonArgs;  // Common args prepended to all processes
                 std::string defaultReadyCheck;        // Default ready check for processes without explicit one
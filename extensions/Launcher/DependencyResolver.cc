@@ -83,6 +83,33 @@ namespace uniset
         return result;
     }
     // -------------------------------------------------------------------------
+    std::vector<std::vector<std::string>> DependencyResolver::resolveLevels() const
+    {
+        // resolve() validates dependencies and returns groups in topological order
+        // (dependencies always come before dependent groups)
+        auto order = resolve();
+
+        std::map<std::string, size_t> level;
+        std::vector<std::vector<std::string>> result;
+
+        for (const auto& name : order)
+        {
+            size_t lvl = 0;
+
+            for (const auto& dep : nodes_.at(name).depends)
+                lvl = std::max(lvl, level[dep] + 1);
+
+            level[name] = lvl;
+
+            if (result.size() <= lvl)
+                result.resize(lvl + 1);
+
+            result[lvl].push_back(name);
+        }
+
+        return result;
+    }
+    // -------------------------------------------------------------------------
     void DependencyResolver::dfs(const std::string& name,
                                  std::map<std::string, VisitState>& visited,
                                  std::vector<std::string>& result) const
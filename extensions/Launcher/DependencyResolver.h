@@ -66,6 +66,15 @@ namespace uniset
              */
             std::vector<std::string> resolveReverse() const;
 
+            /*!
+             * Split groups into dependency levels.
+             * Level 0 contains groups without dependencies, level N contains groups
+             * whose dependencies are all in levels < N (at least one in level N-1).
+             * Groups of the same level do not depend on each other and can be started concurrently.
+             * Throws the same exceptions as resolve().
+             */
+            std::vector<std::vector<std::string>> resolveLevels() const;
+
             /*! Get dependencies for a group */
             std::set<std::string> getDependencies(const std::string& name) const;
 
@@ -11,6 +11,8 @@
 #include <sstream>
 #include <fstream>
 #include <thread>
+#include <cmath>
+#include <cstdlib>
 #include <Poco/JSON/Array.h>
 #include <Poco/Net/HTTPServerResponse.h>
 #include <Poco/File.h>
@@ -94,6 +96,17 @@ namespace uniset
         if (cmd == "groups" && method == "GET")
             return handleGroups();
 
+        if (cmd == "timeline" && method == "GET")
+            return handleTimeline();
+
+        if (cmd == "telemetry" && method == "GET")
+        {
+            if (ctx.depth() >= 2)
+                return handleTelemetryProcess(ctx[1]);
+
+            return handleTelemetry(ctx.params);
+        }
+
         // /restart-all - restart all running processes
         if (cmd == "restart-all" && method == "POST")
         {
@@ -411,6 +424,160 @@ namespace uniset
         return root;
     }
     // -------------------------------------------------------------------------
+    Poco::JSON::Object::Ptr LauncherHttpRegistry::handleTimeline()
+    {
+        auto root = new Poco::JSON::Object();
+        auto t = pm_.getBootTimeline();
+
+        root->set("inProgress", t.inProgress);
+        root->set("parallel", t.parallel);
+        root->set("total_msec", t.total_msec);
+
+        Poco::JSON::Array procs;
+
+        for (const auto& e : t.processes)
+        {
+            Poco::JSON::Object obj;
+            obj.set("name", e.name);
+            obj.set("group", e.group);
+            obj.set("level", e.level);
+            obj.set("start_msec", e.start_msec);
+            obj.set("ready_msec", e.ready_msec);
+            obj.set("ok", e.ok);
+            procs.add(obj);
+        }
+
+        root->set("processes", procs);
+        root->set("count", static_cast<int>(t.processes.size()));
+
+        return root;
+    }
+    // -------------------------------------------------------------------------
+    Poco::JSON::Object::Ptr LauncherHttpRegistry::sampleToJSON(const ProcStatSample& s)
+    {
+        auto round1 = [](double v)
+        {
+            return std::round(v * 10.0) / 10.0;
+        };
+
+        auto obj = new Poco::JSON::Object();
+        obj->set("time", s.time_msec);
+        obj->set("cpu", round1(s.cpu));
+        obj->set("runDelay", round1(s.runDelay));
+        obj->set("rss_kb", s.rss_kb);
+        obj->set("threads", s.threads);
+        obj->set("ctxSwitches", round1(s.ctxSwitches));
+        obj->set("nonvolCtxSwitches", round1(s.nonvolCtxSwitches));
+        obj->set("readRate", std::lround(s.readRate));
+        obj->set("writeRate", std::lround(s.writeRate));
+        return obj;
+    }
+    // -------------------------------------------------------------------------
+    Poco::JSON::Object::Ptr LauncherHttpRegistry::samplesToJSON(const std::vector<ProcStatSample>& samples, size_t maxCount)
+    {
+        auto round1 = [](double v)
+        {
+            return std::round(v * 10.0) / 10.0;
+        };
+
+        // Column arrays (one per metric) are much more compact than an array of objects
+        Poco::JSON::Array time, cpu, runDelay, rss, threads, ctx, nonvol, rd, wr;
+
+        const size_t first = samples.size() > maxCount ? samples.size() - maxCount : 0;
+
+        for (size_t i = first; i < samples.size(); i++)
+        {
+            const auto& s = samples[i];
+            time.add(s.time_msec);
+            cpu.add(round1(s.cpu));
+            runDelay.add(round1(s.runDelay));
+            rss.add(s.rss_kb);
+            threads.add(s.threads);
+            ctx.add(round1(s.ctxSwitches));
+            nonvol.add(round1(s.nonvolCtxSwitches));
+            rd.add(std::lround(s.readRate));
+            wr.add(std::lround(s.writeRate));
+        }
+
+        auto obj = new Poco::JSON::Object();
+        obj->set("time", time);
+        obj->set("cpu", cpu);
+        obj->set("runDelay", runDelay);
+        obj->set("rss_kb", rss);
+        obj->set("threads", threads);
+        obj->set("ctxSwitches", ctx);
+        obj->set("nonvolCtxSwitches", nonvol);
+        obj->set("readRate", rd);
+        obj->set("writeRate", wr);
+        return obj;
+    }
+    // -------------------------------------------------------------------------
+    Poco::JSON::Object::Ptr LauncherHttpRegistry::handleTelemetry(const Poco::URI::QueryParameters& params)
+    {
+        size_t history = 0;
+
+        for (const auto& p : params)
+        {
+            if (p.first == "history")
+                history = static_cast<size_t>(std::max(std::atoi(p.second.c_str()), 0));
+        }
+
+        auto root = new Poco::JSON::Object();
+        const auto& tm = pm_.telemetry();
+
+        root->set("enabled", pm_.getTelemetryInterval() > 0);
+        root->set("interval_msec", pm_.getTelemetryInterval());
+        root->set("history", tm.getHistorySize());
+
+        Poco::JSON::Array processes;
+
+        for (const auto& proc : pm_.getAllProcesses())
+        {
+            Poco::JSON::Object obj;
+            obj.set("name", proc.name);
+            obj.set("pid", proc.pid);
+            obj.set("state", to_string(proc.state));
+            obj.set("cpuLimit", proc.cpuLimit);
+            obj.set("rssLimit_kb", proc.rssLimit_kb);
+
+            ProcStatSample last;
+
+            if (tm.last(proc.name, last))
+                obj.set("last", sampleToJSON(last));
+
+            if (history > 0)
+                obj.set("samples", samplesToJSON(tm.history(proc.name), history));
+
+            processes.add(obj);
+        }
+
+        root->set("processes", processes);
+        return root;
+    }
+    // -------------------------------------------------------------------------
+    Poco::JSON::Object::Ptr LauncherHttpRegistry::handleTelemetryProcess(const std::string& name)
+    {
+        auto proc = pm_.getProcessInfo(name);
+
+        if (proc.name.empty())
+            throw uniset::NameNotFound("Process not found: " + name);
+
+        const auto& tm = pm_.telemetry();
+        auto samples = tm.history(name);
+
+        auto root = new Poco::JSON::Object();
+        root->set("name", proc.name);
+        root->set("pid", proc.pid);
+        root->set("state", to_string(proc.state));
+        root->set("interval_msec", pm_.getTelemetryInterval());
+        root->set("cpuLimit", proc.cpuLimit);
+        root->set("rssLimit_kb", proc.rssLimit_kb);
+        root->set("limitAction", proc.limitRestart ? "restart" : "warn");
+        root->set("count", static_cast<int>(samples.size()));
+        root->set("samples", samplesToJSON(samples, samples.size()));
+        return root;
+    }
+    // -------------------------------------------------------------------------
     Poco::JSON::Object::Ptr LauncherHttpRegistry::handleHelp()
     {
         auto root = new Poco::JSON::Object();
@@ -540,6 +707,49 @@ namespace uniset
             commands.add(cmd);
         }
 
+        // timeline
+        {
+            Poco::JSON::Object cmd;
+            cmd.set("name", "timeline");
+            cmd.set("desc", "Boot timeline of the last startup (per-process ready latency)");
+            cmd.set("method", "GET");
+            commands.add(cmd);
+        }
+
+        // telemetry
+        {
+            Poco::JSON::Object cmd;
+            cmd.set("name", "telemetry");
+            cmd.set("desc", "Resource usage of processes (CPU, RSS, threads, context switches, I/O)");
+            cmd.set("method", "GET");
+
+            Poco::JSON::Array params;
+            Poco::JSON::Object param;
+            param.set("name", "history");
+            param.set("desc", "Include last N samples of each process");
+            params.add(param);
+            cmd.set("parameters", params);
+
+            commands.add(cmd);
+        }
+
+        // telemetry/{name}
+        {
+            Poco::JSON::Object cmd;
+            cmd.set("name", "telemetry/{name}");
+            cmd.set("desc", "Resource usage history of a process");
+            cmd.set("method", "GET");
+
+            Poco::JSON::Array params;
+            Poco::JSON::Object param;
+            param.set("name", "name");
+            param.set("desc", "Process name");
+            params.add(param);
+            cmd.set("parameters", params);
+
+            commands.add(cmd);
+        }
+
         root->set("help", commands);
         root->set("controlEnabled", !controlToken_.empty());
         root->set("readAuthRequired", !readToken_.empty());
@@ -37,6 +37,9 @@ namespace uniset
      * - POST /api/v2/launcher/stop-all     - Stop all processes
      * - GET  /api/v2/launcher/health       - Health check
      * - GET  /api/v2/launcher/groups       - Process groups
+     * - GET  /api/v2/launcher/timeline     - Boot timeline (per-process ready latency)
+     * - GET  /api/v2/launcher/telemetry    - Resource usage of processes (?history=N - with last N samples)
+     * - GET  /api/v2/launcher/telemetry/{name} - Resource usage history of a process
      * - GET  /api/v2/launcher/help         - API help
      */
     class LauncherHttpRegistry :
@@ -79,10 +82,15 @@ namespace uniset
             Poco::JSON::Object::Ptr handleStopAll();
             Poco::JSON::Object::Ptr handleHealth();
             Poco::JSON::Object::Ptr handleGroups();
+            Poco::JSON::Object::Ptr handleTimeline();
+            Poco::JSON::Object::Ptr handleTelemetry(const Poco::URI::QueryParameters& params);
+            Poco::JSON::Object::Ptr handleTelemetryProcess(const std::string& name);
             Poco::JSON::Object::Ptr handleHelp();
 
             Poco::JSON::Object::Ptr processToJSON(const ProcessInfo& proc);
             Poco::JSON::Object::Ptr groupToJSON(const ProcessGroup& group);
+            static Poco::JSON::Object::Ptr sampleToJSON(const ProcStatSample& s);
+            static Poco::JSON::Object::Ptr samplesToJSON(const std::vector<ProcStatSample>& samples, size_t maxCount);
 
             // Authorization helpers
             bool checkReadAuth(const Poco::Net::HTTPServerRequest& req);
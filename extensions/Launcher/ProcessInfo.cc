@@ -96,6 +96,7 @@ namespace uniset
         lastExitCode = -1;  // -1 = unknown (sentinel)
         lastError.clear();
         healthFailCount = 0;
+        limitFailCount = 0;
     }
     // -------------------------------------------------------------------------
 } // end of namespace uniset
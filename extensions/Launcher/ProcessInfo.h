@@ -80,6 +80,14 @@ namespace uniset
         int healthFailThreshold = 3;  // Number of consecutive failures before restart (0 = disabled)
         int healthFailCount = 0;      // Runtime: current consecutive failure count
 
+        // Resource limits (checked by telemetry sampling, see ProcessManager::setTelemetryInterval):
+        // if exceeded limitFailThreshold samples in a row - warning (or restart if limitRestart)
+        double cpuLimit = 0;          // CPU usage limit, % of one core (0 = disabled)
+        size_t rssLimit_kb = 0;       // Resident memory limit (0 = disabled)
+        bool limitRestart = false;    // true = restart process, false = warning only
+        int limitFailThreshold = 3;   // Number of consecutive samples over the limit
+        int limitFailCount = 0;       // Runtime: current consecutive count
+
         // Command to run after process is ready (e.g. "uniset2-admin --create")
         std::string afterRun;
         bool critical = true;           // If true and exhausted maxRestarts - stop launcher. If false (ignoreFail=true) - just leave Failed
@@ -12,6 +12,7 @@
 #include <cstdio>
 #include <cerrno>
 #include <cstring>
+#include <cmath>
 #include <regex>
 #include <fstream>
 #include <sstream>
@@ -308,6 +309,36 @@ namespace uniset
         forwardArgs_ = args;
     }
     // -------------------------------------------------------------------------
+    void ProcessManager::setStartParallel(size_t n)
+    {
+        startParallel_ = std::max(n, static_cast<size_t>(1));
+    }
+    // -------------------------------------------------------------------------
+    size_t ProcessManager::getStartParallel() const
+    {
+        return startParallel_;
+    }
+    // -------------------------------------------------------------------------
+    void ProcessManager::setTelemetryInterval(size_t msec)
+    {
+        telemetryInterval_msec_ = msec;
+    }
+    // -------------------------------------------------------------------------
+    size_t ProcessManager::getTelemetryInterval() const
+    {
+        return telemetryInterval_msec_;
+    }
+    // -------------------------------------------------------------------------
+    void ProcessManager::setTelemetryHistory(size_t samples)
+    {
+        telemetry_.setHistorySize(samples);
+    }
+    // -------------------------------------------------------------------------
+    const ProcessTelemetry& ProcessManager::telemetry() const
+    {
+        return telemetry_;
+    }
+    // -------------------------------------------------------------------------
     void ProcessManager::addProcess(const ProcessInfo& proc)
     {
         std::lock_guard<std::mutex> lock(mutex_);
@@ -340,10 +371,12 @@ namespace uniset
 
         // Get groups in dependency order
         std::vector<std::string> groupOrder;
+        std::vector<std::vector<std::string>> levels;
 
         try
         {
             groupOrder = depResolver_.resolve();
+            levels = depResolver_.resolveLevels();
         }
         catch (const std::exception& e)
         {
@@ -351,6 +384,69 @@ namespace uniset
             return false;
         }
 
+        std::map<std::string, size_t> groupLevel;
+
+        for (size_t lvl = 0; lvl < levels.size(); lvl++)
+        {
+            for (const auto& g : levels[lvl])
+                groupLevel[g] = lvl;
+        }
+
+        bootStart_ = std::chrono::steady_clock::now();
+        boot_ = BootTimeline();
+        boot_.inProgress = true;
+        boot_.parallel = startParallel_;
+
+        auto finish = [this](bool result)
+        {
+            boot_.inProgress = false;
+            boot_.total_msec = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                   std::chrono::steady_clock::now() - bootStart_).count();
+            return result;
+        };
+
+        if (startParallel_ > 1)
+        {
+            // Start by dependency levels: processes of one level concurrently
+            for (size_t lvl = 0; lvl < levels.size(); lvl++)
+            {
+                if (stopping_)
+                    break;
+
+                std::vector<std::string> procs;
+
+                for (const auto& groupName : levels[lvl])
+                {
+                    auto git = groups_.find(groupName);
+
+                    if (git == groups_.end())
+                        continue;
+
+                    mylog->info() << "Starting group: " << groupName << " (level " << lvl << ")" << std::endl;
+
+                    for (const auto& procName : git->second.processes)
+                    {
+                        auto pit = processes_.find(procName);
+
+                        if (pit == processes_.end())
+                        {
+                            mylog->warn() << "Process not found: " << procName << std::endl;
+                            continue;
+                        }
+
+                        if (isStartable(pit->second))
+                            procs.push_back(procName);
+                    }
+                }
+
+                if (!startLevelWithUnlock(procs, lvl, lock))
+                    return finish(false);
+            }
+
+            mylog->info() << "All processes started" << std::endl;
+            return finish(true);
+        }
+
         // Start each group
         for (const auto& groupName : groupOrder)
         {
@@ -378,45 +474,144 @@ namespace uniset
                     continue;
                 }
 
-                // Check skip flag
-                if (pit->second.skip)
-                {
-                    mylog->info() << "Skipping " << procName << " (skip=1)" << std::endl;
+                if (!isStartable(pit->second))
                     continue;
-                }
-
-                // Check manual flag (start only via REST API)
-                if (pit->second.manual)
-                {
-                    mylog->info() << "Skipping " << procName << " (manual=1, start via REST API)" << std::endl;
-                    continue;
-                }
-
-                // Check node filter
-                if (!pit->second.shouldRunOnNode(nodeName_))
-                {
-                    mylog->info() << "Skipping " << procName
-                                  << " (not for node " << nodeName_ << ")" << std::endl;
-                    continue;
-                }
 
                 // Start process with unlocking during waitForReady
-                if (!startProcessWithUnlock(pit->second, lock))
+                if (!startTimedWithUnlock(pit->second, groupName, groupLevel[groupName], lock))
                 {
                     if (pit->second.critical)
                     {
                         mylog->crit() << "Critical process " << procName
                                       << " failed to start" << std::endl;
-                        return false;
+                        return finish(false);
                     }
                 }
             }
         }
 
         mylog->info() << "All processes started" << std::endl;
+        return finish(true);
+    }
+    // -------------------------------------------------------------------------
+    bool ProcessManager::isStartable(const ProcessInfo& proc) const
+    {
+        // Check skip flag
+        if (proc.skip)
+        {
+            mylog->info() << "Skipping " << proc.name << " (skip=1)" << std::endl;
+            return false;
+        }
+
+        // Check manual flag (start only via REST API)
+        if (proc.manual)
+        {
+            mylog->info() << "Skipping " << proc.name << " (manual=1, start via REST API)" << std::endl;
+            return false;
+        }
+
+        // Check node filter
+        if (!proc.shouldRunOnNode(nodeName_))
+        {
+            mylog->info() << "Skipping " << proc.name
+                          << " (not for node " << nodeName_ << ")" << std::endl;
+            return false;
+        }
+
         return true;
     }
     // -------------------------------------------------------------------------
+    bool ProcessManager::startTimedWithUnlock(ProcessInfo& proc, const std::string& group, size_t level,
+            std::unique_lock<std::mutex>& lock)
+    {
+        BootTimelineEntry e;
+        e.name = proc.name;
+        e.group = group;
+        e.level = level;
+
+        auto t0 = std::chrono::steady_clock::now();
+        e.start_msec = std::chrono::duration_cast<std::chrono::milliseconds>(t0 - bootStart_).count();
+
+        bool ok = startProcessWithUnlock(proc, lock);
+
+        // lock is held again here
+        e.ready_msec = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::steady_clock::now() - t0).count();
+        e.ok = ok;
+        boot_.processes.push_back(e);
+
+        if (mylog->is_info())
+            mylog->info() << e.name << (ok ? " ready in " : " failed after ") << e.ready_msec << " ms" << std::endl;
+
+        return ok;
+    }
+    // -------------------------------------------------------------------------
+    bool ProcessManager::startLevelWithUnlock(const std::vector<std::string>& procs, size_t level,
+            std::unique_lock<std::mutex>& lock)
+    {
+        if (procs.empty())
+            return true;
+
+        // Each worker takes the next process from the list and starts it with its own lock
+        // (startProcessWithUnlock() releases the mutex while waiting for readiness,
+        // so ready checks of different processes run in parallel).
+        std::atomic<size_t> next{0};
+        std::atomic<bool> failed{false};
+        const size_t nworkers = std::min(startParallel_, procs.size());
+
+        auto worker = [&]()
+        {
+            while (!failed && !stopping_)
+            {
+                const size_t k = next++;
+
+                if (k >= procs.size())
+                    break;
+
+                std::unique_lock<std::mutex> lk(mutex_);
+
+                try
+                {
+                    auto pit = processes_.find(procs[k]);
+
+                    if (pit == processes_.end())
+                        continue;
+
+                    const std::string group = pit->second.group;
+
+                    if (!startTimedWithUnlock(pit->second, group, level, lk) && pit->second.critical)
+                    {
+                        mylog->crit() << "Critical process " << procs[k]
+                                      << " failed to start" << std::endl;
+                        failed = true;
+                    }
+                }
+                catch (const std::exception& ex)
+                {
+                    mylog->crit() << "Failed to start " << procs[k] << ": " << ex.what() << std::endl;
+                    failed = true;
+                }
+            }
+        };
+
+        mylog->info() << "Starting " << procs.size() << " processes of level " << level
+                      << " (parallel: " << nworkers << ")" << std::endl;
+
+        lock.unlock();
+
+        std::vector<std::thread> workers;
+        workers.reserve(nworkers);
+
+        for (size_t i = 0; i < nworkers; i++)
+            workers.emplace_back(worker);
+
+        for (auto&& w : workers)
+            w.join();
+
+        lock.lock();
+        return !failed;
+    }
+    // -------------------------------------------------------------------------
     std::vector<std::string> ProcessManager::assembleArgs(const ProcessInfo& proc) const
     {
         std::vector<std::string> args;
@@ -1521,6 +1716,13 @@ namespace uniset
 
         running_ = true;
         monitorThread_ = std::thread(&ProcessManager::monitorLoop, this);
+
+        if (telemetryInterval_msec_ > 0)
+        {
+            telemetryThread_ = std::thread(&ProcessManager::telemetryLoop, this);
+            mylog->info() << "Resource telemetry started (interval " << telemetryInterval_msec_ << " ms)" << std::endl;
+        }
+
         mylog->info() << "Process monitoring started" << std::endl;
     }
     // -------------------------------------------------------------------------
@@ -1534,6 +1736,9 @@ namespace uniset
         if (monitorThread_.joinable())
             monitorThread_.join();
 
+        if (telemetryThread_.joinable())
+            telemetryThread_.join();
+
         mylog->info() << "Process monitoring stopped" << std::endl;
     }
     // -------------------------------------------------------------------------
@@ -1654,6 +1859,120 @@ namespace uniset
         }
     }
     // -------------------------------------------------------------------------
+    void ProcessManager::telemetryLoop()
+    {
+        while (running_)
+        {
+            std::vector<std::pair<std::string, Poco::Process::PID>> procs;
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+
+                for (const auto& kv : processes_)
+                {
+                    if (kv.second.state == ProcessState::Running && kv.second.pid > 0)
+                        procs.emplace_back(kv.first, kv.second.pid);
+                }
+            }
+
+            // Read /proc without holding mutex_
+            std::vector<std::pair<std::string, ProcStatSample>> samples;
+
+            for (const auto& p : procs)
+            {
+                ProcStatSample s;
+
+                if (telemetry_.sample(p.first, p.second) && telemetry_.last(p.first, s))
+                    samples.emplace_back(p.first, s);
+            }
+
+            std::vector<std::pair<std::string, Poco::Process::PID>> processesToRestart;
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+
+                for (const auto& item : samples)
+                {
+                    auto it = processes_.find(item.first);
+
+                    if (it == processes_.end() || it->second.state != ProcessState::Running)
+                        continue;
+
+                    if (checkLimits(it->second, item.second))
+                        processesToRestart.emplace_back(it->first, it->second.pid);
+                }
+            }
+
+            for (const auto& item : processesToRestart)
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                auto it = processes_.find(item.first);
+
+                // Could be restarted or stopped (monitorLoop, HTTP API) meanwhile
+                if (it == processes_.end() || it->second.state != ProcessState::Running
+                        || it->second.pid != item.second)
+                    continue;
+
+                stopProcess(it->second);
+                it->second.state = ProcessState::Restarting;
+                startProcessWithUnlock(it->second, lock);
+            }
+
+            if (interruptibleSleep(telemetryInterval_msec_, stopping_, std::min(telemetryInterval_msec_, static_cast<size_t>(500))))
+                break;
+        }
+    }
+    // -------------------------------------------------------------------------
+    bool ProcessManager::checkLimits(ProcessInfo& proc, const ProcStatSample& s)
+    {
+        if (proc.cpuLimit <= 0 && proc.rssLimit_kb == 0)
+            return false;
+
+        std::ostringstream why;
+
+        if (proc.cpuLimit > 0 && s.cpu > proc.cpuLimit)
+            why << "CPU " << std::lround(s.cpu) << "% > " << proc.cpuLimit << "%";
+
+        if (proc.rssLimit_kb > 0 && s.rss_kb > proc.rssLimit_kb)
+        {
+            if (why.tellp() > 0)
+                why << ", ";
+
+            why << "RSS " << s.rss_kb << " kB > " << proc.rssLimit_kb << " kB";
+        }
+
+        if (why.tellp() == 0)
+        {
+            if (proc.limitFailCount > 0)
+            {
+                mylog->info() << proc.name << " resource usage is back within limits" << std::endl;
+                proc.limitFailCount = 0;
+            }
+
+            return false;
+        }
+
+        proc.limitFailCount++;
+        mylog->info() << proc.name << " resource limit exceeded: " << why.str()
+                      << " (" << proc.limitFailCount << "/" << proc.limitFailThreshold << ")" << std::endl;
+
+        if (proc.limitFailCount < proc.limitFailThreshold)
+            return false;
+
+        proc.limitFailCount = 0;
+
+        if (!proc.limitRestart)
+        {
+            mylog->warn() << proc.name << " resource limit exceeded for "
+                          << proc.limitFailThreshold << " samples: " << why.str() << std::endl;
+            return false;
+        }
+
+        mylog->crit() << proc.name << " resource limit exceeded (" << why.str() << "), restarting process" << std::endl;
+        proc.lastError = "resource limit exceeded: " + why.str();
+        return true;
+    }
+    // -------------------------------------------------------------------------
     void ProcessManager::handleProcessExitByName(const std::string& name, int exitCode)
     {
         // Version that works with process name and releases mutex during delay/restart
@@ -1871,6 +2190,18 @@ namespace uniset
         return false;
     }
     // -------------------------------------------------------------------------
+    BootTimeline ProcessManager::getBootTimeline() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        BootTimeline t = boot_;
+
+        if (t.inProgress)
+            t.total_msec = std::chrono::duration_cast<std::chrono::milliseconds>(
+                               std::chrono::steady_clock::now() - bootStart_).count();
+
+        return t;
+    }
+    // -------------------------------------------------------------------------
     std::vector<std::string> ProcessManager::getFullArgs(const std::string& name) const
     {
         std::lock_guard<std::mutex> lock(mutex_);
@@ -1955,6 +2286,15 @@ namespace uniset
         // Show Naming Service status
         bool needNaming = ConfigLoader::needsNamingService(conf_);
         out << "Naming Service: " << (needNaming ? "REQUIRED (localIOR=0)" : "NOT NEEDED (localIOR=1)") << std::endl;
+
+        if (startParallel_ > 1)
+            out << "Startup: parallel by dependency levels (up to " << startParallel_ << " processes at a time)" << std::endl;
+        else
+            out << "Startup: sequential" << std::endl;
+
+        if (telemetryInterval_msec_ > 0)
+            out << "Telemetry: every " << telemetryInterval_msec_ << " ms" << std::endl;
+
         out << std::endl;
 
         // Get groups in dependency order
@@ -2096,6 +2436,20 @@ namespace uniset
                 if (proc.manual)
                     out << "      manual: yes (start via REST API)" << std::endl;
 
+                if (proc.cpuLimit > 0 || proc.rssLimit_kb > 0)
+                {
+                    out << "      Limits:";
+
+                    if (proc.cpuLimit > 0)
+                        out << " cpu " << proc.cpuLimit << "%";
+
+                    if (proc.rssLimit_kb > 0)
+                        out << " rss " << (proc.rssLimit_kb / 1024) << "MB";
+
+                    out << " (" << (proc.limitRestart ? "restart" : "warn")
+                        << " after " << proc.limitFailThreshold << " samples)" << std::endl;
+                }
+
                 out << std::endl;
             }
         }
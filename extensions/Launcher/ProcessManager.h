@@ -18,10 +18,12 @@
 #include <thread>
 #include <functional>
 #include <iostream>
+#include <chrono>
 #include <Poco/Process.h>
 #include "ProcessInfo.h"
 #include "DependencyResolver.h"
 #include "HealthChecker.h"
+#include "ProcessTelemetry.h"
 #include "Configuration.h"
 #include "Debug.h"
 // -------------------------------------------------------------------------
@@ -47,6 +49,28 @@ namespace uniset
         Stop
     };
 
+    /*!
+     * Boot timeline entry: when a process was started during the last startAll()
+     * and how long it took to become ready (see ProcessManager::getBootTimeline()).
+     */
+    struct BootTimelineEntry
+    {
+        std::string name;
+        std::string group;
+        size_t level = 0;       //!< Dependency level of the group (0 = no dependencies)
+        size_t start_msec = 0;  //!< Start offset from the beginning of startAll()
+        size_t ready_msec = 0;  //!< Time from start to ready (or to failure), including retries
+        bool ok = false;        //!< Process became ready
+    };
+
+    struct BootTimeline
+    {
+        bool inProgress = false;
+        size_t parallel = 1;    //!< Parallelism limit used for startup
+        size_t total_msec = 0;  //!< Duration of startAll() (so far, if in progress)
+        std::vector<BootTimelineEntry> processes;  //!< In order of completion
+    };
+
     class ProcessManager
     {
         public:
@@ -64,6 +88,30 @@ namespace uniset
             void setPassthroughArgs(const std::vector<std::string>& args);
             void setForwardArgs(const std::vector<std::string>& args);
 
+            /*!
+             * Max number of processes started concurrently by startAll().
+             * 1 (default) = sequential startup in dependency order (one process at a time).
+             * >1 = groups are split into dependency levels (DependencyResolver::resolveLevels()),
+             * processes of one level are started concurrently (up to n at a time)
+             * and their readiness is checked in parallel. The next level is started
+             * when all processes of the current level are ready.
+             */
+            void setStartParallel(size_t n);
+            size_t getStartParallel() const;
+
+            /*!
+             * Resource telemetry: every msec sample /proc/<pid> of running processes
+             * (CPU, RSS, threads, context switches, I/O, see ProcessTelemetry)
+             * and check resource limits (ProcessInfo::cpuLimit, rssLimit_kb).
+             * 0 = disabled (default). Sampling runs in its own thread started by startMonitoring().
+             */
+            void setTelemetryInterval(size_t msec);
+            size_t getTelemetryInterval() const;
+            void setTelemetryHistory(size_t samples);  //!< Samples kept per process
+
+            //! Collected time series (thread-safe)
+            const ProcessTelemetry& telemetry() const;
+
             // Process registration
             void addProcess(const ProcessInfo& proc);
             void addGroup(const ProcessGroup& group);
@@ -107,6 +155,9 @@ namespace uniset
             bool allRunning() const;
             bool anyCriticalFailed() const;
 
+            //! Startup timeline of the last startAll()
+            BootTimeline getBootTimeline() const;
+
             //! Get full arguments list for a process (commonArgs + args + forwardArgs)
             std::vector<std::string> getFullArgs(const std::string& name) const;
 
@@ -129,10 +180,21 @@ namespace uniset
         private:
             bool startProcessWithUnlock(ProcessInfo& proc, std::unique_lock<std::mutex>& lock);
             bool startOneshotWithUnlock(ProcessInfo& proc, std::unique_lock<std::mutex>& lock);
+
+            // Startup helpers for startAll()
+            bool isStartable(const ProcessInfo& proc) const;  //!< skip/manual/nodeFilter checks (with log)
+            bool startTimedWithUnlock(ProcessInfo& proc, const std::string& group, size_t level,
+                                      std::unique_lock<std::mutex>& lock);
+            bool startLevelWithUnlock(const std::vector<std::string>& procs, size_t level,
+                                      std::unique_lock<std::mutex>& lock);
             void stopProcess(ProcessInfo& proc);
             void doStopAll();  //!< Internal stopAll without bulk guard
             void handleProcessExitByName(const std::string& name, int exitCode);
             void monitorLoop();
+            void telemetryLoop();
+
+            //! Check resource limits for a new sample. Returns true if process must be restarted.
+            bool checkLimits(ProcessInfo& proc, const ProcStatSample& s);
 
             // Helper methods for process startup
             std::vector<std::string> assembleArgs(const ProcessInfo& proc) const;
@@ -156,6 +218,7 @@ namespace uniset
             std::map<std::string, ProcessGroup> groups_;
 
             std::thread monitorThread_;
+            std::thread telemetryThread_;
             std::atomic<bool> running_{false};
             std::atomic<bool> stopping_{false};
             std::atomic<bool> stopAllRunning_{false};
@@ -166,10 +229,18 @@ namespace uniset
             size_t healthCheckInterval_msec_ = 5000;
             size_t restartWindow_msec_ = 60000;
             size_t stopTimeout_msec_ = 5000;  // Time to wait for graceful shutdown before SIGKILL
+            size_t startParallel_ = 1;  // Max processes started concurrently (see setStartParallel)
+            size_t telemetryInterval_msec_ = 0;  // 0 = telemetry disabled
             std::vector<std::string> commonArgs_;
             std::vector<std::string> passthroughArgs_;  // Arguments after "--" passed to all child processes
             std::vector<std::string> forwardArgs_;  // Unknown arguments forwarded to child processes
 
+            ProcessTelemetry telemetry_;  // has its own lock
+
+            // Boot timeline (guarded by mutex_)
+            std::chrono::steady_clock::time_point bootStart_;
+            BootTimeline boot_;
+
             ProcessCallback onStarted_;
             ProcessCallback onStopped_;
             ProcessCallback onFailed_;
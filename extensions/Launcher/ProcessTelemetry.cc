@@ -0,0 +1,370 @@
+/*
+ * Copyright (c) 2026 Pavel Vainerman.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, version 2.1.
+ */
+// -------------------------------------------------------------------------
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <unistd.h>
+#include <dirent.h>
+#include "ProcessTelemetry.h"
+// -------------------------------------------------------------------------
+namespace uniset
+{
+    // -------------------------------------------------------------------------
+    namespace
+    {
+        bool readFile(const std::string& path, std::string& text)
+        {
+            std::ifstream f(path);
+
+            if (!f.is_open())
+                return false;
+
+            std::ostringstream ss;
+            ss << f.rdbuf();
+            text = ss.str();
+            return !text.empty();
+        }
+
+        // Value of "Key:   value ..." line (first number after the key)
+        bool findValue(const std::string& text, const std::string& key, uint64_t& value)
+        {
+            size_t pos = 0;
+
+            while ((pos = text.find(key, pos)) != std::string::npos)
+            {
+                // key must start a line
+                if (pos == 0 || text[pos - 1] == '\n')
+                {
+                    std::istringstream ss(text.substr(pos + key.size(), 32));
+                    return static_cast<bool>(ss >> value);
+                }
+
+                pos += key.size();
+            }
+
+            return false;
+        }
+
+        int64_t nowMsec()
+        {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::system_clock::now().time_since_epoch()).count();
+        }
+    }
+    // -------------------------------------------------------------------------
+    ProcessTelemetry::ProcessTelemetry(size_t historySize)
+        : historySize_(std::max(historySize, static_cast<size_t>(1)))
+    {
+    }
+    // -------------------------------------------------------------------------
+    void ProcessTelemetry::setHistorySize(size_t n)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        historySize_ = std::max(n, static_cast<size_t>(1));
+
+        for (auto& kv : series_)
+        {
+            auto& samples = kv.second.samples;
+
+            while (samples.size() > historySize_)
+                samples.pop_front();
+        }
+    }
+    // -------------------------------------------------------------------------
+    size_t ProcessTelemetry::getHistorySize() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return historySize_;
+    }
+    // -------------------------------------------------------------------------
+    bool ProcessTelemetry::sample(const std::string& name, pid_t pid)
+    {
+        // Read /proc outside the lock
+        ProcStatCounters cur;
+
+        if (pid <= 0 || !readCounters(pid, cur))
+            return false;
+
+        auto now = std::chrono::steady_clock::now();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& s = series_[name];
+
+        // New process (or restarted with a new pid): only store the baseline.
+        // History of the previous instance is kept.
+        if (s.pid != pid)
+        {
+            s.pid = pid;
+            s.t = now;
+            s.prev = cur;
+            return false;
+        }
+
+        const double dt = std::chrono::duration<double>(now - s.t).count();
+
+        if (dt <= 0.0)
+            return false;
+
+        ProcStatSample smp = makeSample(s.prev, cur, dt);
+        smp.time_msec = nowMsec();
+
+        s.samples.push_back(smp);
+
+        while (s.samples.size() > historySize_)
+            s.samples.pop_front();
+
+        s.t = now;
+        s.prev = cur;
+        return true;
+    }
+    // -------------------------------------------------------------------------
+    bool ProcessTelemetry::last(const std::string& name, ProcStatSample& s) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = series_.find(name);
+
+        if (it == series_.end() || it->second.samples.empty())
+            return false;
+
+        s = it->second.samples.back();
+        return true;
+    }
+    // -------------------------------------------------------------------------
+    std::vector<ProcStatSample> ProcessTelemetry::history(const std::string& name) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = series_.find(name);
+
+        if (it == series_.end())
+            return {};
+
+        return std::vector<ProcStatSample>(it->second.samples.begin(), it->second.samples.end());
+    }
+    // -------------------------------------------------------------------------
+    void ProcessTelemetry::remove(const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        series_.erase(name);
+    }
+    // -------------------------------------------------------------------------
+    void ProcessTelemetry::clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        series_.clear();
+    }
+    // -------------------------------------------------------------------------
+    ProcStatSample ProcessTelemetry::makeSample(const ProcStatCounters& prev, const ProcStatCounters& cur, double dt_sec)
+    {
+        // Counters may only grow; a decrease means the reading is broken (use 0)
+        auto delta = [](uint64_t a, uint64_t b) -> double
+        {
+            return b >= a ? static_cast<double>(b - a) : 0.0;
+        };
+
+        ProcStatSample s;
+        s.rss_kb = cur.rss_kb;
+        s.threads = cur.threads;
+
+        if (dt_sec <= 0.0)
+            return s;
+
+        const double dt_nsec = dt_sec * 1e9;
+        s.cpu = 100.0 * delta(prev.cpuTime_nsec, cur.cpuTime_nsec) / dt_nsec;
+
+        if (cur.hasSchedStat && prev.hasSchedStat)
+            s.runDelay = 100.0 * delta(prev.runDelay_nsec, cur.runDelay_nsec) / dt_nsec;
+
+        s.ctxSwitches = (delta(prev.volCtxSwitches, cur.volCtxSwitches)
+                         + delta(prev.nonvolCtxSwitches, cur.nonvolCtxSwitches)) / dt_sec;
+        s.nonvolCtxSwitches = delta(prev.nonvolCtxSwitches, cur.nonvolCtxSwitches) / dt_sec;
+
+        if (cur.hasIO && prev.hasIO)
+        {
+            s.readRate = delta(prev.readBytes, cur.readBytes) / dt_sec;
+            s.writeRate = delta(prev.writeBytes, cur.writeBytes) / dt_sec;
+        }
+
+        return s;
+    }
+    // -------------------------------------------------------------------------
+    bool ProcessTelemetry::readCounters(pid_t pid, ProcStatCounters& c)
+    {
+        const std::string dir = "/proc/" + std::to_string(pid) + "/";
+        std::string text;
+
+        if (!readFile(dir + "stat", text) || !parseStat(text, c))
+            return false;
+
+        if (!readFile(dir + "status", text) || !parseStatus(text, c))
+            return false;
+
+        // CPU time is taken from stat: utime/stime cover the whole thread group
+        // (including exited threads), while schedstat and the ctxt_switches
+        // fields of status describe a single thread. Sum them over all threads.
+        if (!readTaskCounters(dir, c))
+        {
+            // task/ is not readable: main thread only
+            ProcStatCounters t;
+
+            if (readFile(dir + "schedstat", text) && parseSchedStat(text, t))
+            {
+                c.runDelay_nsec = t.runDelay_nsec;
+                c.hasSchedStat = true;
+            }
+        }
+
+        // io is not readable for processes of other users
+        if (readFile(dir + "io", text))
+            parseIO(text, c);
+
+        return true;
+    }
+    // -------------------------------------------------------------------------
+    bool ProcessTelemetry::readTaskCounters(const std::string& dir, ProcStatCounters& c)
+    {
+        DIR* d = ::opendir((dir + "task").c_str());
+
+        if (!d)
+            return false;
+
+        // Counters of exited threads are lost, so the sum may decrease
+        // (makeSample() then reports 0 for that interval)
+        uint64_t vol = 0;
+        uint64_t nonvol = 0;
+        uint64_t delay = 0;
+        bool sched = false;
+        size_t n = 0;
+        std::string text;
+
+        while (struct dirent* e = ::readdir(d))
+        {
+            if (e->d_name[0] == '.')
+                continue;
+
+            const std::string tdir = dir + "task/" + e->d_name + "/";
+            ProcStatCounters t;
+
+            // the thread may exit while we are reading
+            if (!readFile(tdir + "status", text) || !parseStatus(text, t))
+                continue;
+
+            vol += t.volCtxSwitches;
+            nonvol += t.nonvolCtxSwitches;
+            n++;
+
+            if (readFile(tdir + "schedstat", text) && parseSchedStat(text, t))
+            {
+                delay += t.runDelay_nsec;
+                sched = true;
+            }
+        }
+
+        ::closedir(d);
+
+        if (n == 0)
+            return false;
+
+        c.volCtxSwitches = vol;
+        c.nonvolCtxSwitches = nonvol;
+        c.runDelay_nsec = delay;
+        c.hasSchedStat = sched;
+        return true;
+    }
+    // -------------------------------------------------------------------------
+    bool ProcessTelemetry::parseStat(const std::string& text, ProcStatCounters& c)
+    {
+        // pid (comm) state ppid ... : comm may contain spaces and ')'
+        auto pos = text.rfind(')');
+
+        if (pos == std::string::npos)
+            return false;
+
+        std::istringstream ss(text.substr(pos + 1));
+        std::vector<std::string> fields;
+        std::string f;
+
+        while (ss >> f)
+            fields.push_back(f);
+
+        // fields[0] is 'state' (field 3 in proc(5)), so field N is fields[N - 3]
+        // utime(14) stime(15) num_threads(20) rss(24)
+        if (fields.size() < 22)
+            return false;
+
+        try
+        {
+            const uint64_t ticks = std::stoull(fields[11]) + std::stoull(fields[12]);
+            static const long hz = ::sysconf(_SC_CLK_TCK);
+            static const long pageSize = ::sysconf(_SC_PAGESIZE);
+
+            c.cpuTime_nsec = ticks * (1000000000ULL / static_cast<uint64_t>(hz > 0 ? hz : 100));
+
+            c.threads = std::stoul(fields[17]);
+            c.rss_kb = std::stoul(fields[21]) * static_cast<size_t>(pageSize > 0 ? pageSize : 4096) / 1024;
+        }
+        catch (const std::exception&)
+        {
+            return false;
+        }
+
+        return true;
+    }
+    // -------------------------------------------------------------------------
+    bool ProcessTelemetry::parseStatus(const std::string& text, ProcStatCounters& c)
+    {
+        uint64_t v = 0;
+
+        // Kernel threads and zombies have no VmRSS: keep the value from stat
+        if (findValue(text, "VmRSS:", v))
+            c.rss_kb = v;
+
+        if (findValue(text, "Threads:", v))
+            c.threads = v;
+
+        if (findValue(text, "voluntary_ctxt_switches:", v))
+            c.volCtxSwitches = v;
+
+        if (findValue(text, "nonvoluntary_ctxt_switches:", v))
+            c.nonvolCtxSwitches = v;
+
+        return text.find("Name:") != std::string::npos;
+    }
+    // -------------------------------------------------------------------------
+    bool ProcessTelemetry::parseIO(const std::string& text, ProcStatCounters& c)
+    {
+        uint64_t r = 0;
+        uint64_t w = 0;
+
+        if (!findValue(text, "rchar:", r) || !findValue(text, "wchar:", w))
+            return false;
+
+        c.readBytes = r;
+        c.writeBytes = w;
+        c.hasIO = true;
+        return true;
+    }
+    // -------------------------------------------------------------------------
+    bool ProcessTelemetry::parseSchedStat(const std::string& text, ProcStatCounters& c)
+    {
+        // <time on cpu, ns> <time waiting on a runqueue, ns> <timeslices>
+        std::istringstream ss(text);
+        uint64_t run = 0;
+        uint64_t wait = 0;
+
+        if (!(ss >> run >> wait))
+            return false;
+
+        c.cpuTime_nsec = run;
+        c.runDelay_nsec = wait;
+        c.hasSchedStat = true;
+        return true;
+    }
+    // -------------------------------------------------------------------------
+} // end of namespace uniset
+// -------------------------------------------------------------------------
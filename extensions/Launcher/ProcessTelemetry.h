@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026 Pavel Vainerman.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, version 2.1.
+ */
+// -------------------------------------------------------------------------
+#ifndef ProcessTelemetry_H_
+#define ProcessTelemetry_H_
+// -------------------------------------------------------------------------
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+#include <sys/types.h>
+// -------------------------------------------------------------------------
+namespace uniset
+{
+    /*!
+     * Raw cumulative counters of a process from /proc/<pid>/{stat,status,io}
+     * and /proc/<pid>/task/<tid>/{status,schedstat} (summed over all threads).
+     */
+    struct ProcStatCounters
+    {
+        uint64_t cpuTime_nsec = 0;   //!< CPU time (user+system) of all threads, from stat
+        uint64_t runDelay_nsec = 0;  //!< Time spent waiting on a runqueue (schedstat only)
+        size_t rss_kb = 0;
+        size_t threads = 0;
+        uint64_t volCtxSwitches = 0;
+        uint64_t nonvolCtxSwitches = 0;
+        uint64_t readBytes = 0;      //!< rchar: bytes read by syscalls (files, sockets, pipes)
+        uint64_t writeBytes = 0;     //!< wchar: bytes written by syscalls
+        bool hasSchedStat = false;
+        bool hasIO = false;          //!< /proc/<pid>/io is readable
+    };
+
+    /*!
+     * One telemetry sample: rates are computed over the interval since the previous sample.
+     */
+    struct ProcStatSample
+    {
+        int64_t time_msec = 0;       //!< Wall clock time (msec since epoch)
+        double cpu = 0.0;            //!< CPU usage, % of one core
+        double runDelay = 0.0;       //!< Time waiting for CPU, % of interval
+        size_t rss_kb = 0;
+        size_t threads = 0;
+        double ctxSwitches = 0.0;    //!< Voluntary + non-voluntary context switches per second
+        double nonvolCtxSwitches = 0.0;  //!< Non-voluntary (preemptions) per second
+        double readRate = 0.0;       //!< Bytes per second
+        double writeRate = 0.0;      //!< Bytes per second
+    };
+
+    /*!
+     * Per-process resource telemetry.
+     * Samples /proc/<pid> counters and keeps a bounded time series per process
+     * (the oldest samples are dropped when history size is exceeded).
+     * Thread-safe: sample() and queries may be called from different threads.
+     */
+    class ProcessTelemetry
+    {
+        public:
+            explicit ProcessTelemetry(size_t historySize = 120);
+
+            void setHistorySize(size_t n);
+            size_t getHistorySize() const;
+
+            /*!
+             * Read counters of the process and append a sample to its series.
+             * The first call for a pid only stores the baseline (rates need two readings).
+             * \return true if a sample was appended
+             */
+            bool sample(const std::string& name, pid_t pid);
+
+            //! Last sample of the process (false if there are none)
+            bool last(const std::string& name, ProcStatSample& s) const;
+
+            //! All samples of the process (oldest first)
+            std::vector<ProcStatSample> history(const std::string& name) const;
+
+            //! Drop the series of the process (e.g. after it was stopped)
+            void remove(const std::string& name);
+            void clear();
+
+            /*!
+             * Read /proc/<pid> counters.
+             * \return false if the process does not exist (stat/status are not readable)
+             */
+            static bool readCounters(pid_t pid, ProcStatCounters& c);
+
+            // Parsers of /proc/<pid> files (public for tests)
+            static bool parseStat(const std::string& text, ProcStatCounters& c);
+            static bool parseStatus(const std::string& text, ProcStatCounters& c);
+            static bool parseIO(const std::string& text, ProcStatCounters& c);
+            static bool parseSchedStat(const std::string& text, ProcStatCounters& c);
+
+            //! Compute rates between two readings taken dt_sec apart
+            static ProcStatSample makeSample(const ProcStatCounters& prev, const ProcStatCounters& cur, double dt_sec);
+
+        private:
+            //! Sum per-thread counters (context switches, runqueue delay) from dir/task/*
+            static bool readTaskCounters(const std::string& dir, ProcStatCounters& c);
+
+            struct Series
+            {
+                pid_t pid = 0;
+                std::chrono::steady_clock::time_point t;
+                ProcStatCounters prev;
+                std::deque<ProcStatSample> samples;
+            };
+
+            mutable std::mutex mutex_;
+            std::map<std::string, Series> series_;
+            size_t historySize_;
+    };
+
+} // end of namespace uniset
+// -------------------------------------------------------------------------
+#endif // ProcessTelemetry_H_
+// -------------------------------------------------------------------------
@@ -16,6 +16,10 @@
     let hasControl = false;
     let bulkOperationInProgress = false;
     let bulkOperationTimeoutId = null;
+    let telemetry = {};  // process name -> telemetry entry (last sample + history)
+    let telemetryEnabled = false;
+
+    const TELEMETRY_HISTORY = 60;  // samples shown in sparklines
 
     // Initialize
     document.addEventListener('DOMContentLoaded', function() {
@@ -182,7 +186,9 @@
 
             const data = await resp.json();
             errorDiv.style.display = 'none';
+            await fetchTelemetry(headers);
             renderProcesses(data);
+            fetchTimeline(headers);
 
             // Update header info (version and node)
             const versionEl = document.getElementById('version');
@@ -229,6 +235,12 @@
         html += '<th>Uptime</th>';
         html += '<th>Group</th>';
         html += '<th>Restarts</th>';
+        if (telemetryEnabled) {
+            html += '<th title="CPU usage, % of one core">CPU</th>';
+            html += '<th title="Resident memory">RSS</th>';
+            html += '<th title="Threads / context switches per second">Thr / CS</th>';
+            html += '<th title="Read / write bytes per second">I/O</th>';
+        }
         if (hasControl) {
             html += '<th class="actions-header">Actions ';
             html += '<button class="btn btn-warning btn-sm" onclick="restartAll()" title="Restart all running processes"' + (bulkButtonsDisabled ? ' disabled' : '') + '>Restart</button> ';
@@ -292,6 +304,10 @@
             }
             html += '<td>' + restartsStr + '</td>';
 
+            if (telemetryEnabled) {
+                html += renderTelemetryCells(telemetry[proc.name]);
+            }
+
             // Actions
             if (hasControl) {
                 html += '<td class="actions">';
@@ -320,6 +336,158 @@
         contentDiv.innerHTML = html;
     }
 
+    async function fetchTelemetry(headers) {
+        try {
+            const resp = await fetch(API_URL + '/api/v2/launcher/telemetry?history=' + TELEMETRY_HISTORY, { headers });
+            if (!resp.ok) {
+                telemetryEnabled = false;
+                return;
+            }
+            const data = await resp.json();
+            telemetryEnabled = !!data.enabled;
+            telemetry = {};
+            for (const p of (data.processes || [])) {
+                telemetry[p.name] = p;
+            }
+        } catch (e) {
+            // telemetry is optional
+            telemetryEnabled = false;
+        }
+    }
+
+    function renderTelemetryCells(t) {
+        if (!t || !t.last) {
+            return '<td class="telemetry">-</td><td class="telemetry">-</td><td class="telemetry">-</td><td class="telemetry">-</td>';
+        }
+
+        const last = t.last;
+        const samples = t.samples || {};
+        let html = '';
+
+        // CPU
+        const cpuOver = t.cpuLimit > 0 && last.cpu > t.cpuLimit;
+        html += '<td class="telemetry' + (cpuOver ? ' over-limit' : '') + '">';
+        html += sparkline(samples.cpu, t.cpuLimit > 0 ? Math.max(t.cpuLimit, 100) : 100);
+        html += '<span class="telemetry-value">' + last.cpu.toFixed(1) + '%</span></td>';
+
+        // RSS
+        const rssOver = t.rssLimit_kb > 0 && last.rss_kb > t.rssLimit_kb;
+        html += '<td class="telemetry' + (rssOver ? ' over-limit' : '') + '">';
+        html += sparkline(samples.rss_kb, t.rssLimit_kb || 0);
+        html += '<span class="telemetry-value">' + formatBytes(last.rss_kb * 1024) + '</span></td>';
+
+        // Threads / context switches
+        html += '<td class="telemetry">';
+        html += sparkline(samples.ctxSwitches, 0);
+        html += '<span class="telemetry-value">' + last.threads + ' / ' + Math.round(last.ctxSwitches) + '</span></td>';
+
+        // I/O
+        html += '<td class="telemetry">';
+        html += '<span class="telemetry-value">' + formatBytes(last.readRate) + '/s &darr; ';
+        html += formatBytes(last.writeRate) + '/s &uarr;</span></td>';
+
+        return html;
+    }
+
+    // Inline SVG sparkline; scale is max(values, minMax)
+    function sparkline(values, minMax) {
+        if (!values || values.length < 2) {
+            return '';
+        }
+
+        const w = 80;
+        const h = 18;
+        const max = Math.max(Math.max.apply(null, values), minMax || 0, 1e-9);
+        const step = w / (values.length - 1);
+        let points = '';
+
+        for (let i = 0; i < values.length; i++) {
+            const y = h - 1 - (values[i] / max) * (h - 2);
+            points += (i * step).toFixed(1) + ',' + y.toFixed(1) + ' ';
+        }
+
+        return '<svg class="sparkline" width="' + w + '" height="' + h + '" viewBox="0 0 ' + w + ' ' + h + '">' +
+            '<polyline points="' + points.trim() + '"/></svg>';
+    }
+
+    function formatBytes(n) {
+        if (n === undefined || n === null) return '-';
+        if (n < 1024) return Math.round(n) + 'B';
+        if (n < 1024 * 1024) return (n / 1024).toFixed(1) + 'K';
+        if (n < 1024 * 1024 * 1024) return (n / (1024 * 1024)).toFixed(1) + 'M';
+        return (n / (1024 * 1024 * 1024)).toFixed(2) + 'G';
+    }
+
+    async function fetchTimeline(headers) {
+        const timelineDiv = document.getElementById('timeline');
+        if (!timelineDiv) {
+            return;
+        }
+
+        try {
+            const resp = await fetch(API_URL + '/api/v2/launcher/timeline', { headers });
+            if (!resp.ok) {
+                timelineDiv.innerHTML = '';
+                return;
+            }
+            renderTimeline(await resp.json());
+        } catch (e) {
+            // timeline is optional, process table is enough
+            timelineDiv.innerHTML = '';
+        }
+    }
+
+    function renderTimeline(data) {
+        const timelineDiv = document.getElementById('timeline');
+
+        if (!data.processes || data.processes.length === 0) {
+            timelineDiv.innerHTML = '';
+            return;
+        }
+
+        const total = Math.max(data.total_msec, 1);
+
+        let html = '<h2 class="timeline-title">Boot timeline: ' + data.total_msec + ' ms';
+        html += data.parallel > 1 ? ' (parallel: ' + data.parallel + ')' : ' (sequential)';
+        if (data.inProgress) {
+            html += ' <span class="badge badge-blue">in progress</span>';
+        }
+        html += '</h2>';
+
+        html += '<table class="process-table timeline-table">';
+        html += '<thead><tr>';
+        html += '<th>Process</th>';
+        html += '<th>Group</th>';
+        html += '<th>Level</th>';
+        html += '<th>Start</th>';
+        html += '<th>Ready</th>';
+        html += '<th class="timeline-bar-header"></th>';
+        html += '</tr></thead>';
+        html += '<tbody>';
+
+        const procs = data.processes.slice().sort(function(a, b) {
+            return a.start_msec - b.start_msec;
+        });
+
+        for (const p of procs) {
+            const left = (100 * p.start_msec / total).toFixed(2);
+            const width = Math.max(100 * p.ready_msec / total, 0.5).toFixed(2);
+
+            html += '<tr>';
+            html += '<td>' + escapeHtml(p.name) + '</td>';
+            html += '<td>' + escapeHtml(p.group || '-') + '</td>';
+            html += '<td>' + p.level + '</td>';
+            html += '<td>' + p.start_msec + ' ms</td>';
+            html += '<td>' + (p.ok ? p.ready_msec + ' ms' : '<span style="color:var(--accent-red)">failed</span>') + '</td>';
+            html += '<td class="timeline-cell"><div class="timeline-bar' + (p.ok ? '' : ' fail') + '"';
+            html += ' style="margin-left:' + left + '%;width:' + width + '%"></div></td>';
+            html += '</tr>';
+        }
+
+        html += '</tbody></table>';
+        timelineDiv.innerHTML = html;
+    }
+
     function getStateDotClass(state) {
         switch(state.toLowerCase()) {
             case 'running':
@@ -57,6 +57,8 @@ static void print_help(const std::string& prog)
          << "  --html-template FILE Custom HTML template file\n"
          << "  --health-interval MS Health check interval in ms (default: from config, fallback 5000)\n"
          << "  --stop-timeout MS    Graceful shutdown timeout in ms (default: 5000)\n"
+         << "  --start-parallel N   Max processes started concurrently (default: from config, fallback 1 = sequential)\n"
+         << "  --telemetry-interval MS Resource telemetry interval in ms (0 = disabled; default: from config, fallback 0)\n"
          << "  --uniset-port PORT   UniSet/CORBA port (default: auto=UID+52809)\n"
          << "  --omni-logdir DIR    omniNames log directory (default: $TMPDIR/omniORB)\n"
          << "  --default-ready-check TYPE  Default readyCheck for processes (none, tcp:PORT, etc.)\n"
@@ -78,6 +80,9 @@ static void print_help(const std::string& prog)
          << "  POST /api/v2/launcher/process/{name}/start   - Start process\n"
          << "  GET  /api/v2/launcher/health                 - Health check (for Docker/K8s)\n"
          << "  GET  /api/v2/launcher/groups                 - Process groups\n"
+         << "  GET  /api/v2/launcher/timeline               - Boot timeline (per-process ready latency)\n"
+         << "  GET  /api/v2/launcher/telemetry              - Resource usage of processes (last samples)\n"
+         << "  GET  /api/v2/launcher/telemetry/{name}       - Resource usage history of a process\n"
          << "  GET  /api/v2/launcher/help                   - API help\n"
          << "\n"
          << "Whitelist/Blacklist examples:\n"
@@ -108,6 +113,8 @@ int main(int argc, char* argv[])
     std::string controlToken;
     std::string htmlTemplate;
     long healthInterval = -1; // -1 = not set on CLI
+    long startParallel = -1;  // -1 = not set on CLI
+    long telemetryInterval = -1;  // -1 = not set on CLI
     size_t stopTimeout = 5000;
     int unisetPort = 0;  // 0 means "not specified", will get from Configuration
     bool unisetPortSpecified = false;
@@ -210,6 +217,28 @@ int main(int argc, char* argv[])
             continue;
         }
 
+        if (arg == "--start-parallel" && i + 1 < argc)
+        {
+            startParallel = std::stol(argv[++i]);
+            if (startParallel <= 0)
+            {
+                cerr << "Error: --start-parallel must be > 0 (got " << startParallel << ")" << endl;
+                return 1;
+            }
+            continue;
+        }
+
+        if (arg == "--telemetry-interval" && i + 1 < argc)
+        {
+            telemetryInterval = std::stol(argv[++i]);
+            if (telemetryInterval < 0)
+            {
+                cerr << "Error: --telemetry-interval must be >= 0 (got " << telemetryInterval << ")" << endl;
+                return 1;
+            }
+            continue;
+        }
+
         if (arg == "--stop-timeout" && i + 1 < argc)
         {
             stopTimeout = std::stoul(argv[++i]);
@@ -394,6 +423,12 @@ int main(int argc, char* argv[])
         if (healthInterval > 0)
             config.healthCheckInterval_msec = static_cast<size_t>(healthInterval);
 
+        if (startParallel > 0)
+            config.startParallel = static_cast<size_t>(startParallel);
+
+        if (telemetryInterval >= 0)
+            config.telemetryInterval_msec = static_cast<size_t>(telemetryInterval);
+
         // Apply environment variables from config
         for (const auto& kv : config.environment)
             setenv(kv.first.c_str(), kv.second.c_str(), 0);
@@ -406,6 +441,9 @@ int main(int argc, char* argv[])
         pm.setHealthCheckInterval(config.healthCheckInterval_msec);
         pm.setRestartWindow(config.restartWindow_msec);
         pm.setStopTimeout(stopTimeout);
+        pm.setStartParallel(config.startParallel);
+        pm.setTelemetryInterval(config.telemetryInterval_msec);
+        pm.setTelemetryHistory(config.telemetryHistory);
         pm.setCommonArgs(config.commonArgs);
 
         if (!passthroughArgs.empty())
@@ -536,7 +574,8 @@ int main(int argc, char* argv[])
         else
         {
             if (pm.allRunning())
-                cout << "All processes started successfully" << endl;
+                cout << "All processes started successfully ("
+                     << pm.getBootTimeline().total_msec << " ms)" << endl;
             else
                 cerr << "Some processes failed to start (non-critical)" << endl;
 
@@ -479,6 +479,54 @@ TEST_CASE("ConfigLoader: healthCheck=none disables liveness", "[config][healthch
     REQUIRE(config.processes["proc1"].healthCheck.type == ReadyCheckType::None);
 }
 // -------------------------------------------------------------------------
+TEST_CASE("ConfigLoader: telemetry and resource limits", "[config][telemetry]")
+{
+    const char* configWithLimits = R"(<?xml version="1.0"?>
+<Config>
+  <Launcher name="Test" telemetryInterval="2000" telemetryHistory="60">
+    <ProcessGroups>
+      <group name="test" order="0">
+        <process name="proc1" command="/bin/true" cpuLimit="80" rssLimit="256" limitAction="restart" limitFailThreshold="5"/>
+        <process name="proc2" command="/bin/true" rssLimit="100"/>
+        <process name="proc3" command="/bin/true"/>
+      </group>
+    </ProcessGroups>
+  </Launcher>
+</Config>
+)";
+    TempConfigFile cfg(configWithLimits);
+
+    ConfigLoader loader;
+    auto config = loader.load(cfg.path(), "Test");
+
+    REQUIRE(config.telemetryInterval_msec == 2000);
+    REQUIRE(config.telemetryHistory == 60);
+
+    REQUIRE(config.processes["proc1"].cpuLimit == 80);
+    REQUIRE(config.processes["proc1"].rssLimit_kb == 256 * 1024);
+    REQUIRE(config.processes["proc1"].limitRestart == true);
+    REQUIRE(config.processes["proc1"].limitFailThreshold == 5);
+
+    // default action is warning only
+    REQUIRE(config.processes["proc2"].rssLimit_kb == 100 * 1024);
+    REQUIRE(config.processes["proc2"].limitRestart == false);
+    REQUIRE(config.processes["proc2"].limitFailThreshold == 3);
+
+    REQUIRE(config.processes["proc3"].cpuLimit == 0);
+    REQUIRE(config.processes["proc3"].rssLimit_kb == 0);
+}
+// -------------------------------------------------------------------------
+TEST_CASE("ConfigLoader: telemetry disabled by default", "[config][telemetry]")
+{
+    TempConfigFile cfg(TEST_CONFIG);
+
+    ConfigLoader loader;
+    auto config = loader.load(cfg.path(), "TestLauncher");
+
+    REQUIRE(config.telemetryInterval_msec == 0);
+    REQUIRE(config.telemetryHistory == 120);
+}
+// -------------------------------------------------------------------------
 TEST_CASE("ProcessInfo: healthFailCount reset", "[processinfo][healthcheck]")
 {
     ProcessInfo proc;
@@ -7,6 +7,7 @@
  */
 // -------------------------------------------------------------------------
 #include <catch.hpp>
+#include <algorithm>
 #include "DependencyResolver.h"
 // -------------------------------------------------------------------------
 using namespace uniset;
@@ -185,3 +186,39 @@ TEST_CASE("DependencyResolver: clear", "[dependency]")
     REQUIRE(resolver.resolve().empty());
 }
 // -------------------------------------------------------------------------
+TEST_CASE("DependencyResolver: resolveLevels", "[dependency]")
+{
+    DependencyResolver resolver;
+    resolver.addGroup("naming");
+    resolver.addGroup("sm", {"naming"});
+    resolver.addGroup("unet", {"sm"});
+    resolver.addGroup("modbus", {"sm"});
+    resolver.addGroup("logdb", {"naming"});
+    resolver.addGroup("gui", {"unet", "logdb"});
+
+    auto levels = resolver.resolveLevels();
+    REQUIRE(levels.size() == 4);
+
+    REQUIRE(levels[0] == std::vector<std::string> {"naming"});
+
+    // logdb depends only on naming, so it starts together with sm
+    REQUIRE(levels[1].size() == 2);
+    REQUIRE(std::find(levels[1].begin(), levels[1].end(), "sm") != levels[1].end());
+    REQUIRE(std::find(levels[1].begin(), levels[1].end(), "logdb") != levels[1].end());
+
+    REQUIRE(levels[2].size() == 2);
+    REQUIRE(std::find(levels[2].begin(), levels[2].end(), "unet") != levels[2].end());
+    REQUIRE(std::find(levels[2].begin(), levels[2].end(), "modbus") != levels[2].end());
+
+    REQUIRE(levels[3] == std::vector<std::string> {"gui"});
+}
+// -------------------------------------------------------------------------
+TEST_CASE("DependencyResolver: resolveLevels cyclic dependency throws", "[dependency]")
+{
+    DependencyResolver resolver;
+    resolver.addGroup("a", {"b"});
+    resolver.addGroup("b", {"a"});
+
+    REQUIRE_THROWS_AS(resolver.resolveLevels(), CyclicDependencyException);
+}
+// -------------------------------------------------------------------------
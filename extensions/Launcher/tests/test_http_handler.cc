@@ -362,6 +362,22 @@ TEST_CASE("HTTP: GET groups - with groups", "[http][integration]")
     REQUIRE(foundGroup2);
 }
 // -------------------------------------------------------------------------
+// GET /api/v2/launcher/timeline
+// -------------------------------------------------------------------------
+TEST_CASE("HTTP: GET timeline - before startup", "[http][integration]")
+{
+    HTTPServerTestFixture fixture;
+
+    auto json = fixture.httpGet("launcher/timeline");
+
+    REQUIRE(json->getValue<bool>("inProgress") == false);
+    REQUIRE(json->getValue<int>("parallel") == 1);
+    REQUIRE(json->getValue<int>("count") == 0);
+
+    auto processes = json->getArray("processes");
+    REQUIRE(processes->size() == 0);
+}
+// -------------------------------------------------------------------------
 // POST /api/v2/launcher/process/{name}/restart
 // -------------------------------------------------------------------------
 TEST_CASE("HTTP: POST process/{name}/restart - not found", "[http][integration]")
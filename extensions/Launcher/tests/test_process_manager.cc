@@ -1292,3 +1292,116 @@ TEST_CASE("ProcessManager: restartAll starts all when everything stopped", "[int
     pm.stopAll();
 }
 // -------------------------------------------------------------------------
+TEST_CASE("ProcessManager: parallel startup by dependency levels", "[integration][parallel]")
+{
+    ProcessManager pm;
+    silenceLog(pm);
+    pm.setNodeName("Node1");
+    pm.setStopTimeout(1000);
+    pm.setStartParallel(4);
+    REQUIRE(pm.getStartParallel() == 4);
+
+    ProcessGroup g1;
+    g1.name = "base";
+    g1.order = 0;
+    g1.processes = {"base1"};
+    pm.addGroup(g1);
+
+    ProcessGroup g2;
+    g2.name = "workers";
+    g2.order = 1;
+    g2.depends = {"base"};
+    g2.processes = {"w1", "w2", "w3"};
+    pm.addGroup(g2);
+
+    for (const auto& name : {"base1", "w1", "w2", "w3"})
+    {
+        ProcessInfo proc;
+        proc.name = name;
+        proc.command = "/bin/sleep";
+        proc.args = {"60"};
+        proc.group = (std::string(name) == "base1") ? "base" : "workers";
+        pm.addProcess(proc);
+    }
+
+    REQUIRE(pm.startAll() == true);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    for (const auto& name : {"base1", "w1", "w2", "w3"})
+        REQUIRE(pm.getProcessState(name) == ProcessState::Running);
+
+    auto t = pm.getBootTimeline();
+    REQUIRE_FALSE(t.inProgress);
+    REQUIRE(t.parallel == 4);
+    REQUIRE(t.processes.size() == 4);
+
+    for (const auto& e : t.processes)
+    {
+        REQUIRE(e.ok);
+        REQUIRE(e.level == (e.name == "base1" ? 0 : 1));
+        REQUIRE(e.start_msec + e.ready_msec <= t.total_msec);
+    }
+
+    pm.stopAll();
+}
+// -------------------------------------------------------------------------
+TEST_CASE("ProcessManager: setStartParallel clamps to 1", "[manager][parallel]")
+{
+    ProcessManager pm;
+    pm.setStartParallel(0);
+    REQUIRE(pm.getStartParallel() == 1);
+}
+// -------------------------------------------------------------------------
+TEST_CASE("ProcessManager: telemetry samples and restart on resource limit", "[integration][telemetry]")
+{
+    ProcessManager pm;
+    silenceLog(pm);
+    pm.setNodeName("Node1");
+    pm.setStopTimeout(1000);
+    pm.setHealthCheckInterval(100);
+    pm.setTelemetryInterval(100);
+    pm.setTelemetryHistory(50);
+
+    ProcessGroup group;
+    group.name = "test";
+    group.order = 0;
+    group.processes = {"normal", "hungry"};
+    pm.addGroup(group);
+
+    ProcessInfo normal;
+    normal.name = "normal";
+    normal.command = "/bin/sleep";
+    normal.args = {"60"};
+    normal.group = "test";
+    pm.addProcess(normal);
+
+    // any running process uses more than 1 kB
+    ProcessInfo hungry = normal;
+    hungry.name = "hungry";
+    hungry.rssLimit_kb = 1;
+    hungry.limitRestart = true;
+    hungry.limitFailThreshold = 2;
+    pm.addProcess(hungry);
+
+    REQUIRE(pm.startAll() == true);
+    const auto pid = pm.getProcessInfo("hungry").pid;
+    REQUIRE(pid > 0);
+
+    pm.startMonitoring();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+    pm.stopMonitoring();
+
+    // samples are collected
+    ProcStatSample s;
+    REQUIRE(pm.telemetry().last("normal", s));
+    REQUIRE(s.rss_kb > 0);
+    REQUIRE(pm.telemetry().history("normal").size() > 2);
+
+    // process over the limit was restarted
+    auto info = pm.getProcessInfo("hungry");
+    REQUIRE(info.pid != pid);
+    REQUIRE(info.lastError.find("resource limit") != std::string::npos);
+
+    pm.stopAll();
+}
+// -------------------------------------------------------------------------
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2026 Pavel Vainerman.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, version 2.1.
+ */
+// -------------------------------------------------------------------------
+#include <catch.hpp>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <unistd.h>
+#include "ProcessTelemetry.h"
+// -------------------------------------------------------------------------
+using namespace uniset;
+// -------------------------------------------------------------------------
+TEST_CASE("ProcessTelemetry: parseStat", "[telemetry]")
+{
+    // comm with spaces and parentheses
+    const std::string stat = "1234 (my (proc) x) S 1 1234 1234 0 -1 4194560 100 0 0 0 "
+                             "150 50 0 0 20 0 7 0 100 12345678 256 18446744073709551615";
+
+    ProcStatCounters c;
+    REQUIRE(ProcessTelemetry::parseStat(stat, c));
+    REQUIRE(c.threads == 7);
+    REQUIRE(c.rss_kb == 256 * static_cast<size_t>(::sysconf(_SC_PAGESIZE)) / 1024);
+    REQUIRE(c.cpuTime_nsec == 200 * (1000000000ULL / ::sysconf(_SC_CLK_TCK)));
+
+    REQUIRE_FALSE(ProcessTelemetry::parseStat("garbage", c));
+    REQUIRE_FALSE(ProcessTelemetry::parseStat("1 (x) S 1 2 3", c));
+}
+// -------------------------------------------------------------------------
+TEST_CASE("ProcessTelemetry: parseStatus", "[telemetry]")
+{
+    const std::string status = "Name:\ttest\n"
+                               "VmRSS:\t   10240 kB\n"
+                               "Threads:\t5\n"
+                               "voluntary_ctxt_switches:\t100\n"
+                               "nonvoluntary_ctxt_switches:\t7\n";
+
+    ProcStatCounters c;
+    REQUIRE(ProcessTelemetry::parseStatus(status, c));
+    REQUIRE(c.rss_kb == 10240);
+    REQUIRE(c.threads == 5);
+    REQUIRE(c.volCtxSwitches == 100);
+    REQUIRE(c.nonvolCtxSwitches == 7);
+}
+// -------------------------------------------------------------------------
+TEST_CASE("ProcessTelemetry: parseIO and parseSchedStat", "[telemetry]")
+{
+    ProcStatCounters c;
+    REQUIRE(ProcessTelemetry::parseIO("rchar: 1000\nwchar: 2000\nsyscr: 5\n", c));
+    REQUIRE(c.hasIO);
+    REQUIRE(c.readBytes == 1000);
+    REQUIRE(c.writeBytes == 2000);
+
+    REQUIRE(ProcessTelemetry::parseSchedStat("5000000 1000000 42\n", c));
+    REQUIRE(c.hasSchedStat);
+    REQUIRE(c.cpuTime_nsec == 5000000);
+    REQUIRE(c.runDelay_nsec == 1000000);
+
+    ProcStatCounters e;
+    REQUIRE_FALSE(ProcessTelemetry::parseIO("", e));
+    REQUIRE_FALSE(e.hasIO);
+}
+// -------------------------------------------------------------------------
+TEST_CASE("ProcessTelemetry: makeSample", "[telemetry]")
+{
+    ProcStatCounters prev;
+    prev.hasIO = true;
+    prev.hasSchedStat = true;
+
+    ProcStatCounters cur = prev;
+    cur.cpuTime_nsec = 500000000;  // 0.5 sec of CPU time
+    cur.runDelay_nsec = 100000000;
+    cur.volCtxSwitches = 30;
+    cur.nonvolCtxSwitches = 10;
+    cur.readBytes = 4000;
+    cur.writeBytes = 2000;
+    cur.rss_kb = 1024;
+    cur.threads = 3;
+
+    auto s = ProcessTelemetry::makeSample(prev, cur, 2.0);
+    REQUIRE(s.cpu == Approx(25.0));
+    REQUIRE(s.runDelay == Approx(5.0));
+    REQUIRE(s.ctxSwitches == Approx(20.0));
+    REQUIRE(s.nonvolCtxSwitches == Approx(5.0));
+    REQUIRE(s.readRate == Approx(2000.0));
+    REQUIRE(s.writeRate == Approx(1000.0));
+    REQUIRE(s.rss_kb == 1024);
+    REQUIRE(s.threads == 3);
+
+    // counters must not go backwards (broken reading)
+    auto z = ProcessTelemetry::makeSample(cur, prev, 1.0);
+    REQUIRE(z.cpu == 0.0);
+    REQUIRE(z.readRate == 0.0);
+}
+// -------------------------------------------------------------------------
+TEST_CASE("ProcessTelemetry: sample own process", "[telemetry]")
+{
+    ProcessTelemetry tm(3);
+    const pid_t pid = ::getpid();
+
+    ProcStatCounters c;
+    REQUIRE(ProcessTelemetry::readCounters(pid, c));
+    REQUIRE(c.threads >= 1);
+    REQUIRE(c.rss_kb > 0);
+
+    // first call only stores the baseline
+    REQUIRE_FALSE(tm.sample("self", pid));
+
+    ProcStatSample s;
+    REQUIRE_FALSE(tm.last("self", s));
+
+    for (int i = 0; i < 5; i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        REQUIRE(tm.sample("self", pid));
+    }
+
+    // history is bounded
+    REQUIRE(tm.history("self").size() == 3);
+    REQUIRE(tm.last("self", s));
+    REQUIRE(s.rss_kb > 0);
+    REQUIRE(s.cpu >= 0.0);
+
+    tm.setHistorySize(2);
+    REQUIRE(tm.history("self").size() == 2);
+
+    tm.remove("self");
+    REQUIRE(tm.history("self").empty());
+
+    // not existing process
+    REQUIRE_FALSE(tm.sample("none", 0));
+}
+// -------------------------------------------------------------------------
+TEST_CASE("ProcessTelemetry: counters of non-main threads", "[telemetry]")
+{
+    ProcessTelemetry tm;
+    const pid_t pid = ::getpid();
+
+    std::atomic_bool started(false);
+    std::atomic_bool done(false);
+    std::atomic_bool finish(false);
+
+    // The main thread only waits: CPU time and context switches come from the worker.
+    // The worker stays alive until the second reading (counters of exited threads are lost).
+    std::thread worker([&]
+    {
+        while (!started)
+            std::this_thread::yield();
+
+        auto t0 = std::chrono::steady_clock::now();
+
+        while (std::chrono::steady_clock::now() - t0 < std::chrono::milliseconds(500))
+        {
+        }
+
+        for (int i = 0; i < 200; i++)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        done = true;
+
+        while (!finish)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    });
+
+    REQUIRE_FALSE(tm.sample("threads", pid));
+    started = true;
+
+    while (!done)
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    const bool ok = tm.sample("threads", pid);
+    finish = true;
+    worker.join();
+    REQUIRE(ok);
+
+    ProcStatSample s;
+    REQUIRE(tm.last("threads", s));
+    REQUIRE(s.threads >= 2);
+
+    // 500 ms of busy loop within an interval of ~0.7 sec
+    REQUIRE(s.cpu > 30.0);
+
+    // at least 200 sleeps of the worker (the main thread woke up ~15 times)
+    auto h = tm.history("threads");
+    REQUIRE(h.size() == 1);
+    REQUIRE(s.ctxSwitches > 100.0);
+}
+// -------------------------------------------------------------------------
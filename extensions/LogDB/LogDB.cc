@@ -138,7 +138,10 @@ LogDB::LogDB( const string& name, int argc, const char* const* argv, const strin
     if( numOverflow == 0 )
         numOverflow = maxdbRecords;
 
-    dbinfo << myname << "(init): maxdbRecords=" << maxdbRecords << " numOverflow=" << numOverflow << endl;
+    partitionPeriod_sec = uniset::getArgPInt("--" + prefix + "db-partition-period", argc, argv, it.getProp("dbPartitionPeriod"), partitionPeriod_sec);
+
+    dbinfo << myname << "(init): maxdbRecords=" << maxdbRecords << " numOverflow=" << numOverflow
+           << " partitionPeriod=" << partitionPeriod_sec << " sec" << endl;
 
     flushBufferTimer.set<LogDB, &LogDB::onCheckBuffer>(this);
     wsactivate.set<LogDB, &LogDB::onActivate>(this);
@@ -244,17 +247,12 @@ LogDB::LogDB( const string& name, int argc, const char* const* argv, const strin
             throw uniset::SystemError(err.str());
         }
 
-        db = unisetstd::make_unique<SQLiteInterface>();
+        bool fts = ( uniset::findArgParam("--" + prefix + "db-fts-disable", argc, argv) == -1 );
 
-        if( !db->connect(dbfile, false, SQLITE_OPEN_FULLMUTEX) )
-        {
-            ostringstream err;
-            err << myname
-                << "(init): DB connection error: "
-                << db->error();
-            dbcrit << err.str() << endl;
-            throw uniset::SystemError(err.str());
-        }
+        db = unisetstd::make_unique<LogDBStorage>(dblog);
+        db->setMaxRecords(maxdbRecords, numOverflow);
+        db->setPartitionPeriod(partitionPeriod_sec);
+        db->open(dbfile, fts);
     }
 
 #ifndef DISABLE_REST_API
@@ -435,83 +433,17 @@ void LogDB::onTerminate( ev::sig& evsig, int revents )
 }
 //--------------------------------------------------------------------------------------------
 void LogDB::flushBuffer()
-{
-    if( !db || qbuf.empty() || !db->isConnection() )
-        return;
-
-    // без BEGIN и COMMIT вставка большого количества данных будет тормозить!
-    db->query("BEGIN;");
-
-    while( !qbuf.empty() )
-    {
-        if( !db->insert(qbuf.front()) )
-        {
-            dbcrit << myname << "(flushBuffer): error: " << db->error()
-                   << " lost query: " << qbuf.front() << endl;
-        }
-
-        qbuf.pop();
-    }
-
-    db->query("COMMIT;");
-
-    if( !db->lastQueryOK() )
-    {
-        dbcrit << myname << "(flushBuffer): error: " << db->error() << endl;
-    }
-
-    // вызываем каждый раз, для отслеживания переполнения..
-    rotateDB();
-}
-//--------------------------------------------------------------------------------------------
-void LogDB::rotateDB()
 {
     if( !db )
         return;
 
-    // ротация отключена
-    if( maxdbRecords == 0 )
-        return;
-
-    size_t num = getCountOfRecords();
-
-    if( num <= numOverflow )
-        return;
-
-    dblog2 << myname << "(rotateDB): num=" << num << " > " << numOverflow << endl;
-
-    size_t firstOldID = getFirstOfOldRecord(numOverflow);
-
-    DBResult ret = db->query("DELETE FROM logs WHERE id <= " + std::to_string(firstOldID) + ";");
-
-    if( !db->lastQueryOK() )
-    {
-        dbwarn << myname << "(rotateDB): delete error: " << db->error() << endl;
-    }
-
-    ret = db->query("VACUUM;");
-
-    if( !db->lastQueryOK() )
-    {
-        dbwarn << myname << "(rotateDB): vacuum error: " << db->error() << endl;
-    }
-
-    //  dblog3 <<  myname << "(rotateDB): after rotate: " << getCountOfRecords() << " records" << endl;
+    // вставка пачкой в одной транзакции и ротация (см. LogDBStorage)
+    db->flush();
 }
 //--------------------------------------------------------------------------------------------
 void LogDB::addLog( LogDB::Log* log, const string& txt )
 {
-    auto tm = uniset::now_to_timespec();
-
-    ostringstream q;
-
-    q << "INSERT INTO logs(tms,usec,name,text) VALUES("
-      << "datetime(" << tm.tv_sec << ",'unixepoch'),'"   //  timestamp
-      << tm.tv_nsec << "','"  //  usec
-      << log->name << "','"
-      << qEscapeString(txt) << "');";
-
-    qbuf.emplace(q.str());
+    db->add(log->name, uniset::now_to_timespec(), txt);
 }
 //--------------------------------------------------------------------------------------------
 void LogDB::log2File( LogDB::Log* log, const string& txt )
@@ -524,32 +456,7 @@ void LogDB::log2File( LogDB::Log* log, const string& txt )
 //--------------------------------------------------------------------------------------------
 size_t LogDB::getCountOfRecords( const std::string& logname )
 {
-    ostringstream q;
-
-    q << "SELECT count(*) FROM logs";
-
-    if( !logname.empty() )
-        q << " WHERE name='" << logname << "'";
-
-    DBResult ret = db->query(q.str());
-
-    if( !ret )
-        return 0;
-
-    return (size_t) ret.begin().as_int(0);
-}
-//--------------------------------------------------------------------------------------------
-size_t LogDB::getFirstOfOldRecord( size_t maxnum )
-{
-    ostringstream q;
-
-    q << "SELECT id FROM logs order by id DESC limit " << maxnum << ",1";
-    DBResult ret = db->query(q.str());
-
-    if( !ret )
-        return 0;
-
-    return (size_t) ret.begin().as_int(0);
+    return db->count(logname);
 }
 //--------------------------------------------------------------------------------------------
 std::shared_ptr<LogDB> LogDB::init_logdb( int argc, const char* const* argv, const std::string& prefix )
@@ -575,6 +482,8 @@ void LogDB::help_print()
     cout << "--prefix-db-buffer-size sz                  - Размер буфера (до скидывания в БД)." << endl;
     cout << "--prefix-db-max-records sz                  - Максимальное количество записей в БД. При превышении, старые удаляются. 0 - не удалять" << endl;
     cout << "--prefix-db-overflow-factor float           - Коэффициент переполнения, после которого запускается удаление старых записей. По умолчанию: 1.3" << endl;
+    cout << "--prefix-db-partition-period sec            - Период создания нового раздела БД. 0 - только по количеству записей. По умолчанию: 3600 сек" << endl;
+    cout << "--prefix-db-fts-disable                     - Не использовать полнотекстовый индекс (FTS5) для поиска" << endl;
     cout << "--prefix-db-disable                         - Отключить запись в БД" << endl;
     cout << "--prefix-db-timestamp-format localtime|utc  - Формат времени в ответе на запросы. По умолчанию: localtime" << endl;
     cout << endl;
@@ -672,7 +581,7 @@ void LogDB::onCheckBuffer(ev::timer& t, int revents)
         return;
     }
 
-    if( qbuf.size() >= qbufSize )
+    if( db->bufferSize() >= qbufSize )
         flushBuffer();
 }
 // -----------------------------------------------------------------------------
@@ -979,21 +888,6 @@ void LogDB::Log::close()
     iocmd.stop();
 }
 // -----------------------------------------------------------------------------
-std::string LogDB::qEscapeString( const string& txt )
-{
-    ostringstream ret;
-
-    for( const auto& c : txt )
-    {
-        ret << c;
-
-        if( c == '\'' || c == '"' )
-            ret << c;
-    }
-
-    return ret.str();
-}
-// -----------------------------------------------------------------------------
 #ifndef DISABLE_REST_API
 // -----------------------------------------------------------------------------
 class LogDBRequestHandler:
@@ -1240,6 +1134,7 @@ void LogDB::handleRequest( Poco::Net::HTTPServerRequest& req, Poco::Net::HTTPSer
             l.param("from='YYYY-MM-DD'", "From date");
             l.param("to='YYYY-MM-DD'", "To date");
             l.param("last=XX[m|h|d|M]", "Last records (m - minute, h - hour, d - day, M - month)");
+            l.param("text=str", "Search records containing the text");
             l.param("offset=N", "offset");
             l.param("limit=M", "limit records for response");
             myhelp.add(l);
@@ -1370,44 +1265,29 @@ Poco::JSON::Object::Ptr LogDB::httpGetLogs( Poco::Net::HTTPServerResponse& resp,
 
     const auto& logname = params[0].first;
 
-    size_t offset = 0;
-    size_t limit = 0;
-
-    vector<std::string> q_where;
+    LogDBStorage::Query q;
+    q.name = logname;
+    q.tmsFormat = tmsFormat;
 
     for( const auto& p : params )
     {
         if( p.first == "offset" )
-            offset = uni_atoi(p.second);
+            q.offset = uni_atoi(p.second);
         else if( p.first == "limit" )
-            limit = uni_atoi(p.second);
+            q.limit = uni_atoi(p.second);
         else if( p.first == "from" )
-            q_where.push_back("tms>='" + qDate(p.second) + " 00:00:00'");
+            q.from = std::max(q.from, qDate(p.second) + " 00:00:00");
         else if( p.first == "to" )
-            q_where.push_back("tms<='" + qDate(p.second) + " 23:59:59'");
+            q.to = qDate(p.second) + " 23:59:59";
         else if( p.first == "last" )
-            q_where.push_back(qLast(p.second));
+            q.from = std::max(q.from, LogDBStorage::tmsString(time(nullptr) - qLast(p.second)));
+        else if( p.first == "text" )
+            q.text = p.second;
     }
 
     Poco::JSON::Array::Ptr jlist = uniset::json::make_child_array(jdata, "logs");
 
-    ostringstream q;
-
-    q << "SELECT tms,"
-      << " strftime('%d-%m-%Y',datetime(tms,'" << tmsFormat << "')) as date,"
-      << " strftime('%H:%M:%S',datetime(tms,'" << tmsFormat << "')) as time,"
-      << " usec, text FROM logs WHERE name='" << logname << "'";
-
-    if( !q_where.empty() )
-    {
-        for( const auto& w : q_where )
-            q << " AND " << w;
-    }
-
-    if( limit > 0 )
-        q << " ORDER BY tms ASC LIMIT " << offset << "," << limit;
-
-    DBResult ret = db->query(q.str());
+    DBResult ret = db->select(q);
 
     if( !ret )
         return jdata;
@@ -1481,8 +1361,10 @@ Poco::JSON::Object::Ptr LogDB::httpGetStatus( Poco::Net::HTTPServerResponse& res
     if( db )
     {
         jdata->set("db_records", getCountOfRecords());
-        jdata->set("db_buffer_size", qbuf.size());
+        jdata->set("db_buffer_size", db->bufferSize());
         jdata->set("db_max_records", maxdbRecords);
+        jdata->set("db_partitions", db->numPartitions());
+        jdata->set("db_fts", db->isFTS());
     }
     else
     {
@@ -1586,44 +1468,26 @@ bool LogDB::supportsGzip( Poco::Net::HTTPServerRequest& request )
     return false;
 }
 // -----------------------------------------------------------------------------
-string LogDB::qLast( const string& p )
+size_t LogDB::qLast( const string& p )
 {
     if( p.empty() )
-        return "";
+        return 0;
 
     char unit =  p[p.size() - 1];
     std::string sval = p.substr(0, p.size() - 1);
 
     if( unit == 'h' || unit == 'H' )
-    {
-        size_t h = uni_atoi(sval);
-        ostringstream q;
-        q << "tms >= strftime('%s',datetime('now')) - " << h << "*60*60";
-        return q.str();
-    }
-    else if( unit == 'd' || unit == 'D' )
-    {
-        size_t d = uni_atoi(sval);
-        ostringstream q;
-        q << "tms >= strftime('%s',datetime('now')) - " << d << "*24*60*60";
-        return q.str();
-    }
-    else if( unit == 'M' )
-    {
-        size_t m = uni_atoi(sval);
-        ostringstream q;
-        q << "tms >= strftime('%s',datetime('now')) - " << m << "*30*24*60*60";
-        return q.str();
-    }
-    else // по умолчанию минут
-    {
-        size_t m = (unit == 'm') ? uni_atoi(sval) : uni_atoi(p);
-        ostringstream q;
-        q << "tms >= strftime('%s',datetime('now')) - " << m << "*60";
-        return q.str();
-    }
+        return uni_atoi(sval) * 60 * 60;
+
+    if( unit == 'd' || unit == 'D' )
+        return uni_atoi(sval) * 24 * 60 * 60;
+
+    if( unit == 'M' )
+        return uni_atoi(sval) * 30 * 24 * 60 * 60;
 
-    return "";
+    // по умолчанию минут
+    size_t m = (unit == 'm') ? uni_atoi(sval) : uni_atoi(p);
+    return m * 60;
 }
 // -----------------------------------------------------------------------------
 string LogDB::qDate( const string& p, const char sep )
@@ -36,7 +36,7 @@
 #include "UniSetTypes.h"
 #include "LogAgregator.h"
 #include "DebugStream.h"
-#include "SQLiteInterface.h"
+#include "LogDBStorage.h"
 #include "EventLoopServer.h"
 #include "UTCPStream.h"
 #include "LogReader.h"
@@ -93,10 +93,6 @@ namespace uniset
             void log2File( Log* log, const std::string& txt );
 
             size_t getCountOfRecords( const std::string& logname = "" );
-            size_t getFirstOfOldRecord( size_t maxnum );
-
-            // экранирование кавычек (удваивание для sqlite)
-            static std::string qEscapeString( const std::string& s );
 
 #ifndef DISABLE_REST_API
             Poco::JSON::Object::Ptr respError( Poco::Net::HTTPServerResponse& resp, Poco::Net::HTTPResponse::HTTPStatus s, const std::string& message );
@@ -116,9 +112,9 @@ namespace uniset
 
             bool supportsGzip( Poco::Net::HTTPServerRequest& request );
 
-            // формирование условия where для строки XX[m|h|d|M]
+            // перевод строки XX[m|h|d|M] в секунды
             // XX m - минут, h-часов, d-дней, M - месяцев
-            static std::string qLast( const std::string& p );
+            static size_t qLast( const std::string& p );
 
             // преобразование в дату 'YYYY-MM-DD' из строки 'YYYYMMDD' или 'YYYY/MM/DD'
             static std::string qDate(const std::string& p, const char sep = '-');
@@ -129,7 +125,7 @@ namespace uniset
 
 #endif
             std::string myname;
-            std::unique_ptr<SQLiteInterface> db;
+            std::unique_ptr<LogDBStorage> db;
             std::string dbfile;
 
             std::string tmsFormat = { "localtime" }; /*!< формат возвращаемого времени */
@@ -137,17 +133,15 @@ namespace uniset
             bool activate = { false };
             std::chrono::steady_clock::time_point startTime;
 
-            typedef std::queue<std::string> QueryBuffer;
-            QueryBuffer qbuf;
             size_t qbufSize = { 1000 }; // размер буфера сообщений.
 
             ev::timer flushBufferTimer;
             double tmFlushBuffer_sec = { 1.0 };
             void flushBuffer();
-            void rotateDB();
 
             size_t maxdbRecords = { 200 * 1000 };
             size_t numOverflow = { 0 }; // вычисляется из параметра "overflow factor"(float)
+            size_t partitionPeriod_sec = { 3600 }; // период создания нового раздела БД
 
             ev::sig sigTERM;
             ev::sig sigQUIT;
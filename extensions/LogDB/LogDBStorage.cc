@@ -0,0 +1,734 @@
+/*
+ * Copyright (c) 2025 Pavel Vainerman.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, version 2.1.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+// --------------------------------------------------------------------------
+/*! \file
+ *  \author Pavel Vainerman
+*/
+// --------------------------------------------------------------------------
+#include <sstream>
+#include <algorithm>
+#include <cctype>
+#include "unisetstd.h"
+#include "Exceptions.h"
+#include "LogDBStorage.h"
+#include "LogDBSugar.h"
+// --------------------------------------------------------------------------
+using namespace uniset;
+using namespace std;
+// --------------------------------------------------------------------------
+// максимальное количество разделов в представлении logs (ограничение sqlite на UNION)
+static const size_t MaxViewPartitions = 500;
+static const std::string PartPrefix = "logs_p";
+// --------------------------------------------------------------------------
+LogDBStorage::LogDBStorage( const std::shared_ptr<DebugStream>& log ):
+    dblog(log)
+{
+}
+// --------------------------------------------------------------------------
+LogDBStorage::~LogDBStorage()
+{
+    close();
+}
+// --------------------------------------------------------------------------
+void LogDBStorage::open( const std::string& dbfile, bool useFTS )
+{
+    db = unisetstd::make_unique<SQLiteInterface>();
+
+    if( !db->connect(dbfile, false, SQLITE_OPEN_FULLMUTEX) )
+    {
+        ostringstream err;
+        err << "(LogDBStorage): DB connection error: " << db->error();
+        dbcrit << err.str() << endl;
+        throw uniset::SystemError(err.str());
+    }
+
+    fts = false;
+
+    if( useFTS )
+    {
+        // проверяем, что sqlite собран с поддержкой FTS5
+        fts = exec("CREATE VIRTUAL TABLE temp.logdb_fts_check USING fts5(text)");
+
+        if( fts )
+            exec("DROP TABLE temp.logdb_fts_check");
+        else
+            dbwarn << "(LogDBStorage): FTS5 is not supported by sqlite. Text search will use LIKE" << endl;
+    }
+
+    migrateLegacyTable();
+    loadPartitions();
+
+    if( parts.empty() )
+        createPartition(time(nullptr));
+    else
+    {
+        updateView();
+        prepareStatements();
+    }
+
+    if( parts.empty() )
+    {
+        ostringstream err;
+        err << "(LogDBStorage): can't create partition: " << db->error();
+        dbcrit << err.str() << endl;
+        throw uniset::SystemError(err.str());
+    }
+
+    dbinfo << "(LogDBStorage): open " << dbfile
+           << " partitions: " << parts.size()
+           << " records: " << count()
+           << " fts: " << fts << endl;
+}
+// --------------------------------------------------------------------------
+void LogDBStorage::close()
+{
+    finalizeStatements();
+
+    if( db )
+        db->close();
+}
+// --------------------------------------------------------------------------
+bool LogDBStorage::exec( const std::string& q )
+{
+    sqlite3_stmt* st = db->prepare(q);
+
+    if( !st )
+        return false;
+
+    bool ret = db->execute(st);
+    db->finalize(st);
+
+    if( !ret )
+        dblog3 << "(LogDBStorage): '" << q << "' error: " << db->error() << endl;
+
+    return ret;
+}
+// --------------------------------------------------------------------------
+void LogDBStorage::setMaxRecords( size_t max, size_t overflow )
+{
+    maxRecords = max;
+    numOverflow = std::max(max, overflow);
+
+    // размер раздела выбираем так, чтобы удаление самого старого раздела
+    // возвращало количество записей примерно к maxRecords
+    if( maxRecords == 0 )
+        partMaxRecords = 0;
+    else if( numOverflow > maxRecords )
+        partMaxRecords = numOverflow - maxRecords;
+    else
+        partMaxRecords = std::max(maxRecords / 10, (size_t)1);
+}
+// --------------------------------------------------------------------------
+void LogDBStorage::setPartitionPeriod( size_t sec )
+{
+    partitionPeriod = sec;
+}
+// --------------------------------------------------------------------------
+bool LogDBStorage::isFTS() const
+{
+    return fts;
+}
+// --------------------------------------------------------------------------
+size_t LogDBStorage::numPartitions()
+{
+    uniset_rwmutex_rlock l(pmutex);
+    return parts.size();
+}
+// --------------------------------------------------------------------------
+void LogDBStorage::migrateLegacyTable()
+{
+    DBResult r = db->query("SELECT type FROM sqlite_master WHERE name='logs'");
+
+    if( !r || r.begin().as_string(0) != "table" )
+        return;
+
+    // таблица старого формата становится первым разделом
+    dbinfo << "(LogDBStorage): convert table 'logs' to partition '" << PartPrefix << "0'" << endl;
+
+    if( !exec("ALTER TABLE logs RENAME TO " + PartPrefix + "0") )
+    {
+        ostringstream err;
+        err << "(LogDBStorage): can't convert table 'logs': " << db->error();
+        dbcrit << err.str() << endl;
+        throw uniset::SystemError(err.str());
+    }
+}
+// --------------------------------------------------------------------------
+void LogDBStorage::loadPartitions()
+{
+    DBResult r = db->query("SELECT name FROM sqlite_master WHERE type='table' AND name GLOB '" + PartPrefix + "[0-9]*'");
+
+    std::deque<Partition> lst;
+
+    for( auto it = r.begin(); it != r.end(); ++it )
+    {
+        const std::string t = it.as_string(0);
+        const std::string num = t.substr(PartPrefix.size());
+
+        // служебные таблицы FTS (logs_pNNN_fts...)
+        if( num.empty() || !std::all_of(num.begin(), num.end(), ::isdigit) )
+            continue;
+
+        Partition p;
+        p.table = t;
+        p.created = std::stoll(num);
+        initPartition(p, false);
+        lst.push_back(p);
+    }
+
+    std::sort(lst.begin(), lst.end(), []( const Partition & a, const Partition & b )
+    {
+        return a.created < b.created;
+    });
+
+    uniset_rwmutex_wrlock l(pmutex);
+    parts = std::move(lst);
+}
+// --------------------------------------------------------------------------
+bool LogDBStorage::initPartition( Partition& p, bool isnew )
+{
+    if( isnew )
+    {
+        // id без AUTOINCREMENT: номера всё-равно не переиспользуются до удаления всего раздела
+        if( !exec("CREATE TABLE " + p.table + " ("
+                  "id INTEGER PRIMARY KEY,"
+                  "tms timestamp KEY default (strftime('%s', 'now')),"
+                  "usec INTEGER(5) NOT NULL,"
+                  "name TEXT KEY NOT NULL,"
+                  "text TEXT)") )
+            return false;
+    }
+
+    // выборка и подсчёт всегда идут по имени лога
+    exec("CREATE INDEX IF NOT EXISTS " + p.table + "_name ON " + p.table + "(name, tms)");
+
+    if( !isnew )
+    {
+        DBResult r = db->query("SELECT count(*), min(tms), max(tms) FROM " + p.table);
+
+        if( r )
+        {
+            auto it = r.begin();
+            p.records = it.as_int(0);
+            p.tstart = it.as_string(1);
+            p.tend = it.as_string(2);
+        }
+    }
+
+    const std::string ftable = p.table + "_fts";
+    DBResult r = db->query("SELECT name FROM sqlite_master WHERE name='" + ftable + "'");
+    const bool exist = !r.empty();
+
+    if( fts && !exist )
+    {
+        if( !exec("CREATE VIRTUAL TABLE " + ftable + " USING fts5(text, content='" + p.table + "', content_rowid='id')") )
+        {
+            dbwarn << "(LogDBStorage): can't create fts index for " << p.table << ": " << db->error() << endl;
+            return isnew;
+        }
+
+        if( !isnew && p.records > 0 )
+        {
+            dbinfo << "(LogDBStorage): build fts index for " << p.table << " (" << p.records << " records).." << endl;
+            exec("INSERT INTO " + ftable + "(" + ftable + ") VALUES('rebuild')");
+        }
+    }
+    else if( !fts && exist )
+    {
+        // индекс не будет обновляться, поэтому удаляем (при включении будет построен заново)
+        exec("DROP TABLE " + ftable);
+    }
+
+    return true;
+}
+// --------------------------------------------------------------------------
+void LogDBStorage::createPartition( time_t now )
+{
+    Partition p;
+    p.created = now;
+
+    {
+        uniset_rwmutex_rlock l(pmutex);
+
+        if( !parts.empty() && p.created <= parts.back().created )
+            p.created = parts.back().created + 1;
+    }
+
+    p.table = PartPrefix + std::to_string(p.created);
+
+    if( !initPartition(p, true) )
+    {
+        dbcrit << "(LogDBStorage): can't create partition " << p.table << ": " << db->error() << endl;
+        return;
+    }
+
+    dblog2 << "(LogDBStorage): new partition " << p.table << endl;
+
+    finalizeStatements();
+
+    {
+        uniset_rwmutex_wrlock l(pmutex);
+        parts.push_back(p);
+    }
+
+    updateView();
+    prepareStatements();
+}
+// --------------------------------------------------------------------------
+bool LogDBStorage::dropPartition()
+{
+    uniset_rwmutex_wrlock l(pmutex);
+
+    if( parts.size() < 2 )
+        return false;
+
+    const Partition& p = parts.front();
+
+    if( fts )
+        exec("DROP TABLE IF EXISTS " + p.table + "_fts");
+
+    if( !exec("DROP TABLE " + p.table) )
+    {
+        dbwarn << "(LogDBStorage): can't drop partition " << p.table << ": " << db->error() << endl;
+        return false;
+    }
+
+    dblog2 << "(LogDBStorage): drop partition " << p.table << " (" << p.records << " records)" << endl;
+    parts.pop_front();
+    return true;
+}
+// --------------------------------------------------------------------------
+void LogDBStorage::updateView()
+{
+    exec("DROP VIEW IF EXISTS logs");
+
+    std::string cur;
+    ostringstream q;
+    q << "CREATE VIEW logs AS ";
+
+    {
+        uniset_rwmutex_rlock l(pmutex);
+
+        if( parts.empty() )
+            return;
+
+        if( parts.size() > MaxViewPartitions )
+            dbwarn << "(LogDBStorage): view 'logs' contains only the last " << MaxViewPartitions << " partitions" << endl;
+
+        const size_t first = parts.size() > MaxViewPartitions ? parts.size() - MaxViewPartitions : 0;
+
+        for( size_t i = first; i < parts.size(); i++ )
+        {
+            if( i != first )
+                q << " UNION ALL ";
+
+            q << "SELECT id,tms,usec,name,text FROM " << parts[i].table;
+        }
+
+        cur = parts.back().table;
+    }
+
+    if( !exec(q.str()) )
+    {
+        dbwarn << "(LogDBStorage): can't create view 'logs': " << db->error() << endl;
+        return;
+    }
+
+    // вставка через представление (например uniset2-logdb-conv) попадает в текущий раздел
+    ostringstream t;
+    t << "CREATE TRIGGER logs_insert INSTEAD OF INSERT ON logs BEGIN"
+      << " INSERT INTO " << cur << "(tms,usec,name,text) VALUES(new.tms,new.usec,new.name,new.text);";
+
+    if( fts )
+        t << " INSERT INTO " << cur << "_fts(rowid,text) VALUES(last_insert_rowid(),new.text);";
+
+    t << " END";
+
+    if( !exec(t.str()) )
+        dbwarn << "(LogDBStorage): can't create trigger for view 'logs': " << db->error() << endl;
+}
+// --------------------------------------------------------------------------
+void LogDBStorage::prepareStatements()
+{
+    finalizeStatements();
+
+    std::string cur;
+
+    {
+        uniset_rwmutex_rlock l(pmutex);
+
+        if( parts.empty() )
+            return;
+
+        cur = parts.back().table;
+    }
+
+    stInsert = db->prepare("INSERT INTO " + cur + "(tms,usec,name,text) VALUES(?,?,?,?)");
+
+    if( !stInsert )
+        dbcrit << "(LogDBStorage): " << db->error() << endl;
+
+    if( fts )
+    {
+        stInsertFTS = db->prepare("INSERT INTO " + cur + "_fts(rowid,text) VALUES(?,?)");
+
+        if( !stInsertFTS )
+            dbwarn << "(LogDBStorage): " << db->error() << endl;
+    }
+}
+// --------------------------------------------------------------------------
+void LogDBStorage::finalizeStatements()
+{
+    if( !db )
+        return;
+
+    db->finalize(stInsert);
+    db->finalize(stInsertFTS);
+    stInsert = nullptr;
+    stInsertFTS = nullptr;
+}
+// --------------------------------------------------------------------------
+void LogDBStorage::add( const std::string& name, const timespec& tm, const std::string& text )
+{
+    buf.push_back({name, tm, text});
+    bufSize = buf.size();
+}
+// --------------------------------------------------------------------------
+size_t LogDBStorage::bufferSize() const
+{
+    return bufSize;
+}
+// --------------------------------------------------------------------------
+void LogDBStorage::checkPartition( time_t now )
+{
+    bool need = false;
+
+    {
+        uniset_rwmutex_rlock l(pmutex);
+
+        if( parts.empty() )
+            need = true;
+        else
+        {
+            const Partition& cur = parts.back();
+
+            if( partitionPeriod > 0 && cur.records > 0 && now >= cur.created + (time_t)partitionPeriod )
+                need = true;
+            else if( partMaxRecords > 0 && cur.records >= partMaxRecords )
+                need = true;
+        }
+    }
+
+    if( need )
+        createPartition(now);
+}
+// --------------------------------------------------------------------------
+void LogDBStorage::flush()
+{
+    if( !db || buf.empty() || !db->isConnection() )
+        return;
+
+    checkPartition(time(nullptr));
+
+    if( !stInsert )
+    {
+        dbcrit << "(LogDBStorage): insert is not prepared. Lost " << buf.size() << " records" << endl;
+        buf.clear();
+        bufSize = 0;
+        return;
+    }
+
+    // без BEGIN и COMMIT вставка большого количества данных будет тормозить!
+    db->query("BEGIN;");
+
+    size_t added = 0;
+    std::string tmin;
+    std::string tmax;
+    time_t lastsec = 0;
+    std::string tms;
+
+    for( const auto& r : buf )
+    {
+        if( tms.empty() || r.tm.tv_sec != lastsec )
+        {
+            lastsec = r.tm.tv_sec;
+            tms = tmsString(lastsec);
+        }
+
+        sqlite3_bind_text(stInsert, 1, tms.data(), tms.size(), SQLITE_STATIC);
+        sqlite3_bind_int64(stInsert, 2, r.tm.tv_nsec);
+        sqlite3_bind_text(stInsert, 3, r.name.data(), r.name.size(), SQLITE_STATIC);
+        sqlite3_bind_text(stInsert, 4, r.text.data(), r.text.size(), SQLITE_STATIC);
+
+        if( !db->execute(stInsert) )
+        {
+            dbcrit << "(LogDBStorage): insert error: " << db->error()
+                   << " lost: " << r.name << ": " << r.text << endl;
+            continue;
+        }
+
+        if( stInsertFTS )
+        {
+            sqlite3_bind_int64(stInsertFTS, 1, (sqlite3_int64)db->insert_id());
+            sqlite3_bind_text(stInsertFTS, 2, r.text.data(), r.text.size(), SQLITE_STATIC);
+
+            if( !db->execute(stInsertFTS) )
+                dbwarn << "(LogDBStorage): fts insert error: " << db->error() << endl;
+        }
+
+        if( tmin.empty() )
+            tmin = tms;
+
+        tmax = tms;
+        added++;
+    }
+
+    db->query("COMMIT;");
+
+    if( !db->lastQueryOK() )
+        dbcrit << "(LogDBStorage): commit error: " << db->error() << endl;
+
+    buf.clear();
+    bufSize = 0;
+
+    if( added > 0 )
+    {
+        uniset_rwmutex_wrlock l(pmutex);
+        Partition& cur = parts.back();
+        cur.records += added;
+
+        if( cur.tstart.empty() )
+            cur.tstart = tmin;
+
+        if( tmax > cur.tend )
+            cur.tend = tmax;
+    }
+
+    // вызываем каждый раз, для отслеживания переполнения..
+    rotate();
+}
+// --------------------------------------------------------------------------
+void LogDBStorage::rotate()
+{
+    // ротация отключена
+    if( maxRecords == 0 )
+        return;
+
+    bool dropped = false;
+
+    while( true )
+    {
+        size_t num = count();
+
+        if( num <= numOverflow )
+            break;
+
+        dblog2 << "(LogDBStorage): num=" << num << " > " << numOverflow << endl;
+
+        // текущий раздел не удаляется
+        if( !dropPartition() )
+            break;
+
+        dropped = true;
+    }
+
+    if( dropped )
+        updateView();
+}
+// --------------------------------------------------------------------------
+size_t LogDBStorage::count( const std::string& name )
+{
+    uniset_rwmutex_rlock l(pmutex);
+
+    size_t num = 0;
+
+    if( name.empty() )
+    {
+        for( const auto& p : parts )
+            num += p.records;
+
+        return num;
+    }
+
+    // по индексу (name, tms)
+    for( const auto& p : parts )
+    {
+        DBResult r = db->query("SELECT count(*) FROM " + p.table + " WHERE name='" + qEscapeString(name) + "'");
+
+        if( r )
+            num += r.begin().as_int(0);
+    }
+
+    return num;
+}
+// --------------------------------------------------------------------------
+bool LogDBStorage::inRange( const Partition& p, const Query& q ) const
+{
+    // границы известны, только если время хранится в формате 'YYYY-MM-DD HH:MM:SS'
+    auto isDate = []( const std::string & s )
+    {
+        return s.size() == 19 && s[4] == '-';
+    };
+
+    if( !isDate(p.tstart) || !isDate(p.tend) )
+        return true;
+
+    if( !q.from.empty() && p.tend < q.from )
+        return false;
+
+    if( !q.to.empty() && p.tstart > q.to )
+        return false;
+
+    return true;
+}
+// --------------------------------------------------------------------------
+std::string LogDBStorage::condition( const Partition& p, const Query& q ) const
+{
+    ostringstream w;
+    w << "name='" << qEscapeString(q.name) << "'";
+
+    if( !q.from.empty() )
+        w << " AND tms>='" << qEscapeString(q.from) << "'";
+
+    if( !q.to.empty() )
+        w << " AND tms<='" << qEscapeString(q.to) << "'";
+
+    if( !q.text.empty() )
+    {
+        if( fts )
+        {
+            // ищем как фразу (кавычки внутри удваиваются)
+            std::string phrase = "\"";
+
+            for( const auto& c : q.text )
+            {
+                if( c == '"' )
+                    phrase += '"';
+
+                phrase += c;
+            }
+
+            phrase += "\"";
+
+            w << " AND id IN (SELECT rowid FROM " << p.table << "_fts WHERE "
+              << p.table << "_fts MATCH '" << qEscapeString(phrase) << "')";
+        }
+        else
+        {
+            std::string pattern;
+
+            for( const auto& c : q.text )
+            {
+                if( c == '%' || c == '_' || c == '\\' )
+                    pattern += '\\';
+
+                pattern += c;
+            }
+
+            w << " AND text LIKE '%" << qEscapeString(pattern) << "%' ESCAPE '\\'";
+        }
+    }
+
+    return w.str();
+}
+// --------------------------------------------------------------------------
+DBResult LogDBStorage::select( const Query& q )
+{
+    DBResult res;
+
+    uniset_rwmutex_rlock l(pmutex);
+
+    size_t offset = q.offset;
+    size_t limit = q.limit;
+
+    // разделы идут от старых к новым, поэтому результат упорядочен по времени
+    for( const auto& p : parts )
+    {
+        if( !inRange(p, q) )
+            continue;
+
+        const std::string where = condition(p, q);
+
+        // разделы, целиком попадающие в offset, пропускаем
+        if( limit > 0 && offset > 0 )
+        {
+            DBResult r = db->query("SELECT count(*) FROM " + p.table + " WHERE " + where);
+            size_t num = r ? r.begin().as_int(0) : 0;
+
+            if( num <= offset )
+            {
+                offset -= num;
+                continue;
+            }
+        }
+
+        ostringstream s;
+        s << "SELECT tms,"
+          << " strftime('%d-%m-%Y',datetime(tms,'" << q.tmsFormat << "')) as date,"
+          << " strftime('%H:%M:%S',datetime(tms,'" << q.tmsFormat << "')) as time,"
+          << " usec, text FROM " << p.table << " WHERE " << where;
+
+        if( limit > 0 )
+            s << " ORDER BY tms ASC, id ASC LIMIT " << offset << "," << limit;
+
+        offset = 0;
+
+        DBResult r = db->query(s.str());
+
+        if( !r )
+            continue;
+
+        if( limit > 0 )
+            limit -= std::min(limit, r.size());
+
+        if( res.empty() )
+            res = std::move(r);
+        else
+            res.row().insert(res.row().end(), r.row().begin(), r.row().end());
+
+        if( q.limit > 0 && limit == 0 )
+            break;
+    }
+
+    return res;
+}
+// --------------------------------------------------------------------------
+std::string LogDBStorage::tmsString( time_t sec )
+{
+    // так же как datetime(sec,'unixepoch') в sqlite
+    struct tm t;
+    gmtime_r(&sec, &t);
+
+    char buf[32];
+    strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &t);
+    return buf;
+}
+// --------------------------------------------------------------------------
+std::string LogDBStorage::qEscapeString( const string& txt )
+{
+    ostringstream ret;
+
+    for( const auto& c : txt )
+    {
+        ret << c;
+
+        if( c == '\'' )
+            ret << c;
+    }
+
+    return ret.str();
+}
+// --------------------------------------------------------------------------
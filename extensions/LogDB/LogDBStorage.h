@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2025 Pavel Vainerman.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, version 2.1.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+// --------------------------------------------------------------------------
+/*! \file
+ *  \author Pavel Vainerman
+*/
+// --------------------------------------------------------------------------
+#ifndef LogDBStorage_H_
+#define LogDBStorage_H_
+// --------------------------------------------------------------------------
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <atomic>
+#include <ctime>
+#include "Mutex.h"
+#include "DebugStream.h"
+#include "SQLiteInterface.h"
+// -------------------------------------------------------------------------
+namespace uniset
+{
+    //------------------------------------------------------------------------------------------
+    /*! Хранилище логов LogDB (SQLite).
+
+        Записи хранятся не в одной таблице, а в "разделах" (таблицы logs_pNNN, где NNN - время создания раздела).
+        Новый раздел создаётся по истечении partitionPeriod или при заполнении текущего раздела.
+        Ротация (ограничение количества записей) выполняется удалением самого старого раздела целиком (DROP TABLE),
+        а не построчным DELETE по всей таблице с последующим VACUUM.
+
+        Для совместимости с внешними утилитами (sqlite3, uniset2-logdb-conv) создаётся представление \b logs,
+        объединяющее все разделы, с триггером, перенаправляющим INSERT в текущий раздел.
+        Таблица logs старого формата (если есть) при открытии превращается в первый раздел.
+
+        Для поиска по тексту для каждого раздела строится индекс FTS5 (если sqlite собран с его поддержкой),
+        иначе поиск выполняется через LIKE.
+
+        Вставка выполняется пачкой (flush) через подготовленные запросы в одной транзакции.
+        Методы add() и flush() вызываются из одного потока (eventloop LogDB),
+        select() и count() могут вызываться из потоков http-сервера.
+    */
+    class LogDBStorage
+    {
+        public:
+            LogDBStorage( const std::shared_ptr<DebugStream>& log );
+            ~LogDBStorage();
+
+            /*! открыть БД (файл должен существовать, см. uniset2-logdb-adm create)
+             * \param fts - использовать полнотекстовый индекс (если доступен)
+             * throw SystemError
+             */
+            void open( const std::string& dbfile, bool fts = true );
+            void close();
+
+            /*! ограничение количества записей
+             * \param maxRecords - сколько записей оставлять (0 - не ограничивать)
+             * \param overflow - при каком количестве запускать удаление старых разделов
+             */
+            void setMaxRecords( size_t maxRecords, size_t overflow );
+
+            //! период создания нового раздела (0 - только по количеству записей)
+            void setPartitionPeriod( size_t sec );
+
+            //! добавить запись в буфер
+            void add( const std::string& name, const timespec& tm, const std::string& text );
+            size_t bufferSize() const;
+
+            //! записать буфер в БД (и выполнить ротацию)
+            void flush();
+
+            struct Query
+            {
+                std::string name;
+                std::string from; // 'YYYY-MM-DD HH:MM:SS' (UTC)
+                std::string to;   // 'YYYY-MM-DD HH:MM:SS' (UTC)
+                std::string text; // поиск по тексту
+                size_t offset = { 0 };
+                size_t limit = { 0 };
+                std::string tmsFormat = { "localtime" };
+            };
+
+            /*! выборка записей
+             * колонки: tms, date, time, usec, text
+             */
+            DBResult select( const Query& q );
+
+            //! количество записей (всего или для указанного лога)
+            size_t count( const std::string& name = "" );
+
+            size_t numPartitions();
+            bool isFTS() const;
+
+            //! время в формате, в котором оно хранится в БД (колонка tms)
+            static std::string tmsString( time_t sec );
+
+        protected:
+
+            struct Partition
+            {
+                std::string table;
+                time_t created = { 0 };
+                std::string tstart; // первая запись (tms)
+                std::string tend;   // последняя запись (tms)
+                size_t records = { 0 };
+            };
+
+            bool exec( const std::string& q );
+            void migrateLegacyTable();
+            void loadPartitions();
+            bool initPartition( Partition& p, bool isnew );
+            void createPartition( time_t now );
+            bool dropPartition(); // удалить самый старый раздел
+            void updateView();
+            void prepareStatements();
+            void finalizeStatements();
+            void rotate();
+            void checkPartition( time_t now );
+            bool inRange( const Partition& p, const Query& q ) const;
+            std::string condition( const Partition& p, const Query& q ) const;
+
+            static std::string qEscapeString( const std::string& s );
+
+        private:
+            std::shared_ptr<DebugStream> dblog;
+            std::unique_ptr<SQLiteInterface> db;
+            bool fts = { false };
+
+            struct Record
+            {
+                std::string name;
+                timespec tm;
+                std::string text;
+            };
+
+            std::vector<Record> buf;
+            std::atomic<size_t> bufSize = { 0 };
+
+            // список разделов (от старых к новым)
+            // изменяется только в потоке, вызывающем flush()
+            std::deque<Partition> parts;
+            uniset::uniset_rwmutex pmutex;
+
+            sqlite3_stmt* stInsert = { nullptr };
+            sqlite3_stmt* stInsertFTS = { nullptr };
+
+            size_t maxRecords = { 0 };
+            size_t numOverflow = { 0 };
+            size_t partMaxRecords = { 0 };
+            size_t partitionPeriod = { 3600 };
+    };
+    // ----------------------------------------------------------------------------------
+} // end of namespace uniset
+//------------------------------------------------------------------------------------------
+#endif
@@ -0,0 +1,418 @@
+#!/bin/sh
+
+# Тесты хранилища LogDB (LogDBStorage):
+# - преобразование таблицы logs старого формата в раздел
+# - поиск по тексту через FTS5 и через LIKE
+# - ротация (удаление старых разделов)
+# - ограничение количества разделов в представлении 'logs'
+
+set -u # Запрет использования необъявленных переменных
+
+trap '' HUP INT QUIT PIPE TERM
+
+RET=0
+LOGSERVER_PID=
+LOGDB_PID=
+dbfile="logdb-storage-tests.db"
+http_host="localhost"
+http_port=8889
+logdb_out="logdb-storage-tests.log"
+
+# shellcheck disable=SC2317
+atexit() {
+	trap - EXIT
+
+	logdb_stop
+	logserver_stop
+
+	rm -f "${dbfile}"* "$logdb_out"
+
+	exit $RET
+}
+
+trap atexit EXIT
+
+logdb_error() {
+	printf "✗ %20s: ERROR: %s\n" "$1" "$2" >&2
+}
+
+sql() {
+	echo "$1" | sqlite3 "$dbfile" 2>/dev/null
+}
+
+http_get() {
+	curl -s --fail --max-time 10 --request GET "http://$http_host:$http_port/api/v2/logdb/$1"
+}
+
+# количество записей в ответе /logs
+logs_count() {
+	echo "$1" | grep -o '"text":' | wc -l
+}
+
+# тексты записей в ответе /logs (отсортированные)
+logs_texts() {
+	echo "$1" | grep -o '"text":"[^"]*"' | sort
+}
+
+# ------------------------------------------------------------------------------------------
+create_legacy_db() {
+	rm -f "${dbfile}"*
+
+	if ! ./uniset2-logdb-adm create -f "$dbfile"; then
+		logdb_error "create_legacy_db" "failed to create test database"
+		return 1
+	fi
+
+	return 0
+}
+
+# добавить запись в таблицу (или представление) logs
+add_record() {
+	sql "INSERT INTO logs(tms,usec,name,text) VALUES(datetime('now'),0,'logserver1','$1');"
+}
+
+logserver_run() {
+	./uniset2-test-logserver -i localhost -p 3333 -d "$1" 1>/dev/null 2>/dev/null &
+	LOGSERVER_PID=$!
+
+	sleep 1
+	if ! kill -0 "$LOGSERVER_PID" 2>/dev/null; then
+		logdb_error "logserver_run" "logserver failed to start"
+		LOGSERVER_PID=
+		return 1
+	fi
+
+	return 0
+}
+
+logserver_stop() {
+	if [ -n "$LOGSERVER_PID" ]; then
+		kill "$LOGSERVER_PID" 2>/dev/null
+		sleep 1
+		kill -0 "$LOGSERVER_PID" 2>/dev/null && kill -9 "$LOGSERVER_PID" 2>/dev/null
+	fi
+
+	LOGSERVER_PID=
+}
+
+logdb_run() {
+	./uniset2-logdb --logdb-single-confile logdb-tests-conf.xml \
+		--logdb-dbfile "$dbfile" \
+		--logdb-httpserver-host "$http_host" \
+		--logdb-httpserver-port $http_port \
+		--logdb-ls-check-connection-sec 1 \
+		--logdb-log-add-levels crit,warn,level2 \
+		"$@" 1>"$logdb_out" 2>&1 &
+
+	LOGDB_PID=$!
+
+	# shellcheck disable=SC3043
+	local attempt=1
+
+	while [ $attempt -le 30 ]; do
+		if http_get status >/dev/null 2>&1; then
+			return 0
+		fi
+
+		if ! kill -0 "$LOGDB_PID" 2>/dev/null; then
+			break
+		fi
+
+		sleep 1
+		attempt=$((attempt + 1))
+	done
+
+	logdb_error "logdb_run" "LogDB failed to start"
+	cat "$logdb_out"
+	LOGDB_PID=
+	return 1
+}
+
+logdb_stop() {
+	if [ -n "$LOGDB_PID" ]; then
+		kill "$LOGDB_PID" 2>/dev/null
+		sleep 1
+		kill -0 "$LOGDB_PID" 2>/dev/null && kill -9 "$LOGDB_PID" 2>/dev/null
+	fi
+
+	LOGDB_PID=
+}
+
+# список разделов (от старых к новым)
+partitions() {
+	sql "SELECT name FROM sqlite_master WHERE type='table' AND name GLOB 'logs_p[0-9]*' AND name NOT GLOB '*_fts*' ORDER BY CAST(substr(name,7) AS INTEGER);"
+}
+
+# ------------------------------------------------------------------------------------------
+# БД, созданная старой версией (одна таблица logs), открывается без потери записей
+logdb_test_migration() {
+	create_legacy_db || return 1
+
+	add_record "legacy record 1"
+	add_record "legacy record 2"
+	add_record "legacy record 3"
+
+	logdb_run || return 1
+
+	if [ "$(sql "SELECT type FROM sqlite_master WHERE name='logs';")" != "view" ]; then
+		logdb_error "test_migration" "'logs' must be a view after migration"
+		logdb_stop
+		return 1
+	fi
+
+	if [ "$(partitions | head -1)" != "logs_p0" ]; then
+		logdb_error "test_migration" "legacy table must become partition 'logs_p0'. Partitions: $(partitions)"
+		logdb_stop
+		return 1
+	fi
+
+	CNT=$(sql "SELECT count(*) FROM logs_p0;")
+	if [ "$CNT" != "3" ]; then
+		logdb_error "test_migration" "logs_p0 must contain 3 records (got: '$CNT')"
+		logdb_stop
+		return 1
+	fi
+
+	REQ=$(http_get "logs?logserver1")
+	if [ "$(logs_count "$REQ")" != "3" ] || ! echo "$REQ" | grep -q "legacy record 3"; then
+		logdb_error "test_migration" "/logs must return 3 legacy records. Response: $REQ"
+		logdb_stop
+		return 1
+	fi
+
+	# вставка через представление (как uniset2-logdb-conv) попадает в текущий раздел
+	add_record "inserted via view"
+	logdb_stop
+
+	if [ "$(sql "SELECT count(*) FROM logs WHERE text='inserted via view';")" != "1" ]; then
+		logdb_error "test_migration" "insert via view 'logs' failed"
+		return 1
+	fi
+
+	# повторное открытие: разделы уже есть, преобразование не выполняется
+	logdb_run || return 1
+	CNT=$(sql "SELECT count(*) FROM logs;")
+	logdb_stop
+
+	if [ "$CNT" != "4" ]; then
+		logdb_error "test_migration" "after restart 'logs' must contain 4 records (got: '$CNT')"
+		return 1
+	fi
+
+	echo "✓ Migration test passed"
+	return 0
+}
+
+# ------------------------------------------------------------------------------------------
+# поиск по тексту через FTS5 и через LIKE должен давать одинаковый результат
+# (FTS ищет по словам, LIKE по подстроке, поэтому данные подобраны так, чтобы это не влияло)
+logdb_search() {
+	for t in "AI1" "100%25" "under_score" "value%3D10" "no-such-text"; do
+		echo "== $t"
+		logs_texts "$(http_get "logs?logserver1&text=$t")"
+	done
+}
+
+logdb_test_search() {
+	create_legacy_db || return 1
+
+	add_record "sensor AI1 value=10"
+	add_record "sensor AI2 value=20"
+	add_record "pump started at 100% load"
+	add_record "text with under_score"
+	add_record "other message"
+
+	# ожидаемые результаты
+	expected=$(
+		cat <<'_EOF_'
+== AI1
+"text":"sensor AI1 value=10"
+== 100%25
+"text":"pump started at 100% load"
+== under_score
+"text":"text with under_score"
+== value%3D10
+"text":"sensor AI1 value=10"
+== no-such-text
+_EOF_
+	)
+
+	# FTS
+	logdb_run || return 1
+	REQ=$(http_get status)
+	fts_res=$(logdb_search)
+	logdb_stop
+
+	have_fts=0
+	echo "CREATE VIRTUAL TABLE t USING fts5(x);" | sqlite3 :memory: 2>/dev/null && have_fts=1
+
+	if [ $have_fts -eq 1 ] && ! echo "$REQ" | grep -q '"db_fts":true'; then
+		logdb_error "test_search" "FTS5 is available, but not used. Status: $REQ"
+		return 1
+	fi
+
+	# LIKE
+	logdb_run --logdb-db-fts-disable || return 1
+	REQ=$(http_get status)
+	like_res=$(logdb_search)
+	logdb_stop
+
+	if ! echo "$REQ" | grep -q '"db_fts":false'; then
+		logdb_error "test_search" "FTS must be disabled. Status: $REQ"
+		return 1
+	fi
+
+	if [ "$like_res" != "$expected" ]; then
+		logdb_error "test_search" "unexpected LIKE search result"
+		echo "$like_res"
+		return 1
+	fi
+
+	if [ "$fts_res" != "$like_res" ]; then
+		logdb_error "test_search" "FTS and LIKE search results differ"
+		echo "FTS:"
+		echo "$fts_res"
+		echo "LIKE:"
+		echo "$like_res"
+		return 1
+	fi
+
+	# индекс был удалён при работе без FTS и должен быть построен заново
+	logdb_run || return 1
+	fts_res=$(logdb_search)
+	logdb_stop
+
+	if [ "$fts_res" != "$expected" ]; then
+		logdb_error "test_search" "unexpected search result after index rebuild"
+		echo "$fts_res"
+		return 1
+	fi
+
+	echo "✓ Search (FTS/LIKE) test passed"
+	return 0
+}
+
+# ------------------------------------------------------------------------------------------
+# ротация: при переполнении удаляется самый старый раздел, а не отдельные записи
+logdb_test_rotation() {
+	create_legacy_db || return 1
+
+	logserver_run 10 || return 1
+
+	# max-records=200, overflow=300 => раздел не больше 100 записей
+	logdb_run --logdb-db-buffer-size 10 \
+		--logdb-db-max-records 200 \
+		--logdb-db-overflow-factor 1.5 \
+		--logdb-db-partition-period 0 || return 1
+
+	first=
+	dropped=0
+	attempt=1
+
+	while [ $attempt -le 30 ]; do
+		sleep 1
+		attempt=$((attempt + 1))
+
+		p=$(partitions | head -1)
+		[ -z "$p" ] && continue
+		[ -z "$first" ] && first="$p" && continue
+
+		if [ "$p" != "$first" ]; then
+			dropped=1
+			break
+		fi
+	done
+
+	logserver_stop
+	sleep 2
+
+	CNT=$(sql "SELECT count(*) FROM logs;")
+	NPARTS=$(partitions | wc -l)
+	logdb_stop
+
+	if [ $dropped -eq 0 ]; then
+		logdb_error "test_rotation" "the oldest partition '$first' was not dropped"
+		return 1
+	fi
+
+	if [ -z "$CNT" ] || [ "$CNT" -eq 0 ] || [ "$CNT" -gt 300 ]; then
+		logdb_error "test_rotation" "count of records must be in (0, 300] (got: '$CNT')"
+		return 1
+	fi
+
+	if [ "$NPARTS" -gt 4 ]; then
+		logdb_error "test_rotation" "too many partitions after rotation: $NPARTS"
+		return 1
+	fi
+
+	if ! grep -q "(LogDBStorage): drop partition $first" "$logdb_out"; then
+		logdb_error "test_rotation" "not found 'drop partition $first' in LogDB log"
+		return 1
+	fi
+
+	echo "✓ Rotation test passed: partitions=$NPARTS records=$CNT"
+	return 0
+}
+
+# ------------------------------------------------------------------------------------------
+# представление 'logs' содержит не больше 500 (MaxViewPartitions) последних разделов,
+# HTTP API при этом работает со всеми разделами
+logdb_test_max_view_partitions() {
+	rm -f "${dbfile}"*
+
+	i=1
+	{
+		echo "BEGIN;"
+		while [ $i -le 501 ]; do
+			echo "CREATE TABLE logs_p$i (id INTEGER PRIMARY KEY, tms timestamp KEY default (strftime('%s', 'now')), usec INTEGER(5) NOT NULL, name TEXT KEY NOT NULL, text TEXT);"
+			echo "INSERT INTO logs_p$i(tms,usec,name,text) VALUES(datetime('now'),0,'logserver1','record $i');"
+			i=$((i + 1))
+		done
+		echo "COMMIT;"
+	} | sqlite3 "$dbfile"
+
+	logdb_run --logdb-db-fts-disable || return 1
+
+	REQ=$(http_get status)
+	CNT=$(http_get "count?logserver1")
+	VIEW_CNT=$(sql "SELECT count(*) FROM logs;")
+	VIEW_FIRST=$(sql "SELECT min(text) FROM logs WHERE text='record 1';")
+	logdb_stop
+
+	if ! grep -q "view 'logs' contains only the last 500 partitions" "$logdb_out"; then
+		logdb_error "test_max_view_partitions" "not found warning about view partitions limit in LogDB log"
+		return 1
+	fi
+
+	if ! echo "$REQ" | grep -q '"db_partitions":501'; then
+		logdb_error "test_max_view_partitions" "status must report 501 partitions. Status: $REQ"
+		return 1
+	fi
+
+	if [ "$VIEW_CNT" != "500" ] || [ -n "$VIEW_FIRST" ]; then
+		logdb_error "test_max_view_partitions" "view 'logs' must contain the last 500 partitions (count: '$VIEW_CNT')"
+		return 1
+	fi
+
+	if ! echo "$CNT" | grep -q '"count":501'; then
+		logdb_error "test_max_view_partitions" "/count must use all partitions. Response: $CNT"
+		return 1
+	fi
+
+	echo "✓ View partitions limit test passed"
+	return 0
+}
+
+# ------------------------------------------------------------------------------------------
+logdb_test_migration || RET=1
+logdb_test_search || RET=1
+logdb_test_rotation || RET=1
+logdb_test_max_view_partitions || RET=1
+
+if [ $RET -eq 0 ]; then
+	echo "✓ All storage tests completed successfully!"
+else
+	echo "✗ Some storage tests failed (exit code: $RET)"
+fi
+
+exit $RET
@@ -15,6 +15,10 @@
  */
 // -------------------------------------------------------------------------
 #include <sstream>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <endian.h>
 #include "Exceptions.h"
 #include "MQTTPublisher.h"
 // -----------------------------------------------------------------------------
@@ -56,6 +60,9 @@ MQTTPublisher::MQTTPublisher(uniset::ObjectId objId, xmlNode* cnode, uniset::Obj
 
     myinfo << myname << "(init): filter-field=" << ff << " filter-value=" << fv << endl;
 
+    minInterval = conf->getArgPInt("--" + argprefix + "min-interval", it.getProp("minInterval"), 0);
+    deadband = conf->getArgInt("--" + argprefix + "deadband", it.getProp("deadband"));
+
     xmlNode* senssec = conf->getXMLSensorsSection();
 
     if( !senssec )
@@ -98,6 +105,9 @@ MQTTPublisher::MQTTPublisher(uniset::ObjectId objId, xmlNode* cnode, uniset::Obj
         pubname << topic << "/" << sname;
 
         MQTTInfo m(sid, pubname.str());
+        m.minInterval = sit.getPIntProp("mqtt_min_interval", minInterval);
+        m.deadband = sit.getPIntProp("mqtt_deadband", deadband);
+
         publist.emplace(sid, std::move(m) );
 
         if( smTestID == DefaultObjectId )
@@ -128,6 +138,79 @@ MQTTPublisher::MQTTPublisher(uniset::ObjectId objId, xmlNode* cnode, uniset::Obj
     host = conf->getArg2Param("--" + argprefix + "mqtt-host", it.getProp("mqttHost"), "localhost");
     port = conf->getArgPInt("--" + argprefix + "mqtt-port", it.getProp("mqttPort"), 1883);
     keepalive = conf->getArgPInt("--" + argprefix + "mqtt-keepalive", it.getProp("mqttKeepAlive"), 60);
+    qos = conf->getArgInt("--" + argprefix + "mqtt-qos", it.getProp2("mqttQoS", "1"));
+
+    if( qos < 0 || qos > 2 )
+    {
+        ostringstream err;
+        err << myname << "(init): bad mqtt QoS=" << qos << ". Must be 0, 1 or 2";
+        mycrit << err.str() << endl;
+        throw SystemError(err.str());
+    }
+
+    maxInflight = conf->getArgPInt("--" + argprefix + "max-inflight", it.getProp("maxInflight"), 0);
+
+    string mode = conf->getArg2Param("--" + argprefix + "publish-mode", it.getProp("publishMode"), "sensor");
+
+    if( mode == "batch" )
+        publishMode = pmBatch;
+    else if( mode == "sensor" )
+        publishMode = pmSensor;
+    else
+    {
+        ostringstream err;
+        err << myname << "(init): unknown publish mode '" << mode << "'. Must be 'sensor' or 'batch'";
+        mycrit << err.str() << endl;
+        throw SystemError(err.str());
+    }
+
+    batchTopic = conf->getArg2Param("--" + argprefix + "batch-topic", it.getProp("batchTopic"), topic + "/batch");
+    batchWindow = conf->getArgPInt("--" + argprefix + "batch-window", it.getProp("batchWindow"), batchWindow);
+    batchMaxItems = conf->getArgPInt("--" + argprefix + "batch-max-items", it.getProp("batchMaxItems"), batchMaxItems);
+    batchBufMax = conf->getArgPInt("--" + argprefix + "batch-buf-max", it.getProp("batchBufMax"), batchBufMax);
+    batchCoalesce = conf->getArgPInt("--" + argprefix + "batch-coalesce", it.getProp("batchCoalesce"), 1);
+
+    if( batchMaxItems == 0 )
+        batchMaxItems = 1;
+
+    string fmt = conf->getArg2Param("--" + argprefix + "batch-format", it.getProp("batchFormat"), "json");
+
+    if( fmt == "binary" )
+        batchFormat = bfBinary;
+    else if( fmt == "json" )
+        batchFormat = bfJSON;
+    else
+    {
+        ostringstream err;
+        err << myname << "(init): unknown batch format '" << fmt << "'. Must be 'json' or 'binary'";
+        mycrit << err.str() << endl;
+        throw SystemError(err.str());
+    }
+
+    if( publishMode == pmBatch )
+    {
+        flushTime = batchWindow;
+    }
+    else
+    {
+        // отложенные значения проверяем с периодом минимального из заданных интервалов
+        timeout_t tmin = 0;
+
+        for( const auto& i : publist )
+        {
+            if( i.second.minInterval > 0 && (tmin == 0 || i.second.minInterval < tmin) )
+                tmin = i.second.minInterval;
+        }
+
+        flushTime = tmin > 0 ? std::max(tmin, (timeout_t)10) : 100;
+        pendingList.reserve(publist.size());
+    }
+
+    myinfo << myname << "(init): publish mode=" << mode
+           << " qos=" << qos
+           << " maxInflight=" << maxInflight
+           << " flushTime=" << flushTime
+           << endl;
 
     // см. sysCommad()
     //  connect_async(host.c_str(),port,keepalive);
@@ -177,6 +260,17 @@ void MQTTPublisher::help_print( int argc, const char* const* argv )
     cout << "--prefix-mqtt-host host           - host(ip) MQTT Broker (server). Default: localhost" << endl;
     cout << "--prefix-mqtt-port port           - port for MQTT Broker (server). Default: 1883" << endl;
     cout << "--prefix-mqtt-keepalive val       - keepalive for connection to MQTT Broker (server). Default: 60" << endl;
+    cout << "--prefix-mqtt-qos [0|1|2]         - QoS for published messages. Default: 1" << endl;
+    cout << "--prefix-max-inflight num         - Макс. количество неподтверждённых сообщений (QoS>0). Default: 0 (без ограничений)" << endl;
+    cout << "--prefix-publish-mode sensor|batch - Режим публикации: по датчикам или пакетами. Default: sensor" << endl;
+    cout << "--prefix-min-interval msec        - (sensor) Мин. интервал между публикациями в топик датчика. Default: 0" << endl;
+    cout << "--prefix-deadband val             - (sensor) Не публиковать изменения меньше val. Default: 0" << endl;
+    cout << "--prefix-batch-topic name         - (batch) Топик для пакетов. Default: TOPIC/batch" << endl;
+    cout << "--prefix-batch-window msec        - (batch) Окно накопления изменений. Default: 100" << endl;
+    cout << "--prefix-batch-max-items num      - (batch) Макс. значений в одном сообщении. Default: 500" << endl;
+    cout << "--prefix-batch-coalesce [0|1]     - (batch) Только последнее значение датчика за окно. Default: 1" << endl;
+    cout << "--prefix-batch-buf-max num        - (batch) Макс. размер буфера при batch-coalesce=0. Default: 10000" << endl;
+    cout << "--prefix-batch-format json|binary - (batch) Формат пакета. Default: json" << endl;
     cout << endl;
     cout << " Logs: " << endl;
     cout << "--prefix-log-...            - log control" << endl;
@@ -197,6 +291,9 @@ void MQTTPublisher::on_connect(int rc)
     connectOK = ( rc == 0 );
     myinfo << myname << "(on_connect): connect to " << host << ":" <<  port << " " << ( connectOK ? "OK" : "FAIL" ) << endl;
 
+    // подтверждения на сообщения прошлого соединения уже не придут
+    inflight = 0;
+
     if( connectOK )
         askSensors(UniversalIO::UIONotify);
 
@@ -206,6 +303,15 @@ void MQTTPublisher::on_connect(int rc)
     //  }
 }
 // -----------------------------------------------------------------------------
+void MQTTPublisher::on_disconnect( int rc )
+{
+    // вызывается из потока mosquitto (rc=0 - штатное отключение).
+    // connectOK не сбрасываем: переподключением занимается цикл mosquitto (loop_start),
+    // а неподтверждённые сообщения потеряны вместе с соединением
+    inflight = 0;
+    mywarn << myname << "(on_disconnect): disconnect from " << host << ":" << port << " rc=" << rc << endl;
+}
+// -----------------------------------------------------------------------------
 void MQTTPublisher::on_message( const mosquitto_message* message )
 {
 
@@ -214,6 +320,18 @@ void MQTTPublisher::on_message( const mosquitto_message* message )
 void MQTTPublisher::on_subscribe( int mid, int qos_count, const int* granted_qos )
 {
 
+}
+// -----------------------------------------------------------------------------
+void MQTTPublisher::on_publish( int mid )
+{
+    // вызывается из потока mosquitto
+    // для QoS>0 - после подтверждения от брокера
+    if( qos == 0 )
+        return;
+
+    size_t n = inflight.load();
+
+    while( n > 0 && !inflight.compare_exchange_weak(n, n - 1) ) {}
 }
 // -----------------------------------------------------------------------------
 std::shared_ptr<MQTTPublisher> MQTTPublisher::init_mqttpublisher(int argc, const char* const* argv,
@@ -271,30 +389,329 @@ void MQTTPublisher::askSensors( UniversalIO::UIOCommand cmd )
 // -----------------------------------------------------------------------------
 void MQTTPublisher::sensorInfo( const uniset::SensorMessage* sm )
 {
-    auto i = publist.find(sm->id);
+    if( publishMode == pmBatch )
+        addToBatch(sm);
+    else
+    {
+        auto i = publist.find(sm->id);
+
+        if( i != publist.end() )
+        {
+            publishValue(&i->second, sm->value, std::chrono::steady_clock::now());
+
+            if( !pendingList.empty() && !timerIsOn )
+            {
+                timerIsOn = true;
+                askTimer(tmFlush, flushTime);
+            }
+        }
+    }
+
+    auto t = textpublist.find(sm->id);
+
+    if( t != textpublist.end() )
+        t->second.check(this, sm->value, mylog, myname);
+}
+// -----------------------------------------------------------------------------
+void MQTTPublisher::timerInfo( const uniset::TimerMessage* tm )
+{
+    if( tm->id != tmFlush )
+        return;
+
+    bool empty = true;
+
+    if( publishMode == pmBatch )
+    {
+        flushBatch();
+        empty = batch.empty();
+    }
+    else
+    {
+        flushPending();
+        empty = pendingList.empty();
+    }
+
+    if( empty && timerIsOn )
+    {
+        askTimer(tmFlush, 0);
+        timerIsOn = false;
+    }
+}
+// -----------------------------------------------------------------------------
+bool MQTTPublisher::inflightIsFull() const noexcept
+{
+    return ( qos > 0 && maxInflight > 0 && inflight >= maxInflight );
+}
+// -----------------------------------------------------------------------------
+bool MQTTPublisher::publishMessage( const std::string& topic, const std::string& msg )
+{
+    if( qos > 0 )
+        inflight++;
+
+    int ret = publish(NULL, topic.c_str(), msg.size(), msg.c_str(), qos, false);
 
-    if( i != publist.end() )
+    if( ret != MOSQ_ERR_SUCCESS )
     {
-        ostringstream m;
-        m << sm->value;
+        if( qos > 0 )
+            inflight--;
 
-        string tmsg(m.str());
+        errorCount++;
+        mycrit << myname << "(publishMessage): PUBLISH FAILED: topic='" << topic << "' err(" << ret << "): " << mosqpp::strerror(ret) << endl;
+        return false;
+    }
 
-        //subscribe(NULL, i.second.pubname.c_str());
-        myinfo << "(sensorInfo): publish: topic='" << i->second.pubname << "' msg='" << tmsg.c_str() << "'" << endl;
+    publishCount++;
+    return true;
+}
+// -----------------------------------------------------------------------------
+bool MQTTPublisher::publishValue( MQTTInfo* mi, long value, const std::chrono::steady_clock::time_point& now )
+{
+    if( mi->published && mi->deadband > 0 && std::labs(value - mi->lastValue) < mi->deadband )
+    {
+        // изменение в пределах зоны нечувствительности
+        // (отложенное значение тоже больше не нужно)
+        skipDeadband++;
+        mi->pending = false;
+        return false;
+    }
 
-        int ret = publish(NULL, i->second.pubname.c_str(), tmsg.size(), tmsg.c_str(), 1, false);
+    bool delay = inflightIsFull();
 
-        if( ret != MOSQ_ERR_SUCCESS )
+    if( !delay && mi->published && mi->minInterval > 0 )
+        delay = ( now - mi->lastTime < std::chrono::milliseconds(mi->minInterval) );
+
+    if( delay )
+    {
+        // сохраняем последнее значение, оно будет опубликовано позже (см. flushPending)
+        mi->pendingValue = value;
+
+        if( !mi->pending )
         {
-            mycrit << myname << "(sensorInfo): PUBLISH FAILED: err(" << ret << "): " << mosqpp::strerror(ret) << endl;
+            mi->pending = true;
+            pendingList.push_back(mi);
+            delayedCount++;
         }
+
+        return false;
     }
 
-    auto t = textpublist.find(sm->id);
+    const std::string tmsg = std::to_string(value);
 
-    if( t != textpublist.end() )
-        t->second.check(this, sm->value, mylog, myname);
+    myinfo << "(sensorInfo): publish: topic='" << mi->pubname << "' msg='" << tmsg << "'" << endl;
+
+    if( !publishMessage(mi->pubname, tmsg) )
+        return false;
+
+    mi->published = true;
+    mi->lastValue = value;
+    mi->lastTime = now;
+    mi->pending = false;
+    return true;
+}
+// -----------------------------------------------------------------------------
+void MQTTPublisher::flushPending()
+{
+    if( pendingList.empty() )
+        return;
+
+    const auto now = std::chrono::steady_clock::now();
+
+    size_t k = 0;
+
+    for( size_t i = 0; i < pendingList.size(); i++ )
+    {
+        MQTTInfo* mi = pendingList[i];
+
+        // значение могло быть уже опубликовано (или отброшено) из sensorInfo
+        if( !mi->pending )
+            continue;
+
+        // publishValue() при повторной задержке сам не добавит элемент в список (pending=true)
+        if( !publishValue(mi, mi->pendingValue, now) && mi->pending )
+            pendingList[k++] = mi;
+    }
+
+    pendingList.resize(k);
+}
+// -----------------------------------------------------------------------------
+void MQTTPublisher::addToBatch( const uniset::SensorMessage* sm )
+{
+    if( publist.find(sm->id) == publist.end() )
+        return;
+
+    if( batchCoalesce )
+    {
+        auto it = batchIndex.find(sm->id);
+
+        if( it != batchIndex.end() )
+        {
+            auto& b = batch[it->second];
+            b.value = sm->value;
+            b.tv = sm->sm_tv;
+            return;
+        }
+
+        batchIndex[sm->id] = batch.size();
+    }
+    else if( batch.size() >= batchBufMax )
+    {
+        // буфер переполнен (не успеваем публиковать) - отбрасываем самое старое значение
+        batch.pop_front();
+        lostCount++;
+    }
+
+    batch.push_back({sm->id, sm->value, sm->sm_tv});
+
+    if( batch.size() >= batchMaxItems )
+        flushBatch();
+
+    if( !batch.empty() && !timerIsOn )
+    {
+        timerIsOn = true;
+        askTimer(tmFlush, flushTime);
+    }
+}
+// -----------------------------------------------------------------------------
+bool MQTTPublisher::flushBatch()
+{
+    if( batch.empty() )
+        return true;
+
+    if( !connectOK )
+        return false;
+
+    size_t pos = 0;
+
+    while( pos < batch.size() && !inflightIsFull() )
+    {
+        const size_t end = std::min(pos + batchMaxItems, batch.size());
+
+        const std::string msg = ( batchFormat == bfBinary )
+                                ? makeBatchBinary(batch, pos, end)
+                                : makeBatchJSON(batch, pos, end);
+
+        mylog4 << myname << "(flushBatch): publish: topic='" << batchTopic << "' items=" << (end - pos)
+               << " bytes=" << msg.size() << endl;
+
+        if( !publishMessage(batchTopic, msg) )
+            break;
+
+        batchCount++;
+        pos = end;
+    }
+
+    if( pos == 0 )
+        return false;
+
+    batch.erase(batch.begin(), batch.begin() + pos);
+
+    if( batchCoalesce )
+    {
+        batchIndex.clear();
+
+        for( size_t i = 0; i < batch.size(); i++ )
+            batchIndex[batch[i].sid] = i;
+    }
+
+    return batch.empty();
+}
+// -----------------------------------------------------------------------------
+std::string MQTTPublisher::makeBatchJSON( const BatchBuffer& items, size_t beg, size_t end )
+{
+    auto conf = uniset_conf();
+
+    ostringstream s;
+    s << "[";
+
+    for( size_t i = beg; i < end; i++ )
+    {
+        const auto& b = items[i];
+
+        if( i != beg )
+            s << ",";
+
+        s << "{\"id\":" << b.sid
+          << ",\"name\":\"" << conf->oind->getShortName(b.sid) << "\""
+          << ",\"value\":" << b.value
+          << ",\"sec\":" << b.tv.tv_sec
+          << ",\"nsec\":" << b.tv.tv_nsec
+          << "}";
+    }
+
+    s << "]";
+    return s.str();
+}
+// -----------------------------------------------------------------------------
+std::string MQTTPublisher::makeBatchBinary( const BatchBuffer& items, size_t beg, size_t end )
+{
+    static const size_t headerSize = 8;
+    static const size_t recordSize = 28;
+
+    const uint32_t count = end - beg;
+    std::string msg(headerSize + recordSize * count, '\0');
+    char* p = &msg[0];
+
+    p[0] = 'U';
+    p[1] = 'M';
+    p[2] = 1; // version
+    p[3] = 0;
+
+    uint32_t c32 = htole32(count);
+    memcpy(p + 4, &c32, sizeof(c32));
+    p += headerSize;
+
+    for( size_t i = beg; i < end; i++ )
+    {
+        const auto& b = items[i];
+        uint64_t id = htole64((uint64_t)(int64_t)b.sid);
+        uint64_t val = htole64((uint64_t)(int64_t)b.value);
+        uint64_t sec = htole64((uint64_t)(int64_t)b.tv.tv_sec);
+        uint32_t nsec = htole32((uint32_t)b.tv.tv_nsec);
+
+        memcpy(p, &id, 8);
+        memcpy(p + 8, &val, 8);
+        memcpy(p + 16, &sec, 8);
+        memcpy(p + 24, &nsec, 4);
+        p += recordSize;
+    }
+
+    return msg;
+}
+// -----------------------------------------------------------------------------
+std::string MQTTPublisher::getMonitInfo() const
+{
+    ostringstream inf;
+
+    inf << "MQTT: " << host << ":" << port << " " << ( connectOK ? "CONNECTED" : "DISCONNECTED" ) << endl
+        << "  publish mode: " << ( publishMode == pmBatch ? "batch" : "sensor" )
+        << " qos=" << qos
+        << " inflight=" << inflight << "/" << maxInflight << endl;
+
+    if( publishMode == pmBatch )
+    {
+        inf << "  batch: topic='" << batchTopic << "'"
+            << " format=" << ( batchFormat == bfBinary ? "binary" : "json" )
+            << " window=" << batchWindow
+            << " maxItems=" << batchMaxItems
+            << " coalesce=" << batchCoalesce
+            << " buffer=" << batch.size() << endl;
+    }
+    else
+    {
+        inf << "  rate limit: minInterval=" << minInterval
+            << " deadband=" << deadband
+            << " pending=" << pendingList.size() << endl;
+    }
+
+    inf << "  statistics: published=" << publishCount
+        << " batches=" << batchCount
+        << " delayed=" << delayedCount
+        << " skipDeadband=" << skipDeadband
+        << " lost=" << lostCount
+        << " errors=" << errorCount
+        << endl;
+
+    return inf.str();
 }
 // -----------------------------------------------------------------------------
 MQTTPublisher::MQTTTextInfo::MQTTTextInfo( const string& rootsec, UniXML::iterator s, UniXML::iterator i ):
@@ -19,7 +19,11 @@
 // -----------------------------------------------------------------------------
 #include <unordered_map>
 #include <list>
+#include <vector>
+#include <deque>
 #include <memory>
+#include <atomic>
+#include <chrono>
 #include <mosquittopp.h>
 #include "UObject_SK.h"
 #include "SMInterface.h"
@@ -36,6 +40,8 @@ namespace uniset
       - \ref sec_MQTT_Comm
       - \ref sec_MQTT_Conf
       - \ref sec_MQTT_Text
+      - \ref sec_MQTT_Batch
+      - \ref sec_MQTT_Rate
 
     \section sec_MQTT_Comm Общее описание MQTTPublisher
 
@@ -104,6 +110,44 @@ namespace uniset
 
     \note Если заданные "одиночные" значения совпадают с диапазоном, то будет сгенерировано несколько сообщений. Т.е. диапазоны могут пересекаться.
 
+    \section sec_MQTT_Batch Пакетная публикация
+    По умолчанию каждое изменение датчика публикуется отдельным сообщением в свой топик.
+    При большом потоке изменений (запуск, "лавина" аварий) это приводит к десяткам тысяч маленьких
+    сообщений. Для таких случаев предусмотрен пакетный режим (--prefix-publish-mode batch или publishMode="batch"),
+    в котором изменения накапливаются в течение окна и публикуются одним сообщением в групповой топик.
+    - \b --prefix-batch-topic name (batchTopic) - топик для публикации пакетов. По умолчанию TOPIC/batch
+    - \b --prefix-batch-window msec (batchWindow) - окно накопления изменений. По умолчанию 100 мсек.
+    - \b --prefix-batch-max-items num (batchMaxItems) - максимальное количество значений в одном сообщении.
+    При заполнении пакет публикуется, не дожидаясь окончания окна. По умолчанию 500.
+    - \b --prefix-batch-coalesce [0|1] (batchCoalesce) - в пакет попадает только последнее значение датчика за окно.
+    По умолчанию 1. При 0 публикуются все изменения (в этом случае буфер ограничен --prefix-batch-buf-max, при
+    переполнении самые старые значения отбрасываются).
+    - \b --prefix-batch-format json|binary (batchFormat) - формат пакета. По умолчанию json.
+
+    Формат json - массив объектов:
+    \code
+    [{"id":111,"name":"MQTT_AI_AS","value":10,"sec":1762405075,"nsec":21000000},...]
+    \endcode
+
+    Формат binary (все числа little-endian):
+    \code
+    заголовок (8 байт):  'U' 'M' version(uint8_t=1) reserved(uint8_t=0) count(uint32_t)
+    запись (28 байт):    id(int64_t) value(int64_t) sec(int64_t) nsec(uint32_t)
+    \endcode
+
+    \section sec_MQTT_Rate Ограничение частоты публикации
+    В режиме публикации "по датчикам" можно ограничить частоту публикации в каждый топик:
+    - \b --prefix-min-interval msec (minInterval) - минимальный интервал между публикациями в топик датчика.
+    Изменения, пришедшие раньше, не теряются - по истечении интервала публикуется последнее значение.
+    - \b --prefix-deadband val (deadband) - изменения значения меньше чем на val не публикуются.
+    Для конкретного датчика эти параметры можно переопределить полями mqtt_min_interval="..", mqtt_deadband=".."
+    (значение "0" отключает ограничение для датчика).
+
+    Для QoS>0 можно ограничить количество неподтверждённых брокером сообщений (in-flight):
+    - \b --prefix-mqtt-qos [0|1|2] (mqttQoS) - QoS публикуемых сообщений. По умолчанию 1.
+    - \b --prefix-max-inflight num (maxInflight) - максимальное количество неподтверждённых сообщений. 0 - без ограничений.
+    При заполнении окна публикация откладывается (значения датчиков и пакеты ожидают подтверждений).
+    При разрыве соединения (и при новом подключении) счётчик неподтверждённых сообщений сбрасывается.
     */
     // -----------------------------------------------------------------------------
     /*! Реализация публикатора на основе MQTT */
@@ -126,16 +170,52 @@ namespace uniset
             static void help_print( int argc, const char* const* argv );
 
             virtual void on_connect(int rc) override;
+            virtual void on_disconnect(int rc) override;
             virtual void on_message(const struct mosquitto_message* message) override;
             virtual void on_subscribe(int mid, int qos_count, const int* granted_qos) override;
+            virtual void on_publish(int mid) override;
+
+            enum Timers
+            {
+                tmFlush,
+                tmLastNumberOfTimer
+            };
+
+            enum PublishMode
+            {
+                pmSensor,   /*!< публикация каждого изменения в топик датчика */
+                pmBatch     /*!< пакетная публикация в групповой топик */
+            };
+
+            enum BatchFormat
+            {
+                bfJSON,
+                bfBinary
+            };
+
+            struct BatchItem
+            {
+                uniset::ObjectId sid;
+                long value;
+                struct timespec tv;
+            };
+
+            // буфер пакетного режима (при переполнении удаляются самые старые значения)
+            typedef std::deque<BatchItem> BatchBuffer;
+
+            /*! сформировать пакет (см. \ref sec_MQTT_Batch) */
+            static std::string makeBatchJSON( const BatchBuffer& items, size_t beg, size_t end );
+            static std::string makeBatchBinary( const BatchBuffer& items, size_t beg, size_t end );
 
         protected:
             MQTTPublisher();
 
             virtual void askSensors( UniversalIO::UIOCommand cmd ) override;
             virtual void sensorInfo( const uniset::SensorMessage* sm ) override;
+            virtual void timerInfo( const uniset::TimerMessage* tm ) override;
             virtual bool deactivateObject() override;
             virtual void sysCommand( const uniset::SystemMessage* sm ) override;
+            virtual std::string getMonitInfo() const override;
 
             std::shared_ptr<SMInterface> shm;
 
@@ -143,11 +223,28 @@ namespace uniset
             {
                 uniset::ObjectId sid;
                 std::string pubname;
+                timeout_t minInterval = { 0 };
+                long deadband = { 0 };
+
+                bool published = { false };
+                long lastValue = { 0 };
+                std::chrono::steady_clock::time_point lastTime;
+
+                // значение, публикация которого отложена (min-interval или in-flight)
+                bool pending = { false };
+                long pendingValue = { 0 };
 
                 MQTTInfo( uniset::ObjectId id, const std::string& name ):
                     sid(id), pubname(name) {}
             };
 
+            bool publishValue( MQTTInfo* mi, long value, const std::chrono::steady_clock::time_point& now );
+            void flushPending();
+            bool flushBatch();
+            void addToBatch( const uniset::SensorMessage* sm );
+            bool inflightIsFull() const noexcept;
+            bool publishMessage( const std::string& topic, const std::string& msg );
+
             typedef std::unordered_map<uniset::ObjectId, MQTTInfo> MQTTMap;
 
             struct RangeInfo
@@ -181,6 +278,41 @@ namespace uniset
             MQTTMap publist;
             MQTTTextMap textpublist;
 
+            PublishMode publishMode = { pmSensor };
+
+            // пакетный режим
+            // буфер mutex-ом можно не защищать, т.к. к нему идёт обращение
+            // только из основного потока обработки (sensorInfo, timerInfo)
+            std::string batchTopic;
+            BatchFormat batchFormat = { bfJSON };
+            timeout_t batchWindow = { 100 };
+            size_t batchMaxItems = { 500 };
+            size_t batchBufMax = { 10000 };
+            bool batchCoalesce = { true };
+            BatchBuffer batch;
+            std::unordered_map<uniset::ObjectId, size_t> batchIndex; // sid -> позиция в batch (batchCoalesce)
+
+            // ограничение частоты (режим pmSensor)
+            timeout_t minInterval = { 0 };
+            long deadband = { 0 };
+            std::vector<MQTTInfo*> pendingList;
+
+            // окно неподтверждённых сообщений (QoS>0)
+            int qos = { 1 };
+            size_t maxInflight = { 0 };
+            std::atomic_size_t inflight = { 0 };
+
+            timeout_t flushTime = { 100 };
+            bool timerIsOn = { false };
+
+            // статистика
+            size_t publishCount = { 0 };
+            size_t batchCount = { 0 };
+            size_t skipDeadband = { 0 };
+            size_t delayedCount = { 0 };
+            size_t lostCount = { 0 };
+            size_t errorCount = { 0 };
+
         private:
 
             std::string prefix;
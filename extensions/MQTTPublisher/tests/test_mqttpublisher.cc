@@ -0,0 +1,269 @@
+#include <catch.hpp>
+// -----------------------------------------------------------------------------
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <endian.h>
+#include <mosquittopp.h>
+#include "UniSetTypes.h"
+#include "UInterface.h"
+#include "PassiveTimer.h"
+#include "MQTTPublisher.h"
+// -----------------------------------------------------------------------------
+using namespace std;
+using namespace uniset;
+// -----------------------------------------------------------------------------
+// см. tests_with_sm.sh
+static const int mqttPort = 18830;
+static const std::string sensorTopic("test/sensors");
+static const std::string batchTopic("test/batch/batch");
+static std::shared_ptr<UInterface> ui;
+// -----------------------------------------------------------------------------
+/*! Подписчик, собирающий все сообщения из топиков test/# */
+class TestSubscriber:
+    public mosqpp::mosquittopp
+{
+    public:
+        TestSubscriber():
+            mosquittopp("mqtt-test-subscriber")
+        {
+            mosqpp::lib_init();
+            connect_async("localhost", mqttPort, 60);
+            loop_start();
+        }
+
+        virtual ~TestSubscriber()
+        {
+            disconnect();
+            loop_stop();
+        }
+
+        virtual void on_connect( int rc ) override
+        {
+            if( rc == 0 )
+                subscribe(NULL, "test/#", 1);
+        }
+
+        virtual void on_subscribe( int mid, int qos_count, const int* granted_qos ) override
+        {
+            subscribed = true;
+        }
+
+        virtual void on_message( const struct mosquitto_message* m ) override
+        {
+            std::lock_guard<std::mutex> l(mut);
+            msgs.emplace_back(m->topic, std::string((const char*)m->payload, m->payloadlen));
+        }
+
+        void clear()
+        {
+            std::lock_guard<std::mutex> l(mut);
+            msgs.clear();
+        }
+
+        std::vector<std::string> get( const std::string& topic )
+        {
+            std::lock_guard<std::mutex> l(mut);
+            std::vector<std::string> ret;
+
+            for( const auto& m : msgs )
+            {
+                if( m.first == topic )
+                    ret.push_back(m.second);
+            }
+
+            return ret;
+        }
+
+        // ждать пока в топике не наберётся num сообщений
+        std::vector<std::string> wait( const std::string& topic, size_t num, timeout_t msec )
+        {
+            PassiveTimer pt(msec);
+
+            while( !pt.checkTime() )
+            {
+                auto ret = get(topic);
+
+                if( ret.size() >= num )
+                    return ret;
+
+                msleep(50);
+            }
+
+            return get(topic);
+        }
+
+        std::atomic_bool subscribed = { false };
+
+    private:
+        std::mutex mut;
+        std::vector<std::pair<std::string, std::string>> msgs;
+};
+// -----------------------------------------------------------------------------
+static std::shared_ptr<TestSubscriber> sub;
+// -----------------------------------------------------------------------------
+static void InitTest()
+{
+    auto conf = uniset_conf();
+    CHECK( conf != nullptr );
+
+    if( !ui )
+    {
+        ui = std::make_shared<UInterface>();
+        // UI понадобиться для проверки записанных в SM значений.
+        CHECK( ui->getObjectIndex() != nullptr );
+        CHECK( ui->getConf() == conf );
+    }
+
+    if( !sub )
+    {
+        sub = std::make_shared<TestSubscriber>();
+
+        PassiveTimer pt(5000);
+
+        while( !pt.checkTime() && !sub->subscribed )
+            msleep(100);
+
+        REQUIRE( sub->subscribed );
+    }
+
+    sub->clear();
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("[MQTTPublisher]: batch json format", "[mqtt][batch][json]")
+{
+    InitTest();
+
+    MQTTPublisher::BatchBuffer items;
+    items.push_back({1, 10, {100, 20}});
+    items.push_back({4, 1, {101, 30}});
+    items.push_back({5, -5, {102, 40}});
+
+    auto s = MQTTPublisher::makeBatchJSON(items, 0, items.size());
+    REQUIRE( s == "[{\"id\":1,\"name\":\"AI1_S\",\"value\":10,\"sec\":100,\"nsec\":20},"
+             "{\"id\":4,\"name\":\"DI1_S\",\"value\":1,\"sec\":101,\"nsec\":30},"
+             "{\"id\":5,\"name\":\"AI4_S\",\"value\":-5,\"sec\":102,\"nsec\":40}]" );
+
+    s = MQTTPublisher::makeBatchJSON(items, 1, 2);
+    REQUIRE( s == "[{\"id\":4,\"name\":\"DI1_S\",\"value\":1,\"sec\":101,\"nsec\":30}]" );
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("[MQTTPublisher]: batch binary format", "[mqtt][batch][binary]")
+{
+    MQTTPublisher::BatchBuffer items;
+    items.push_back({1, 10, {100, 20}});
+    items.push_back({4, -1, {101, 30}});
+
+    auto s = MQTTPublisher::makeBatchBinary(items, 0, items.size());
+    REQUIRE( s.size() == 8 + 2 * 28 );
+    REQUIRE( s[0] == 'U' );
+    REQUIRE( s[1] == 'M' );
+    REQUIRE( s[2] == 1 );
+
+    uint32_t count = 0;
+    memcpy(&count, s.data() + 4, sizeof(count));
+    REQUIRE( le32toh(count) == 2 );
+
+    int64_t v = 0;
+    memcpy(&v, s.data() + 8 + 28, sizeof(v));
+    REQUIRE( (int64_t)le64toh(v) == 4 );
+    memcpy(&v, s.data() + 8 + 28 + 8, sizeof(v));
+    REQUIRE( (int64_t)le64toh(v) == -1 );
+
+    uint32_t nsec = 0;
+    memcpy(&nsec, s.data() + 8 + 28 + 24, sizeof(nsec));
+    REQUIRE( le32toh(nsec) == 30 );
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("[MQTTPublisher]: publish by sensor (deadband)", "[mqtt][sensor][deadband]")
+{
+    InitTest();
+
+    // AI2_S: min_interval=0, deadband=3
+    const std::string topic = sensorTopic + "/AI2_S";
+
+    ui->setValue(2, 10);
+    auto msgs = sub->wait(topic, 1, 3000);
+    REQUIRE( msgs.size() == 1 );
+    REQUIRE( msgs[0] == "10" );
+
+    // изменение в пределах deadband
+    ui->setValue(2, 11);
+    msleep(500);
+    REQUIRE( sub->get(topic).size() == 1 );
+
+    ui->setValue(2, 20);
+    msgs = sub->wait(topic, 2, 3000);
+    REQUIRE( msgs.size() == 2 );
+    REQUIRE( msgs[1] == "20" );
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("[MQTTPublisher]: publish by sensor (min interval)", "[mqtt][sensor][interval]")
+{
+    InitTest();
+
+    // AI3_S: min_interval=500, deadband=0
+    const std::string topic = sensorTopic + "/AI3_S";
+
+    // первое значение публикуется сразу
+    ui->setValue(3, 100);
+    auto msgs = sub->wait(topic, 1, 3000);
+    REQUIRE( msgs.size() == 1 );
+    REQUIRE( msgs[0] == "100" );
+
+    // "пачка" изменений внутри интервала
+    for( long v = 101; v <= 105; v++ )
+        ui->setValue(3, v);
+
+    msleep(300);
+    // пока интервал не прошёл, ничего не публикуется
+    REQUIRE( sub->get(topic).size() == 1 );
+
+    // по истечении интервала публикуется последнее значение
+    msgs = sub->wait(topic, 2, 3000);
+    REQUIRE( msgs.size() == 2 );
+    REQUIRE( msgs[1] == "105" );
+
+    msleep(1000);
+    REQUIRE( sub->get(topic).size() == 2 );
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("[MQTTPublisher]: batch publish", "[mqtt][batch]")
+{
+    InitTest();
+
+    ui->setValue(1, 200);
+    ui->setValue(5, 201);
+    ui->setValue(4, 1);
+    ui->setValue(6, 202); // датчик не публикуется (нет mqtt="1")
+
+    // ждём окончания окна накопления (batchWindow=200)
+    msleep(1000);
+    auto msgs = sub->get(batchTopic);
+    REQUIRE( msgs.size() >= 1 );
+
+    std::string all;
+
+    for( const auto& m : msgs )
+        all += m;
+
+    REQUIRE( all.find("\"name\":\"AI1_S\",\"value\":200") != std::string::npos );
+    REQUIRE( all.find("\"name\":\"AI4_S\",\"value\":201") != std::string::npos );
+    REQUIRE( all.find("\"name\":\"DI1_S\",\"value\":1") != std::string::npos );
+    REQUIRE( all.find("AI5_S") == std::string::npos );
+
+    // несколько изменений за окно - в пакет попадает только последнее
+    sub->clear();
+
+    for( long v = 300; v < 310; v++ )
+        ui->setValue(5, v);
+
+    msleep(1000);
+    msgs = sub->get(batchTopic);
+    REQUIRE( msgs.size() >= 1 );
+    REQUIRE( msgs.size() < 10 );
+    REQUIRE( msgs.back().find("\"value\":309") != std::string::npos );
+}
+// -----------------------------------------------------------------------------
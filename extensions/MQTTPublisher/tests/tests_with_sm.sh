@@ -0,0 +1,38 @@
+#!/bin/sh
+
+# Для тестов нужен локальный брокер mosquitto.
+# Запускаем свой экземпляр на отдельном порту, чтобы не зависеть от системного.
+MQTT_PORT=18830
+MOSQUITTO=$(command -v mosquitto 2>/dev/null || echo /usr/sbin/mosquitto)
+
+if [ ! -x "$MOSQUITTO" ]; then
+	echo "mosquitto not found. Skip MQTTPublisher tests.."
+	exit 77
+fi
+
+MOSQUITTO_PID=
+
+atexit() {
+	[ -n "$MOSQUITTO_PID" ] && kill "$MOSQUITTO_PID" 2>/dev/null
+}
+
+trap atexit EXIT
+
+$MOSQUITTO -p $MQTT_PORT &
+MOSQUITTO_PID=$!
+sleep 1
+
+# '--' - нужен для отделения аргументов catch, от наших..
+cd ../../../Utilities/Admin/
+./uniset2-start.sh -f ./create_links.sh
+./uniset2-start.sh -f ./create
+
+./uniset2-start.sh -f ./exist | grep -q UNISET_PLC/Controllers || exit 1
+cd -
+
+./uniset2-start.sh -f ./tests-with-sm $* -- --confile mqtt-test-configure.xml --e-startup-pause 10 \
+--mqtt-name MQTTPublisher1 --mqtt-mqtt-port $MQTT_PORT --mqtt-min-interval 500 --mqtt-deadband 3 \
+--mqttb-name MQTTPublisher2 --mqttb-mqtt-port $MQTT_PORT --mqttb-publish-mode batch --mqttb-batch-window 200 \
+--mqttb-batch-max-items 3 --mqttb-max-inflight 10
+
+# --mqtt-log-add-levels any
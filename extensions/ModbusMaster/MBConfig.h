@@ -196,6 +196,10 @@ namespace uniset
                 std::atomic<size_t> numreply = { 0 }; // количество успешных запросов..
                 std::atomic<size_t> prev_numreply = { 0 };
 
+                // метка трассировки задержек (см. LatencyTrace)
+                // ставится при первом ответе устройства в цикле опроса и "передаётся" в SM при обновлении (updateSM)
+                uint32_t trace = { 0 };
+
                 //
                 bool ask_every_reg = { false }; /*!< опрашивать ли каждый регистр, независимо от результата опроса предыдущего. По умолчанию false - прервать опрос при первом же timeout */
 
@@ -24,6 +24,7 @@
 #include "extensions/Extensions.h"
 #include "ORepHelpers.h"
 #include "MBExchange.h"
+#include "LatencyTrace.h"
 #include "modbus/MBLogSugar.h"
 // -------------------------------------------------------------------------
 namespace uniset
@@ -1082,6 +1083,11 @@ namespace uniset
                 }
             }
 
+            // метка трассировки передаётся в SM с первым значением, полученным в этом цикле
+            // (см. SMInterface::localSetValue())
+            LatencyTrace::Scope ltrace(d->trace);
+            d->trace = 0;
+
             for( auto&& m : d->pollmap )
             {
                 auto& regmap = m.second;
@@ -2534,6 +2540,9 @@ namespace uniset
                             {
                                 d->numreply++;
                                 allNotRespond = false;
+
+                                if( !d->trace )
+                                    d->trace = LatencyTrace::start();
                             }
                         }
                     }
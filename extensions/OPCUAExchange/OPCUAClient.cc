@@ -15,6 +15,7 @@
  */
 // -------------------------------------------------------------------------
 #include <open62541pp/open62541pp.hpp>
+#include <open62541/client_highlevel_async.h>
 #include "OPCUAClient.h"
 
 // -----------------------------------------------------------------------------
@@ -233,6 +234,16 @@ opcua::StatusCode OPCUAClient::read(const std::vector<opcua::ua::ReadValueId>& a
             {
                 processResult(opcua::toString(attrs[i].nodeId()), response.results()[i], results[i]);
             }
+
+            // см. asyncReadCallback()
+            if( response.results().size() < attrs.size() )
+            {
+                if( dlog->debugging(Debug::WARN) )
+                    dlog->warn() << "Response items size mismatched: " << response.results().size() << " != " << attrs.size() << endl;
+
+                for( size_t i = response.results().size(); i < attrs.size() && i < results.size(); i++ )
+                    results[i].status = opcua::StatusCode{ UA_STATUSCODE_BADNODATA };
+            }
         }
     }
     return serviceResult;
@@ -356,3 +367,218 @@ opcua::StatusCode OPCUAClient::subscribeDataChanges(std::vector<opcua::ua::ReadV
     return serviceResult;
 }
 // -----------------------------------------------------------------------------
+std::vector<std::pair<size_t, size_t>> OPCUAClient::splitRange( size_t total, size_t maxNodes )
+{
+    std::vector<std::pair<size_t, size_t>> ret;
+
+    if( total == 0 )
+        return ret;
+
+    if( maxNodes == 0 || maxNodes >= total )
+    {
+        ret.emplace_back(0, total);
+        return ret;
+    }
+
+    for( size_t off = 0; off < total; off += maxNodes )
+        ret.emplace_back(off, std::min(maxNodes, total - off));
+
+    return ret;
+}
+// -----------------------------------------------------------------------------
+void OPCUAClient::asyncReadCallback( UA_Client* c, void* userdata, UA_UInt32 requestId, UA_ReadResponse* rr )
+{
+    auto job = static_cast<OPCUAClient::ReadJob*>(userdata);
+
+    if( !job || job->done )
+        return;
+
+    job->done = true;
+    job->latency_usec = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - job->tstart).count();
+
+    if( !rr )
+    {
+        job->status = opcua::StatusCode{ UA_STATUSCODE_BADUNEXPECTEDERROR };
+        return;
+    }
+
+    job->status = opcua::StatusCode{ rr->responseHeader.serviceResult };
+
+    if( job->status.isBad() )
+        return;
+
+    if( rr->resultsSize > job->count )
+    {
+        auto log = job->owner->dlog;
+
+        if( log->debugging(Debug::CRIT) )
+            log->crit() << "Response items size mismatched: " << rr->resultsSize << " != " << job->count << endl;
+
+        job->status = opcua::StatusCode{ UA_STATUSCODE_BADRESPONSETOOLARGE };
+        return;
+    }
+
+    for( size_t i = 0; i < rr->resultsSize; i++ )
+    {
+        const size_t k = job->offset + i;
+        job->owner->processResult(opcua::toString((*job->ids)[k].nodeId()),
+                                  opcua::asWrapper<opcua::DataValue>(rr->results[i]),
+                                  (*job->results)[k]);
+    }
+
+    // сервер вернул не все значения: остальные помечаем как непрочитанные,
+    // чтобы не остались значения от предыдущего опроса
+    if( rr->resultsSize < job->count )
+    {
+        auto log = job->owner->dlog;
+
+        if( log->debugging(Debug::WARN) )
+            log->warn() << "Response items size mismatched: " << rr->resultsSize << " != " << job->count << endl;
+
+        for( size_t i = rr->resultsSize; i < job->count; i++ )
+            (*job->results)[job->offset + i].status = opcua::StatusCode{ UA_STATUSCODE_BADNODATA };
+    }
+}
+// -----------------------------------------------------------------------------
+void OPCUAClient::asyncWriteCallback( UA_Client* c, void* userdata, UA_UInt32 requestId, UA_WriteResponse* wr )
+{
+    auto job = static_cast<OPCUAClient::WriteJob*>(userdata);
+
+    if( !job || job->done )
+        return;
+
+    job->done = true;
+    job->latency_usec = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - job->tstart).count();
+
+    if( !wr )
+        job->status = opcua::StatusCode{ UA_STATUSCODE_BADUNEXPECTEDERROR };
+    else
+        job->status = opcua::StatusCode{ wr->responseHeader.serviceResult };
+}
+// -----------------------------------------------------------------------------
+template<class Job, class SendFn>
+opcua::StatusCode OPCUAClient::runPipeline( std::vector<Job>& jobs, size_t maxOutstanding, size_t timeout_msec, SendFn send )
+{
+    if( maxOutstanding == 0 )
+        maxOutstanding = 1;
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_msec);
+    size_t next = 0;
+    size_t inflight = 0;
+    UA_StatusCode iterResult = UA_STATUSCODE_GOOD;
+
+    while( true )
+    {
+        // досылаем запросы, пока есть свободные "слоты"
+        while( next < jobs.size() && inflight < maxOutstanding )
+        {
+            auto& j = jobs[next++];
+            j.owner = this;
+            j.tstart = std::chrono::steady_clock::now();
+            j.status = opcua::StatusCode{ UA_STATUSCODE_GOOD };
+
+            UA_StatusCode rc = send(j);
+
+            if( rc != UA_STATUSCODE_GOOD )
+            {
+                j.status = opcua::StatusCode{ rc };
+                j.done = true;
+                continue;
+            }
+
+            j.sent = true;
+            inflight++;
+        }
+
+        if( inflight == 0 && next >= jobs.size() )
+            break;
+
+        if( std::chrono::steady_clock::now() >= deadline )
+            break;
+
+        iterResult = UA_Client_run_iterate(client.handle(), 5);
+
+        if( iterResult != UA_STATUSCODE_GOOD )
+            break;
+
+        inflight = 0;
+
+        for( size_t i = 0; i < next; i++ )
+        {
+            if( jobs[i].sent && !jobs[i].done )
+                inflight++;
+        }
+    }
+
+    bool unfinished = false;
+
+    for( auto&& j : jobs )
+    {
+        if( !j.done )
+        {
+            unfinished = true;
+            break;
+        }
+    }
+
+    if( unfinished )
+    {
+        // разрыв соединения вызывает callback-и всех ожидающих запросов (пока задания ещё "живы")
+        client.disconnect();
+
+        for( auto&& j : jobs )
+        {
+            if( !j.done )
+            {
+                j.done = true;
+                j.status = opcua::StatusCode{ iterResult != UA_STATUSCODE_GOOD ? iterResult : UA_STATUSCODE_BADTIMEOUT };
+            }
+        }
+    }
+
+    for( const auto& j : jobs )
+    {
+        if( j.status.isBad() )
+            return j.status;
+    }
+
+    return opcua::StatusCode{ UA_STATUSCODE_GOOD };
+}
+// -----------------------------------------------------------------------------
+opcua::StatusCode OPCUAClient::readPipelined( std::vector<ReadJob>& jobs, size_t maxOutstanding, size_t timeout_msec )
+{
+    if( dlog->debugging(Debug::LEVEL4) )
+        dlog->level4() << "Read attributes (pipelined): requests=" << jobs.size() << " outstanding=" << maxOutstanding << endl;
+
+    return runPipeline(jobs, maxOutstanding, timeout_msec, [this]( ReadJob & j )
+    {
+        UA_ReadRequest request;
+        UA_ReadRequest_init(&request);
+        request.timestampsToReturn = UA_TIMESTAMPSTORETURN_NEITHER;
+        // wrapper-ы open62541pp совпадают по размещению с UA_-типами
+        request.nodesToRead = const_cast<UA_ReadValueId*>(reinterpret_cast<const UA_ReadValueId*>(j.ids->data() + j.offset));
+        request.nodesToReadSize = j.count;
+
+        UA_UInt32 reqId = 0;
+        // запрос кодируется при отправке, поэтому request может быть локальным
+        return UA_Client_sendAsyncReadRequest(client.handle(), &request, &OPCUAClient::asyncReadCallback, &j, &reqId);
+    });
+}
+// -----------------------------------------------------------------------------
+opcua::StatusCode OPCUAClient::writePipelined( std::vector<WriteJob>& jobs, size_t maxOutstanding, size_t timeout_msec )
+{
+    if( dlog->debugging(Debug::LEVEL4) )
+        dlog->level4() << "Write attributes (pipelined): requests=" << jobs.size() << " outstanding=" << maxOutstanding << endl;
+
+    return runPipeline(jobs, maxOutstanding, timeout_msec, [this]( WriteJob & j )
+    {
+        UA_WriteRequest request;
+        UA_WriteRequest_init(&request);
+        request.nodesToWrite = reinterpret_cast<UA_WriteValue*>(j.values->data() + j.offset);
+        request.nodesToWriteSize = j.count;
+
+        UA_UInt32 reqId = 0;
+        return UA_Client_sendAsyncWriteRequest(client.handle(), &request, &OPCUAClient::asyncWriteCallback, &j, &reqId);
+    });
+}
+// -----------------------------------------------------------------------------
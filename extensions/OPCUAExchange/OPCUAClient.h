@@ -22,6 +22,7 @@
 #include <unordered_map>
 #include <map>
 #include <variant>
+#include <chrono>
 
 #include "open62541pp/open62541pp.hpp"
 #include "open62541pp/detail/exceptioncatcher.hpp"
@@ -84,6 +85,55 @@ namespace uniset
             static opcua::ua::WriteValue makeWriteValue32( const std::string& name, int32_t val );
             static opcua::ua::ReadValueId makeReadValue32( const std::string& name );
 
+            /*! Задание для конвейерного (асинхронного) чтения: элементы [offset, offset+count) списка ids.
+             *  Результаты записываются в (*results)[offset...]
+             */
+            struct ReadJob
+            {
+                const std::vector<opcua::ua::ReadValueId>* ids = { nullptr };
+                std::vector<ResultVar>* results = { nullptr };
+                size_t offset = { 0 };
+                size_t count = { 0 };
+
+                // результат выполнения
+                opcua::StatusCode status;
+                bool sent = { false };
+                bool done = { false };
+                uint64_t latency_usec = { 0 };
+
+                // служебные поля
+                OPCUAClient* owner = { nullptr };
+                std::chrono::steady_clock::time_point tstart;
+            };
+
+            /*! Задание для конвейерной (асинхронной) записи: элементы [offset, offset+count) списка values */
+            struct WriteJob
+            {
+                std::vector<opcua::ua::WriteValue>* values = { nullptr };
+                size_t offset = { 0 };
+                size_t count = { 0 };
+
+                opcua::StatusCode status;
+                bool sent = { false };
+                bool done = { false };
+                uint64_t latency_usec = { 0 };
+
+                OPCUAClient* owner = { nullptr };
+                std::chrono::steady_clock::time_point tstart;
+            };
+
+            /*! Асинхронная отправка запросов на чтение/запись.
+             * Одновременно "в полёте" держится не более maxOutstanding запросов,
+             * функция возвращает управление после получения всех ответов или по истечении timeout_msec
+             * (в этом случае соединение разрывается, а незавершённые задания получают статус BadTimeout).
+             * \return первый "плохой" статус сервиса (или Good)
+             */
+            opcua::StatusCode readPipelined( std::vector<ReadJob>& jobs, size_t maxOutstanding, size_t timeout_msec );
+            opcua::StatusCode writePipelined( std::vector<WriteJob>& jobs, size_t maxOutstanding, size_t timeout_msec );
+
+            /*! Разбивка списка из total элементов на части не более maxNodes (0 - без ограничений) */
+            static std::vector<std::pair<size_t, size_t>> splitRange( size_t total, size_t maxNodes );
+
             void onSessionActivated(opcua::StateCallback callback)
             {
                 client.onSessionActivated(std::move(callback));
@@ -165,8 +215,15 @@ namespace uniset
             opcua::Client client;
             std::shared_ptr<DebugStream> dlog;
 
+            // обработка ответов на асинхронные запросы (userdata - ReadJob/WriteJob)
+            static void asyncReadCallback( UA_Client* c, void* userdata, UA_UInt32 requestId, UA_ReadResponse* rr );
+            static void asyncWriteCallback( UA_Client* c, void* userdata, UA_UInt32 requestId, UA_WriteResponse* wr );
+
         private:
             void processResult(const opcua::String& node_name, const opcua::DataValue& in, ResultVar& out);
+
+            template<class Job, class SendFn>
+            opcua::StatusCode runPipeline( std::vector<Job>& jobs, size_t maxOutstanding, size_t timeout_msec, SendFn send );
     };
     // --------------------------------------------------------------------------
 } // end of namespace uniset
@@ -146,7 +146,7 @@ namespace uniset
                     subscription_ok = false;
                     channels[i].needSubscription = true;
                 }
-                newSessionActivated = true;
+                channels[i].needServerInfo = true;
             });
 
             channels[i].client->onSubscriptionInactive([this, i](opcua::ua::IntegerId id)
@@ -320,6 +320,12 @@ namespace uniset
         vmonit(maxReadItems);
         vmonit(maxWriteItems);
 
+        pipelineDepth = conf->getArgPInt("--" + argprefix + "pipeline-depth", it.getProp("pipelineDepth"), 0);
+        pipelineTimeout = conf->getArgPInt("--" + argprefix + "pipeline-timeout", it.getProp("pipelineTimeout"), pipelineTimeout);
+
+        vmonit(pipelineDepth);
+        vmonit(pipelineTimeout);
+
 #ifndef DISABLE_REST_API
 
         // HTTP API: разрешение перехвата управления
@@ -457,7 +463,6 @@ namespace uniset
     void OPCUAExchange::channelThread( Channel* ch )
     {
         opcinfo << myname << "(channel" << ch->num << "Thread): run..." << endl;
-        Tick tick = 1;
 
         if( ch->addr.empty() )
         {
@@ -478,19 +483,22 @@ namespace uniset
                     continue;
                 }
                 
-                if(newSessionActivated)
+                // ограничения сервера читаются заново для каждой новой сессии этого канала
+                if( ch->needServerInfo )
                 {
-                    newSessionActivated = false;
                     opclog3 << myname << " Read server info <<<<<<< " << endl;
                     opcua::Node node = ch->client->createNode(opcua::VariableId::Server_ServerStatus_CurrentTime);
                     opclog3 << myname << " Server date (UTC): " << node.readValue().to<opcua::DateTime>().format("%Y-%m-%d %H:%M:%S") << endl;
                     node = ch->client->createNode(opcua::VariableId::Server_ServerCapabilities_OperationLimits_MaxNodesPerRead);
-                    opclog3 << myname << " Server_ServerCapabilities_OperationLimits_MaxNodesPerRead: " << node.readValue().to<uint32_t>() << endl;
+                    ch->serverMaxNodesPerRead = node.readValue().to<uint32_t>();
+                    opclog3 << myname << " Server_ServerCapabilities_OperationLimits_MaxNodesPerRead: " << ch->serverMaxNodesPerRead << endl;
                     node = ch->client->createNode(opcua::VariableId::Server_ServerCapabilities_OperationLimits_MaxNodesPerWrite);
-                    opclog3 << myname << " Server_ServerCapabilities_OperationLimits_MaxNodesPerWrite: " << node.readValue().to<uint32_t>() << endl;
+                    ch->serverMaxNodesPerWrite = node.readValue().to<uint32_t>();
+                    opclog3 << myname << " Server_ServerCapabilities_OperationLimits_MaxNodesPerWrite: " << ch->serverMaxNodesPerWrite << endl;
                     node = ch->client->createNode(opcua::VariableId::Server_ServerCapabilities_OperationLimits_MaxMonitoredItemsPerCall);
                     opclog3 << myname << " Server_ServerCapabilities_OperationLimits_MaxMonitoredItemsPerCall: " << node.readValue().to<uint32_t>() << endl;
                     opclog3 << myname << " End server info >>>>>>> " << endl;
+                    ch->needServerInfo = false;
                 }
 
                 // Create subscription outside callback after session activation
@@ -551,11 +559,8 @@ namespace uniset
 
                 ch->status = true;
 
-                if( tick >= std::numeric_limits<Tick>::max() )
-                    tick = 1;
-
                 updateToChannel(ch);
-                channelExchange(tick++, ch, writeToAllChannels || currentChannel == ch->idx);
+                channelExchange(ch, writeToAllChannels || currentChannel == ch->idx);
 
                 if( currentChannel == ch->idx )
                 {
@@ -576,6 +581,7 @@ namespace uniset
                 }
 
                 auto t_end = std::chrono::steady_clock::now();
+                ch->cycleTime.add(std::chrono::duration_cast<std::chrono::microseconds>(t_end - t_start).count());
                 opclog8 << myname << "(channelThread): " << setw(10) << setprecision(7) << std::fixed
                         << std::chrono::duration_cast<std::chrono::duration<float>>(t_end - t_start).count() << " sec" << endl;
             }
@@ -600,43 +606,209 @@ namespace uniset
             if( cancelled )
                 break;
 
-            msleep( polltime );
+            // пауза с учётом времени, затраченного на обмен (период цикла ~ polltime)
+            timeout_t cycle_msec = ch->cycleTime.last_usec / 1000;
+            msleep( cycle_msec < polltime ? polltime - cycle_msec : 1 );
         }
 
         opcinfo << myname << "(channel" << ch->num << "Thread): terminated..." << endl;
     }
     // --------------------------------------------------------------------------------
-    void OPCUAExchange::channelExchange( Tick tick, Channel* ch, bool writeOn )
+    bool OPCUAExchange::isCriticalError( const opcua::StatusCode& ret ) const noexcept
+    {
+        return ( ret == UA_STATUSCODE_BADSESSIONIDINVALID || ret == UA_STATUSCODE_BADSESSIONCLOSED ||
+                 ret == UA_STATUSCODE_BADCONNECTIONREJECTED || ret == UA_STATUSCODE_BADCONNECTIONCLOSED ||
+                 ret == UA_STATUSCODE_BADCOMMUNICATIONERROR || ret == UA_STATUSCODE_BADTIMEOUT );
+    }
+    // --------------------------------------------------------------------------------
+    bool OPCUAExchange::isTickReady( std::unordered_map<Tick, std::chrono::steady_clock::time_point>& deadlines,
+                                     Tick tick, timeout_t polltime, const std::chrono::steady_clock::time_point& now ) noexcept
+    {
+        // tick=0,1 - на каждом цикле
+        if( tick <= 1 )
+            return true;
+
+        const auto period = std::chrono::milliseconds(polltime * tick);
+        auto it = deadlines.find(tick);
+
+        // первый раз группа срабатывает через tick циклов (как и при счётчике циклов),
+        // а не на первом же цикле
+        if( it == deadlines.end() )
+        {
+            deadlines[tick] = now + std::chrono::milliseconds(polltime * (tick - 1));
+            return false;
+        }
+
+        // допускаем срабатывание на полцикла раньше, чтобы "дрожание" цикла не приводило к пропуску
+        if( now + std::chrono::milliseconds(polltime / 2) < it->second )
+            return false;
+
+        it->second += period;
+
+        // если сильно отстали - планируем от текущего момента
+        if( it->second < now )
+            it->second = now + period;
+
+        return true;
+    }
+    // --------------------------------------------------------------------------------
+    bool OPCUAExchange::exchangeWritePipelined( Channel* ch, const std::vector<std::vector<opcua::ua::WriteValue>*>& groups )
+    {
+        const size_t maxNodes = ch->serverMaxNodesPerWrite;
+        std::vector<OPCUAClient::WriteJob> jobs;
+
+        for( auto&& g : groups )
+        {
+            for( const auto& r : OPCUAClient::splitRange(g->size(), maxNodes) )
+            {
+                OPCUAClient::WriteJob j;
+                j.values = g;
+                j.offset = r.first;
+                j.count = r.second;
+                jobs.emplace_back(std::move(j));
+            }
+        }
+
+        if( jobs.empty() )
+            return true;
+
+        opclog4 << myname << "(channelExchange): channel" << ch->num << " pipelined write: requests=" << jobs.size() << endl;
+
+        ch->client->writePipelined(jobs, pipelineDepth, pipelineTimeout);
+
+        bool critical = false;
+
+        for( const auto& j : jobs )
+        {
+            if( j.sent )
+                ch->writeLatency.add(j.latency_usec);
+
+            if( j.status.isBad() )
+            {
+                opcwarn << myname << "(channelExchange): channel" << ch->num << " write error: " << j.status.name() << endl;
+                addError(ch->idx, "write", j.status);
+
+                if( isCriticalError(j.status) )
+                    critical = true;
+            }
+        }
+
+        return !critical;
+    }
+    // --------------------------------------------------------------------------------
+    bool OPCUAExchange::exchangeReadPipelined( Channel* ch, const std::vector<std::pair<std::vector<opcua::ua::ReadValueId>*, std::vector<OPCUAClient::ResultVar>*>>& groups )
+    {
+        const size_t maxNodes = ch->serverMaxNodesPerRead;
+        std::vector<OPCUAClient::ReadJob> jobs;
+
+        for( auto&& g : groups )
+        {
+            for( const auto& r : OPCUAClient::splitRange(g.first->size(), maxNodes) )
+            {
+                OPCUAClient::ReadJob j;
+                j.ids = g.first;
+                j.results = g.second;
+                j.offset = r.first;
+                j.count = r.second;
+                jobs.emplace_back(std::move(j));
+            }
+        }
+
+        if( jobs.empty() )
+            return true;
+
+        opclog4 << myname << "(channelExchange): channel" << ch->num << " pipelined read: requests=" << jobs.size() << endl;
+
+        ch->client->readPipelined(jobs, pipelineDepth, pipelineTimeout);
+
+        bool critical = false;
+
+        for( const auto& j : jobs )
+        {
+            if( j.sent )
+                ch->readLatency.add(j.latency_usec);
+
+            if( j.status.isBad() )
+            {
+                opcwarn << myname << "(channelExchange): channel" << ch->num << " read error: " << j.status.name() << endl;
+                addError(ch->idx, "read", j.status);
+
+                if( isCriticalError(j.status) )
+                    critical = true;
+            }
+        }
+
+        return !critical;
+    }
+    // --------------------------------------------------------------------------------
+    void OPCUAExchange::channelExchange( Channel* ch, bool writeOn )
     {
         if( exchangeMode == emSkipExchange )
             return;
 
         auto t_start = std::chrono::steady_clock::now();
+        const auto now = t_start;
 
         if( writeOn && exchangeMode != emReadOnly )
         {
+            // группы, которые нужно записать на этом цикле
+            std::vector<std::vector<opcua::ua::WriteValue>*> wgroups;
+
             for( auto&& v : ch->writeValues )
             {
-                if (v.first == 0 || tick % v.first == 0)
+                if( !isTickReady(ch->writeDeadline, v.first, polltime, now) )
+                    continue;
+
+                for( auto& it : v.second->ids )
+                {
+                    if( !it.empty() )
+                        wgroups.push_back(&it);
+                }
+            }
+
+            if( pipelineDepth > 0 )
+            {
+                if( !exchangeWritePipelined(ch, wgroups) )
+                {
+                    ch->client->disconnect();
+                    ch->needSubscription = true;  // Потребуется новая подписка при переподключении
+                    ch->status = false;  // Сигнализируем о потере соединения для переключения канала
+                    return;
+                }
+            }
+            else
+            {
+                const size_t maxNodes = ch->serverMaxNodesPerWrite;
+
+                for( auto&& g : wgroups )
                 {
-                    for(auto& it : v.second->ids)
+                    for( const auto& r : OPCUAClient::splitRange(g->size(), maxNodes) )
                     {
-                        opclog4 << myname << "(channelExchange): channel" << ch->num << " tick " << (int) tick << " write "
-                                << it.size() << " attrs" << endl;
+                        opclog4 << myname << "(channelExchange): channel" << ch->num << " write "
+                                << r.second << " attrs" << endl;
+
+                        auto t_req = std::chrono::steady_clock::now();
+                        opcua::StatusCode ret;
+
+                        if( r.first == 0 && r.second == g->size() )
+                            ret = ch->client->write32(*g);
+                        else
+                        {
+                            std::vector<opcua::ua::WriteValue> part(g->begin() + r.first, g->begin() + r.first + r.second);
+                            ret = ch->client->write32(part);
+                        }
 
-                        auto ret = ch->client->write32(it);
+                        ch->writeLatency.add(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t_req).count());
 
                         if( ret.isBad() )
                         {
-                            opcwarn << myname << "(channelExchange): channel" << ch->num << " tick=" << (int) tick
+                            opcwarn << myname << "(channelExchange): channel" << ch->num
                                     << " write error: " << ret.name() << endl;
                             addError(ch->idx, "write", ret);
                         }
 
                         // Проверяем критичные ошибки, требующие переподключения и переключения канала
-                        if( ret == UA_STATUSCODE_BADSESSIONIDINVALID || ret == UA_STATUSCODE_BADSESSIONCLOSED ||
-                                ret == UA_STATUSCODE_BADCONNECTIONREJECTED || ret == UA_STATUSCODE_BADCONNECTIONCLOSED ||
-                                ret == UA_STATUSCODE_BADCOMMUNICATIONERROR || ret == UA_STATUSCODE_BADTIMEOUT )
+                        if( isCriticalError(ret) )
                         {
                             ch->client->disconnect();
                             ch->needSubscription = true;  // Потребуется новая подписка при переподключении
@@ -691,29 +863,68 @@ namespace uniset
             }
             else
             {
+                std::vector<std::pair<std::vector<opcua::ua::ReadValueId>*, std::vector<OPCUAClient::ResultVar>*>> rgroups;
+
                 for( auto&& v : ch->readValues )
                 {
-                    if (v.first == 0 || tick % v.first == 0)
+                    if( !isTickReady(ch->readDeadline, v.first, polltime, now) )
+                        continue;
+
+                    auto rit = v.second->results.begin();
+
+                    for( auto& it : v.second->ids )
+                    {
+                        auto& res = *rit++;
+
+                        if( !it.empty() )
+                            rgroups.emplace_back(&it, &res);
+                    }
+                }
+
+                if( pipelineDepth > 0 )
+                {
+                    if( !exchangeReadPipelined(ch, rgroups) )
                     {
-                        std::vector<std::vector<OPCUAClient::ResultVar>>::iterator rit = v.second->results.begin();
+                        ch->client->disconnect();
+                        ch->needSubscription = true;  // Потребуется новая подписка при переподключении
+                        ch->status = false;  // Сигнализируем о потере соединения для переключения канала
+                        return;
+                    }
+                }
+                else
+                {
+                    const size_t maxNodes = ch->serverMaxNodesPerRead;
 
-                        for(const auto& it : v.second->ids)
+                    for( auto&& g : rgroups )
+                    {
+                        for( const auto& r : OPCUAClient::splitRange(g.first->size(), maxNodes) )
                         {
-                            opclog4 << myname << "(channelExchange): channel" << ch->num << " tick " << (int) tick << " read "
-                                    << it.size() << " attrs" << endl;
+                            opclog4 << myname << "(channelExchange): channel" << ch->num << " read "
+                                    << r.second << " attrs" << endl;
+
+                            auto t_req = std::chrono::steady_clock::now();
+                            opcua::StatusCode ret;
+
+                            if( r.first == 0 && r.second == g.first->size() )
+                                ret = ch->client->read(*g.first, *g.second);
+                            else
+                            {
+                                std::vector<opcua::ua::ReadValueId> part(g.first->begin() + r.first, g.first->begin() + r.first + r.second);
+                                std::vector<OPCUAClient::ResultVar> pres(g.second->begin() + r.first, g.second->begin() + r.first + r.second);
+                                ret = ch->client->read(part, pres);
+                                std::copy(pres.begin(), pres.end(), g.second->begin() + r.first);
+                            }
 
-                            auto ret = ch->client->read(it, *rit++);
+                            ch->readLatency.add(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t_req).count());
 
                             if( ret.isBad() )
                             {
-                                opcwarn << myname << "(channelExchange): channel" << ch->num << " tick=" << (int) tick
+                                opcwarn << myname << "(channelExchange): channel" << ch->num
                                         << " read error: " << ret.name() << endl;
                                 addError(ch->idx, "read", ret);
                             }
 
-                            if( ret == UA_STATUSCODE_BADSESSIONIDINVALID || ret == UA_STATUSCODE_BADSESSIONCLOSED ||
-                                    ret == UA_STATUSCODE_BADCONNECTIONREJECTED || ret == UA_STATUSCODE_BADCONNECTIONCLOSED ||
-                                    ret == UA_STATUSCODE_BADCOMMUNICATIONERROR || ret == UA_STATUSCODE_BADTIMEOUT )
+                            if( isCriticalError(ret) )
                             {
                                 ch->client->disconnect();
                                 ch->needSubscription = true;  // Потребуется новая подписка при переподключении
@@ -731,6 +942,37 @@ namespace uniset
                 << std::chrono::duration_cast<std::chrono::duration<float>>(t_end - t_start).count() << " sec" << endl;
     }
     // --------------------------------------------------------------------------------
+    void OPCUAExchange::LatencyStat::add( uint64_t usec ) noexcept
+    {
+        size_t i = 0;
+
+        for( ; i < numBuckets - 1; i++ )
+        {
+            if( usec <= (uint64_t)bounds_msec[i] * 1000 )
+                break;
+        }
+
+        buckets[i]++;
+        count++;
+        sum_usec += usec;
+        last_usec = usec;
+
+        uint64_t prev = max_usec;
+
+        while( usec > prev && !max_usec.compare_exchange_weak(prev, usec) ) {}
+    }
+    // --------------------------------------------------------------------------------
+    void OPCUAExchange::LatencyStat::reset() noexcept
+    {
+        for( auto&& b : buckets )
+            b = 0;
+
+        count = 0;
+        sum_usec = 0;
+        max_usec = 0;
+        last_usec = 0;
+    }
+    // --------------------------------------------------------------------------------
     void OPCUAExchange::updateFromSM()
     {
         if( shm->isLocalwork() )
@@ -1638,6 +1880,8 @@ namespace uniset
         cout << "--opcua-stop-on-error [0|1]    - Остановить при ошибке. Default: 0" << endl;
         cout << "--opcua-maxNodesPerRead num    - Макс. элементов в одном read-запросе. Default: 0 (без ограничений)" << endl;
         cout << "--opcua-maxNodesPerWrite num   - Макс. элементов в одном write-запросе. Default: 0 (без ограничений)" << endl;
+        cout << "--opcua-pipeline-depth num     - Кол-во одновременно ожидающих ответа запросов. Default: 0 (синхронный обмен)" << endl;
+        cout << "--opcua-pipeline-timeout msec  - Время ожидания ответов на запросы цикла. Default: 5000 msec" << endl;
         cout << "--opcua-error-history-max num  - Макс. размер истории ошибок. Default: 100" << endl;
         cout << "--opcua-skip-init-output [0|1] - Не инициализировать выходы при старте" << endl;
         cout << endl;
@@ -2383,6 +2627,10 @@ namespace uniset
                 params->set(n, httpControlActive.load() ? 1 : 0);
             else if( n == "errorHistoryMax" )
                 params->set(n, (int)errorHistoryMax);
+            else if( n == "pipelineDepth" )
+                params->set(n, (int)pipelineDepth);
+            else if( n == "pipelineTimeout" )
+                params->set(n, (int)pipelineTimeout);
             else
                 unknown->add(n);
         }
@@ -2423,6 +2671,14 @@ namespace uniset
                 {
                     ch->set("ok", channels[i].status ? 1 : 0);
                     ch->set("addr", channels[i].addr);
+                    ch->set("serverMaxNodesPerRead", (Poco::UInt64)channels[i].serverMaxNodesPerRead);
+                    ch->set("serverMaxNodesPerWrite", (Poco::UInt64)channels[i].serverMaxNodesPerWrite);
+
+                    Object::Ptr lat = new Object();
+                    lat->set("read", channels[i].readLatency.toJSON());
+                    lat->set("write", channels[i].writeLatency.toJSON());
+                    lat->set("cycle", channels[i].cycleTime.toJSON());
+                    ch->set("latency", lat);
                 }
 
                 chs->add(ch);
@@ -2532,6 +2788,34 @@ namespace uniset
         return out;
     }
     // -----------------------------------------------------------------------------
+    Poco::JSON::Object::Ptr OPCUAExchange::LatencyStat::toJSON() const
+    {
+        Poco::JSON::Object::Ptr j = new Poco::JSON::Object();
+        const uint64_t n = count;
+        j->set("count", (Poco::UInt64)n);
+        j->set("avg_usec", (Poco::UInt64)(n > 0 ? sum_usec / n : 0));
+        j->set("max_usec", (Poco::UInt64)max_usec);
+        j->set("last_usec", (Poco::UInt64)last_usec);
+
+        Poco::JSON::Array::Ptr hist = new Poco::JSON::Array();
+
+        for( size_t i = 0; i < numBuckets; i++ )
+        {
+            Poco::JSON::Object::Ptr b = new Poco::JSON::Object();
+
+            if( i < numBuckets - 1 )
+                b->set("le_msec", bounds_msec[i]);
+            else
+                b->set("le_msec", "inf");
+
+            b->set("count", (Poco::UInt64)buckets[i]);
+            hist->add(b);
+        }
+
+        j->set("histogram", hist);
+        return j;
+    }
+    // -----------------------------------------------------------------------------
     Poco::JSON::Object::Ptr OPCUAExchange::httpGetMyInfo( Poco::JSON::Object::Ptr root )
     {
         auto my = UniSetObject::httpGetMyInfo(root);
@@ -123,7 +123,9 @@ namespace uniset
     \endcode
      - \b opcua_nodeid - Адрес переменной на OPCUA сервере
      - \b opcua_tick - Как часто опрашивать датчик. Не обязательный параметр, по умолчанию - опрос на каждом цикле.
-     Если задать "2" - то опрос будет производиться на каждом втором цикле и т.п. Циклы завязаны на polltime.
+     Если задать "2" - то опрос будет производиться раз в 2*polltime и т.п. Группы планируются по времени
+     (deadline), а не по номеру цикла, поэтому при "затянувшемся" цикле обмена период опроса группы сохраняется.
+     Первый раз группа опрашивается не сразу, а через opcua_tick циклов.
      - \b opcua_mask - "битовая маска"(uint32_t). Позволяет задать маску для значения. Действует как на значения читаемые,
      так и записываемые. При этом разрешается привязывать разные датчики к одной и той же переменной указывая разные маски.
      - \b opcua_type - типа переменной в ПЛК.
@@ -166,6 +168,17 @@ namespace uniset
      Пока это делается не автоматически, а в ручную через параметры.
      - \b --prefix-maxNodesPerRead максимальное количество элементов в одном запросе на чтение.
      - \b --prefix-maxNodesPerWrite максимальное количество элементов в одном запросе на запись.
+     Помимо этого при подключении считываются ограничения сервера (MaxNodesPerRead/MaxNodesPerWrite)
+     и запросы, превышающие их, автоматически делятся на части.
+
+     Конвейерный (асинхронный) обмен
+     - \b --prefix-pipeline-depth N (pipelineDepth) - количество одновременно отправленных (ожидающих ответа) запросов
+     на канал. 0 - синхронный обмен (по умолчанию), запросы отправляются по одному с ожиданием ответа.
+     При N>0 все запросы текущего цикла отправляются асинхронно, что сильно сокращает время цикла при большом RTT.
+     - \b --prefix-pipeline-timeout msec (pipelineTimeout) - максимальное время ожидания ответов на запросы цикла.
+     По умолчанию 5000 мсек. При превышении соединение разрывается.
+
+     Время выполнения запросов (гистограммы по каждому каналу) доступно в HTTP API (/status, поле channels[].latency).
 
      Поведение процесса при ошибке в OPCUA при работе по подписке!
      - \b --prefix-stop-on-error N - где N[0,1,2],
@@ -210,6 +223,12 @@ namespace uniset
 
             using Tick = uint8_t;
 
+            /*! пора ли опрашивать группу tick (период polltime*tick, первый раз - через tick циклов)
+             * \param deadlines - время следующего опроса для каждой группы (обновляется)
+             */
+            static bool isTickReady( std::unordered_map<Tick, std::chrono::steady_clock::time_point>& deadlines, Tick tick,
+                                     timeout_t polltime, const std::chrono::steady_clock::time_point& now ) noexcept;
+
             static const size_t numChannels = 2;
             struct ReadGroup
             {
@@ -311,6 +330,26 @@ namespace uniset
                 size_t count { 1 };
             };
 
+            /*! Статистика времени выполнения запросов (гистограмма) */
+            struct LatencyStat
+            {
+                static constexpr size_t numBuckets = 12;
+                // верхние границы интервалов, мсек (последний интервал - всё что больше)
+                static constexpr uint32_t bounds_msec[numBuckets - 1] = { 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 5000 };
+
+                std::atomic<uint64_t> buckets[numBuckets] = {};
+                std::atomic<uint64_t> count = { 0 };
+                std::atomic<uint64_t> sum_usec = { 0 };
+                std::atomic<uint64_t> max_usec = { 0 };
+                std::atomic<uint64_t> last_usec = { 0 };
+
+                void add( uint64_t usec ) noexcept;
+                void reset() noexcept;
+#ifndef DISABLE_REST_API
+                Poco::JSON::Object::Ptr toJSON() const;
+#endif
+            };
+
             typedef std::list<IOBase> ThresholdList;
             // т.к. пороговые датчики не связаны напрямую с обменом, создаём для них отдельный список
             // и отдельно его проверяем потом
@@ -335,7 +374,10 @@ namespace uniset
             void channel2Thread();
             void channelThread( Channel* ch );
             bool prepare();
-            void channelExchange( Tick tick, Channel* ch, bool writeOn );
+            void channelExchange( Channel* ch, bool writeOn );
+            bool isCriticalError( const opcua::StatusCode& ret ) const noexcept;
+            bool exchangeWritePipelined( Channel* ch, const std::vector<std::vector<opcua::ua::WriteValue>*>& groups );
+            bool exchangeReadPipelined( Channel* ch, const std::vector<std::pair<std::vector<opcua::ua::ReadValueId>*, std::vector<OPCUAClient::ResultVar>*>>& groups );
             void updateFromChannel( Channel* ch );
             void updateToChannel( Channel* ch );
             void updateFromSM();
@@ -396,6 +438,8 @@ namespace uniset
             size_t maxItem = { 0 };
             size_t maxReadItems = { 0 };
             size_t maxWriteItems = { 0 };
+            size_t pipelineDepth = { 0 };      /*!< количество одновременно ожидающих ответа запросов (0 - синхронный обмен) */
+            timeout_t pipelineTimeout = { 5000 }; /*!< время ожидания ответов на все запросы цикла, мсек */
 
             struct Channel
             {
@@ -413,6 +457,19 @@ namespace uniset
                 uniset::ObjectId respond_s = { uniset::DefaultObjectId };
                 IOController::IOStateList::iterator respond_it;
                 std::atomic_bool needSubscription = { false };  // Требуется создать подписку
+
+                // ограничения сервера (считываются при подключении, 0 - не заданы)
+                std::atomic_bool needServerInfo = { false }; // новая сессия, ограничения надо прочитать
+                std::atomic<size_t> serverMaxNodesPerRead = { 0 };
+                std::atomic<size_t> serverMaxNodesPerWrite = { 0 };
+
+                // планирование групп (tick) по времени
+                std::unordered_map<Tick, std::chrono::steady_clock::time_point> readDeadline;
+                std::unordered_map<Tick, std::chrono::steady_clock::time_point> writeDeadline;
+
+                LatencyStat readLatency;
+                LatencyStat writeLatency;
+                LatencyStat cycleTime;
             };
             Channel channels[numChannels];
             uniset::Trigger noConnections;
@@ -446,7 +503,6 @@ namespace uniset
             uint16_t stopOnError = {0U};                /*!< параметр, для выбора поведения процесса при ошибке в OPCUA */
             std::atomic<uint32_t> connectCount = {0U};  /*!< Считаем количество успешных подключений к серверу */
             std::atomic_bool subscription_ok = {false};
-            std::atomic_bool newSessionActivated = {false};
 
             std::atomic_bool activated = { false };
             std::atomic_bool cancelled = { false };
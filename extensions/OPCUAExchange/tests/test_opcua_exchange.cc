@@ -233,6 +233,313 @@ TEST_CASE("OPCUAExchange: first bit", "[opcua][firstbit]")
     REQUIRE( OPCUAExchange::firstBit(192) == 6 );
 }
 // -----------------------------------------------------------------------------
+TEST_CASE("OPCUAExchange: split request by server limits", "[opcua][splitrange]")
+{
+    REQUIRE( OPCUAClient::splitRange(0, 10).empty() );
+
+    auto r = OPCUAClient::splitRange(25, 0);
+    REQUIRE( r.size() == 1 );
+    REQUIRE( r[0].first == 0 );
+    REQUIRE( r[0].second == 25 );
+
+    r = OPCUAClient::splitRange(25, 10);
+    REQUIRE( r.size() == 3 );
+    REQUIRE( r[0] == std::make_pair<size_t, size_t>(0, 10) );
+    REQUIRE( r[1] == std::make_pair<size_t, size_t>(10, 10) );
+    REQUIRE( r[2] == std::make_pair<size_t, size_t>(20, 5) );
+
+    r = OPCUAClient::splitRange(20, 10);
+    REQUIRE( r.size() == 2 );
+    REQUIRE( r[1] == std::make_pair<size_t, size_t>(10, 10) );
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("OPCUAExchange: tick scheduling", "[opcua][tick]")
+{
+    std::unordered_map<OPCUAExchange::Tick, std::chrono::steady_clock::time_point> deadlines;
+    const timeout_t polltime = 100;
+    auto now = std::chrono::steady_clock::now();
+
+    // tick=0,1 - на каждом цикле
+    REQUIRE( OPCUAExchange::isTickReady(deadlines, 0, polltime, now) );
+    REQUIRE( OPCUAExchange::isTickReady(deadlines, 1, polltime, now) );
+
+    // tick=3: не на первом цикле, а на третьем (и далее - каждый третий)
+    REQUIRE_FALSE( OPCUAExchange::isTickReady(deadlines, 3, polltime, now) );
+    now += std::chrono::milliseconds(polltime);
+    REQUIRE_FALSE( OPCUAExchange::isTickReady(deadlines, 3, polltime, now) );
+    now += std::chrono::milliseconds(polltime);
+    REQUIRE( OPCUAExchange::isTickReady(deadlines, 3, polltime, now) );
+
+    for( int i = 0; i < 2; i++ )
+    {
+        now += std::chrono::milliseconds(polltime);
+        REQUIRE_FALSE( OPCUAExchange::isTickReady(deadlines, 3, polltime, now) );
+    }
+
+    now += std::chrono::milliseconds(polltime);
+    REQUIRE( OPCUAExchange::isTickReady(deadlines, 3, polltime, now) );
+
+    // tick=2: на втором цикле
+    REQUIRE_FALSE( OPCUAExchange::isTickReady(deadlines, 2, polltime, now) );
+    now += std::chrono::milliseconds(polltime);
+    REQUIRE( OPCUAExchange::isTickReady(deadlines, 2, polltime, now) );
+}
+// -----------------------------------------------------------------------------
+// Доступ к обработчикам ответов, чтобы подавать ответы в произвольном порядке
+class OPCUAClientPipelineTest:
+    public OPCUAClient
+{
+    public:
+        using OPCUAClient::asyncReadCallback;
+        using OPCUAClient::asyncWriteCallback;
+};
+// -----------------------------------------------------------------------------
+// узлы тестового сервера для проверки конвейерных запросов (i=60000...)
+static const int pipeNode0 = 60000;
+// -----------------------------------------------------------------------------
+// ответ на запрос чтения из одного значения
+static void pipelineReadReply( OPCUAClient::ReadJob& job, UA_StatusCode serviceResult, int32_t value )
+{
+    UA_DataValue dv;
+    UA_DataValue_init(&dv);
+    UA_Variant_setScalarCopy(&dv.value, &value, &UA_TYPES[UA_TYPES_INT32]);
+    dv.hasValue = true;
+
+    UA_ReadResponse rr;
+    UA_ReadResponse_init(&rr);
+    rr.responseHeader.serviceResult = serviceResult;
+    rr.results = &dv;
+    rr.resultsSize = 1;
+
+    OPCUAClientPipelineTest::asyncReadCallback(nullptr, &job, 0, &rr);
+    UA_DataValue_clear(&dv);
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("OPCUAExchange: pipelined read (short response)", "[opcua][pipeline]")
+{
+    OPCUAClientPipelineTest client;
+
+    std::vector<opcua::ua::ReadValueId> ids;
+    std::vector<OPCUAClient::ResultVar> results(2);
+
+    for( int i = 0; i < 2; i++ )
+        ids.push_back(OPCUAClient::makeReadValue32("ns=0;i=" + std::to_string(pipeNode0 + i)));
+
+    // значение от предыдущего опроса
+    results[1].value = (int32_t)5;
+    results[1].status = opcua::StatusCode{ UA_STATUSCODE_GOOD };
+
+    OPCUAClient::ReadJob job;
+    job.ids = &ids;
+    job.results = &results;
+    job.offset = 0;
+    job.count = 2;
+    job.owner = &client;
+    job.sent = true;
+    job.tstart = std::chrono::steady_clock::now();
+
+    // в ответе одно значение из двух
+    pipelineReadReply(job, UA_STATUSCODE_GOOD, 10);
+
+    REQUIRE( job.done );
+    REQUIRE( job.status.isGood() );
+    REQUIRE( results[0].status.isGood() );
+    REQUIRE( results[0].get() == 10 );
+    // второе значение не получено: не считается прочитанным
+    REQUIRE( results[1].status.isBad() );
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("OPCUAExchange: pipelined read (out of order replies)", "[opcua][pipeline]")
+{
+    OPCUAClientPipelineTest client;
+
+    std::vector<opcua::ua::ReadValueId> ids;
+    std::vector<OPCUAClient::ResultVar> results(4);
+
+    for( int i = 0; i < 4; i++ )
+        ids.push_back(OPCUAClient::makeReadValue32("ns=0;i=" + std::to_string(pipeNode0 + i)));
+
+    std::vector<OPCUAClient::ReadJob> jobs(4);
+
+    for( size_t i = 0; i < jobs.size(); i++ )
+    {
+        jobs[i].ids = &ids;
+        jobs[i].results = &results;
+        jobs[i].offset = i;
+        jobs[i].count = 1;
+        jobs[i].owner = &client;
+        jobs[i].sent = true;
+        jobs[i].tstart = std::chrono::steady_clock::now();
+    }
+
+    // ответы приходят не в порядке отправки, на один запрос ответа нет
+    pipelineReadReply(jobs[2], UA_STATUSCODE_GOOD, 12);
+    pipelineReadReply(jobs[0], UA_STATUSCODE_GOOD, 10);
+    pipelineReadReply(jobs[3], UA_STATUSCODE_BADTOOMANYOPERATIONS, 13);
+
+    REQUIRE( jobs[0].done );
+    REQUIRE( jobs[2].done );
+    REQUIRE( jobs[3].done );
+    REQUIRE_FALSE( jobs[1].done );
+
+    // результат каждого ответа попадает в "своё" место
+    REQUIRE( results[0].status.isGood() );
+    REQUIRE( results[0].get() == 10 );
+    REQUIRE( results[2].status.isGood() );
+    REQUIRE( results[2].get() == 12 );
+    REQUIRE( jobs[3].status.isBad() );
+    REQUIRE( results[3].get() == 0 );
+    REQUIRE( results[1].get() == 0 );
+
+    // повторный (запоздавший) ответ на уже завершённый запрос игнорируется
+    pipelineReadReply(jobs[0], UA_STATUSCODE_GOOD, 100);
+    REQUIRE( results[0].get() == 10 );
+
+    pipelineReadReply(jobs[1], UA_STATUSCODE_GOOD, 11);
+    REQUIRE( jobs[1].done );
+    REQUIRE( results[1].get() == 11 );
+
+    // ответ на запись
+    OPCUAClient::WriteJob wjob;
+    wjob.owner = &client;
+    wjob.sent = true;
+
+    UA_WriteResponse wr;
+    UA_WriteResponse_init(&wr);
+    wr.responseHeader.serviceResult = UA_STATUSCODE_BADTIMEOUT;
+    OPCUAClientPipelineTest::asyncWriteCallback(nullptr, &wjob, 0, &wr);
+    REQUIRE( wjob.done );
+    REQUIRE( wjob.status.isBad() );
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("OPCUAExchange: pipelined read/write (depth > 1)", "[opcua][pipeline]")
+{
+    InitTest();
+
+    const size_t num = 10;
+
+    for( size_t i = 0; i < num; i++ )
+        opcTestServer1->setI32(pipeNode0 + (int)i, 1000 + i);
+
+    OPCUAClient client;
+    REQUIRE( client.connect("opc.tcp://127.0.0.1:4840") );
+
+    std::vector<opcua::ua::ReadValueId> ids;
+
+    for( size_t i = 0; i < num; i++ )
+        ids.push_back(OPCUAClient::makeReadValue32("ns=0;i=" + std::to_string(pipeNode0 + (int)i)));
+
+    // запросы по 3 значения (последний неполный), в "полёте" до 3 запросов
+    std::vector<OPCUAClient::ResultVar> results(num);
+    std::vector<OPCUAClient::ReadJob> jobs;
+
+    for( const auto& r : OPCUAClient::splitRange(num, 3) )
+    {
+        OPCUAClient::ReadJob j;
+        j.ids = &ids;
+        j.results = &results;
+        j.offset = r.first;
+        j.count = r.second;
+        jobs.push_back(j);
+    }
+
+    REQUIRE( jobs.size() == 4 );
+    REQUIRE( client.readPipelined(jobs, 3, 3000).isGood() );
+
+    for( const auto& j : jobs )
+    {
+        REQUIRE( j.done );
+        REQUIRE( j.status.isGood() );
+    }
+
+    for( size_t i = 0; i < num; i++ )
+    {
+        REQUIRE( results[i].status.isGood() );
+        REQUIRE( results[i].get() == (int32_t)(1000 + i) );
+    }
+
+    // запись по 2 значения, глубина конвейера 2
+    std::vector<opcua::ua::WriteValue> values;
+
+    for( size_t i = 0; i < num; i++ )
+        values.push_back(OPCUAClient::makeWriteValue32("ns=0;i=" + std::to_string(pipeNode0 + (int)i), 2000 + i));
+
+    std::vector<OPCUAClient::WriteJob> wjobs;
+
+    for( const auto& r : OPCUAClient::splitRange(num, 2) )
+    {
+        OPCUAClient::WriteJob j;
+        j.values = &values;
+        j.offset = r.first;
+        j.count = r.second;
+        wjobs.push_back(j);
+    }
+
+    REQUIRE( client.writePipelined(wjobs, 2, 3000).isGood() );
+
+    for( size_t i = 0; i < num; i++ )
+        REQUIRE( opcTestServer1->getI32(pipeNode0 + (int)i) == (int32_t)(2000 + i) );
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("OPCUAExchange: pipelined read (timeout)", "[opcua][pipeline]")
+{
+    InitTest();
+
+    const size_t num = 6;
+
+    for( size_t i = 0; i < num; i++ )
+        opcTestServer1->setI32(pipeNode0 + (int)i, 3000 + i);
+
+    OPCUAClient client;
+    REQUIRE( client.connect("opc.tcp://127.0.0.1:4840") );
+
+    std::vector<opcua::ua::ReadValueId> ids;
+
+    for( size_t i = 0; i < num; i++ )
+        ids.push_back(OPCUAClient::makeReadValue32("ns=0;i=" + std::to_string(pipeNode0 + (int)i)));
+
+    std::vector<OPCUAClient::ResultVar> results(num);
+    std::vector<OPCUAClient::ReadJob> jobs;
+
+    for( const auto& r : OPCUAClient::splitRange(num, 1) )
+    {
+        OPCUAClient::ReadJob j;
+        j.ids = &ids;
+        j.results = &results;
+        j.offset = r.first;
+        j.count = r.second;
+        jobs.push_back(j);
+    }
+
+    // время истекает сразу после отправки первых двух запросов:
+    // отправленные завершаются разрывом соединения, остальные не отправляются
+    REQUIRE( client.readPipelined(jobs, 2, 0).isBad() );
+
+    for( size_t i = 0; i < jobs.size(); i++ )
+    {
+        REQUIRE( jobs[i].done );
+        REQUIRE( jobs[i].status.isBad() );
+        REQUIRE( jobs[i].sent == (i < 2) );
+    }
+
+    for( size_t i = 2; i < jobs.size(); i++ )
+        REQUIRE( jobs[i].status.get() == UA_STATUSCODE_BADTIMEOUT );
+
+    // после переподключения обмен восстанавливается
+    REQUIRE( client.connect("opc.tcp://127.0.0.1:4840") );
+
+    for( auto&& j : jobs )
+    {
+        j.done = false;
+        j.sent = false;
+    }
+
+    REQUIRE( client.readPipelined(jobs, 2, 3000).isGood() );
+
+    for( size_t i = 0; i < num; i++ )
+        REQUIRE( results[i].get() == (int32_t)(3000 + i) );
+}
+// -----------------------------------------------------------------------------
 TEST_CASE("OPCUAExchange: get bits", "[opcua][getbits]")
 {
     REQUIRE( OPCUAExchange::getBits(1, 1, 0) == 1 );
@@ -1400,6 +1707,26 @@ TEST_CASE("OPCUAExchange: HTTP /status includes new fields", "[http][opcuaex][st
     REQUIRE(st->has("httpControlActive"));
     REQUIRE(st->has("errorHistoryMax"));
     REQUIRE(st->has("errorHistorySize"));
+
+    // статистика времени выполнения запросов
+    auto chs = st->getArray("channels");
+    REQUIRE(chs);
+    REQUIRE(chs->size() > 0);
+    auto ch0 = chs->getObject(0);
+    REQUIRE(ch0);
+
+    if( ch0->get("disabled").convert<int>() == 0 )
+    {
+        REQUIRE(ch0->has("serverMaxNodesPerRead"));
+        auto lat = ch0->getObject("latency");
+        REQUIRE(lat);
+        REQUIRE(lat->has("read"));
+        REQUIRE(lat->has("write"));
+        REQUIRE(lat->has("cycle"));
+        auto cycle = lat->getObject("cycle");
+        REQUIRE(cycle->get("count").convert<uint64_t>() > 0);
+        REQUIRE(cycle->getArray("histogram")->size() == 12);
+    }
 }
 // -----------------------------------------------------------------------------
 TEST_CASE("OPCUAExchange: HTTP /sensors (filter by id/name)", "[http][opcuaex][sensors][filter]")
@@ -94,7 +94,9 @@ OPCUAServer::OPCUAServer(uniset::ObjectId objId, xmlNode* cnode, uniset::ObjectI
     namePrefix = it.getProp2("namePrefix", "");
     updateTime_msec = conf->getArgPInt("--" + argprefix + "updatetime", it.getProp("updateTime"), (int)updateTime_msec);
     vmonit(updateTime_msec);
-    myinfo << myname << "(init): OPC UA server " << ip << ":" << port << " updatePause=" << updateTime_msec << endl;
+    updateOnlyChanges = conf->getArgInt("--" + argprefix + "update-only-changes", it.getProp2("updateOnlyChanges", "1"));
+    myinfo << myname << "(init): OPC UA server " << ip << ":" << port << " updatePause=" << updateTime_msec
+           << " updateOnlyChanges=" << updateOnlyChanges << endl;
 
     auto opcConfig = UA_Server_getConfig(opcServer.handle());
     opcConfig->maxSubscriptions = conf->getArgPInt("--" + argprefix + "maxSubscriptions", it.getProp("maxSubscriptions"), (int)opcConfig->maxSubscriptions);
@@ -637,6 +639,7 @@ void OPCUAServer::help_print()
     cout << "--opcua-host ip              - IP на котором слушает сервер. Default: 0.0.0.0" << endl;
     cout << "--opcua-port port            - Порт сервера. Default: 4840" << endl;
     cout << "--opcua-updatetime msec      - Период обновления данных в/из SM. Default: 200 msec" << endl;
+    cout << "--opcua-update-only-changes [0|1] - Записывать в OPC UA только изменившиеся значения. Default: 1" << endl;
     cout << endl;
 
     cout << " OPC UA Limits: " << endl;
@@ -827,6 +830,8 @@ OPCUAServer::DefaultValueUType OPCUAServer::getBits(
 void OPCUAServer::update()
 {
     auto t_start = std::chrono::steady_clock::now();
+    // режим может поменяться через HTTP API, на время цикла фиксируем
+    const bool onlyChanges = updateOnlyChanges;
 
     for( auto it = this->variables.begin(); it != this->variables.end(); it++ )
     {
@@ -849,21 +854,39 @@ void OPCUAServer::update()
             if( it->second.stype == UniversalIO::DO )
             {
                 uniset::uniset_rwmutex_rlock lock(it->second.vmut);
+
+                if( onlyChanges && it->second.written && it->second.lastState == it->second.state )
+                {
+                    updateSkipCount++;
+                    continue;
+                }
+
                 it->second.node.writeValue(opcua::Variant{it->second.state});
+                it->second.lastState = it->second.state;
+                it->second.written = true;
+                updateWriteCount++;
             }
             else if( it->second.stype == UniversalIO::AO )
             {
+                uniset::uniset_rwmutex_rlock lock(it->second.vmut);
+
+                if( onlyChanges && it->second.written && it->second.lastValue == it->second.value )
+                {
+                    updateSkipCount++;
+                    continue;
+                }
+
                 if( it->second.vtype == opcua::DataTypeId::Float )
                 {
-                    uniset::uniset_rwmutex_rlock lock(it->second.vmut);
                     float fval = (float)it->second.value / pow(10.0, it->second.precision);
                     it->second.node.writeValue(opcua::Variant{ fval} );
                 }
                 else
-                {
-                    uniset::uniset_rwmutex_rlock lock(it->second.vmut);
                     it->second.node.writeValue(opcua::Variant{it->second.value});
-                }
+
+                it->second.lastValue = it->second.value;
+                it->second.written = true;
+                updateWriteCount++;
             }
             else if( it->second.stype == UniversalIO::DI )
             {
@@ -921,6 +944,9 @@ std::string OPCUAServer::getMonitInfo() const
     inf << "write(in): " << writeCount << endl;
     inf << "read(out): " << variables.size() - writeCount << endl;
     inf << "methods(call): " << methodCount << endl;
+    inf << "updateOnlyChanges: " << updateOnlyChanges
+        << " writes: " << updateWriteCount
+        << " skipped: " << updateSkipCount << endl;
     return inf.str();
 }
 // -----------------------------------------------------------------------------
@@ -1053,12 +1079,13 @@ Poco::JSON::Object::Ptr OPCUAServer::httpHelp( const Poco::URI::QueryParameters&
     {
         uniset::json::help::item cmd("getparam", "read runtime parameters");
         cmd.param("name", "parameter to read; can be repeated");
-        cmd.param("note", "supported: updateTime_msec|variablesCount|writeCount|methodCount|httpEnabledSetParams");
+        cmd.param("note", "supported: updateTime_msec|updateOnlyChanges|variablesCount|writeCount|methodCount|updateWriteCount|updateSkipCount|httpEnabledSetParams");
         myhelp.add(cmd);
     }
     {
         uniset::json::help::item cmd("setparam", "set runtime parameters");
         cmd.param("updateTime_msec", "milliseconds");
+        cmd.param("updateOnlyChanges", "0|1");
         cmd.param("note", "may be disabled by httpEnabledSetParams");
         myhelp.add(cmd);
     }
@@ -1141,6 +1168,12 @@ Poco::JSON::Object::Ptr OPCUAServer::httpGetParam( const Poco::URI::QueryParamet
             params->set(n, (int)writeCount);
         else if( n == "methodCount" )
             params->set(n, (int)methodCount);
+        else if( n == "updateOnlyChanges" )
+            params->set(n, updateOnlyChanges ? 1 : 0);
+        else if( n == "updateWriteCount" )
+            params->set(n, (Poco::UInt64)updateWriteCount);
+        else if( n == "updateSkipCount" )
+            params->set(n, (Poco::UInt64)updateSkipCount);
         else if( n == "httpEnabledSetParams" )
             params->set(n, httpEnabledSetParams ? 1 : 0);
         else
@@ -1186,6 +1219,12 @@ Poco::JSON::Object::Ptr OPCUAServer::httpSetParam( const Poco::URI::QueryParamet
             updateTime_msec = (timeout_t)v;
             updated->set(name, (int)updateTime_msec);
         }
+        else if( name == "updateOnlyChanges" )
+        {
+            long v = to_long(val, name, myname);
+            updateOnlyChanges = ( v != 0 );
+            updated->set(name, updateOnlyChanges ? 1 : 0);
+        }
         else
         {
             unknown->add(name);
@@ -1232,6 +1271,7 @@ Poco::JSON::Object::Ptr OPCUAServer::httpStatus()
     {
         Object::Ptr rp = new Object();
         rp->set("updateTime_msec",  (int)updateTime_msec);
+        rp->set("updateOnlyChanges", updateOnlyChanges ? 1 : 0);
         st->set("params", rp);
     }
 
@@ -1252,6 +1292,8 @@ Poco::JSON::Object::Ptr OPCUAServer::httpStatus()
         vars->set("read", (int)(variables.size() - writeCount));
         vars->set("write", (int)writeCount);
         vars->set("methods", (int)methodCount);
+        vars->set("updateWrites", (Poco::UInt64)updateWriteCount);
+        vars->set("updateSkipped", (Poco::UInt64)updateSkipCount);
         st->set("variables", vars);
     }
 
@@ -67,6 +67,10 @@ namespace uniset
     \endcode
     К основным параметрам относятся
      - \b updatePause - мсек, период с которым обновляются значения датчиков
+     - \b updateOnlyChanges - [1|0] записывать в OPC UA переменные только изменившиеся значения.
+       По умолчанию включено. Для каждой переменной хранится последнее записанное значение,
+       запись (и уведомления подписанным клиентам) происходит только при его изменении.
+       Количество пропущенных записей выводится в HTTP API (/status).
      - \b port - port на котором слушает OPC UA сервер
      - \b host - адрес на котором запускается сервер. По умолчанию 0.0.0.0
 
@@ -262,11 +266,21 @@ namespace uniset
                 uint8_t offset = { 0 };
                 opcua::DataTypeId vtype = { DefaultVariableType };
                 uint8_t precision = { 0 }; // only for float
+
+                // последнее записанное в OPC UA значение (для updateOnlyChanges)
+                // используется только в потоке обновления
+                bool written = { false };
+                DefaultValueType lastValue = { 0 };
+                bool lastState = { false };
             };
 
             std::unordered_map<ObjectId, IOVariable> variables;
             size_t writeCount = { 0 };
 
+            std::atomic_bool updateOnlyChanges = { true }; // меняется из HTTP API
+            std::atomic_size_t updateWriteCount = { 0 }; /*!< количество записей в OPC UA переменные */
+            std::atomic_size_t updateSkipCount = { 0 }; /*!< количество пропущенных (не изменившихся) записей */
+
             struct IONode
             {
                 opcua::Node<opcua::Server> node;
@@ -706,5 +706,53 @@ TEST_CASE("OPCUAServer: HTTP /getparam extended", "[http][opcua][getparam]")
     }
 }
 // -----------------------------------------------------------------------------
-#endif // DISABLE_REST_API
+static Poco::JSON::Object::Ptr getParams( const std::string& query )
+{
+    using Poco::Net::HTTPClientSession;
+    using Poco::Net::HTTPRequest;
+    using Poco::Net::HTTPResponse;
+
+    HTTPClientSession cs(httpAddr, httpPort);
+    HTTPRequest req(HTTPRequest::HTTP_GET, "/api/v2/OPCUAServer/getparam?" + query, HTTPRequest::HTTP_1_1);
+    HTTPResponse res;
+    cs.sendRequest(req);
+    std::istream& rs = cs.receiveResponse(res);
+    REQUIRE(res.getStatus() == HTTPResponse::HTTP_OK);
+
+    std::stringstream ss;
+    ss << rs.rdbuf();
+    Poco::JSON::Parser parser;
+    auto r = parser.parse(ss.str());
+    auto j = r.extract<Poco::JSON::Object::Ptr>();
+    REQUIRE(j->get("result").toString() == "OK");
+    return j->getObject("params");
+}
 // -----------------------------------------------------------------------------
+TEST_CASE("OPCUAServer: update only changes", "[opcuaserver][changes]")
+{
+    InitTest();
+
+    auto p = getParams("name=updateOnlyChanges&name=updateWriteCount&name=updateSkipCount");
+    REQUIRE( (int)p->get("updateOnlyChanges") == 1 );
+
+    // значения не меняются - записи пропускаются
+    Poco::UInt64 writes1 = p->getValue<Poco::UInt64>("updateWriteCount");
+    Poco::UInt64 skip1 = p->getValue<Poco::UInt64>("updateSkipCount");
+    msleep(pause_msec * 3);
+
+    p = getParams("name=updateWriteCount&name=updateSkipCount");
+    Poco::UInt64 writes2 = p->getValue<Poco::UInt64>("updateWriteCount");
+    Poco::UInt64 skip2 = p->getValue<Poco::UInt64>("updateSkipCount");
+    REQUIRE( skip2 > skip1 );
+    REQUIRE( writes2 == writes1 );
+
+    // изменившееся значение записывается
+    ui->setValue(2, 555);
+    msleep(pause_msec);
+    REQUIRE( opcuaRead(nodeId, "AI1_S") == 555 );
+
+    p = getParams("name=updateWriteCount");
+    REQUIRE( p->getValue<Poco::UInt64>("updateWriteCount") > writes2 );
+}
+// -----------------------------------------------------------------------------
+#endif // DISABLE_REST_API
@@ -18,6 +18,8 @@ extern "C" {
 #include <rrd.h>
 }
 #include <cmath>
+#include <algorithm>
+#include <chrono>
 #include <sstream>
 #include "Exceptions.h"
 #include "RRDServer.h"
@@ -51,6 +53,28 @@ RRDServer::RRDServer(uniset::ObjectId objId, xmlNode* cnode, uniset::ObjectId sh
         throw NameNotFound(err.str());
     }
 
+    int nw = conf->getArgPInt("--" + argprefix + "writers", it.getProp("writers"), 1);
+
+    if( nw < 0 )
+    {
+        ostringstream err;
+        err << myname << "(init): bad writers=" << nw << ". Must be >= 0";
+        mycrit << err.str() << endl;
+        throw SystemError(err.str());
+    }
+
+    numWriters = nw;
+    queueMax = conf->getArgPInt("--" + argprefix + "queue-max", it.getProp("queueMax"), queueMax);
+    maxBatch = conf->getArgPInt("--" + argprefix + "max-batch", it.getProp("maxBatch"), maxBatch);
+
+    if( maxBatch == 0 )
+        maxBatch = 1;
+
+    myinfo << myname << "(init): writers=" << numWriters
+           << " queueMax=" << queueMax
+           << " maxBatch=" << maxBatch
+           << endl;
+
     int tmID = 1;
 
     for( ; it1.getCurrent(); it1++, ++tmID )
@@ -71,6 +95,58 @@ RRDServer::RRDServer(uniset::ObjectId objId, xmlNode* cnode, uniset::ObjectId sh
 // -----------------------------------------------------------------------------
 RRDServer::~RRDServer()
 {
+    stopWriters();
+}
+// -----------------------------------------------------------------------------
+bool RRDServer::deactivateObject()
+{
+    stopWriters();
+    return UObject_SK::deactivateObject();
+}
+// -----------------------------------------------------------------------------
+void RRDServer::startWriters()
+{
+    std::lock_guard<std::mutex> wl(wmut);
+
+    if( numWriters == 0 || !writers.empty() )
+        return;
+
+    {
+        std::lock_guard<std::mutex> l(jmut);
+        writersTerminate = false;
+    }
+
+    for( size_t i = 0; i < numWriters; i++ )
+        writers.emplace_back(&RRDServer::writerThread, this);
+
+    activeWriters = writers.size();
+    myinfo << myname << "(startWriters): run " << writers.size() << " writer threads" << endl;
+}
+// -----------------------------------------------------------------------------
+void RRDServer::stopWriters()
+{
+    std::lock_guard<std::mutex> wl(wmut);
+
+    if( writers.empty() )
+        return;
+
+    // после этого новые выборки в очередь не попадают (пишутся синхронно),
+    // а уже стоящие в очереди дописываются потоками перед завершением
+    {
+        std::lock_guard<std::mutex> l(jmut);
+        writersTerminate = true;
+    }
+
+    jcv.notify_all();
+
+    for( auto&& t : writers )
+    {
+        if( t.joinable() )
+            t.join();
+    }
+
+    writers.clear();
+    activeWriters = 0;
 }
 // -----------------------------------------------------------------------------
 void RRDServer::initRRD( xmlNode* cnode, int tmID )
@@ -269,6 +345,9 @@ void RRDServer::help_print( int argc, const char* const* argv )
     cout << "--prefix-confnode    - configuration section name. Default: <NAME name='NAME'...> " << endl;
     cout << "--prefix-heartbeat-id name   - ID for heartbeat sensor." << endl;
     cout << "--prefix-heartbeat-max val   - max value for heartbeat sensor." << endl;
+    cout << "--prefix-writers num         - количество потоков записи. 0 - синхронная запись. Default: 1" << endl;
+    cout << "--prefix-queue-max num       - макс. количество ожидающих записи выборок по одному файлу. Default: 100" << endl;
+    cout << "--prefix-max-batch num       - макс. количество выборок, записываемых одним вызовом rrd_update. Default: 50" << endl;
     cout << endl;
     cout << " Logs: " << endl;
     cout << "--prefix-log-...            - log control" << endl;
@@ -355,6 +434,8 @@ void RRDServer::sysCommand( const uniset::SystemMessage* sm )
 
     if( sm->command == SystemMessage::StartUp || sm->command == SystemMessage::WatchDog )
     {
+        startWriters();
+
         for( const auto& it : rrdlist )
         {
             try
@@ -384,7 +465,7 @@ void RRDServer::sensorInfo( const uniset::SensorMessage* sm )
 // -----------------------------------------------------------------------------
 void RRDServer::timerInfo( const uniset::TimerMessage* tm )
 {
-    for( const auto& it : rrdlist )
+    for( auto&& it : rrdlist )
     {
         if( it.tid == tm->id )
         {
@@ -398,25 +479,227 @@ void RRDServer::timerInfo( const uniset::TimerMessage* tm )
 
             myinfo << myname << "(update): '" << it.filename << "' " << v.str() << endl;
 
-            rrd_clear_error();
+            // если потоки записи не запущены (или уже остановлены) - пишем сами
+            if( numWriters == 0 || !pushSample(&it, v.str()) )
+            {
+                std::vector<std::string> samples = { v.str() };
+                rrdUpdate(&it, samples);
+            }
+
+            break;
+        }
+    }
+}
+// -----------------------------------------------------------------------------
+bool RRDServer::pushSample( RRDInfo* rrd, std::string&& sample )
+{
+    {
+        std::lock_guard<std::mutex> jl(jmut);
+
+        if( writersTerminate )
+            return false;
 
-            const std::string tmp(v.str()); // надежда на RVO оптимизацию
-            const char* argv = tmp.c_str();
+        std::lock_guard<std::mutex> l(rrd->wq->mut);
 
-            if( rrd_update_r(it.filename.c_str(), NULL, 1, &argv) < 0 )
+        if( rrd->wq->samples.size() >= queueMax )
+        {
+            // не успеваем писать - отбрасываем самую старую выборку
+            rrd->wq->samples.pop_front();
+            rrd->wq->dropped++;
+            mywarn << myname << "(update): '" << rrd->filename << "' queue overflow (queueMax=" << queueMax << "). Drop old sample.." << endl;
+        }
+
+        rrd->wq->samples.emplace_back(std::move(sample));
+        rrd->wq->maxBacklog = std::max(rrd->wq->maxBacklog, rrd->wq->samples.size());
+
+        if( rrd->wq->scheduled )
+            return true;
+
+        rrd->wq->scheduled = true;
+        jobs.push_back(rrd);
+    }
+
+    jcv.notify_one();
+    return true;
+}
+// -----------------------------------------------------------------------------
+void RRDServer::writerThread()
+{
+    std::vector<std::string> samples;
+    samples.reserve(maxBatch);
+
+    while( true )
+    {
+        RRDInfo* rrd = nullptr;
+
+        {
+            std::unique_lock<std::mutex> l(jmut);
+            jcv.wait(l, [this] { return writersTerminate || !jobs.empty(); });
+
+            // при завершении дописываем всё, что уже стоит в очереди
+            if( jobs.empty() )
+                break;
+
+            rrd = jobs.front();
+            jobs.pop_front();
+        }
+
+        // забираем все накопившиеся выборки (но не больше maxBatch)
+        samples.clear();
+
+        {
+            std::lock_guard<std::mutex> l(rrd->wq->mut);
+
+            while( !rrd->wq->samples.empty() && samples.size() < maxBatch )
             {
-                ostringstream err;
-                err << myname << "(update): Can`t update RRD ('" << it.filename << "'): err: " << string(rrd_get_error());
-                mycrit << err.str() << endl;
+                samples.emplace_back(std::move(rrd->wq->samples.front()));
+                rrd->wq->samples.pop_front();
             }
+        }
 
-            break;
+        if( !samples.empty() )
+            rrdUpdate(rrd, samples);
+
+        bool reschedule = false;
+
+        {
+            std::lock_guard<std::mutex> l(rrd->wq->mut);
+
+            // пока писали, могли прийти новые выборки
+            if( rrd->wq->samples.empty() )
+                rrd->wq->scheduled = false;
+            else
+                reschedule = true;
+        }
+
+        if( reschedule )
+        {
+            std::lock_guard<std::mutex> l(jmut);
+            jobs.push_back(rrd);
         }
     }
 }
 // -----------------------------------------------------------------------------
+bool RRDServer::rrdUpdate( RRDInfo* rrd, std::vector<std::string>& samples )
+{
+    std::vector<const char*> argv;
+    argv.reserve(samples.size());
+
+    for( const auto& s : samples )
+        argv.push_back(s.c_str());
+
+    auto t_start = std::chrono::steady_clock::now();
+
+    rrd_clear_error();
+    int ret = rrd_update_r(rrd->filename.c_str(), NULL, argv.size(), argv.data());
+
+    uint64_t usec = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t_start).count();
+
+    std::string err;
+
+    if( ret < 0 )
+    {
+        err = string(rrd_get_error());
+        mycrit << myname << "(update): Can`t update RRD ('" << rrd->filename << "'): err: " << err
+               << ". Lost samples: " << samples.size() << endl;
+    }
+    else
+    {
+        mylog4 << myname << "(update): '" << rrd->filename << "' samples=" << samples.size()
+               << " time=" << usec << " usec" << endl;
+    }
+
+    std::lock_guard<std::mutex> l(rrd->wq->mut);
+    rrd->wq->updates++;
+    rrd->wq->lastLatency_usec = usec;
+    rrd->wq->totalLatency_usec += usec;
+    rrd->wq->maxLatency_usec = std::max(rrd->wq->maxLatency_usec, usec);
+
+    if( ret < 0 )
+    {
+        rrd->wq->errors++;
+        rrd->wq->failed += samples.size();
+        rrd->wq->lastError = err;
+        return false;
+    }
+
+    rrd->wq->written += samples.size();
+    return true;
+}
+// -----------------------------------------------------------------------------
+std::string RRDServer::getMonitInfo() const
+{
+    ostringstream inf;
+
+    inf << "writers: " << ( activeWriters == 0 ? string("sync") : std::to_string(activeWriters.load()) )
+        << " queueMax=" << queueMax
+        << " maxBatch=" << maxBatch
+        << endl;
+
+    for( const auto& it : rrdlist )
+    {
+        std::lock_guard<std::mutex> l(it.wq->mut);
+        inf << "  " << it.filename
+            << ": step=" << it.sec
+            << " backlog=" << it.wq->samples.size()
+            << " maxBacklog=" << it.wq->maxBacklog
+            << " written=" << it.wq->written
+            << " updates=" << it.wq->updates
+            << " dropped=" << it.wq->dropped
+            << " failed=" << it.wq->failed
+            << " errors=" << it.wq->errors
+            << " lastLatency=" << it.wq->lastLatency_usec << " usec"
+            << " maxLatency=" << it.wq->maxLatency_usec << " usec"
+            << endl;
+    }
+
+    return inf.str();
+}
+// -----------------------------------------------------------------------------
+#ifndef DISABLE_REST_API
+void RRDServer::httpGetUserData( Poco::JSON::Object::Ptr& jdata )
+{
+    jdata->set("writers", (Poco::UInt64)activeWriters);
+    jdata->set("queueMax", (Poco::UInt64)queueMax);
+    jdata->set("maxBatch", (Poco::UInt64)maxBatch);
+
+    Poco::JSON::Array::Ptr jrrd = new Poco::JSON::Array();
+    size_t backlog = 0;
+
+    for( const auto& it : rrdlist )
+    {
+        Poco::JSON::Object::Ptr j = new Poco::JSON::Object();
+
+        std::lock_guard<std::mutex> l(it.wq->mut);
+        j->set("filename", it.filename);
+        j->set("step", (int)it.sec);
+        j->set("backlog", (Poco::UInt64)it.wq->samples.size());
+        j->set("maxBacklog", (Poco::UInt64)it.wq->maxBacklog);
+        j->set("written", (Poco::UInt64)it.wq->written);
+        j->set("updates", (Poco::UInt64)it.wq->updates);
+        j->set("dropped", (Poco::UInt64)it.wq->dropped);
+        j->set("failed", (Poco::UInt64)it.wq->failed);
+        j->set("errors", (Poco::UInt64)it.wq->errors);
+        j->set("lastError", it.wq->lastError);
+
+        Poco::JSON::Object::Ptr lat = new Poco::JSON::Object();
+        lat->set("last_usec", (Poco::UInt64)it.wq->lastLatency_usec);
+        lat->set("max_usec", (Poco::UInt64)it.wq->maxLatency_usec);
+        lat->set("avg_usec", (Poco::UInt64)(it.wq->updates > 0 ? it.wq->totalLatency_usec / it.wq->updates : 0));
+        j->set("latency", lat);
+
+        backlog += it.wq->samples.size();
+        jrrd->add(j);
+    }
+
+    jdata->set("backlog", (Poco::UInt64)backlog);
+    jdata->set("rrd", jrrd);
+}
+#endif
+// -----------------------------------------------------------------------------
 RRDServer::RRDInfo::RRDInfo(const string& fname, long tmID, long sec, const RRDServer::DSList& lst):
-    filename(fname), tid(tmID), sec(sec), dslist(lst)
+    filename(fname), tid(tmID), sec(sec), dslist(lst),
+    wq(std::make_shared<WriteQueue>())
 {
     // фомируем dsmap
     for( auto&& i : dslist )
@@ -19,7 +19,13 @@
 // -----------------------------------------------------------------------------
 #include <unordered_map>
 #include <list>
+#include <deque>
+#include <vector>
 #include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 #include "UObject_SK.h"
 #include "SMInterface.h"
 #include "SharedMemory.h"
@@ -35,6 +41,7 @@ namespace uniset
       - \ref sec_RRD_Comm
       - \ref sec_RRD_Conf
       - \ref sec_RRD_DSName
+      - \ref sec_RRD_Async
 
     \section sec_RRD_Comm Общее описание RRDServer
 
@@ -80,6 +87,22 @@ namespace uniset
     \section sec_RRD_DSName Именование параметров
        По умолчанию в качестве имени параметра берётся поле \b 'ds_field'_dsname='', если это поле не указано, то берётся \b name датчика.
     \warning Имя не может превышать RRDServer::RRD_MAX_DSNAME_LEN.
+
+    \section sec_RRD_Async Асинхронная запись
+    Запись в rrd-файлы (rrd_update) выполняется не в потоке обработки сообщений, а пулом потоков записи.
+    По таймеру в очередь файла помещается очередная "выборка" (время и значения), а поток записи
+    забирает из очереди сразу все накопившиеся выборки и записывает их одним вызовом rrd_update
+    (несколько отметок времени за раз). Один файл одновременно обрабатывается только одним потоком,
+    поэтому порядок записи сохраняется.
+    - \b --prefix-writers num (writers) - количество потоков записи. По умолчанию 1.
+    0 - синхронная запись в потоке обработки сообщений (как раньше).
+    - \b --prefix-queue-max num (queueMax) - максимальное количество ожидающих записи выборок по одному файлу.
+    При переполнении самые старые выборки отбрасываются. По умолчанию 100.
+    Выборки, которые не удалось записать (ошибка rrd_update), не повторяются, а учитываются в статистике (failed).
+    - \b --prefix-max-batch num (maxBatch) - максимальное количество выборок, записываемых одним вызовом. По умолчанию 50.
+
+    Статистика по файлам (размер очереди, потери, время записи) доступна через HTTP API
+    (/api/v2/RRDServer1, поле "rrd") и в getInfo.
     */
     // -----------------------------------------------------------------------------
     /*! Реализация хранения на основе RRD */
@@ -118,6 +141,11 @@ namespace uniset
             virtual void sensorInfo( const uniset::SensorMessage* sm ) override;
             virtual void timerInfo( const uniset::TimerMessage* tm ) override;
             virtual void sysCommand( const uniset::SystemMessage* sm ) override;
+            virtual bool deactivateObject() override;
+            virtual std::string getMonitInfo() const override;
+#ifndef DISABLE_REST_API
+            virtual void httpGetUserData( Poco::JSON::Object::Ptr& jdata ) override;
+#endif
 
             void initRRD( xmlNode* cnode, int tmID );
 
@@ -141,6 +169,26 @@ namespace uniset
             typedef std::unordered_map<uniset::ObjectId, std::shared_ptr<DSInfo>> DSMap;
             typedef std::vector<std::shared_ptr<DSInfo>> DSList;
 
+            /*! очередь записи в rrd-файл (см. \ref sec_RRD_Async) */
+            struct WriteQueue
+            {
+                std::mutex mut;
+                std::deque<std::string> samples; // "time:v1:v2:..."
+                bool scheduled = { false }; // файл стоит в очереди (или обрабатывается) потоком записи
+
+                // статистика (защищена mut)
+                size_t dropped = { 0 };  // выборки, отброшенные при переполнении очереди
+                size_t failed = { 0 };   // выборки, потерянные из-за ошибки rrd_update
+                size_t updates = { 0 };  // количество вызовов rrd_update
+                size_t written = { 0 };  // количество записанных выборок
+                size_t errors = { 0 };
+                size_t maxBacklog = { 0 };
+                uint64_t lastLatency_usec = { 0 };
+                uint64_t maxLatency_usec = { 0 };
+                uint64_t totalLatency_usec = { 0 };
+                std::string lastError;
+            };
+
             struct RRDInfo
             {
                 std::string filename;
@@ -148,6 +196,7 @@ namespace uniset
                 long sec;
                 DSMap dsmap;
                 DSList dslist;
+                std::shared_ptr<WriteQueue> wq;
 
                 RRDInfo( const std::string& fname, long tmID, long sec, const DSList& lst );
             };
@@ -156,6 +205,24 @@ namespace uniset
 
             RRDList rrdlist;
 
+            bool rrdUpdate( RRDInfo* rrd, std::vector<std::string>& samples );
+            bool pushSample( RRDInfo* rrd, std::string&& sample );
+            void writerThread();
+            void startWriters();
+            void stopWriters();
+
+            size_t numWriters = { 1 };
+            size_t queueMax = { 100 };
+            size_t maxBatch = { 50 };
+
+            std::mutex wmut; // запуск/останов потоков записи (writers)
+            std::vector<std::thread> writers;
+            std::atomic_size_t activeWriters = { 0 };
+            std::mutex jmut;
+            std::condition_variable jcv;
+            std::deque<RRDInfo*> jobs; // файлы, ожидающие записи
+            bool writersTerminate = { true }; // потоки записи не работают (защищено jmut)
+
         private:
 
             std::string prefix;
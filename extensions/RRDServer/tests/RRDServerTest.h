@@ -0,0 +1,55 @@
+// -----------------------------------------------------------------------------
+#ifndef RRDServerTest_H_
+#define RRDServerTest_H_
+// -----------------------------------------------------------------------------
+#include <string>
+#include "RRDServer.h"
+// -----------------------------------------------------------------------------
+/*! RRDServer с доступом к статистике записи (для тестов) */
+class RRDServerTest:
+    public uniset::RRDServer
+{
+    public:
+        RRDServerTest( uniset::ObjectId objId, xmlNode* cnode, uniset::ObjectId shmID,
+                       const std::shared_ptr<uniset::SharedMemory>& ic, const std::string& prefix ):
+            RRDServer(objId, cnode, shmID, ic, prefix) {}
+
+        struct Stat
+        {
+            size_t backlog = { 0 };
+            size_t written = { 0 };
+            size_t updates = { 0 };
+            size_t dropped = { 0 };
+            size_t failed = { 0 };
+            size_t errors = { 0 };
+        };
+
+        Stat getStat( const std::string& filename )
+        {
+            Stat st;
+
+            for( const auto& it : rrdlist )
+            {
+                if( it.filename != filename )
+                    continue;
+
+                std::lock_guard<std::mutex> l(it.wq->mut);
+                st.backlog = it.wq->samples.size();
+                st.written = it.wq->written;
+                st.updates = it.wq->updates;
+                st.dropped = it.wq->dropped;
+                st.failed = it.wq->failed;
+                st.errors = it.wq->errors;
+                break;
+            }
+
+            return st;
+        }
+
+        inline size_t writersCount() const noexcept
+        {
+            return activeWriters;
+        }
+};
+// -----------------------------------------------------------------------------
+#endif // RRDServerTest_H_
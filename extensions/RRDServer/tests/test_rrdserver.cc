@@ -0,0 +1,147 @@
+#include <catch.hpp>
+// -----------------------------------------------------------------------------
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <unistd.h>
+#include <rrd.h>
+#include "UniSetTypes.h"
+#include "UInterface.h"
+#include "PassiveTimer.h"
+#include "RRDServerTest.h"
+// -----------------------------------------------------------------------------
+using namespace std;
+using namespace uniset;
+// -----------------------------------------------------------------------------
+// см. rrd-test-configure.xml
+static const std::string rrdFile1("rrdtest1.rrd"); // AI1_S, AI2_S
+static const std::string rrdFile2("rrdtest2.rrd"); // AI3_S
+static const ObjectId sidAI1 = 1;
+static const ObjectId sidAI2 = 2;
+static const ObjectId sidAI3 = 3;
+static std::shared_ptr<UInterface> ui;
+extern std::shared_ptr<RRDServerTest> rrd;
+// -----------------------------------------------------------------------------
+static void InitTest()
+{
+    auto conf = uniset_conf();
+    CHECK( conf != nullptr );
+
+    if( !ui )
+    {
+        ui = make_shared<UInterface>();
+        CHECK( ui->getObjectIndex() != nullptr );
+        CHECK( ui->getConf() == conf );
+    }
+
+    REQUIRE( rrd != nullptr );
+}
+// -----------------------------------------------------------------------------
+// ждём пока в файл запишется не меньше num выборок
+static bool waitWritten( const std::string& fname, size_t num, timeout_t msec = 10000 )
+{
+    PassiveTimer pt(msec);
+
+    while( !pt.checkTime() )
+    {
+        if( rrd->getStat(fname).written >= num )
+            return true;
+
+        msleep(100);
+    }
+
+    return false;
+}
+// -----------------------------------------------------------------------------
+// последние записанные в файл значения (rrd_lastupdate)
+static std::vector<std::string> lastValues( const std::string& fname )
+{
+    std::vector<std::string> ret;
+    time_t last_update = 0;
+    unsigned long ds_count = 0;
+    char** ds_names = nullptr;
+    char** last_ds = nullptr;
+
+    rrd_clear_error();
+
+    if( rrd_lastupdate_r(fname.c_str(), &last_update, &ds_count, &ds_names, &last_ds) < 0 )
+        return ret;
+
+    for( unsigned long i = 0; i < ds_count; i++ )
+    {
+        ret.emplace_back(last_ds[i]);
+        free(last_ds[i]);
+        free(ds_names[i]);
+    }
+
+    free(last_ds);
+    free(ds_names);
+    return ret;
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("[RRDServer]: async write", "[rrd][async]")
+{
+    InitTest();
+
+    // --rrd-writers 2 (см. tests_with_sm.sh)
+    REQUIRE( rrd->writersCount() == 2 );
+
+    ui->setValue(sidAI1, 10);
+    ui->setValue(sidAI2, 20);
+    msleep(100);
+
+    auto st = rrd->getStat(rrdFile1);
+    REQUIRE( waitWritten(rrdFile1, st.written + 2) );
+
+    st = rrd->getStat(rrdFile1);
+    REQUIRE( st.errors == 0 );
+    REQUIRE( st.failed == 0 );
+    REQUIRE( st.dropped == 0 );
+    REQUIRE( st.updates > 0 );
+    REQUIRE( st.updates <= st.written );
+
+    auto v = lastValues(rrdFile1);
+    REQUIRE( v.size() == 2 );
+    REQUIRE( v[0] == "10" );
+    REQUIRE( v[1] == "20" );
+
+    ui->setValue(sidAI1, 30);
+    msleep(100);
+    REQUIRE( waitWritten(rrdFile1, rrd->getStat(rrdFile1).written + 2) );
+
+    v = lastValues(rrdFile1);
+    REQUIRE( v.size() == 2 );
+    REQUIRE( v[0] == "30" );
+    REQUIRE( v[1] == "20" );
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("[RRDServer]: write errors", "[rrd][async][errors]")
+{
+    InitTest();
+
+    ui->setValue(sidAI3, 5);
+    REQUIRE( waitWritten(rrdFile2, rrd->getStat(rrdFile2).written + 1) );
+    REQUIRE( rrd->getStat(rrdFile2).failed == 0 );
+
+    // файл пропал - запись не проходит, выборки учитываются как потерянные
+    REQUIRE( unlink(rrdFile2.c_str()) == 0 );
+
+    PassiveTimer pt(10000);
+
+    while( !pt.checkTime() && rrd->getStat(rrdFile2).failed < 2 )
+        msleep(100);
+
+    auto st2 = rrd->getStat(rrdFile2);
+    REQUIRE( st2.failed >= 2 );
+    REQUIRE( st2.errors > 0 );
+    REQUIRE( st2.errors <= st2.failed );
+
+    const size_t written2 = st2.written;
+
+    // ошибки одного файла не мешают записи других
+    REQUIRE( waitWritten(rrdFile1, rrd->getStat(rrdFile1).written + 2) );
+    REQUIRE( rrd->getStat(rrdFile1).failed == 0 );
+    REQUIRE( rrd->getStat(rrdFile2).written == written2 );
+}
+// -----------------------------------------------------------------------------
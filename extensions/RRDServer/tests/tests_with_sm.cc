@@ -0,0 +1,105 @@
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <string>
+#include "Debug.h"
+#include "UniSetActivator.h"
+#include "PassiveTimer.h"
+#include "SharedMemory.h"
+#include "Extensions.h"
+#include "RRDServerTest.h"
+// --------------------------------------------------------------------------
+using namespace std;
+using namespace uniset;
+using namespace uniset::extensions;
+// --------------------------------------------------------------------------
+std::shared_ptr<RRDServerTest> rrd;
+// --------------------------------------------------------------------------
+int main(int argc, const char* argv[] )
+{
+    try
+    {
+        Catch::Session session;
+
+        if( argc > 1 && ( strcmp(argv[1], "--help") == 0 || strcmp(argv[1], "-h") == 0 ) )
+        {
+            cout << "--confile    - Использовать указанный конф. файл. По умолчанию configure.xml" << endl;
+            SharedMemory::help_print(argc, argv);
+            RRDServer::help_print(argc, argv);
+            cout << endl << endl << "--------------- CATCH HELP --------------" << endl;
+            session.showHelp();
+            return 0;
+        }
+
+        int returnCode = session.applyCommandLine( argc, argv );
+
+        //        if( returnCode != 0 ) // Indicates a command line error
+        //            return returnCode;
+
+        auto conf = uniset_init(argc, argv);
+
+        auto shm = SharedMemory::init_smemory(argc, argv);
+
+        if( !shm )
+            return 1;
+
+        string name = conf->getArgParam("--rrd-name", "RRDServer1");
+        ObjectId ID = conf->getObjectID(name);
+        xmlNode* cnode = conf->getNode(name);
+
+        if( ID == DefaultObjectId || !cnode )
+        {
+            cerr << "(tests_with_sm): not found ID or <" << name << "> section" << endl;
+            return 1;
+        }
+
+        rrd = make_shared<RRDServerTest>(ID, cnode, shm->getId(), shm, "rrd");
+
+        auto act = UniSetActivator::Instance();
+
+        act->add(shm);
+        act->add(rrd);
+
+        SystemMessage sm(SystemMessage::StartUp);
+        act->broadcast( sm.transport_msg() );
+        act->run(true);
+
+        int tout = 6000;
+        PassiveTimer pt(tout);
+
+        while( !pt.checkTime() && !act->exist() && !rrd->exist() )
+            msleep(100);
+
+        if( !act->exist() )
+        {
+            cerr << "(tests_with_sm): SharedMemory not exist! (timeout=" << tout << ")" << endl;
+            return 1;
+        }
+
+        if( !rrd->exist() )
+        {
+            cerr << "(tests_with_sm): RRDServer not exist! (timeout=" << tout << ")" << endl;
+            return 1;
+        }
+
+        return session.run();
+    }
+    catch( const SystemError& err )
+    {
+        cerr << "(tests_with_sm): " << err << endl;
+    }
+    catch( const uniset::Exception& ex )
+    {
+        cerr << "(tests_with_sm): " << ex << endl;
+    }
+    catch( const std::exception& e )
+    {
+        cerr << "(tests_with_sm): " << e.what() << endl;
+    }
+    catch(...)
+    {
+        cerr << "(tests_with_sm): catch(...)" << endl;
+    }
+
+    return 1;
+}
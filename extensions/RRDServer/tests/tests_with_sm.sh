@@ -0,0 +1,14 @@
+#!/bin/sh
+
+# '--' - нужен для отделения аргументов catch, от наших..
+cd ../../../Utilities/Admin/
+./uniset2-start.sh -f ./create_links.sh
+./uniset2-start.sh -f ./create
+
+./uniset2-start.sh -f ./exist | grep -q UNISET_PLC/Controllers || exit 1
+cd -
+
+./uniset2-start.sh -f ./tests-with-sm $* -- --confile rrd-test-configure.xml --e-startup-pause 10 \
+--rrd-name RRDServer1 --rrd-writers 2
+
+# --rrd-log-add-levels any
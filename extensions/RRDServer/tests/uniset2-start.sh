@@ -0,0 +1 @@
+../../../Utilities/scripts/uniset2-start.sh
\ No newline at end of file
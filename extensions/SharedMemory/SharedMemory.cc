@@ -22,6 +22,7 @@
 #include "Extensions.h"
 #include "ORepHelpers.h"
 #include "SMLogSugar.h"
+#include "UniSetActivator.h"
 // -----------------------------------------------------------------------------
 namespace uniset
 {
@@ -53,6 +54,10 @@ namespace uniset
         cout << "--http-api-disable-set [1,0]     - включение или отключение функции 'set' в HTTP API" << endl;
         cout << "--http-api-disable-freeze  [1,0] - включение или отключение функций 'freeze/unfreeze' в HTTP API" << endl;
         cout << "--http-api-disable-access-control  [1,0] - включение или отключение проверки прав доступа для функций HTTP API" << endl;
+        cout << "--http-api-changes-max-clients num  - максимальное число одновременных long-poll/SSE клиентов '/changes'. По умолчанию: 10" << endl;
+        cout << "                                      (не больше --activator-httpserver-max-threads - 1)" << endl;
+        cout << "--http-api-changes-max-timeout msec - максимальное время ожидания изменений в '/changes' (long-poll). По умолчанию: 60000" << endl;
+        cout << "--http-api-changes-heartbeat msec   - период посылки пустого сообщения в SSE-потоке '/changes'. По умолчанию: 15000" << endl;
         cout << endl;
         cout << "--sm-default-sensor-permission perm - Умолчательные права на датчики [RW, RO, WR, None]. По умолчанию: rw" << endl;
         cout << "--sm-ignore-acl-errors              - Игнорировать ошибки на стройках ACL" << endl;
@@ -194,6 +199,24 @@ namespace uniset
         if( disableHttpAccessControl )
             sminfo << myname << "(init): HTTP API 'access control' disabled" << endl;
 
+        httpChangesMaxClients = conf->getArgPInt("--http-api-changes-max-clients", httpChangesMaxClients);
+        httpChangesMaxTimeout = conf->getArgPInt("--http-api-changes-max-timeout", httpChangesMaxTimeout);
+        httpChangesHeartbeat = conf->getArgPInt("--http-api-changes-heartbeat", httpChangesHeartbeat);
+
+        // ожидающий клиент занимает поток http-сервера активатора на всё время ожидания,
+        // поэтому хотя бы один поток оставляем для остальных запросов
+        const int httpThreads = conf->getArgPInt("--activator-httpserver-max-threads", UniSetActivator::httpDefaultMaxThreads);
+        const size_t maxWaiting = ( httpThreads > 1 ) ? httpThreads - 1 : 0;
+
+        if( httpChangesMaxClients > maxWaiting )
+        {
+            smwarn << myname << "(init): --http-api-changes-max-clients " << httpChangesMaxClients
+                   << " >= --activator-httpserver-max-threads " << httpThreads
+                   << ". Set max clients to " << maxWaiting << endl;
+
+            httpChangesMaxClients = maxWaiting;
+        }
+
 #endif
 
         e_filter = conf->getArgParam("--e-filter");
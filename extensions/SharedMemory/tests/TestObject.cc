@@ -38,6 +38,17 @@ void TestObject::sysCommand( const uniset::SystemMessage* sm )
 // -----------------------------------------------------------------------------
 void TestObject::sensorInfo( const SensorMessage* sm )
 {
+    {
+        std::lock_guard<std::mutex> l(filterMutex);
+        auto i = filterStat.find(sm->id);
+
+        if( i != filterStat.end() )
+        {
+            i->second.count++;
+            i->second.value = sm->value;
+        }
+    }
+
     if( sm->id == monotonic_s )
     {
         if( (sm->value - lastValue) < 0 )
@@ -119,3 +130,28 @@ int TestObject::getLastTextMessageType() const
     return lastTextType;
 }
 // -----------------------------------------------------------------------------
+void TestObject::askFilter( ObjectId sid, const IONotifyController_i::NotifyFilter* filter )
+{
+    {
+        std::lock_guard<std::mutex> l(filterMutex);
+        filterStat[sid] = FilterStat();
+    }
+
+    if( filter )
+        ui->askSensor(sid, UniversalIO::UIONotify, *filter);
+    else
+        ui->askSensor(sid, UniversalIO::UIONotify);
+}
+// -----------------------------------------------------------------------------
+long TestObject::getFilterCount( ObjectId sid )
+{
+    std::lock_guard<std::mutex> l(filterMutex);
+    return filterStat[sid].count;
+}
+// -----------------------------------------------------------------------------
+long TestObject::getFilterValue( ObjectId sid )
+{
+    std::lock_guard<std::mutex> l(filterMutex);
+    return filterStat[sid].value;
+}
+// -----------------------------------------------------------------------------
@@ -1,6 +1,8 @@
 #ifndef _TestObject_H_
 #define _TestObject_H_
 // -----------------------------------------------------------------------------
+#include <mutex>
+#include <unordered_map>
 #include "TestObject_SK.h"
 // -----------------------------------------------------------------------------
 class TestObject:
@@ -39,6 +41,11 @@ class TestObject:
         std::string getLastTextMessage() const;
         int getLastTextMessageType() const;
 
+        // тест фильтрации уведомлений (filter=nullptr - обычный заказ)
+        void askFilter( uniset::ObjectId sid, const IONotifyController_i::NotifyFilter* filter );
+        long getFilterCount( uniset::ObjectId sid );
+        long getFilterValue( uniset::ObjectId sid );
+
     protected:
         TestObject();
 
@@ -54,6 +61,15 @@ class TestObject:
         long lastValue = { 0 };
         std::string lastText = { "" };
         int lastTextType = { 0 };
+
+        struct FilterStat
+        {
+            long count = { 0 };
+            long value = { 0 };
+        };
+
+        std::mutex filterMutex;
+        std::unordered_map<uniset::ObjectId, FilterStat> filterStat;
 };
 // -----------------------------------------------------------------------------
 #endif // _TestObject_H_
@@ -3,6 +3,13 @@
 #include <memory>
 #include <future>
 #include <fstream>
+#include <set>
+#include <sstream>
+#include <chrono>
+#include <Poco/Net/HTTPClientSession.h>
+#include <Poco/Net/HTTPRequest.h>
+#include <Poco/Net/HTTPResponse.h>
+#include <Poco/JSON/Parser.h>
 #include "UniSetTypes.h"
 #include "UInterface.h"
 #include "DelayTimer.h"
@@ -56,6 +63,277 @@ TEST_CASE("[SM]: get/set", "[sm][getset]")
     CHECK( ui->getValue(500) == 0 );
 }
 // -----------------------------------------------------------------------------
+TEST_CASE("[SM]: change sequence", "[sm][changes]")
+{
+    InitTest();
+
+    auto it = shm->find(500);
+    REQUIRE( it != shm->ioEnd() );
+
+    ui->setValue(500, 10);
+    uint64_t seq = shm->getChangeSeq();
+    REQUIRE( seq > 0 );
+    REQUIRE( it->second->changeSeq == seq );
+
+    // значение не изменилось - номер тот же
+    ui->setValue(500, 10);
+    REQUIRE( shm->getChangeSeq() == seq );
+    REQUIRE( shm->waitChanges(seq, 50) == seq );
+
+    ui->setValue(500, 11);
+    REQUIRE( shm->getChangeSeq() > seq );
+    REQUIRE( it->second->changeSeq > seq );
+
+    // ожидание изменений
+    seq = shm->getChangeSeq();
+    auto res = std::async(std::launch::async, [seq]
+    {
+        return shm->waitChanges(seq, 5000);
+    });
+
+    msleep(100);
+    ui->setValue(500, 12);
+    REQUIRE( res.wait_for(std::chrono::milliseconds(2000)) == std::future_status::ready );
+    REQUIRE( res.get() > seq );
+
+    ui->setValue(500, 0);
+}
+// -----------------------------------------------------------------------------
+#ifndef DISABLE_REST_API
+// GET /api/v2/SharedMemory/changes?... (см. --activator-httpserver-port в tests.sh)
+static Poco::Net::HTTPRequest changesRequest( const std::string& query )
+{
+    return Poco::Net::HTTPRequest(Poco::Net::HTTPRequest::HTTP_GET,
+                                  "/api/v2/SharedMemory/changes?supplier=TestObject&" + query,
+                                  Poco::Net::HTTPRequest::HTTP_1_1);
+}
+// -----------------------------------------------------------------------------
+// без REQUIRE (можно вызывать из другого потока)
+static std::string httpGet( const std::string& query, Poco::Net::HTTPResponse::HTTPStatus& status )
+{
+    Poco::Net::HTTPClientSession cs("127.0.0.1", 9797);
+    auto req = changesRequest(query);
+    Poco::Net::HTTPResponse res;
+
+    cs.sendRequest(req);
+    std::istream& rs = cs.receiveResponse(res);
+    status = res.getStatus();
+
+    std::stringstream ss;
+    ss << rs.rdbuf();
+    return ss.str();
+}
+// -----------------------------------------------------------------------------
+static Poco::JSON::Object::Ptr parseChanges( const std::string& data )
+{
+    Poco::JSON::Parser parser;
+    auto json = parser.parse(data).extract<Poco::JSON::Object::Ptr>();
+    REQUIRE( json );
+    REQUIRE( json->has("seq") );
+    REQUIRE( json->getArray("sensors") );
+    return json;
+}
+// -----------------------------------------------------------------------------
+static Poco::JSON::Object::Ptr httpChanges( const std::string& query )
+{
+    Poco::Net::HTTPResponse::HTTPStatus status;
+    auto data = httpGet(query, status);
+    REQUIRE( status == Poco::Net::HTTPResponse::HTTP_OK );
+    return parseChanges(data);
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("[SM]: HTTP /changes", "[sm][changes][http]")
+{
+    InitTest();
+
+    // since=0 - начальный снимок, в т.ч. датчики, которые ни разу не менялись (502)
+    auto json = httpChanges("since=0&filter=500,502");
+    auto jsens = json->getArray("sensors");
+    REQUIRE( jsens->size() == 2 );
+
+    std::set<long> ids;
+
+    for( size_t i = 0; i < jsens->size(); i++ )
+        ids.insert(jsens->getObject(i)->get("id").convert<long>());
+
+    REQUIRE( ids == std::set<long>{ 500, 502 } );
+
+    // без изменений - пустой список
+    uint64_t seq = json->get("seq").convert<uint64_t>();
+    REQUIRE( seq > 0 );
+    json = httpChanges("since=" + std::to_string(seq) + "&filter=500,502");
+    REQUIRE( json->getArray("sensors")->size() == 0 );
+    REQUIRE( json->get("seq").convert<uint64_t>() >= seq ); // могли измениться другие датчики (Pulsar_S)
+
+    // только изменившийся датчик
+    ui->setValue(500, 42);
+    json = httpChanges("since=" + std::to_string(seq) + "&filter=500,502");
+    jsens = json->getArray("sensors");
+    REQUIRE( jsens->size() == 1 );
+    REQUIRE( jsens->getObject(0)->get("id").convert<long>() == 500 );
+    REQUIRE( jsens->getObject(0)->get("value").convert<long>() == 42 );
+    REQUIRE( json->get("seq").convert<uint64_t>() > seq );
+
+    ui->setValue(500, 0);
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("[SM]: HTTP /changes (long-poll)", "[sm][changes][http]")
+{
+    InitTest();
+
+    ui->setValue(500, 0);
+    auto json = httpChanges("since=0&filter=500");
+    const uint64_t seq = json->get("seq").convert<uint64_t>();
+    const std::string query = "since=" + std::to_string(seq) + "&filter=500";
+
+    // изменений нет - ответ по истечении timeout
+    auto t0 = std::chrono::steady_clock::now();
+    json = httpChanges(query + "&timeout=300");
+    auto msec = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count();
+    REQUIRE( json->getArray("sensors")->size() == 0 );
+    REQUIRE( msec >= 250 );
+
+    // ожидание изменения
+    auto res = std::async(std::launch::async, [&query]
+    {
+        Poco::Net::HTTPResponse::HTTPStatus status;
+        auto data = httpGet(query + "&timeout=10000", status);
+        return std::make_pair(status, data);
+    });
+
+    msleep(200);
+    REQUIRE( res.wait_for(std::chrono::milliseconds(0)) == std::future_status::timeout );
+
+    // пока клиент ждёт, остальные запросы обрабатываются
+    t0 = std::chrono::steady_clock::now();
+    json = httpChanges("since=0&filter=502");
+    msec = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count();
+    REQUIRE( json->getArray("sensors")->size() == 1 );
+    REQUIRE( msec < 2000 );
+    REQUIRE( res.wait_for(std::chrono::milliseconds(0)) == std::future_status::timeout );
+
+    ui->setValue(500, 77);
+    REQUIRE( res.wait_for(std::chrono::milliseconds(3000)) == std::future_status::ready );
+
+    auto ret = res.get();
+    REQUIRE( ret.first == Poco::Net::HTTPResponse::HTTP_OK );
+    json = parseChanges(ret.second);
+    auto jsens = json->getArray("sensors");
+    REQUIRE( jsens->size() == 1 );
+    REQUIRE( jsens->getObject(0)->get("id").convert<long>() == 500 );
+    REQUIRE( jsens->getObject(0)->get("value").convert<long>() == 77 );
+    REQUIRE( json->get("seq").convert<uint64_t>() > seq );
+
+    ui->setValue(500, 0);
+}
+// -----------------------------------------------------------------------------
+// следующее SSE-событие (строки до пустой): данные события или комментарий (': ping')
+static std::string readEvent( std::istream& in, std::string& id )
+{
+    std::string line;
+    std::string data;
+    std::string comment;
+
+    while( std::getline(in, line) )
+    {
+        if( line.empty() )
+        {
+            if( !data.empty() || !comment.empty() )
+                break;
+
+            continue;
+        }
+
+        if( line[0] == ':' )
+            comment = line;
+        else if( line.compare(0, 4, "id: ") == 0 )
+            id = line.substr(4);
+        else if( line.compare(0, 6, "data: ") == 0 )
+            data = line.substr(6);
+    }
+
+    return data.empty() ? comment : data;
+}
+// -----------------------------------------------------------------------------
+// следующее событие с данными (ping пропускаются)
+static std::string readData( std::istream& in, std::string& id )
+{
+    for( size_t i = 0; i < 10; i++ )
+    {
+        auto data = readEvent(in, id);
+
+        if( data.empty() || data[0] != ':' )
+            return data;
+    }
+
+    return "";
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("[SM]: HTTP /changes (SSE)", "[sm][changes][http][sse]")
+{
+    InitTest();
+
+    ui->setValue(500, 0);
+    auto json = httpChanges("since=0&filter=500");
+    const uint64_t seq = json->get("seq").convert<uint64_t>();
+
+    std::string lastId;
+
+    {
+        Poco::Net::HTTPClientSession cs("127.0.0.1", 9797);
+        cs.setTimeout(Poco::Timespan(5, 0));
+        auto req = changesRequest("sse&interval=0&since=" + std::to_string(seq) + "&filter=500");
+        Poco::Net::HTTPResponse res;
+
+        cs.sendRequest(req);
+        std::istream& in = cs.receiveResponse(res);
+        REQUIRE( res.getStatus() == Poco::Net::HTTPResponse::HTTP_OK );
+        REQUIRE( res.getContentType().find("text/event-stream") != std::string::npos );
+
+        // изменений нет - приходит только ping (--http-api-changes-heartbeat в tests.sh)
+        std::string id;
+        REQUIRE( readEvent(in, id) == ": ping" );
+
+        ui->setValue(500, 55);
+        auto data = readData(in, id);
+        REQUIRE_FALSE( data.empty() );
+        REQUIRE( data[0] == '{' );
+
+        json = parseChanges(data);
+        auto jsens = json->getArray("sensors");
+        REQUIRE( jsens->size() == 1 );
+        REQUIRE( jsens->getObject(0)->get("id").convert<long>() == 500 );
+        REQUIRE( jsens->getObject(0)->get("value").convert<long>() == 55 );
+        REQUIRE( std::to_string(json->get("seq").convert<uint64_t>()) == id );
+        lastId = id;
+    }
+
+    // переподключение: продолжаем с Last-Event-ID
+    ui->setValue(500, 56);
+
+    Poco::Net::HTTPClientSession cs("127.0.0.1", 9797);
+    cs.setTimeout(Poco::Timespan(5, 0));
+    auto req = changesRequest("sse&interval=0&filter=500");
+    req.set("Last-Event-ID", lastId);
+    Poco::Net::HTTPResponse res;
+
+    cs.sendRequest(req);
+    std::istream& in = cs.receiveResponse(res);
+    REQUIRE( res.getStatus() == Poco::Net::HTTPResponse::HTTP_OK );
+
+    std::string id;
+    auto data = readData(in, id);
+    REQUIRE_FALSE( data.empty() );
+    REQUIRE( data[0] == '{' );
+
+    json = parseChanges(data);
+    REQUIRE( std::to_string(json->get("since").convert<uint64_t>()) == lastId );
+    REQUIRE( json->getArray("sensors")->getObject(0)->get("value").convert<long>() == 56 );
+
+    ui->setValue(500, 0);
+}
+#endif
+// -----------------------------------------------------------------------------
 TEST_CASE("[SM]: threshold", "[sm][threshold]")
 {
     InitTest();
@@ -177,6 +455,87 @@ TEST_CASE("[SM]: askDoNotNotify", "[sm][ask]")
     CHECK( obj->in_sensor_s ); // должно придти т.к. равно "1"
 }
 // -----------------------------------------------------------------------------
+TEST_CASE("[SM]: notify filter", "[sm][ask][filter]")
+{
+    InitTest();
+
+    const ObjectId sid = 530; // FilterAI_S
+    ui->setValue(sid, 0);
+
+    IONotifyController_i::NotifyFilter f;
+    f.deadband = 10;
+    f.deadband_pct = 0;
+    f.minInterval = 500;
+
+    obj->askFilter(sid, &f);
+    msleep(200);
+
+    // первое уведомление (при заказе) приходит всегда
+    REQUIRE( obj->getFilterCount(sid) == 1 );
+    REQUIRE( obj->getFilterValue(sid) == 0 );
+
+    msleep(500);
+
+    // изменения в зоне нечувствительности не посылаются
+    ui->setValue(sid, 5);
+    ui->setValue(sid, -9);
+    msleep(200);
+    CHECK( obj->getFilterCount(sid) == 1 );
+
+    // вышли из зоны (интервал истёк) - посылается сразу
+    ui->setValue(sid, 20);
+    msleep(200);
+    CHECK( obj->getFilterCount(sid) == 2 );
+    CHECK( obj->getFilterValue(sid) == 20 );
+
+    // внутри интервала изменения не посылаются,
+    // но по его истечении приходит последнее значение
+    ui->setValue(sid, 40);
+    ui->setValue(sid, 60);
+    ui->setValue(sid, 80);
+    msleep(50);
+    CHECK( obj->getFilterCount(sid) == 2 );
+
+    msleep(600);
+    CHECK( obj->getFilterCount(sid) == 3 );
+    CHECK( obj->getFilterValue(sid) == 80 );
+
+    // перезаказ без фильтра - приходят все изменения
+    obj->askFilter(sid, nullptr);
+    msleep(200);
+    REQUIRE( obj->getFilterCount(sid) == 1 );
+
+    ui->setValue(sid, 81);
+    msleep(200);
+    ui->setValue(sid, 82);
+    msleep(200);
+    CHECK( obj->getFilterCount(sid) == 3 );
+    CHECK( obj->getFilterValue(sid) == 82 );
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("[SM]: notify filter (configure)", "[sm][ask][filter]")
+{
+    InitTest();
+
+    // в <consumers> для TestObject задано: deadband="5" min_interval="300"
+    const ObjectId sid = 531; // FilterConfAI_S
+    ui->setValue(sid, 0);
+
+    obj->askFilter(sid, nullptr);
+    msleep(200);
+    REQUIRE( obj->getFilterCount(sid) == 1 );
+
+    msleep(300);
+    ui->setValue(sid, 3);
+    msleep(200);
+    CHECK( obj->getFilterCount(sid) == 1 );
+
+    ui->setValue(sid, 10);
+    msleep(200);
+    CHECK( obj->getFilterCount(sid) == 2 );
+    CHECK( obj->getFilterValue(sid) == 10 );
+}
+// -----------------------------------------------------------------------------
 TEST_CASE("[SM]: heartbeat test N2", "[sm][heartbeat]")
 {
     InitTest();
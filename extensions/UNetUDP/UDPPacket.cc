@@ -15,7 +15,13 @@
  */
 // -------------------------------------------------------------------------
 #include <cstdint>
+#include <cstring>
 #include <endian.h>
+#include <algorithm>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "CRC16.h"
 #include "UDPPacket.h"
 // -------------------------------------------------------------------------
 // сделано так, чтобы макросы раскрывались в "пустоту" если не требуется преобразование
@@ -25,15 +31,12 @@
 #if __BYTE_ORDER == __LITTLE_ENDIAN
 static uint8_t HostIsBigEndian = 0;
 #define LE_TO_H(x) {}
-#define LE32_TO_H(x) {}
 #define LE16_TO_H(x) {}
 #elif INTPTR_MAX == INT64_MAX
 #define LE_TO_H(x) x = le64toh(x)
-#define LE32_TO_H(x) x = le32toh(x)
 #define LE16_TO_H(x) x = le16toh(x)
 #elif INTPTR_MAX == INT32_MAX
 #define LE_TO_H(x) x = le32toh(x)
-#define LE32_TO_H(x) x = le32toh(x)
 #define LE16_TO_H(x) x = le16toh(x)
 #else
 #error UNET(LE_TO_H): Unknown byte order or size of pointer
@@ -42,15 +45,12 @@ static uint8_t HostIsBigEndian = 0;
 #if __BYTE_ORDER == __BIG_ENDIAN
 static uint8_t HostIsBigEndian = 1;
 #define BE_TO_H(x) {}
-#define BE32_TO_H(x) {}
 #define BE16_TO_H(x) {}
 #elif INTPTR_MAX == INT64_MAX
 #define BE_TO_H(x) x = be64toh(x)
-#define BE32_TO_H(x) x = be32toh(x)
 #define BE16_TO_H(x) x = be16toh(x)
 #elif INTPTR_MAX == INT32_MAX
 #define BE_TO_H(x) x = be32toh(x)
-#define BE32_TO_H(x) x = be32toh(x)
 #define BE16_TO_H(x) x = be16toh(x)
 #else
 #error UNET(BE_TO_H): Unknown byte order or size of pointer
@@ -62,81 +62,9 @@ namespace uniset
     using namespace std;
     using namespace UniSetUDP;
     // ---------------------------------------------------------------------
-#define USE_CRC_TAB 1 // при расчёте использовать таблицы
-    // ---------------------------------------------------------------------
-#ifdef USE_CRC_TAB
-    static unsigned short crc_16_tab[] =
-    {
-        0x0000, 0xc0c1, 0xc181, 0x0140, 0xc301, 0x03c0, 0x0280, 0xc241,
-        0xc601, 0x06c0, 0x0780, 0xc741, 0x0500, 0xc5c1, 0xc481, 0x0440,
-        0xcc01, 0x0cc0, 0x0d80, 0xcd41, 0x0f00, 0xcfc1, 0xce81, 0x0e40,
-        0x0a00, 0xcac1, 0xcb81, 0x0b40, 0xc901, 0x09c0, 0x0880, 0xc841,
-        0xd801, 0x18c0, 0x1980, 0xd941, 0x1b00, 0xdbc1, 0xda81, 0x1a40,
-        0x1e00, 0xdec1, 0xdf81, 0x1f40, 0xdd01, 0x1dc0, 0x1c80, 0xdc41,
-        0x1400, 0xd4c1, 0xd581, 0x1540, 0xd701, 0x17c0, 0x1680, 0xd641,
-        0xd201, 0x12c0, 0x1380, 0xd341, 0x1100, 0xd1c1, 0xd081, 0x1040,
-        0xf001, 0x30c0, 0x3180, 0xf141, 0x3300, 0xf3c1, 0xf281, 0x3240,
-        0x3600, 0xf6c1, 0xf781, 0x3740, 0xf501, 0x35c0, 0x3480, 0xf441,
-        0x3c00, 0xfcc1, 0xfd81, 0x3d40, 0xff01, 0x3fc0, 0x3e80, 0xfe41,
-        0xfa01, 0x3ac0, 0x3b80, 0xfb41, 0x3900, 0xf9c1, 0xf881, 0x3840,
-        0x2800, 0xe8c1, 0xe981, 0x2940, 0xeb01, 0x2bc0, 0x2a80, 0xea41,
-        0xee01, 0x2ec0, 0x2f80, 0xef41, 0x2d00, 0xedc1, 0xec81, 0x2c40,
-        0xe401, 0x24c0, 0x2580, 0xe541, 0x2700, 0xe7c1, 0xe681, 0x2640,
-        0x2200, 0xe2c1, 0xe381, 0x2340, 0xe101, 0x21c0, 0x2080, 0xe041,
-        0xa001, 0x60c0, 0x6180, 0xa141, 0x6300, 0xa3c1, 0xa281, 0x6240,
-        0x6600, 0xa6c1, 0xa781, 0x6740, 0xa501, 0x65c0, 0x6480, 0xa441,
-        0x6c00, 0xacc1, 0xad81, 0x6d40, 0xaf01, 0x6fc0, 0x6e80, 0xae41,
-        0xaa01, 0x6ac0, 0x6b80, 0xab41, 0x6900, 0xa9c1, 0xa881, 0x6840,
-        0x7800, 0xb8c1, 0xb981, 0x7940, 0xbb01, 0x7bc0, 0x7a80, 0xba41,
-        0xbe01, 0x7ec0, 0x7f80, 0xbf41, 0x7d00, 0xbdc1, 0xbc81, 0x7c40,
-        0xb401, 0x74c0, 0x7580, 0xb541, 0x7700, 0xb7c1, 0xb681, 0x7640,
-        0x7200, 0xb2c1, 0xb381, 0x7340, 0xb101, 0x71c0, 0x7080, 0xb041,
-        0x5000, 0x90c1, 0x9181, 0x5140, 0x9301, 0x53c0, 0x5280, 0x9241,
-        0x9601, 0x56c0, 0x5780, 0x9741, 0x5500, 0x95c1, 0x9481, 0x5440,
-        0x9c01, 0x5cc0, 0x5d80, 0x9d41, 0x5f00, 0x9fc1, 0x9e81, 0x5e40,
-        0x5a00, 0x9ac1, 0x9b81, 0x5b40, 0x9901, 0x59c0, 0x5880, 0x9841,
-        0x8801, 0x48c0, 0x4980, 0x8941, 0x4b00, 0x8bc1, 0x8a81, 0x4a40,
-        0x4e00, 0x8ec1, 0x8f81, 0x4f40, 0x8d01, 0x4dc0, 0x4c80, 0x8c41,
-        0x4400, 0x84c1, 0x8581, 0x4540, 0x8701, 0x47c0, 0x4680, 0x8641,
-        0x8201, 0x42c0, 0x4380, 0x8341, 0x4100, 0x81c1, 0x8081, 0x4040
-    };
-#endif
-    // -------------------------------------------------------------------------
-    /* CRC-16 is based on the polynomial x^16 + x^15 + x^2 + 1.  Bits are */
-    /* sent LSB to MSB. */
-    static int get_crc_16( uint16_t crc, unsigned char* buf, int size ) noexcept
-    {
-
-        while( size-- )
-        {
-#ifdef USE_CRC_TAB
-            crc = (crc >> 8) ^ crc_16_tab[ (crc ^ * (buf++)) & 0xff ];
-#else
-            register int i, ch;
-            ch = *(buf++);
-
-            for (i = 0; i < 8; i++)
-            {
-                if ((crc ^ ch) & 1)
-                    crc = (crc >> 1) ^ 0xa001;
-                else
-                    crc >>= 1;
-
-                ch >>= 1;
-            }
-
-#endif
-            // crc = crc & 0xffff;
-        }
-
-        return crc;
-    }
-    // -------------------------------------------------------------------------
     uint16_t UniSetUDP::makeCRC( unsigned char* buf, size_t len ) noexcept
     {
-        uint16_t crc = 0xffff;
-        crc = get_crc_16(crc, (unsigned char*)(buf), len);
-        return crc;
+        return CRC16::calc(buf, len);
     }
     // -----------------------------------------------------------------------------
     std::ostream& UniSetUDP::operator<<( std::ostream& os, UniSetUDP::UDPHeader& p )
@@ -234,6 +162,24 @@ namespace uniset
         return true;
     }
     // -----------------------------------------------------------------------------
+    void UDPMessage::setDBits( const uint8_t* vals, size_t num ) noexcept
+    {
+        packBits(vals, std::min(num, MaxDCount), d_dat);
+    }
+    // -----------------------------------------------------------------------------
+    void UDPMessage::getDBits( uint8_t* vals, size_t num ) const noexcept
+    {
+        unpackBits(d_dat, std::min(num, MaxDCount), vals);
+    }
+    // -----------------------------------------------------------------------------
+    void UDPMessage::setAValues( const int64_t* vals, size_t num ) noexcept
+    {
+        num = std::min(num, MaxACount);
+
+        for( size_t i = 0; i < num; i++ )
+            a_dat[i].val = vals[i];
+    }
+    // -----------------------------------------------------------------------------
     long UDPMessage::dID( size_t index ) const noexcept
     {
         if( index >= MaxDCount )
@@ -307,34 +253,20 @@ namespace uniset
 
         // CONVERT DATA TO HOST BYTE ORDER
         // -------------------------------
-        if( be_order != HostIsBigEndian )
-        {
-            for( size_t n = 0; n < header.acount; n++ )
-            {
-                if( be_order )
-                {
-                    BE32_TO_H(a_dat[n].id);
-                    BE_TO_H(a_dat[n].val);
-                }
-                else
-                {
-                    LE32_TO_H(a_dat[n].id);
-                    LE_TO_H(a_dat[n].val);
-                }
-            }
+        // Сюда попадаем, только если порядок байт в пакете отличается от нашего,
+        // значит преобразование (и BE->LE, и LE->BE) сводится к перестановке байт.
+        // Циклы сделаны без ветвлений внутри, чтобы компилятор мог их векторизовать.
+        const size_t anum = std::min((size_t)header.acount, MaxACount);
+        const size_t dnum = std::min((size_t)header.dcount, MaxDCount);
 
-            for( size_t n = 0; n < header.dcount; n++ )
-            {
-                if( be_order )
-                {
-                    BE32_TO_H(d_id[n]);
-                }
-                else
-                {
-                    LE32_TO_H(d_id[n]);
-                }
-            }
+        for( size_t n = 0; n < anum; n++ )
+        {
+            a_dat[n].id = (int32_t)__builtin_bswap32((uint32_t)a_dat[n].id);
+            a_dat[n].val = (int64_t)__builtin_bswap64((uint64_t)a_dat[n].val);
         }
+
+        for( size_t n = 0; n < dnum; n++ )
+            d_id[n] = (int32_t)__builtin_bswap32((uint32_t)d_id[n]);
     }
     // -----------------------------------------------------------------------------
     void UDPMessage::updatePacketCrc() noexcept
@@ -345,15 +277,115 @@ namespace uniset
     // -----------------------------------------------------------------------------
     uint16_t UDPMessage::calcDcrc() const noexcept
     {
+        // считаем только по заполненной части пакета
+        const size_t dnum = std::min((size_t)header.dcount, MaxDCount);
         uint16_t crc[2];
-        crc[0] = makeCRC( (unsigned char*)(d_id), sizeof(d_id) );
-        crc[1] = makeCRC( (unsigned char*)(d_dat), sizeof(d_dat) );
+        crc[0] = makeCRC( (unsigned char*)(d_id), dnum * sizeof(d_id[0]) );
+        crc[1] = makeCRC( (unsigned char*)(d_dat), (dnum + 7) / 8 );
         return makeCRC( (unsigned char*)(&crc), sizeof(crc) );
     }
     // -----------------------------------------------------------------------------
     uint16_t UDPMessage::calcAcrc() const noexcept
     {
-        return makeCRC( (unsigned char*)(&a_dat), sizeof(a_dat) );
+        const size_t anum = std::min((size_t)header.acount, MaxACount);
+        return makeCRC( (unsigned char*)(&a_dat), anum * sizeof(a_dat[0]) );
+    }
+    // -----------------------------------------------------------------------------
+    void UniSetUDP::packBits( const uint8_t* vals, size_t num, uint8_t* bits ) noexcept
+    {
+        size_t i = 0;
+
+#if defined(__SSE2__)
+        // 16 значений -> 16 бит (movemask собирает старшие биты байтов)
+        const __m128i zero = _mm_setzero_si128();
+
+        for( ; i + 16 <= num; i += 16 )
+        {
+            __m128i v = _mm_loadu_si128((const __m128i*)(vals + i));
+            uint32_t m = ~_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero)) & 0xFFFF;
+            bits[i >> 3] = m & 0xFF;
+            bits[(i >> 3) + 1] = m >> 8;
+        }
+
+#endif
+
+        for( ; i + 8 <= num; i += 8 )
+        {
+            uint8_t b = 0;
+
+            for( size_t k = 0; k < 8; k++ )
+                b |= (vals[i + k] ? 1 : 0) << k;
+
+            bits[i >> 3] = b;
+        }
+
+        // неполный последний байт (остальные биты сохраняем)
+        if( i < num )
+        {
+            uint8_t b = bits[i >> 3];
+
+            for( size_t k = 0; i + k < num; k++ )
+            {
+                const uint8_t mask = 1 << k;
+                b = vals[i + k] ? (b | mask) : (b & ~mask);
+            }
+
+            bits[i >> 3] = b;
+        }
+    }
+    // -----------------------------------------------------------------------------
+    void UniSetUDP::unpackBits( const uint8_t* bits, size_t num, uint8_t* vals ) noexcept
+    {
+        size_t i = 0;
+
+#if defined(__SSE2__)
+        // 16 бит -> 16 байт: каждый байт вектора "размножаем" на 8 позиций
+        // и проверяем "свой" бит маской 1,2,4..128
+        const __m128i mask = _mm_set1_epi64x(0x8040201008040201LL);
+        const __m128i one = _mm_set1_epi8(1);
+
+        for( ; i + 16 <= num; i += 16 )
+        {
+            const uint64_t lo = bits[i >> 3] * 0x0101010101010101ULL;
+            const uint64_t hi = bits[(i >> 3) + 1] * 0x0101010101010101ULL;
+            __m128i v = _mm_and_si128(_mm_set_epi64x((long long)hi, (long long)lo), mask);
+            v = _mm_and_si128(_mm_cmpeq_epi8(v, mask), one);
+            _mm_storeu_si128((__m128i*)(vals + i), v);
+        }
+
+#endif
+
+        for( ; i < num; i++ )
+            vals[i] = (bits[i >> 3] >> (i & 0x7)) & 1;
+    }
+    // -----------------------------------------------------------------------------
+    size_t UniSetUDP::diffBits( const uint8_t* a, const uint8_t* b, size_t num, size_t* changed ) noexcept
+    {
+        size_t n = 0;
+        size_t i = 0;
+
+        // по 64 бита, без изменений - пропускаем сразу
+        for( ; i + 64 <= num; i += 64 )
+        {
+            uint64_t x, y;
+            std::memcpy(&x, a + (i >> 3), sizeof(x));
+            std::memcpy(&y, b + (i >> 3), sizeof(y));
+            uint64_t d = le64toh(x ^ y);
+
+            while( d )
+            {
+                changed[n++] = i + __builtin_ctzll(d);
+                d &= d - 1;
+            }
+        }
+
+        for( ; i < num; i++ )
+        {
+            if( (a[i >> 3] ^ b[i >> 3]) & (1 << (i & 0x7)) )
+                changed[n++] = i;
+        }
+
+        return n;
     }
     // -----------------------------------------------------------------------------
     UDPHeader::UDPHeader() noexcept
@@ -110,6 +110,17 @@ namespace uniset
             //!\return true - successful
             bool setAData( size_t index, int64_t val ) noexcept;
 
+            // Пакетное обновление (сразу для всех датчиков пакета, вместо поштучных setDData/setAData)
+            // -------------------------------
+            //! записать значения дискретных [0...num) из массива vals (0 или 1)
+            void setDBits( const uint8_t* vals, size_t num ) noexcept;
+
+            //! прочитать значения дискретных [0...num) в массив vals (0 или 1)
+            void getDBits( uint8_t* vals, size_t num ) const noexcept;
+
+            //! записать значения аналоговых [0...num) из массива vals
+            void setAValues( const int64_t* vals, size_t num ) noexcept;
+
             long getDataID( ) const noexcept; /*!< получение "уникального" идентификатора данных этого пакета */
 
             inline bool isAFull() const noexcept
@@ -136,6 +147,7 @@ namespace uniset
                 return header.acount;
             }
 
+            // CRC считается только по заполненной части (dcount/acount), а не по всему массиву
             uint16_t calcDcrc() const noexcept;
             uint16_t calcAcrc() const noexcept;
             void updatePacketCrc() noexcept;
@@ -148,6 +160,26 @@ namespace uniset
 
         std::ostream& operator<<( std::ostream& os, UDPMessage& p );
 
+        // Функции для работы с битовым массивом значений (d_dat) целиком.
+        // Бит с индексом i хранится в байте i/8, разряд i%8 (как в setDData/dValue).
+        // pack/unpack обрабатывают по 16 значений за раз (SSE2), иначе (и для остатка) - по 8 (байтами),
+        // diffBits сравнивает по 64 бита.
+        // -----------------------------------------------------------------------------
+        /*! упаковать num значений (0 - false, иначе true) в битовый массив bits.
+         * Биты за пределами num (в последнем байте) не изменяются.
+         */
+        void packBits( const uint8_t* vals, size_t num, uint8_t* bits ) noexcept;
+
+        //! распаковать num битов в массив значений (0 или 1)
+        void unpackBits( const uint8_t* bits, size_t num, uint8_t* vals ) noexcept;
+
+        /*! сравнить битовые массивы a и b (первые num битов)
+         * \param changed - сюда записываются индексы отличающихся битов (размер не меньше num)
+         * \return количество отличающихся битов
+         */
+        size_t diffBits( const uint8_t* a, const uint8_t* b, size_t num, size_t* changed ) noexcept;
+
+        // CRC-16 (см. CRC16.h)
         uint16_t makeCRC( unsigned char* buf, size_t len ) noexcept;
     }
     // --------------------------------------------------------------------------
@@ -15,6 +15,8 @@
  */
 // -------------------------------------------------------------------------
 #include <sstream>
+#include <cstring>
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <Poco/Net/NetException.h>
@@ -163,6 +165,12 @@ namespace uniset
     // -----------------------------------------------------------------------------
     void UNetReceiver::setLockUpdate( bool st ) noexcept
     {
+        // Пока сохранение было заблокировано, датчики в SM обновлял кто-то другой (другой канал),
+        // поэтому запомненные данные (crc, значения) устарели и первый пакет должен обновить все датчики.
+        // Сам кэш сбрасывается в потоке обработки (см. update())
+        if( !st && lockUpdate )
+            cacheInvalid = true;
+
         lockUpdate = st;
 
         if( !st )
@@ -345,12 +353,7 @@ namespace uniset
         if( wnum == 1 && rnum == 0 )
             return;
 
-        // сбрасываем кэш
-        for( auto&& c : d_icache_map )
-            c.second.crc = 0;
-
-        for( auto&& c : a_icache_map )
-            c.second.crc = 0;
+        resetCache();
 
         // сбрасываем запомненый номер последнего обработанного пакета
         // и тем самым заставляем обработать заново последний пакет и обновить данные в SM (см. update)
@@ -397,9 +400,6 @@ namespace uniset
             return;
 
         UniSetUDP::UDPMessage* p;
-        CacheItem* c_it = nullptr;
-        UniSetUDP::UDPAData* dat = nullptr;
-        long s_id;
 
         // обрабатываем, пока очередь либо не опустеет,
         // либо обнаружится "дырка" в последовательности,
@@ -438,95 +438,164 @@ namespace uniset
             if( mode == Mode::mDisabled )
                 continue;
 
+            if( cacheInvalid.exchange(false) )
+                resetCache();
+
             // Обработка дискретных
             auto dcache = getDCache(p);
 
             if( p->header.dcrc == 0 || dcache->crc != p->header.dcrc || ignoreCRC )
-            {
-                dcache->crc = p->header.dcrc;
-
-                for( size_t i = 0; i < p->header.dcount; i++ )
-                {
-                    try
-                    {
-                        s_id = p->dID(i);
-                        c_it = &(dcache->items[i]);
-
-                        if (c_it->id != s_id)
-                        {
-                            unetwarn << myname << "(update): reinit dcache for sid=" << s_id << endl;
-                            c_it->id = s_id;
-                            shm->initIterator(c_it->ioit);
-                        }
-
-                        shm->localSetValue(c_it->ioit, s_id, p->dValue(i), shm->ID());
-                    }
-                    catch (const uniset::Exception& ex)
-                    {
-                        // сбрасываем crc, т.к. данные не удалось успешно обновить
-                        dcache->crc = 0;
-                        unetcrit << myname << "(update): D:"
-                                 << " id=" << s_id
-                                 << " val=" << p->dValue(i)
-                                 << " error: " << ex
-                                 << std::endl;
-                    }
-                    catch (...)
-                    {
-                        // сбрасываем crc, т.к. данные не удалось успешно обновить
-                        dcache->crc = 0;
-                        unetcrit << myname << "(update): D:"
-                                 << " id=" << s_id
-                                 << " val=" << p->dValue(i)
-                                 << " error: catch..."
-                                 << std::endl;
-                    }
-                }
-            }
+                updateDData(dcache, p);
 
             // Обработка аналоговых
             auto acache = getACache(p);
 
             if( p->header.acrc == 0 || acache->crc != p->header.acrc || ignoreCRC )
+                updateAData(acache, p);
+        }
+    }
+    // -----------------------------------------------------------------------------
+    void UNetReceiver::resetCache() noexcept
+    {
+        // при crc=0 следующий пакет обновляет все датчики (без сравнения с запомненными значениями)
+        for( auto&& c : d_icache_map )
+            c.second.crc = 0;
+
+        for( auto&& c : a_icache_map )
+            c.second.crc = 0;
+    }
+    // -----------------------------------------------------------------------------
+    void UNetReceiver::updateDData( CacheInfo* dcache, UniSetUDP::UDPMessage* p ) noexcept
+    {
+        const size_t dnum = std::min((size_t)p->header.dcount, UniSetUDP::MaxDCount);
+        const size_t dbytes = (dnum + 7) / 8;
+
+        // Если данные предыдущего пакета известны (crc не сбрасывался) и список датчиков тот же,
+        // то в SM записываются только изменившиеся значения (по разнице битовых масок),
+        // иначе - все датчики пакета.
+        const bool onlyChanged = dcache->crc != 0 && p->header.dcrc != 0 && !ignoreCRC
+                                 && dcache->bits.size() == dbytes && dcache->ids.size() == dnum
+                                 && std::memcmp(dcache->ids.data(), (const uint8_t*)p->d_id, dnum * sizeof(int32_t)) == 0;
+
+        dcache->crc = p->header.dcrc;
+
+        if( onlyChanged )
+        {
+            if( dchanged.size() < dnum )
+                dchanged.resize(dnum);
+
+            const size_t num = UniSetUDP::diffBits(dcache->bits.data(), p->d_dat, dnum, dchanged.data());
+
+            for( size_t k = 0; k < num; k++ )
+                updateDItem(dcache, p, dchanged[k]);
+        }
+        else
+        {
+            for( size_t i = 0; i < dnum; i++ )
+                updateDItem(dcache, p, i);
+
+            dcache->ids.resize(dnum);
+            std::memcpy(dcache->ids.data(), (const uint8_t*)p->d_id, dnum * sizeof(int32_t));
+        }
+
+        dcache->bits.assign(p->d_dat, p->d_dat + dbytes);
+    }
+    // -----------------------------------------------------------------------------
+    void UNetReceiver::updateDItem( CacheInfo* dcache, UniSetUDP::UDPMessage* p, size_t i ) noexcept
+    {
+        long s_id = p->dID(i);
+
+        try
+        {
+            CacheItem* c_it = &(dcache->items[i]);
+
+            if (c_it->id != s_id)
             {
-                acache->crc = p->header.acrc;
+                unetwarn << myname << "(update): reinit dcache for sid=" << s_id << endl;
+                c_it->id = s_id;
+                shm->initIterator(c_it->ioit);
+            }
 
-                for( size_t i = 0; i < p->header.acount; i++ )
-                {
-                    try
-                    {
-                        dat = &p->a_dat[i];
-                        c_it = &(acache->items)[i];
-
-                        if (c_it->id != dat->id)
-                        {
-                            unetwarn << myname << "(update): reinit acache for sid=" << dat->id << endl;
-                            c_it->id = dat->id;
-                            shm->initIterator(c_it->ioit);
-                        }
-
-                        shm->localSetValue(c_it->ioit, dat->id, dat->val, shm->ID());
-                    }
-                    catch (const uniset::Exception& ex)
-                    {
-                        acache->crc = 0;
-                        unetcrit << myname << "(update): A:"
-                                 << " id=" << dat->id
-                                 << " val=" << dat->val
-                                 << " error: " << ex
-                                 << std::endl;
-                    }
-                    catch (...)
-                    {
-                        acache->crc = 0;
-                        unetcrit << myname << "(update): A:"
-                                 << " id=" << dat->id
-                                 << " val=" << dat->val
-                                 << " error: catch..."
-                                 << std::endl;
-                    }
-                }
+            shm->localSetValue(c_it->ioit, s_id, p->dValue(i), shm->ID());
+        }
+        catch (const uniset::Exception& ex)
+        {
+            // сбрасываем crc, т.к. данные не удалось успешно обновить
+            dcache->crc = 0;
+            unetcrit << myname << "(update): D:"
+                     << " id=" << s_id
+                     << " val=" << p->dValue(i)
+                     << " error: " << ex
+                     << std::endl;
+        }
+        catch (...)
+        {
+            // сбрасываем crc, т.к. данные не удалось успешно обновить
+            dcache->crc = 0;
+            unetcrit << myname << "(update): D:"
+                     << " id=" << s_id
+                     << " val=" << p->dValue(i)
+                     << " error: catch..."
+                     << std::endl;
+        }
+    }
+    // -----------------------------------------------------------------------------
+    void UNetReceiver::updateAData( CacheInfo* acache, UniSetUDP::UDPMessage* p ) noexcept
+    {
+        const size_t anum = std::min((size_t)p->header.acount, UniSetUDP::MaxACount);
+
+        // аналогично дискретным: при известных предыдущих данных обновляем только изменившиеся
+        // (сравнивается пара id-значение целиком, поэтому смена датчика тоже будет обработана)
+        const bool onlyChanged = acache->crc != 0 && p->header.acrc != 0 && !ignoreCRC
+                                 && acache->adat.size() == anum;
+
+        acache->crc = p->header.acrc;
+
+        for( size_t i = 0; i < anum; i++ )
+        {
+            if( onlyChanged && std::memcmp(&acache->adat[i], &p->a_dat[i], sizeof(UniSetUDP::UDPAData)) == 0 )
+                continue;
+
+            updateAItem(acache, p, i);
+        }
+
+        acache->adat.assign(p->a_dat, p->a_dat + anum);
+    }
+    // -----------------------------------------------------------------------------
+    void UNetReceiver::updateAItem( CacheInfo* acache, UniSetUDP::UDPMessage* p, size_t i ) noexcept
+    {
+        UniSetUDP::UDPAData* dat = &p->a_dat[i];
+
+        try
+        {
+            CacheItem* c_it = &(acache->items)[i];
+
+            if (c_it->id != dat->id)
+            {
+                unetwarn << myname << "(update): reinit acache for sid=" << dat->id << endl;
+                c_it->id = dat->id;
+                shm->initIterator(c_it->ioit);
             }
+
+            shm->localSetValue(c_it->ioit, dat->id, dat->val, shm->ID());
+        }
+        catch (const uniset::Exception& ex)
+        {
+            acache->crc = 0;
+            unetcrit << myname << "(update): A:"
+                     << " id=" << dat->id
+                     << " val=" << dat->val
+                     << " error: " << ex
+                     << std::endl;
+        }
+        catch (...)
+        {
+            acache->crc = 0;
+            unetcrit << myname << "(update): A:"
+                     << " id=" << dat->id
+                     << " val=" << dat->val
+                     << " error: catch..."
+                     << std::endl;
         }
     }
     // -----------------------------------------------------------------------------
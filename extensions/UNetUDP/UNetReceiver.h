@@ -292,6 +292,7 @@ namespace uniset
             size_t maxDifferens = { 20 };
 
             std::atomic_bool lockUpdate = { false }; /*!< флаг блокировки сохранения принятых данных в SM */
+            std::atomic_bool cacheInvalid = { false }; /*!< кэш устарел (снята блокировка), сбросить перед обработкой пакета */
 
             EventSlot slEvent;
             Trigger trTimeout;
@@ -312,6 +313,12 @@ namespace uniset
                 uint16_t crc;
                 CacheVec items;
 
+                // данные последнего обработанного пакета
+                // (чтобы при изменении crc обновлять в SM только изменившиеся датчики)
+                std::vector<int32_t> ids;
+                std::vector<uint8_t> bits;
+                std::vector<UniSetUDP::UDPAData> adat;
+
                 CacheInfo(): crc(0) {}
             };
 
@@ -326,6 +333,13 @@ namespace uniset
 
             CacheInfo* getDCache( UniSetUDP::UDPMessage* upack ) noexcept;
             CacheInfo* getACache( UniSetUDP::UDPMessage* pack ) noexcept;
+
+            void resetCache() noexcept;
+            void updateDData( CacheInfo* dcache, UniSetUDP::UDPMessage* p ) noexcept;
+            void updateAData( CacheInfo* acache, UniSetUDP::UDPMessage* p ) noexcept;
+            void updateDItem( CacheInfo* dcache, UniSetUDP::UDPMessage* p, size_t i ) noexcept;
+            void updateAItem( CacheInfo* acache, UniSetUDP::UDPMessage* p, size_t i ) noexcept;
+            std::vector<size_t> dchanged; // индексы изменившихся дискретных (см. updateDData)
     };
     // --------------------------------------------------------------------------
 } // end of namespace uniset
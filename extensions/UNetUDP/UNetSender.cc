@@ -150,29 +150,83 @@ namespace uniset
             }
         }
 
-        for( auto&& it : items )
+        for( auto&& it : mypacks )
         {
-            UItem& i = it.second;
+            for( auto&& pack : it.second )
+                updatePack(pack);
+        }
+    }
+    // -----------------------------------------------------------------------------
+    void UNetSender::updatePack( PackMessage& pack )
+    {
+        // Значения сначала читаются из SM (без блокировки пакета),
+        // а потом пакет обновляется целиком за одну блокировку:
+        // дискретные - упаковкой всего битового массива, аналоговые - одним проходом.
+        // Если значение получить не удалось, в пакете остаётся то, что там сейчас
+        // (как и при поштучном обновлении): перед записью такие позиции берутся
+        // из самого пакета, а не из dvals/avals (там может быть устаревшее значение,
+        // а в пакете - уже более новое, записанное в updateSensor).
+        long value = 0;
+        std::vector<size_t> dfailed;
+        std::vector<size_t> afailed;
+        const size_t dnum = pack.ditems.size();
+
+        for( size_t i = 0; i < dnum; i++ )
+        {
+            if( readValue(*pack.ditems[i], value) )
+                pack.dvals[i] = value ? 1 : 0;
+            else
+                dfailed.push_back(i);
+        }
 
-            try
-            {
-                long value = shm->localGetValue(i.ioit, i.id);
-                updateItem(i, value);
-            }
-            catch( IOController_i::Undefined& ex )
-            {
-                unetwarn << myname << "(updateFromSM): sid=" << i.id
-                         << " undefined state (value=" << ex.value << ")." << endl;
-                updateItem( i, ex.value );
-            }
-            catch( std::exception& ex )
-            {
-                unetwarn << myname << "(updateFromSM): " << ex.what() << endl;
+        const size_t anum = pack.aitems.size();
+
+        for( size_t i = 0; i < anum; i++ )
+        {
+            if( readValue(*pack.aitems[i], value) )
+                pack.avals[i] = value;
+            else
+                afailed.push_back(i);
+        }
+
+        uniset::uniset_rwmutex_wrlock l(pack.mut);
+
+        for( const auto& i : dfailed )
+            pack.dvals[i] = pack.msg.dValue(i) ? 1 : 0;
+
+        for( const auto& i : afailed )
+            pack.avals[i] = pack.msg.a_dat[i].val;
+
+        pack.msg.setDBits(pack.dvals.data(), dnum);
+        pack.msg.setAValues(pack.avals.data(), anum);
+    }
+    // -----------------------------------------------------------------------------
+    bool UNetSender::readValue( UItem& i, long& value )
+    {
+        try
+        {
+            value = shm->localGetValue(i.ioit, i.id);
+            return true;
+        }
+        catch( IOController_i::Undefined& ex )
+        {
+            unetwarn << myname << "(updateFromSM): sid=" << i.id
+                     << " undefined state (value=" << ex.value << ")." << endl;
+            value = ex.value;
+            return true;
+        }
+        catch( std::exception& ex )
+        {
+            unetwarn << myname << "(updateFromSM): " << ex.what() << endl;
 
-                if( i.undefined_value != not_specified_value )
-                    updateItem( i, i.undefined_value );
+            if( i.undefined_value != not_specified_value )
+            {
+                value = i.undefined_value;
+                return true;
             }
         }
+
+        return false;
     }
 
     // -----------------------------------------------------------------------------
@@ -554,7 +608,36 @@ namespace uniset
             std::terminate();
         }
 
-        items.emplace(p.id, std::move(p));
+        auto ret = items.emplace(p.id, std::move(p));
+
+        // запоминаем датчик в пакете для пакетного обновления (см. updatePack)
+        // (указатели на элементы unordered_map не меняются при добавлении новых)
+        UItem* item = &ret.first->second;
+        auto& pack = pk[item->pack_num];
+
+        if( item->iotype == UniversalIO::DI || item->iotype == UniversalIO::DO )
+        {
+            if( pack.ditems.size() <= item->pack_ind )
+            {
+                pack.ditems.resize(item->pack_ind + 1, nullptr);
+                pack.dvals.resize(item->pack_ind + 1, 0);
+            }
+
+            pack.ditems[item->pack_ind] = item;
+            pack.dvals[item->pack_ind] = defval ? 1 : 0;
+        }
+        else
+        {
+            if( pack.aitems.size() <= item->pack_ind )
+            {
+                pack.aitems.resize(item->pack_ind + 1, nullptr);
+                pack.avals.resize(item->pack_ind + 1, 0);
+            }
+
+            pack.aitems[item->pack_ind] = item;
+            pack.avals[item->pack_ind] = defval;
+        }
+
         return true;
     }
 
@@ -124,6 +124,13 @@ namespace uniset
 
                 uniset::UniSetUDP::UDPMessage msg;
                 uniset::uniset_rwmutex mut;
+
+                // датчики пакета (индекс = pack_ind) и последние прочитанные из SM значения
+                // (используются только в updateFromSM для обновления пакета целиком)
+                std::vector<UItem*> ditems;
+                std::vector<UItem*> aitems;
+                std::vector<uint8_t> dvals;
+                std::vector<int64_t> avals;
             };
 
             void real_send( PackMessage& mypack ) noexcept;
@@ -131,6 +138,14 @@ namespace uniset
             /*! (принудительно) обновить все данные (из SM) */
             void updateFromSM();
 
+            /*! обновить все данные пакета (из SM) */
+            void updatePack( PackMessage& pack );
+
+            /*! прочитать значение датчика из SM
+             * \return false - значение получить не удалось (и не задано undefined_value)
+             */
+            bool readValue( UItem& it, long& value );
+
             /*! Обновить значение по ID датчика */
             void updateSensor( uniset::ObjectId id, long value );
 
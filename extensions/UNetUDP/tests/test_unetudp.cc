@@ -1,10 +1,15 @@
 #include <catch.hpp>
 // -----------------------------------------------------------------------------
 #include <memory>
+#include <vector>
+#include <cstring>
 #include "UniSetTypes.h"
 #include "UInterface.h"
 #include "UDPPacket.h"
 #include "UDPCore.h"
+#include "UDPTransport.h"
+#include "SMInterface.h"
+#include "unisetstd.h"
 // -----------------------------------------------------------------------------
 // include-ы искплючительно для того, чтобы их обработал gcov (покрытие кода)
 #include "UNetReceiver.h"
@@ -172,6 +177,106 @@ TEST_CASE("[UNetUDP]: UDPMessage", "[unetudp][udp][udpmessage]")
     }
 }
 // -----------------------------------------------------------------------------
+TEST_CASE("[UNetUDP]: bulk bits", "[unetudp][udp][bulk]")
+{
+    // некратное 8 и 16 количество, чтобы проверить "хвосты"
+    const size_t num = 1003;
+    std::vector<uint8_t> vals(num);
+
+    for( size_t i = 0; i < num; i++ )
+        vals[i] = ((i * 7) % 3 == 0) ? (i % 5 + 1) : 0; // не только 0/1
+
+    SECTION("pack/unpack")
+    {
+        UniSetUDP::UDPMessage u;
+
+        for( size_t i = 0; i < num; i++ )
+            u.addDData(i, false);
+
+        u.setDBits(vals.data(), num);
+
+        for( size_t i = 0; i < num; i++ )
+            REQUIRE( u.dValue(i) == (vals[i] != 0) );
+
+        std::vector<uint8_t> ret(num);
+        u.getDBits(ret.data(), num);
+
+        for( size_t i = 0; i < num; i++ )
+            REQUIRE( ret[i] == (vals[i] ? 1 : 0) );
+
+        // биты за пределами num не изменяются
+        uint8_t bits[2] = { 0xFF, 0xFF };
+        uint8_t zero[3] = { 0, 0, 0 };
+        UniSetUDP::packBits(zero, 3, bits);
+        REQUIRE( bits[0] == 0xF8 );
+        REQUIRE( bits[1] == 0xFF );
+    }
+
+    SECTION("diff")
+    {
+        uint8_t a[UniSetUDP::MaxDDataCount];
+        uint8_t b[UniSetUDP::MaxDDataCount];
+        UniSetUDP::packBits(vals.data(), num, a);
+        std::memcpy(b, a, sizeof(b));
+
+        std::vector<size_t> changed(num);
+        REQUIRE( UniSetUDP::diffBits(a, b, num, changed.data()) == 0 );
+
+        std::vector<size_t> expected = { 0, 63, 64, 500, 1000, 1002 };
+
+        for( const auto& i : expected )
+            b[i >> 3] ^= (1 << (i & 0x7));
+
+        // изменения за пределами num не учитываются
+        b[1003 >> 3] ^= (1 << (1003 & 0x7));
+
+        REQUIRE( UniSetUDP::diffBits(a, b, num, changed.data()) == expected.size() );
+
+        for( size_t k = 0; k < expected.size(); k++ )
+            REQUIRE( changed[k] == expected[k] );
+    }
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("[UNetUDP]: foreign byte order", "[unetudp][udp][ntoh]")
+{
+    UniSetUDP::UDPMessage u;
+    u.header.num = 10;
+
+    for( size_t i = 0; i < 100; i++ )
+    {
+        u.addDData(i + 1, i % 2);
+        u.addAData(i + 1000, -(int64_t)i * 100000000);
+    }
+
+    // имитируем пакет от узла с другим порядком байт
+    UniSetUDP::UDPMessage p(u);
+    p.header._be_order = !u.header._be_order;
+    p.header.num = __builtin_bswap64(p.header.num);
+    p.header.dcount = __builtin_bswap16(p.header.dcount);
+    p.header.acount = __builtin_bswap16(p.header.acount);
+
+    for( size_t i = 0; i < 100; i++ )
+    {
+        p.d_id[i] = __builtin_bswap32(p.d_id[i]);
+        p.a_dat[i].id = __builtin_bswap32(p.a_dat[i].id);
+        p.a_dat[i].val = __builtin_bswap64(p.a_dat[i].val);
+    }
+
+    p.ntoh();
+    REQUIRE( p.header._be_order == u.header._be_order );
+    REQUIRE( p.header.num == 10 );
+    REQUIRE( p.dsize() == 100 );
+    REQUIRE( p.asize() == 100 );
+
+    for( size_t i = 0; i < 100; i++ )
+    {
+        REQUIRE( p.dID(i) == u.dID(i) );
+        REQUIRE( p.dValue(i) == u.dValue(i) );
+        REQUIRE( p.a_dat[i].id == u.a_dat[i].id );
+        REQUIRE( p.a_dat[i].val == u.a_dat[i].val );
+    }
+}
+// -----------------------------------------------------------------------------
 #if 0
 TEST_CASE("[UNetUDP]: respond sensor", "[unetudp][udp]")
 {
@@ -578,6 +683,90 @@ TEST_CASE("[UNetUDP]: switching channels", "[unetudp][udp][chswitch]")
     REQUIRE( ui->getValue(node1_channelSwitchCount_as) == 0 );
 }
 // -----------------------------------------------------------------------------
+// Два приёмника (канала) получают одни и те же данные, в SM пишет только один из них.
+// После переключения каналов кэш ранее заблокированного приёмника устарел
+// и первый же пакет должен обновить все датчики (даже если crc совпадает с запомненным).
+static ObjectId chswitch_as = 19;
+static ObjectId chswitch_s = 20;
+static int ch_numpack = 1;
+
+static void sendToChannels( long aval, bool dval, int port1, int port2 )
+{
+    UniSetUDP::UDPMessage pack;
+    pack.addAData(chswitch_as, aval);
+    pack.addDData(chswitch_s, dval);
+    pack.header.nodeID = s_nodeID;
+    pack.header.procID = s_procID + 1;
+    pack.header.num = ch_numpack++;
+    pack.updatePacketCrc();
+
+    for( auto&& p : { port1, port2 } )
+    {
+        Poco::Net::SocketAddress addr(host, p);
+        CHECK( udp_s->poll(UniSetTimer::millisecToPoco(2000), Poco::Net::Socket::SELECT_WRITE) );
+        REQUIRE( udp_s->sendTo(&pack, sizeof(pack), addr) == sizeof(pack) );
+    }
+
+    msleep(300);
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("[UNetUDP]: switching channels (cache of locked receiver)", "[unetudp][udp][chswitch][lockupdate]")
+{
+    InitTest();
+
+    const int port1 = 3010;
+    const int port2 = 3011;
+    auto smi = make_shared<SMInterface>(5003 /* SharedMemory */, ui, 6000 /* TestProc */);
+    auto r1 = make_shared<UNetReceiver>(unisetstd::make_unique<UDPReceiveTransport>(host, port1), smi);
+    auto r2 = make_shared<UNetReceiver>(unisetstd::make_unique<UDPReceiveTransport>(host, port2), smi);
+
+    // активный канал - r2
+    r1->setLockUpdate(true);
+    r2->setLockUpdate(false);
+    r1->start();
+    r2->start();
+    msleep(200);
+
+    sendToChannels(10, true, port1, port2);
+    REQUIRE( ui->getValue(chswitch_as) == 10 );
+    REQUIRE( ui->getValue(chswitch_s) == 1 );
+
+    // переключаемся на r1
+    r2->setLockUpdate(true);
+    r1->setLockUpdate(false);
+    sendToChannels(20, false, port1, port2);
+    REQUIRE( ui->getValue(chswitch_as) == 20 );
+    REQUIRE( ui->getValue(chswitch_s) == 0 );
+
+    SECTION("the same crc")
+    {
+        // обратно на r2: данные (и crc) совпадают с запомненными в r2 до блокировки
+        r1->setLockUpdate(true);
+        r2->setLockUpdate(false);
+        sendToChannels(10, true, port1, port2);
+        REQUIRE( ui->getValue(chswitch_as) == 10 );
+        REQUIRE( ui->getValue(chswitch_s) == 1 );
+    }
+
+    SECTION("changed items")
+    {
+        // обратно на r2: crc другой, но значения совпадают с запомненными в r2 до блокировки
+        r1->setLockUpdate(true);
+        r2->setLockUpdate(false);
+        sendToChannels(10, false, port1, port2);
+        REQUIRE( ui->getValue(chswitch_as) == 10 );
+        REQUIRE( ui->getValue(chswitch_s) == 0 );
+
+        // дальше обычная работа (с учётом кэша)
+        sendToChannels(11, true, port1, port2);
+        REQUIRE( ui->getValue(chswitch_as) == 11 );
+        REQUIRE( ui->getValue(chswitch_s) == 1 );
+    }
+
+    r1->stop();
+    r2->stop();
+}
+// -----------------------------------------------------------------------------
 TEST_CASE("[UNetUDP]: check undefined value", "[unetudp][udp][sender]")
 {
     InitTest();
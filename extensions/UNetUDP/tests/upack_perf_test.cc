@@ -0,0 +1,155 @@
+// --------------------------------------------------------------------------
+// Замер скорости формирования и разбора UNet-пакета (заполненного целиком):
+// поштучные setDData/dValue против пакетных setDBits/getDBits/diffBits,
+// а также перекодирование пакета с "чужим" порядком байт (ntoh)
+// --------------------------------------------------------------------------
+#include <string>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <algorithm>
+#include "UniSetTypes.h"
+#include "UDPPacket.h"
+// --------------------------------------------------------------------------
+using namespace std;
+using namespace uniset;
+using namespace uniset::UniSetUDP;
+// --------------------------------------------------------------------------
+// защита от "выбрасывания" вычислений оптимизатором
+static volatile size_t result = 0;
+// --------------------------------------------------------------------------
+static void one_test( const std::string& name, size_t count, const std::function<size_t()>& f )
+{
+    auto start = std::chrono::steady_clock::now();
+    size_t r = 0;
+
+    for( size_t i = 0; i < count; i++ )
+        r += f();
+
+    auto end = std::chrono::steady_clock::now();
+    result = r;
+
+    double usec = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    cerr << "    " << setw(24) << std::left << name << ": "
+         << setw(10) << std::right << fixed << setprecision(3) << (usec / count) << " usec/pack" << endl;
+}
+// --------------------------------------------------------------------------
+int main( int argc, const char** argv )
+{
+    size_t count = uniset::getArgPInt("--count", argc, argv, "", 20000);
+
+    // процент изменившихся дискретных между пакетами
+    size_t changes = uniset::getArgPInt("--changes", argc, argv, "", 1);
+
+    std::unique_ptr<UDPMessage> msg(new UDPMessage());
+    std::vector<uint8_t> dvals(MaxDCount);
+    std::vector<int64_t> avals(MaxACount);
+
+    for( size_t i = 0; i < MaxDCount; i++ )
+    {
+        dvals[i] = (i % 3) == 0;
+        msg->addDData(i + 1, dvals[i]);
+    }
+
+    for( size_t i = 0; i < MaxACount; i++ )
+    {
+        avals[i] = i * 100;
+        msg->addAData(i + 1, avals[i]);
+    }
+
+    cerr << "full pack: dcount=" << msg->dsize() << " acount=" << msg->asize()
+         << " count=" << count << endl;
+
+    cerr << "pack:" << endl;
+
+    one_test("setDData (per item)", count, [&]
+    {
+        for( size_t i = 0; i < MaxDCount; i++ )
+            msg->setDData(i, dvals[i]);
+
+        return msg->d_dat[0];
+    });
+
+    one_test("setDBits", count, [&]
+    {
+        msg->setDBits(dvals.data(), MaxDCount);
+        return msg->d_dat[0];
+    });
+
+    one_test("setAData (per item)", count, [&]
+    {
+        for( size_t i = 0; i < MaxACount; i++ )
+            msg->setAData(i, avals[i]);
+
+        return (size_t)msg->a_dat[0].val;
+    });
+
+    one_test("setAValues", count, [&]
+    {
+        msg->setAValues(avals.data(), MaxACount);
+        return (size_t)msg->a_dat[0].val;
+    });
+
+    cerr << "unpack:" << endl;
+
+    one_test("dValue (per item)", count, [&]
+    {
+        for( size_t i = 0; i < MaxDCount; i++ )
+            dvals[i] = msg->dValue(i);
+
+        return (size_t)dvals[1];
+    });
+
+    one_test("getDBits", count, [&]
+    {
+        msg->getDBits(dvals.data(), MaxDCount);
+        return (size_t)dvals[1];
+    });
+
+    // предыдущий пакет, отличающийся на changes% дискретных
+    std::unique_ptr<UDPMessage> prev(new UDPMessage(*msg));
+    const size_t step = changes > 0 ? std::max((size_t)100 / changes, (size_t)1) : MaxDCount;
+
+    for( size_t i = 0; i < MaxDCount; i += step )
+        prev->setDData(i, !prev->dValue(i));
+
+    std::vector<size_t> changed(MaxDCount);
+
+    cerr << "changed discretes (" << changes << "%):" << endl;
+
+    one_test("compare (per item)", count, [&]
+    {
+        size_t n = 0;
+
+        for( size_t i = 0; i < MaxDCount; i++ )
+        {
+            if( prev->dValue(i) != msg->dValue(i) )
+                changed[n++] = i;
+        }
+
+        return n;
+    });
+
+    one_test("diffBits", count, [&]
+    {
+        return diffBits(prev->d_dat, msg->d_dat, MaxDCount, changed.data());
+    });
+
+    cerr << "byte order:" << endl;
+
+    one_test("ntoh (foreign order)", count, [&]
+    {
+        // пакет перекодируется "туда и обратно", поэтому в конце остаётся тем же
+        msg->header._be_order = !msg->header._be_order;
+        msg->header.acount = __builtin_bswap16(msg->header.acount);
+        msg->header.dcount = __builtin_bswap16(msg->header.dcount);
+        msg->ntoh();
+        return (size_t)msg->d_id[0];
+    });
+
+    return 0;
+}
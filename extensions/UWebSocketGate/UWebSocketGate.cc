@@ -223,15 +223,7 @@ void UWebSocketGate::checkMessages( ev::timer& t, int revents )
     if( EV_ERROR & revents )
         return;
 
-    for( int i = 0; i < maxMessagesProcessing; i++ )
-    {
-        auto m = receiveMessage();
-
-        if( !m )
-            break;
-
-        processingMessage(m.get());
-    }
+    processMessages(maxMessagesProcessing);
 }
 //--------------------------------------------------------------------------------------------
 void UWebSocketGate::sensorInfo( const SensorMessage* sm )
@@ -22,6 +22,7 @@
 #include <vector>
 #include <deque>
 #include <ostream>
+#include <cstdint>
 //--------------------------------------------------------------------------
 namespace uniset
 {
@@ -75,6 +76,17 @@ namespace uniset
     пересортировывать весь кэш (чтобы наиболее часто используемые были в начале). Чтобы не делать эту операцию каждый
     раз, сделан счётчик циклов. Т.е. через какое количество обращений к кэшу, производить принудительную пересортировку.
     Значение по умолчанию - 5(размер кэша). Задать можно при помощи Calibration::setCacheResortCycle()
+
+      Если сырое значение постоянно "гуляет" по всему диапазону (вибрация, расход и т.п.), то кэш почти
+    не помогает (промахи + пересортировка). Для таких случаев можно заранее построить таблицу
+    (Calibration::buildLookupTable()) и тогда поиск значения выполняется за O(1), без обращения к кэшу:
+    - если диапазон [leftRaw, rightRaw] не больше заданного размера таблицы, то таблица содержит
+      готовые значения для каждого raw (одно обращение к массиву);
+    - иначе диапазон делится на интервалы (по 2^N значений) и для каждого интервала в таблице хранится
+      номер участка диаграммы, с которого начинается интервал. Значение вычисляется по найденному участку
+      (обычно это сам участок или соседний). Только для точек на границах участков используется обычный поиск.
+    Результат совпадает с результатом поиска по диаграмме.
+    \note Второй вариант возможен только если участки диаграммы не перекрываются (точки заданы по возрастанию 'x').
     */
     class Calibration
     {
@@ -181,6 +193,19 @@ namespace uniset
             {
                 return numCacheResort;
             }
+
+            /*! построить таблицу для поиска значений за O(1) (см. описание класса)
+                \param maxsize - максимальный размер таблицы (количество элементов)
+                \return true - если таблица построена
+            */
+            bool buildLookupTable( size_t maxsize = 65536 );
+            void clearLookupTable();
+
+            //! используется таблица (см. buildLookupTable())
+            inline bool isLookupTable() const noexcept
+            {
+                return !ltable.empty() || !lseg.empty();
+            }
             // ---------------------------------------------------------------
 
             friend std::ostream& operator<<(std::ostream& os, Calibration& c );
@@ -282,6 +307,9 @@ namespace uniset
 
             void insertToCache( const long raw, const long val );
 
+            //! поиск значения по диаграмме (без кэша)
+            long findValue( const long raw ) const noexcept;
+
         private:
             PartsVec pvec;
             std::string myname;
@@ -316,6 +344,11 @@ namespace uniset
             ValueCache cache;
             size_t numCacheResort; // количество обращений, при которых происходит перестроение (сортировка) кэша..
             size_t numCallToCache; // текущий счётчик обращений к кэшу
+
+            // таблица для поиска за O(1) (см. buildLookupTable())
+            std::vector<long> ltable;   /*!< значения для каждого raw из [leftRaw, rightRaw] */
+            std::vector<uint32_t> lseg; /*!< номер участка для каждого интервала raw (по 2^lshift значений) */
+            unsigned int lshift = { 0 };
     };
     // --------------------------------------------------------------------------
 } // end of namespace uniset
@@ -19,8 +19,8 @@
 #ifndef DigitalFilter_H_
 #define DigitalFilter_H_
 //--------------------------------------------------------------------------
-#include <deque>
 #include <vector>
+#include <cstdint>
 #include <ostream>
 #include "PassiveTimer.h"
 //--------------------------------------------------------------------------
@@ -71,7 +71,7 @@ namespace uniset
 
             // void init( list<int>& data );
 
-            inline int size()
+            inline int size() const
             {
                 return buf.size();
             }
@@ -89,6 +89,7 @@ namespace uniset
             friend std::ostream& operator<<(std::ostream& os, const DigitalFilter* d);
 
         private:
+            friend class IOBlock; // пакетная обработка (берёт параметры и состояние фильтра)
 
             // Первая ступень фильтра
             double firstLevel();
@@ -101,13 +102,34 @@ namespace uniset
             double S;        // Среднеквадратичное отклонение
             PassiveTimer tmr;
 
-            typedef std::deque<int> FIFOBuffer;
+            // Кольцевой буфер фиксированного размера (FIFO)
+            // самое старое значение находится в buf[head]
+            typedef std::vector<int> FIFOBuffer;
             FIFOBuffer buf;
+            size_t head;
+            int64_t sum;    // сумма значений в буфере
             unsigned int maxsize;
 
+            // поместить значение в буфер, вернуть вытесненное (самое старое)
+            int push( int newval );
+
+            // перебор значений буфера от старых к новым
+            template<typename Func>
+            inline void forEach( Func f ) const
+            {
+                for( size_t i = head; i < buf.size(); i++ )
+                    f(buf[i]);
+
+                for( size_t i = 0; i < head; i++ )
+                    f(buf[i]);
+            }
+
+            // Отсортированная копия буфера (для медианного фильтра).
+            // Обновляется при каждом вызове median() за O(log n) сравнений (без выделения памяти)
             typedef std::vector<int> MedianVector;
             MedianVector mvec;
-            bool mvec_sorted; // флаг, что mvec отсортирован (заполнен)
+            bool mvec_sorted; // флаг, что mvec соответствует текущему содержимому буфера
+            void sortMedian();
 
             typedef std::vector<double> Coeff;
             Coeff w;        // Вектор коэффициентов для filterIIR
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2025 Pavel Vainerman.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, version 2.1.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+// -----------------------------------------------------------------------------
+#ifndef IOBlock_H_
+#define IOBlock_H_
+// -----------------------------------------------------------------------------
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "IOBase.h"
+// -------------------------------------------------------------------------
+namespace uniset
+{
+    // -----------------------------------------------------------------------------
+    /*! \class IOBlock
+     * Пакетная обработка аналоговых входов (альтернатива вызову IOBase::processingAsAI() для каждого входа).
+     *
+     * Входы группируются по "профилю" обработки (без фильтра, рекурсивный фильтр с буфером заданного размера).
+     * Параметры и состояние входов одного профиля хранятся "по столбцам" (structure of arrays),
+     * поэтому проверка обрыва, калибровка и учёт precision выполняются простыми циклами по массивам
+     * (которые компилятор может векторизовать), а буферы рекурсивных фильтров лежат в одном кольцевом массиве.
+     *
+     * Результат обработки совпадает с IOBase::processingAsAI() (см. tests/test_ioblock.cc).
+     * Входы, которые не подходят для пакетной обработки (DI/DO, калибровочная диаграмма,
+     * зависимость от другого датчика, rawdata, медианный, адаптивный или RC-фильтр),
+     * обрабатываются обычным IOBase::processingAsAI().
+     *
+     * \warning После добавления входа в блок состояние его фильтра хранится в блоке (IOBase::df не обновляется).
+     * Если вход временно обрабатывается через IOBase::processingAsAI() (например в тестовом режиме),
+     * то перед этим состояние надо вернуть в IOBase::df (saveFilters()), а после - снова взять из него (loadFilters()).
+     *
+     * Пороговые датчики (IOBase::t_ai) добавляются отдельно (addThreshold) и обрабатываются processThresholds().
+     *
+     * Пример использования:
+     * \code
+     *  for( auto&& it : iolist )
+     *      it.blkIndex = blk.add(&it);
+     *  ...
+     *  // на каждом шаге опроса
+     *  for( auto&& it : iolist )
+     *      blk.setRaw(it.blkIndex, readRaw(it));
+     *
+     *  blk.process(shm, force);
+     * \endcode
+     */
+    class IOBlock
+    {
+        public:
+            IOBlock();
+            ~IOBlock();
+
+            /*! добавить вход
+             * \return индекс, по которому задаётся "сырое" значение входа (см. setRaw())
+             */
+            size_t add( IOBase* it );
+
+            /*! добавить пороговый датчик (it->t_ai != DefaultObjectId) */
+            void addThreshold( IOBase* it );
+
+            /*! может ли вход обрабатываться пакетно */
+            static bool isBlockable( const IOBase* it ) noexcept;
+
+            /*! задать "сырое" значение входа (будет обработано при следующем вызове process()) */
+            void setRaw( size_t idx, long raw ) noexcept;
+
+            /*! обработать все входы (аналог IOBase::processingAsAI() для каждого) */
+            void process( const std::shared_ptr<SMInterface>& shm, bool force );
+
+            /*! обработать пороговые датчики (аналог IOBase::processingThreshold() для каждого) */
+            void processThresholds( const std::shared_ptr<SMInterface>& shm, bool force );
+
+            /*! вернуть состояние фильтров в IOBase::df (перед обработкой входов через IOBase::processingAsAI()) */
+            void saveFilters() noexcept;
+
+            /*! взять состояние фильтров из IOBase::df (после обработки входов через IOBase::processingAsAI()) */
+            void loadFilters() noexcept;
+
+            void clear();
+
+            //! количество входов (всего)
+            size_t size() const noexcept;
+
+            //! количество входов, обрабатываемых пакетно
+            size_t blockSize() const noexcept;
+
+            //! количество входов, обрабатываемых через IOBase::processingAsAI()
+            size_t fallbackSize() const noexcept;
+
+            //! количество блоков (профилей обработки)
+            inline size_t blocks() const noexcept
+            {
+                return blist.size();
+            }
+
+            inline size_t thresholds() const noexcept
+            {
+                return tlist.items.size();
+            }
+
+        protected:
+
+            //! входы с одинаковым профилем обработки
+            struct Block
+            {
+                size_t fsize = { 0 }; /*!< размер буфера рекурсивного фильтра (0 - без фильтра) */
+
+                std::vector<IOBase*> items;
+                std::vector<long> raw;      /*!< "сырые" значения */
+                std::vector<long> val;      /*!< обработанные значения */
+                std::vector<uint8_t> brk;   /*!< признак обрыва */
+
+                std::vector<long> breaklim;
+                std::vector<uint8_t> toint; /*!< приводить к int (как это делает DigitalFilter) */
+
+                // калибровка (см. uniset::lcalibrate)
+                std::vector<uint8_t> cal;   /*!< задана калибровка */
+                std::vector<long> rmin;
+                std::vector<float> kcal;    /*!< (float)(maxCal - minCal) */
+                std::vector<float> kraw;    /*!< (float)(maxRaw - minRaw) */
+                std::vector<float> cmin;    /*!< (float)minCal */
+                std::vector<long> lo;       /*!< нижняя граница (с учётом calcrop) */
+                std::vector<long> hi;       /*!< верхняя граница (с учётом calcrop) */
+                std::vector<uint8_t> prec;  /*!< учитывать precision */
+                std::vector<double> pmul;   /*!< pow(10.0, precision) */
+
+                // рекурсивный фильтр (см. DigitalFilter::filterIIR)
+                std::vector<int> ring;      /*!< буферы фильтров (по fsize на вход) */
+                std::vector<uint32_t> head; /*!< позиция самого старого значения в буфере */
+                std::vector<int64_t> sum;   /*!< сумма значений в буфере */
+                std::vector<int> prev;
+                std::vector<int> thr;
+                std::vector<double> cprev;
+                std::vector<double> cnew;
+
+                void add( IOBase* it );
+                void filter() noexcept;
+                void calibrate() noexcept;
+
+                // перенос состояния рекурсивного фильтра i-го входа из/в IOBase::df
+                void loadFilter( size_t i ) noexcept;
+                void saveFilter( size_t i ) noexcept;
+            };
+
+            //! пороговые датчики
+            struct Thresholds
+            {
+                std::vector<IOBase*> items;
+                std::vector<long> val;
+                std::vector<long> lowlimit;
+                std::vector<long> hilimit;
+                std::vector<uint8_t> invert;
+                std::vector<uint8_t> state;
+            };
+
+            struct Slot
+            {
+                size_t block; /*!< номер блока или fallback (см. ниже) */
+                size_t pos;   /*!< позиция в блоке */
+            };
+
+            static const size_t fallback = { (size_t) - 1 };
+
+            std::vector<Block> blist;
+            std::vector<Slot> slots;
+
+            // входы, обрабатываемые через IOBase::processingAsAI()
+            std::vector<IOBase*> fitems;
+            std::vector<long> fraw;
+
+            Thresholds tlist;
+    };
+    // --------------------------------------------------------------------------
+} // end of namespace uniset
+// -----------------------------------------------------------------------------
+#endif // IOBlock_H_
+// -----------------------------------------------------------------------------
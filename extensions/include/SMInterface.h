@@ -44,6 +44,11 @@ namespace uniset
             void askSensor( uniset::ObjectId id, UniversalIO::UIOCommand cmd,
                             uniset::ObjectId backid = uniset::DefaultObjectId );
 
+            //! заказ с фильтрацией уведомлений (см. IONotifyController::askSensorWithFilter)
+            void askSensor( uniset::ObjectId id, UniversalIO::UIOCommand cmd,
+                            const IONotifyController_i::NotifyFilter& filter,
+                            uniset::ObjectId backid = uniset::DefaultObjectId );
+
             void freezeValue( uniset::ObjectId id, bool set, long value, uniset::ObjectId supplier );
 
             IOController_i::SensorInfoSeq* getSensorsMap();
@@ -250,8 +250,8 @@ namespace uniset
     }
     // ----------------------------------------------------------------------------
     // рекурсивная функция поиска методом "половинного деления"
-    static Calibration::PartsVec::iterator find_range( const long raw, Calibration::PartsVec::iterator beg,
-            Calibration::PartsVec::iterator end )
+    static Calibration::PartsVec::const_iterator find_range( const long raw, Calibration::PartsVec::const_iterator beg,
+            Calibration::PartsVec::const_iterator end )
     {
         if( beg->checkX(raw) )
             return beg;
@@ -261,6 +261,11 @@ namespace uniset
 
         auto it = beg + std::distance(beg, end) / 2;
 
+        // между beg и end участков нет (raw не попадает ни в один участок,
+        // например если крайние точки диаграммы не целые). getY() вернёт ValueOutOfRange
+        if( it == beg )
+            return end;
+
         if( raw < it->left_x() )
             return find_range(raw, beg, it);
 
@@ -280,6 +285,31 @@ namespace uniset
         if( raw > rightRaw )
             return (crop_raw ? rightVal : outOfRange);
 
+        if( !ltable.empty() )
+            return ltable[raw - leftRaw];
+
+        if( !lseg.empty() )
+        {
+            // см. buildLookupTable()
+            const TypeOfValue x = raw;
+            const size_t last = pvec.size() - 1;
+            size_t i = lseg[ (size_t)(raw - leftRaw) >> lshift ];
+
+            while( i < last && (x > pvec[i].right_x() || pvec[i].left_x() == pvec[i].right_x()) )
+                i++;
+
+            const Part& p = pvec[i];
+
+            if( x > p.left_x() && x < p.right_x() )
+            {
+                const TypeOfValue q = p.calcY(x);
+                return ( q != ValueOutOfRange ) ? tRound(q) : outOfRange;
+            }
+
+            // точка на границе участков
+            return findValue(raw);
+        }
+
         if( szCache ) // > 0
         {
             for( auto& c : cache )
@@ -300,30 +330,107 @@ namespace uniset
             }
         }
 
+        const long val = findValue(raw);
+
+        if( szCache )
+            insertToCache(raw, val);
+
+        return val;
+    }
+    // ----------------------------------------------------------------------------
+    long Calibration::findValue( const long raw ) const noexcept
+    {
         auto fit = find_range(raw, pvec.begin(), --pvec.end() );
 
         if( fit == pvec.end() )
-        {
-            if( szCache )
-                insertToCache(raw, outOfRange);
-
             return outOfRange;
-        }
 
         TypeOfValue q = fit->getY(raw);
 
         if( q != ValueOutOfRange )
+            return tRound(q);
+
+        return outOfRange;
+    }
+    // ----------------------------------------------------------------------------
+    bool Calibration::buildLookupTable( size_t maxsize )
+    {
+        clearLookupTable();
+
+        if( pvec.empty() || maxsize == 0 || rightRaw < leftRaw )
+            return false;
+
+        const size_t range = (size_t)(rightRaw - leftRaw) + 1;
+
+        if( range <= maxsize )
         {
-            if( szCache )
-                insertToCache(raw, tRound(q) );
+            // значения вычисляются обычным поиском, поэтому результат с таблицей и без неё совпадает
+            std::vector<long> t;
+            t.reserve(range);
 
-            return tRound(q);
+            for( long raw = leftRaw; raw <= rightRaw; raw++ )
+                t.push_back( findValue(raw) );
+
+            ltable.swap(t);
+            return true;
         }
 
-        if( szCache )
-            insertToCache(raw, outOfRange);
+        if( pvec.size() >= UINT32_MAX )
+            return false;
 
-        return outOfRange;
+        // участки не должны перекрываться
+        // (иначе участок для raw определяется неоднозначно).
+        // Вертикальные участки (точки с одинаковым 'x') не учитываем, они попадают только на границы.
+        const Part* prev = nullptr;
+
+        for( const auto& p : pvec )
+        {
+            if( p.left_x() == p.right_x() )
+                continue;
+
+            if( prev && p.left_x() < prev->right_x() )
+            {
+                dwarn << myname << "(Calibration::buildLookupTable): участки диаграммы перекрываются"
+                      << " ([" << prev->left_x() << " : " << prev->right_x() << "]"
+                      << " и [" << p.left_x() << " : " << p.right_x() << "])."
+                      << " Таблица не построена." << endl;
+                return false;
+            }
+
+            prev = &p;
+        }
+
+        lshift = 0;
+
+        while( ((range - 1) >> lshift) >= maxsize )
+            lshift++;
+
+        std::vector<uint32_t> t( ((range - 1) >> lshift) + 1 );
+
+        for( size_t k = 0; k < t.size(); k++ )
+        {
+            // первый участок, который может содержать значения интервала
+            const TypeOfValue x = leftRaw + (long)(k << lshift);
+
+            auto it = std::lower_bound(pvec.begin(), pvec.end(), x, []( const Part & p, const TypeOfValue & v )
+            {
+                return p.right_x() < v;
+            });
+
+            t[k] = std::min( (size_t)(it - pvec.begin()), pvec.size() - 1 );
+        }
+
+        lseg.swap(t);
+        return true;
+    }
+    // ----------------------------------------------------------------------------
+    void Calibration::clearLookupTable()
+    {
+        ltable.clear();
+        ltable.shrink_to_fit();
+        lseg.clear();
+        lseg.shrink_to_fit();
+        lshift = 0;
     }
     // ----------------------------------------------------------------------------
     void Calibration::setCacheResortCycle( size_t n )
@@ -34,6 +34,8 @@ namespace uniset
         M(0),
         S(0),
         tmr(UniSetTimer::WaitUpTime),
+        head(0),
+        sum(0),
         maxsize(bufsize),
         mvec_sorted(false),
         w(bufsize),
@@ -45,7 +47,7 @@ namespace uniset
         coeff_new(iir_coeff_new)
     {
         buf.resize(maxsize);
-        mvec.reserve(maxsize);
+        mvec.resize(maxsize);
         init(val);
     }
     //--------------------------------------------------------------------------
@@ -69,30 +71,44 @@ namespace uniset
         if( iir_thr > 0 )
             thr = iir_thr;
 
-        if( buf.size() > maxsize )
+        // приводим буфер к линейному виду (от старых к новым)
+        FIFOBuffer lbuf;
+        lbuf.reserve(buf.size());
+        forEach([&lbuf]( int v )
         {
-            // удаляем лишние (первые) элементы
-            int sub = buf.size() - maxsize;
+            lbuf.push_back(v);
+        });
 
-            for( int i = 0; i < sub; i++ )
-                buf.pop_front();
+        if( lbuf.size() > maxsize )
+        {
+            // удаляем лишние (первые) элементы
+            lbuf.erase(lbuf.begin(), lbuf.begin() + (lbuf.size() - maxsize));
         }
 
-        buf.resize(maxsize);
+        lbuf.resize(maxsize);
+        buf.swap(lbuf);
+        head = 0;
+        sum = 0;
+
+        for( const auto& v : buf )
+            sum += v;
 
         if( w.size() != maxsize || lsq != lsparam )
             w.assign(maxsize, 1.0 / maxsize);
 
         lsparam = lsq;
         mvec.resize(maxsize);
+        sortMedian();
     }
     //--------------------------------------------------------------------------
     void DigitalFilter::init( int val )
     {
-        buf.clear();
+        buf.assign(maxsize, val);
+        head = 0;
+        sum = (int64_t)val * maxsize;
 
-        for( size_t i = 0; i < maxsize; i++ )
-            buf.push_back(val);
+        mvec.assign(maxsize, val);
+        mvec_sorted = true;
 
         w.assign(maxsize, 1.0 / maxsize);
 
@@ -103,22 +119,19 @@ namespace uniset
     double DigitalFilter::firstLevel()
     {
         // считаем среднее арифметическое
-        M = 0;
-
-        for( const auto& i : buf )
-            M = M + i;
-
+        // (сумма целых хранится точно, поэтому результат совпадает с поэлементным суммированием)
+        M = (double)sum;
         M = M / buf.size();
 
         // считаем среднеквадратичное отклонение
         S = 0;
         double r = 0;
 
-        for( const auto& i : buf )
+        forEach([this, &r]( int i )
         {
             r = M - i;
             S = S + r * r;
-        }
+        });
 
         S = S / buf.size();
         S = sqrt(S);
@@ -130,14 +143,14 @@ namespace uniset
         int n = 0;
         double val = 0; // Конечное среднее значение
 
-        for( const auto& i : buf )
+        forEach([this, &n, &val]( int i )
         {
             if( fabs(M - i) < S * 2 ) // откидываем
             {
                 val += i;
                 n++;
             }
-        }
+        });
 
         if( n == 0 )
             return M;
@@ -183,16 +196,29 @@ namespace uniset
     }
     //--------------------------------------------------------------------------
     void DigitalFilter::add( int newval )
+    {
+        push(newval);
+        mvec_sorted = false;
+    }
+    //--------------------------------------------------------------------------
+    int DigitalFilter::push( int newval )
     {
         // помещаем очередное значение в буфер
         // удаляя при этом старое (FIFO)
 
         // т.к. мы изначально создаём буфер нужного размера и заполням (см. init)
         // то каждый раз проверять размер не нужно
-        //    if( buf.size() > maxsize )
-        //        buf.pop_front();
-        buf.pop_front();
-        buf.push_back(newval);
+        if( buf.empty() )
+            return newval;
+
+        const int old = buf[head];
+        buf[head] = newval;
+        sum += (int64_t)newval - old;
+
+        if( ++head >= buf.size() )
+            head = 0;
+
+        return old;
     }
     //--------------------------------------------------------------------------
     int DigitalFilter::current1()
@@ -209,8 +235,10 @@ namespace uniset
     {
         os << "(" << d.buf.size() << ")[";
 
-        for( const auto& i : d.buf )
+        d.forEach([&os]( int i )
+        {
             os << " " << setw(5) << i;
+        });
 
         os << " ]";
         return os;
@@ -226,23 +254,54 @@ namespace uniset
         if( maxsize < 1 )
             return newval;
 
-        add(newval);
+        const int old = push(newval);
 
-        mvec.assign(buf.begin(), buf.end());
-        sort(mvec.begin(), mvec.end());
-        mvec_sorted = true;
+        if( !mvec_sorted )
+        {
+            sortMedian();
+            return mvec[maxsize / 2];
+        }
+
+        // заменяем в отсортированном окне вытесненное значение на новое:
+        // двоичный поиск и один сдвиг части окна (без выделения памяти)
+        auto pos = std::lower_bound(mvec.begin(), mvec.end(), old);
+
+        if( newval >= old )
+        {
+            auto ins = std::upper_bound(pos + 1, mvec.end(), newval);
+            std::move(pos + 1, ins, pos);
+            *(ins - 1) = newval;
+        }
+        else
+        {
+            auto ins = std::upper_bound(mvec.begin(), pos, newval);
+            std::move_backward(ins, pos, pos + 1);
+            *ins = newval;
+        }
 
         return mvec[maxsize / 2];
     }
     //--------------------------------------------------------------------------
+    void DigitalFilter::sortMedian()
+    {
+        if( mvec.size() != buf.size() )
+            mvec.resize(buf.size());
+
+        size_t k = 0;
+        forEach([this, &k]( int v )
+        {
+            mvec[k++] = v;
+        });
+
+        sort(mvec.begin(), mvec.end());
+        mvec_sorted = true;
+    }
+    //--------------------------------------------------------------------------
     int DigitalFilter::currentMedian()
     {
+        // если данные добавлялись через add(), то окно надо пересчитать
         if( !mvec_sorted )
-        {
-            mvec.assign(buf.begin(), buf.end());
-            sort(mvec.begin(), mvec.end());
-            // mvec_sorted = true; // специально не выставляю, чтобы если данные добавляются через add(), то тут надо каждый раз пересчитыать..
-        }
+            sortMedian();
 
         return mvec[maxsize / 2];
     }
@@ -254,20 +313,23 @@ namespace uniset
         add(newval);
 
         // Цифровая фильтрация
-        auto it = buf.begin();
-
-        for( unsigned int i = 0; i < maxsize; i++, it++ )
-            ls += *it * w[i];
+        size_t i = 0;
+        forEach([this, &i]( int v )
+        {
+            ls += v * w[i++];
+        });
 
         // Вычисляем ошибку выхода
         double er = newval - ls;
 
         // Обновляем коэффициенты
         double u = 2 * (lsparam / maxsize) * er;
-        it = buf.begin();
-
-        for( unsigned int i = 0; i < maxsize; i++, it++ )
-            w[i] = w[i] + *it * u;
+        i = 0;
+        forEach([this, &i, u]( int v )
+        {
+            w[i] = w[i] + v * u;
+            i++;
+        });
 
         return lroundf(ls);
     }
@@ -288,13 +350,10 @@ namespace uniset
         }
         else
         {
-            double aver = 0;
-
             add(newval);
 
-            for( const auto& i : buf )
-                aver += i;
-
+            // см. firstLevel()
+            double aver = (double)sum;
             aver /= maxsize;
             prev = lroundf((coeff_prev * prev + coeff_new * aver) / (coeff_prev + coeff_new));
         }
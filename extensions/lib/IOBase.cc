@@ -896,6 +896,15 @@ namespace uniset
 
                 if( !initProp(it, "cal_cacheresort", prefix, init_prefix_only).empty() )
                     b->cdiagram->setCacheResortCycle(initIntProp(it, "cal_cacheresort", prefix, init_prefix_only));
+
+                const int cal_lookup = initIntProp(it, "cal_lookup", prefix, init_prefix_only);
+
+                if( cal_lookup > 0 && !b->cdiagram->buildLookupTable(cal_lookup) )
+                {
+                    if( dlog && dlog->is_warn() )
+                        dlog->warn() << myname << "(IOBase::readItem): sensor='" << it.getProp("name")
+                                     << "' failed to build lookup table for caldiagram='" << caldiagram << "'" << endl;
+                }
             }
         }
         else if( b->stype == UniversalIO::DI || b->stype == UniversalIO::DO ) // -V560
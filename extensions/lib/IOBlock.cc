@@ -0,0 +1,372 @@
+/*
+ * Copyright (c) 2025 Pavel Vainerman.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, version 2.1.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+// -------------------------------------------------------------------------
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "UniSetTypes.h"
+#include "IOBlock.h"
+// -----------------------------------------------------------------------------
+using namespace std;
+// -----------------------------------------------------------------------------
+namespace uniset
+{
+    // -----------------------------------------------------------------------------
+    IOBlock::IOBlock()
+    {
+    }
+    // -----------------------------------------------------------------------------
+    IOBlock::~IOBlock()
+    {
+    }
+    // -----------------------------------------------------------------------------
+    bool IOBlock::isBlockable( const IOBase* it ) noexcept
+    {
+        if( it->stype == UniversalIO::DI || it->stype == UniversalIO::DO )
+            return false;
+
+        if( it->cdiagram || it->rawdata || it->d_id != DefaultObjectId )
+            return false;
+
+        // порядок проверок такой же как в IOBase::processingAsAI()
+        if( it->nofilter || it->df.size() <= 1 )
+            return true;
+
+        if( it->f_median )
+            return false;
+
+        if( it->f_filter_iir )
+            return true;
+
+        if( it->f_ls )
+            return false;
+
+        // RC-фильтр с T <= 0 фактически отключён
+        return ( it->df.Ti <= 0 );
+    }
+    // -----------------------------------------------------------------------------
+    size_t IOBlock::add( IOBase* it )
+    {
+        if( !isBlockable(it) )
+        {
+            slots.push_back({ fallback, fitems.size() });
+            fitems.push_back(it);
+            fraw.push_back(0);
+            return slots.size() - 1;
+        }
+
+        const bool usefilter = ( !it->nofilter && it->df.size() > 1 );
+        const size_t fsize = ( usefilter && it->f_filter_iir ) ? it->df.size() : 0;
+
+        auto b = std::find_if(blist.begin(), blist.end(), [fsize]( const Block & b )
+        {
+            return b.fsize == fsize;
+        });
+
+        if( b == blist.end() )
+        {
+            blist.emplace_back();
+            b = blist.end() - 1;
+            b->fsize = fsize;
+        }
+
+        const size_t pos = b->items.size();
+        b->add(it);
+
+        // фильтр (отключённый) RC возвращает int
+        b->toint.push_back( usefilter && fsize == 0 );
+
+        if( fsize > 0 )
+        {
+            const DigitalFilter& df = it->df;
+            b->ring.resize(b->ring.size() + fsize);
+            b->head.push_back(0);
+            b->sum.push_back(0);
+            b->prev.push_back(0);
+            b->thr.push_back(df.thr);
+            b->cprev.push_back(df.coeff_prev);
+            b->cnew.push_back(df.coeff_new);
+
+            // переносим текущее состояние фильтра
+            b->loadFilter(pos);
+        }
+
+        slots.push_back({ (size_t)(b - blist.begin()), pos });
+        return slots.size() - 1;
+    }
+    // -----------------------------------------------------------------------------
+    void IOBlock::Block::add( IOBase* it )
+    {
+        items.push_back(it);
+        raw.push_back(0);
+        val.push_back(0);
+        brk.push_back(0);
+        breaklim.push_back(it->breaklim);
+
+        const IOController_i::CalibrateInfo& c = it->cal;
+        const bool usecal = ( c.maxRaw != c.minRaw );
+        cal.push_back(usecal);
+        rmin.push_back(c.minRaw);
+        kcal.push_back( (float)(c.maxCal - c.minCal) );
+        kraw.push_back( usecal ? (float)(c.maxRaw - c.minRaw) : 1.0f );
+        cmin.push_back( (float)c.minCal );
+
+        // см. uniset::setinregion()
+        if( usecal && it->calcrop )
+        {
+            lo.push_back( std::min(c.minCal, c.maxCal) );
+            hi.push_back( std::max(c.minCal, c.maxCal) );
+        }
+        else
+        {
+            lo.push_back( std::numeric_limits<long>::min() );
+            hi.push_back( std::numeric_limits<long>::max() );
+        }
+
+        const bool useprec = ( !it->noprecision && c.precision != 0 );
+        prec.push_back(useprec);
+        pmul.push_back( useprec ? pow(10.0, c.precision) : 1.0 );
+    }
+    // -----------------------------------------------------------------------------
+    void IOBlock::addThreshold( IOBase* it )
+    {
+        if( it->t_ai == DefaultObjectId )
+            return;
+
+        tlist.items.push_back(it);
+        tlist.val.push_back(0);
+        tlist.lowlimit.push_back(it->ti.lowlimit);
+        tlist.hilimit.push_back(it->ti.hilimit);
+        tlist.invert.push_back(it->ti.invert);
+        tlist.state.push_back(0);
+    }
+    // -----------------------------------------------------------------------------
+    void IOBlock::setRaw( size_t idx, long raw ) noexcept
+    {
+        const Slot& s = slots[idx];
+
+        if( s.block == fallback )
+            fraw[s.pos] = raw;
+        else
+            blist[s.block].raw[s.pos] = raw;
+    }
+    // -----------------------------------------------------------------------------
+    void IOBlock::Block::loadFilter( size_t i ) noexcept
+    {
+        const DigitalFilter& df = items[i]->df;
+        int* buf = ring.data() + i * fsize;
+
+        df.forEach([&buf]( int v )
+        {
+            *buf++ = v;
+        });
+
+        head[i] = 0;
+        sum[i] = df.sum;
+        prev[i] = df.prev;
+    }
+    // -----------------------------------------------------------------------------
+    void IOBlock::Block::saveFilter( size_t i ) noexcept
+    {
+        DigitalFilter& df = items[i]->df;
+        const int* buf = ring.data() + i * fsize;
+
+        // в DigitalFilter самое старое значение кладём в начало буфера
+        for( size_t k = 0; k < fsize; k++ )
+            df.buf[k] = buf[(head[i] + k) % fsize];
+
+        df.head = 0;
+        df.sum = sum[i];
+        df.prev = prev[i];
+        df.mvec_sorted = false;
+    }
+    // -----------------------------------------------------------------------------
+    void IOBlock::saveFilters() noexcept
+    {
+        for( auto&& b : blist )
+        {
+            if( b.fsize == 0 )
+                continue;
+
+            for( size_t i = 0; i < b.items.size(); i++ )
+                b.saveFilter(i);
+        }
+    }
+    // -----------------------------------------------------------------------------
+    void IOBlock::loadFilters() noexcept
+    {
+        for( auto&& b : blist )
+        {
+            if( b.fsize == 0 )
+                continue;
+
+            for( size_t i = 0; i < b.items.size(); i++ )
+                b.loadFilter(i);
+        }
+    }
+    // -----------------------------------------------------------------------------
+    void IOBlock::Block::filter() noexcept
+    {
+        const size_t n = items.size();
+
+        if( fsize == 0 )
+        {
+            for( size_t i = 0; i < n; i++ )
+                val[i] = toint[i] ? (long)(int)raw[i] : raw[i];
+
+            return;
+        }
+
+        // см. DigitalFilter::filterIIR()
+        for( size_t i = 0; i < n; i++ )
+        {
+            // при обрыве фильтр не "крутится"
+            if( brk[i] )
+                continue;
+
+            const int newval = (int)raw[i];
+            int* buf = ring.data() + i * fsize;
+
+            if( newval > prev[i] + thr[i] || newval < prev[i] - thr[i] )
+            {
+                std::fill(buf, buf + fsize, newval);
+                head[i] = 0;
+                sum[i] = (int64_t)newval * fsize;
+                prev[i] = newval;
+            }
+            else
+            {
+                sum[i] += (int64_t)newval - buf[head[i]];
+                buf[head[i]] = newval;
+
+                if( ++head[i] >= fsize )
+                    head[i] = 0;
+
+                // сумма целых чисел (в пределах 2^53) в double точна, поэтому результат совпадает с поэлементным суммированием
+                double aver = (double)sum[i];
+                aver /= (unsigned int)fsize;
+                prev[i] = lroundf((cprev[i] * prev[i] + cnew[i] * aver) / (cprev[i] + cnew[i]));
+            }
+
+            val[i] = prev[i];
+        }
+    }
+    // -----------------------------------------------------------------------------
+    void IOBlock::Block::calibrate() noexcept
+    {
+        const size_t n = items.size();
+
+        // см. uniset::lcalibrate()
+        for( size_t i = 0; i < n; i++ )
+        {
+            const long c = lroundf( (float)(val[i] - rmin[i]) * kcal[i] / kraw[i] + cmin[i] );
+            const long v = cal[i] ? std::min(std::max(c, lo[i]), hi[i]) : val[i];
+            val[i] = prec[i] ? lround( v * pmul[i] ) : v;
+        }
+    }
+    // -----------------------------------------------------------------------------
+    void IOBlock::process( const std::shared_ptr<SMInterface>& shm, bool force )
+    {
+        for( auto&& b : blist )
+        {
+            const size_t n = b.items.size();
+
+            for( size_t i = 0; i < n; i++ )
+                b.brk[i] = ( b.breaklim[i] > 0 && b.raw[i] < b.breaklim[i] );
+
+            b.filter();
+            b.calibrate();
+
+            // запись (по одному, т.к. у каждого датчика своя блокировка)
+            for( size_t i = 0; i < n; i++ )
+            {
+                IOBase* it = b.items[i];
+                uniset_rwmutex_wrlock lock(it->val_lock);
+
+                if( b.brk[i] )
+                {
+                    it->value = ChannelBreakValue;
+                    shm->localSetUndefinedState(it->ioit, true, it->si.id);
+                    continue;
+                }
+
+                // если предыдущее значение "обрыв",
+                // то сбрасываем признак
+                if( it->value == ChannelBreakValue )
+                    shm->localSetUndefinedState(it->ioit, false, it->si.id);
+
+                if( force || it->value != b.val[i] )
+                {
+                    shm->localSetValue( it->ioit, it->si.id, b.val[i], shm->ID() );
+                    it->value = b.val[i];
+                }
+            }
+        }
+
+        for( size_t i = 0; i < fitems.size(); i++ )
+            IOBase::processingAsAI(fitems[i], fraw[i], shm, force);
+    }
+    // -----------------------------------------------------------------------------
+    void IOBlock::processThresholds( const std::shared_ptr<SMInterface>& shm, bool force )
+    {
+        const size_t n = tlist.items.size();
+
+        for( size_t i = 0; i < n; i++ )
+        {
+            IOBase* it = tlist.items[i];
+            tlist.val[i] = shm->localGetValue(it->t_ait, it->t_ai);
+            tlist.state[i] = ( it->value ? 1 : 0 );
+        }
+
+        // см. IOBase::processingThreshold()
+        for( size_t i = 0; i < n; i++ )
+        {
+            // нижний предел проверяется первым
+            const uint8_t low = ( tlist.val[i] <= tlist.lowlimit[i] );
+            const uint8_t high = ( tlist.val[i] >= tlist.hilimit[i] );
+            const uint8_t inv = tlist.invert[i];
+            tlist.state[i] = low ? inv : ( high ? !inv : tlist.state[i] );
+        }
+
+        for( size_t i = 0; i < n; i++ )
+            IOBase::processingAsDI(tlist.items[i], tlist.state[i], shm, force);
+    }
+    // -----------------------------------------------------------------------------
+    void IOBlock::clear()
+    {
+        blist.clear();
+        slots.clear();
+        fitems.clear();
+        fraw.clear();
+        tlist = Thresholds();
+    }
+    // -----------------------------------------------------------------------------
+    size_t IOBlock::size() const noexcept
+    {
+        return slots.size();
+    }
+    // -----------------------------------------------------------------------------
+    size_t IOBlock::blockSize() const noexcept
+    {
+        return slots.size() - fitems.size();
+    }
+    // -----------------------------------------------------------------------------
+    size_t IOBlock::fallbackSize() const noexcept
+    {
+        return fitems.size();
+    }
+    // -----------------------------------------------------------------------------
+} // end of namespace uniset
@@ -18,6 +18,7 @@
 #include <iomanip>
 #include "Exceptions.h"
 #include "SMInterface.h"
+#include "LatencyTrace.h"
 // --------------------------------------------------------------------------
 using namespace std;
 using namespace uniset;
@@ -169,6 +170,27 @@ void SMInterface::askSensor( uniset::ObjectId id, UniversalIO::UIOCommand cmd, u
     END_FUNC(SMInterface::askSensor)
 }
 // --------------------------------------------------------------------------
+void SMInterface::askSensor( uniset::ObjectId id, UniversalIO::UIOCommand cmd,
+                             const IONotifyController_i::NotifyFilter& filter, uniset::ObjectId backid )
+{
+    ConsumerInfo_var ci = new ConsumerInfo();
+    ci->id   = (backid == DefaultObjectId) ? myid : backid;
+    ci->node = ui->getConf()->getLocalNode();
+
+    if( ic )
+    {
+        BEG_FUNC1(SMInterface::askSensor)
+        ic->askSensorWithFilter(id, ci, cmd, filter);
+        return;
+        END_FUNC(SMInterface::askSensor)
+    }
+
+    BEG_FUNC1(SMInterface::askSensor)
+    ui->askRemoteSensor(id, cmd, conf->getLocalNode(), filter, ci->id);
+    return;
+    END_FUNC(SMInterface::askSensor)
+}
+// --------------------------------------------------------------------------
 IOController_i::SensorInfoSeq* SMInterface::getSensorsMap()
 {
     if( ic )
@@ -253,9 +275,20 @@ void SMInterface::localSetValue( IOController::IOStateList::iterator& it,
                                  uniset::ObjectId sid,
                                  CORBA::Long value, uniset::ObjectId sup_id )
 {
+    // трассировка задержек (метку выставляет процесс обмена, см. LatencyTrace::Scope)
+    // метка относится только к первому записываемому значению
+    const uint32_t trace = LatencyTrace::take();
+    LatencyTrace::hop(LatencyTrace::Receive, trace);
+
     if( !ic )
-        return setValue(sid, value);
+    {
+        setValue(sid, value);
+        LatencyTrace::hop(LatencyTrace::SetValue, trace);
+        return;
+    }
 
+    // SetValue учитывается в IONotifyController
+    LatencyTrace::Scope ltrace(trace);
     ic->localSetValueIt(it, sid, value, sup_id);
 }
 // --------------------------------------------------------------------------
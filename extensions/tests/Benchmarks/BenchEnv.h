@@ -0,0 +1,57 @@
+// --------------------------------------------------------------------------
+#ifndef BenchEnv_H_
+#define BenchEnv_H_
+// --------------------------------------------------------------------------
+#include <memory>
+#include <vector>
+#include <atomic>
+#include <unordered_map>
+#include "UniSetObject.h"
+#include "SharedMemory.h"
+#include "SMInterface.h"
+// --------------------------------------------------------------------------
+/*! "Получатель" уведомлений для замера рассылки IONotifyController.
+ * Запоминает последнее полученное значение по каждому заказанному датчику.
+ * Список датчиков задаётся до активации (дальше map не меняется, поэтому
+ * читать значения из других потоков можно без блокировок).
+ */
+class BenchConsumer:
+    public uniset::UniSetObject
+{
+    public:
+        BenchConsumer( uniset::ObjectId id, const std::vector<uniset::ObjectId>& sensors );
+        virtual ~BenchConsumer();
+
+        //! последнее полученное значение датчика (LONG_MIN - ничего не получали)
+        long lastValue( uniset::ObjectId sid ) const;
+
+        inline size_t received() const noexcept
+        {
+            return count;
+        }
+
+        void askSensors( UniversalIO::UIOCommand cmd );
+
+    protected:
+        virtual void sensorInfo( const uniset::SensorMessage* sm ) override;
+
+        std::unordered_map<uniset::ObjectId, std::atomic<long>> values;
+        std::atomic<size_t> count = { 0 };
+};
+// --------------------------------------------------------------------------
+// Окружение, общее для всех замеров (создаётся в main)
+namespace benv
+{
+    std::shared_ptr<uniset::SharedMemory> shm();
+    std::shared_ptr<SMInterface> smi();
+    std::shared_ptr<uniset::UInterface> ui();
+
+    //! датчики для замеров get/set (BenchAI1_S ... BenchAI64_S)
+    const std::vector<uniset::ObjectId>& sensors();
+
+    //! получатели уведомлений (BenchConsumer1 ... BenchConsumer16)
+    const std::vector<std::shared_ptr<BenchConsumer>>& consumers();
+}
+// --------------------------------------------------------------------------
+#endif // BenchEnv_H_
+// --------------------------------------------------------------------------
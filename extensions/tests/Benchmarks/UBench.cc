@@ -0,0 +1,633 @@
+// --------------------------------------------------------------------------
+#include <cmath>
+#include <ctime>
+#include <regex>
+#include <memory>
+#include <thread>
+#include <sstream>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+#include <unistd.h>
+#include "Exceptions.h"
+#include "UniSetTypes.h"
+#include "UBench.h"
+#include "uniset-config.h"
+// --------------------------------------------------------------------------
+using namespace std;
+// --------------------------------------------------------------------------
+namespace ubench
+{
+    // ----------------------------------------------------------------------
+    static int64_t cpu_now_ns()
+    {
+        struct timespec ts;
+
+        if( clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) != 0 )
+            return 0;
+
+        return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+    }
+    // ----------------------------------------------------------------------
+    State::State( size_t maxIters, const std::vector<int64_t>& args ):
+        maxIters(maxIters),
+        args(args)
+    {
+    }
+    // ----------------------------------------------------------------------
+    bool State::keepRunning()
+    {
+        if( !started )
+        {
+            started = true;
+            start();
+        }
+
+        if( count < maxIters && errmsg.empty() )
+        {
+            count++;
+            return true;
+        }
+
+        if( !finished )
+        {
+            stop();
+            finished = true;
+        }
+
+        return false;
+    }
+    // ----------------------------------------------------------------------
+    void State::start()
+    {
+        paused = false;
+        cpuStart = cpu_now_ns();
+        realStart = std::chrono::steady_clock::now();
+    }
+    // ----------------------------------------------------------------------
+    void State::stop()
+    {
+        if( paused )
+            return;
+
+        realTime += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - realStart).count();
+        cpuTime += (double)(cpu_now_ns() - cpuStart);
+        paused = true;
+    }
+    // ----------------------------------------------------------------------
+    void State::pauseTiming()
+    {
+        stop();
+    }
+    // ----------------------------------------------------------------------
+    void State::resumeTiming()
+    {
+        start();
+    }
+    // ----------------------------------------------------------------------
+    void State::skipWithError( const std::string& err )
+    {
+        errmsg = err.empty() ? "error" : err;
+    }
+    // ----------------------------------------------------------------------
+    Benchmark::Benchmark( const std::string& name, const BenchFunction& f ):
+        name(name),
+        func(f)
+    {
+    }
+    // ----------------------------------------------------------------------
+    Benchmark* Benchmark::arg( int64_t a )
+    {
+        argsList.push_back({a});
+        return this;
+    }
+    // ----------------------------------------------------------------------
+    Benchmark* Benchmark::args( const std::vector<int64_t>& a )
+    {
+        argsList.push_back(a);
+        return this;
+    }
+    // ----------------------------------------------------------------------
+    Benchmark* Benchmark::minTime( double sec )
+    {
+        minTimeSec = sec;
+        return this;
+    }
+    // ----------------------------------------------------------------------
+    Benchmark* Benchmark::iterations( size_t n )
+    {
+        fixedIters = n;
+        return this;
+    }
+    // ----------------------------------------------------------------------
+    static std::vector<std::unique_ptr<Benchmark>>& registry()
+    {
+        static std::vector<std::unique_ptr<Benchmark>> lst;
+        return lst;
+    }
+    // ----------------------------------------------------------------------
+    Benchmark* registerBenchmark( const std::string& name, const BenchFunction& f )
+    {
+        registry().emplace_back(new Benchmark(name, f));
+        return registry().back().get();
+    }
+    // ----------------------------------------------------------------------
+    //! результат одного замера (или агрегат по повторам)
+    struct Result
+    {
+        std::string name;
+        std::string runName;
+        std::string aggregate; // "" - обычный замер (run_type=iteration)
+        size_t repetitions = { 1 };
+        size_t repIndex = { 0 };
+        size_t iterations = { 0 };
+        double realTime = { 0.0 }; // nsec на итерацию
+        double cpuTime = { 0.0 };  // nsec на итерацию
+        double itemsPerSec = { 0.0 };
+        double bytesPerSec = { 0.0 };
+        std::string label;
+        std::string error;
+    };
+    // ----------------------------------------------------------------------
+    class Runner
+    {
+        public:
+            static Result runOne( Benchmark* b, const std::vector<int64_t>& args, double minTime );
+    };
+    // ----------------------------------------------------------------------
+    Result Runner::runOne( Benchmark* b, const std::vector<int64_t>& args, double minTime )
+    {
+        static const size_t maxIters = 1000000000;
+
+        if( b->minTimeSec > 0 )
+            minTime = b->minTimeSec;
+
+        size_t n = b->fixedIters > 0 ? b->fixedIters : 1;
+        Result r;
+
+        while( true )
+        {
+            State st(n, args);
+
+            try
+            {
+                b->func(st);
+            }
+            catch( const uniset::Exception& ex )
+            {
+                ostringstream err;
+                err << ex;
+                st.skipWithError(err.str());
+            }
+            catch( const std::exception& ex )
+            {
+                st.skipWithError(ex.what());
+            }
+
+            if( !st.error() && !st.finished )
+                st.skipWithError("the benchmark function did not complete the keepRunning() loop");
+
+            const double sec = st.realTime / 1e9;
+
+            if( st.error() || b->fixedIters > 0 || sec >= minTime || n >= maxIters )
+            {
+                r.iterations = st.count;
+                r.label = st.label;
+                r.error = st.errmsg;
+
+                if( st.count > 0 )
+                {
+                    r.realTime = st.realTime / st.count;
+                    r.cpuTime = st.cpuTime / st.count;
+                }
+
+                if( sec > 0 )
+                {
+                    r.itemsPerSec = st.items / sec;
+                    r.bytesPerSec = st.bytes / sec;
+                }
+
+                return r;
+            }
+
+            // подбор количества итераций (как в google benchmark)
+            double multiplier = minTime * 1.4 / std::max(sec, 1e-9);
+
+            if( sec / minTime <= 0.1 )
+                multiplier = 10.0;
+
+            if( multiplier <= 1.0 )
+                multiplier = 2.0;
+
+            n = std::min(maxIters, std::max((size_t)(n * multiplier), n + 1));
+        }
+    }
+    // ----------------------------------------------------------------------
+    static std::string jsonEscape( const std::string& s )
+    {
+        ostringstream os;
+
+        for( const auto& c : s )
+        {
+            switch( c )
+            {
+                case '"':
+                    os << "\\\"";
+                    break;
+
+                case '\\':
+                    os << "\\\\";
+                    break;
+
+                case '\n':
+                    os << "\\n";
+                    break;
+
+                case '\t':
+                    os << "\\t";
+                    break;
+
+                default:
+                    if( (unsigned char)c < 0x20 )
+                        os << "\\u" << hex << setw(4) << setfill('0') << (int)c << dec << setfill(' ');
+                    else
+                        os << c;
+            }
+        }
+
+        return os.str();
+    }
+    // ----------------------------------------------------------------------
+    // 12300000 --> "12.3M"
+    static std::string humanReadable( double v )
+    {
+        static const char* units[] = { "", "k", "M", "G", "T" };
+        size_t u = 0;
+
+        while( std::fabs(v) >= 1000.0 && u < 4 )
+        {
+            v /= 1000.0;
+            u++;
+        }
+
+        ostringstream os;
+        os << fixed << setprecision(v < 10 ? 3 : (v < 100 ? 2 : 1)) << v << units[u];
+        return os.str();
+    }
+    // ----------------------------------------------------------------------
+    static std::string timeStr( double nsec )
+    {
+        ostringstream os;
+        os << fixed;
+
+        if( nsec < 10000.0 )
+            os << setprecision(1) << nsec << " ns";
+        else if( nsec < 10000000.0 )
+            os << setprecision(1) << nsec / 1000.0 << " us";
+        else
+            os << setprecision(1) << nsec / 1000000.0 << " ms";
+
+        return os.str();
+    }
+    // ----------------------------------------------------------------------
+    static void printConsoleHeader( std::ostream& os, size_t nameWidth )
+    {
+        const std::string line(nameWidth + 60, '-');
+        os << line << endl
+           << setw(nameWidth) << left << "Benchmark" << right
+           << setw(16) << "Time" << setw(16) << "CPU" << setw(14) << "Iterations" << " Counters" << endl
+           << line << endl;
+    }
+    // ----------------------------------------------------------------------
+    static void printConsole( std::ostream& os, const Result& r, size_t nameWidth )
+    {
+        os << setw(nameWidth) << left << r.name << right;
+
+        if( !r.error.empty() )
+        {
+            os << " ERROR: " << r.error << endl;
+            return;
+        }
+
+        os << setw(16) << timeStr(r.realTime) << setw(16) << timeStr(r.cpuTime);
+
+        if( r.aggregate.empty() )
+            os << setw(14) << r.iterations;
+        else
+            os << setw(14) << r.repetitions;
+
+        if( r.itemsPerSec > 0 )
+            os << " items_per_second=" << humanReadable(r.itemsPerSec) << "/s";
+
+        if( r.bytesPerSec > 0 )
+            os << " bytes_per_second=" << humanReadable(r.bytesPerSec) << "B/s";
+
+        if( !r.label.empty() )
+            os << " " << r.label;
+
+        os << endl;
+    }
+    // ----------------------------------------------------------------------
+    static void writeJSON( std::ostream& os, const std::vector<Result>& results, const std::string& exe )
+    {
+        char hostname[256] = { 0 };
+        gethostname(hostname, sizeof(hostname) - 1);
+
+        time_t t = time(nullptr);
+        struct tm tms;
+        localtime_r(&t, &tms);
+        char date[64];
+        strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", &tms);
+
+        long mhz = 0;
+        {
+            ifstream f("/proc/cpuinfo");
+            std::string line;
+
+            while( std::getline(f, line) )
+            {
+                if( line.compare(0, 7, "cpu MHz") == 0 )
+                {
+                    auto pos = line.find(':');
+
+                    if( pos != std::string::npos )
+                        mhz = std::lround(atof(line.c_str() + pos + 1));
+
+                    break;
+                }
+            }
+        }
+
+        os << "{" << endl
+           << "  \"context\": {" << endl
+           << "    \"date\": \"" << date << "\"," << endl
+           << "    \"host_name\": \"" << jsonEscape(hostname) << "\"," << endl
+           << "    \"executable\": \"" << jsonEscape(exe) << "\"," << endl
+           << "    \"num_cpus\": " << std::thread::hardware_concurrency() << "," << endl
+           << "    \"mhz_per_cpu\": " << mhz << "," << endl
+#ifdef PACKAGE_VERSION
+           << "    \"uniset_version\": \"" << PACKAGE_VERSION << "\"," << endl
+#endif
+#ifdef NDEBUG
+           << "    \"library_build_type\": \"release\"" << endl
+#else
+           << "    \"library_build_type\": \"debug\"" << endl
+#endif
+           << "  }," << endl
+           << "  \"benchmarks\": [";
+
+        os << setprecision(12);
+
+        for( size_t i = 0; i < results.size(); i++ )
+        {
+            const auto& r = results[i];
+
+            os << ( i > 0 ? "," : "" ) << endl
+               << "    {" << endl
+               << "      \"name\": \"" << jsonEscape(r.name) << "\"," << endl
+               << "      \"run_name\": \"" << jsonEscape(r.runName) << "\"," << endl
+               << "      \"run_type\": \"" << ( r.aggregate.empty() ? "iteration" : "aggregate" ) << "\"," << endl
+               << "      \"repetitions\": " << r.repetitions << "," << endl;
+
+            if( r.aggregate.empty() )
+                os << "      \"repetition_index\": " << r.repIndex << "," << endl;
+            else
+                os << "      \"aggregate_name\": \"" << r.aggregate << "\"," << endl;
+
+            os << "      \"threads\": 1," << endl;
+
+            if( !r.error.empty() )
+            {
+                os << "      \"error_occurred\": true," << endl
+                   << "      \"error_message\": \"" << jsonEscape(r.error) << "\"" << endl
+                   << "    }";
+                continue;
+            }
+
+            os << "      \"iterations\": " << ( r.aggregate.empty() ? r.iterations : r.repetitions ) << "," << endl
+               << "      \"real_time\": " << r.realTime << "," << endl
+               << "      \"cpu_time\": " << r.cpuTime << "," << endl
+               << "      \"time_unit\": \"ns\"";
+
+            if( r.itemsPerSec > 0 )
+                os << "," << endl << "      \"items_per_second\": " << r.itemsPerSec;
+
+            if( r.bytesPerSec > 0 )
+                os << "," << endl << "      \"bytes_per_second\": " << r.bytesPerSec;
+
+            if( !r.label.empty() )
+                os << "," << endl << "      \"label\": \"" << jsonEscape(r.label) << "\"";
+
+            os << endl << "    }";
+        }
+
+        os << endl << "  ]" << endl << "}" << endl;
+    }
+    // ----------------------------------------------------------------------
+    // mean/median/stddev по повторам
+    static void addAggregates( std::vector<Result>& results, const std::vector<Result>& reps )
+    {
+        std::vector<Result> ok;
+
+        for( const auto& r : reps )
+        {
+            if( r.error.empty() )
+                ok.push_back(r);
+        }
+
+        if( ok.size() < 2 )
+            return;
+
+        auto field = [&]( double Result::* f, const std::string & agg )
+        {
+            std::vector<double> v;
+
+            for( const auto& r : ok )
+                v.push_back(r.*f);
+
+            double mean = 0;
+
+            for( const auto& x : v )
+                mean += x;
+
+            mean /= v.size();
+
+            if( agg == "mean" )
+                return mean;
+
+            if( agg == "median" )
+            {
+                std::sort(v.begin(), v.end());
+                const size_t m = v.size() / 2;
+                return ( v.size() % 2 ) ? v[m] : (v[m - 1] + v[m]) / 2.0;
+            }
+
+            // stddev
+            double sq = 0;
+
+            for( const auto& x : v )
+                sq += (x - mean) * (x - mean);
+
+            return std::sqrt(sq / (v.size() - 1));
+        };
+
+        for( const auto& agg : { "mean", "median", "stddev" } )
+        {
+            Result a;
+            a.runName = ok[0].runName;
+            a.name = a.runName + "_" + agg;
+            a.aggregate = agg;
+            a.repetitions = reps.size();
+            a.iterations = ok[0].iterations;
+            a.realTime = field(&Result::realTime, agg);
+            a.cpuTime = field(&Result::cpuTime, agg);
+            a.itemsPerSec = field(&Result::itemsPerSec, agg);
+            a.bytesPerSec = field(&Result::bytesPerSec, agg);
+            results.push_back(a);
+        }
+    }
+    // ----------------------------------------------------------------------
+    void help_print()
+    {
+        cout << "--bench-filter regex        - Запускать только замеры, имя которых содержит regex" << endl;
+        cout << "--bench-min-time sec        - Минимальное время одного замера. По умолчанию 0.5 сек" << endl;
+        cout << "--bench-repetitions num     - Количество повторов каждого замера (+mean/median/stddev). По умолчанию 1" << endl;
+        cout << "--bench-format console|json - Формат вывода результатов. По умолчанию console" << endl;
+        cout << "--bench-out file            - Дополнительно записать результаты в файл (json)" << endl;
+        cout << "--bench-list                - Вывести список замеров" << endl;
+    }
+    // ----------------------------------------------------------------------
+    int runBenchmarks( int argc, const char* const* argv )
+    {
+        const std::string filter = uniset::getArgParam("--bench-filter", argc, argv, "");
+        const std::string format = uniset::getArgParam("--bench-format", argc, argv, "console");
+        const std::string outfile = uniset::getArgParam("--bench-out", argc, argv, "");
+        const size_t reps = std::max(1, uniset::getArgPInt("--bench-repetitions", argc, argv, "", 1));
+        const bool listOnly = uniset::findArgParam("--bench-list", argc, argv) != -1;
+
+        double minTime = atof(uniset::getArgParam("--bench-min-time", argc, argv, "0.5").c_str());
+
+        if( minTime <= 0 )
+            minTime = 0.5;
+
+        if( format != "console" && format != "json" )
+        {
+            cerr << "(bench): unknown format '" << format << "'. Must be [console,json]" << endl;
+            return 1;
+        }
+
+        std::regex re;
+
+        try
+        {
+            re = std::regex(filter.empty() ? "." : filter);
+        }
+        catch( const std::regex_error& ex )
+        {
+            cerr << "(bench): bad filter '" << filter << "': " << ex.what() << endl;
+            return 1;
+        }
+
+        // список запусков (имя/аргументы)
+        std::vector<std::tuple<Benchmark*, std::vector<int64_t>, std::string>> runs;
+
+        for( const auto& b : registry() )
+        {
+            auto alist = b->getArgs();
+
+            if( alist.empty() )
+                alist.push_back({});
+
+            for( const auto& a : alist )
+            {
+                std::string name = b->getName();
+
+                for( const auto& v : a )
+                    name += "/" + std::to_string(v);
+
+                if( std::regex_search(name, re) )
+                    runs.emplace_back(b.get(), a, name);
+            }
+        }
+
+        if( listOnly )
+        {
+            for( const auto& r : runs )
+                cout << std::get<2>(r) << endl;
+
+            return 0;
+        }
+
+        size_t nameWidth = 10;
+
+        for( const auto& r : runs )
+            nameWidth = std::max(nameWidth, std::get<2>(r).size() + (reps > 1 ? 8 : 0) + 2);
+
+        const bool console = ( format == "console" );
+
+        if( console )
+            printConsoleHeader(cout, nameWidth);
+
+        std::vector<Result> results;
+        int ret = 0;
+
+        for( const auto& r : runs )
+        {
+            std::vector<Result> rlist;
+
+            for( size_t i = 0; i < reps; i++ )
+            {
+                Result res = Runner::runOne(std::get<0>(r), std::get<1>(r), minTime);
+                res.runName = std::get<2>(r);
+                res.name = res.runName;
+                res.repetitions = reps;
+                res.repIndex = i;
+
+                if( !res.error.empty() )
+                    ret = 1;
+
+                if( console )
+                    printConsole(cout, res, nameWidth);
+                else
+                    printConsole(cerr, res, nameWidth);
+
+                rlist.push_back(res);
+                results.push_back(res);
+
+                // ошибка окружения (нет связи и т.п.) - повторять бессмысленно
+                if( !res.error.empty() )
+                    break;
+            }
+
+            if( reps > 1 )
+            {
+                const size_t first = results.size();
+                addAggregates(results, rlist);
+
+                for( size_t i = first; i < results.size(); i++ )
+                    printConsole(console ? cout : cerr, results[i], nameWidth);
+            }
+        }
+
+        if( !console )
+            writeJSON(cout, results, argv[0]);
+
+        if( !outfile.empty() )
+        {
+            ofstream f(outfile);
+
+            if( !f.is_open() )
+            {
+                cerr << "(bench): can't open " << outfile << endl;
+                return 1;
+            }
+
+            writeJSON(f, results, argv[0]);
+        }
+
+        return ret;
+    }
+    // ----------------------------------------------------------------------
+} // end of namespace ubench
+// --------------------------------------------------------------------------
@@ -0,0 +1,171 @@
+// --------------------------------------------------------------------------
+#ifndef UBench_H_
+#define UBench_H_
+// --------------------------------------------------------------------------
+#include <string>
+#include <vector>
+#include <chrono>
+#include <functional>
+#include <cstdint>
+// --------------------------------------------------------------------------
+/*! Минимальный "каркас" для замеров производительности (uniset2-bench).
+ *
+ * Интерфейс и формат результатов повторяют Google Benchmark (https://github.com/google/benchmark),
+ * чтобы результаты можно было обрабатывать его же инструментами (compare.py и т.п.),
+ * но без внешней зависимости.
+ *
+ * \code
+ * static void BM_Something( ubench::State& st )
+ * {
+ *     // подготовка (не входит в замер)
+ *     while( st.keepRunning() )
+ *         doSomething(st.range(0));
+ *
+ *     st.setItemsProcessed(st.iterations());
+ * }
+ * UBENCH(BM_Something)->arg(1)->arg(100);
+ * \endcode
+ *
+ * Количество итераций подбирается автоматически так, чтобы замер длился не меньше minTime.
+ * Время (real/cpu) выводится в наносекундах на одну итерацию.
+ * CPU-время считается по всему процессу (CLOCK_PROCESS_CPUTIME_ID), т.е. включает работу
+ * других потоков (сервер, получатели), что для сквозных (end-to-end) замеров и нужно.
+ */
+namespace ubench
+{
+    // ----------------------------------------------------------------------
+    class State
+    {
+        public:
+            State( size_t maxIters, const std::vector<int64_t>& args );
+
+            //! цикл замера: while( st.keepRunning() ) { ... }
+            bool keepRunning();
+
+            inline int64_t range( size_t i = 0 ) const
+            {
+                return i < args.size() ? args[i] : 0;
+            }
+
+            inline size_t iterations() const noexcept
+            {
+                return count;
+            }
+
+            //! исключить из замера часть итерации (например подготовку данных)
+            void pauseTiming();
+            void resumeTiming();
+
+            //! обработано "единиц" (сообщений, датчиков...) за весь замер -> items_per_second
+            inline void setItemsProcessed( int64_t n ) noexcept
+            {
+                items = n;
+            }
+            //! обработано байт за весь замер -> bytes_per_second
+            inline void setBytesProcessed( int64_t n ) noexcept
+            {
+                bytes = n;
+            }
+
+            inline void setLabel( const std::string& l )
+            {
+                label = l;
+            }
+
+            //! прервать замер с ошибкой (результат будет помечен как error_occurred)
+            void skipWithError( const std::string& err );
+
+            inline bool error() const noexcept
+            {
+                return !errmsg.empty();
+            }
+
+        private:
+            friend class Runner;
+
+            void start();
+            void stop();
+
+            const size_t maxIters;
+            const std::vector<int64_t> args;
+            size_t count = { 0 };
+            bool started = { false };
+            bool paused = { false };
+            bool finished = { false };
+            std::chrono::steady_clock::time_point realStart;
+            int64_t cpuStart = { 0 };
+            double realTime = { 0.0 }; // nsec
+            double cpuTime = { 0.0 };  // nsec
+            int64_t items = { 0 };
+            int64_t bytes = { 0 };
+            std::string label;
+            std::string errmsg;
+    };
+    // ----------------------------------------------------------------------
+    using BenchFunction = std::function<void(State&)>;
+
+    class Benchmark
+    {
+        public:
+            Benchmark( const std::string& name, const BenchFunction& f );
+
+            //! добавить вариант запуска с параметром (st.range(0))
+            Benchmark* arg( int64_t a );
+            //! добавить вариант запуска с несколькими параметрами (st.range(0), st.range(1), ...)
+            Benchmark* args( const std::vector<int64_t>& a );
+            //! минимальное время замера, сек (по умолчанию --bench-min-time)
+            Benchmark* minTime( double sec );
+            //! фиксированное количество итераций (без подбора)
+            Benchmark* iterations( size_t n );
+
+            inline const std::string& getName() const noexcept
+            {
+                return name;
+            }
+
+            inline const std::vector<std::vector<int64_t>>& getArgs() const noexcept
+            {
+                return argsList;
+            }
+
+        private:
+            friend class Runner;
+
+            std::string name;
+            BenchFunction func;
+            std::vector<std::vector<int64_t>> argsList;
+            double minTimeSec = { 0.0 };
+            size_t fixedIters = { 0 };
+    };
+    // ----------------------------------------------------------------------
+    Benchmark* registerBenchmark( const std::string& name, const BenchFunction& f );
+
+    /*! Запустить зарегистрированные замеры.
+     * Параметры:
+     * --bench-filter regex       - запускать только замеры, имя которых содержит regex
+     * --bench-min-time sec       - минимальное время одного замера (по умолчанию 0.5)
+     * --bench-repetitions num    - количество повторов (для num > 1 добавляются mean/median/stddev)
+     * --bench-format console|json - формат вывода в stdout
+     * --bench-out file           - дополнительно записать результаты в file (json)
+     * --bench-list               - только вывести список замеров
+     * \return 0 - если все замеры прошли без ошибок
+     */
+    int runBenchmarks( int argc, const char* const* argv );
+
+    void help_print();
+
+    //! защита от "выбрасывания" вычислений оптимизатором
+    template<typename T>
+    inline void doNotOptimize( T const& v )
+    {
+        asm volatile("" : : "r,m"(v) : "memory");
+    }
+}
+// --------------------------------------------------------------------------
+#define UBENCH_CONCAT2(a, b) a##b
+#define UBENCH_CONCAT(a, b) UBENCH_CONCAT2(a, b)
+#define UBENCH(func) \
+    static ubench::Benchmark* UBENCH_CONCAT(ubench_reg_, __LINE__) __attribute__((unused)) = ubench::registerBenchmark(#func, func)
+// --------------------------------------------------------------------------
+#endif // UBench_H_
+// --------------------------------------------------------------------------
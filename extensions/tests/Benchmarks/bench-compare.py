@@ -0,0 +1,125 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+Сравнение результатов uniset2-bench (формат Google Benchmark JSON) с эталонными.
+
+    bench-compare.py [--threshold 10] [--metric real_time|cpu_time] baseline.json current.json
+
+Для каждого замера выводится изменение времени на итерацию (в процентах).
+Если в файлах есть повторы (--bench-repetitions), используется медиана.
+Код возврата: 0 - регрессий нет, 1 - есть замеры, ставшие медленнее больше чем на threshold %,
+              2 - ошибка (нет файла, неверный формат и т.п.)
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(fname):
+    with open(fname) as f:
+        data = json.load(f)
+
+    if "benchmarks" not in data:
+        raise ValueError("%s: not a benchmark result (no 'benchmarks')" % fname)
+
+    # run_name -> запись (медиана, если есть повторы)
+    res = {}
+    medians = {}
+
+    for b in data["benchmarks"]:
+        name = b.get("run_name", b.get("name"))
+
+        if b.get("error_occurred"):
+            res[name] = b
+            continue
+
+        if b.get("run_type") == "aggregate":
+            if b.get("aggregate_name") == "median":
+                medians[name] = b
+            continue
+
+        res.setdefault(name, b)
+
+    res.update(medians)
+    return data.get("context", {}), res
+
+
+def fmt_time(ns):
+    if ns < 10000.0:
+        return "%.1f ns" % ns
+    if ns < 10000000.0:
+        return "%.1f us" % (ns / 1000.0)
+    return "%.1f ms" % (ns / 1000000.0)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare two uniset2-bench results")
+    parser.add_argument("baseline", help="baseline result (json)")
+    parser.add_argument("current", help="current result (json)")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="regression threshold, %% (default: 10)")
+    parser.add_argument("--metric", choices=["real_time", "cpu_time"], default="real_time",
+                        help="compared value (default: real_time)")
+    args = parser.parse_args()
+
+    try:
+        bctx, base = load(args.baseline)
+        cctx, cur = load(args.current)
+    except (OSError, ValueError) as e:
+        print("(bench-compare): %s" % e, file=sys.stderr)
+        return 2
+
+    for key in ("host_name", "num_cpus", "library_build_type"):
+        if bctx.get(key) != cctx.get(key):
+            print("WARNING: different %s: %s -> %s" % (key, bctx.get(key), cctx.get(key)))
+
+    width = max([len(n) for n in list(base) + list(cur)] + [10]) + 2
+    print("%-*s %14s %14s %9s" % (width, "Benchmark", "baseline", "current", "change"))
+    print("-" * (width + 40))
+
+    regressions = []
+
+    for name in list(base) + [n for n in cur if n not in base]:
+        b = base.get(name)
+        c = cur.get(name)
+
+        if b is None:
+            print("%-*s %14s %14s %9s" % (width, name, "-", fmt_time(c.get(args.metric, 0)), "new"))
+            continue
+
+        if c is None:
+            print("%-*s %14s %14s %9s" % (width, name, fmt_time(b.get(args.metric, 0)), "-", "removed"))
+            continue
+
+        if c.get("error_occurred"):
+            print("%-*s ERROR: %s" % (width, name, c.get("error_message", "")))
+            regressions.append(name)
+            continue
+
+        if b.get("error_occurred"):
+            print("%-*s %14s %14s %9s" % (width, name, "error", fmt_time(c[args.metric]), "-"))
+            continue
+
+        bv = b[args.metric]
+        cv = c[args.metric]
+        change = (cv - bv) * 100.0 / bv if bv > 0 else 0.0
+        mark = ""
+
+        if change > args.threshold:
+            mark = "  <-- REGRESSION"
+            regressions.append(name)
+        elif change < -args.threshold:
+            mark = "  (faster)"
+
+        print("%-*s %14s %14s %+8.1f%%%s" % (width, name, fmt_time(bv), fmt_time(cv), change, mark))
+
+    if regressions:
+        print("\n%d regression(s) (threshold %.1f%%): %s" % (len(regressions), args.threshold, ", ".join(regressions)))
+        return 1
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,16 @@
+#!/bin/sh
+
+# Запуск набора замеров (uniset2-bench) вместе с omniNames.
+# Все аргументы передаются uniset2-bench, например:
+#   ./bench.sh --bench-filter Modbus --bench-repetitions 5 --bench-format json --bench-out result.json
+cd ../../../Utilities/Admin/
+
+./create_links.sh
+./uniset2-start.sh -f ./create
+
+./uniset2-start.sh -f ./exist | grep -q UNISET_PLC/Controllers || exit 1
+
+cd -
+
+./uniset2-start.sh -f ./uniset2-bench --confile bench.xml --e-startup-pause 10 \
+	--http-api-disable-access-control 1 --activator-run-httpserver --activator-httpserver-port 9191 $*
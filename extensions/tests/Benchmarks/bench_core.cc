@@ -0,0 +1,317 @@
+// --------------------------------------------------------------------------
+// IOController (get/set), рассылка IONotifyController, очередь MQRing
+// (MQAtomic - для сравнения)
+// --------------------------------------------------------------------------
+#include <thread>
+#include <atomic>
+#include <climits>
+#include <vector>
+#include "MQRing.h"
+#include "MQAtomic.h"
+#include "MessageType.h"
+#include "UBench.h"
+#include "BenchEnv.h"
+// --------------------------------------------------------------------------
+using namespace std;
+using namespace uniset;
+// --------------------------------------------------------------------------
+// Чтение через IOController::getValue (поиск датчика по ID)
+static void BM_IOController_GetValue( ubench::State& st )
+{
+    auto shm = benv::shm();
+    const auto& sensors = benv::sensors();
+    size_t i = 0;
+
+    while( st.keepRunning() )
+    {
+        ubench::doNotOptimize( shm->getValue(sensors[i], DefaultObjectId) );
+
+        if( ++i >= sensors.size() )
+            i = 0;
+    }
+
+    st.setItemsProcessed(st.iterations());
+}
+UBENCH(BM_IOController_GetValue);
+// --------------------------------------------------------------------------
+// Запись через IOController::setValue (поиск датчика по ID)
+static void BM_IOController_SetValue( ubench::State& st )
+{
+    auto shm = benv::shm();
+    const auto& sensors = benv::sensors();
+    size_t i = 0;
+    long v = 0;
+
+    while( st.keepRunning() )
+    {
+        shm->setValue(sensors[i], ++v, DefaultObjectId);
+
+        if( ++i >= sensors.size() )
+            i = 0;
+    }
+
+    st.setItemsProcessed(st.iterations());
+}
+UBENCH(BM_IOController_SetValue);
+// --------------------------------------------------------------------------
+// Чтение/запись через сохранённые итераторы (так работают процессы обмена с SM в одном процессе)
+static void BM_IOController_LocalGetSet( ubench::State& st )
+{
+    auto smi = benv::smi();
+    const auto& sensors = benv::sensors();
+    std::vector<IOController::IOStateList::iterator> its(sensors.size());
+
+    for( auto&& it : its )
+        smi->initIterator(it);
+
+    size_t i = 0;
+    long v = 0;
+
+    while( st.keepRunning() )
+    {
+        smi->localSetValue(its[i], sensors[i], ++v, DefaultObjectId);
+        ubench::doNotOptimize( smi->localGetValue(its[i], sensors[i]) );
+
+        if( ++i >= sensors.size() )
+            i = 0;
+    }
+
+    st.setItemsProcessed(2 * st.iterations());
+}
+UBENCH(BM_IOController_LocalGetSet);
+// --------------------------------------------------------------------------
+// Чтение/запись через UInterface (CORBA-вызов, как из другого процесса)
+static void BM_UInterface_GetSet( ubench::State& st )
+{
+    auto ui = benv::ui();
+    const auto& sensors = benv::sensors();
+    size_t i = 0;
+    long v = 0;
+
+    while( st.keepRunning() )
+    {
+        ui->setValue(sensors[i], ++v);
+        ubench::doNotOptimize( ui->getValue(sensors[i]) );
+
+        if( ++i >= sensors.size() )
+            i = 0;
+    }
+
+    st.setItemsProcessed(2 * st.iterations());
+}
+UBENCH(BM_UInterface_GetSet);
+// --------------------------------------------------------------------------
+// Рассылка уведомления N получателям: время от setValue до получения
+// нового значения всеми получателями (sensorInfo)
+static void BM_IONotifyController_FanOut( ubench::State& st )
+{
+    const size_t num = st.range(0);
+    const ObjectId sid = uniset_conf()->getSensorID("BenchFanout" + std::to_string(num) + "_S");
+    const auto& consumers = benv::consumers();
+
+    if( sid == DefaultObjectId || consumers.size() < num )
+    {
+        st.skipWithError("not found 'BenchFanout" + std::to_string(num) + "_S' or not enough consumers");
+        return;
+    }
+
+    auto shm = benv::shm();
+    long v = shm->getValue(sid, DefaultObjectId);
+
+    while( st.keepRunning() )
+    {
+        shm->setValue(sid, ++v, DefaultObjectId);
+
+        for( size_t k = 0; k < num && !st.error(); k++ )
+        {
+            const auto t0 = std::chrono::steady_clock::now();
+
+            while( consumers[k]->lastValue(sid) != v )
+            {
+                if( std::chrono::steady_clock::now() - t0 > std::chrono::seconds(5) )
+                {
+                    st.skipWithError("notification lost (consumer " + std::to_string(k + 1) + ")");
+                    break;
+                }
+
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    st.setItemsProcessed(st.iterations() * num);
+}
+UBENCH(BM_IONotifyController_FanOut)->arg(1)->arg(4)->arg(16);
+// --------------------------------------------------------------------------
+// Очередь сообщений UniSetObject (MQRing): поместить и извлечь одно сообщение
+static void BM_MQRing_PushPop( ubench::State& st )
+{
+    MQRing mq(st.range(0));
+    SensorMessage sm(100, 1);
+    auto tm = sm.transport_msg();
+    MQRing::Item item;
+
+    while( st.keepRunning() )
+    {
+        mq.push(tm);
+        ubench::doNotOptimize( mq.pop(&item, 1) );
+    }
+
+    st.setItemsProcessed(st.iterations());
+}
+UBENCH(BM_MQRing_PushPop)->arg(2000);
+// --------------------------------------------------------------------------
+// Очередь сообщений UniSetObject (MQRing): пачка из N сообщений
+// (заполнение и выборка пачками, как в UniSetObject::processMessages)
+static void BM_MQRing_Burst( ubench::State& st )
+{
+    const size_t num = st.range(0);
+    MQRing mq(num);
+    SensorMessage sm(100, 1);
+    auto tm = sm.transport_msg();
+    std::vector<MQRing::Item> batch(100); // --uniset-object-message-batch (по умолчанию)
+
+    while( st.keepRunning() )
+    {
+        for( size_t i = 0; i < num; i++ )
+            mq.push(tm);
+
+        while( mq.pop(batch.data(), batch.size()) > 0 )
+            ubench::doNotOptimize( batch[0].get() );
+    }
+
+    st.setItemsProcessed(st.iterations() * num);
+}
+UBENCH(BM_MQRing_Burst)->arg(100)->arg(2000);
+// --------------------------------------------------------------------------
+// Очередь сообщений UniSetObject (MQRing): писатель (замер) и читатель
+// (выборка пачками) в отдельном потоке
+static void BM_MQRing_ProducerConsumer( ubench::State& st )
+{
+    MQRing mq(st.range(0));
+    SensorMessage sm(100, 1);
+    auto tm = sm.transport_msg();
+
+    std::atomic<bool> active = { true };
+    std::atomic<size_t> popped = { 0 };
+
+    std::thread reader([&]
+    {
+        std::vector<MQRing::Item> batch(100);
+
+        while( active || !mq.empty() )
+        {
+            const size_t n = mq.pop(batch.data(), batch.size());
+
+            if( n > 0 )
+                popped += n;
+            else
+                std::this_thread::yield();
+        }
+    });
+
+    size_t pushed = 0;
+
+    while( st.keepRunning() )
+    {
+        // очередь переполнена: ждём читателя (иначе MQRing выбросит старое сообщение)
+        while( pushed - popped >= mq.getMaxSizeOfMessageQueue() )
+            std::this_thread::yield();
+
+        mq.push(tm);
+        pushed++;
+    }
+
+    active = false;
+    reader.join();
+
+    st.setItemsProcessed(st.iterations());
+
+    if( popped != pushed )
+        st.setLabel("lost=" + std::to_string(pushed - popped));
+}
+UBENCH(BM_MQRing_ProducerConsumer)->arg(2000);
+// --------------------------------------------------------------------------
+// Далее MQAtomic (прежняя очередь) - для сравнения с MQRing
+// --------------------------------------------------------------------------
+// Очередь сообщений: поместить и извлечь одно сообщение
+static void BM_MQAtomic_PushPop( ubench::State& st )
+{
+    MQAtomic mq(st.range(0));
+    SensorMessage sm(100, 1);
+    auto msg = make_shared<VoidMessage>(sm.transport_msg());
+
+    while( st.keepRunning() )
+    {
+        mq.push(msg);
+        ubench::doNotOptimize( mq.top() );
+    }
+
+    st.setItemsProcessed(st.iterations());
+}
+UBENCH(BM_MQAtomic_PushPop)->arg(2000);
+// --------------------------------------------------------------------------
+// Очередь сообщений: пачка из N сообщений (заполнение и выборка)
+static void BM_MQAtomic_Burst( ubench::State& st )
+{
+    const size_t num = st.range(0);
+    MQAtomic mq(num);
+    SensorMessage sm(100, 1);
+    auto msg = make_shared<VoidMessage>(sm.transport_msg());
+
+    while( st.keepRunning() )
+    {
+        for( size_t i = 0; i < num; i++ )
+            mq.push(msg);
+
+        for( size_t i = 0; i < num; i++ )
+            ubench::doNotOptimize( mq.top() );
+    }
+
+    st.setItemsProcessed(st.iterations() * num);
+}
+UBENCH(BM_MQAtomic_Burst)->arg(100)->arg(2000);
+// --------------------------------------------------------------------------
+// Очередь сообщений: писатель (замер) и читатель в отдельном потоке
+static void BM_MQAtomic_ProducerConsumer( ubench::State& st )
+{
+    MQAtomic mq(st.range(0));
+    SensorMessage sm(100, 1);
+    auto msg = make_shared<VoidMessage>(sm.transport_msg());
+
+    std::atomic<bool> active = { true };
+    std::atomic<size_t> popped = { 0 };
+
+    std::thread reader([&]
+    {
+        while( active || !mq.empty() )
+        {
+            if( mq.top() )
+                popped++;
+            else
+                std::this_thread::yield();
+        }
+    });
+
+    size_t pushed = 0;
+
+    while( st.keepRunning() )
+    {
+        // очередь переполнена: ждём читателя (MQAtomic иначе потеряет сообщение)
+        while( pushed - popped >= mq.getMaxSizeOfMessageQueue() )
+            std::this_thread::yield();
+
+        mq.push(msg);
+        pushed++;
+    }
+
+    active = false;
+    reader.join();
+
+    st.setItemsProcessed(st.iterations());
+
+    if( popped != pushed )
+        st.setLabel("lost=" + std::to_string(pushed - popped));
+}
+UBENCH(BM_MQAtomic_ProducerConsumer)->arg(2000);
+// --------------------------------------------------------------------------
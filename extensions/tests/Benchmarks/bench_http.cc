@@ -0,0 +1,90 @@
+#ifndef DISABLE_REST_API
+// --------------------------------------------------------------------------
+// HTTP API: запрос к SharedMemory и формирование ответа (JSON).
+// Сравнение вариантов с 1 и N датчиками отделяет стоимость формирования JSON
+// от накладных расходов HTTP (соединение keep-alive, т.е. без connect на каждый запрос)
+// --------------------------------------------------------------------------
+#include <sstream>
+#include <iterator>
+#include <Poco/Net/HTTPClientSession.h>
+#include <Poco/Net/HTTPRequest.h>
+#include <Poco/Net/HTTPResponse.h>
+#include "Configuration.h"
+#include "UHttpRequestHandler.h"
+#include "UBench.h"
+#include "BenchEnv.h"
+// --------------------------------------------------------------------------
+using namespace std;
+using namespace uniset;
+using namespace Poco::Net;
+// --------------------------------------------------------------------------
+static void httpLoop( ubench::State& st, const std::string& req, size_t items )
+{
+    auto conf = uniset_conf();
+    const std::string host = conf->getArgParam("--activator-httpserver-host", "localhost");
+    const int port = conf->getArgPInt("--activator-httpserver-port", 9191);
+    const std::string path = "/api/" + UHttp::UHTTP_API_VERSION + "/" + benv::shm()->getName() + "/" + req;
+
+    HTTPClientSession session(host, port);
+    session.setKeepAlive(true);
+    session.setTimeout(Poco::Timespan(5, 0));
+
+    size_t bytes = 0;
+    std::string body;
+
+    while( st.keepRunning() )
+    {
+        try
+        {
+            HTTPRequest rq(HTTPRequest::HTTP_GET, path, HTTPRequest::HTTP_1_1);
+            rq.setKeepAlive(true);
+            HTTPResponse res;
+
+            session.sendRequest(rq);
+            std::istream& rs = session.receiveResponse(res);
+            body.assign(std::istreambuf_iterator<char>(rs), std::istreambuf_iterator<char>());
+
+            if( res.getStatus() != HTTPResponse::HTTP_OK )
+            {
+                st.skipWithError(path + ": " + std::to_string(res.getStatus()) + " " + res.getReason());
+                break;
+            }
+
+            bytes += body.size();
+        }
+        catch( const Poco::Exception& ex )
+        {
+            st.skipWithError(host + ":" + std::to_string(port) + path + ": " + ex.displayText()
+                             + " (use --activator-run-httpserver)");
+            break;
+        }
+    }
+
+    st.setItemsProcessed(st.iterations() * items);
+    st.setBytesProcessed(bytes);
+}
+// --------------------------------------------------------------------------
+// GET .../get?filter=id1,...,idN - значения N датчиков
+static void BM_HttpAPI_Get( ubench::State& st )
+{
+    const auto& sensors = benv::sensors();
+    const size_t num = std::min((size_t)st.range(0), sensors.size());
+
+    ostringstream req;
+    req << "get?filter=";
+
+    for( size_t i = 0; i < num; i++ )
+        req << ( i > 0 ? "," : "" ) << sensors[i];
+
+    httpLoop(st, req.str(), num);
+}
+UBENCH(BM_HttpAPI_Get)->arg(1)->arg(64);
+// --------------------------------------------------------------------------
+// GET .../sensors?limit=N - полная информация по N датчикам
+static void BM_HttpAPI_Sensors( ubench::State& st )
+{
+    httpLoop(st, "sensors?limit=" + std::to_string(st.range(0)), st.range(0));
+}
+UBENCH(BM_HttpAPI_Sensors)->arg(64);
+// --------------------------------------------------------------------------
+#endif // #ifndef DISABLE_REST_API
@@ -0,0 +1,134 @@
+// --------------------------------------------------------------------------
+// Modbus TCP: запрос/ответ (ModbusTCPMaster <-> ModbusTCPServer) через loopback
+// --------------------------------------------------------------------------
+#include <memory>
+#include <vector>
+#include "Configuration.h"
+#include "PassiveTimer.h"
+#include "modbus/ModbusTCPMaster.h"
+#include "modbus/ModbusTCPServerSlot.h"
+#include "UBench.h"
+// --------------------------------------------------------------------------
+using namespace std;
+using namespace uniset;
+using namespace ModbusRTU;
+// --------------------------------------------------------------------------
+static const ModbusAddr slaveaddr = 0x01;
+// --------------------------------------------------------------------------
+static mbErrCode readOutputRegisters( const ReadOutputMessage& query, ReadOutputRetMessage& reply )
+{
+    for( size_t i = 0; i < query.count; i++ )
+        reply.addData( query.start + i );
+
+    return erNoError;
+}
+// --------------------------------------------------------------------------
+static mbErrCode writeOutputRegisters( const WriteOutputMessage& query, WriteOutputRetMessage& reply )
+{
+    reply.set(query.start, query.quant);
+    return erNoError;
+}
+// --------------------------------------------------------------------------
+// Сервер запускается один раз (при первом замере) и работает до завершения программы
+class MBServer
+{
+    public:
+        MBServer( int port ):
+            sslot(new ModbusTCPServerSlot("127.0.0.1", port))
+        {
+            sslot->connectReadOutput( sigc::ptr_fun(&readOutputRegisters) );
+            sslot->connectWriteOutput( sigc::ptr_fun(&writeOutputRegisters) );
+            sslot->setSessionTimeout(0);
+            sslot->async_run( { slaveaddr } );
+
+            PassiveTimer pt(5000);
+
+            while( !pt.checkTime() && !sslot->isActive() )
+                msleep(10);
+        }
+
+        ~MBServer()
+        {
+            sslot->terminate();
+        }
+
+        inline bool isActive() const
+        {
+            return sslot->isActive();
+        }
+
+    private:
+        std::unique_ptr<ModbusTCPServerSlot> sslot;
+};
+// --------------------------------------------------------------------------
+static int mbPort()
+{
+    return uniset_conf()->getArgPInt("--bench-mbtcp-port", 20502);
+}
+// --------------------------------------------------------------------------
+static bool mbConnect( ubench::State& st, ModbusTCPMaster& mb )
+{
+    static MBServer srv(mbPort());
+
+    if( !srv.isActive() )
+    {
+        st.skipWithError("ModbusTCP server not started on 127.0.0.1:" + std::to_string(mbPort()));
+        return false;
+    }
+
+    mb.setTimeout(1000);
+
+    if( !mb.connect("127.0.0.1", mbPort()) )
+    {
+        st.skipWithError("can't connect to 127.0.0.1:" + std::to_string(mbPort()));
+        return false;
+    }
+
+    return true;
+}
+// --------------------------------------------------------------------------
+// Чтение N регистров (0x03)
+static void BM_ModbusTCP_Read03( ubench::State& st )
+{
+    ModbusTCPMaster mb;
+
+    if( !mbConnect(st, mb) )
+        return;
+
+    const ModbusData count = st.range(0);
+
+    while( st.keepRunning() )
+    {
+        auto ret = mb.read03(slaveaddr, 0, count);
+        ubench::doNotOptimize(ret.count);
+    }
+
+    mb.disconnect();
+    st.setItemsProcessed(st.iterations());
+}
+UBENCH(BM_ModbusTCP_Read03)->arg(1)->arg(10)->arg(120);
+// --------------------------------------------------------------------------
+// Запись N регистров (0x10)
+static void BM_ModbusTCP_Write10( ubench::State& st )
+{
+    ModbusTCPMaster mb;
+
+    if( !mbConnect(st, mb) )
+        return;
+
+    WriteOutputMessage msg(slaveaddr, 0);
+
+    for( int64_t i = 0; i < st.range(0); i++ )
+        msg.addData(i);
+
+    while( st.keepRunning() )
+    {
+        auto ret = mb.write10(msg);
+        ubench::doNotOptimize(ret.quant);
+    }
+
+    mb.disconnect();
+    st.setItemsProcessed(st.iterations());
+}
+UBENCH(BM_ModbusTCP_Write10)->arg(1)->arg(10)->arg(120);
+// --------------------------------------------------------------------------
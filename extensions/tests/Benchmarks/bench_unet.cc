@@ -0,0 +1,128 @@
+// --------------------------------------------------------------------------
+// UNet: формирование/разбор пакета и пересылка через UDP (loopback)
+// --------------------------------------------------------------------------
+#include <memory>
+#include <vector>
+#include "Configuration.h"
+#include "UDPPacket.h"
+#include "UDPTransport.h"
+#include "UBench.h"
+// --------------------------------------------------------------------------
+using namespace std;
+using namespace uniset;
+using namespace uniset::UniSetUDP;
+// --------------------------------------------------------------------------
+// заполненный целиком пакет (MaxDCount дискретных, MaxACount аналоговых)
+static std::unique_ptr<UDPMessage> makeFullPacket()
+{
+    std::unique_ptr<UDPMessage> msg(new UDPMessage());
+
+    for( size_t i = 0; i < MaxDCount; i++ )
+        msg->addDData(i + 1, (i % 3) == 0);
+
+    for( size_t i = 0; i < MaxACount; i++ )
+        msg->addAData(i + 1, i * 100);
+
+    msg->updatePacketCrc();
+    return msg;
+}
+// --------------------------------------------------------------------------
+// Формирование пакета: значения всех датчиков + crc (как UNetSender::updateFromSM/send)
+static void BM_UNet_Pack( ubench::State& st )
+{
+    auto msg = makeFullPacket();
+    std::vector<uint8_t> dvals(MaxDCount);
+    std::vector<int64_t> avals(MaxACount);
+    size_t num = 0;
+
+    while( st.keepRunning() )
+    {
+        // "изменение" части значений между пакетами
+        dvals[num % MaxDCount] ^= 1;
+        avals[num % MaxACount]++;
+
+        msg->setDBits(dvals.data(), MaxDCount);
+        msg->setAValues(avals.data(), MaxACount);
+        msg->updatePacketCrc();
+        msg->header.num = ++num;
+        ubench::doNotOptimize(msg->header.dcrc);
+    }
+
+    st.setItemsProcessed(st.iterations());
+    st.setBytesProcessed(st.iterations() * sizeof(UDPMessage));
+}
+UBENCH(BM_UNet_Pack);
+// --------------------------------------------------------------------------
+// Разбор пакета: проверка, crc и извлечение значений (как UNetReceiver::receive/update)
+static void BM_UNet_Unpack( ubench::State& st )
+{
+    auto msg = makeFullPacket();
+    std::vector<uint8_t> dvals(MaxDCount);
+    std::vector<int64_t> avals(MaxACount);
+
+    while( st.keepRunning() )
+    {
+        msg->ntoh();
+
+        if( !msg->isOk() || msg->calcDcrc() != msg->header.dcrc || msg->calcAcrc() != msg->header.acrc )
+        {
+            st.skipWithError("bad packet");
+            break;
+        }
+
+        msg->getDBits(dvals.data(), msg->dsize());
+
+        for( size_t i = 0; i < msg->asize(); i++ )
+            avals[i] = msg->a_dat[i].val;
+
+        ubench::doNotOptimize(avals[0]);
+    }
+
+    st.setItemsProcessed(st.iterations());
+    st.setBytesProcessed(st.iterations() * sizeof(UDPMessage));
+}
+UBENCH(BM_UNet_Unpack);
+// --------------------------------------------------------------------------
+// Пересылка пакета через UDP (loopback): отправка и приём в одном потоке
+static void BM_UNet_Loopback( ubench::State& st )
+{
+    const int port = uniset_conf()->getArgPInt("--bench-unet-port", 20048);
+
+    UDPReceiveTransport recv("127.0.0.1", port);
+    UDPSendTransport send("127.0.0.1", port);
+
+    if( !recv.createConnection(false, 1000, false) || !send.createConnection(false, 1000) )
+    {
+        st.skipWithError("can't create UDP connection 127.0.0.1:" + std::to_string(port));
+        return;
+    }
+
+    auto msg = makeFullPacket();
+    std::unique_ptr<UDPMessage> rmsg(new UDPMessage());
+
+    while( st.keepRunning() )
+    {
+        msg->header.num++;
+
+        if( send.send(msg.get(), sizeof(UDPMessage)) != sizeof(UDPMessage) )
+        {
+            st.skipWithError("send error");
+            break;
+        }
+
+        if( !recv.isReadyForReceive(1000) || recv.receive(rmsg.get(), sizeof(UDPMessage)) != sizeof(UDPMessage) )
+        {
+            st.skipWithError("receive error (packet lost?)");
+            break;
+        }
+
+        rmsg->ntoh();
+        ubench::doNotOptimize(rmsg->header.num);
+    }
+
+    recv.disconnect();
+    st.setItemsProcessed(st.iterations());
+    st.setBytesProcessed(st.iterations() * sizeof(UDPMessage));
+}
+UBENCH(BM_UNet_Loopback);
+// --------------------------------------------------------------------------
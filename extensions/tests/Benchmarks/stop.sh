@@ -0,0 +1 @@
+../../../Utilities/scripts/uniset2-stop.sh
\ No newline at end of file
@@ -0,0 +1,209 @@
+// --------------------------------------------------------------------------
+// Набор замеров производительности основного "пути данных" uniset:
+// IOController (get/set), рассылка уведомлений IONotifyController,
+// очередь сообщений MQAtomic, формирование/разбор и пересылка UNet-пакетов,
+// запрос/ответ Modbus TCP и HTTP API (JSON).
+// Результаты выводятся в формате Google Benchmark (--bench-format json),
+// для сравнения двух прогонов см. bench-compare.py
+// --------------------------------------------------------------------------
+#include <string>
+#include <climits>
+#include <iostream>
+#include "Debug.h"
+#include "UniSetActivator.h"
+#include "PassiveTimer.h"
+#include "SharedMemory.h"
+#include "SMInterface.h"
+#include "Extensions.h"
+#include "UBench.h"
+#include "BenchEnv.h"
+// --------------------------------------------------------------------------
+using namespace std;
+using namespace uniset;
+using namespace uniset::extensions;
+// --------------------------------------------------------------------------
+static shared_ptr<SharedMemory> g_shm;
+static shared_ptr<SMInterface> g_smi;
+static shared_ptr<UInterface> g_ui;
+static std::vector<ObjectId> g_sensors;
+static std::vector<std::shared_ptr<BenchConsumer>> g_consumers;
+static const size_t maxSensors = 64;
+static const size_t maxConsumers = 16;
+// --------------------------------------------------------------------------
+BenchConsumer::BenchConsumer( ObjectId id, const std::vector<ObjectId>& sensors ):
+    UniSetObject(id)
+{
+    for( const auto& s : sensors )
+        values[s] = LONG_MIN;
+}
+// --------------------------------------------------------------------------
+BenchConsumer::~BenchConsumer()
+{
+}
+// --------------------------------------------------------------------------
+long BenchConsumer::lastValue( ObjectId sid ) const
+{
+    auto it = values.find(sid);
+    return it != values.end() ? it->second.load() : LONG_MIN;
+}
+// --------------------------------------------------------------------------
+void BenchConsumer::askSensors( UniversalIO::UIOCommand cmd )
+{
+    for( const auto& v : values )
+        ui->askSensor(v.first, cmd, getId());
+}
+// --------------------------------------------------------------------------
+void BenchConsumer::sensorInfo( const SensorMessage* sm )
+{
+    auto it = values.find(sm->id);
+
+    if( it != values.end() )
+        it->second = sm->value;
+
+    count++;
+}
+// --------------------------------------------------------------------------
+namespace benv
+{
+    std::shared_ptr<SharedMemory> shm()
+    {
+        return g_shm;
+    }
+
+    std::shared_ptr<SMInterface> smi()
+    {
+        return g_smi;
+    }
+
+    std::shared_ptr<UInterface> ui()
+    {
+        return g_ui;
+    }
+
+    const std::vector<ObjectId>& sensors()
+    {
+        return g_sensors;
+    }
+
+    const std::vector<std::shared_ptr<BenchConsumer>>& consumers()
+    {
+        return g_consumers;
+    }
+}
+// --------------------------------------------------------------------------
+int main( int argc, const char** argv )
+{
+    try
+    {
+        if( argc > 1 && ( strcmp(argv[1], "--help") == 0 || strcmp(argv[1], "-h") == 0 ) )
+        {
+            cout << "--confile    - Использовать указанный конф. файл. По умолчанию bench.xml" << endl;
+            ubench::help_print();
+            cout << endl;
+            SharedMemory::help_print(argc, argv);
+            return 0;
+        }
+
+        // только список (без запуска SharedMemory)
+        if( findArgParam("--bench-list", argc, argv) != -1 )
+            return ubench::runBenchmarks(argc, argv);
+
+        auto conf = uniset_init(argc, argv, "bench.xml");
+
+        for( size_t i = 1; i <= maxSensors; i++ )
+        {
+            const ObjectId sid = conf->getSensorID("BenchAI" + std::to_string(i) + "_S");
+
+            if( sid == DefaultObjectId )
+                break;
+
+            g_sensors.push_back(sid);
+        }
+
+        if( g_sensors.empty() )
+        {
+            cerr << "(uniset2-bench): not found sensors 'BenchAI1_S'... in " << conf->getConfFileName() << endl;
+            return 1;
+        }
+
+        g_shm = SharedMemory::init_smemory(argc, argv);
+
+        if( !g_shm )
+            return 1;
+
+        g_ui = make_shared<UInterface>();
+        g_smi = make_shared<SMInterface>(g_shm->getId(), g_ui, DefaultObjectId, g_shm);
+
+        auto act = UniSetActivator::Instance();
+        act->add(g_shm);
+
+        // получатель k заказывает датчики BenchFanoutN_S для всех N >= k
+        for( size_t k = 1; k <= maxConsumers; k++ )
+        {
+            const ObjectId cid = conf->getObjectID("BenchConsumer" + std::to_string(k));
+
+            if( cid == DefaultObjectId )
+                break;
+
+            std::vector<ObjectId> slist;
+
+            for( size_t n = k; n <= maxConsumers; n++ )
+            {
+                const ObjectId sid = conf->getSensorID("BenchFanout" + std::to_string(n) + "_S");
+
+                if( sid != DefaultObjectId )
+                    slist.push_back(sid);
+            }
+
+            auto c = make_shared<BenchConsumer>(cid, slist);
+            act->add(c);
+            g_consumers.push_back(c);
+        }
+
+        SystemMessage sm(SystemMessage::StartUp);
+        act->broadcast( sm.transport_msg() );
+        act->run(true);
+
+        int tout = 10000;
+        PassiveTimer pt(tout);
+
+        while( !pt.checkTime() && !act->exist() )
+            msleep(100);
+
+        if( !act->exist() )
+        {
+            cerr << "(uniset2-bench): SharedMemory not exist! (timeout=" << tout << ")" << endl;
+            return 1;
+        }
+
+        for( auto&& c : g_consumers )
+            c->askSensors(UniversalIO::UIONotify);
+
+        int ret = ubench::runBenchmarks(argc, argv);
+
+        for( auto&& c : g_consumers )
+            c->askSensors(UniversalIO::UIODontNotify);
+
+        act->terminate();
+        return ret;
+    }
+    catch( const uniset::SystemError& err )
+    {
+        cerr << "(uniset2-bench): " << err << endl;
+    }
+    catch( const uniset::Exception& ex )
+    {
+        cerr << "(uniset2-bench): " << ex << endl;
+    }
+    catch( const std::exception& e )
+    {
+        cerr << "(uniset2-bench): " << e.what() << endl;
+    }
+    catch(...)
+    {
+        cerr << "(uniset2-bench): catch(...)" << endl;
+    }
+
+    return 1;
+}
+// --------------------------------------------------------------------------
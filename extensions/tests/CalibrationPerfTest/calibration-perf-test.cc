@@ -0,0 +1,107 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <memory>
+#include <unistd.h>
+#include "UniSetTypes.h"
+#include "UniXML.h"
+#include "Calibration.h"
+// --------------------------------------------------------------------------
+using namespace std;
+using namespace uniset;
+// --------------------------------------------------------------------------
+// Скорость получения значения по калибровочной диаграмме (Calibration::getValue)
+// с кэшем (по умолчанию), без кэша и с таблицей (Calibration::buildLookupTable).
+// Входные данные: случайные значения по всему диапазону ("вибрация")
+// и медленно меняющиеся значения (обычный аналоговый датчик).
+// --------------------------------------------------------------------------
+static double run( Calibration* cal, const std::vector<long>& data, long& chk )
+{
+    auto t0 = std::chrono::steady_clock::now();
+
+    for( const auto& v : data )
+        chk += cal->getValue(v, true);
+
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / data.size();
+}
+// --------------------------------------------------------------------------
+int main( int argc, const char** argv )
+{
+    const size_t count = std::max(uniset::getArgPInt("--count", argc, argv, "", 1000000), 1);
+    const int points = std::max(uniset::getArgPInt("--points", argc, argv, "", 50), 2);
+    const int range = std::max(uniset::getArgPInt("--range", argc, argv, "", 100000), points);
+    const size_t tsize = std::max(uniset::getArgPInt("--table-size", argc, argv, "", 4096), 1);
+
+    // диаграмма (монотонно возрастающая по 'x')
+    const std::string confile = "calibration-perf-test." + std::to_string(getpid()) + ".xml";
+    std::mt19937 gen(1);
+
+    {
+        ofstream f(confile);
+        f << "<?xml version=\"1.0\" encoding=\"utf-8\"?>" << endl
+          << "<Calibrations>" << endl
+          << "<diagram name=\"perf\">" << endl;
+
+        long y = 0;
+
+        for( int i = 0; i < points; i++ )
+        {
+            y += (long)(gen() % 200) - 50;
+            f << "<point x=\"" << ((long)i * range / (points - 1)) << "\" y=\"" << y << "\"/>" << endl;
+        }
+
+        f << "</diagram>" << endl
+          << "</Calibrations>" << endl;
+    }
+
+    std::unique_ptr<Calibration> cache(new Calibration("perf", confile));
+    std::unique_ptr<Calibration> nocache(new Calibration("perf", confile));
+    std::unique_ptr<Calibration> values(new Calibration("perf", confile));
+    std::unique_ptr<Calibration> segments(new Calibration("perf", confile));
+    unlink(confile.c_str());
+
+    nocache->setCacheSize(0);
+    values->buildLookupTable(range + 1);
+    segments->buildLookupTable(tsize);
+
+    std::vector<long> rnd(count);
+
+    for( auto&& d : rnd )
+        d = gen() % (range + 1);
+
+    std::vector<long> slow(count);
+    long v = range / 2;
+
+    for( auto&& d : slow )
+    {
+        v += (long)(gen() % 5) - 2;
+        v = std::max(0L, std::min(v, (long)range));
+        d = v;
+    }
+
+    long chk = 0;
+
+    cout << "count=" << count << " points=" << points << " range=" << range
+         << " table-size=" << tsize << " (nsec per value)" << endl;
+    cout << setw(10) << "input" << setw(12) << "cache" << setw(12) << "nocache"
+         << setw(12) << "values" << setw(12) << "segments" << endl;
+
+    for( auto&& d : { std::make_pair("random", &rnd), std::make_pair("slow", &slow) } )
+    {
+        const double tc = run(cache.get(), *d.second, chk);
+        const double tn = run(nocache.get(), *d.second, chk);
+        const double tv = run(values.get(), *d.second, chk);
+        const double ts = run(segments.get(), *d.second, chk);
+
+        cout << setw(10) << d.first << setw(12) << tc << setw(12) << tn
+             << setw(12) << tv << setw(12) << ts << endl;
+    }
+
+    // чтобы компилятор не выкинул вычисления
+    return ( chk == 1 ) ? 1 : 0;
+}
+// --------------------------------------------------------------------------
@@ -0,0 +1,76 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <functional>
+#include "UniSetTypes.h"
+#include "DigitalFilter.h"
+// --------------------------------------------------------------------------
+using namespace std;
+using namespace uniset;
+// --------------------------------------------------------------------------
+// Скорость работы фильтров DigitalFilter (время обработки одного значения)
+// для разных размеров буфера. Используется для оценки нагрузки
+// от фильтрации в IOControl (сотни каналов, опрос раз в 10 мсек).
+// --------------------------------------------------------------------------
+static double run( const std::vector<int>& data, const std::function<int(int)>& f, long& chk )
+{
+    auto t0 = std::chrono::steady_clock::now();
+
+    for( const auto& v : data )
+        chk += f(v);
+
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / data.size();
+}
+// --------------------------------------------------------------------------
+int main( int argc, const char** argv )
+{
+    const size_t count = std::max(uniset::getArgPInt("--count", argc, argv, "", 1000000), 1);
+    const int range = std::max(uniset::getArgPInt("--range", argc, argv, "", 1000), 1);
+
+    std::mt19937 gen(1);
+    std::vector<int> data(count);
+
+    for( auto&& d : data )
+        d = (int)(gen() % (2 * range)) - range;
+
+    long chk = 0;
+
+    cout << "count=" << count << " (nsec per value)" << endl;
+    cout << setw(6) << "size" << setw(12) << "median" << setw(12) << "filter1"
+         << setw(12) << "leastsqr" << setw(12) << "IIR" << endl;
+
+    for( unsigned int sz : { 5, 15, 31, 63 } )
+    {
+        DigitalFilter df(sz, 0, 0.2, range);
+
+        const double tm = run(data, [&df]( int v )
+        {
+            return df.median(v);
+        }, chk);
+
+        const double tf = run(data, [&df]( int v )
+        {
+            return df.filter1(v);
+        }, chk);
+
+        const double tl = run(data, [&df]( int v )
+        {
+            return df.leastsqr(v);
+        }, chk);
+
+        const double ti = run(data, [&df]( int v )
+        {
+            return df.filterIIR(v);
+        }, chk);
+
+        cout << setw(6) << sz << setw(12) << tm << setw(12) << tf
+             << setw(12) << tl << setw(12) << ti << endl;
+    }
+
+    // чтобы компилятор не выкинул вычисления
+    return ( chk == 1 ) ? 1 : 0;
+}
+// --------------------------------------------------------------------------
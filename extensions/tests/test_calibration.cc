@@ -65,3 +65,55 @@ TEST_CASE("Calibration", "[calibration]")
 
     delete cal;
 }
+
+TEST_CASE("Calibration: lookup table", "[calibration][lookup]")
+{
+    Calibration* ref = buildCalibrationDiagram("testcal");
+    CHECK( ref != 0 );
+    ref->setCacheSize(0);
+
+    Calibration* cal = buildCalibrationDiagram("testcal");
+    CHECK( cal != 0 );
+    CHECK_FALSE( cal->isLookupTable() );
+
+    SECTION("values")
+    {
+        // таблица значений для всего диапазона
+        REQUIRE( cal->buildLookupTable() );
+        REQUIRE( cal->isLookupTable() );
+
+        for( long raw = cal->getLeftRaw() - 10; raw <= cal->getRightRaw() + 10; raw++ )
+        {
+            REQUIRE( cal->getValue(raw, false) == ref->getValue(raw, false) );
+            REQUIRE( cal->getValue(raw, true) == ref->getValue(raw, true) );
+        }
+    }
+
+    SECTION("segments")
+    {
+        // таблица номеров участков (диапазон больше размера таблицы)
+        for( size_t sz : { 1, 7, 64, 1000 } )
+        {
+            REQUIRE( cal->buildLookupTable(sz) );
+            REQUIRE( cal->isLookupTable() );
+
+            for( long raw = cal->getLeftRaw() - 10; raw <= cal->getRightRaw() + 10; raw++ )
+            {
+                REQUIRE( cal->getValue(raw, false) == ref->getValue(raw, false) );
+                REQUIRE( cal->getValue(raw, true) == ref->getValue(raw, true) );
+            }
+        }
+    }
+
+    SECTION("clear")
+    {
+        REQUIRE( cal->buildLookupTable() );
+        cal->clearLookupTable();
+        REQUIRE_FALSE( cal->isLookupTable() );
+        REQUIRE( cal->getValue(933) == 466 );
+        REQUIRE_FALSE( cal->buildLookupTable(0) );
+    }
+
+    delete cal;
+    delete ref;
+}
@@ -1,5 +1,8 @@
 #include <catch.hpp>
 // -----------------------------------------------------------------------------
+#include <deque>
+#include <random>
+#include <algorithm>
 #include "Exceptions.h"
 #include "Extensions.h"
 #include "DigitalFilter.h"
@@ -96,3 +99,178 @@ TEST_CASE("[DigitalFilter]: filterRC", "[DigitalFilter][filterRC]")
     REQUIRE( df1.currentRC() == 10 );
     REQUIRE( df10.currentRC() == 10 );
 }
+// -----------------------------------------------------------------------------
+// "Эталонная" реализация фильтров (прямое вычисление по всему буферу, как было до
+// перехода на кольцевой буфер и инкрементальные вычисления).
+// Результаты DigitalFilter должны совпадать с ней в точности.
+class RefFilter
+{
+    public:
+        RefFilter( size_t sz, double lsq, int thr, double cp, double cn ):
+            lsparam(lsq), thr(thr), cprev(cp), cnew(cn)
+        {
+            init(sz, 0);
+        }
+
+        void init( size_t sz, int v )
+        {
+            buf.assign(sz, v);
+            w.assign(sz, 1.0 / sz);
+        }
+
+        void add( int v )
+        {
+            buf.pop_front();
+            buf.push_back(v);
+        }
+
+        int median( int v )
+        {
+            add(v);
+            std::vector<int> m(buf.begin(), buf.end());
+            std::sort(m.begin(), m.end());
+            return m[buf.size() / 2];
+        }
+
+        int filter1( int v )
+        {
+            add(v);
+            double M = 0;
+
+            for( const auto& i : buf )
+                M = M + i;
+
+            M = M / buf.size();
+
+            double S = 0;
+
+            for( const auto& i : buf )
+                S = S + (M - i) * (M - i);
+
+            S = sqrt(S / buf.size());
+
+            if( S == 0 )
+                return lroundf(M);
+
+            int n = 0;
+            double val = 0;
+
+            for( const auto& i : buf )
+            {
+                if( fabs(M - i) < S * 2 )
+                {
+                    val += i;
+                    n++;
+                }
+            }
+
+            return lroundf( n == 0 ? M : val / n );
+        }
+
+        int leastsqr( int v )
+        {
+            double ls = 0;
+            add(v);
+
+            for( size_t i = 0; i < buf.size(); i++ )
+                ls += buf[i] * w[i];
+
+            double u = 2 * (lsparam / buf.size()) * (v - ls);
+
+            for( size_t i = 0; i < buf.size(); i++ )
+                w[i] = w[i] + buf[i] * u;
+
+            return lroundf(ls);
+        }
+
+        int filterIIR( int v )
+        {
+            if( v > prev + thr || v < prev - thr )
+            {
+                init(buf.size(), v);
+                prev = v;
+                return prev;
+            }
+
+            double aver = 0;
+            add(v);
+
+            for( const auto& i : buf )
+                aver += i;
+
+            aver /= buf.size();
+            prev = lroundf((cprev * prev + cnew * aver) / (cprev + cnew));
+            return prev;
+        }
+
+    private:
+        std::deque<int> buf;
+        std::vector<double> w;
+        double lsparam;
+        int thr;
+        int prev = { 0 };
+        double cprev;
+        double cnew;
+};
+// -----------------------------------------------------------------------------
+TEST_CASE("[DigitalFilter]: compare with reference", "[DigitalFilter][median][filter1][leastsqr][iir]")
+{
+    std::mt19937 gen(1);
+
+    for( int t = 0; t < 200; t++ )
+    {
+        const unsigned int sz = 1 + gen() % 40;
+        const double lsq = (gen() % 10) / 10.0 + 0.05;
+        const int thr = 1 + gen() % 300;
+        const double cp = (gen() % 50) / 10.0 + 0.1;
+        const double cn = (gen() % 50) / 10.0 + 0.1;
+        const int range = ( gen() % 3 == 0 ) ? 1000000 : 200;
+
+        DigitalFilter df(sz, 0, lsq, thr, cp, cn);
+        RefFilter ref(sz, lsq, thr, cp, cn);
+
+        const int mode = t % 4;
+
+        for( int i = 0; i < 300; i++ )
+        {
+            const int v = (int)(gen() % (2 * range)) - range;
+
+            if( mode == 0 )
+            {
+                const int m = df.median(v);
+                REQUIRE( m == ref.median(v) );
+                REQUIRE( df.currentMedian() == m );
+            }
+            else if( mode == 1 )
+                REQUIRE( df.filter1(v) == ref.filter1(v) );
+            else if( mode == 2 )
+                REQUIRE( df.leastsqr(v) == ref.leastsqr(v) );
+            else
+                REQUIRE( df.filterIIR(v) == ref.filterIIR(v) );
+        }
+    }
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("[DigitalFilter]: median after add", "[DigitalFilter][median]")
+{
+    DigitalFilter df(5);
+
+    for( int i = 0; i < 5; i++ )
+        df.median(i * 10);
+
+    REQUIRE( df.currentMedian() == 20 );
+
+    // значения добавленные через add() тоже учитываются
+    for( int i = 0; i < 5; i++ )
+        df.add(100 + i);
+
+    REQUIRE( df.currentMedian() == 102 );
+    REQUIRE( df.median(1) == 102 );
+
+    // после смены размера буфера
+    df.setSettings(3, 0, 0.2, 10000, 0.5, 0.5);
+    REQUIRE( df.size() == 3 );
+    REQUIRE( df.currentMedian() == 103 );
+    REQUIRE( df.median(0) == 1 );
+}
+// -----------------------------------------------------------------------------
@@ -0,0 +1,269 @@
+#include <catch.hpp>
+// -----------------------------------------------------------------------------
+#include <memory>
+#include <random>
+#include <vector>
+#include "Exceptions.h"
+#include "Extensions.h"
+#include "tests_with_sm.h"
+#include "IOBase.h"
+#include "IOBlock.h"
+// -----------------------------------------------------------------------------
+using namespace std;
+using namespace uniset;
+using namespace uniset::extensions;
+// -----------------------------------------------------------------------------
+static std::shared_ptr<SMInterface> shm;
+static void init_test()
+{
+    shm = smiInstance();
+    CHECK( shm != nullptr );
+}
+// -----------------------------------------------------------------------------
+// случайные параметры обработки (одинаковые для одинаковых генераторов)
+static void init_random_item( IOBase& b, std::mt19937& gen, ObjectId sid )
+{
+    shm->initIterator(b.ioit);
+    b.si.id = sid;
+    b.stype = UniversalIO::AI;
+
+    if( gen() % 2 )
+    {
+        b.cal.minRaw = (long)(gen() % 2000) - 1000;
+        b.cal.maxRaw = b.cal.minRaw + (long)(gen() % 4000) - 1000;
+        b.cal.minCal = (long)(gen() % 20000) - 10000;
+        b.cal.maxCal = (long)(gen() % 20000) - 10000;
+    }
+
+    b.cal.precision = (int)(gen() % 7) - 3;
+    b.noprecision = ( gen() % 4 == 0 );
+    b.calcrop = ( gen() % 3 != 0 );
+    b.breaklim = ( gen() % 5 == 0 ) ? (long)(gen() % 300) : 0;
+    b.nofilter = ( gen() % 6 == 0 );
+
+    const int fsize = 1 + gen() % 8;
+    const int kind = gen() % 7;
+
+    if( kind == 0 ) // без фильтра
+        return;
+
+    if( kind == 1 ) // RC-фильтр с T=0
+    {
+        b.df.setSettings(fsize, 0, 0.2, 0, 0.5, 0.5);
+        b.df.init(0);
+        return;
+    }
+
+    if( kind == 2 ) // медианный (обрабатывается через processingAsAI)
+    {
+        b.f_median = true;
+        b.df.setSettings(fsize, 0, 0.2, 0, 0.5, 0.5);
+        b.df.init(0);
+        return;
+    }
+
+    b.f_filter_iir = true;
+    const double cprev = (gen() % 100) / 10.0 + 0.1;
+    const double cnew = (gen() % 100) / 10.0 + 0.1;
+    b.df.setSettings(fsize, 0, 0.2, 1 + gen() % 500, cprev, cnew);
+    b.df.init( (int)(gen() % 100) );
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("[IOBlock]: isBlockable", "[iobase][ioblock][extensions]")
+{
+    CHECK( uniset_conf() != nullptr );
+
+    IOBase ib;
+    ib.stype = UniversalIO::AI;
+    CHECK( IOBlock::isBlockable(&ib) );
+
+    ib.df.setSettings(5, 0, 0.2, 100, 0.5, 0.5);
+    ib.f_filter_iir = true;
+    CHECK( IOBlock::isBlockable(&ib) );
+
+    ib.f_filter_iir = false;
+    CHECK( IOBlock::isBlockable(&ib) ); // RC-фильтр отключён (T=0)
+
+    ib.df.setSettings(5, 100, 0.2, 100, 0.5, 0.5);
+    CHECK_FALSE( IOBlock::isBlockable(&ib) ); // RC-фильтр
+
+    ib.f_median = true;
+    CHECK_FALSE( IOBlock::isBlockable(&ib) );
+
+    ib.nofilter = true;
+    CHECK( IOBlock::isBlockable(&ib) );
+
+    ib.rawdata = true;
+    CHECK_FALSE( IOBlock::isBlockable(&ib) );
+
+    ib.rawdata = false;
+    ib.stype = UniversalIO::DI;
+    CHECK_FALSE( IOBlock::isBlockable(&ib) );
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("[IOBlock]: compare with processingAsAI", "[iobase][ioblock][extensions]")
+{
+    CHECK( uniset_conf() != nullptr );
+    auto conf = uniset_conf();
+
+    init_test();
+
+    ObjectId sid = conf->getSensorID("CalibrationTest_AI1_AS");
+    REQUIRE( sid != DefaultObjectId );
+
+    const size_t num = 500;
+    std::vector<IOBase> ref(num);
+    std::vector<IOBase> blk(num);
+    std::vector<size_t> idx(num);
+    std::mt19937 gen1(7);
+    std::mt19937 gen2(7);
+    IOBlock block;
+
+    for( size_t i = 0; i < num; i++ )
+    {
+        init_random_item(ref[i], gen1, sid);
+        init_random_item(blk[i], gen2, sid);
+        idx[i] = block.add(&blk[i]);
+    }
+
+    REQUIRE( block.size() == num );
+    REQUIRE( block.blockSize() > 0 );
+    REQUIRE( block.fallbackSize() > 0 );
+
+    std::mt19937 rgen(11);
+
+    for( size_t step = 0; step < 200; step++ )
+    {
+        const bool force = ( step % 50 == 0 );
+
+        for( size_t i = 0; i < num; i++ )
+        {
+            const int m = rgen() % 10;
+            const long raw = ( m == 0 ) ? (long)(int32_t)rgen() * 3 : ( m < 3 ? (long)(rgen() % 2000) - 1000 : (long)(rgen() % 600) );
+
+            IOBase::processingAsAI(&ref[i], raw, shm, force);
+            block.setRaw(idx[i], raw);
+        }
+
+        block.process(shm, force);
+
+        for( size_t i = 0; i < num; i++ )
+            REQUIRE( blk[i].value == ref[i].value );
+    }
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("[IOBlock]: filter state (processingAsAI and back)", "[iobase][ioblock][extensions]")
+{
+    CHECK( uniset_conf() != nullptr );
+    auto conf = uniset_conf();
+
+    init_test();
+
+    ObjectId sid = conf->getSensorID("CalibrationTest_AI1_AS");
+    REQUIRE( sid != DefaultObjectId );
+
+    const size_t num = 100;
+    std::vector<IOBase> ref(num);
+    std::vector<IOBase> blk(num);
+    std::vector<size_t> idx(num);
+    std::mt19937 gen1(3);
+    std::mt19937 gen2(3);
+    IOBlock block;
+
+    for( size_t i = 0; i < num; i++ )
+    {
+        init_random_item(ref[i], gen1, sid);
+        init_random_item(blk[i], gen2, sid);
+        idx[i] = block.add(&blk[i]);
+    }
+
+    REQUIRE( block.blockSize() > 0 );
+
+    std::mt19937 rgen(5);
+
+    // пакетно -> по одному (как в тестовом режиме IOControl) -> снова пакетно
+    for( size_t step = 0; step < 150; step++ )
+    {
+        const bool single = ( step >= 50 && step < 100 );
+
+        if( step == 50 )
+            block.saveFilters();
+        else if( step == 100 )
+            block.loadFilters();
+
+        for( size_t i = 0; i < num; i++ )
+        {
+            const long raw = (long)(rgen() % 600);
+
+            IOBase::processingAsAI(&ref[i], raw, shm, false);
+
+            if( single )
+                IOBase::processingAsAI(&blk[i], raw, shm, false);
+            else
+                block.setRaw(idx[i], raw);
+        }
+
+        if( !single )
+            block.process(shm, false);
+
+        for( size_t i = 0; i < num; i++ )
+            REQUIRE( blk[i].value == ref[i].value );
+    }
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("[IOBlock]: thresholds", "[iobase][ioblock][threshold][extensions]")
+{
+    CHECK( uniset_conf() != nullptr );
+    auto conf = uniset_conf();
+
+    init_test();
+
+    ObjectId ai = conf->getSensorID("AI64_AS");
+    REQUIRE( ai != DefaultObjectId );
+
+    ObjectId di = conf->getSensorID("D65_S");
+    REQUIRE( di != DefaultObjectId );
+
+    const size_t num = 50;
+    std::vector<IOBase> ref(num);
+    std::vector<IOBase> blk(num);
+    std::mt19937 gen(3);
+    IOBlock block;
+
+    for( size_t i = 0; i < num; i++ )
+    {
+        const long lo = gen() % 100;
+        const long hi = gen() % 100;
+        const bool inv = gen() % 2;
+
+        for( auto* b : { &ref[i], &blk[i] } )
+        {
+            shm->initIterator(b->ioit);
+            shm->initIterator(b->t_ait);
+            b->si.id = di;
+            b->stype = UniversalIO::DI;
+            b->t_ai = ai;
+            b->ti.lowlimit = lo;
+            b->ti.hilimit = hi;
+            b->ti.invert = inv;
+        }
+
+        block.addThreshold(&blk[i]);
+    }
+
+    REQUIRE( block.thresholds() == num );
+
+    for( size_t step = 0; step < 200; step++ )
+    {
+        shm->setValue(ai, (long)(gen() % 120) - 10);
+
+        for( auto&& r : ref )
+            IOBase::processingThreshold(&r, shm, false);
+
+        block.processThresholds(shm, false);
+
+        for( size_t i = 0; i < num; i++ )
+            REQUIRE( blk[i].value == ref[i].value );
+    }
+}
+// -----------------------------------------------------------------------------
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2025 Pavel Vainerman.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, version 2.1.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+// --------------------------------------------------------------------------
+#ifndef CRC16_H_
+#define CRC16_H_
+// --------------------------------------------------------------------------
+#include <cstdint>
+#include <cstddef>
+#include <string>
+// --------------------------------------------------------------------------
+namespace uniset
+{
+    /*! Расчёт CRC-16 (полином x^16 + x^15 + x^2 + 1, "отражённый" 0xA001, как в Modbus RTU).
+     * Используется Modbus RTU (ModbusRTU::checkCRC) и UNetUDP (UniSetUDP::makeCRC).
+     *
+     * Есть несколько реализаций:
+     * - Bitwise - побитовый расчёт (эталон, медленно)
+     * - Table   - классическая таблица на 256 значений (байт за шаг)
+     * - Slice8  - slicing-by-8 (8 байт за шаг)
+     * - Slice16 - slicing-by-16 (16 байт за шаг)
+     * - CLMUL   - "свёртка" блоков по 64 байта при помощи PCLMULQDQ (только x86, если поддерживается процессором)
+     *
+     * Реализация по умолчанию выбирается один раз при запуске (по возможностям процессора),
+     * для буферов короче 8 байт всегда используется Table.
+     *
+     * Расчёт можно вести по частям: для продолжения передаётся результат предыдущего вызова
+     * \code
+     *    uint16_t crc = CRC16::calc(buf1, len1);
+     *    crc = CRC16::calc(buf2, len2, crc);
+     * \endcode
+     */
+    namespace CRC16
+    {
+        const uint16_t initValue = 0xffff;
+
+        enum class Impl
+        {
+            Bitwise,
+            Table,
+            Slice8,
+            Slice16,
+            CLMUL
+        };
+
+        /*! расчёт CRC выбранной по умолчанию (самой быстрой) реализацией */
+        uint16_t calc( const void* buf, size_t len, uint16_t crc = initValue ) noexcept;
+
+        /*! расчёт CRC заданной реализацией (для тестов и замеров).
+         * Если реализация не поддерживается, используется Slice16.
+         */
+        uint16_t calc( Impl impl, const void* buf, size_t len, uint16_t crc = initValue ) noexcept;
+
+        bool isSupported( Impl impl ) noexcept;
+        Impl defaultImpl() noexcept;
+        std::string implName( Impl impl );
+    }
+    // --------------------------------------------------------------------------
+} // end of namespace uniset
+// --------------------------------------------------------------------------
+#endif // CRC16_H_
+// --------------------------------------------------------------------------
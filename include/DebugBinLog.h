@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2025 Pavel Vainerman.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, version 2.1.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+// -------------------------------------------------------------------------
+#ifndef DebugBinLog_H_
+#define DebugBinLog_H_
+// -------------------------------------------------------------------------
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <ostream>
+#include <type_traits>
+#include "Debug.h"
+// -------------------------------------------------------------------------
+class DebugStream;
+// -------------------------------------------------------------------------
+namespace uniset
+{
+    /*! "Отложенный" (бинарный) вывод логов DebugStream.
+
+        В потоке, который пишет лог, не выполняется форматирование: в буфер потока (свой у каждого потока,
+        без блокировок) записывается время, указатель на строку формата (она же "идентификатор" записи,
+        поэтому это должна быть строковая константа) и значения аргументов "как есть".
+        Превращение в текст (дата/время, подстановка аргументов) выполняется отдельным фоновым потоком,
+        который затем пишет готовую строку в DebugStream, т.е. в файл, на экран и всем подписчикам
+        (LogServer, LogDB и т.п.) как обычно.
+
+        Используется через DebugStream::blog() или макрос ublog():
+        \code
+            mylog->binaryMode(true);
+            ...
+            ublog(mylog, LEVEL3, "(step): sensor {} value={}", sid, value);
+        \endcode
+        В строке формата каждое "{}" заменяется очередным аргументом.
+        Поддерживаются целые, вещественные, bool, char, перечисления, указатели, строки (const char*, std::string).
+        Строки копируются в буфер.
+
+        Если буфер потока переполнен (фоновый поток не успевает), запись отбрасывается,
+        а в лог выводится сообщение о количестве потерянных записей.
+
+        Записи ссылаются на лог не указателем, а идентификатором (attach()). Деструктор DebugStream
+        сперва выводит уже записанное (flush()), затем снимает регистрацию (detach()) - записи,
+        сделанные позже (другими потоками), отбрасываются фоновым потоком.
+        UniSetActivator при завершении (shutdown) также вызывает flush().
+
+        Обычный вывод (mylog3 << ...) продолжает работать как раньше и может использоваться одновременно.
+        Порядок строк, выведенных разными способами (и разными потоками), при этом не гарантируется.
+    */
+    namespace BinLog
+    {
+        enum class Tag : uint8_t
+        {
+            None,
+            Int,
+            UInt,
+            Double,
+            Bool,
+            Char,
+            Ptr,
+            Str
+        };
+
+        //! значение аргумента
+        struct Value
+        {
+            Tag tag = { Tag::None };
+
+            union
+            {
+                int64_t i;
+                uint64_t u;
+                double d;
+                const void* p;
+            };
+
+            const char* s = { nullptr };
+            size_t len = { 0 };
+
+            Value() noexcept: i(0) {}
+            Value( bool v ) noexcept: tag(Tag::Bool), u(v) {}
+            Value( char v ) noexcept: tag(Tag::Char), i(v) {}
+            Value( const char* v ) noexcept: tag(Tag::Str), i(0), s(v ? v : "(null)"), len(std::strlen(s)) {}
+            Value( const std::string& v ) noexcept: tag(Tag::Str), i(0), s(v.data()), len(v.size()) {}
+
+            template<typename T, typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value, int>::type = 0>
+            Value( T v ) noexcept: tag(Tag::Int), i(v) {}
+
+            template<typename T, typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value, int>::type = 0>
+            Value( T v ) noexcept: tag(Tag::UInt), u(v) {}
+
+            template<typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+            Value( T v ) noexcept: tag(Tag::Double), d(v) {}
+
+            template<typename T, typename std::enable_if<std::is_enum<T>::value, int>::type = 0>
+            Value( T v ) noexcept: tag(Tag::Int), i(static_cast<int64_t>(v)) {}
+
+            template<typename T>
+            Value( const T* v ) noexcept: tag(Tag::Ptr), p(v) {}
+        };
+
+        /*! зарегистрировать лог для вывода фоновым потоком
+         * \return идентификатор лога для write() (0 - ошибка)
+         */
+        uint64_t attach( DebugStream* log ) noexcept;
+
+        /*! снять регистрацию (вызывается при удалении лога, после flush()).
+         * Если фоновый поток в этот момент выводит запись в этот лог, функция дожидается окончания вывода.
+         * Оставшиеся в буферах записи для этого лога отбрасываются.
+         */
+        void detach( uint64_t logId ) noexcept;
+
+        /*! записать в буфер потока (для вывода фоновым потоком)
+         * \return false - запись потеряна (буфер переполнен)
+         */
+        bool write( uint64_t logId, Debug::type t, const char* fmt, const Value* vals, size_t num ) noexcept;
+
+        //! сразу вывести в поток (подстановка аргументов в fmt)
+        void format( std::ostream& os, const char* fmt, const Value* vals, size_t num );
+
+        //! дождаться вывода всех записанных к этому моменту записей (не больше msec)
+        bool flush( size_t msec = 2000 ) noexcept;
+
+        /*! размер буфера для каждого потока (байт).
+         * Действует для потоков, которые ещё не писали в лог.
+         */
+        void setThreadBufferSize( size_t sz ) noexcept;
+
+        //! период опроса буферов фоновым потоком
+        void setPollTime( size_t msec ) noexcept;
+
+        // статистика
+        size_t lostRecords() noexcept;
+        size_t writtenRecords() noexcept;
+        size_t discardedRecords() noexcept; // записи для уже удалённых логов
+    }
+    // -------------------------------------------------------------------------
+} // end of uniset namespace
+// -------------------------------------------------------------------------
+// вывод через DebugStream::blog() только если уровень включён
+// (аргументы в этом случае даже не вычисляются)
+// формат обязательно строковая константа ("" fmt не даст передать переменную)
+#define ublog(log, level, fmt, ...) \
+    do { if( (log)->debugging(Debug::level) ) (log)->blog(Debug::level, "" fmt, ##__VA_ARGS__); } while(0)
+// -------------------------------------------------------------------------
+#endif // DebugBinLog_H_
+// -------------------------------------------------------------------------
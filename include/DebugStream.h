@@ -17,9 +17,11 @@
 
 #include <iostream>
 #include <string>
+#include <ctime>
 #include <sigc++/sigc++.h>
 #include <vector>
 #include "Debug.h"
+#include "DebugBinLog.h"
 
 /** DebugStream is a ostream intended for debug output.
     It has also support for a logfile. Debug output is output to cerr
@@ -57,6 +59,11 @@
     debug.debug(Debug::type(Debug::INFO | Debug::CRIT)) << "...info/crit...\n";
     debug[Debug::type(Debug::INFO | Debug::CRIT)] << "...info/crit...\n";
 
+    Low-overhead output (see DebugBinLog.h): the format and the arguments are
+    stored "as is" and rendered to text later, in a background thread:
+    debug.binaryMode(true);
+    ublog(debug, INFO, "sensor {} value={}", id, value);
+
 */
 class DebugStream : public std::ostream
 {
@@ -148,6 +155,11 @@ class DebugStream : public std::ostream
         */
         std::ostream& debug(Debug::type t = Debug::ANY) noexcept;
 
+        /** The same as debug(t), but the date and time are taken from tm
+            (used for deferred output, see DebugBinLog.h)
+        */
+        std::ostream& debug(Debug::type t, const timespec& tm) noexcept;
+
         /** This is an operator to give a more convenient use:
             dbgstream[Debug::INFO] << "Info!\n";
             Вывод осуществляется с датой и временем (если они не отключены)
@@ -225,6 +237,42 @@ class DebugStream : public std::ostream
         // example: dlog.V(1)[Debug::INFO] << "some log.." << endl;
         DebugStream& V( Debug::verbosity v ) noexcept;
 
+        // -----------------------------------------------------
+        // "отложенный" (бинарный) вывод (см. DebugBinLog.h)
+        // В binaryMode blog() только сохраняет формат и аргументы в буфер потока,
+        // а в текст они превращаются фоновым потоком. Иначе blog() выводит строку сразу.
+        void binaryMode( bool s ) noexcept;
+
+        inline bool isBinaryMode() const noexcept
+        {
+            return binmode;
+        }
+
+        // example: dlog.blog(Debug::INFO, "sensor {} value={}", id, value);
+        // (вывод строки целиком, endl не нужен)
+        template<typename... Args>
+        inline void blog( Debug::type t, const char* fmt, const Args& ... args ) noexcept
+        {
+            if( !(dt & t) || vv > verb )
+                return;
+
+            const uniset::BinLog::Value vals[] = { uniset::BinLog::Value(args)..., uniset::BinLog::Value() };
+
+            if( binmode )
+            {
+                uniset::BinLog::write(binId, t, fmt, vals, sizeof...(Args));
+                return;
+            }
+
+            try
+            {
+                std::ostream& os = debug(t);
+                uniset::BinLog::format(os, fmt, vals, sizeof...(Args));
+                os << std::endl;
+            }
+            catch(...) {}
+        }
+
         // labels
         typedef std::pair<std::string, std::string> Label;
 
@@ -271,6 +319,7 @@ class DebugStream : public std::ostream
         std::ostream& printDate(Debug::type t, char brk = '/') noexcept;
         std::ostream& printTime(Debug::type t, char brk = ':') noexcept;
         std::ostream& printDateTime(Debug::type t) noexcept;
+        std::ostream& printDateTime(Debug::type t, const timespec& tm) noexcept;
 
         std::ostream& pos(int x, int y) noexcept;
 
@@ -288,6 +337,7 @@ class DebugStream : public std::ostream
 
     protected:
         void sbuf_overflow( const std::string& s ) noexcept;
+        std::ostream& printHeader( Debug::type t, const timespec& tm ) noexcept;
 
         // private:
         /// The current debug level
@@ -317,6 +367,9 @@ class DebugStream : public std::ostream
         std::vector<Label> labels;
         bool show_labels = { true };
         bool hide_label_key = { false };
+
+        bool binmode = { false };
+        uint64_t binId = { 0 }; // идентификатор лога для BinLog (0 - не зарегистрирован)
 };
 
 // ------------------------------------------------------------------------------------------------
@@ -33,6 +33,12 @@ namespace uniset
             /*! считать список io */
             virtual IOController::IOStateList read() = 0;
 
+            /*! считать настройки фильтрации уведомлений для заказчиков (см. \ref sec_NC_Filter) */
+            virtual IONotifyController::ConsumerFilterMap readConsumerFilters()
+            {
+                return IONotifyController::ConsumerFilterMap();
+            }
+
             //          /*! записать текущий список io */
             //          virtual bool write( const IOController::IOStateList& iolist ) = 0;
     };
@@ -43,6 +43,11 @@ namespace uniset
             // реализация интерфейса IOConfig
             virtual IOController::IOStateList read() override;
 
+            /*! фильтры заказчиков из секций <consumers> датчиков
+             * (<consumer name=".." type=".." deadband=".." deadband_pct=".." min_interval=".."/>)
+             */
+            virtual IONotifyController::ConsumerFilterMap readConsumerFilters() override;
+
             // читать список датчиков
             static ACLInfoMap readACLInfo( const std::shared_ptr<Configuration>& conf, const std::shared_ptr<UniXML>& _xml );
 
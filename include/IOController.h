@@ -25,6 +25,9 @@
 #include <unordered_map>
 #include <list>
 #include <limits>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 #include <sigc++/sigc++.h>
 #include "IOController_i.hh"
 #include "UniSetTypes.h"
@@ -168,6 +171,23 @@ namespace uniset
                 return ioList.size();
             }
 
+            /*! Текущий номер изменения.
+             * Глобальный (в рамках объекта) монотонно возрастающий счётчик изменений датчиков.
+             * При каждом изменении значения (или признака undefined) датчику присваивается очередной номер
+             * (USensorInfo::changeSeq). Используется в HTTP API '/changes'.
+             * Номера присваиваются и при формировании списка датчиков (initIOList),
+             * поэтому 'since=0' всегда возвращает все датчики.
+             */
+            inline uint64_t getChangeSeq() const noexcept
+            {
+                return changeSeq.load();
+            }
+
+            /*! Ожидание изменений с номером больше seq.
+             * \return текущий номер изменения (если изменений не было, то seq)
+             */
+            uint64_t waitChanges( uint64_t seq, timeout_t msec );
+
         protected:
 
             // доступ к элементам через итератор
@@ -206,10 +226,19 @@ namespace uniset
             virtual Poco::JSON::Object::Ptr request_set( const std::string& req, const Poco::URI::QueryParameters& p );
             virtual Poco::JSON::Object::Ptr request_freeze( const std::string& req, const Poco::URI::QueryParameters& p, bool set );
             virtual Poco::JSON::Object::Ptr request_sensors( const std::string& req, const Poco::URI::QueryParameters& p );
+            virtual Poco::JSON::Object::Ptr request_changes( const UHttp::HttpRequestContext& ctx );
+            // добавить в jdata датчики из slist, изменившиеся после since. return количество добавленных
+            size_t getChanges( Poco::JSON::Array::Ptr& jdata, const std::vector<std::shared_ptr<USensorInfo>>& slist,
+                               uint64_t since, uniset::ObjectId consumer_id, bool shortInfo );
             void getSensorInfo( Poco::JSON::Array::Ptr& jdata, std::shared_ptr<USensorInfo>& s, uniset::ObjectId consumer_id, bool shortInfo = false );
             bool disabledHttpSetApi = { false }; /*!< отключить API "set", для невозможности устанавливать датчики через HTTP API */
             bool disabledHttpFreezeApi = { false }; /*!< отключить API "freeze/unfreeze", для невозможности управлять через HTTP API */
             bool disableHttpAccessControl = { false }; /*!< отключить проверку прав доступа для HTTP API */
+
+            // параметры '/changes'
+            size_t httpChangesMaxClients = { 10 }; /*!< максимальное количество одновременных long-poll/SSE клиентов */
+            timeout_t httpChangesMaxTimeout = { 60000 }; /*!< максимальное время ожидания изменений в режиме long-poll, мсек */
+            timeout_t httpChangesHeartbeat = { 15000 }; /*!< период посылки "пустого" сообщения в режиме SSE, мсек */
 #endif
 
             // переопределяем для добавления вызова регистрации датчиков
@@ -314,6 +343,15 @@ namespace uniset
 
             uniset::AccessMask defaultAccessMask = { uniset::AccessRW };
 
+            // поддержка '/changes'
+            void notifyChanges() noexcept;
+            std::atomic<uint64_t> changeSeq = { 0 };
+            std::mutex changesMutex;
+            std::condition_variable changesEvent;
+            std::atomic_size_t changesWaiters = { 0 };
+            std::atomic_size_t changesClients = { 0 };
+            std::atomic_bool changesStop = { false };
+
         public:
 
             struct UThresholdInfo;
@@ -366,6 +404,7 @@ namespace uniset
                 ThresholdExtList thresholds;
 
                 size_t nchanges = { 0 }; // количество изменений датчика
+                uint64_t changeSeq = { 0 }; // номер последнего изменения (см. IOController::getChangeSeq())
 
                 long undef_value = { not_specified_value }; // значение для "неопределённого состояния датчика"
                 long frozen_value = { 0 };
@@ -25,7 +25,12 @@
 #include <memory>
 #include <unordered_map>
 #include <list>
+#include <vector>
 #include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
 
 #include "UniSetTypes.h"
 #include "IOController_i.hh"
@@ -45,6 +50,7 @@ namespace uniset
         Задачи решаемые IONotifyController-ом (\b IONC):
         - \ref sec_NC_AskSensors
         - \ref sec_NC_Consumers
+        - \ref sec_NC_Filter
         - \ref sec_NC_Thresholds
         - \ref sec_NC_Depends
 
@@ -89,6 +95,35 @@ namespace uniset
     "Статический" способ заказа гарантирует, что при перезапуске
     \b IONC список заказчиков будет восстановлен по конфигурационному файлу.
 
+        \section sec_NC_Filter Фильтрация уведомлений (зона нечувствительности и ограничение частоты)
+    Для "шумящих" аналоговых датчиков каждое небольшое изменение приводит к рассылке SensorMessage
+    всем заказчикам. Чтобы не тратить ресурсы на пересылку ненужных изменений, заказчик может
+    задать фильтр (IONotifyController_i::NotifyFilter), который проверяется в момент рассылки:
+    - \b deadband     - зона нечувствительности: уведомление не посылается, если значение
+     отличается от последнего посланного этому заказчику меньше чем на deadband;
+    - \b deadband_pct - зона нечувствительности в процентах от диапазона (maxCal-minCal).
+     Если диапазон не задан, процент считается от последнего посланного значения.
+     Если заданы оба параметра, используется большее значение;
+    - \b minInterval  - минимальный интервал между уведомлениями (мсек). Изменения внутри интервала
+     не посылаются, но по его истечении заказчику \b всегда приходит последнее (текущее) значение.
+
+    Зона нечувствительности действует только для аналоговых датчиков (AI,AO).
+    Изменение признака "undefined" посылается всегда. Первое уведомление (UIONotify)
+    посылается без фильтрации и задаёт начальное значение для сравнения.
+
+    Задать фильтр можно при заказе (UInterface::askSensor с параметром NotifyFilter,
+    IONotifyController::askSensorWithFilter) или в конфигурационном файле, в секции \b <consumers> датчика.
+    Настройки из файла применяются, когда указанный заказчик заказывает датчик обычным askSensor.
+    \code
+    <item name="AI1_S" iotype="AI" ...>
+       <consumers>
+           <consumer name="UWebSocketGate1" type="objects" deadband="5" min_interval="500"/>
+           <consumer name="ClickHouse1" type="objects" deadband_pct="0.5" min_interval="1000"/>
+       </consumers>
+    </item>
+    \endcode
+    Количество не посланных (отфильтрованных) уведомлений выводится в статистике заказчиков (filtered).
+
         \section sec_NC_Thresholds Пороговые датчики
 
         \section sec_NC_Depends Механизм зависимостей между датчиками
@@ -149,6 +184,10 @@ namespace uniset
 
             virtual void askSensor(const uniset::ObjectId sid, const uniset::ConsumerInfo& ci, UniversalIO::UIOCommand cmd) override;
 
+            //! заказ с фильтрацией уведомлений (см. \ref sec_NC_Filter)
+            virtual void askSensorWithFilter(const uniset::ObjectId sid, const uniset::ConsumerInfo& ci,
+                                             UniversalIO::UIOCommand cmd, const IONotifyController_i::NotifyFilter& filter) override;
+
             virtual void askThreshold(const uniset::ObjectId sid, const uniset::ConsumerInfo& ci,
                                       uniset::ThresholdId tid,
                                       CORBA::Long lowLimit, CORBA::Long hiLimit, CORBA::Boolean invert,
@@ -184,6 +223,16 @@ namespace uniset
                 size_t lostEvents = { 0 }; // количество потерянных сообщений (не смогли послать)
                 size_t smCount = { 0 }; // количество посланных SensorMessage
 
+                // фильтрация уведомлений (см. sec_NC_Filter)
+                bool hasFilter = { false };
+                IONotifyController_i::NotifyFilter filter = { 0, 0.0, 0 };
+                size_t filtered = { 0 }; // количество отфильтрованных (не посланных) уведомлений
+                bool sent = { false }; // было послано хотя бы одно сообщение (есть с чем сравнивать)
+                long lastValue = { 0 }; // последнее посланное значение
+                bool lastUndefined = { false };
+                std::chrono::steady_clock::time_point lastTime; // время последней посылки
+                bool pending = { false }; // есть не посланное (отложенное) изменение
+
                 ConsumerInfoExt( const ConsumerInfoExt& ) = default;
                 ConsumerInfoExt& operator=( const ConsumerInfoExt& ) = default;
                 ConsumerInfoExt( ConsumerInfoExt&& ) = default;
@@ -207,6 +256,16 @@ namespace uniset
             /*! словарь: датчик -> список потребителей */
             typedef std::unordered_map<uniset::ObjectId, ConsumerListInfo> AskMap;
 
+            /*! настройка фильтра для заказчика (из конфигурационного файла) */
+            struct ConsumerFilterInfo
+            {
+                uniset::ConsumerInfo ci;
+                IONotifyController_i::NotifyFilter filter;
+            };
+
+            /*! словарь: датчик -> список фильтров заказчиков */
+            typedef std::unordered_map<uniset::ObjectId, std::vector<ConsumerFilterInfo>> ConsumerFilterMap;
+
             // связь: id датчика --> id порога --> список заказчиков
             // т.к. каждый порог имеет уникальный указатель, используем его в качестве ключа
             typedef std::unordered_map<UThresholdInfo*, ConsumerListInfo> AskThresholdMap;
@@ -264,12 +323,42 @@ namespace uniset
             friend class NCRestorer;
 
             //----------------------
-            bool addConsumer( ConsumerListInfo& lst, const uniset::ConsumerInfo& cons );     //!< добавить потребителя сообщения
+            bool addConsumer( ConsumerListInfo& lst, const uniset::ConsumerInfo& cons,
+                              const IONotifyController_i::NotifyFilter* filter = nullptr );     //!< добавить потребителя сообщения
             bool removeConsumer( ConsumerListInfo& lst, const uniset::ConsumerInfo& cons );  //!< удалить потребителя сообщения
 
             //! обработка заказа
             void ask(AskMap& askLst, const uniset::ObjectId sid,
-                     const uniset::ConsumerInfo& ci, UniversalIO::UIOCommand cmd);
+                     const uniset::ConsumerInfo& ci, UniversalIO::UIOCommand cmd,
+                     const IONotifyController_i::NotifyFilter* filter = nullptr );
+
+            //! заказ датчика (filter=nullptr - фильтр берётся из настроек, если задан)
+            void processAskSensor( const uniset::ObjectId sid, const uniset::ConsumerInfo& ci,
+                                   UniversalIO::UIOCommand cmd, const IONotifyController_i::NotifyFilter* filter );
+
+            //! посылка сообщения заказчику (с повторными попытками)
+            //! \return false - заказчик удалён из списка (li указывает на предыдущий элемент)
+            bool pushMessage( ConsumerListInfo& lst, ConsumerList::iterator& li, uniset::TransportMessage& tmsg,
+                              const uniset::SensorMessage& sm, std::chrono::steady_clock::time_point now );
+
+            //! проверка фильтра заказчика. \return true - уведомление надо послать сейчас
+            bool checkFilter( ConsumerInfoExt& c, const uniset::SensorMessage& sm, std::chrono::steady_clock::time_point now );
+
+            //! посылка отложенных (по minInterval) значений датчика
+            void sendPending( const uniset::ObjectId sid );
+
+            // отложенные посылки
+            void schedulePending( const uniset::ObjectId sid, std::chrono::steady_clock::time_point tm );
+            void pendingThread();
+
+            ConsumerFilterMap consumerFilters; /*!< фильтры заказчиков из конфигурационного файла */
+
+            typedef std::pair<std::chrono::steady_clock::time_point, uniset::ObjectId> PendingItem;
+            std::vector<PendingItem> pendingQueue; // куча (std::push_heap) с ближайшим временем в вершине
+            std::mutex pendingMutex;
+            std::condition_variable pendingEvent;
+            std::unique_ptr<std::thread> pendingThr;
+            bool pendingActive = { true };
 
             /*! добавить новый порог для датчика */
             std::shared_ptr<UThresholdInfo> addThresholdIfNotExist( std::shared_ptr<USensorInfo>& usi, std::shared_ptr<UThresholdInfo>& ti );
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2025 Pavel Vainerman.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, version 2.1.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+// --------------------------------------------------------------------------
+#ifndef IdLookupTable_H_
+#define IdLookupTable_H_
+// --------------------------------------------------------------------------
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <cstdint>
+#include "UniSetTypes.h"
+// --------------------------------------------------------------------------
+namespace uniset
+{
+    // --------------------------------------------------------------------------
+    /*! \class IdLookupTable
+     * Таблица для быстрого поиска элементов по идентификатору (ObjectId).
+     * Используется в коде, генерируемом uniset2-codegen (preSensorInfo, getValue),
+     * вместо цепочки сравнений "if( id == X )" по всем датчикам процесса.
+     *
+     * Таблица заполняется (add) и "строится" (build) один раз при инициализации.
+     * Если идентификаторы расположены достаточно плотно (что обычно для датчиков),
+     * то строится прямая таблица переходов id -> элементы (поиск за O(1)),
+     * иначе используется двоичный поиск по отсортированному списку (O(log n)).
+     *
+     * Одному id может соответствовать несколько элементов (порядок добавления сохраняется),
+     * поэтому поиск возвращает диапазон.
+     */
+    template<typename T>
+    class IdLookupTable
+    {
+        public:
+
+            //! диапазон найденных элементов
+            class Range
+            {
+                public:
+                    Range( const T* b = nullptr, const T* e = nullptr ) noexcept: b(b), e(e) {}
+
+                    inline const T* begin() const noexcept
+                    {
+                        return b;
+                    }
+                    inline const T* end() const noexcept
+                    {
+                        return e;
+                    }
+                    inline bool empty() const noexcept
+                    {
+                        return b == e;
+                    }
+                    inline size_t size() const noexcept
+                    {
+                        return e - b;
+                    }
+
+                private:
+                    const T* b;
+                    const T* e;
+            };
+
+            /*! добавить элемент (после добавления всех элементов надо вызвать build()) */
+            void add( uniset::ObjectId id, const T& v )
+            {
+                ids.push_back(id);
+                vals.push_back(v);
+                built = false;
+            }
+
+            /*! построить таблицу
+             * \param denseFactor - во сколько раз диапазон id может превышать количество элементов,
+             * чтобы ещё использовалась прямая таблица (0 - не использовать прямую таблицу)
+             */
+            void build( size_t denseFactor = 8 )
+            {
+                offs.clear();
+                built = true;
+
+                if( ids.empty() )
+                    return;
+
+                // сортируем с сохранением порядка добавления для одинаковых id
+                std::vector<size_t> idx(ids.size());
+                std::iota(idx.begin(), idx.end(), 0);
+                std::stable_sort(idx.begin(), idx.end(), [this]( size_t a, size_t b )
+                {
+                    return ids[a] < ids[b];
+                });
+
+                std::vector<uniset::ObjectId> sids;
+                std::vector<T> svals;
+                sids.reserve(ids.size());
+                svals.reserve(vals.size());
+
+                for( auto&& i : idx )
+                {
+                    sids.push_back(ids[i]);
+                    svals.push_back(vals[i]);
+                }
+
+                ids.swap(sids);
+                vals.swap(svals);
+
+                minId = ids.front();
+                const size_t range = (size_t)(ids.back() - ids.front()) + 1;
+
+                if( denseFactor == 0 || range > denseFactor * ids.size() + 256 || ids.size() >= UINT32_MAX )
+                    return;
+
+                // прямая таблица: offs[id - minId] .. offs[id - minId + 1] - индексы элементов в vals
+                offs.assign(range + 1, 0);
+
+                for( auto&& id : ids )
+                    offs[id - minId + 1]++;
+
+                for( size_t i = 1; i < offs.size(); i++ )
+                    offs[i] += offs[i - 1];
+            }
+
+            /*! найти все элементы с заданным id */
+            inline Range find( uniset::ObjectId id ) const noexcept
+            {
+                if( !offs.empty() )
+                {
+                    const size_t k = (size_t)(id - minId);
+
+                    if( id < minId || k + 1 >= offs.size() )
+                        return Range();
+
+                    return Range(vals.data() + offs[k], vals.data() + offs[k + 1]);
+                }
+
+                auto r = std::equal_range(ids.begin(), ids.end(), id);
+                return Range(vals.data() + (r.first - ids.begin()), vals.data() + (r.second - ids.begin()));
+            }
+
+            /*! найти первый элемент с заданным id
+             * \return nullptr если элемент не найден
+             */
+            inline const T* get( uniset::ObjectId id ) const noexcept
+            {
+                auto r = find(id);
+                return r.empty() ? nullptr : r.begin();
+            }
+
+            inline size_t size() const noexcept
+            {
+                return vals.size();
+            }
+
+            inline bool empty() const noexcept
+            {
+                return vals.empty();
+            }
+
+            //! используется прямая таблица (поиск за O(1))
+            inline bool isDense() const noexcept
+            {
+                return !offs.empty();
+            }
+
+            inline bool isBuilt() const noexcept
+            {
+                return built;
+            }
+
+        private:
+            std::vector<uniset::ObjectId> ids;
+            std::vector<T> vals;
+            std::vector<uint32_t> offs;
+            uniset::ObjectId minId = { 0 };
+            bool built = { false };
+    };
+    // --------------------------------------------------------------------------
+} // end of namespace uniset
+// --------------------------------------------------------------------------
+#endif // IdLookupTable_H_
+// --------------------------------------------------------------------------
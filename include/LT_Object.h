@@ -131,6 +131,14 @@ namespace uniset
              */
             timeout_t getTimeLeft( uniset::TimerId timerid ) const;
 
+            /*! Минимальный квант проверки таймеров (по умолчанию UniSetTimer::MinQuantityTime).
+             * checkTimers() не проверяет таймеры чаще этого кванта и не возвращает время ожидания меньше него.
+             * Если квант задан меньше MinQuantityTime (режим UniSetObject::setEventLoopMode()),
+             * оставшееся время считается по собственному таймеру каждого заказа.
+             */
+            void setTimersQuantity( timeout_t msec ) noexcept;
+            timeout_t getTimersQuantity() const noexcept;
+
         protected:
 
             /*! пользовательская функция для вывода названия таймера */
@@ -204,6 +212,7 @@ namespace uniset
             /*! замок для блокирования совместного доступа к списку таймеров */
             mutable uniset::uniset_rwmutex lstMutex;
             PassiveTimer tmLast;
+            timeout_t tmQuantity = { UniSetTimer::MinQuantityTime };
 
             Debug::type loglevel = { Debug::LEVEL3 };
     };
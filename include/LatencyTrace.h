@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2025 Pavel Vainerman.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, version 2.1.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+// --------------------------------------------------------------------------
+#ifndef LatencyTrace_H_
+#define LatencyTrace_H_
+// --------------------------------------------------------------------------
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <array>
+#ifndef DISABLE_REST_API
+#include <Poco/JSON/Object.h>
+#endif
+// --------------------------------------------------------------------------
+namespace uniset
+{
+    /*! Трассировка задержек прохождения изменений датчиков ("от поля до заказчика").
+
+        Для выборки (sampling, в процентах) изменений в точке "входа" ставится метка времени
+        (CLOCK_MONOTONIC, мкс по модулю 2^32, см. start()). Метка передаётся дальше вместе со значением
+        (в SensorMessage::trace_tm, а внутри потока - через current()/Scope),
+        и в каждой точке прохождения (Hop) задержка от метки добавляется в гистограмму этой точки.
+        Одна метка относится к одному значению (см. take()).
+
+        Точки прохождения:
+        - Receive  - значение получено от устройства и передаётся в SM (например MBExchange)
+        - SetValue - значение сохранено в SM
+        - Dispatch - уведомления разосланы заказчикам
+        - Dequeue  - сообщение извлечено из очереди заказчика
+        - Handled  - сообщение обработано заказчиком (sensorInfo)
+
+        Гистограммы свои у каждого процесса. Между процессами метка передаётся только
+        в SensorMessage (SM -> заказчик), для Dequeue/Handled задержка считается от метки,
+        поставленной в SM (часы CLOCK_MONOTONIC общие для узла).
+        Метки, пришедшие с другого узла, не учитываются (см. localNode()).
+        Метка процесса обмена (Receive) доходит до SM только если обмен работает в одном процессе с SM
+        (SMInterface с указателем на IONotifyController). При записи в SM через UInterface (CORBA) метка не передаётся:
+        в процессе обмена учитываются Receive и SetValue (время удалённого вызова), а SM выбирает изменения для трассировки сам.
+
+        Включается параметром командной строки --uniset-latency-trace percent (по умолчанию отключено).
+        Статистика доступна через HTTP API (/api/VERSION/ObjectName/latency) и uniset2-admin --latency.
+
+        Если трассировка отключена, затраты - одна проверка атомарной переменной в точке "входа".
+    */
+    namespace LatencyTrace
+    {
+        enum Hop : uint8_t
+        {
+            Receive,
+            SetValue,
+            Dispatch,
+            Dequeue,
+            Handled,
+            HopCount
+        };
+
+        // корзины гистограммы: [0], [1], [2..3], [4..7] ... [2^31..2^32) мкс
+        static const size_t NumBuckets = 33;
+
+        /*! процент трассируемых изменений (0 - отключить)
+         * Выбирается каждое N-ое изменение (N = 100/percent) в каждом потоке.
+         */
+        void setSampling( double percent ) noexcept;
+        double getSampling() noexcept;
+        bool enabled() noexcept;
+
+        //! текущее время (мкс, CLOCK_MONOTONIC, по модулю 2^32, никогда не 0)
+        uint32_t now() noexcept;
+
+        //! начать трассировку (если изменение попало в выборку)
+        //! \return метка или 0 (не трассируется)
+        uint32_t start() noexcept;
+
+        //! учесть задержку от stamp в точке h (stamp == 0 - ничего не делается)
+        void hop( Hop h, uint32_t stamp ) noexcept;
+
+        //! метка, выставленная в текущем потоке (см. Scope)
+        uint32_t current() noexcept;
+
+        //! забрать метку текущего потока (метка сбрасывается, чтобы не попасть в следующие значения)
+        uint32_t take() noexcept;
+
+        //! выставить метку текущего потока на время жизни объекта
+        class Scope
+        {
+            public:
+                Scope( uint32_t stamp ) noexcept;
+                ~Scope() noexcept;
+
+            private:
+                uint32_t prev;
+        };
+
+        //! узел, на котором работает процесс (метки с других узлов не учитываются)
+        void setLocalNode( long node ) noexcept;
+        long localNode() noexcept;
+
+        struct HopStat
+        {
+            size_t count = { 0 };
+            uint64_t sum = { 0 }; // мкс
+            uint32_t max = { 0 }; // мкс
+            std::array<size_t, NumBuckets> buckets;
+
+            HopStat() noexcept
+            {
+                buckets.fill(0);
+            }
+
+            double avg() const noexcept;
+
+            //! оценка перцентиля (верхняя граница корзины), p = 0..1
+            uint32_t percentile( double p ) const noexcept;
+        };
+
+        HopStat stat( Hop h ) noexcept;
+        size_t started() noexcept; // количество начатых трассировок
+        void reset() noexcept;
+
+        std::string hopName( Hop h );
+
+        //! текстовый отчёт (для getInfo)
+        std::string report();
+
+#ifndef DISABLE_REST_API
+        Poco::JSON::Object::Ptr toJSON();
+#endif
+    }
+    // --------------------------------------------------------------------------
+} // end of namespace uniset
+// --------------------------------------------------------------------------
+#endif // LatencyTrace_H_
+// --------------------------------------------------------------------------
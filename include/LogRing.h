@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2025 Pavel Vainerman.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, version 2.1.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+// -------------------------------------------------------------------------
+#ifndef LogRing_H_
+#define LogRing_H_
+// -------------------------------------------------------------------------
+#include <string>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <cstdint>
+// -------------------------------------------------------------------------
+namespace uniset
+{
+    /*! Кольцевой буфер записей лога, общий для всех сессий LogServer.
+
+        Каждая запись (строка лога) копируется в буфер один раз, а читатели (LogSession)
+        хранят только свою позицию (Cursor) и отправляют данные прямо из буфера (writev).
+        Запись в буфер выполняется под mutex-ом (писать в DebugStream могут разные потоки),
+        чтение - без блокировок.
+
+        Писатель никогда не ждёт читателей: при нехватке места самые старые записи затираются.
+        Читатель, который "отстал" больше чем на размер буфера, обнаруживает это при помощи sync()
+        и получает количество потерянных записей.
+
+        Формат буфера: [заголовок 8 байт: длина, номер записи][данные][выравнивание до 8 байт]...
+        Запись никогда не "разрывается" на конце буфера: если она не помещается,
+        пишется специальный заголовок "перехода" в начало.
+
+        \warning Чтение выполняется по схеме seqlock: данные, отданные read(), могут быть затёрты
+        писателем в любой момент. Поэтому после их использования надо вызвать valid().
+        Если получено false, отправленная часть могла быть испорчена, следующий sync() сообщит о потере.
+    */
+    class LogRing
+    {
+        public:
+
+            //! \param capacity - размер буфера в байтах (округляется вверх до степени двойки)
+            explicit LogRing( size_t capacity = 2 * 1024 * 1024 );
+            ~LogRing();
+
+            LogRing( const LogRing& ) = delete;
+            LogRing& operator=( const LogRing& ) = delete;
+
+            //! Добавить запись. Записи длиннее capacity()/4 обрезаются.
+            void push( const std::string& s ) noexcept;
+            void push( const char* data, size_t len ) noexcept;
+
+            //! Позиция читателя
+            struct Cursor
+            {
+                uint64_t pos = { 0 };    // позиция (в байтах, от начала работы) текущей записи
+                uint32_t seq = { 0 };    // номер текущей записи
+                size_t offset = { 0 };   // сколько байт текущей записи уже отправлено
+            };
+
+            //! Запись, доступная для отправки
+            struct Slice
+            {
+                const char* data = { nullptr };
+                size_t len = { 0 };
+                uint64_t pos = { 0 };    // позиция записи
+                uint64_t next = { 0 };   // позиция следующей записи
+                uint32_t seq = { 0 };
+            };
+
+            //! Позиция "сейчас" (новый читатель получит только записи, добавленные после вызова)
+            Cursor cursor() const noexcept;
+
+            /*! Проверка, что запись под курсором ещё не затёрта.
+             * Если затёрта, курсор переводится на самую старую запись в буфере.
+             * \return количество потерянных записей
+             */
+            size_t sync( Cursor& c ) const noexcept;
+
+            /*! Получить записи начиная с курсора (не больше maxnum).
+             * Курсор не меняется, для продвижения используется advance().
+             * \return количество записей в slices
+             */
+            size_t read( const Cursor& c, Slice* slices, size_t maxnum ) const noexcept;
+
+            //! Продвинуть курсор на nbytes отправленных байт (с учётом c.offset для первой записи)
+            static void advance( Cursor& c, const Slice* slices, size_t num, size_t nbytes ) noexcept;
+
+            //! false - данные начиная с pos уже могли быть затёрты
+            bool valid( uint64_t pos ) const noexcept;
+
+            //! Количество ещё не прочитанных записей для курсора
+            size_t pending( const Cursor& c ) const noexcept;
+
+            size_t capacity() const noexcept;
+
+            // статистика по записям
+            size_t minRecordSize() const noexcept;
+            size_t maxRecordSize() const noexcept;
+
+        protected:
+            static const size_t HeaderSize = 8;
+            static const uint32_t WrapMark = 0xffffffff;
+
+            struct Header
+            {
+                uint32_t len;
+                uint32_t seq;
+            };
+
+            Header header( uint64_t pos ) const noexcept;
+            uint64_t recordSize( uint64_t pos, const Header& h ) const noexcept;
+
+        private:
+            std::unique_ptr<char[]> buf;
+            const size_t cap;
+            const uint64_t mask;
+
+            mutable std::mutex wmutex;
+            std::atomic<uint64_t> head = { 0 }; // позиция следующей записи
+            std::atomic<uint64_t> tail = { 0 }; // самая старая запись в буфере
+            std::atomic<uint32_t> wseq = { 0 }; // номер следующей записи
+
+            std::atomic<size_t> minSize = { 0 };
+            std::atomic<size_t> maxSize = { 0 };
+    };
+    // -------------------------------------------------------------------------
+} // end of uniset namespace
+// -------------------------------------------------------------------------
+#endif // LogRing_H_
+// -------------------------------------------------------------------------
@@ -40,6 +40,7 @@ namespace uniset
     // -------------------------------------------------------------------------
     class LogSession;
     class LogAgregator;
+    class LogRing;
     class NullLogSession;
     // -------------------------------------------------------------------------
     /*! \page pgLogServer Лог сервер
@@ -88,6 +89,10 @@ namespace uniset
 
     \warning Т.к. LogServer в основном только отдаёт "клиентам" логи, то он реализован с использованием CommonEventLoop,
     т.е. у всех LogServer будет ОДИН ОБЩИЙ event loop.
+
+    Пока есть подключения, каждая запись лога один раз копируется в общий кольцевой буфер (LogRing),
+    из которого её читают все сессии. Размер буфера задаётся параметром --prefix-ring-size (байт).
+    Если клиент не успевает читать и его записи затёрты, он получает сообщение о количестве потерянных записей.
     */
     // -------------------------------------------------------------------------
     class LogServer:
@@ -103,6 +108,9 @@ namespace uniset
             void setSessionLog( Debug::type t ) noexcept;
             void setMaxSessionCount( size_t num ) noexcept;
 
+            //! размер общего буфера (в байтах). Применяется при подключении первого клиента.
+            void setRingSize( size_t bytes ) noexcept;
+
             // port <= 0: select an available port automatically
             bool async_run( const std::string& addr, int port );
             bool run( const std::string& addr, int port );
@@ -138,6 +146,8 @@ namespace uniset
             void saveDefaultLogLevels( const std::string& logname );
             void restoreDefaultLogLevels( const std::string& logname );
             std::string onCommand( LogSession* s, LogServerTypes::Command cmd, const std::string& logname );
+            void logOnEvent( const std::string& s ) noexcept;
+            void onRingEvent( ev::async& watcher, int revents ) noexcept;
 
         private:
 
@@ -151,6 +161,11 @@ namespace uniset
 
             DebugStream mylog;
             ev::io io;
+            ev::async ringEvent; // появились новые записи в ring
+
+            size_t ringSize = { 2 * 1024 * 1024 };
+            std::shared_ptr<LogRing> ring;
+            sigc::connection ringConn;
 
             // делаем loop общим.. одним на всех!
             static CommonEventLoop loop;
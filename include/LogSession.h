@@ -20,6 +20,8 @@
 #include <string>
 #include <memory>
 #include <queue>
+#include <vector>
+#include <atomic>
 #include <ev++.h>
 #include "Poco/Net/StreamSocket.h"
 #include "Mutex.h"
@@ -27,6 +29,7 @@
 #include "UTCPCore.h"
 #include "UTCPStream.h"
 #include "LogAgregator.h"
+#include "LogRing.h"
 #ifndef DISABLE_REST_API
 #include <Poco/JSON/Object.h>
 #endif
@@ -34,12 +37,28 @@
 namespace uniset
 {
 
-    /*! Реализация "сессии" для клиентов LogServer. */
+    /*! Реализация "сессии" для клиентов LogServer.
+
+        Сессия не копирует себе записи лога, а читает их из кольцевого буфера (LogRing),
+        общего для всех сессий LogServer, храня только свою позицию в нём.
+        Если клиент не успевает читать и его записи затёрты, ему отправляется сообщение
+        о количестве потерянных записей.
+
+        В режиме фильтра (LogServerTypes::cmdFilterMode), а также если общий буфер не задан,
+        сессия использует собственный буфер, в который пишутся только "её" логи.
+    */
     class LogSession
     {
         public:
 
             LogSession( const Poco::Net::StreamSocket& s, std::shared_ptr<DebugStream>& log, timeout_t cmdTimeout = 2000, timeout_t checkConnectionTime = 10000 );
+
+            /*! \param ring - общий буфер, в который пишутся записи log
+             * (заполняет его владелец, сессии надо сообщать о новых записях через wakeup())
+             */
+            LogSession( const Poco::Net::StreamSocket& s, std::shared_ptr<DebugStream>& log,
+                        const std::shared_ptr<LogRing>& ring,
+                        timeout_t cmdTimeout = 2000, timeout_t checkConnectionTime = 10000 );
             ~LogSession();
 
             typedef sigc::slot<void, LogSession*> FinalSlot;
@@ -59,10 +78,15 @@ namespace uniset
             void addSessionLogLevel( Debug::type t ) noexcept;
             void delSessionLogLevel( Debug::type t ) noexcept;
 
-            //! Установить размер буфера для сообщений (количество записей. Не в байтах!!)
+            /*! Установить размер собственного буфера (количество записей. Не в байтах!!)
+             * Применяется при создании собственного буфера (режим фильтра), на общий буфер не влияет.
+             */
             void setMaxBufSize( size_t num );
             size_t getMaxBufSize() const noexcept;
 
+            //! в общем буфере появились новые записи (вызывается в потоке event loop)
+            void wakeup() noexcept;
+
             // запуск обработки входящих запросов
             void run( const ev::loop_ref& loop ) noexcept;
             void terminate();
@@ -83,6 +107,7 @@ namespace uniset
             void callback( ev::io& watcher, int revents ) noexcept;
             void readEvent( ev::io& watcher ) noexcept;
             void writeEvent( ev::io& watcher );
+            void writeError() noexcept;
             size_t readData( unsigned char* buf, int len );
             void cmdProcessing( const std::string& cmdLogName, const LogServerTypes::lsMessage& msg );
             void onCmdTimeout( ev::timer& watcher, int revents ) noexcept;
@@ -94,31 +119,40 @@ namespace uniset
             timeout_t cmdTimeout = { 2000 };
             double checkConnectionTime = { 10. }; // время на проверку живости соединения..(сек)
 
-            // Т.к. сообщений может быть ОЧЕНЬ МНОГО.. сеть медленная
-            // очередь будет не успевать рассасываться,
-            // то потенциально может "скушаться" вся память.
-            // Поэтому приходиться ограничить доступное количество записей.
+            // Размер собственного буфера (в записях).
             // Рассчитываем, что средний размер одного сообщения 150 символов (байт)
-            // тогда выделяем буфер на 200 сообщений (~ 30кB)
             // На самом деле сообщения могут быть совершенно разные..
-            size_t maxRecordsNum = { 30000 }; // максимальное количество сообщение в очереди
+            size_t maxRecordsNum = { 30000 };
+            static const size_t avgRecordSize = { 150 };
+
+            void createOwnRing();
+
+            // опубликовать текущие ring/cursor для getShortInfo()/httpGetShortInfo(),
+            // которые вызываются из других потоков (вызывать только из потока сессии)
+            void publishCursor() noexcept;
 
         private:
-            std::queue<UTCPCore::Buffer*> logbuf;
-            std::mutex logbuf_mutex;
-            bool lostMsg = { false };
+            std::shared_ptr<LogRing> sring; // общий буфер (LogServer)
+            std::shared_ptr<LogRing> myring; // собственный буфер (режим фильтра или работа без LogServer)
+            LogRing* ring = { nullptr }; // буфер из которого сейчас идёт чтение
+            LogRing::Cursor cursor;
+            std::atomic<LogRing*> statRing = { nullptr }; // копии ring и cursor.seq для чтения из других потоков
+            std::atomic<uint32_t> statSeq = { 0 };
+
+            // служебные сообщения (ответы на команды, сообщения о потерях)
+            // отправляются между записями лога
+            std::queue<UTCPCore::Buffer*> cmdbuf;
 
             // статистика по использованию буфера
-            size_t maxCount = { 0 }; // максимальное количество побывавшее в очереди
-            size_t minSizeMsg = { 0 }; // минимальная встретившаяся длинна сообщения
-            size_t maxSizeMsg = { 0 }; // максимальная встретившаяся длинна сообщения
-            size_t numLostMsg = { 0 }; // количество потерянных сообщений
+            std::atomic<size_t> maxCount = { 0 }; // максимальное количество записей, ожидавших отправки
+            std::atomic<size_t> numLostMsg = { 0 }; // количество потерянных сообщений
 
             std::string peername = { "" };
             std::string caddr = { "" };
             std::shared_ptr<DebugStream> log;
             std::shared_ptr<LogAgregator> alog;
             sigc::connection conn;
+            std::vector<sigc::connection> fconn; // подключения в режиме фильтра
 
             std::shared_ptr<UTCPStream> sock;
 
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2025 Pavel Vainerman.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, version 2.1.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+// --------------------------------------------------------------------------
+#ifndef MQRing_H_
+#define MQRing_H_
+//--------------------------------------------------------------------------
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <deque>
+#include <mutex>
+#include "MessageType.h"
+//--------------------------------------------------------------------------
+namespace uniset
+{
+    //--------------------------------------------------------------------------
+    typedef std::shared_ptr<uniset::VoidMessage> VoidMessagePtr;
+    //--------------------------------------------------------------------------
+    /*! \class MQRing
+     * Очередь сообщений без блокировок (кольцевой буфер фиксированного размера) для схемы
+     * "МНОГО ПИСАТЕЛЕЙ" и "ОДИН ЧИТАТЕЛЬ" (используется в UniSetObject).
+     *
+     * В отличие от MQAtomic и MQMutex сообщение хранится непосредственно в ячейке буфера
+     * (копия TransportMessage), поэтому при помещении в очередь не выделяется память
+     * и нет работы со счётчиками ссылок shared_ptr. Сообщения, которые не помещаются в TransportMessage
+     * (например TextMessage), хранятся в ячейке "по указателю" (см. push(const VoidMessagePtr&)).
+     *
+     * Каждая ячейка имеет свой номер последовательности (seq), по которому писатели и читатель
+     * определяют, свободна ли ячейка для записи (seq == pos) или в ней лежит сообщение (seq == pos+1).
+     * Позиции записи (tail) и чтения (head) монотонно растут, индекс ячейки - (pos % size).
+     * Писатель сперва "занимает" позицию (CAS по tail), затем копирует сообщение и "публикует" ячейку (seq).
+     * Поэтому читатель никогда не увидит недописанное сообщение, а переполнение определяется
+     * однозначно (ячейка для записи ещё не освобождена читателем), без "догоняния" индексов.
+     *
+     * Читатель может забрать сразу пачку готовых сообщений (pop) - одной атомарной операцией над head.
+     *
+     * Максимальное ограничение на размер очереди сообщений задаётся функцией setMaxSizeOfMessageQueue().
+     * Память под очередь резервируется сразу (size * sizeof(Item)), поэтому размер кольцевого буфера
+     * ограничен (MaxRingSize). Для очереди большего размера используется обычная очередь с блокировкой
+     * (std::deque + mutex, как в MQMutex), которая растёт по мере необходимости.
+     *
+     * Если очередь переполняется, то сообщения ТЕРЯЮТСЯ!
+     * При помощи функции setLostStrategy() можно установить стратегию что терять
+     * lostNewData - в случае переполнения теряются новые данные (т.е. не будут помещаться в очередь)
+     * lostOldData - в случае переполнения очереди, старые данные затираются новыми
+     * (писатель сам удаляет самое старое сообщение и записывает новое).
+     */
+    class MQRing
+    {
+        public:
+            MQRing( size_t qsize = 2000 );
+            ~MQRing();
+
+            /*! максимальный размер кольцевого буфера (при большем размере очереди используется std::deque) */
+            static const size_t MaxRingSize = 16384;
+
+            //! элемент очереди
+            struct Item
+            {
+                //! сообщение
+                inline const VoidMessage* get() const noexcept
+                {
+                    return ext ? ext.get() : reinterpret_cast<const VoidMessage*>(&raw);
+                }
+
+                std::aligned_storage<sizeof(VoidMessage), alignof(VoidMessage)>::type raw;
+                VoidMessagePtr ext; // сообщение хранящееся "по указателю"
+            };
+
+            /*! поместить сообщение в очередь (копируется в ячейку) */
+            bool push( const TransportMessage& tm ) noexcept;
+
+            /*! поместить сообщение в очередь "по указателю"
+             * (для сообщений, которые нельзя передать через TransportMessage)
+             */
+            bool push( const VoidMessagePtr& msg ) noexcept;
+
+            /*! Извлечь до num сообщений (в порядке поступления)
+             * \return количество извлечённых сообщений
+             */
+            size_t pop( Item* buf, size_t num ) noexcept;
+
+            /*! Извлечь сообщение из очереди
+             * \return не валидный shared_ptr если сообщений нет
+             */
+            VoidMessagePtr top() noexcept;
+
+            size_t size() const noexcept;
+            bool empty() const noexcept;
+
+            // ----- Настройки  -----
+            // неявно подразумевается, что всё настраивается до первого использования
+            // (при изменении размера сообщения в очереди теряются)
+            // ----------------------
+            void setMaxSizeOfMessageQueue( size_t s );
+            size_t getMaxSizeOfMessageQueue() const noexcept;
+
+            /*! Стратегия при переполнении */
+            enum LostStrategy
+            {
+                lostOldData, // default
+                lostNewData
+            };
+
+            void setLostStrategy( LostStrategy s ) noexcept;
+
+            /*! true - очередь работает без блокировок (кольцевой буфер), false - std::deque + mutex */
+            bool isLockFree() const noexcept;
+
+            // ---- Статистика ----
+            /*! максимальное количество которое было в очереди сообщений */
+            inline size_t getMaxQueueMessages() const noexcept
+            {
+                return stMaxQueueMessages.load(std::memory_order_relaxed);
+            }
+
+            /*! количество потерянных сообщений */
+            inline size_t getCountOfLostMessages() const noexcept
+            {
+                return stCountOfLostMessages.load(std::memory_order_relaxed);
+            }
+
+        protected:
+
+            struct Slot
+            {
+                std::atomic<size_t> seq;
+                Item item;
+            };
+
+            template<typename Fill>
+            bool enqueue( Fill&& fill ) noexcept;
+
+            // удалить самое старое сообщение (при переполнении)
+            bool dropOldest() noexcept;
+
+            void mqAlloc();
+
+            // очередь с блокировкой (для размера больше MaxRingSize)
+            template<typename Fill>
+            bool enqueueLocked( Fill&& fill ) noexcept;
+            size_t popLocked( Item* buf, size_t num ) noexcept;
+
+        private:
+
+            std::unique_ptr<Slot[]> ring;
+
+            std::deque<Item> dq; // используется если ring не создан
+            mutable std::mutex dqmutex;
+
+            // позиция на запись и позиция на чтение (разнесены по разным кэш-линиям)
+            alignas(64) std::atomic<size_t> tail = { 0 };
+            alignas(64) std::atomic<size_t> head = { 0 };
+
+            LostStrategy lostStrategy = { lostOldData };
+
+            /*! размер очереди сообщений */
+            size_t SizeOfMessageQueue = { 2000 };
+
+            // статистическая информация
+            std::atomic<size_t> stMaxQueueMessages = { 0 };    /*!< Максимальное число сообщений хранившихся в очереди */
+            std::atomic<size_t> stCountOfLostMessages = { 0 };    /*!< количество потерянных сообщений */
+    };
+    // -------------------------------------------------------------------------
+} // end of uniset namespace
+//---------------------------------------------------------------------------
+#endif
+//---------------------------------------------------------------------------
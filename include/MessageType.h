@@ -141,6 +141,9 @@ namespace uniset
             bool threshold = { false };  /*!< TRUE - сработал порог, FALSE - порог отключился */
             uniset::ThresholdId tid = { uniset::DefaultThresholdId };
 
+            // метка трассировки задержек (0 - не трассируется), см. LatencyTrace.h
+            uint32_t trace_tm = { 0 };
+
             SensorMessage( SensorMessage&& m) noexcept = default;
             SensorMessage& operator=(SensorMessage&& m) noexcept = default;
             SensorMessage( const SensorMessage& ) noexcept = default;
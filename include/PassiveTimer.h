@@ -28,6 +28,8 @@
 #include <atomic>
 #include <chrono>
 #include <limits>
+#include <vector>
+#include <sys/epoll.h>
 #include <Poco/Timespan.h>
 #include "Mutex.h"
 //----------------------------------------------------------------------------------------
@@ -153,6 +155,76 @@ namespace uniset
             std::condition_variable cv_working;
     };
     // -------------------------------------------------------------------------
+    /*! \class PassiveEpollTimer
+     * \brief Пассивный таймер с режимом засыпания на основе epoll (только Linux)
+     * \par
+     * Ожидание wait(timeout_t timeMS) выполняется в epoll_wait() сразу по нескольким источникам:
+     * - "звонок" (eventfd), который выставляется terminate();
+     * - таймер ожидания (timerfd, CLOCK_MONOTONIC);
+     * - дополнительные дескрипторы, добавленные через addFd().
+     *
+     * terminate() пишет в eventfd только если "звонок" ещё не выставлен, поэтому серия вызовов
+     * terminate() (например при поступлении пачки сообщений) стоит одного системного вызова и одного пробуждения.
+     * "Звонок", выставленный до вызова wait(), не теряется (wait() сразу вернёт управление).
+     *
+     * Ожидание и работа с событиями по дескрипторам (fdEvents()) выполняется в одном потоке,
+     * terminate() может вызываться из любого потока.
+     * \sa UniSetObject::setEventLoopMode()
+     */
+    class PassiveEpollTimer:
+        public PassiveTimer
+    {
+        public:
+
+            PassiveEpollTimer(); // throw SystemError
+            virtual ~PassiveEpollTimer() noexcept;
+
+            virtual bool wait( timeout_t t_msec ) noexcept override; /*!< блокировать вызывающий поток на заданное время */
+            virtual void terminate() noexcept override;  /*!< прервать ожидание ("звонок") */
+
+            /*! добавить дескриптор в ожидание
+             * \param events - маска событий epoll (EPOLLIN, EPOLLOUT, ...)
+             */
+            bool addFd( int fd, uint32_t events = EPOLLIN ) noexcept;
+            bool removeFd( int fd ) noexcept;
+
+            struct FdEvent
+            {
+                int fd;
+                uint32_t events;
+            };
+
+            //! события по дополнительным дескрипторам, полученные последним вызовом wait()
+            inline const std::vector<FdEvent>& fdEvents() const noexcept
+            {
+                return fdevents;
+            }
+
+            // ---- Статистика ----
+            //! количество пробуждений по "звонку"
+            inline size_t getWakeups() const noexcept
+            {
+                return stWakeups;
+            }
+
+            //! количество записей в eventfd (остальные вызовы terminate() были "склеены")
+            inline size_t getDoorbells() const noexcept
+            {
+                return stDoorbells.load(std::memory_order_relaxed);
+            }
+
+        private:
+            int epfd = { -1 };
+            int evfd = { -1 };
+            int tmfd = { -1 };
+
+            std::atomic_bool pending = { false }; // "звонок" выставлен, но ещё не обработан
+            std::vector<FdEvent> fdevents;
+
+            size_t stWakeups = { 0 };
+            std::atomic<size_t> stDoorbells = { 0 };
+    };
+    // -------------------------------------------------------------------------
 } // end of uniset namespace
 //----------------------------------------------------------------------------------------
 # endif //PASSIVETIMER_H_
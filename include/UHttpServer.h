@@ -22,6 +22,7 @@
 #include <memory>
 #include <vector>
 #include <Poco/Net/HTTPServer.h>
+#include <Poco/ThreadPool.h>
 #include "DebugStream.h"
 #include "ThreadCreator.h"
 #include "UHttpRequestHandler.h"
@@ -59,7 +60,12 @@ namespace uniset
         {
             public:
 
-                UHttpServer( std::shared_ptr<IHttpRequestRegistry>& supplier, const std::string& host, int port );
+                /*! \param maxThreads - максимальное число потоков обработки запросов
+                 * (запрос, ожидающий данные (long-poll, SSE), занимает поток на всё время ожидания)
+                 * \param maxQueued - максимальное число соединений, ожидающих свободный поток
+                 */
+                UHttpServer( std::shared_ptr<IHttpRequestRegistry>& supplier, const std::string& host, int port,
+                             int maxThreads = 1, int maxQueued = 100 );
                 virtual ~UHttpServer();
 
                 void start();
@@ -88,6 +94,7 @@ namespace uniset
                 // Note: HTTPServer takes ownership of reqFactory, so we just keep a raw pointer
                 // for configuration methods. HTTPServer will delete it.
                 UHttpRequestHandlerFactory* reqFactory = { nullptr };
+                std::unique_ptr<Poco::ThreadPool> pool; // должен удаляться после http
                 std::shared_ptr<Poco::Net::HTTPServer> http;
                 UHttp::NetworkRules whitelist;
                 UHttp::NetworkRules blacklist;
@@ -96,9 +96,22 @@ namespace uniset
             void askRemoteSensor( const uniset::ObjectId id, UniversalIO::UIOCommand cmd, const uniset::ObjectId node,
                                   uniset::ObjectId backid = uniset::DefaultObjectId ) const;
 
+            //! Заказ с фильтрацией уведомлений (зона нечувствительности, минимальный интервал), см. IONotifyController
+            void askSensor( const uniset::ObjectId id, UniversalIO::UIOCommand cmd, const IONotifyController_i::NotifyFilter& filter,
+                            uniset::ObjectId backid = uniset::DefaultObjectId ) const;
+
+            void askRemoteSensor( const uniset::ObjectId id, UniversalIO::UIOCommand cmd, const uniset::ObjectId node,
+                                  const IONotifyController_i::NotifyFilter& filter, uniset::ObjectId backid = uniset::DefaultObjectId ) const;
+
             //! Заказ по списку
             uniset::IDSeq_var askSensorsSeq( const uniset::IDList& lst, UniversalIO::UIOCommand cmd,
                                              uniset::ObjectId backid = uniset::DefaultObjectId );
+
+            /*! Заказ по списку датчиков, находящихся на узле node (одним вызовом)
+             * \return список датчиков, которые не удалось заказать
+             */
+            uniset::IDSeq_var askRemoteSensorsSeq( const uniset::IDList& lst, UniversalIO::UIOCommand cmd,
+                                                   uniset::ObjectId node, uniset::ObjectId backid = uniset::DefaultObjectId );
             // ------------------------------------------------------
 
             // установка неопределённого состояния
@@ -312,6 +325,10 @@ namespace uniset
         private:
             void init();
 
+            // filter = nullptr - обычный заказ (askSensor)
+            void askRemoteSensorWithFilter( const uniset::ObjectId id, UniversalIO::UIOCommand cmd, const uniset::ObjectId node,
+                                            uniset::ObjectId backid, const IONotifyController_i::NotifyFilter* filter ) const;
+
             ObjectRepository rep;
             uniset::ObjectId myid;
             mutable CosNaming::NamingContext_var localctx;
@@ -53,6 +53,11 @@ namespace uniset
          * --activator-httpserver-trusted-proxies list - список доверенных фронтов (через запятую) для разбора X-Forwarded-For/X-Real-IP
          * --activator-httpserver-bearer-required 0|1 - требовать Bearer токен
          * --activator-httpserver-bearer-tokens list - список допустимых Bearer токенов (через запятую)
+         * --activator-httpserver-max-threads num - максимальное число потоков обработки запросов. Default: 16
+         * --activator-httpserver-max-queued num - максимальное число соединений, ожидающих свободный поток. Default: 100
+         *
+         * Запросы, ожидающие данные (long-poll, SSE), занимают поток на всё время ожидания,
+         * поэтому потоков должно быть больше, чем таких клиентов (см. SharedMemory --http-api-changes-max-clients).
          *
          * \sa \ref pg_UHttpServer
          *
@@ -83,6 +88,11 @@ namespace uniset
 
             static UniSetActivatorPtr Instance();
 
+#ifndef DISABLE_REST_API
+            /*! количество потоков http-сервера по умолчанию (--activator-httpserver-max-threads) */
+            static const int httpDefaultMaxThreads = 16;
+#endif
+
             /*! Print command line help */
             static void help_print();
 
@@ -145,6 +155,8 @@ namespace uniset
             std::vector<std::string> httpTrustedProxies;
             bool httpBearerRequired = { false };
             std::vector<std::string> httpBearerTokens;
+            int httpMaxThreads = { httpDefaultMaxThreads };
+            int httpMaxQueued = { 100 };
 #endif
     };
     // -------------------------------------------------------------------------
@@ -31,6 +31,7 @@
 #include <memory>
 #include <string>
 #include <list>
+#include <vector>
 
 #include "UniSetTypes.h"
 #include "MessageType.h"
@@ -40,7 +41,7 @@
 #include "UniSetObject_i.hh"
 #include "ThreadCreator.h"
 #include "LT_Object.h"
-#include "MQMutex.h"
+#include "MQRing.h"
 #include "UHttpRequestHandler.h"
 
 //---------------------------------------------------------------------------
@@ -69,6 +70,15 @@ namespace uniset
      * Соответственно сообщения вынимаются в порядке поступления, но сперва из Hi, потом из Medium, а потом из Low очереди.
      * \warning Если сообщения будут поступать в Hi или Medium очередь быстрее чем они обрабатываются, то до Low сообщений дело может и не дойти.
      *
+     *  Очереди построены на MQRing (без блокировок, сообщения хранятся в самой очереди).
+     *  Память под очередь выделяется сразу, поэтому при размере очереди (--uniset-object-size-message-queue)
+     *  больше MQRing::MaxRingSize используется очередь с блокировкой, растущая по мере необходимости.
+     *  Поток обработки забирает сообщения пачками (см. processMessages()), размер пачки задаётся
+     *  параметром --uniset-object-message-batch (по умолчанию 100).
+     *
+     *  Режим "event loop" (см. setEventLoopMode()): поток обработки ожидает в epoll сразу
+     *  поступление сообщений, срабатывание таймеров и события по дополнительным дескрипторам.
+     *
     */
     class UniSetObject:
         public std::enable_shared_from_this<UniSetObject>,
@@ -152,6 +162,13 @@ namespace uniset
             /*! Ожидать сообщения заданное время */
             VoidMessagePtr waitMessage( timeout_t msec = UniSetTimer::WaitUpTime );
 
+            /*! Обработать имеющиеся сообщения (не больше maxCount), без выделения памяти под каждое сообщение.
+             * Сообщения забираются из очередей пачками, в порядке приоритета.
+             * Вызывается только из потока обработки сообщений.
+             * \return количество обработанных сообщений
+             */
+            size_t processMessages( size_t maxCount );
+
             /*! прервать ожидание сообщений */
             void termWaiting();
 
@@ -191,6 +208,26 @@ namespace uniset
             /*! установить приоритет для потока обработки сообщений (если позволяют права и система) */
             void setThreadPriority( Poco::Thread::Priority p );
 
+            /*! Режим "event loop" для потока обработки сообщений (только Linux). Вызывать до активации объекта.
+             * Ожидание идёт в epoll (см. PassiveEpollTimer) сразу по:
+             * - поступлению сообщений ("звонок" eventfd; пачка сообщений стоит одного пробуждения),
+             * - таймеру ожидания (timerfd), при этом точность askTimer() - 1 мсек, а не UniSetTimer::MinQuantityTime,
+             * - дополнительным дескрипторам (addWaitFd(), обработка в fdEvent()).
+             * Для всех объектов процесса включается параметром --uniset-object-event-loop 1
+             * throw SystemError
+             */
+            void setEventLoopMode( bool set );
+            bool isEventLoopMode() const noexcept;
+
+            /*! добавить дескриптор в ожидание (только в режиме event loop)
+             * \param events - маска событий epoll (EPOLLIN, EPOLLOUT, ...)
+             */
+            bool addWaitFd( int fd, uint32_t events = EPOLLIN );
+            bool removeWaitFd( int fd );
+
+            /*! событие по дескриптору, добавленному через addWaitFd() (вызывается в потоке обработки сообщений) */
+            virtual void fdEvent( int fd, uint32_t events ) {}
+
             /*! установка размера очереди сообщений */
             void setMaxSizeOfMessageQueue( size_t s );
 
@@ -210,6 +247,7 @@ namespace uniset
             Poco::JSON::Object::Ptr request_configure_get( const std::string& req, const Poco::URI::QueryParameters& p );
             Poco::JSON::Object::Ptr request_configure_by_name( const std::string& name, const std::string& props );
             Poco::JSON::Object::Ptr request_params( const std::string& req, const Poco::URI::QueryParameters& p );
+            Poco::JSON::Object::Ptr request_latency( const std::string& req, const Poco::URI::QueryParameters& p );
             virtual Poco::JSON::Object::Ptr request_params_get( const std::string& req, const Poco::URI::QueryParameters& p );
             virtual Poco::JSON::Object::Ptr request_params_set( const std::string& req, const Poco::URI::QueryParameters& p );
 #endif
@@ -242,6 +280,7 @@ namespace uniset
 
             bool threadcreate;
             std::unique_ptr<UniSetTimer> tmr;
+            PassiveEpollTimer* evtmr = { nullptr }; // tmr в режиме event loop
             uniset::ObjectId myid;
             CORBA::Object_var oref;
 
@@ -251,9 +290,12 @@ namespace uniset
             std::unique_ptr< ThreadCreator<UniSetObject> > thr;
 
             /*! очереди сообщений в зависимости от приоритета */
-            MQMutex mqueueLow;
-            MQMutex mqueueMedium;
-            MQMutex mqueueHi;
+            MQRing mqueueLow;
+            MQRing mqueueMedium;
+            MQRing mqueueHi;
+
+            /*! буфер для извлечения сообщений пачкой (см. processMessages) */
+            std::vector<MQRing::Item> mbatch;
 
             bool a_working;
             std::mutex    m_working;
@@ -2,7 +2,7 @@
 #ifndef ModbusTCPCore_H_
 #define ModbusTCPCore_H_
 // -------------------------------------------------------------------------
-#include <queue>
+#include <vector>
 #include "ModbusRTUErrors.h"
 #include "UTCPStream.h"
 // -------------------------------------------------------------------------
@@ -12,17 +12,82 @@ namespace uniset
     /*!    ModbusTCP core functions */
     namespace ModbusTCPCore
     {
+        /*! Буфер приёма.
+         * Непрерывная область памяти, в которую данные читаются из сокета "пачками"
+         * и из которой забираются без побайтового копирования.
+         * Непрочитанные данные всегда лежат одним куском (data(),size()),
+         * поэтому заголовок и весь кадр можно разбирать "на месте".
+         * Память переиспользуется: при нехватке места в конце буфера
+         * непрочитанный остаток (обычно не больше одного кадра) сдвигается в начало.
+         */
+        class RecvBuffer
+        {
+            public:
+                static const size_t defaultCapacity = 4096;
+
+                explicit RecvBuffer( size_t capacity = defaultCapacity );
+
+                inline size_t size() const noexcept
+                {
+                    return wpos - rpos;
+                }
+                inline bool empty() const noexcept
+                {
+                    return wpos == rpos;
+                }
+
+                // начало непрочитанных данных
+                inline const unsigned char* data() const noexcept
+                {
+                    return buf.data() + rpos;
+                }
+
+                // сколько всего байт было извлечено из буфера (используется для контроля границ кадра)
+                inline size_t total() const noexcept
+                {
+                    return rtotal;
+                }
+
+                // скопировать не более len байт в out и удалить их из буфера
+                size_t read( unsigned char* out, size_t len ) noexcept;
+
+                // удалить из буфера len байт
+                void consume( size_t len ) noexcept;
+                void clear() noexcept;
+
+                // запись: получить место не менее чем под len байт (в конце буфера),
+                // записать туда данные и подтвердить запись commit(n)
+                unsigned char* prepare( size_t len );
+                inline size_t space() const noexcept
+                {
+                    return buf.size() - wpos;
+                }
+                inline void commit( size_t len ) noexcept
+                {
+                    wpos += len;
+                }
+
+            private:
+                std::vector<unsigned char> buf;
+                size_t rpos = { 0 };
+                size_t wpos = { 0 };
+                size_t rtotal = { 0 };
+        };
+
         // Если соединение закрыто (другой стороной), функции выкидывают исключение uniset::CommFailed
 
         // t - msec (сколько ждать)
-        size_t readNextData(UTCPStream* tcp, std::queue<unsigned char>& qrecv, size_t max = 100);
-        size_t getNextData( UTCPStream* tcp, std::queue<unsigned char>& qrecv, unsigned char* buf, size_t len );
+        size_t readNextData(UTCPStream* tcp, RecvBuffer& rbuf, size_t max = 100);
+        size_t getNextData( UTCPStream* tcp, RecvBuffer& rbuf, unsigned char* buf, size_t len );
         ModbusRTU::mbErrCode sendData(UTCPStream* tcp, unsigned char* buf, size_t len );
 
         // работа напрямую с сокетом
-        size_t readDataFD(int fd, std::queue<unsigned char>& qrecv, size_t max = 100, size_t attempts = 1 );
-        size_t getDataFD( int fd, std::queue<unsigned char>& qrecv, unsigned char* buf, size_t len, size_t attempts = 1 );
+        size_t readDataFD(int fd, RecvBuffer& rbuf, size_t max = 100, size_t attempts = 1 );
+        size_t getDataFD( int fd, RecvBuffer& rbuf, unsigned char* buf, size_t len, size_t attempts = 1 );
         ModbusRTU::mbErrCode sendDataFD( int fd, unsigned char* buf, size_t len );
+
+        // в буфере есть целиком принятый кадр (MBAP заголовок + данные)
+        bool hasFrame( const RecvBuffer& rbuf ) noexcept;
     }
     // -------------------------------------------------------------------------
 } // end of namespace uniset
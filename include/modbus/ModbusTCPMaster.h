@@ -8,6 +8,7 @@
 #include "UTCPStream.h"
 #include "ModbusTypes.h"
 #include "ModbusClient.h"
+#include "ModbusTCPCore.h"
 // -------------------------------------------------------------------------
 namespace uniset
 {
@@ -55,7 +56,7 @@ namespace uniset
             //ost::TCPStream* tcp;
             std::shared_ptr<UTCPStream> tcp;
             ModbusRTU::ModbusData nTransaction;
-            std::queue<unsigned char> qrecv;
+            ModbusTCPCore::RecvBuffer rbuf;
             PassiveTimer ptTimeout;
             std::string iaddr = { "" };
             int port = { 0 };
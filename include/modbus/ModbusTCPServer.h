@@ -132,7 +132,6 @@ namespace uniset
             int port = { 0 };
             std::string iaddr;
             std::string myname;
-            std::queue<unsigned char> qrecv;
             ModbusRTU::MBAPHeader curQueryHeader;
 
             std::mutex sMutex;
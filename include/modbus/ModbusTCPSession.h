@@ -8,6 +8,7 @@
 #include <ev++.h>
 #include "ModbusServerSlot.h"
 #include "ModbusServer.h"
+#include "ModbusTCPCore.h"
 #include "PassiveTimer.h"
 #include "UTCPCore.h"
 #include "UTCPStream.h"
@@ -73,6 +74,7 @@ namespace uniset
             virtual void setChannelTimeout( timeout_t msec ) override;
             virtual ModbusRTU::mbErrCode sendData( unsigned char* buf, int len ) override;
             virtual ModbusRTU::mbErrCode tcp_processing( ModbusRTU::MBAPHeader& mhead );
+            ModbusRTU::mbErrCode processFrame( const std::unordered_set<ModbusRTU::ModbusAddr>& vmbaddr, timeout_t msec );
             virtual ModbusRTU::mbErrCode make_adu_header( ModbusRTU::ModbusMessage& request ) override;
             virtual ModbusRTU::mbErrCode post_send_request(ModbusRTU::ModbusMessage& request ) override;
 
@@ -119,7 +121,8 @@ namespace uniset
                     ModbusRTU::FileTransferRetMessage& reply ) override;
 
         private:
-            std::queue<unsigned char> qrecv;
+            ModbusTCPCore::RecvBuffer rbuf;
+            size_t frameEnd = { 0 }; // позиция (rbuf.total()) конца текущего кадра
             std::unordered_set<ModbusRTU::ModbusAddr> vaddr;
             ModbusRTU::MBAPHeader curQueryHeader;
             PassiveTimer ptTimeout;
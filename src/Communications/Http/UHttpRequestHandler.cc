@@ -298,12 +298,21 @@ namespace uniset
 
             // Все остальные запросы — через registry->httpRequest()
             auto json = registry->httpRequest(ctx);
+
+            // ответ уже отправлен самим обработчиком (например поток SSE)
+            if( !json || resp.sent() )
+                return;
+
             std::ostream& out = resp.send();
             json->stringify(out);
             out.flush();
         }
         catch( std::exception& ex )
         {
+            // ответ уже (частично) отправлен, сообщить об ошибке нельзя
+            if( resp.sent() )
+                return;
+
             ostringstream err;
             err << ex.what();
 
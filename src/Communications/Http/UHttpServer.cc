@@ -18,7 +18,9 @@
 #include <sstream>
 #include <cstring>
 #include <stdexcept>
+#include <algorithm>
 #include <Poco/URI.h>
+#include "unisetstd.h"
 #include "UHttpServer.h"
 #include "Exceptions.h"
 // -------------------------------------------------------------------------
@@ -130,22 +132,26 @@ namespace uniset
     }
     // -------------------------------------------------------------------------
 
-    UHttpServer::UHttpServer(std::shared_ptr<IHttpRequestRegistry>& supplier, const std::string& _host, int _port ):
+    UHttpServer::UHttpServer(std::shared_ptr<IHttpRequestRegistry>& supplier, const std::string& _host, int _port, int maxThreads, int maxQueued ):
         sa(_host, _port)
     {
         try
         {
 			mylog = std::make_shared<DebugStream>();
 
-			/*! \FIXME: доделать конфигурирование параметров */
+			maxThreads = std::max(maxThreads, 1);
+
 			HTTPServerParams* httpParams = new HTTPServerParams;
-			httpParams->setMaxQueued(100);
-			httpParams->setMaxThreads(1);
+			httpParams->setMaxQueued(std::max(maxQueued, 1));
+			httpParams->setMaxThreads(maxThreads);
 
 			// HTTPServer takes ownership of factory and will delete it
 			reqFactory = new UHttpRequestHandlerFactory(supplier);
 
-			http = std::make_shared<Poco::Net::HTTPServer>(reqFactory, ServerSocket(sa), httpParams );
+			// свой пул потоков, т.к. общий пул Poco (defaultPool) ограничен 16 потоками
+			pool = unisetstd::make_unique<Poco::ThreadPool>(1, maxThreads);
+
+			http = std::make_shared<Poco::Net::HTTPServer>(reqFactory, *pool, ServerSocket(sa), httpParams );
 		}
 		catch( std::exception& ex )
 		{
@@ -154,7 +160,7 @@ namespace uniset
 			throw uniset::SystemError(err.str());
 		}
 
-		mylog->info() << "(UHttpServer::init): init " << _host << ":" << _port << std::endl;
+		mylog->info() << "(UHttpServer::init): init " << _host << ":" << _port << " maxThreads=" << maxThreads << std::endl;
 	}
 	// -------------------------------------------------------------------------
 	UHttpServer::~UHttpServer()
@@ -14,8 +14,12 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 // -------------------------------------------------------------------------
+#include <cstring>
+#include <algorithm>
+#include <unistd.h>
 #include <Poco/Net/NetException.h>
 #include "modbus/ModbusTCPCore.h"
+#include "modbus/ModbusTypes.h"
 #include "Exceptions.h"
 // -------------------------------------------------------------------------
 namespace uniset
@@ -24,11 +28,77 @@ namespace uniset
     using namespace std;
     using namespace ModbusRTU;
     // -------------------------------------------------------------------------
-#define USE_BUFFER_FOR_READ 1
 #define DEFAULT_BUFFER_SIZE_FOR_READ 255
     // -------------------------------------------------------------------------
-    size_t ModbusTCPCore::readNextData(UTCPStream* tcp,
-                                       std::queue<unsigned char>& qrecv, size_t max )
+    ModbusTCPCore::RecvBuffer::RecvBuffer( size_t capacity ):
+        buf(capacity)
+    {
+    }
+    // -------------------------------------------------------------------------
+    size_t ModbusTCPCore::RecvBuffer::read( unsigned char* out, size_t len ) noexcept
+    {
+        len = std::min(len, size());
+
+        if( len > 0 )
+        {
+            memcpy(out, buf.data() + rpos, len);
+            consume(len);
+        }
+
+        return len;
+    }
+    // -------------------------------------------------------------------------
+    void ModbusTCPCore::RecvBuffer::consume( size_t len ) noexcept
+    {
+        len = std::min(len, size());
+        rpos += len;
+        rtotal += len;
+
+        if( rpos == wpos )
+            rpos = wpos = 0;
+    }
+    // -------------------------------------------------------------------------
+    void ModbusTCPCore::RecvBuffer::clear() noexcept
+    {
+        rtotal += size();
+        rpos = wpos = 0;
+    }
+    // -------------------------------------------------------------------------
+    unsigned char* ModbusTCPCore::RecvBuffer::prepare( size_t len )
+    {
+        if( space() < len )
+        {
+            // сдвигаем непрочитанный остаток в начало
+            if( rpos > 0 )
+            {
+                const size_t sz = size();
+
+                if( sz > 0 )
+                    memmove(buf.data(), buf.data() + rpos, sz);
+
+                rpos = 0;
+                wpos = sz;
+            }
+
+            if( space() < len )
+                buf.resize(wpos + len);
+        }
+
+        return buf.data() + wpos;
+    }
+    // -------------------------------------------------------------------------
+    bool ModbusTCPCore::hasFrame( const RecvBuffer& rbuf ) noexcept
+    {
+        if( rbuf.size() < sizeof(MBAPHeader) )
+            return false;
+
+        // поле len (big-endian) - третье в заголовке
+        const unsigned char* p = rbuf.data() + 2 * sizeof(ModbusData);
+        const size_t len = ((size_t)p[0] << 8) | p[1];
+        return rbuf.size() >= sizeof(MBAPHeader) + len;
+    }
+    // -------------------------------------------------------------------------
+    size_t ModbusTCPCore::readNextData(UTCPStream* tcp, RecvBuffer& rbuf, size_t max )
     {
         if( !tcp ) // || !tcp->available() )
             return 0;
@@ -36,21 +106,18 @@ namespace uniset
         size_t i = 0;
         bool commfail = false;
 
-#ifdef USE_BUFFER_FOR_READ
-
         max = std::max(max, (size_t)DEFAULT_BUFFER_SIZE_FOR_READ);
 
-        char* buf = new char[max];
+        // читаем сразу в буфер приёма (сколько поместится)
+        unsigned char* p = rbuf.prepare(max);
 
         try
         {
-            ssize_t l = tcp->receiveBytes(buf, max);
+            ssize_t l = tcp->receiveBytes(p, rbuf.space());
 
             if( l > 0 )
             {
-                for( ssize_t k = 0; k < l; k++ )
-                    qrecv.push(buf[k]);
-
+                rbuf.commit(l);
                 i = l;
             }
 
@@ -67,35 +134,6 @@ namespace uniset
             commfail = true;
         }
 
-        delete [] buf;
-#else
-
-        try
-        {
-            for( ; i < max; i++ )
-            {
-                // (не оптимально): читаем один символ за раз..
-                unsigned char c;
-                ssize_t l = tcp->readData(&c, sizeof(c), 0, t);
-
-                if( l == 0 )
-                {
-                    commfail = true;
-                    break;
-                }
-
-                if( l < 0 )
-                    break;
-
-                qrecv.push(c);
-            }
-        }
-        catch( ost::SockException& e )
-        {
-        }
-
-#endif
-
         if( commfail )
             throw uniset::CommFailed();
 
@@ -103,10 +141,10 @@ namespace uniset
     }
     // ------------------------------------------------------------------------
     size_t ModbusTCPCore::getNextData(UTCPStream* tcp,
-                                      std::queue<unsigned char>& qrecv,
+                                      RecvBuffer& rbuf,
                                       unsigned char* buf, size_t len)
     {
-        if( qrecv.empty() || qrecv.size() < len )
+        if( rbuf.size() < len )
         {
             if( !tcp ) // || !tcp->available() )
                 return 0;
@@ -116,51 +154,37 @@ namespace uniset
 
             try
             {
-                size_t ret = ModbusTCPCore::readNextData(tcp, qrecv, len);
+                size_t ret = ModbusTCPCore::readNextData(tcp, rbuf, len);
 
                 if( ret == 0 )
                     return 0;
             }
             catch( uniset::CommFailed& ex )
             {
-                if( qrecv.empty() )
+                if( rbuf.empty() )
                     return 0;
             }
         }
 
-        size_t i = 0;
-
-        for( ; i < len && !qrecv.empty(); i++ )
-        {
-            buf[i] = qrecv.front();
-            qrecv.pop();
-        }
-
-        return i;
+        return rbuf.read(buf, len);
     }
     // -------------------------------------------------------------------------
-    size_t ModbusTCPCore::readDataFD( int fd, std::queue<unsigned char>& qrecv, size_t max, size_t attempts )
+    size_t ModbusTCPCore::readDataFD( int fd, RecvBuffer& rbuf, size_t max, size_t attempts )
     {
         bool commfail = false;
 
-#ifdef USE_BUFFER_FOR_READ
-
         max = std::max(max, (size_t)DEFAULT_BUFFER_SIZE_FOR_READ);
 
-        char* buf = new char[max];
-
-        ssize_t l = 0;
         size_t cnt = 0;
 
         for( size_t a = 0; a < attempts; a++ )
         {
-            l = ::read(fd, buf, max);
+            unsigned char* p = rbuf.prepare(max);
+            ssize_t l = ::read(fd, p, rbuf.space());
 
             if( l > 0 )
             {
-                for( int k = 0; k < l; k++ )
-                    qrecv.push(buf[k]);
-
+                rbuf.commit(l);
                 cnt += l;
 
                 if( cnt >= max )
@@ -172,71 +196,35 @@ namespace uniset
                 commfail = true;
         }
 
-        delete [] buf;
-#else
-
-        size_t i = 0;
-
-        for( size_t a = 0; a < attempts; a++ )
-        {
-            for( ; i < max; i++ )
-            {
-                // (не оптимально): читаем один символ за раз..
-                unsigned char c;
-                ssize_t l = ::read(fd, &c, sizeof(c));
-
-                if( l == 0 )
-                {
-                    commfail = true;
-                    break;
-                }
-
-                if( l < 0 )
-                    break;
-
-                qrecv.push(c);
-            }
-        }
-
-#endif
-
         if( commfail )
             throw uniset::CommFailed();
 
-        return std::min(qrecv.size(), max);
+        return std::min(rbuf.size(), max);
     }
     // ------------------------------------------------------------------------
-    size_t ModbusTCPCore::getDataFD( int fd, std::queue<unsigned char>& qrecv,
+    size_t ModbusTCPCore::getDataFD( int fd, RecvBuffer& rbuf,
                                      unsigned char* buf, size_t len, size_t attempts )
     {
-        if( qrecv.empty() || qrecv.size() < len )
+        if( rbuf.size() < len )
         {
             if( len == 0 )
                 len = 7;
 
             try
             {
-                size_t ret = ModbusTCPCore::readDataFD(fd, qrecv, len, attempts);
+                size_t ret = ModbusTCPCore::readDataFD(fd, rbuf, len, attempts);
 
-                if( ret == 0 && qrecv.empty() )
+                if( ret == 0 && rbuf.empty() )
                     return 0;
             }
             catch( uniset::CommFailed& ex )
             {
-                if( qrecv.empty() )
+                if( rbuf.empty() )
                     return 0;
             }
         }
 
-        size_t i = 0;
-
-        for( ; i < len && !qrecv.empty(); i++ )
-        {
-            buf[i] = qrecv.front();
-            qrecv.pop();
-        }
-
-        return i;
+        return rbuf.read(buf, len);
     }
     // -------------------------------------------------------------------------
     mbErrCode ModbusTCPCore::sendData(UTCPStream* tcp, unsigned char* buf, size_t len )
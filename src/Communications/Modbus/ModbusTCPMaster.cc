@@ -51,7 +51,7 @@ namespace uniset
     // -------------------------------------------------------------------------
     size_t ModbusTCPMaster::getNextData( unsigned char* buf, size_t len )
     {
-        return ModbusTCPCore::getNextData(tcp.get(), qrecv, buf, len );
+        return ModbusTCPCore::getNextData(tcp.get(), rbuf, buf, len );
     }
     // -------------------------------------------------------------------------
     void ModbusTCPMaster::setChannelTimeout( timeout_t msec )
@@ -159,8 +159,7 @@ namespace uniset
 
             // чистим очередь
             //        cleanInputStream();
-            while( !qrecv.empty() )
-                qrecv.pop();
+            rbuf.clear();
 
             //tcp->sync();
 
@@ -178,8 +178,17 @@ namespace uniset
     // -------------------------------------------------------------------------
     void ModbusTCPSession::readEvent( ev::io& watcher )
     {
-        if( receive(vaddr, timeout) == erSessionClosed )
-            cancelled = true;
+        // клиент может посылать запросы не дожидаясь ответов,
+        // поэтому обрабатываем все целиком принятые кадры, лежащие в буфере
+        do
+        {
+            if( receive(vaddr, timeout) == erSessionClosed )
+            {
+                cancelled = true;
+                return;
+            }
+        }
+        while( !cancelled && ModbusTCPCore::hasFrame(rbuf) );
     }
     // -------------------------------------------------------------------------
     void ModbusTCPSession::writeEvent( ev::io& watcher )
@@ -219,69 +228,85 @@ namespace uniset
             res = tcp_processing(buf.mbaphead);
 
             if( res != erNoError )
+            {
+                // кадр не разобран, границы следующего неизвестны
+                rbuf.clear();
                 return res;
+            }
 
-            if( msec != UniSetTimer::WaitUpTime )
-            {
-                msec = ptTimeout.getLeft(msec);
+            res = processFrame(vmbaddr, msec);
 
-                if( msec == 0 ) // времени для ответа не осталось..
-                    return erTimeOut;
-            }
+            // пропускаем не разобранный остаток кадра
+            // (чтобы следующий кадр в буфере начинался с заголовка)
+            if( rbuf.total() < frameEnd )
+                rbuf.consume(frameEnd - rbuf.total());
+        }
+        catch( uniset::CommFailed& ex )
+        {
+            cancelled = true;
+            return erSessionClosed;
+        }
 
-            if( qrecv.empty() )
-                return erTimeOut;
+        return res;
+    }
+    // -------------------------------------------------------------------------
+    ModbusRTU::mbErrCode ModbusTCPSession::processFrame( const std::unordered_set<ModbusAddr>& vmbaddr, timeout_t msec )
+    {
+        ModbusRTU::mbErrCode res = erTimeOut;
 
-            if( cancelled )
-                return erSessionClosed;
+        if( msec != UniSetTimer::WaitUpTime )
+        {
+            msec = ptTimeout.getLeft(msec);
 
-            // запоминаем принятый заголовок,
-            // для формирования ответа (см. make_adu_header)
-            curQueryHeader = buf.mbaphead;
+            if( msec == 0 ) // времени для ответа не осталось..
+                return erTimeOut;
+        }
 
-            if( dlog->is_level9() )
-                dlog->level9() << "(ModbusTCPSession::recv): ADU len=" << curQueryHeader.len << endl;
+        if( rbuf.empty() )
+            return erTimeOut;
 
-            res = recv( vmbaddr, buf, msec );
+        if( cancelled )
+            return erSessionClosed;
 
-            if( cancelled )
-                return erSessionClosed;
+        // запоминаем принятый заголовок,
+        // для формирования ответа (см. make_adu_header)
+        curQueryHeader = buf.mbaphead;
 
-            if( res != erNoError ) // && res!=erBadReplyNodeAddress )
-            {
-                if( res < erInternalErrorCode )
-                {
-                    ErrorRetMessage::make_to( buf.addr(), buf.func(), res, buf );
-                    send(buf);
-                    printProcessingTime();
-                }
-                else if( aftersend_msec > 0 )
-                    iowait(aftersend_msec);
+        if( dlog->is_level9() )
+            dlog->level9() << "(ModbusTCPSession::recv): ADU len=" << curQueryHeader.len << endl;
 
-                return res;
-            }
+        res = recv( vmbaddr, buf, msec );
 
-            if( msec != UniSetTimer::WaitUpTime )
-            {
-                msec = ptTimeout.getLeft(msec);
+        if( cancelled )
+            return erSessionClosed;
 
-                if( msec == 0 )
-                    return erTimeOut;
+        if( res != erNoError ) // && res!=erBadReplyNodeAddress )
+        {
+            if( res < erInternalErrorCode )
+            {
+                ErrorRetMessage::make_to( buf.addr(), buf.func(), res, buf );
+                send(buf);
+                printProcessingTime();
             }
+            else if( aftersend_msec > 0 )
+                iowait(aftersend_msec);
 
-            if( cancelled )
-                return erSessionClosed;
-
-            // processing message...
-            res = processing(buf);
+            return res;
         }
-        catch( uniset::CommFailed& ex )
+
+        if( msec != UniSetTimer::WaitUpTime )
         {
-            cancelled = true;
-            return erSessionClosed;
+            msec = ptTimeout.getLeft(msec);
+
+            if( msec == 0 )
+                return erTimeOut;
         }
 
-        return res;
+        if( cancelled )
+            return erSessionClosed;
+
+        // processing message...
+        return processing(buf);
     }
     // -------------------------------------------------------------------------
     void ModbusTCPSession::final()
@@ -297,7 +322,7 @@ namespace uniset
     // -------------------------------------------------------------------------
     size_t ModbusTCPSession::getNextData( unsigned char* buf, int len )
     {
-        ssize_t res = ModbusTCPCore::getDataFD( sock->getSocket(), qrecv, buf, len );
+        ssize_t res = ModbusTCPCore::getDataFD( sock->getSocket(), rbuf, buf, len );
 
         try
         {
@@ -325,12 +350,8 @@ namespace uniset
     // --------------------------------------------------------------------------------
     mbErrCode ModbusTCPSession::tcp_processing( ModbusRTU::MBAPHeader& mhead )
     {
-        // чистим очередь
-        while( !qrecv.empty() )
-            qrecv.pop();
-
+        // буфер не чистим: в нём может лежать следующий запрос (принятый вместе с предыдущим)
         size_t len = getNextData((unsigned char*)(&mhead), sizeof(mhead));
-        //size_t len = ModbusTCPCore::getDataFD( sfd, qrecv, (unsigned char*)(&mhead), sizeof(mhead) );
 
         if( len < sizeof(mhead) )
         {
@@ -370,20 +391,30 @@ namespace uniset
             return erInvalidFormat;
         }
 
-        pt.setTiming(10);
+        frameEnd = rbuf.total() + mhead.len;
 
-        try
+        // обычно кадр уже целиком в буфере (прочитан вместе с заголовком)
+        len = rbuf.size();
+
+        if( len < mhead.len )
         {
-            do
+            pt.setTiming(10);
+
+            try
             {
-                len = ModbusTCPCore::readDataFD( sock->getSocket(), qrecv, mhead.len );
+                do
+                {
+                    ModbusTCPCore::readDataFD( sock->getSocket(), rbuf, mhead.len - len );
 
-                if( len == 0 )
-                    io.loop.iteration();
+                    if( rbuf.size() == len )
+                        io.loop.iteration();
+
+                    len = rbuf.size();
+                }
+                while( len < mhead.len && !pt.checkTime() );
             }
-            while( len == 0 && !pt.checkTime() );
+            catch( const uniset::CommFailed& ex ) {}
         }
-        catch( const uniset::CommFailed& ex ) {}
 
         if( len < mhead.len )
         {
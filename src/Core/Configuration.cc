@@ -37,6 +37,7 @@
 #include "ObjectIndex_idXML.h"
 #include "ObjectIndex_hashXML.h"
 #include "UniSetActivator.h"
+#include "LatencyTrace.h"
 // -------------------------------------------------------------------------
 using namespace std;
 // -------------------------------------------------------------------------
@@ -76,12 +77,14 @@ std::string uniset::Configuration::help()
     print_help(os, 25, "--uniset-port num", "использовать заданный порт (переопределяет 'port заданный в конф. файле в разделе <nodes><node.. port=''>)\n");
     print_help(os, 25, "--localIOR {1,0}", "использовать локальные файлы для получения IOR (т.е. не использовать omniNames). Переопределяет параметр в конфигурационном файле.\n");
     print_help(os, 25, "--transientIOR {1,0}", "использовать генерируемые IOR(не постоянные). Переопределяет параметр в конфигурационном файле. Default=0\n");
+    print_help(os, 25, "--uniset-latency-trace percent", "трассировка задержек для percent% изменений датчиков (см. LatencyTrace.h). Default=0 (отключено)\n");
     os << "\ndebug logs:\n";
     print_help(os, 25, "--ulog-add-levels", "добавить уровень вывода логов\n");
     print_help(os, 25, "--ulog-del-levels", "удалить уровень вывода логов\n");
     print_help(os, 25, "--ulog-show-microseconds", "Выводить время с микросекундами\n");
     print_help(os, 25, "--ulog-show-milliseconds", "Выводить время с миллисекундами\n");
     print_help(os, 25, "--ulog-show-localtime", "Выводить локальное время. По умолчанию UTC.\n");
+    print_help(os, 25, "--ulog-binary-mode", "\"отложенный\" вывод логов (ublog) фоновым потоком\n");
     print_help(os, 25, "--ulog-no-debug", "отключение логов\n");
     print_help(os, 25, "--ulog-logfile", "перенаправление лога в файл\n");
     print_help(os, 25, "--ulog-levels N", "уровень 'говорливости' логов");
@@ -345,6 +348,10 @@ namespace uniset
             // считываем список узлов
             createNodesList();
 
+            // трассировка задержек (см. LatencyTrace.h)
+            LatencyTrace::setLocalNode(localNode);
+            LatencyTrace::setSampling( atof(getArgParam("--uniset-latency-trace", "0").c_str()) );
+
             std::list< std::pair<string, string> > omniParams;
             // ---------------------------------------------------------------------------------
             UniXML::iterator omniIt(unixml->findNode(unixml->getFirstNode(), "omniORB") );
@@ -774,6 +781,7 @@ namespace uniset
 
         localNodeName = nodename;
         oind->initLocalNode(localNode);
+        LatencyTrace::setLocalNode(localNode);
     }
     // -------------------------------------------------------------------------
     bool Configuration::checkOmniORBendPoint( const std::string& endPoint )
@@ -1088,6 +1096,9 @@ namespace uniset
 
             if( getPIntProp(dnode, "showLocalTime", 0) != 0 )
                 deb->showLocalTime(true);
+
+            if( getPIntProp(dnode, "binaryMode", 0) != 0 )
+                deb->binaryMode(true);
         }
 
         // теперь смотрим командную строку
@@ -1098,6 +1109,13 @@ namespace uniset
         const string show_usec("--" + debname + "-show-microseconds");
         const string verb_level("--" + debname + "-verbosity");
         const string show_localtime("--" + debname + "-show-localtime");
+        const string binary_mode("--" + debname + "-binary-mode");
+
+        for (int i = 1; i < _argc; i++)
+        {
+            if( binary_mode == _argv[i] )
+                deb->binaryMode(true);
+        }
 
         // смотрим командную строку
         for (int i = 1; i < (_argc - 1); i++)
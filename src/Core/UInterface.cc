@@ -577,6 +577,29 @@ namespace uniset
     void UInterface::askRemoteSensor( const uniset::ObjectId id, UniversalIO::UIOCommand cmd,
                                       const uniset::ObjectId node,
                                       uniset::ObjectId backid ) const
+    {
+        askRemoteSensorWithFilter(id, cmd, node, backid, nullptr);
+    }
+
+    void UInterface::askRemoteSensor( const uniset::ObjectId id, UniversalIO::UIOCommand cmd,
+                                      const uniset::ObjectId node,
+                                      const IONotifyController_i::NotifyFilter& filter,
+                                      uniset::ObjectId backid ) const
+    {
+        askRemoteSensorWithFilter(id, cmd, node, backid, &filter);
+    }
+
+    void UInterface::askSensor( const uniset::ObjectId id, UniversalIO::UIOCommand cmd,
+                                const IONotifyController_i::NotifyFilter& filter,
+                                uniset::ObjectId backid ) const
+    {
+        askRemoteSensorWithFilter(id, cmd, uconf->getLocalNode(), backid, &filter);
+    }
+
+    void UInterface::askRemoteSensorWithFilter( const uniset::ObjectId id, UniversalIO::UIOCommand cmd,
+            const uniset::ObjectId node,
+            uniset::ObjectId backid,
+            const IONotifyController_i::NotifyFilter* filter ) const
     {
         if( backid == uniset::DefaultObjectId )
             backid = myid;
@@ -615,7 +638,12 @@ namespace uniset
                     uniset::ConsumerInfo_var ci = new uniset::ConsumerInfo();
                     ci->id = backid;
                     ci->node = uconf->getLocalNode();
-                    inc->askSensor(id, ci, cmd );
+
+                    if( filter )
+                        inc->askSensorWithFilter(id, ci, cmd, *filter);
+                    else
+                        inc->askSensor(id, ci, cmd );
+
                     return;
                 }
                 catch( const CORBA::TRANSIENT& ) {}
@@ -2489,6 +2517,12 @@ namespace uniset
     // --------------------------------------------------------------------------------------------
     uniset::IDSeq_var UInterface::askSensorsSeq( const uniset::IDList& lst,
             UniversalIO::UIOCommand cmd, uniset::ObjectId backid )
+    {
+        return askRemoteSensorsSeq(lst, cmd, uconf->getLocalNode(), backid);
+    }
+    // --------------------------------------------------------------------------------------------
+    uniset::IDSeq_var UInterface::askRemoteSensorsSeq( const uniset::IDList& lst, UniversalIO::UIOCommand cmd,
+            uniset::ObjectId node, uniset::ObjectId backid )
     {
         if( lst.empty() )
             return uniset::IDSeq_var();
@@ -2499,6 +2533,9 @@ namespace uniset
         if( backid == uniset::DefaultObjectId )
             throw uniset::IOBadParam("UI(askSensorSeq): unknown back ID");
 
+        if( node == uniset::DefaultObjectId )
+            node = uconf->getLocalNode();
+
         uniset::ObjectId sid = lst.getFirst();
 
         if ( sid == uniset::DefaultObjectId )
@@ -2510,7 +2547,7 @@ namespace uniset
 
             try
             {
-                oref = rcache.resolve(sid, uconf->getLocalNode());
+                oref = rcache.resolve(sid, node);
             }
             catch( const uniset::NameNotFound&  ) {}
 
@@ -2519,7 +2556,7 @@ namespace uniset
                 try
                 {
                     if( CORBA::is_nil(oref) )
-                        oref = resolve(sid, uconf->getLocalNode());
+                        oref = resolve(sid, node);
 
                     IONotifyController_i_var iom = IONotifyController_i::_narrow(oref);
 
@@ -2541,34 +2578,34 @@ namespace uniset
         catch( const uniset::TimeOut& ) {}
         catch(const IOController_i::NameNotFound&  ex)
         {
-            rcache.erase(sid, uconf->getLocalNode());
+            rcache.erase(sid, node);
             throw uniset::NameNotFound("UI(getSensorSeq): " + string(ex.err));
         }
         catch(const IOController_i::IOBadParam& ex)
         {
-            rcache.erase(sid, uconf->getLocalNode());
+            rcache.erase(sid, node);
             throw uniset::IOBadParam("UI(getSensorSeq): " + string(ex.err));
         }
         catch(const IOController_i::AccessDenied& ex)
         {
-            rcache.erase(sid, uconf->getLocalNode());
+            rcache.erase(sid, node);
             throw uniset::AccessDenied("UI(getSensorSeq): " + string(ex.err));
         }
         catch(const uniset::ORepFailed& )
         {
-            rcache.erase(sid, uconf->getLocalNode());
+            rcache.erase(sid, node);
             // не смогли получить ссылку на объект
-            throw uniset::IOBadParam(set_err("UI(askSensorSeq): resolve failed ", sid, uconf->getLocalNode()));
+            throw uniset::IOBadParam(set_err("UI(askSensorSeq): resolve failed ", sid, node));
         }
         catch(const CORBA::NO_IMPLEMENT& )
         {
-            rcache.erase(sid, uconf->getLocalNode());
-            throw uniset::IOBadParam(set_err("UI(askSensorSeq): method no implement", sid, uconf->getLocalNode()));
+            rcache.erase(sid, node);
+            throw uniset::IOBadParam(set_err("UI(askSensorSeq): method no implement", sid, node));
         }
         catch( const CORBA::OBJECT_NOT_EXIST& )
         {
-            rcache.erase(sid, uconf->getLocalNode());
-            throw uniset::IOBadParam(set_err("UI(askSensorSeq): object not exist", sid, uconf->getLocalNode()));
+            rcache.erase(sid, node);
+            throw uniset::IOBadParam(set_err("UI(askSensorSeq): object not exist", sid, node));
         }
         catch( const CORBA::COMM_FAILURE& ex )
         {
@@ -2580,8 +2617,8 @@ namespace uniset
             // uwarn << "UI(getValue): CORBA::SystemException" << endl;
         }
 
-        rcache.erase(sid, uconf->getLocalNode());
-        throw uniset::TimeOut(set_err("UI(askSensorSeq): Timeout", sid, uconf->getLocalNode()));
+        rcache.erase(sid, node);
+        throw uniset::TimeOut(set_err("UI(askSensorSeq): Timeout", sid, node));
     }
     // -----------------------------------------------------------------------------
     IOController_i::ShortMapSeq* UInterface::getSensors( const uniset::ObjectId id, uniset::ObjectId node )
@@ -131,6 +131,8 @@ namespace uniset
             httpTrustedProxies = splitList(conf->getArgParam("--activator-httpserver-trusted-proxies", ""));
             httpBearerRequired = conf->getArgPInt("--activator-httpserver-bearer-required", 0) ? true : false;
             httpBearerTokens = splitList(conf->getArgParam("--activator-httpserver-bearer-tokens", ""));
+            httpMaxThreads = conf->getArgPInt("--activator-httpserver-max-threads", httpDefaultMaxThreads);
+            httpMaxQueued = conf->getArgPInt("--activator-httpserver-max-queued", httpMaxQueued);
         }
 
 #endif
@@ -196,7 +198,7 @@ namespace uniset
             try
             {
                 auto reg = dynamic_pointer_cast<UHttp::IHttpRequestRegistry>(shared_from_this());
-                httpserv = make_shared<UHttp::UHttpServer>(reg, httpHost, httpPort);
+                httpserv = make_shared<UHttp::UHttpServer>(reg, httpHost, httpPort, httpMaxThreads, httpMaxQueued);
                 httpserv->setCORS_allow(httpCORS_allow);
                 httpserv->setDefaultContentType(httpDefaultContentType);
                 httpserv->setWhitelist(httpWhitelist);
@@ -289,6 +291,9 @@ namespace uniset
             ucrit << myname << "(shutdown): " << ex.what() << endl;
         }
 
+        // логи в бинарном режиме (см. DebugBinLog.h): выводим всё записанное до завершения процесса
+        uniset::BinLog::flush();
+
         {
             std::unique_lock<std::mutex> lk(g_donemutex);
             g_done = true;
@@ -345,6 +350,7 @@ namespace uniset
         {
             ulogsys << "(FINISH GUARD THREAD): WAIT TIMEOUT "
                     << TERMINATE_TIMEOUT_SEC << " sec..KILL *******" << endl << flush;
+            uniset::BinLog::flush(500);
             set_signals(false);
             std::abort();
             return;
@@ -444,6 +450,10 @@ namespace uniset
         if( name == "configure" )
             return request_configure(ctx.pathString(), ctx.params);
 
+        // Системная команда: latency (статистика задержек процесса)
+        if( name == "latency" )
+            return request_latency(ctx.depth() > 0 ? ctx[0] : "", ctx.params);
+
         // Запрос к самому активатору
         if( name == myname )
             return UniSetObject::httpRequest(ctx);
@@ -509,6 +519,8 @@ namespace uniset
         cout << "--activator-httpserver-trusted-proxies list  - Trusted proxies for X-Forwarded-For (comma-separated)" << endl;
         cout << "--activator-httpserver-bearer-required 0|1   - Require Bearer token. Default: 0" << endl;
         cout << "--activator-httpserver-bearer-tokens list    - Allowed Bearer tokens (comma-separated)" << endl;
+        cout << "--activator-httpserver-max-threads num       - Max request handler threads. Default: 16" << endl;
+        cout << "--activator-httpserver-max-queued num        - Max connections waiting for a free thread. Default: 100" << endl;
 #else
         cout << "(HTTP server disabled at compile time)" << endl;
 #endif
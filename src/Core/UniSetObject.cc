@@ -20,6 +20,7 @@
 // --------------------------------------------------------------------------
 #include <unordered_map>
 #include <map>
+#include <algorithm>
 #include <unistd.h>
 #include <signal.h>
 #include <iomanip>
@@ -38,6 +39,7 @@
 #include "UniSetManager.h"
 #include "UniSetActivator.h"
 #include "Debug.h"
+#include "LatencyTrace.h"
 
 // ------------------------------------------------------------------------------------------
 using namespace std;
@@ -135,7 +137,19 @@ namespace uniset
         if( sz > 0 )
             setMaxSizeOfMessageQueue(sz);
 
-        uinfo << myname << "(init): SizeOfMessageQueue=" << getMaxSizeOfMessageQueue() << endl;
+        int batch = conf->getArgPInt("--uniset-object-message-batch", 100);
+
+        if( batch <= 0 )
+            batch = 1;
+
+        mbatch.resize(batch);
+
+        if( conf->getArgPInt("--uniset-object-event-loop", 0) )
+            setEventLoopMode(true);
+
+        uinfo << myname << "(init): SizeOfMessageQueue=" << getMaxSizeOfMessageQueue()
+              << " messageBatch=" << mbatch.size()
+              << " eventLoop=" << isEventLoopMode() << endl;
     }
     // ------------------------------------------------------------------------------------------
 
@@ -183,19 +197,72 @@ namespace uniset
         active = set;
     }
     // ------------------------------------------------------------------------------------------
+    static inline void traceDequeue( const VoidMessage* m ) noexcept
+    {
+        if( m->type == Message::SensorInfo )
+        {
+            const SensorMessage* sm = reinterpret_cast<const SensorMessage*>(m);
+
+            if( sm->trace_tm && sm->node == LatencyTrace::localNode() )
+                LatencyTrace::hop(LatencyTrace::Dequeue, sm->trace_tm);
+        }
+    }
+    // ------------------------------------------------------------------------------------------
     /*!
      *    \param  vm - указатель на структуру, которая заполняется, если есть сообщение
      *    \return Возвращает указатель VoidMessagePtr если сообщение есть, и shared_ptr(nullptr) если нет
     */
     VoidMessagePtr UniSetObject::receiveMessage()
     {
+        VoidMessagePtr m;
+
         if( !mqueueHi.empty() )
-            return mqueueHi.top();
+            m = mqueueHi.top();
+        else if( !mqueueMedium.empty() )
+            m = mqueueMedium.top();
+        else
+            m = mqueueLow.top();
 
-        if( !mqueueMedium.empty() )
-            return mqueueMedium.top();
+        if( m )
+            traceDequeue(m.get());
 
-        return mqueueLow.top();
+        return m;
+    }
+    // ------------------------------------------------------------------------------------------
+    size_t UniSetObject::processMessages( size_t maxCount )
+    {
+        size_t count = 0;
+
+        while( count < maxCount )
+        {
+            const size_t num = std::min(mbatch.size(), maxCount - count);
+
+            // пачка берётся из одной очереди (самой приоритетной из непустых)
+            size_t n = mqueueHi.pop(mbatch.data(), num);
+
+            if( n == 0 )
+                n = mqueueMedium.pop(mbatch.data(), num);
+
+            if( n == 0 )
+                n = mqueueLow.pop(mbatch.data(), num);
+
+            if( n == 0 )
+                break;
+
+            for( size_t i = 0; i < n; i++ )
+            {
+                const VoidMessage* m = mbatch[i].get();
+                traceDequeue(m);
+                processingMessage(m);
+
+                // сообщения хранящиеся "по указателю" освобождаем сразу
+                mbatch[i].ext.reset();
+            }
+
+            count += n;
+        }
+
+        return count;
     }
     // ------------------------------------------------------------------------------------------
     VoidMessagePtr UniSetObject::waitMessage( timeout_t timeMS )
@@ -384,18 +451,67 @@ namespace uniset
             thr->setPriority(p);
     }
     // ------------------------------------------------------------------------------------------
-    void UniSetObject::push( const TransportMessage& tm )
+    void UniSetObject::setEventLoopMode( bool set )
     {
-        auto vm = make_shared<VoidMessage>(tm);
+        if( set == isEventLoopMode() )
+            return;
 
-        if( vm->priority == Message::Medium )
-            mqueueMedium.push(vm);
-        else if( vm->priority == Message::High )
-            mqueueHi.push(vm);
-        else if( vm->priority == Message::Low )
-            mqueueLow.push(vm);
+        if( isActive() )
+        {
+            ostringstream err;
+            err << myname << "(setEventLoopMode): object is active..";
+            throw SystemError(err.str());
+        }
+
+        if( set )
+        {
+            auto t = unisetstd::make_unique<PassiveEpollTimer>();
+            evtmr = t.get();
+            tmr = std::move(t);
+            setTimersQuantity(1);
+        }
+        else
+        {
+            evtmr = nullptr;
+            tmr = CREATE_TIMER;
+            setTimersQuantity(UniSetTimer::MinQuantityTime);
+        }
+    }
+    // ------------------------------------------------------------------------------------------
+    bool UniSetObject::isEventLoopMode() const noexcept
+    {
+        return ( evtmr != nullptr );
+    }
+    // ------------------------------------------------------------------------------------------
+    bool UniSetObject::addWaitFd( int fd, uint32_t events )
+    {
+        if( !evtmr )
+        {
+            uwarn << myname << "(addWaitFd): event loop mode is not enabled" << endl;
+            return false;
+        }
+
+        return evtmr->addFd(fd, events);
+    }
+    // ------------------------------------------------------------------------------------------
+    bool UniSetObject::removeWaitFd( int fd )
+    {
+        return evtmr ? evtmr->removeFd(fd) : false;
+    }
+    // ------------------------------------------------------------------------------------------
+    void UniSetObject::push( const TransportMessage& tm )
+    {
+        // сообщение копируется прямо в очередь (без создания VoidMessage)
+        const Message::Priority priority = reinterpret_cast<const Message*>(&tm.data)->priority;
+
+        if( priority == Message::Medium )
+            mqueueMedium.push(tm);
+        else if( priority == Message::High )
+            mqueueHi.push(tm);
+        else if( priority == Message::Low )
+            mqueueLow.push(tm);
         else // на всякий по умолчанию medium
-            mqueueMedium.push(vm);
+            mqueueMedium.push(tm);
 
         termWaiting();
     }
@@ -453,6 +569,10 @@ namespace uniset
             throw uniset::SystemError("configure: expected 'get'");
         }
 
+        // /api/v2/ObjectName/latency[/reset|/set?sampling=N] - задержки (для всего процесса)
+        if( ctx[0] == "latency" )
+            return request_latency(ctx.depth() >= 2 ? ctx[1] : "", ctx.params);
+
         // Неизвестный путь
         ctx.response.setStatus(Poco::Net::HTTPResponse::HTTP_NOT_FOUND);
         throw uniset::SystemError("Unknown path: " + ctx.pathString());
@@ -472,6 +592,19 @@ namespace uniset
             cmd.param("param1=val1,param2=val2,...", "paremeters");
             myhelp.add(cmd);
         }
+        {
+            uniset::json::help::item cmd("latency", "latency trace statistics (for whole process)");
+            myhelp.add(cmd);
+        }
+        {
+            uniset::json::help::item cmd("latency/reset", "reset latency trace statistics");
+            myhelp.add(cmd);
+        }
+        {
+            uniset::json::help::item cmd("latency/set", "set latency trace sampling");
+            cmd.param("sampling", "percent of traced changes (0 - disable)");
+            myhelp.add(cmd);
+        }
 
         return myhelp;
     }
@@ -484,6 +617,7 @@ namespace uniset
         my->set("msgCount", countMessages());
         my->set("lostMessages", getCountOfLostMessages());
         my->set("maxSizeOfMessageQueue", getMaxSizeOfMessageQueue());
+        my->set("eventLoop", isEventLoopMode());
         my->set("isActive", isActive());
         my->set("objectType", getStrType());
         return my;
@@ -500,6 +634,31 @@ namespace uniset
         throw uniset::SystemError(err.str());
     }
     // ------------------------------------------------------------------------------------------
+    // обработка запроса вида: /latency[/reset|/set?sampling=N]
+    Poco::JSON::Object::Ptr UniSetObject::request_latency( const std::string& req, const Poco::URI::QueryParameters& params )
+    {
+        if( req == "reset" )
+            LatencyTrace::reset();
+        else if( req == "set" )
+        {
+            for( const auto& p : params )
+            {
+                if( p.first == "sampling" )
+                    LatencyTrace::setSampling(atof(p.second.c_str()));
+            }
+        }
+        else if( !req.empty() )
+        {
+            ostringstream err;
+            err << "(request_latency):  BAD REQUEST: Unknown command '" << req << "'";
+            throw uniset::SystemError(err.str());
+        }
+
+        Poco::JSON::Object::Ptr json = new Poco::JSON::Object();
+        json->set("latency", LatencyTrace::toJSON());
+        return json;
+    }
+    // ------------------------------------------------------------------------------------------
     // обработка запроса вида: /params/xxxx
     Poco::JSON::Object::Ptr UniSetObject::request_params( const std::string& req, const Poco::URI::QueryParameters& params )
     {
@@ -907,10 +1066,22 @@ namespace uniset
         // заказа продолжит спать(т.е. обработчик вызван не будет)...
         try
         {
-            auto m = waitMessage(sleepTime);
+            if( evtmr )
+            {
+                // ждём, только если сообщений нет (иначе только проверяем дескрипторы)
+                evtmr->wait( countMessages() > 0 ? 0 : sleepTime );
 
-            if( m )
-                processingMessage(m.get());
+                for( const auto& e : evtmr->fdEvents() )
+                    fdEvent(e.fd, e.events);
+
+                processMessages(mbatch.size());
+            }
+            // забираем все накопившиеся сообщения (пачками), а если их нет - ждём
+            else if( processMessages(mbatch.size()) == 0 )
+            {
+                tmr->wait(sleepTime);
+                processMessages(mbatch.size());
+            }
 
             if( !isActive() )
                 return;
@@ -930,8 +1101,15 @@ namespace uniset
             switch( msg->type )
             {
                 case Message::SensorInfo:
-                    sensorInfo( reinterpret_cast<const SensorMessage*>(msg) );
+                {
+                    const SensorMessage* sm = reinterpret_cast<const SensorMessage*>(msg);
+                    sensorInfo(sm);
+
+                    if( sm->trace_tm && sm->node == LatencyTrace::localNode() )
+                        LatencyTrace::hop(LatencyTrace::Handled, sm->trace_tm);
+
                     break;
+                }
 
                 case Message::Timer:
                     timerInfo( reinterpret_cast<const TimerMessage*>(msg) );
@@ -1034,6 +1212,20 @@ namespace uniset
              << " maxMsg=" << mqueueLow.getMaxQueueMessages()
              << " qFull(" << mqueueLow.getMaxSizeOfMessageQueue() << ")=" << mqueueLow.getCountOfLostMessages();
 
+        if( evtmr )
+            info << "\n\t event loop: wakeups=" << evtmr->getWakeups() << " doorbells=" << evtmr->getDoorbells();
+
+        // статистика задержек (общая для процесса)
+        const std::string param(userparam);
+
+        if( param == "latency" || param == "latency:reset" )
+        {
+            info << endl << LatencyTrace::report();
+
+            if( param == "latency:reset" )
+                LatencyTrace::reset();
+        }
+
         SimpleInfo* res = new SimpleInfo();
         res->info =  info.str().c_str(); // CORBA::string_dup(info.str().c_str());
         res->id   =  myid;
@@ -0,0 +1,628 @@
+/*
+ * Copyright (c) 2025 Pavel Vainerman.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, version 2.1.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+// -------------------------------------------------------------------------
+#include <ctime>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <unordered_map>
+#include <chrono>
+#include <condition_variable>
+#include "DebugStream.h"
+#include "DebugBinLog.h"
+// -------------------------------------------------------------------------
+namespace uniset
+{
+    // -------------------------------------------------------------------------
+    using namespace std;
+    // -------------------------------------------------------------------------
+    namespace
+    {
+        // максимальное количество аргументов в одной записи
+        const size_t MaxArgs = 32;
+        const uint32_t WrapMark = 0xffffffff;
+
+        // Формат записи в буфере потока:
+        // [RecHeader][tag(1)][значение(8)]...[tag(1)][длина(4)][строка]...[выравнивание до 8 байт]
+        struct RecHeader
+        {
+            uint32_t size; // размер записи целиком (или WrapMark - переход в начало буфера)
+            uint32_t num;  // количество аргументов
+            Debug::type level;
+            uint64_t logId; // см. BinLog::attach()
+            const char* fmt;
+            timespec tm;
+        };
+
+        inline size_t align8( size_t n ) noexcept
+        {
+            return (n + 7) & ~size_t(7);
+        }
+        // -------------------------------------------------------------------------
+        // буфер одного потока: пишет только сам поток, читает только фоновый поток
+        struct ThreadBuffer
+        {
+            explicit ThreadBuffer( size_t sz ):
+                buf(new char[sz]),
+                cap(sz),
+                mask(sz - 1)
+            {}
+
+            std::unique_ptr<char[]> buf;
+            const size_t cap;
+            const size_t mask;
+
+            std::atomic<uint64_t> head = { 0 };
+            std::atomic<uint64_t> tail = { 0 };
+
+            std::atomic<size_t> written = { 0 };
+            std::atomic<size_t> lost = { 0 };
+            size_t lostReported = { 0 }; // используется только фоновым потоком
+
+            std::atomic_bool closed = { false }; // поток завершился
+        };
+        // -------------------------------------------------------------------------
+        class Backend
+        {
+            public:
+
+                void add( const std::shared_ptr<ThreadBuffer>& b )
+                {
+                    {
+                        std::lock_guard<std::mutex> l(mut);
+                        buffers.push_back(b);
+                    }
+
+                    std::call_once(startFlag, [this]
+                    {
+                        std::thread thr(&Backend::run, this);
+                        thr.detach();
+                        started = true;
+                    });
+                }
+
+                // буферы, в которых есть невыведенные записи, и позиция последней записи в каждом
+                typedef std::vector<std::pair<std::shared_ptr<ThreadBuffer>, uint64_t>> Snapshot;
+
+                Snapshot pending()
+                {
+                    Snapshot ret;
+                    std::lock_guard<std::mutex> l(mut);
+
+                    for( const auto& b : buffers )
+                    {
+                        const uint64_t h = b->head.load(std::memory_order_acquire);
+
+                        if( h != b->tail.load(std::memory_order_acquire) )
+                            ret.emplace_back(b, h);
+                    }
+
+                    return ret;
+                }
+
+                void wakeup() noexcept
+                {
+                    cv.notify_one();
+                }
+
+                size_t lostRecords()
+                {
+                    std::lock_guard<std::mutex> l(mut);
+                    return lostTotal + sum(&ThreadBuffer::lost);
+                }
+
+                size_t writtenRecords()
+                {
+                    std::lock_guard<std::mutex> l(mut);
+                    return writtenTotal + sum(&ThreadBuffer::written);
+                }
+
+                uint64_t attach( DebugStream* log )
+                {
+                    std::lock_guard<std::mutex> l(lmut);
+                    const uint64_t id = ++lastLogId;
+                    logs[id] = log;
+                    return id;
+                }
+
+                // вывод записей выполняется под lmut, поэтому после выхода
+                // фоновый поток к этому логу уже не обращается
+                void detach( uint64_t id )
+                {
+                    std::lock_guard<std::mutex> l(lmut);
+                    logs.erase(id);
+                }
+
+                std::atomic<size_t> discarded = { 0 };
+
+                std::atomic<size_t> bufSize = { 64 * 1024 };
+                std::atomic<size_t> pollTime = { 10 };
+                std::atomic_bool started = { false };
+
+            protected:
+
+                size_t sum( std::atomic<size_t> ThreadBuffer::* field )
+                {
+                    size_t n = 0;
+
+                    for( const auto& b : buffers )
+                        n += ((*b).*field).load(std::memory_order_relaxed);
+
+                    return n;
+                }
+
+                void run() noexcept
+                {
+                    std::vector<std::shared_ptr<ThreadBuffer>> lst;
+
+                    while( true )
+                    {
+                        lst.clear();
+
+                        {
+                            std::lock_guard<std::mutex> l(mut);
+
+                            // буферы завершившихся потоков удаляем, когда всё из них выведено
+                            for( auto it = buffers.begin(); it != buffers.end(); )
+                            {
+                                auto& b = *it;
+
+                                if( b->closed && b->head.load() == b->tail.load() )
+                                {
+                                    writtenTotal += b->written;
+                                    lostTotal += b->lost;
+                                    it = buffers.erase(it);
+                                    continue;
+                                }
+
+                                lst.push_back(b);
+                                ++it;
+                            }
+                        }
+
+                        size_t n = 0;
+
+                        for( const auto& b : lst )
+                            n += drain(*b);
+
+                        if( n == 0 )
+                        {
+                            std::unique_lock<std::mutex> lk(mut);
+                            cv.wait_for(lk, std::chrono::milliseconds(pollTime.load()));
+                        }
+                    }
+                }
+
+                size_t drain( ThreadBuffer& b ) noexcept
+                {
+                    uint64_t t = b.tail.load(std::memory_order_relaxed);
+                    const uint64_t h = b.head.load(std::memory_order_acquire);
+                    size_t n = 0;
+
+                    while( t < h )
+                    {
+                        const char* p = b.buf.get() + (t & b.mask);
+
+                        // до конца буфера может оставаться меньше заголовка (только метка перехода)
+                        uint32_t size;
+                        std::memcpy(&size, p, sizeof(size));
+
+                        if( size == WrapMark )
+                        {
+                            t += b.cap - (t & b.mask);
+                            continue;
+                        }
+
+                        RecHeader hd;
+                        std::memcpy(&hd, p, sizeof(hd));
+
+                        render(b, hd, p + sizeof(hd));
+
+                        t += hd.size;
+                        n++;
+
+                        // место освобождаем сразу, чтобы писатель не ждал всю пачку
+                        b.tail.store(t, std::memory_order_release);
+                    }
+
+                    b.tail.store(t, std::memory_order_release);
+                    return n;
+                }
+
+                void render( ThreadBuffer& b, const RecHeader& hd, const char* p ) noexcept
+                {
+                    BinLog::Value vals[MaxArgs];
+
+                    for( size_t i = 0; i < hd.num; i++ )
+                    {
+                        vals[i].tag = (BinLog::Tag)(*p++);
+
+                        if( vals[i].tag == BinLog::Tag::Str )
+                        {
+                            uint32_t len;
+                            std::memcpy(&len, p, sizeof(len));
+                            p += sizeof(len);
+                            vals[i].s = p;
+                            vals[i].len = len;
+                            p += len;
+                        }
+                        else
+                        {
+                            std::memcpy(&vals[i].u, p, sizeof(vals[i].u));
+                            p += sizeof(vals[i].u);
+                        }
+                    }
+
+                    try
+                    {
+                        std::lock_guard<std::mutex> l(lmut);
+
+                        auto it = logs.find(hd.logId);
+
+                        // лог уже удалён
+                        if( it == logs.end() )
+                        {
+                            discarded++;
+                            return;
+                        }
+
+                        DebugStream* log = it->second;
+                        const size_t lost = b.lost.load(std::memory_order_relaxed);
+
+                        if( lost != b.lostReported )
+                        {
+                            log->debug(hd.level, hd.tm) << "(BinLog): lost " << (lost - b.lostReported)
+                                                        << " records (thread buffer overflow)" << endl;
+                            b.lostReported = lost;
+                        }
+
+                        std::ostream& os = log->debug(hd.level, hd.tm);
+                        BinLog::format(os, hd.fmt, vals, hd.num);
+                        os << endl;
+                    }
+                    catch(...) {}
+                }
+
+            private:
+                std::mutex mut;
+                std::condition_variable cv;
+                std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+                std::once_flag startFlag;
+
+                // зарегистрированные логи (защищено lmut)
+                std::mutex lmut;
+                std::unordered_map<uint64_t, DebugStream*> logs;
+                uint64_t lastLogId = { 0 };
+
+                // статистика удалённых буферов
+                size_t writtenTotal = { 0 };
+                size_t lostTotal = { 0 };
+        };
+        // -------------------------------------------------------------------------
+        // Объект не удаляется (фоновый поток работает до завершения процесса),
+        // чтобы при завершении программы не зависеть от порядка удаления статических объектов.
+        Backend& backend()
+        {
+            static Backend* b = new Backend();
+            return *b;
+        }
+        // -------------------------------------------------------------------------
+        struct ThreadBufferHolder
+        {
+            std::shared_ptr<ThreadBuffer> b;
+
+            ~ThreadBufferHolder()
+            {
+                if( b )
+                    b->closed = true;
+            }
+        };
+
+        ThreadBuffer* threadBuffer() noexcept
+        {
+            static thread_local ThreadBufferHolder holder;
+
+            if( !holder.b )
+            {
+                try
+                {
+                    size_t sz = 4096;
+
+                    while( sz < backend().bufSize )
+                        sz <<= 1;
+
+                    holder.b = std::make_shared<ThreadBuffer>(sz);
+                    backend().add(holder.b);
+                }
+                catch(...)
+                {
+                    holder.b.reset();
+                    return nullptr;
+                }
+            }
+
+            return holder.b.get();
+        }
+        // -------------------------------------------------------------------------
+        void print( std::ostream& os, const BinLog::Value& v )
+        {
+            switch( v.tag )
+            {
+                case BinLog::Tag::Int:
+                    os << v.i;
+                    break;
+
+                case BinLog::Tag::UInt:
+                    os << v.u;
+                    break;
+
+                case BinLog::Tag::Double:
+                    os << v.d;
+                    break;
+
+                case BinLog::Tag::Bool:
+                    os << (bool)v.u;
+                    break;
+
+                case BinLog::Tag::Char:
+                    os << (char)v.i;
+                    break;
+
+                case BinLog::Tag::Ptr:
+                    os << v.p;
+                    break;
+
+                case BinLog::Tag::Str:
+                    os.write(v.s, v.len);
+                    break;
+
+                default:
+                    break;
+            }
+        }
+    }
+    // -------------------------------------------------------------------------
+    uint64_t BinLog::attach( DebugStream* log ) noexcept
+    {
+        if( !log )
+            return 0;
+
+        try
+        {
+            return backend().attach(log);
+        }
+        catch(...) {}
+
+        return 0;
+    }
+    // -------------------------------------------------------------------------
+    void BinLog::detach( uint64_t logId ) noexcept
+    {
+        try
+        {
+            backend().detach(logId);
+        }
+        catch(...) {}
+    }
+    // -------------------------------------------------------------------------
+    bool BinLog::write( uint64_t logId, Debug::type t, const char* fmt, const Value* vals, size_t num ) noexcept
+    {
+        ThreadBuffer* b = threadBuffer();
+
+        if( !b || logId == 0 || !fmt )
+            return false;
+
+        if( num > MaxArgs )
+            num = MaxArgs;
+
+        // запись не должна занимать больше четверти буфера, длинные строки обрезаем
+        size_t fixed = sizeof(RecHeader);
+        size_t strnum = 0;
+
+        for( size_t i = 0; i < num; i++ )
+        {
+            if( vals[i].tag == Tag::Str )
+            {
+                fixed += 1 + sizeof(uint32_t);
+                strnum++;
+            }
+            else
+                fixed += 1 + sizeof(vals[i].u);
+        }
+
+        const size_t maxRec = b->cap / 4;
+        const size_t maxStr = strnum > 0 && maxRec > fixed ? (maxRec - fixed) / strnum : 0;
+        size_t sz = fixed;
+
+        for( size_t i = 0; i < num; i++ )
+        {
+            if( vals[i].tag == Tag::Str )
+                sz += std::min(vals[i].len, maxStr);
+        }
+
+        sz = align8(sz);
+
+        uint64_t h = b->head.load(std::memory_order_relaxed);
+        uint64_t off = h & b->mask;
+        const uint64_t skip = ( off + sz > b->cap ) ? b->cap - off : 0;
+
+        if( h + skip + sz - b->tail.load(std::memory_order_acquire) > b->cap )
+        {
+            b->lost.store(b->lost.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        char* buf = b->buf.get();
+
+        if( skip > 0 )
+        {
+            std::memcpy(buf + off, &WrapMark, sizeof(WrapMark));
+            h += skip;
+            off = 0;
+        }
+
+        RecHeader hd;
+        hd.size = sz;
+        hd.num = num;
+        hd.level = t;
+        hd.logId = logId;
+        hd.fmt = fmt;
+        clock_gettime(CLOCK_REALTIME, &hd.tm);
+
+        char* p = buf + off;
+        std::memcpy(p, &hd, sizeof(hd));
+        p += sizeof(hd);
+
+        for( size_t i = 0; i < num; i++ )
+        {
+            *p++ = (char)vals[i].tag;
+
+            if( vals[i].tag == Tag::Str )
+            {
+                const uint32_t len = std::min(vals[i].len, maxStr);
+                std::memcpy(p, &len, sizeof(len));
+                p += sizeof(len);
+                std::memcpy(p, vals[i].s, len);
+                p += len;
+            }
+            else
+            {
+                std::memcpy(p, &vals[i].u, sizeof(vals[i].u));
+                p += sizeof(vals[i].u);
+            }
+        }
+
+        b->head.store(h + sz, std::memory_order_release);
+        b->written.store(b->written.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return true;
+    }
+    // -------------------------------------------------------------------------
+    void BinLog::format( std::ostream& os, const char* fmt, const Value* vals, size_t num )
+    {
+        size_t k = 0;
+        const char* p = fmt;
+
+        while( *p )
+        {
+            const char* m = std::strstr(p, "{}");
+
+            if( !m )
+            {
+                os << p;
+                break;
+            }
+
+            os.write(p, m - p);
+
+            if( k < num )
+                print(os, vals[k++]);
+            else
+                os << "{}";
+
+            p = m + 2;
+        }
+
+        // лишние аргументы выводим через пробел
+        for( ; k < num; k++ )
+        {
+            os << ' ';
+            print(os, vals[k]);
+        }
+    }
+    // -------------------------------------------------------------------------
+    bool BinLog::flush( size_t msec ) noexcept
+    {
+        auto& be = backend();
+
+        if( !be.started )
+            return true;
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(msec);
+
+        try
+        {
+            // ждём только записи, сделанные до вызова flush
+            // (если другие потоки продолжают писать, ожидание всё равно закончится)
+            auto lst = be.pending();
+
+            for( const auto& p : lst )
+            {
+                while( p.first->tail.load(std::memory_order_acquire) < p.second )
+                {
+                    if( std::chrono::steady_clock::now() >= deadline )
+                        return false;
+
+                    be.wakeup();
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+        }
+        catch(...)
+        {
+            return false;
+        }
+
+        return true;
+    }
+    // -------------------------------------------------------------------------
+    void BinLog::setThreadBufferSize( size_t sz ) noexcept
+    {
+        backend().bufSize = sz;
+    }
+    // -------------------------------------------------------------------------
+    void BinLog::setPollTime( size_t msec ) noexcept
+    {
+        backend().pollTime = msec > 0 ? msec : 1;
+    }
+    // -------------------------------------------------------------------------
+    size_t BinLog::lostRecords() noexcept
+    {
+        try
+        {
+            return backend().lostRecords();
+        }
+        catch(...) {}
+
+        return 0;
+    }
+    // -------------------------------------------------------------------------
+    size_t BinLog::writtenRecords() noexcept
+    {
+        try
+        {
+            return backend().writtenRecords();
+        }
+        catch(...) {}
+
+        return 0;
+    }
+    // -------------------------------------------------------------------------
+    size_t BinLog::discardedRecords() noexcept
+    {
+        try
+        {
+            return backend().discarded.load();
+        }
+        catch(...) {}
+
+        return 0;
+    }
+    // -------------------------------------------------------------------------
+} // end of namespace uniset
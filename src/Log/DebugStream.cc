@@ -74,6 +74,14 @@ void DebugStream::sbuf_overflow( const std::string& s ) noexcept
 //--------------------------------------------------------------------------
 DebugStream::~DebugStream()
 {
+	// выводим то, что уже записано в буферы потоков (иначе при завершении программы
+	// теряются последние сообщения), записи сделанные позже будут отброшены
+	if( binId )
+	{
+		uniset::BinLog::flush();
+		uniset::BinLog::detach(binId);
+	}
+
 	delete nullstream.rdbuf(0); // Without this we leak
 	delete rdbuf(0);            // Without this we leak
 	delete internal;
@@ -92,6 +100,7 @@ const DebugStream& DebugStream::operator=( const DebugStream& r )
 	show_msec = r.show_msec;
 	show_usec = r.show_usec;
 	fname = r.fname;
+	binaryMode(r.binmode);
 
 	if( !r.fname.empty() )
 		logFile(fname);
@@ -140,7 +149,7 @@ void DebugStream::logFile( const std::string& f, bool truncate )
 		if( onScreen )
 			delete rdbuf(new teebuf(cerr.rdbuf(), &internal->sbuf));
 		else
-			delete rdbuf(&internal->sbuf);
+			delete rdbuf(new debugbuf(&internal->sbuf)); // rdbuf() удаляется в деструкторе
 	}
 }
 //--------------------------------------------------------------------------
@@ -158,35 +167,62 @@ void DebugStream::disableOnScreen()
 	logFile(fname, false);
 }
 //--------------------------------------------------------------------------
+void DebugStream::binaryMode( bool s ) noexcept
+{
+	if( s && binId == 0 )
+		binId = uniset::BinLog::attach(this);
+
+	// без регистрации выводим сразу
+	binmode = s && binId != 0;
+}
+//--------------------------------------------------------------------------
 std::ostream& DebugStream::debug(Debug::type t) noexcept
 {
 	if( (dt & t) && (vv <= verb) )
 	{
-		uniset::ios_fmt_restorer ifs(*this);
+		timespec tm = { 0, 0 };
 
 		if( show_datetime )
-			printDateTime(t);
+			tm = uniset::now_to_timespec();
+
+		return printHeader(t, tm);
+	}
+
+	return nullstream;
+}
+//--------------------------------------------------------------------------
+std::ostream& DebugStream::debug(Debug::type t, const timespec& tm) noexcept
+{
+	if( (dt & t) && (vv <= verb) )
+		return printHeader(t, tm);
+
+	return nullstream;
+}
+//--------------------------------------------------------------------------
+std::ostream& DebugStream::printHeader(Debug::type t, const timespec& tm) noexcept
+{
+	uniset::ios_fmt_restorer ifs(*this);
+
+	if( show_datetime )
+		printDateTime(t, tm);
 
-		if( show_logtype )
-			*this << "(" << std::setfill(' ') << std::setw(6) << t << "):  "; // "):\t";
+	if( show_logtype )
+		*this << "(" << std::setfill(' ') << std::setw(6) << t << "):  "; // "):\t";
 
-		if( show_labels )
+	if( show_labels )
+	{
+		for( const auto& l : labels )
 		{
-			for( const auto& l : labels )
-			{
-				*this << "[";
+			*this << "[";
 
-				if( !hide_label_key )
-					*this << l.first << "=";
+			if( !hide_label_key )
+				*this << l.first << "=";
 
-				*this << l.second << "]";
-			}
+			*this << l.second << "]";
 		}
-
-		return *this;
 	}
 
-	return nullstream;
+	return *this;
 }
 //--------------------------------------------------------------------------
 std::ostream& DebugStream::operator()(Debug::type t) noexcept
@@ -265,12 +301,19 @@ std::ostream& DebugStream::printTime(Debug::type t, char brk) noexcept
 }
 //--------------------------------------------------------------------------
 std::ostream& DebugStream::printDateTime(Debug::type t) noexcept
+{
+	if( (dt & t) && (vv <= verb) )
+		return printDateTime(t, uniset::now_to_timespec());
+
+	return nullstream;
+}
+//--------------------------------------------------------------------------
+std::ostream& DebugStream::printDateTime(Debug::type t, const timespec& tv) noexcept
 {
 	if( (dt & t) && (vv <= verb) )
 	{
 		uniset::ios_fmt_restorer ifs(*this);
 
-		timespec tv = uniset::now_to_timespec(); // gettimeofday(tv,0);
 		std::tm tms;
 		if( show_localtime )
 		    localtime_r(&tv.tv_sec, &tms);
@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2025 Pavel Vainerman.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, version 2.1.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+// -------------------------------------------------------------------------
+#include <cstring>
+#include "LogRing.h"
+// -------------------------------------------------------------------------
+namespace uniset
+{
+    // -------------------------------------------------------------------------
+    using namespace std;
+    // -------------------------------------------------------------------------
+    static inline uint64_t align8( uint64_t n ) noexcept
+    {
+        return (n + 7) & ~uint64_t(7);
+    }
+    // -------------------------------------------------------------------------
+    static size_t ring_capacity( size_t sz ) noexcept
+    {
+        size_t c = 4096;
+
+        while( c < sz )
+            c <<= 1;
+
+        return c;
+    }
+    // -------------------------------------------------------------------------
+    LogRing::LogRing( size_t capacity ):
+        buf(new char[ring_capacity(capacity)]),
+        cap(ring_capacity(capacity)),
+        mask(ring_capacity(capacity) - 1)
+    {
+    }
+    // -------------------------------------------------------------------------
+    LogRing::~LogRing()
+    {
+    }
+    // -------------------------------------------------------------------------
+    LogRing::Header LogRing::header( uint64_t pos ) const noexcept
+    {
+        Header h;
+        std::memcpy(&h, buf.get() + (pos & mask), sizeof(h));
+        return h;
+    }
+    // -------------------------------------------------------------------------
+    uint64_t LogRing::recordSize( uint64_t pos, const Header& h ) const noexcept
+    {
+        if( h.len == WrapMark )
+            return cap - (pos & mask);
+
+        return align8(HeaderSize + h.len);
+    }
+    // -------------------------------------------------------------------------
+    void LogRing::push( const std::string& s ) noexcept
+    {
+        push(s.data(), s.size());
+    }
+    // -------------------------------------------------------------------------
+    void LogRing::push( const char* data, size_t len ) noexcept
+    {
+        if( !data || len == 0 )
+            return;
+
+        if( len > cap / 4 - HeaderSize )
+            len = cap / 4 - HeaderSize;
+
+        const uint64_t rsize = align8(HeaderSize + len);
+
+        std::lock_guard<std::mutex> l(wmutex);
+
+        uint64_t h = head.load(std::memory_order_relaxed);
+        uint64_t off = h & mask;
+
+        // запись не "разрываем": если не помещается до конца буфера, переходим в начало
+        const uint64_t skip = ( off + rsize > cap ) ? cap - off : 0;
+
+        // освобождаем место, затирая самые старые записи
+        uint64_t t = tail.load(std::memory_order_relaxed);
+
+        while( h + skip + rsize - t > cap )
+            t += recordSize(t, header(t));
+
+        // читатель, увидевший новые данные, должен увидеть и новый tail
+        tail.store(t, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        if( skip > 0 )
+        {
+            const Header w = { WrapMark, 0 };
+            std::memcpy(buf.get() + off, &w, sizeof(w));
+            h += skip;
+            off = 0;
+        }
+
+        const uint32_t seq = wseq.load(std::memory_order_relaxed);
+        const Header hd = { (uint32_t)len, seq };
+        std::memcpy(buf.get() + off, &hd, sizeof(hd));
+        std::memcpy(buf.get() + off + HeaderSize, data, len);
+
+        wseq.store(seq + 1, std::memory_order_relaxed);
+        head.store(h + rsize, std::memory_order_release);
+
+        if( len < minSize.load(std::memory_order_relaxed) || minSize.load(std::memory_order_relaxed) == 0 )
+            minSize.store(len, std::memory_order_relaxed);
+
+        if( len > maxSize.load(std::memory_order_relaxed) )
+            maxSize.store(len, std::memory_order_relaxed);
+    }
+    // -------------------------------------------------------------------------
+    LogRing::Cursor LogRing::cursor() const noexcept
+    {
+        std::lock_guard<std::mutex> l(wmutex);
+        Cursor c;
+        c.pos = head.load(std::memory_order_relaxed);
+        c.seq = wseq.load(std::memory_order_relaxed);
+        return c;
+    }
+    // -------------------------------------------------------------------------
+    size_t LogRing::sync( Cursor& c ) const noexcept
+    {
+        while( true )
+        {
+            const uint64_t t = tail.load(std::memory_order_acquire);
+
+            if( c.pos >= t )
+                return 0;
+
+            uint64_t p = t;
+            Header h = header(p);
+
+            if( h.len == WrapMark )
+            {
+                p += cap - (p & mask);
+                h = header(p);
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            // пока читали, писатель успел затереть и эту запись
+            if( tail.load(std::memory_order_relaxed) != t )
+                continue;
+
+            const size_t lost = (uint32_t)(h.seq - c.seq);
+            c.pos = p;
+            c.seq = h.seq;
+            c.offset = 0;
+            return lost;
+        }
+    }
+    // -------------------------------------------------------------------------
+    size_t LogRing::read( const Cursor& c, Slice* slices, size_t maxnum ) const noexcept
+    {
+        const uint64_t h = head.load(std::memory_order_acquire);
+        uint64_t p = c.pos;
+        size_t n = 0;
+
+        while( n < maxnum && p < h )
+        {
+            const Header hd = header(p);
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if( tail.load(std::memory_order_relaxed) > p )
+                break;
+
+            if( hd.len == WrapMark )
+            {
+                p += cap - (p & mask);
+                continue;
+            }
+
+            Slice& s = slices[n++];
+            s.data = buf.get() + (p & mask) + HeaderSize;
+            s.len = hd.len;
+            s.seq = hd.seq;
+            s.pos = p;
+            p += align8(HeaderSize + hd.len);
+            s.next = p;
+        }
+
+        return n;
+    }
+    // -------------------------------------------------------------------------
+    void LogRing::advance( Cursor& c, const Slice* slices, size_t num, size_t nbytes ) noexcept
+    {
+        size_t off = c.offset;
+
+        for( size_t i = 0; i < num; i++ )
+        {
+            const size_t rest = slices[i].len - off;
+
+            if( nbytes < rest )
+            {
+                c.pos = slices[i].pos;
+                c.seq = slices[i].seq;
+                c.offset = off + nbytes;
+                return;
+            }
+
+            nbytes -= rest;
+            off = 0;
+            c.pos = slices[i].next;
+            c.seq = slices[i].seq + 1;
+            c.offset = 0;
+        }
+    }
+    // -------------------------------------------------------------------------
+    bool LogRing::valid( uint64_t pos ) const noexcept
+    {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return tail.load(std::memory_order_relaxed) <= pos;
+    }
+    // -------------------------------------------------------------------------
+    size_t LogRing::pending( const Cursor& c ) const noexcept
+    {
+        return (uint32_t)(wseq.load(std::memory_order_relaxed) - c.seq);
+    }
+    // -------------------------------------------------------------------------
+    size_t LogRing::capacity() const noexcept
+    {
+        return cap;
+    }
+    // -------------------------------------------------------------------------
+    size_t LogRing::minRecordSize() const noexcept
+    {
+        return minSize.load(std::memory_order_relaxed);
+    }
+    // -------------------------------------------------------------------------
+    size_t LogRing::maxRecordSize() const noexcept
+    {
+        return maxSize.load(std::memory_order_relaxed);
+    }
+    // -------------------------------------------------------------------------
+} // end of namespace uniset
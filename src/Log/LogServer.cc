@@ -21,6 +21,7 @@
 #include "UniSetTypes.h"
 #include "Exceptions.h"
 #include "LogSession.h"
+#include "LogRing.h"
 #include "LogAgregator.h"
 #include "Configuration.h"
 // -------------------------------------------------------------------------
@@ -39,6 +40,8 @@ namespace uniset
                 loop.evstop(this);
         }
         catch(...) {}
+
+        ringConn.disconnect();
     }
     // -------------------------------------------------------------------------
     void LogServer::setCmdTimeout( timeout_t msec ) noexcept
@@ -56,6 +59,11 @@ namespace uniset
         sessMaxCount = num;
     }
     // -------------------------------------------------------------------------
+    void LogServer::setRingSize( size_t bytes ) noexcept
+    {
+        ringSize = bytes;
+    }
+    // -------------------------------------------------------------------------
     LogServer::LogServer( std::shared_ptr<LogAgregator> log ):
         LogServer()
     {
@@ -117,6 +125,8 @@ namespace uniset
         }
 
         io.stop();
+        ringEvent.stop();
+        ringConn.disconnect();
         isrunning = false;
 
         sock->close();
@@ -296,6 +306,11 @@ namespace uniset
         io.set( eloop );
         io.set<LogServer, &LogServer::ioAccept>(this);
         io.start(sock->getSocket(), ev::READ);
+
+        ringEvent.set( eloop );
+        ringEvent.set<LogServer, &LogServer::onRingEvent>(this);
+        ringEvent.start();
+
         isrunning = true;
     }
     // -------------------------------------------------------------------------
@@ -335,7 +350,16 @@ namespace uniset
         {
             Poco::Net::StreamSocket ss = sock->acceptConnection();
 
-            auto s = make_shared<LogSession>( ss, elog, cmdTimeout );
+            // общий буфер заполняется только пока есть подключения
+            if( !ringConn.connected() && elog )
+            {
+                if( !ring || ring->capacity() < ringSize )
+                    ring = make_shared<LogRing>(ringSize);
+
+                ringConn = elog->signal_stream_event().connect( sigc::mem_fun(this, &LogServer::logOnEvent) );
+            }
+
+            auto s = make_shared<LogSession>( ss, elog, ring, cmdTimeout );
             s->setSessionLogLevel(sessLogLevel);
             s->connectFinalSession( sigc::mem_fun(this, &LogServer::sessionFinished) );
             s->signal_logsession_command().connect( sigc::mem_fun(this, &LogServer::onCommand) );
@@ -373,7 +397,32 @@ namespace uniset
         {
             // восстанавливаем уровни логов по умолчанию
             restoreDefaultLogLevels("ALL");
+            ringConn.disconnect();
+        }
+    }
+    // -------------------------------------------------------------------------
+    void LogServer::logOnEvent( const std::string& s ) noexcept
+    {
+        ring->push(s);
+
+        if( ringEvent.is_active() )
+            ringEvent.send();
+    }
+    // -------------------------------------------------------------------------
+    void LogServer::onRingEvent( ev::async& watcher, int revents ) noexcept
+    {
+        if( EV_ERROR & revents )
+        {
+            if( mylog.is_crit() )
+                mylog.crit() << myname << "(LogServer::onRingEvent): EVENT ERROR.." << endl;
+
+            return;
         }
+
+        uniset_rwmutex_rlock l(mutSList);
+
+        for( const auto& s : slist )
+            s->wakeup();
     }
     // -------------------------------------------------------------------------
     void LogServer::init( const std::string& prefix, xmlNode* cnode, int argc, const char* const argv[] )
@@ -394,12 +443,16 @@ namespace uniset
 
         timeout_t cmdTimeout = uniset::getArgPInt("--" + prefix + "-cmd-timeout", ac, av, it.getProp("cmdTimeout"), 2000);
         setCmdTimeout(cmdTimeout);
+
+        size_t rsize = uniset::getArgPInt("--" + prefix + "-ring-size", ac, av, it.getProp("ringSize"), ringSize);
+        setRingSize(rsize);
     }
     // -----------------------------------------------------------------------------
     std::string LogServer::help_print( const std::string& prefix )
     {
         std::ostringstream h;
         h << "--" << prefix << "-cmd-timeout msec      - Timeout for wait command. Default: 2000 msec." << endl;
+        h << "--" << prefix << "-ring-size bytes       - Size of the log buffer shared by all sessions. Default: 2097152 bytes." << endl;
         return h.str();
     }
     // -----------------------------------------------------------------------------
@@ -22,6 +22,7 @@
 #include <regex>
 #include <fcntl.h>
 #include <errno.h>
+#include <sys/uio.h>
 #include <cstring>
 #include <Poco/Net/NetException.h>
 #include <Poco/Exception.h>
@@ -36,12 +37,18 @@ namespace uniset
     // -------------------------------------------------------------------------
     using namespace std;
     // -------------------------------------------------------------------------
+    // максимальное количество записей, отправляемых за один writev()
+    static const size_t MaxIOV = 64;
+    // -------------------------------------------------------------------------
     LogSession::~LogSession()
     {
         cancelled = true;
 
         conn.disconnect();
 
+        for( auto&& c : fconn )
+            c.disconnect();
+
         if( io.is_active() )
             io.stop();
 
@@ -53,11 +60,25 @@ namespace uniset
 
         if( asyncEvent.is_active() )
             asyncEvent.stop();
+
+        while( !cmdbuf.empty() )
+        {
+            delete cmdbuf.front();
+            cmdbuf.pop();
+        }
     }
     // -------------------------------------------------------------------------
     LogSession::LogSession( const Poco::Net::StreamSocket& s, std::shared_ptr<DebugStream>& _log, timeout_t _cmdTimeout, timeout_t _checkConnectionTime ):
+        LogSession(s, _log, nullptr, _cmdTimeout, _checkConnectionTime)
+    {
+    }
+    // -------------------------------------------------------------------------
+    LogSession::LogSession( const Poco::Net::StreamSocket& s, std::shared_ptr<DebugStream>& _log,
+                            const std::shared_ptr<LogRing>& _ring,
+                            timeout_t _cmdTimeout, timeout_t _checkConnectionTime ):
         cmdTimeout(_cmdTimeout),
         checkConnectionTime(_checkConnectionTime / 1000.),
+        sring(_ring),
         peername(""),
         caddr(""),
         log(_log)
@@ -106,70 +127,64 @@ namespace uniset
         asyncEvent.set<LogSession, &LogSession::event>(this);
         checkConnectionTimer.set<LogSession, &LogSession::onCheckConnectionTimer>(this);
 
-        if( log )
-            conn = log->signal_stream_event().connect( sigc::mem_fun(this, &LogSession::logOnEvent) );
-        else
+        if( !log )
             mylog.crit() << "(LogSession): LOG NULL!!" << endl;
+
+        if( sring )
+        {
+            ring = sring.get();
+            cursor = sring->cursor();
+            publishCursor();
+        }
+        else
+        {
+            createOwnRing();
+
+            if( log )
+                conn = log->signal_stream_event().connect( sigc::mem_fun(this, &LogSession::logOnEvent) );
+        }
     }
     // -------------------------------------------------------------------------
-    void LogSession::logOnEvent( const std::string& s ) noexcept
+    void LogSession::createOwnRing()
     {
-        if( cancelled || s.empty() )
-            return;
+        if( !myring )
+            myring = make_shared<LogRing>(maxRecordsNum * avgRecordSize);
 
-        try
+        if( ring != myring.get() )
         {
-            // чтобы поменьше удерживать mutex
-            std::unique_lock<std::mutex> lk(logbuf_mutex);
-
-            // собираем статистику..
-            // --------------------------
-            if( s.size() < minSizeMsg || minSizeMsg == 0 )
-                minSizeMsg = s.size();
-
-            if( s.size() > maxSizeMsg )
-                maxSizeMsg = s.size();
-
-            if( logbuf.size() > maxCount )
-                maxCount = logbuf.size();
-
-            // --------------------------
-
-            // проверяем на переполнение..
-            if( logbuf.size() >= maxRecordsNum )
-            {
-                numLostMsg++;
-
-                if( numLostMsg > maxRecordsNum )
-                {
-                    // видимо клиент отвалился или совсем не успевает читать
-                    // разрываем сессию..
-                    if( mylog.is_info() )
-                        mylog.info() << peername << "(LogSession::onEvent): too many lost messages. Close session.." << endl;
-
-                    cancelled = true;
-                }
-
-                if( !lostMsg )
-                {
-                    ostringstream err;
-                    err <<  "(LogSession): The buffer is full. Message is lost...(size of buffer " << maxRecordsNum << ")" << endl;
-                    logbuf.emplace(new UTCPCore::Buffer(std::move(err.str())));
-                    lostMsg = true;
-                }
-
-                return;
-            }
-
-            lostMsg = false;
-            logbuf.emplace(new UTCPCore::Buffer(s));
+            ring = myring.get();
+            cursor = myring->cursor();
+            publishCursor();
         }
-        catch(...) {}
+    }
+    // -------------------------------------------------------------------------
+    void LogSession::publishCursor() noexcept
+    {
+        statRing.store(ring, std::memory_order_relaxed);
+        statSeq.store(cursor.seq, std::memory_order_release);
+    }
+    // -------------------------------------------------------------------------
+    void LogSession::logOnEvent( const std::string& s ) noexcept
+    {
+        if( cancelled || s.empty() || !myring )
+            return;
+
+        myring->push(s);
 
         if( asyncEvent.is_active() )
             asyncEvent.send();
     }
     // -------------------------------------------------------------------------
+    void LogSession::wakeup() noexcept
+    {
+        // пока не пришла команда (или не истёк cmdTimeout) лог не отправляем
+        if( cancelled || !asyncEvent.is_active() || ring != sring.get() )
+            return;
+
+        if( !(io.events & ev::WRITE) )
+            io.set(ev::WRITE);
+    }
+    // -------------------------------------------------------------------------
     void LogSession::run( const ev::loop_ref& loop ) noexcept
     {
         setSessionLogLevel(Debug::ANY);
@@ -199,13 +214,15 @@ namespace uniset
             cmdTimer.stop();
             asyncEvent.stop();
             conn.disconnect();
+
+            for( auto&& c : fconn )
+                c.disconnect();
         }
 
+        while( !cmdbuf.empty() )
         {
-            std::unique_lock<std::mutex> lk(logbuf_mutex);
-
-            while( !logbuf.empty() )
-                logbuf.pop();
+            delete cmdbuf.front();
+            cmdbuf.pop();
         }
 
         sock->disconnect();
@@ -262,13 +279,11 @@ namespace uniset
             io.stop();
             cmdTimer.stop();
 
-            try
-            {
-                std::unique_lock<std::mutex> lk(logbuf_mutex);
-                asyncEvent.stop();
-                conn.disconnect();
-            }
-            catch(...) {}
+            asyncEvent.stop();
+            conn.disconnect();
+
+            for( auto&& c : fconn )
+                c.disconnect();
 
             final();
         }
@@ -279,82 +294,116 @@ namespace uniset
         if( cancelled.load() )
             return;
 
-        UTCPCore::Buffer* buffer = 0;
-
+        // служебные сообщения вставляем только между записями лога
+        if( cursor.offset == 0 && !cmdbuf.empty() )
         {
-            std::unique_lock<std::mutex> lk(logbuf_mutex);
+            UTCPCore::Buffer* buffer = cmdbuf.front();
 
-            if( logbuf.empty() )
+            ssize_t ret = ::write(watcher.fd, buffer->dpos(), buffer->nbytes());
+
+            if( ret < 0 )
             {
-                io.set(EV_READ);
-                checkConnectionTimer.start( checkConnectionTime ); // restart timer
+                writeError();
                 return;
             }
 
-            buffer = logbuf.front();
-        }
+            buffer->pos += ret;
 
-        if( !buffer )
-        {
-            io.set(EV_READ);
+            if( buffer->nbytes() == 0 )
+            {
+                cmdbuf.pop();
+                delete buffer;
+            }
+
+            io.set(ev::WRITE);
             return;
         }
 
-        ssize_t ret = ::write(watcher.fd, buffer->dpos(), buffer->nbytes());
+        // клиент не успевает читать и его записи уже затёрты
+        const size_t lost = ring->sync(cursor);
 
-        if( ret < 0 )
+        if( lost > 0 )
         {
-            // копируем, а потом проверяем
-            // хоть POSIX говорит о том, что errno thread-local
-            // но почему-то словил, что errno (по крайней мере для EPIPE "broken pipe")
-            // в лог выводилось, а в if( ... ) уже не ловилось
-            // возможно связано с тем, что ввод/вывод "прерываемая" операция при многопоточности
-            int errnum = errno;
+            publishCursor();
+            numLostMsg += lost;
 
-            // можно было бы конечно убрать вывод лога в else, после проверки в if
-            if( mylog.is_warn() )
-                mylog.warn() << peername << "(LogSession::writeEvent): write to socket error(" << errnum << "): " << strerror(errnum) << endl;
+            ostringstream err;
+            err << "(LogSession): lost " << lost << " records...(size of buffer " << ring->capacity() << " bytes)" << endl;
+            cmdbuf.emplace(new UTCPCore::Buffer(err.str()));
+            io.set(ev::WRITE);
+            return;
+        }
 
-            if( errnum == EPIPE || errnum == EBADF )
-            {
-                if( mylog.is_warn() )
-                    mylog.warn() << peername << "(LogSession::writeEvent): write error.. terminate session.." << endl;
+        const size_t pending = ring->pending(cursor);
 
-                cancelled = true;
-            }
+        if( pending > maxCount )
+            maxCount = pending;
 
+        LogRing::Slice slices[MaxIOV];
+        const size_t num = ring->read(cursor, slices, MaxIOV);
+
+        if( num == 0 )
+        {
+            io.set(EV_READ);
+            checkConnectionTimer.start( checkConnectionTime ); // restart timer
             return;
         }
 
-        buffer->pos += ret;
+        struct iovec iov[MaxIOV];
 
-        if( buffer->nbytes() == 0 )
+        for( size_t i = 0; i < num; i++ )
         {
-            {
-                std::unique_lock<std::mutex> lk(logbuf_mutex);
-                logbuf.pop();
-            }
-
-            delete buffer;
+            iov[i].iov_base = (void*)slices[i].data;
+            iov[i].iov_len = slices[i].len;
         }
 
+        iov[0].iov_base = (void*)(slices[0].data + cursor.offset);
+        iov[0].iov_len -= cursor.offset;
 
+        ssize_t ret = ::writev(watcher.fd, iov, num);
+
+        if( ret < 0 )
         {
-            std::unique_lock<std::mutex> lk(logbuf_mutex);
+            writeError();
+            return;
+        }
 
-            if( logbuf.empty() )
-            {
-                io.set(EV_READ);
-                checkConnectionTimer.start( checkConnectionTime ); // restart timer
-                return;
-            }
+        LogRing::advance(cursor, slices, num, ret);
+        publishCursor();
+
+        // пока отправляли, писатель мог затереть эти данные
+        if( !ring->valid(slices[0].pos) )
+        {
+            numLostMsg++;
+            cmdbuf.emplace(new UTCPCore::Buffer("\n(LogSession): records were overwritten while sending...\n"));
         }
 
         if( checkConnectionTimer.is_active() )
             checkConnectionTimer.stop();
 
         io.set(ev::WRITE);
-        //io.set(ev::READ | ev::WRITE);
+    }
+    // -------------------------------------------------------------------------
+    void LogSession::writeError() noexcept
+    {
+        // копируем, а потом проверяем
+        // хоть POSIX говорит о том, что errno thread-local
+        // но почему-то словил, что errno (по крайней мере для EPIPE "broken pipe")
+        // в лог выводилось, а в if( ... ) уже не ловилось
+        // возможно связано с тем, что ввод/вывод "прерываемая" операция при многопоточности
+        int errnum = errno;
+
+        // можно было бы конечно убрать вывод лога в else, после проверки в if
+        if( mylog.is_warn() )
+            mylog.warn() << peername << "(LogSession::writeEvent): write to socket error(" << errnum << "): " << strerror(errnum) << endl;
+
+        if( errnum == EPIPE || errnum == EBADF )
+        {
+            if( mylog.is_warn() )
+                mylog.warn() << peername << "(LogSession::writeEvent): write error.. terminate session.." << endl;
+
+            cancelled = true;
+        }
     }
     // -------------------------------------------------------------------------
     size_t LogSession::readData( unsigned char* buf, int len )
@@ -504,6 +553,15 @@ namespace uniset
             // отключаем старый обработчик
             if( conn )
                 conn.disconnect();
+
+            for( auto&& c : fconn )
+                c.disconnect();
+
+            fconn.clear();
+
+            // в режиме фильтра в общем буфере "чужие" записи,
+            // поэтому переходим на собственный, куда пишутся только выбранные логи
+            createOwnRing();
         }
 
         // обрабатываем команды только если нашли подходящие логи
@@ -542,7 +600,7 @@ namespace uniset
                     break;
 
                 case LogServerTypes::cmdFilterMode:
-                    l.log->signal_stream_event().connect( sigc::mem_fun(this, &LogSession::logOnEvent) );
+                    fconn.emplace_back( l.log->signal_stream_event().connect( sigc::mem_fun(this, &LogSession::logOnEvent) ) );
                     break;
 
                 case LogServerTypes::cmdShowLocalTime:
@@ -575,11 +633,7 @@ namespace uniset
             LogAgregator::printLogList(s, loglist);
             s << "=====================" << endl << endl;
 
-            {
-                std::unique_lock<std::mutex> lk(logbuf_mutex);
-                logbuf.emplace(new UTCPCore::Buffer(s.str()));
-            }
-
+            cmdbuf.emplace(new UTCPCore::Buffer(s.str()));
             io.set(ev::WRITE);
         }
 
@@ -589,11 +643,7 @@ namespace uniset
 
             if( !ret.empty() )
             {
-                {
-                    std::unique_lock<std::mutex> lk(logbuf_mutex);
-                    logbuf.emplace(new UTCPCore::Buffer( std::move(ret) ));
-                }
-
+                cmdbuf.emplace(new UTCPCore::Buffer(ret));
                 io.set(ev::WRITE);
             }
         }
@@ -629,9 +679,7 @@ namespace uniset
             return;
         }
 
-        std::unique_lock<std::mutex> lk(logbuf_mutex);
-
-        if( !logbuf.empty() )
+        if( !cmdbuf.empty() || ring->pending(cursor) > 0 )
             return;
 
         // если клиент уже отвалился.. то при попытке write.. сессия будет закрыта.
@@ -641,7 +689,7 @@ namespace uniset
         try
         {
             //
-            logbuf.emplace(new UTCPCore::Buffer(" \b"));
+            cmdbuf.emplace(new UTCPCore::Buffer(" \b"));
         }
         catch(...) {}
 
@@ -694,7 +742,6 @@ namespace uniset
     // ---------------------------------------------------------------------
     void LogSession::setMaxBufSize( size_t num )
     {
-        std::unique_lock<std::mutex> lk(logbuf_mutex);
         maxRecordsNum = num;
     }
     // ---------------------------------------------------------------------
@@ -710,20 +757,21 @@ namespace uniset
     // ---------------------------------------------------------------------
     string LogSession::getShortInfo() noexcept
     {
-        size_t sz = 0;
-        {
-            std::unique_lock<std::mutex> lk(logbuf_mutex);
-            sz = logbuf.size();
-        }
+        // вызывается не из потока сессии, поэтому ring/cursor не трогаем,
+        // а используем то, что опубликовано в publishCursor()
+        const LogRing* r = statRing.load(std::memory_order_relaxed);
+        LogRing::Cursor c;
+        c.seq = statSeq.load(std::memory_order_acquire);
+        const size_t sz = r->pending(c);
 
         ostringstream inf;
 
         inf << "client: " << caddr << " :"
-            << " buffer[" << maxRecordsNum << "]: size=" << sz
-            << " maxCount=" << maxCount
-            << " minSizeMsg=" << minSizeMsg
-            << " maxSizeMsg=" << maxSizeMsg
-            << " numLostMsg=" << numLostMsg
+            << " buffer[" << r->capacity() << " bytes" << (r == sring.get() ? " shared" : "") << "]: size=" << sz
+            << " maxCount=" << maxCount.load()
+            << " minSizeMsg=" << r->minRecordSize()
+            << " maxSizeMsg=" << r->maxRecordSize()
+            << " numLostMsg=" << numLostMsg.load()
             << endl;
 
         return inf.str();
@@ -734,22 +782,23 @@ namespace uniset
     {
         Poco::JSON::Object::Ptr jret = new Poco::JSON::Object();
 
-        size_t sz = 0;
-        {
-            std::unique_lock<std::mutex> lk(logbuf_mutex);
-            sz = logbuf.size();
-        }
+        // см. getShortInfo()
+        const LogRing* r = statRing.load(std::memory_order_relaxed);
+        LogRing::Cursor c;
+        c.seq = statSeq.load(std::memory_order_acquire);
+        const size_t sz = r->pending(c);
 
         Poco::JSON::Object::Ptr jdata = new Poco::JSON::Object();
         jret->set(caddr, jdata);
 
         jdata->set("client", caddr);
-        jdata->set("maxbufsize", maxRecordsNum);
+        jdata->set("maxbufsize", r->capacity()); // в байтах
+        jdata->set("sharedbuf", r == sring.get());
         jdata->set("bufsize", sz);
-        jdata->set("maxCount", maxCount);
-        jdata->set("minSizeMsg", minSizeMsg);
-        jdata->set("maxSizeMsg", maxSizeMsg);
-        jdata->set("numLostMsg", numLostMsg);
+        jdata->set("maxCount", maxCount.load());
+        jdata->set("minSizeMsg", r->minRecordSize());
+        jdata->set("maxSizeMsg", r->maxRecordSize());
+        jdata->set("numLostMsg", numLostMsg.load());
 
         return jret;
     }
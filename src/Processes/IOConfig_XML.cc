@@ -15,6 +15,8 @@
  */
 // --------------------------------------------------------------------------
 #include <sstream>
+#include <algorithm>
+#include <cstdlib>
 #include "Configuration.h"
 #include "IOController.h"
 #include "IONotifyController.h"
@@ -152,6 +154,68 @@ namespace uniset
         return lst;
     }
     // --------------------------------------------------------------------------
+    IONotifyController::ConsumerFilterMap IOConfig_XML::readConsumerFilters()
+    {
+        IONotifyController::ConsumerFilterMap fmap;
+
+        xmlNode* snode = root ? root : uxml->findNode( uxml->getFirstNode(), "sensors");
+
+        if( !snode )
+            return fmap;
+
+        UniXML::iterator it(snode);
+
+        if( !it.goChildren() )
+            return fmap;
+
+        for( ; it.getCurrent(); ++it )
+        {
+            if( !check_list_item(it) )
+                continue;
+
+            xmlNode* cnode = uxml->findNodeLevel1(it.getCurrent(), "consumers");
+
+            if( !cnode )
+                continue;
+
+            UniXML::iterator cit(cnode);
+
+            if( !cit.goChildren() )
+                continue;
+
+            IOController_i::SensorInfo si;
+
+            if( !getBaseInfo(it.getCurrent(), si) )
+                continue;
+
+            for( ; cit.getCurrent(); ++cit )
+            {
+                IONotifyController::ConsumerFilterInfo f;
+                f.filter.deadband = cit.getIntProp("deadband");
+                f.filter.deadband_pct = atof(cit.getProp("deadband_pct").c_str());
+                f.filter.minInterval = std::max(0, cit.getPIntProp("min_interval", 0));
+
+                if( f.filter.deadband == 0 && f.filter.deadband_pct == 0 && f.filter.minInterval == 0 )
+                    continue;
+
+                if( f.filter.deadband < 0 || f.filter.deadband_pct < 0 )
+                {
+                    uwarn << "(IOConfig_XML::readConsumerFilters): bad filter for consumer '" << cit.getProp("name")
+                          << "' (sensor " << it.getProp("name") << "): deadband=" << f.filter.deadband
+                          << " deadband_pct=" << f.filter.deadband_pct << endl;
+                    continue;
+                }
+
+                if( !getConsumerInfo(cit, f.ci.id, f.ci.node) )
+                    continue;
+
+                fmap[si.id].emplace_back( std::move(f) );
+            }
+        }
+
+        return fmap;
+    }
+    // --------------------------------------------------------------------------
     IOController::IOStateList IOConfig_XML::read_list( xmlNode* node )
     {
         IOController::IOStateList lst;
@@ -21,6 +21,8 @@
 //#include <stream.h>
 #include <sstream>
 #include <cmath>
+#include <cstdlib>
+#include <algorithm>
 #include <unordered_set>
 #include "UInterface.h"
 #include "IOController.h"
@@ -69,6 +71,7 @@ IOController::~IOController()
 // ------------------------------------------------------------------------------------------
 bool IOController::activateObject()
 {
+    changesStop = false;
     bool res = UniSetManager::activateObject();
     sensorsRegistration();
 
@@ -80,6 +83,13 @@ bool IOController::activateObject()
 // ------------------------------------------------------------------------------------------
 bool IOController::deactivateObject()
 {
+    // будим ожидающих изменений ('/changes')
+    {
+        std::lock_guard<std::mutex> l(changesMutex);
+        changesStop = true;
+    }
+    changesEvent.notify_all();
+
     sensorsUnregistration();
     return UniSetManager::deactivateObject();
 }
@@ -247,8 +257,14 @@ void IOController::localSetUndefinedState( IOStateList::iterator& li,
                 usi->value = usi->real_value;
         }
 
+        if( changed )
+            usi->changeSeq = ++changeSeq;
+
     }    // unlock
 
+    if( changed )
+        notifyChanges();
+
     // сперва локальные события...
     try
     {
@@ -441,15 +457,10 @@ long IOController::localSetValue( std::shared_ptr<USensorInfo>& usi,
 
         if( changed || blockChanged || freezeChanged )
         {
-            ulog4 << myname << "(localSetValue): (" << usi->si.id << ")"
-                  << uniset_conf()->oind->getNameById(usi->si.id)
-                  << " newvalue=" << value
-                  << " value=" << usi->value
-                  << " blocked=" << usi->blocked
-                  << " frozen=" << usi->frozen
-                  << " real_value=" << usi->real_value
-                  << " supplier=" << sup_id
-                  << endl;
+            // выполняется под блокировкой датчика, поэтому без форматирования (см. DebugBinLog.h)
+            ublog(ulog(), LEVEL4, "{}(localSetValue): ({}){} newvalue={} value={} blocked={} frozen={} real_value={} supplier={}",
+                  myname, usi->si.id, uniset_conf()->oind->getNameById(usi->si.id),
+                  value, usi->value, usi->blocked, usi->frozen, usi->real_value, sup_id);
 
             usi->real_value = value;
 
@@ -461,6 +472,7 @@ long IOController::localSetValue( std::shared_ptr<USensorInfo>& usi,
             retValue = usi->value;
 
             usi->nchanges++; // статистика
+            usi->changeSeq = ++changeSeq;
 
             // запоминаем время изменения
             try
@@ -476,6 +488,9 @@ long IOController::localSetValue( std::shared_ptr<USensorInfo>& usi,
         }
     }    // unlock
 
+    if( changed || blockChanged || freezeChanged )
+        notifyChanges();
+
     try
     {
         if( changed || blockChanged || freezeChanged )
@@ -499,6 +514,38 @@ long IOController::localSetValue( std::shared_ptr<USensorInfo>& usi,
     return retValue;
 }
 // ------------------------------------------------------------------------------------------
+void IOController::notifyChanges() noexcept
+{
+    // mutex захватываем, только если кто-то ждёт (см. waitChanges)
+    if( changesWaiters == 0 )
+        return;
+
+    {
+        std::lock_guard<std::mutex> l(changesMutex);
+    }
+
+    changesEvent.notify_all();
+}
+// ------------------------------------------------------------------------------------------
+uint64_t IOController::waitChanges( uint64_t seq, timeout_t msec )
+{
+    if( changeSeq > seq || msec == 0 )
+        return changeSeq;
+
+    changesWaiters++;
+
+    {
+        std::unique_lock<std::mutex> l(changesMutex);
+        changesEvent.wait_for(l, std::chrono::milliseconds(msec), [&]
+        {
+            return changeSeq > seq || changesStop;
+        });
+    }
+
+    changesWaiters--;
+    return changeSeq;
+}
+// ------------------------------------------------------------------------------------------
 IOType IOController::getIOType( uniset::ObjectId sid )
 {
     auto ali = ioList.find(sid);
@@ -864,6 +911,10 @@ IOController::IOStateList::iterator IOController::myioEnd()
 void IOController::initIOList( const IOController::IOStateList&& l )
 {
     ioList = std::move(l);
+
+    // начальные номера изменений, чтобы '/changes?since=0' возвращал все датчики
+    for( auto&& s : ioList )
+        s.second->changeSeq = ++changeSeq;
 }
 // ----------------------------------------------------------------------------------------
 void IOController::for_iolist( IOController::UFunction f )
@@ -1165,6 +1216,20 @@ Poco::JSON::Object::Ptr IOController::httpHelp( const Poco::URI::QueryParameters
         myhelp.add(cmd);
     }
 
+    {
+        // 'changes'
+        uniset::json::help::item cmd("changes", "get sensors changed since the given change number (long-poll or SSE stream)");
+        cmd.param("since=N", "[optional] change number from the previous response ('seq'). 0 - all sensors. Default: 0");
+        cmd.param("timeout=msec", "[optional] long-poll: wait for changes up to msec. Default: 0 (do not wait)");
+        cmd.param("sse", "[optional] Server-Sent Events stream (or header 'Accept: text/event-stream')");
+        cmd.param("interval=msec", "[optional] SSE: minimal interval between events. Default: 100");
+        cmd.param("filter=id1,name2,id3", "[optional] filter by ID or name (mixed format, comma-separated)");
+        cmd.param("iotype", "[optional] filter by type: AI|AO|DI|DO");
+        cmd.param("shortInfo", "[optional] get short information for sensors");
+        cmd.param("supplier", "[optional] But required for access control");
+        myhelp.add(cmd);
+    }
+
     {
         // 'sensors'
         uniset::json::help::item cmd("sensors", "get all sensors with filtering and pagination");
@@ -1203,6 +1268,10 @@ Poco::JSON::Object::Ptr IOController::httpRequest( const UHttp::HttpRequestConte
     if( ctx.depth() >= 1 && ctx[0] == "sensors" )
         return request_sensors(ctx[0], ctx.params);
 
+    // /api/v2/ObjectName/changes?...
+    if( ctx.depth() >= 1 && ctx[0] == "changes" )
+        return request_changes(ctx);
+
     return UniSetObject::httpRequest(ctx);
 }
 // -----------------------------------------------------------------------------
@@ -1531,6 +1600,240 @@ Poco::JSON::Object::Ptr IOController::request_freeze( const string& req, const P
     return jdata;
 }
 // -----------------------------------------------------------------------------
+size_t IOController::getChanges( Poco::JSON::Array::Ptr& jdata,
+                                 const std::vector<std::shared_ptr<USensorInfo>>& slist,
+                                 uint64_t since, uniset::ObjectId consumer_id, bool shortInfo )
+{
+    size_t count = 0;
+
+    for( auto s : slist )
+    {
+        {
+            uniset_rwmutex_rlock lock(s->val_lock);
+
+            if( s->changeSeq <= since )
+                continue;
+        }
+
+        getSensorInfo(jdata, s, consumer_id, shortInfo);
+        count++;
+    }
+
+    return count;
+}
+// -----------------------------------------------------------------------------
+Poco::JSON::Object::Ptr IOController::request_changes( const UHttp::HttpRequestContext& ctx )
+{
+    // {
+    //   "seq": N,      - номер изменения, который нужно передать в 'since' в следующем запросе
+    //   "since": M,
+    //   "sensors" [
+    //           { name: string, value: long, ...},
+    //           ...
+    //   ],
+    //   "object" { mydata... }
+    //  }
+    //
+    // Датчик попадает в ответ, если он изменился после 'since'.
+    // Гарантируется, что изменение не будет пропущено, но один и тот же датчик
+    // может прийти повторно (если изменился во время формирования ответа).
+
+    auto conf = uniset_conf();
+    uint64_t since = 0;
+    timeout_t timeout = 0;
+    timeout_t interval = 100;
+    bool shortInfo = false;
+    bool sse = false;
+    std::string filter;
+    UniversalIO::IOType iotypeFilter = UniversalIO::UnknownIOType;
+    uniset::ObjectId sup_id = DefaultObjectId;
+
+    for( const auto& p : ctx.params )
+    {
+        if( p.first == "supplier" )
+            sup_id = conf->getAnyObjectID(p.second);
+        else if( p.first == "since" )
+            since = std::strtoull(p.second.c_str(), nullptr, 10);
+        else if( p.first == "timeout" )
+            timeout = uni_atoi(p.second);
+        else if( p.first == "interval" )
+            interval = uni_atoi(p.second);
+        else if( p.first == "sse" )
+            sse = true;
+        else if( p.first == "shortInfo" )
+            shortInfo = true;
+        else if( p.first == "filter" && !p.second.empty() )
+            filter = p.second;
+        else if( p.first == "iotype" && !p.second.empty() )
+            iotypeFilter = uniset::getIOType(p.second);
+    }
+
+    if( !sse && ctx.request.get("Accept", "").find("text/event-stream") != std::string::npos )
+        sse = true;
+
+    // при переподключении EventSource сам присылает номер последнего полученного события
+    if( sse && ctx.request.has("Last-Event-ID") )
+        since = std::strtoull(ctx.request.get("Last-Event-ID").c_str(), nullptr, 10);
+
+    if( !disableHttpAccessControl )
+    {
+        if( sup_id == DefaultObjectId )
+        {
+            ostringstream err;
+            err << myname << "(request_changes): 'changes' requires 'supplier' parameter. Example: /changes?supplier=Name&...";
+            throw uniset::SystemError(err.str());
+        }
+    }
+    else if( sup_id == DefaultObjectId )
+        sup_id = getId();
+
+    // список отслеживаемых датчиков формируем один раз,
+    // датчики недоступные на чтение в него не попадают
+    std::vector<std::shared_ptr<USensorInfo>> slist;
+
+    auto addSensor = [&]( std::shared_ptr<USensorInfo>& s )
+    {
+        if( iotypeFilter != UniversalIO::UnknownIOType && s->type != iotypeFilter )
+            return;
+
+        if( sup_id != getId() && !s->checkMask(sup_id, defaultAccessMask).canRead() )
+            return;
+
+        slist.push_back(s);
+    };
+
+    if( !filter.empty() )
+    {
+        auto lst = uniset::getSInfoList(filter, conf);
+
+        for( const auto& i : lst )
+        {
+            auto it = ioList.find(i.si.id);
+
+            if( it != ioList.end() )
+                addSensor(it->second);
+        }
+
+        if( slist.empty() )
+        {
+            ostringstream err;
+            err << myname << "(request_changes): 'changes'. Unknown ID or Name. Use parameters: changes?filter=ID1,name2,ID3,...";
+            throw uniset::SystemError(err.str());
+        }
+    }
+    else
+    {
+        slist.reserve(ioList.size());
+
+        for( auto&& it : ioList )
+            addSensor(it.second);
+    }
+
+    timeout = std::min(std::max(timeout, (timeout_t)0), httpChangesMaxTimeout);
+
+    // ожидающие клиенты занимают поток http-сервера, поэтому их число ограничено
+    const bool waiting = ( sse || timeout > 0 );
+
+    if( waiting && ++changesClients > httpChangesMaxClients )
+    {
+        changesClients--;
+        ostringstream err;
+        err << myname << "(request_changes): too many clients (max: " << httpChangesMaxClients << ")";
+        ctx.response.setStatus(Poco::Net::HTTPResponse::HTTP_SERVICE_UNAVAILABLE);
+        throw uniset::SystemError(err.str());
+    }
+
+    // уменьшение счётчика клиентов при любом выходе
+    struct ClientGuard
+    {
+        std::atomic_size_t& clients;
+        const bool active;
+
+        ~ClientGuard()
+        {
+            if( active )
+                clients--;
+        }
+    } clientGuard{changesClients, waiting};
+
+    if( !sse )
+    {
+        PassiveTimer pt(timeout);
+
+        while( true )
+        {
+            const uint64_t cur = changeSeq;
+            Poco::JSON::Object::Ptr jdata = new Poco::JSON::Object();
+            auto my = httpGetMyInfo(jdata);
+            auto jsens = uniset::json::make_child_array(jdata, "sensors");
+
+            size_t count = getChanges(jsens, slist, since, sup_id, shortInfo);
+
+            if( count > 0 || timeout == 0 || pt.checkTime() || changesStop )
+            {
+                jdata->set("seq", cur);
+                jdata->set("since", since);
+                return jdata;
+            }
+
+            waitChanges(cur, pt.getLeft(timeout));
+        }
+    }
+
+    // SSE
+    ctx.response.setContentType("text/event-stream");
+    ctx.response.set("Cache-Control", "no-cache");
+    ctx.response.setChunkedTransferEncoding(true);
+    std::ostream& out = ctx.response.send();
+
+    try
+    {
+        const timeout_t heartbeat = std::max(httpChangesHeartbeat, (timeout_t)100);
+        PassiveTimer ptHeartbeat(heartbeat);
+
+        while( !changesStop && out.good() )
+        {
+            const uint64_t cur = changeSeq;
+            Poco::JSON::Array::Ptr jsens = new Poco::JSON::Array();
+
+            if( getChanges(jsens, slist, since, sup_id, shortInfo) > 0 )
+            {
+                Poco::JSON::Object::Ptr jdata = new Poco::JSON::Object();
+                jdata->set("seq", cur);
+                jdata->set("since", since);
+                jdata->set("sensors", jsens);
+
+                out << "id: " << cur << "\nevent: changes\ndata: ";
+                jdata->stringify(out);
+                out << "\n\n";
+                out.flush();
+                ptHeartbeat.reset();
+
+                // копим изменения не чаще interval
+                if( interval > 0 )
+                    msleep(interval);
+            }
+            else if( ptHeartbeat.checkTime() )
+            {
+                out << ": ping\n\n";
+                out.flush();
+                ptHeartbeat.reset();
+            }
+
+            since = cur;
+            waitChanges(cur, ptHeartbeat.getLeft(heartbeat));
+        }
+    }
+    catch( const std::exception& ex )
+    {
+        // обычно это отключение клиента
+        uinfo << myname << "(request_changes): SSE stream closed: " << ex.what() << endl;
+    }
+
+    // ответ уже отправлен
+    return nullptr;
+}
+// -----------------------------------------------------------------------------
 void IOController::getSensorInfo( Poco::JSON::Array::Ptr& jdata, std::shared_ptr<USensorInfo>& s, uniset::ObjectId consumer_id, bool shortInfo )
 {
     Poco::JSON::Object::Ptr jsens = new Poco::JSON::Object();
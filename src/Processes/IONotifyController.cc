@@ -25,11 +25,15 @@
 #include <stdio.h>
 #include <unistd.h>
 #include <iomanip>
+#include <algorithm>
+#include <functional>
+#include <cmath>
 
 #include "UInterface.h"
 #include "IONotifyController.h"
 #include "ORepHelpers.h"
 #include "Debug.h"
+#include "LatencyTrace.h"
 #include "IOConfig.h"
 
 // ------------------------------------------------------------------------------------------
@@ -74,6 +78,16 @@ IONotifyController::~IONotifyController()
 {
 	conUndef.disconnect();
 	conInit.disconnect();
+
+	{
+		std::lock_guard<std::mutex> l(pendingMutex);
+		pendingActive = false;
+	}
+
+	pendingEvent.notify_all();
+
+	if( pendingThr && pendingThr->joinable() )
+		pendingThr->join();
 }
 // ------------------------------------------------------------------------------------------
 void IONotifyController::showStatisticsForConsumer( ostringstream& inf, const std::string& consumer )
@@ -184,6 +198,7 @@ void IONotifyController::showStatisticsForConsumer( ostringstream& inf, const st
 				<< " lostEvents: " << setw(3) << s.inf.lostEvents
 				<< " attempt: " << setw(3) << s.inf.attempt
 				<< " smCount: " << setw(5) << s.inf.smCount
+				<< " filtered: " << setw(5) << s.inf.filtered
 				<< " ]"
 				<< endl;
 		}
@@ -247,6 +262,7 @@ void IONotifyController::showStatisticsForConsusmers( ostringstream& inf )
 				<< " lostEvents=" << c.lostEvents
 				<< " attempt=" << c.attempt
 				<< " smCount=" << c.smCount
+				<< " filtered=" << c.filtered
 				<< "]"
 				<< endl;
 		}
@@ -397,6 +413,10 @@ SimpleInfo* IONotifyController::getInfo( const char* userparam )
 		showStatisticsForConsumersWithLostEvent(inf);
 		inf << "-----------------------------------------------------------------------------" << endl << endl;
 	}
+	else if( param == "latency" || param == "latency:reset" )
+	{
+		// статистика задержек выводится в UniSetObject::getInfo()
+	}
 	else if( !param.empty() )
 	{
 		auto query = uniset::explode_str(param, ':');
@@ -420,7 +440,8 @@ SimpleInfo* IONotifyController::getInfo( const char* userparam )
 			<< "  consumers       - Consumers list " << endl
 			<< "  lost            - Consumers list with lostEvent > 0" << endl
 			<< "  consumer:name   - Statistic for consumer 'name'" << endl
-			<< "  sensor:name     - Statistic for sensor 'name'"
+			<< "  sensor:name     - Statistic for sensor 'name'" << endl
+			<< "  latency[:reset] - Latency trace statistics (see LatencyTrace.h)"
 			<< endl;
 	}
 
@@ -429,13 +450,24 @@ SimpleInfo* IONotifyController::getInfo( const char* userparam )
 	return i._retn();
 }
 
+// ------------------------------------------------------------------------------------------
+static void initFilter( IONotifyController::ConsumerInfoExt& c, const IONotifyController_i::NotifyFilter* f )
+{
+	c.hasFilter = ( f && (f->deadband > 0 || f->deadband_pct > 0 || f->minInterval > 0) );
+
+	if( c.hasFilter )
+		c.filter = *f;
+
+	c.sent = false;
+	c.pending = false;
+}
 // ------------------------------------------------------------------------------------------
 /*!
  *    \param lst - список в который необходимо внести потребителя
  *    \param name - имя вносимого потребителя
  *    \note Добавление произойдёт только если такого потребителя не существует в списке
 */
-bool IONotifyController::addConsumer( ConsumerListInfo& lst, const ConsumerInfo& ci )
+bool IONotifyController::addConsumer( ConsumerListInfo& lst, const ConsumerInfo& ci, const IONotifyController_i::NotifyFilter* filter )
 {
 	uniset_rwmutex_wrlock l(lst.mut);
 
@@ -447,6 +479,9 @@ bool IONotifyController::addConsumer( ConsumerListInfo& lst, const ConsumerInfo&
 			// считаем что "заказчик" опять на связи
 			it.attempt = maxAttemtps;
 
+			// параметры фильтрации задаются каждым заказом
+			initFilter(it, filter);
+
 			// выставляем флаг, что заказчик опять "на связи"
 			std::lock_guard<std::mutex> lock(lostConsumersMutex);
 			auto c = lostConsumers.find(ci.id);
@@ -459,6 +494,7 @@ bool IONotifyController::addConsumer( ConsumerListInfo& lst, const ConsumerInfo&
 	}
 
 	ConsumerInfoExt cinf(ci, 0, maxAttemtps);
+	initFilter(cinf, filter);
 
 	// получаем ссылку
 	try
@@ -507,6 +543,27 @@ bool IONotifyController::removeConsumer( ConsumerListInfo& lst, const ConsumerIn
 */
 void IONotifyController::askSensor(const uniset::ObjectId sid,
 								   const uniset::ConsumerInfo& ci, UniversalIO::UIOCommand cmd )
+{
+	processAskSensor(sid, ci, cmd, nullptr);
+}
+// ------------------------------------------------------------------------------------------
+void IONotifyController::askSensorWithFilter( const uniset::ObjectId sid, const uniset::ConsumerInfo& ci,
+		UniversalIO::UIOCommand cmd, const IONotifyController_i::NotifyFilter& filter )
+{
+	if( filter.deadband < 0 || filter.deadband_pct < 0 )
+	{
+		ostringstream err;
+		err << myname << "(askSensorWithFilter): bad filter for sensor '" << uniset_conf()->oind->getNameById(sid)
+			<< "': deadband=" << filter.deadband << " deadband_pct=" << filter.deadband_pct;
+
+		throw IOController_i::IOBadParam(err.str().c_str());
+	}
+
+	processAskSensor(sid, ci, cmd, &filter);
+}
+// ------------------------------------------------------------------------------------------
+void IONotifyController::processAskSensor( const uniset::ObjectId sid, const uniset::ConsumerInfo& ci,
+		UniversalIO::UIOCommand cmd, const IONotifyController_i::NotifyFilter* filter )
 {
     // TODO: check access control
 
@@ -526,7 +583,7 @@ void IONotifyController::askSensor(const uniset::ObjectId sid,
 
 	{
 		uniset_rwmutex_wrlock lock(askIOMutex);
-		ask(askIOList, sid, ci, cmd);
+		ask(askIOList, sid, ci, cmd, filter);
 	}
 
 	auto usi = li->second;
@@ -546,12 +603,31 @@ void IONotifyController::askSensor(const uniset::ObjectId sid,
 }
 // ------------------------------------------------------------------------------------------
 void IONotifyController::ask( AskMap& askLst, const uniset::ObjectId sid,
-							  const uniset::ConsumerInfo& cons, UniversalIO::UIOCommand cmd)
+							  const uniset::ConsumerInfo& cons, UniversalIO::UIOCommand cmd,
+							  const IONotifyController_i::NotifyFilter* filter )
 {
     // TODO: check access control
 	// поиск датчика в списке
 	auto askIterator = askLst.find(sid);
 
+	// фильтр не задан при заказе - смотрим настройки из конфигурационного файла
+	if( !filter && !consumerFilters.empty() )
+	{
+		auto fi = consumerFilters.find(sid);
+
+		if( fi != consumerFilters.end() )
+		{
+			for( const auto& f : fi->second )
+			{
+				if( f.ci.id == cons.id && f.ci.node == cons.node )
+				{
+					filter = &f.filter;
+					break;
+				}
+			}
+		}
+	}
+
 	switch (cmd)
 	{
 		case UniversalIO::UIONotify: // заказ
@@ -559,11 +635,11 @@ void IONotifyController::ask( AskMap& askLst, const uniset::ObjectId sid,
 		case UniversalIO::UIONotifyFirstNotNull:
 		{
 			if( askIterator != askLst.end() )
-				addConsumer(askIterator->second, cons);
+				addConsumer(askIterator->second, cons, filter);
 			else
 			{
 				ConsumerListInfo newlst; // создаем новый список
-				addConsumer(newlst, cons);
+				addConsumer(newlst, cons, filter);
 				askLst.emplace(sid, std::move(newlst));
 			}
 
@@ -602,6 +678,11 @@ long IONotifyController::localSetValue( std::shared_ptr<IOController::USensorInf
 	// оптимизация:
 	// if( !usi ) - не проверяем, т.к. считаем что это внутренние функции и несуществующий указатель передать не могут
 
+	// трассировка задержек: метка либо пришла вместе со значением (обмен в этом же процессе),
+	// либо изменение выбирается здесь (только если значение изменилось, см. ниже)
+	uint32_t trace = LatencyTrace::current();
+	const uint32_t tm = ( !trace && LatencyTrace::enabled() ) ? LatencyTrace::now() : 0;
+
 	CORBA::Long prevValue = value;
 	{
 		uniset_rwmutex_rlock lock(usi->val_lock);
@@ -613,7 +694,15 @@ long IONotifyController::localSetValue( std::shared_ptr<IOController::USensorInf
 	// Рассылаем уведомления только в случае изменения значения
 	// --------
 	if( prevValue == curValue )
+	{
+		LatencyTrace::hop(LatencyTrace::SetValue, trace);
 		return curValue;
+	}
+
+	if( tm && LatencyTrace::start() )
+		trace = tm;
+
+	LatencyTrace::hop(LatencyTrace::SetValue, trace);
 
 
 	{
@@ -624,6 +713,7 @@ long IONotifyController::localSetValue( std::shared_ptr<IOController::USensorInf
 		uniset::uniset_rwmutex_rlock lock(usi->val_lock);
 
 		SensorMessage sm(usi->makeSensorMessage(false));
+		sm.trace_tm = trace;
 
 		try
 		{
@@ -635,7 +725,10 @@ long IONotifyController::localSetValue( std::shared_ptr<IOController::USensorInf
 		ConsumerListInfo* lst = static_cast<ConsumerListInfo*>(usi->getUserData(udataConsumerList));
 
 		if( lst )
+		{
 			send(*lst, sm);
+			LatencyTrace::hop(LatencyTrace::Dispatch, trace);
+		}
 	}
 
 	// проверка порогов
@@ -656,6 +749,7 @@ long IONotifyController::localSetValue( std::shared_ptr<IOController::USensorInf
 void IONotifyController::send( ConsumerListInfo& lst, const uniset::SensorMessage& sm, const uniset::ConsumerInfo* ci  )
 {
 	TransportMessage tmsg(sm.transport_msg());
+	const auto now = std::chrono::steady_clock::now();
 
 	uniset_rwmutex_wrlock l(lst.mut);
 
@@ -663,87 +757,256 @@ void IONotifyController::send( ConsumerListInfo& lst, const uniset::SensorMessag
 	{
 		if( ci )
 		{
+			// адресная посылка (первое уведомление при заказе) идёт без фильтрации
 			if( ci->id != li->id || ci->node != li->node )
 				continue;
 		}
+		else if( li->hasFilter && !checkFilter(*li, sm, now) )
+			continue;
 
-		for( int i = 0; i < sendAttemtps; i++ )
+		pushMessage(lst, li, tmsg, sm, now);
+	}
+}
+// --------------------------------------------------------------------------------------------------------------
+bool IONotifyController::pushMessage( ConsumerListInfo& lst, ConsumerList::iterator& li, TransportMessage& tmsg,
+									  const SensorMessage& sm, std::chrono::steady_clock::time_point now )
+{
+	for( int i = 0; i < sendAttemtps; i++ )
+	{
+		try
 		{
-			try
-			{
-				if( CORBA::is_nil(li->ref) )
-				{
-					CORBA::Object_var op = ui->resolve(li->id, li->node);
-					li->ref = UniSetObject_i::_narrow(op);
-				}
-
-				tmsg.consumer = li->id;
-				li->ref->push( tmsg );
-				li->smCount++;
-				li->attempt = maxAttemtps; // reinit attempts
-				break;
-			}
-			catch( const CORBA::SystemException& ex )
-			{
-				uwarn << myname << "(IONotifyController::send): attempt=" << (maxAttemtps - li->attempt + 1)
-					  << " from " << maxAttemtps << " "
-					  << uniset_conf()->oind->getNameById(li->id) << "@" << li->node << " (CORBA::SystemException): "
-					  << ex.NP_minorString() << endl;
-			}
-			catch( const std::exception& ex )
+			if( CORBA::is_nil(li->ref) )
 			{
-				uwarn << myname << "(IONotifyController::send): attempt=" <<  (maxAttemtps - li->attempt + 1) << " "
-					  << " from " << maxAttemtps << " "
-					  << ex.what()
-					  << " for " << uniset_conf()->oind->getNameById(li->id) << "@" << li->node << endl;
+				CORBA::Object_var op = ui->resolve(li->id, li->node);
+				li->ref = UniSetObject_i::_narrow(op);
 			}
-			catch(...)
+
+			tmsg.consumer = li->id;
+			li->ref->push( tmsg );
+			li->smCount++;
+			li->attempt = maxAttemtps; // reinit attempts
+
+			if( li->hasFilter )
 			{
-				ucrit << myname << "(IONotifyController::send): attempt=" <<  (maxAttemtps - li->attempt + 1) << " "
-					  << " from " << maxAttemtps << " "
-					  << uniset_conf()->oind->getNameById(li->id) << "@" << li->node
-					  << " catch..." << endl;
+				li->sent = true;
+				li->lastValue = sm.value;
+				li->lastUndefined = sm.undefined;
+				li->lastTime = now;
+				li->pending = false;
 			}
 
-			// фиксируем только после первой попытки послать
-			if( i > 0 )
-				li->lostEvents++;
+			return true;
+		}
+		catch( const CORBA::SystemException& ex )
+		{
+			uwarn << myname << "(IONotifyController::send): attempt=" << (maxAttemtps - li->attempt + 1)
+				  << " from " << maxAttemtps << " "
+				  << uniset_conf()->oind->getNameById(li->id) << "@" << li->node << " (CORBA::SystemException): "
+				  << ex.NP_minorString() << endl;
+		}
+		catch( const std::exception& ex )
+		{
+			uwarn << myname << "(IONotifyController::send): attempt=" <<  (maxAttemtps - li->attempt + 1) << " "
+				  << " from " << maxAttemtps << " "
+				  << ex.what()
+				  << " for " << uniset_conf()->oind->getNameById(li->id) << "@" << li->node << endl;
+		}
+		catch(...)
+		{
+			ucrit << myname << "(IONotifyController::send): attempt=" <<  (maxAttemtps - li->attempt + 1) << " "
+				  << " from " << maxAttemtps << " "
+				  << uniset_conf()->oind->getNameById(li->id) << "@" << li->node
+				  << " catch..." << endl;
+		}
 
-			try
+		// фиксируем только после первой попытки послать
+		if( i > 0 )
+			li->lostEvents++;
+
+		try
+		{
+			if( maxAttemtps > 0 && --(li->attempt) <= 0 )
 			{
-				if( maxAttemtps > 0 && --(li->attempt) <= 0 )
+				uwarn << myname << "(IONotifyController::send): ERASE FROM CONSUMERS:  "
+					  << uniset_conf()->oind->getNameById(li->id) << "@" << li->node << endl;
+
 				{
-					uwarn << myname << "(IONotifyController::send): ERASE FROM CONSUMERS:  "
-						  << uniset_conf()->oind->getNameById(li->id) << "@" << li->node << endl;
+					std::lock_guard<std::mutex> lock(lostConsumersMutex);
+					auto& c = lostConsumers[li->id];
 
+					// если уже выставлен флаг что "заказчик" пропал, то не надо увеличивать "счётчик"
+					// видимо мы уже зафиксировали его пропажу на другом датчике...
+					if( !c.lost )
 					{
-						std::lock_guard<std::mutex> lock(lostConsumersMutex);
-						auto& c = lostConsumers[li->id];
-
-						// если уже выставлен флаг что "заказчик" пропал, то не надо увеличивать "счётчик"
-						// видимо мы уже зафиксировали его пропажу на другом датчике...
-						if( !c.lost )
-						{
-							c.count += 1;
-							c.lost = true;
-						}
+						c.count += 1;
+						c.lost = true;
 					}
-
-					li = lst.clst.erase(li);
-					--li;
-					break;
 				}
 
-
-				li->ref = UniSetObject_i::_nil();
+				li = lst.clst.erase(li);
+				--li;
+				return false;
 			}
-			catch( const std::exception& ex )
+
+
+			li->ref = UniSetObject_i::_nil();
+		}
+		catch( const std::exception& ex )
+		{
+			uwarn << myname << "(IONotifyController::send): UniSetObject_i::_nil() "
+				  << ex.what()
+				  << " for " << uniset_conf()->oind->getNameById(li->id) << "@" << li->node << endl;
+		}
+	}
+
+	return true;
+}
+// --------------------------------------------------------------------------------------------------------------
+bool IONotifyController::checkFilter( ConsumerInfoExt& c, const SensorMessage& sm, std::chrono::steady_clock::time_point now )
+{
+	// первое сообщение (не с чем сравнивать) и смена признака undefined посылаются всегда
+	if( !c.sent || sm.undefined != c.lastUndefined )
+		return true;
+
+	if( sm.sensor_type == UniversalIO::AI || sm.sensor_type == UniversalIO::AO )
+	{
+		double deadband = c.filter.deadband;
+
+		if( c.filter.deadband_pct > 0 )
+		{
+			// процент от диапазона, а если он не задан, от последнего посланного значения
+			const double range = std::fabs( (double)sm.ci.maxCal - (double)sm.ci.minCal );
+			const double base = ( range > 0 ) ? range : std::fabs( (double)c.lastValue );
+			deadband = std::max(deadband, base * c.filter.deadband_pct / 100.0);
+		}
+
+		if( deadband > 0 && std::fabs( (double)sm.value - (double)c.lastValue ) < deadband )
+		{
+			// значение вернулось в зону нечувствительности, отложенная посылка уже не нужна
+			c.pending = false;
+			c.filtered++;
+			return false;
+		}
+	}
+
+	if( c.filter.minInterval > 0 )
+	{
+		const auto next = c.lastTime + std::chrono::milliseconds(c.filter.minInterval);
+
+		if( now < next )
+		{
+			// последнее значение будет послано по истечении интервала (см. sendPending)
+			if( !c.pending )
 			{
-				uwarn << myname << "(IONotifyController::send): UniSetObject_i::_nil() "
-					  << ex.what()
-					  << " for " << uniset_conf()->oind->getNameById(li->id) << "@" << li->node << endl;
+				c.pending = true;
+				schedulePending(sm.id, next);
 			}
+
+			c.filtered++;
+			return false;
+		}
+	}
+
+	return true;
+}
+// --------------------------------------------------------------------------------------------------------------
+void IONotifyController::schedulePending( const ObjectId sid, std::chrono::steady_clock::time_point tm )
+{
+	std::lock_guard<std::mutex> l(pendingMutex);
+
+	if( !pendingActive )
+		return;
+
+	// поток запускается только если кто-то из заказчиков использует minInterval
+	if( !pendingThr )
+		pendingThr = std::unique_ptr<std::thread>(new std::thread(&IONotifyController::pendingThread, this));
+
+	const bool wakeup = pendingQueue.empty() || tm < pendingQueue.front().first;
+
+	pendingQueue.emplace_back(tm, sid);
+	std::push_heap(pendingQueue.begin(), pendingQueue.end(), std::greater<PendingItem>());
+
+	if( wakeup )
+		pendingEvent.notify_one();
+}
+// --------------------------------------------------------------------------------------------------------------
+void IONotifyController::pendingThread()
+{
+	std::unique_lock<std::mutex> l(pendingMutex);
+
+	while( pendingActive )
+	{
+		if( pendingQueue.empty() )
+		{
+			pendingEvent.wait(l);
+			continue;
+		}
+
+		const auto tm = pendingQueue.front().first;
+
+		if( std::chrono::steady_clock::now() < tm )
+		{
+			pendingEvent.wait_until(l, tm);
+			continue;
+		}
+
+		std::pop_heap(pendingQueue.begin(), pendingQueue.end(), std::greater<PendingItem>());
+		const ObjectId sid = pendingQueue.back().second;
+		pendingQueue.pop_back();
+
+		// рассылка идёт без pendingMutex (его захватывает send при откладывании посылки)
+		l.unlock();
+
+		try
+		{
+			sendPending(sid);
+		}
+		catch( const std::exception& ex )
+		{
+			ucrit << myname << "(IONotifyController::pendingThread): " << ex.what() << endl;
 		}
+
+		l.lock();
+	}
+}
+// --------------------------------------------------------------------------------------------------------------
+void IONotifyController::sendPending( const ObjectId sid )
+{
+	auto it = myiofind(sid);
+
+	if( it == myioEnd() )
+		return;
+
+	auto usi = it->second;
+	ConsumerListInfo* lst = static_cast<ConsumerListInfo*>(usi->getUserData(udataConsumerList));
+
+	if( !lst )
+		return;
+
+	uniset::uniset_rwmutex_rlock vlock(usi->val_lock);
+
+	SensorMessage sm(usi->makeSensorMessage(false));
+	TransportMessage tmsg(sm.transport_msg());
+	const auto now = std::chrono::steady_clock::now();
+
+	uniset_rwmutex_wrlock l(lst->mut);
+
+	for( auto li = lst->clst.begin(); li != lst->clst.end(); ++li )
+	{
+		// для каждого отложенного изменения в очереди есть своя запись (см. checkFilter)
+		if( !li->pending || now < li->lastTime + std::chrono::milliseconds(li->filter.minInterval) )
+			continue;
+
+		// значение вернулось к последнему посланному
+		if( li->sent && li->lastValue == sm.value && li->lastUndefined == sm.undefined )
+		{
+			li->pending = false;
+			continue;
+		}
+
+		// не смогли послать - пробуем ещё раз через интервал
+		if( pushMessage(*lst, li, tmsg, sm, now) && li->pending )
+			schedulePending(sid, now + std::chrono::milliseconds(li->filter.minInterval));
 	}
 }
 // --------------------------------------------------------------------------------------------------------------
@@ -768,7 +1031,10 @@ void IONotifyController::readConf()
 	try
 	{
 		if( restorer )
+		{
 			initIOList( std::move(restorer->read()) );
+			consumerFilters = restorer->readConsumerFilters();
+		}
 	}
 	catch( const std::exception& ex )
 	{
@@ -1355,6 +1621,16 @@ Poco::JSON::Object::Ptr IONotifyController::getConsumers(ObjectId sid, ConsumerL
 		consumer->set("lostEvents", c.lostEvents);
 		consumer->set("attempt", c.attempt);
 		consumer->set("smCount", c.smCount);
+		consumer->set("filtered", c.filtered);
+
+		if( c.hasFilter )
+		{
+			auto jfilter = uniset::json::make_child(consumer, "filter");
+			jfilter->set("deadband", c.filter.deadband);
+			jfilter->set("deadband_pct", c.filter.deadband_pct);
+			jfilter->set("minInterval", c.filter.minInterval);
+		}
+
 		jcons->add(consumer);
 	}
 
@@ -58,18 +58,22 @@ timeout_t LT_Object::checkTimers( UniSetObject* obj )
         }
 
         // защита от непрерывного потока сообщений
-        if( tmLast.getCurrent() < UniSetTimer::MinQuantityTime )
+        if( tmLast.getCurrent() < tmQuantity )
         {
             // корректируем сперва sleepTime
             sleepTime = tmLast.getLeft(sleepTime);
 
-            if( sleepTime < UniSetTimer::MinQuantityTime )
+            if( sleepTime < tmQuantity )
             {
-                sleepTime = UniSetTimer::MinQuantityTime;
+                sleepTime = tmQuantity;
                 return sleepTime;
             }
         }
 
+        // при малом кванте оставшееся время считаем по таймеру заказа
+        // (иначе накапливается ошибка округления при частых проверках)
+        const bool precise = ( tmQuantity < UniSetTimer::MinQuantityTime );
+
         {
             // lock
             uniset_rwmutex_wrlock lock(lstMutex);
@@ -99,6 +103,10 @@ timeout_t LT_Object::checkTimers( UniSetObject* obj )
 
                     li->reset();
                 }
+                else if( precise )
+                {
+                    li->curTimeMS = li->tmr.getLeft(li->tmr.getInterval());
+                }
                 else
                 {
                     li->curTimeMS = tmLast.getLeft(li->curTimeMS);
@@ -109,8 +117,8 @@ timeout_t LT_Object::checkTimers( UniSetObject* obj )
                     sleepTime = li->curTimeMS;
             }
 
-            if( sleepTime < UniSetTimer::MinQuantityTime )
-                sleepTime = UniSetTimer::MinQuantityTime;
+            if( sleepTime < tmQuantity )
+                sleepTime = tmQuantity;
         } // unlock
 
         tmLast.reset();
@@ -151,6 +159,16 @@ timeout_t LT_Object::getTimeLeft( TimerId timerid ) const
     return 0;
 }
 // ------------------------------------------------------------------------------------------
+void LT_Object::setTimersQuantity( timeout_t msec ) noexcept
+{
+    tmQuantity = msec;
+}
+// ------------------------------------------------------------------------------------------
+timeout_t LT_Object::getTimersQuantity() const noexcept
+{
+    return tmQuantity;
+}
+// ------------------------------------------------------------------------------------------
 LT_Object::TimersList LT_Object::getTimersList() const
 {
     uniset_rwmutex_rlock l(lstMutex);
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2025 Pavel Vainerman.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, version 2.1.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+// --------------------------------------------------------------------------
+#include <unistd.h>
+#include <errno.h>
+#include <cstring>
+#include <sstream>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include "Exceptions.h"
+#include "PassiveTimer.h"
+// ------------------------------------------------------------------------------------------
+using namespace std;
+// ------------------------------------------------------------------------------------------
+namespace uniset
+{
+    // ------------------------------------------------------------------------------------------
+    PassiveEpollTimer::PassiveEpollTimer()
+    {
+        epfd = epoll_create1(EPOLL_CLOEXEC);
+        evfd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        tmfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+
+        bool ok = ( epfd != -1 && evfd != -1 && tmfd != -1 );
+
+        if( ok )
+        {
+            struct epoll_event ev;
+            memset(&ev, 0, sizeof(ev));
+            ev.events = EPOLLIN;
+            ev.data.fd = evfd;
+            ok = ( epoll_ctl(epfd, EPOLL_CTL_ADD, evfd, &ev) == 0 );
+
+            ev.data.fd = tmfd;
+            ok = ok && ( epoll_ctl(epfd, EPOLL_CTL_ADD, tmfd, &ev) == 0 );
+        }
+
+        if( !ok )
+        {
+            ostringstream err;
+            err << "(PassiveEpollTimer): init failed: " << strerror(errno);
+
+            for( auto fd : { epfd, evfd, tmfd } )
+            {
+                if( fd != -1 )
+                    close(fd);
+            }
+
+            throw SystemError(err.str());
+        }
+
+        fdevents.reserve(16);
+    }
+    // ------------------------------------------------------------------------------------------
+    PassiveEpollTimer::~PassiveEpollTimer() noexcept
+    {
+        close(tmfd);
+        close(evfd);
+        close(epfd);
+    }
+    // ------------------------------------------------------------------------------------------
+    void PassiveEpollTimer::terminate() noexcept
+    {
+        // если "звонок" уже выставлен, то второй раз "звонить" не надо
+        if( pending.exchange(true, std::memory_order_acq_rel) )
+            return;
+
+        uint64_t v = 1;
+
+        if( ::write(evfd, &v, sizeof(v)) == sizeof(v) )
+            stDoorbells.fetch_add(1, std::memory_order_relaxed);
+    }
+    // ------------------------------------------------------------------------------------------
+    bool PassiveEpollTimer::wait( timeout_t time_msec ) noexcept
+    {
+        fdevents.clear();
+
+        timeout_t t_msec = PassiveTimer::setTiming(time_msec); // вызываем для совместимости с обычным PassiveTimer-ом
+
+        int timeout = -1;
+        struct itimerspec its;
+        memset(&its, 0, sizeof(its));
+
+        if( time_msec == 0 )
+            timeout = 0;
+        else if( time_msec != WaitUpTime )
+        {
+            its.it_value.tv_sec = t_msec / 1000;
+            its.it_value.tv_nsec = (t_msec % 1000) * 1000000;
+        }
+
+        // при WaitUpTime (и 0) таймер "разоружается" (мог остаться от предыдущего ожидания)
+        if( timerfd_settime(tmfd, 0, &its, nullptr) == -1 )
+            return false;
+
+        struct epoll_event evs[16];
+        int n = 0;
+
+        do
+        {
+            n = epoll_wait(epfd, evs, 16, timeout);
+        }
+        while( n < 0 && errno == EINTR );
+
+        if( n < 0 )
+            return false;
+
+        uint64_t v;
+
+        for( int i = 0; i < n; i++ )
+        {
+            const int fd = evs[i].data.fd;
+
+            if( fd == evfd )
+            {
+                if( ::read(evfd, &v, sizeof(v)) > 0 )
+                    stWakeups++;
+
+                // после сброса (acquire) будут видны все сообщения, помещённые в очередь до terminate()
+                pending.exchange(false, std::memory_order_acq_rel);
+            }
+            else if( fd == tmfd )
+            {
+                if( ::read(tmfd, &v, sizeof(v)) < 0 ) {}
+            }
+            else
+            {
+                try
+                {
+                    fdevents.push_back({ fd, evs[i].events });
+                }
+                catch(...) {}
+            }
+        }
+
+        return true;
+    }
+    // ------------------------------------------------------------------------------------------
+    bool PassiveEpollTimer::addFd( int fd, uint32_t events ) noexcept
+    {
+        if( fd < 0 || fd == evfd || fd == tmfd )
+            return false;
+
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events = events;
+        ev.data.fd = fd;
+
+        if( epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev) == 0 )
+            return true;
+
+        // уже добавлен - меняем маску
+        if( errno == EEXIST )
+            return ( epoll_ctl(epfd, EPOLL_CTL_MOD, fd, &ev) == 0 );
+
+        return false;
+    }
+    // ------------------------------------------------------------------------------------------
+    bool PassiveEpollTimer::removeFd( int fd ) noexcept
+    {
+        if( fd < 0 || fd == evfd || fd == tmfd )
+            return false;
+
+        return ( epoll_ctl(epfd, EPOLL_CTL_DEL, fd, nullptr) == 0 );
+    }
+    // ------------------------------------------------------------------------------------------
+} // end of namespace uniset
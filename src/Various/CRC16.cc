@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2025 Pavel Vainerman.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, version 2.1.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+// -------------------------------------------------------------------------
+#include <cstring>
+#include "CRC16.h"
+// -------------------------------------------------------------------------
+#if defined(__x86_64__) || defined(__i386__)
+#define CRC16_USE_CLMUL 1
+#include <immintrin.h>
+#endif
+// -------------------------------------------------------------------------
+namespace uniset
+{
+    // -------------------------------------------------------------------------
+    using namespace std;
+    // -------------------------------------------------------------------------
+    namespace
+    {
+        const uint16_t POLY = 0xa001; // x^16 + x^15 + x^2 + 1 (отражённый)
+
+        // для буферов меньше этого размера "быстрые" реализации не дают выигрыша
+        const size_t SMALL_BUFFER = 8;
+
+        // tab[k][i] - CRC байта i, за которым следуют k нулевых байт
+        struct Tables
+        {
+            uint16_t tab[16][256];
+
+            Tables() noexcept
+            {
+                for( size_t i = 0; i < 256; i++ )
+                {
+                    uint16_t crc = i;
+
+                    for( size_t b = 0; b < 8; b++ )
+                        crc = (crc & 1) ? (crc >> 1) ^ POLY : (crc >> 1);
+
+                    tab[0][i] = crc;
+                }
+
+                for( size_t i = 0; i < 256; i++ )
+                {
+                    for( size_t k = 1; k < 16; k++ )
+                        tab[k][i] = (tab[k - 1][i] >> 8) ^ tab[0][tab[k - 1][i] & 0xff];
+                }
+            }
+        };
+
+        // таблицы строятся при первом обращении (в том числе из статических конструкторов других модулей)
+        inline const Tables& tables() noexcept
+        {
+            static const Tables t;
+            return t;
+        }
+        // -------------------------------------------------------------------------
+        uint16_t crc_bitwise( uint16_t crc, const uint8_t* p, size_t len ) noexcept
+        {
+            while( len-- )
+            {
+                crc ^= *(p++);
+
+                for( size_t i = 0; i < 8; i++ )
+                    crc = (crc & 1) ? (crc >> 1) ^ POLY : (crc >> 1);
+            }
+
+            return crc;
+        }
+        // -------------------------------------------------------------------------
+        inline uint16_t crc_table( uint16_t crc, const uint8_t* p, size_t len ) noexcept
+        {
+            const uint16_t* t = tables().tab[0];
+
+            while( len-- )
+                crc = (crc >> 8) ^ t[(crc ^ * (p++)) & 0xff];
+
+            return crc;
+        }
+        // -------------------------------------------------------------------------
+        uint16_t crc_slice8( uint16_t crc, const uint8_t* p, size_t len ) noexcept
+        {
+            const auto& t = tables().tab;
+
+            for( ; len >= 8; len -= 8, p += 8 )
+            {
+                const uint8_t b0 = p[0] ^ (crc & 0xff);
+                const uint8_t b1 = p[1] ^ (crc >> 8);
+
+                crc = t[7][b0] ^ t[6][b1] ^ t[5][p[2]] ^ t[4][p[3]]
+                      ^ t[3][p[4]] ^ t[2][p[5]] ^ t[1][p[6]] ^ t[0][p[7]];
+            }
+
+            return crc_table(crc, p, len);
+        }
+        // -------------------------------------------------------------------------
+        uint16_t crc_slice16( uint16_t crc, const uint8_t* p, size_t len ) noexcept
+        {
+            const auto& t = tables().tab;
+
+            for( ; len >= 16; len -= 16, p += 16 )
+            {
+                const uint8_t b0 = p[0] ^ (crc & 0xff);
+                const uint8_t b1 = p[1] ^ (crc >> 8);
+
+                crc = t[15][b0] ^ t[14][b1] ^ t[13][p[2]] ^ t[12][p[3]]
+                      ^ t[11][p[4]] ^ t[10][p[5]] ^ t[9][p[6]] ^ t[8][p[7]]
+                      ^ t[7][p[8]] ^ t[6][p[9]] ^ t[5][p[10]] ^ t[4][p[11]]
+                      ^ t[3][p[12]] ^ t[2][p[13]] ^ t[1][p[14]] ^ t[0][p[15]];
+            }
+
+            return crc_slice8(crc, p, len);
+        }
+        // -------------------------------------------------------------------------
+#ifdef CRC16_USE_CLMUL
+        /*
+         * "Свёртка" (folding) при помощи умножения без переносов.
+         * CRC зависит только от остатка сообщения по модулю полинома P, поэтому
+         * блок A (128 бит), за которым на расстоянии n бит идёт блок B, можно заменить на
+         * A*(x^n mod P) ^ B, не меняя CRC. В "отражённом" представлении (младший бит первого байта -
+         * старшая степень) младшее 64-битное слово блока - старшая половина многочлена.
+         * Когда данных остаётся меньше блока, досчитываем CRC по свёрнутому блоку и "хвосту" таблицей.
+         */
+        // константа для умножения на x^n: (x^(n-1) mod P) * x, бит j соответствует x^(64-j)
+        uint64_t fold_const( size_t n ) noexcept
+        {
+            uint32_t r = 1; // x^0 (обычное представление: бит d - x^d)
+
+            for( size_t i = 0; i < n - 1; i++ )
+            {
+                r <<= 1;
+
+                if( r & 0x10000 )
+                    r ^= 0x18005;
+            }
+
+            uint64_t k = 0;
+
+            for( size_t d = 0; d < 16; d++ )
+            {
+                if( r & (1 << d) )
+                    k |= (uint64_t)1 << (63 - d); // (d+1)-я степень -> бит 64-(d+1)
+            }
+
+            return k;
+        }
+        // -------------------------------------------------------------------------
+        struct FoldConsts
+        {
+            __m128i k512; // свёртка на 4 блока вперёд (low: x^576, high: x^512)
+            __m128i k128; // свёртка на 1 блок вперёд (low: x^192, high: x^128)
+
+            FoldConsts() noexcept
+            {
+                k512 = _mm_set_epi64x((long long)fold_const(512), (long long)fold_const(576));
+                k128 = _mm_set_epi64x((long long)fold_const(128), (long long)fold_const(192));
+            }
+        };
+
+        __attribute__((target("pclmul,sse2")))
+        inline __m128i fold( __m128i a, __m128i b, __m128i k ) noexcept
+        {
+            const __m128i lo = _mm_clmulepi64_si128(a, k, 0x00);
+            const __m128i hi = _mm_clmulepi64_si128(a, k, 0x11);
+            return _mm_xor_si128(b, _mm_xor_si128(lo, hi));
+        }
+        // -------------------------------------------------------------------------
+        __attribute__((target("pclmul,sse2")))
+        uint16_t crc_clmul( uint16_t crc, const uint8_t* p, size_t len ) noexcept
+        {
+            if( len < 64 )
+                return crc_slice16(crc, p, len);
+
+            static const FoldConsts fk;
+
+            // начальное значение "вносим" в первые два байта данных
+            __m128i x0 = _mm_loadu_si128((const __m128i*)p);
+            x0 = _mm_xor_si128(x0, _mm_cvtsi32_si128(crc));
+            __m128i x1 = _mm_loadu_si128((const __m128i*)(p + 16));
+            __m128i x2 = _mm_loadu_si128((const __m128i*)(p + 32));
+            __m128i x3 = _mm_loadu_si128((const __m128i*)(p + 48));
+            p += 64;
+            len -= 64;
+
+            for( ; len >= 64; len -= 64, p += 64 )
+            {
+                x0 = fold(x0, _mm_loadu_si128((const __m128i*)p), fk.k512);
+                x1 = fold(x1, _mm_loadu_si128((const __m128i*)(p + 16)), fk.k512);
+                x2 = fold(x2, _mm_loadu_si128((const __m128i*)(p + 32)), fk.k512);
+                x3 = fold(x3, _mm_loadu_si128((const __m128i*)(p + 48)), fk.k512);
+            }
+
+            x1 = fold(x0, x1, fk.k128);
+            x2 = fold(x1, x2, fk.k128);
+            x3 = fold(x2, x3, fk.k128);
+
+            for( ; len >= 16; len -= 16, p += 16 )
+                x3 = fold(x3, _mm_loadu_si128((const __m128i*)p), fk.k128);
+
+            uint8_t tmp[16];
+            _mm_storeu_si128((__m128i*)tmp, x3);
+            crc = crc_slice16(0, tmp, sizeof(tmp));
+            return crc_table(crc, p, len);
+        }
+        // -------------------------------------------------------------------------
+        bool clmul_supported() noexcept
+        {
+            static const bool supported = []
+            {
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse2");
+            }();
+
+            return supported;
+        }
+#endif
+        // -------------------------------------------------------------------------
+        typedef uint16_t (*CRCFunc)( uint16_t crc, const uint8_t* p, size_t len );
+
+        CRCFunc select_default() noexcept
+        {
+#ifdef CRC16_USE_CLMUL
+
+            if( clmul_supported() )
+                return crc_clmul;
+
+#endif
+            return crc_slice16;
+        }
+    }
+    // -------------------------------------------------------------------------
+    uint16_t CRC16::calc( const void* buf, size_t len, uint16_t crc ) noexcept
+    {
+        const uint8_t* p = (const uint8_t*)buf;
+
+        if( len < SMALL_BUFFER )
+            return crc_table(crc, p, len);
+
+        static const CRCFunc defaultFunc = select_default();
+        return defaultFunc(crc, p, len);
+    }
+    // -------------------------------------------------------------------------
+    uint16_t CRC16::calc( Impl impl, const void* buf, size_t len, uint16_t crc ) noexcept
+    {
+        const uint8_t* p = (const uint8_t*)buf;
+
+        switch( impl )
+        {
+            case Impl::Bitwise:
+                return crc_bitwise(crc, p, len);
+
+            case Impl::Table:
+                return crc_table(crc, p, len);
+
+            case Impl::Slice8:
+                return crc_slice8(crc, p, len);
+
+#ifdef CRC16_USE_CLMUL
+
+            case Impl::CLMUL:
+                if( clmul_supported() )
+                    return crc_clmul(crc, p, len);
+
+                break;
+#endif
+
+            default:
+                break;
+        }
+
+        return crc_slice16(crc, p, len);
+    }
+    // -------------------------------------------------------------------------
+    bool CRC16::isSupported( Impl impl ) noexcept
+    {
+        if( impl == Impl::CLMUL )
+        {
+#ifdef CRC16_USE_CLMUL
+            return clmul_supported();
+#else
+            return false;
+#endif
+        }
+
+        return true;
+    }
+    // -------------------------------------------------------------------------
+    CRC16::Impl CRC16::defaultImpl() noexcept
+    {
+        return isSupported(Impl::CLMUL) ? Impl::CLMUL : Impl::Slice16;
+    }
+    // -------------------------------------------------------------------------
+    std::string CRC16::implName( Impl impl )
+    {
+        switch( impl )
+        {
+            case Impl::Bitwise:
+                return "bitwise";
+
+            case Impl::Table:
+                return "table";
+
+            case Impl::Slice8:
+                return "slice8";
+
+            case Impl::Slice16:
+                return "slice16";
+
+            case Impl::CLMUL:
+                return "clmul";
+        }
+
+        return "unknown";
+    }
+    // -------------------------------------------------------------------------
+} // end of namespace uniset
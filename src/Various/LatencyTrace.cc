@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2025 Pavel Vainerman.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, version 2.1.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+// --------------------------------------------------------------------------
+#include <ctime>
+#include <cmath>
+#include <atomic>
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+#include "LatencyTrace.h"
+// --------------------------------------------------------------------------
+namespace uniset
+{
+    // --------------------------------------------------------------------------
+    namespace LatencyTrace
+    {
+        // каждое N-ое изменение (0 - отключено)
+        static std::atomic<uint32_t> period = { 0 };
+        static std::atomic<long> lnode = { -1 };
+        static std::atomic<size_t> nstarted = { 0 };
+
+        static thread_local uint32_t tl_current = 0;
+        static thread_local uint32_t tl_counter = 0;
+
+        struct AtomicHopStat
+        {
+            std::atomic<uint64_t> sum = { 0 };
+            std::atomic<uint32_t> max = { 0 };
+            std::atomic<size_t> buckets[NumBuckets];
+
+            AtomicHopStat() noexcept
+            {
+                for( auto&& b : buckets )
+                    b = 0;
+            }
+        };
+
+        static AtomicHopStat hops[HopCount];
+        // --------------------------------------------------------------------------
+        void setSampling( double percent ) noexcept
+        {
+            if( percent <= 0 )
+                period = 0;
+            else if( percent >= 100 )
+                period = 1;
+            else
+                period = (uint32_t)std::lround(100.0 / percent);
+        }
+        // --------------------------------------------------------------------------
+        double getSampling() noexcept
+        {
+            const uint32_t p = period.load(std::memory_order_relaxed);
+            return p == 0 ? 0 : 100.0 / p;
+        }
+        // --------------------------------------------------------------------------
+        bool enabled() noexcept
+        {
+            return period.load(std::memory_order_relaxed) != 0;
+        }
+        // --------------------------------------------------------------------------
+        uint32_t now() noexcept
+        {
+            struct timespec ts;
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            const uint32_t t = (uint32_t)((uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000);
+            return t == 0 ? 1 : t;
+        }
+        // --------------------------------------------------------------------------
+        uint32_t start() noexcept
+        {
+            const uint32_t p = period.load(std::memory_order_relaxed);
+
+            if( p == 0 || ++tl_counter < p )
+                return 0;
+
+            tl_counter = 0;
+            nstarted.fetch_add(1, std::memory_order_relaxed);
+            return now();
+        }
+        // --------------------------------------------------------------------------
+        void hop( Hop h, uint32_t stamp ) noexcept
+        {
+            if( stamp == 0 || h >= HopCount )
+                return;
+
+            const uint32_t lat = now() - stamp; // по модулю 2^32
+            const size_t b = lat == 0 ? 0 : 32 - __builtin_clz(lat);
+
+            auto& s = hops[h];
+            s.sum.fetch_add(lat, std::memory_order_relaxed);
+            s.buckets[b].fetch_add(1, std::memory_order_relaxed);
+
+            uint32_t m = s.max.load(std::memory_order_relaxed);
+
+            while( lat > m && !s.max.compare_exchange_weak(m, lat, std::memory_order_relaxed) ) {}
+        }
+        // --------------------------------------------------------------------------
+        uint32_t current() noexcept
+        {
+            return tl_current;
+        }
+        // --------------------------------------------------------------------------
+        uint32_t take() noexcept
+        {
+            const uint32_t stamp = tl_current;
+            tl_current = 0;
+            return stamp;
+        }
+        // --------------------------------------------------------------------------
+        Scope::Scope( uint32_t stamp ) noexcept:
+            prev(tl_current)
+        {
+            tl_current = stamp;
+        }
+        // --------------------------------------------------------------------------
+        Scope::~Scope() noexcept
+        {
+            tl_current = prev;
+        }
+        // --------------------------------------------------------------------------
+        void setLocalNode( long node ) noexcept
+        {
+            lnode = node;
+        }
+        // --------------------------------------------------------------------------
+        long localNode() noexcept
+        {
+            return lnode.load(std::memory_order_relaxed);
+        }
+        // --------------------------------------------------------------------------
+        double HopStat::avg() const noexcept
+        {
+            return count > 0 ? (double)sum / count : 0;
+        }
+        // --------------------------------------------------------------------------
+        uint32_t HopStat::percentile( double p ) const noexcept
+        {
+            if( count == 0 )
+                return 0;
+
+            const size_t need = std::max((size_t)std::ceil(p * count), (size_t)1);
+            size_t n = 0;
+
+            for( size_t b = 0; b < NumBuckets; b++ )
+            {
+                n += buckets[b];
+
+                if( n >= need )
+                {
+                    // верхняя граница корзины, но не больше максимума
+                    const uint64_t hi = b == 0 ? 0 : ((uint64_t)1 << b) - 1;
+                    return (uint32_t)std::min(hi, (uint64_t)max);
+                }
+            }
+
+            return max;
+        }
+        // --------------------------------------------------------------------------
+        HopStat stat( Hop h ) noexcept
+        {
+            HopStat ret;
+
+            if( h >= HopCount )
+                return ret;
+
+            const auto& s = hops[h];
+
+            for( size_t b = 0; b < NumBuckets; b++ )
+            {
+                ret.buckets[b] = s.buckets[b].load(std::memory_order_relaxed);
+                ret.count += ret.buckets[b];
+            }
+
+            ret.sum = s.sum.load(std::memory_order_relaxed);
+            ret.max = s.max.load(std::memory_order_relaxed);
+            return ret;
+        }
+        // --------------------------------------------------------------------------
+        size_t started() noexcept
+        {
+            return nstarted.load(std::memory_order_relaxed);
+        }
+        // --------------------------------------------------------------------------
+        void reset() noexcept
+        {
+            for( auto&& s : hops )
+            {
+                s.sum = 0;
+                s.max = 0;
+
+                for( auto&& b : s.buckets )
+                    b = 0;
+            }
+
+            nstarted = 0;
+        }
+        // --------------------------------------------------------------------------
+        std::string hopName( Hop h )
+        {
+            switch( h )
+            {
+                case Receive:
+                    return "receive";
+
+                case SetValue:
+                    return "setValue";
+
+                case Dispatch:
+                    return "dispatch";
+
+                case Dequeue:
+                    return "dequeue";
+
+                case Handled:
+                    return "handled";
+
+                default:
+                    break;
+            }
+
+            return "unknown";
+        }
+        // --------------------------------------------------------------------------
+        std::string report()
+        {
+            std::ostringstream s;
+            s << "latency trace: sampling=" << getSampling() << "%"
+              << " started=" << started() << std::endl;
+
+            s << std::setw(10) << std::left << "hop"
+              << std::setw(12) << std::right << "count"
+              << std::setw(12) << "avg"
+              << std::setw(12) << "p50"
+              << std::setw(12) << "p99"
+              << std::setw(12) << "max"
+              << "  (usec)" << std::endl;
+
+            for( size_t h = 0; h < HopCount; h++ )
+            {
+                const auto st = stat((Hop)h);
+                s << std::setw(10) << std::left << hopName((Hop)h)
+                  << std::setw(12) << std::right << st.count
+                  << std::setw(12) << std::fixed << std::setprecision(1) << st.avg()
+                  << std::setw(12) << st.percentile(0.5)
+                  << std::setw(12) << st.percentile(0.99)
+                  << std::setw(12) << st.max
+                  << std::endl;
+            }
+
+            return s.str();
+        }
+        // --------------------------------------------------------------------------
+#ifndef DISABLE_REST_API
+        Poco::JSON::Object::Ptr toJSON()
+        {
+            Poco::JSON::Object::Ptr j = new Poco::JSON::Object();
+            j->set("sampling", getSampling());
+            j->set("started", started());
+
+            Poco::JSON::Array::Ptr jhops = new Poco::JSON::Array();
+
+            for( size_t h = 0; h < HopCount; h++ )
+            {
+                const auto st = stat((Hop)h);
+
+                Poco::JSON::Object::Ptr jh = new Poco::JSON::Object();
+                jh->set("name", hopName((Hop)h));
+                jh->set("count", st.count);
+                jh->set("avg", st.avg());
+                jh->set("p50", st.percentile(0.5));
+                jh->set("p90", st.percentile(0.9));
+                jh->set("p99", st.percentile(0.99));
+                jh->set("max", st.max);
+
+                // гистограмма: верхняя граница корзины (мкс) -> количество (пустые не выводим)
+                Poco::JSON::Array::Ptr jb = new Poco::JSON::Array();
+
+                for( size_t b = 0; b < NumBuckets; b++ )
+                {
+                    if( st.buckets[b] == 0 )
+                        continue;
+
+                    Poco::JSON::Array::Ptr v = new Poco::JSON::Array();
+                    v->add(b == 0 ? (uint64_t)0 : ((uint64_t)1 << b) - 1);
+                    v->add(st.buckets[b]);
+                    jb->add(v);
+                }
+
+                jh->set("histogram", jb);
+                jhops->add(jh);
+            }
+
+            j->set("hops", jhops);
+            return j;
+        }
+#endif
+        // --------------------------------------------------------------------------
+    } // end of namespace LatencyTrace
+    // --------------------------------------------------------------------------
+} // end of namespace uniset
+// --------------------------------------------------------------------------
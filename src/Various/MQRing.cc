@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) 2025 Pavel Vainerman.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, version 2.1.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+// --------------------------------------------------------------------------
+#include <cstring>
+#include <thread>
+#include <algorithm>
+#include "MQRing.h"
+//--------------------------------------------------------------------------
+using namespace uniset;
+using namespace std;
+//--------------------------------------------------------------------------
+MQRing::MQRing( size_t qsize ):
+	SizeOfMessageQueue(qsize > 0 ? qsize : 1)
+{
+	mqAlloc();
+}
+//---------------------------------------------------------------------------
+MQRing::~MQRing()
+{
+}
+//---------------------------------------------------------------------------
+template<typename Fill>
+bool MQRing::enqueue( Fill&& fill ) noexcept
+{
+	if( !ring )
+		return enqueueLocked(std::forward<Fill>(fill));
+
+	size_t pos = tail.load(std::memory_order_relaxed);
+
+	while( true )
+	{
+		Slot& s = ring[pos % SizeOfMessageQueue];
+		const size_t seq = s.seq.load(std::memory_order_acquire);
+		const ssize_t dif = (ssize_t)seq - (ssize_t)pos;
+
+		if( dif == 0 )
+		{
+			// ячейка свободна, пробуем её занять
+			if( tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed) )
+			{
+				fill(s.item);
+				s.seq.store(pos + 1, std::memory_order_release);
+
+				// ведём статистику
+				// head читается после занятия позиции и мог уже "обогнать" её (читатель забрал сообщение),
+				// поэтому разница может быть отрицательной или больше размера очереди
+				ssize_t d = (ssize_t)(pos + 1 - head.load(std::memory_order_relaxed));
+				const size_t sz = std::min( (size_t)std::max(d, (ssize_t)0), SizeOfMessageQueue );
+
+				if( sz > stMaxQueueMessages.load(std::memory_order_relaxed) )
+					stMaxQueueMessages.store(sz, std::memory_order_relaxed);
+
+				return true;
+			}
+
+			// pos обновлён в compare_exchange
+			continue;
+		}
+
+		if( dif < 0 )
+		{
+			// ячейка ещё не освобождена читателем - очередь переполнена
+			if( lostStrategy == lostNewData )
+			{
+				stCountOfLostMessages.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+
+			// lostOldData: освобождаем место, удаляя самое старое сообщение
+			// (если не получилось, значит его как раз сейчас забирают - просто пробуем снова)
+			if( !dropOldest() )
+				std::this_thread::yield();
+		}
+
+		pos = tail.load(std::memory_order_relaxed);
+	}
+
+	return false;
+}
+//---------------------------------------------------------------------------
+template<typename Fill>
+bool MQRing::enqueueLocked( Fill&& fill ) noexcept
+{
+	try
+	{
+		std::lock_guard<std::mutex> lk(dqmutex);
+
+		if( dq.size() >= SizeOfMessageQueue )
+		{
+			stCountOfLostMessages.fetch_add(1, std::memory_order_relaxed);
+
+			if( lostStrategy == lostNewData )
+				return false;
+
+			dq.pop_front();
+		}
+
+		dq.emplace_back();
+		fill(dq.back());
+
+		if( dq.size() > stMaxQueueMessages.load(std::memory_order_relaxed) )
+			stMaxQueueMessages.store(dq.size(), std::memory_order_relaxed);
+
+		return true;
+	}
+	catch(...) {}
+
+	// не хватило памяти
+	stCountOfLostMessages.fetch_add(1, std::memory_order_relaxed);
+	return false;
+}
+//---------------------------------------------------------------------------
+bool MQRing::dropOldest() noexcept
+{
+	size_t pos = head.load(std::memory_order_relaxed);
+
+	// если читатель сейчас забирает сообщения (head уже сдвинут, а ячейки ещё не освобождены),
+	// то очередь не переполнена и удалять ничего не надо - надо просто подождать
+	if( tail.load(std::memory_order_relaxed) - pos < SizeOfMessageQueue )
+		return false;
+
+	Slot& s = ring[pos % SizeOfMessageQueue];
+
+	if( s.seq.load(std::memory_order_acquire) != pos + 1 )
+		return false;
+
+	if( !head.compare_exchange_strong(pos, pos + 1, std::memory_order_relaxed) )
+		return false;
+
+	s.item.ext.reset();
+	s.seq.store(pos + SizeOfMessageQueue, std::memory_order_release);
+	stCountOfLostMessages.fetch_add(1, std::memory_order_relaxed);
+	return true;
+}
+//---------------------------------------------------------------------------
+bool MQRing::push( const TransportMessage& tm ) noexcept
+{
+	static_assert(sizeof(VoidMessage) >= sizeof(uniset::RawDataOfTransportMessage), "VoidMessage less than TransportMessage");
+
+	return enqueue([&tm]( Item & it )
+	{
+		// то же что и VoidMessage(tm), но без создания временного объекта
+		memcpy(&it.raw, &tm.data, sizeof(tm.data));
+		reinterpret_cast<VoidMessage*>(&it.raw)->consumer = tm.consumer;
+	});
+}
+//---------------------------------------------------------------------------
+bool MQRing::push( const VoidMessagePtr& vm ) noexcept
+{
+	if( !vm )
+		return false;
+
+	return enqueue([&vm]( Item & it )
+	{
+		it.ext = vm;
+	});
+}
+//---------------------------------------------------------------------------
+size_t MQRing::pop( Item* buf, size_t num ) noexcept
+{
+	if( num == 0 )
+		return 0;
+
+	if( !ring )
+		return popLocked(buf, num);
+
+	size_t pos = head.load(std::memory_order_relaxed);
+	size_t n = 0;
+
+	while( true )
+	{
+		// смотрим сколько подряд ячеек готово к чтению
+		n = 0;
+
+		while( n < num && ring[(pos + n) % SizeOfMessageQueue].seq.load(std::memory_order_acquire) == pos + n + 1 )
+			n++;
+
+		if( n == 0 )
+			return 0;
+
+		// забираем их все сразу (конкурировать можем только с писателями, удаляющими старые сообщения)
+		if( head.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed) )
+			break;
+	}
+
+	for( size_t i = 0; i < n; i++ )
+	{
+		Slot& s = ring[(pos + i) % SizeOfMessageQueue];
+		buf[i].raw = s.item.raw;
+		buf[i].ext = std::move(s.item.ext);
+		s.seq.store(pos + i + SizeOfMessageQueue, std::memory_order_release);
+	}
+
+	return n;
+}
+//---------------------------------------------------------------------------
+size_t MQRing::popLocked( Item* buf, size_t num ) noexcept
+{
+	std::lock_guard<std::mutex> lk(dqmutex);
+
+	const size_t n = std::min(num, dq.size());
+
+	for( size_t i = 0; i < n; i++ )
+	{
+		buf[i].raw = dq[i].raw;
+		buf[i].ext = std::move(dq[i].ext);
+	}
+
+	dq.erase(dq.begin(), dq.begin() + n);
+	return n;
+}
+//---------------------------------------------------------------------------
+VoidMessagePtr MQRing::top() noexcept
+{
+	Item it;
+
+	if( pop(&it, 1) == 0 )
+		return nullptr;
+
+	if( it.ext )
+		return std::move(it.ext);
+
+	try
+	{
+		return std::make_shared<VoidMessage>(*it.get());
+	}
+	catch(...) {}
+
+	return nullptr;
+}
+//---------------------------------------------------------------------------
+size_t MQRing::size() const noexcept
+{
+	if( !ring )
+	{
+		std::lock_guard<std::mutex> lk(dqmutex);
+		return dq.size();
+	}
+
+	const size_t h = head.load(std::memory_order_relaxed);
+	const size_t t = tail.load(std::memory_order_relaxed);
+
+	if( t <= h )
+		return 0;
+
+	return std::min(t - h, SizeOfMessageQueue);
+}
+//---------------------------------------------------------------------------
+bool MQRing::empty() const noexcept
+{
+	return size() == 0;
+}
+//---------------------------------------------------------------------------
+void MQRing::setMaxSizeOfMessageQueue( size_t s )
+{
+	if( s == 0 )
+		s = 1;
+
+	if( s != SizeOfMessageQueue )
+	{
+		SizeOfMessageQueue = s;
+		mqAlloc();
+	}
+}
+//---------------------------------------------------------------------------
+size_t MQRing::getMaxSizeOfMessageQueue() const noexcept
+{
+	return SizeOfMessageQueue;
+}
+//---------------------------------------------------------------------------
+void MQRing::setLostStrategy( MQRing::LostStrategy s ) noexcept
+{
+	lostStrategy = s;
+}
+//---------------------------------------------------------------------------
+bool MQRing::isLockFree() const noexcept
+{
+	return ring != nullptr;
+}
+//---------------------------------------------------------------------------
+void MQRing::mqAlloc()
+{
+	head = 0;
+	tail = 0;
+
+	{
+		std::lock_guard<std::mutex> lk(dqmutex);
+		dq.clear();
+	}
+
+	// большой кольцевой буфер занимал бы память сразу целиком (даже если очередь пустая),
+	// поэтому в этом случае используем очередь, которая растёт по мере необходимости
+	if( SizeOfMessageQueue > MaxRingSize )
+	{
+		ring.reset();
+		return;
+	}
+
+	ring.reset( new Slot[SizeOfMessageQueue] );
+
+	for( size_t i = 0; i < SizeOfMessageQueue; i++ )
+		ring[i].seq.store(i, std::memory_order_relaxed);
+}
+//---------------------------------------------------------------------------
@@ -0,0 +1,83 @@
+// --------------------------------------------------------------------------
+// Замер скорости расчёта CRC-16 разными реализациями (см. CRC16.h)
+// на типичных размерах: кадр Modbus RTU, пакет UNet (заполненная часть и весь массив)
+// --------------------------------------------------------------------------
+#include <string>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include "UniSetTypes.h"
+#include "CRC16.h"
+// --------------------------------------------------------------------------
+using namespace std;
+using namespace uniset;
+// --------------------------------------------------------------------------
+// защита от "выбрасывания" вычислений оптимизатором
+static volatile uint16_t result = 0;
+// --------------------------------------------------------------------------
+static double one_test( CRC16::Impl impl, const std::vector<uint8_t>& buf, size_t count )
+{
+    auto start = std::chrono::steady_clock::now();
+    uint16_t crc = 0;
+
+    for( size_t i = 0; i < count; i++ )
+        crc ^= CRC16::calc(impl, buf.data(), buf.size());
+
+    auto end = std::chrono::steady_clock::now();
+    result = crc;
+
+    double usec = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    return usec > 0 ? (double)buf.size() * count / usec : 0; // MB/sec
+}
+// --------------------------------------------------------------------------
+int main( int argc, const char** argv )
+{
+    // суммарный объём данных на одну реализацию и размер (байт)
+    size_t total = uniset::getArgPInt("--total", argc, argv, "", 200 * 1024 * 1024);
+
+    // 8 - запрос Modbus RTU, 256 - максимальный кадр Modbus RTU,
+    // 1200 - 100 аналоговых датчиков UNet, 24000 - весь массив a_dat в UNet-пакете
+    const std::vector<size_t> sizes = { 8, 256, 1200, 24000 };
+
+    const std::vector<CRC16::Impl> impls =
+    {
+        CRC16::Impl::Bitwise,
+        CRC16::Impl::Table,
+        CRC16::Impl::Slice8,
+        CRC16::Impl::Slice16,
+        CRC16::Impl::CLMUL
+    };
+
+    cerr << "default implementation: " << CRC16::implName(CRC16::defaultImpl()) << endl;
+
+    for( auto&& sz : sizes )
+    {
+        std::vector<uint8_t> buf(sz);
+
+        for( size_t i = 0; i < sz; i++ )
+            buf[i] = i * 31 + 7;
+
+        size_t count = std::max(total / sz, (size_t)1);
+
+        cerr << "size " << sz << " bytes:" << endl;
+
+        for( auto&& impl : impls )
+        {
+            if( !CRC16::isSupported(impl) )
+            {
+                cerr << "    " << setw(8) << CRC16::implName(impl) << ": not supported" << endl;
+                continue;
+            }
+
+            // побитовый вариант очень медленный, уменьшаем объём
+            size_t n = (impl == CRC16::Impl::Bitwise) ? std::max(count / 20, (size_t)1) : count;
+
+            cerr << "    " << setw(8) << CRC16::implName(impl) << ": "
+                 << setw(10) << fixed << setprecision(1) << one_test(impl, buf, n) << " MB/sec" << endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,98 @@
+// --------------------------------------------------------------------------
+// Замер "стоимости" вызова логирования в рабочем потоке:
+// выключенный уровень (<< и ublog), обычный текстовый вывод и бинарный режим (см. DebugBinLog.h)
+// --------------------------------------------------------------------------
+#include <string>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include "UniSetTypes.h"
+#include "DebugStream.h"
+// --------------------------------------------------------------------------
+using namespace std;
+using namespace uniset;
+// --------------------------------------------------------------------------
+static size_t received = 0;
+
+static void on_log( const std::string& txt )
+{
+    received += txt.size();
+}
+// --------------------------------------------------------------------------
+template<typename Func>
+static double one_test( const std::string& name, size_t count, Func&& f )
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for( size_t i = 0; i < count; i++ )
+        f(i);
+
+    auto end = std::chrono::steady_clock::now();
+    double nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    cout << setw(25) << std::left << name << ": " << setw(10) << std::right << std::fixed << std::setprecision(1)
+         << nsec / count << " ns/call" << endl;
+
+    return nsec;
+}
+// --------------------------------------------------------------------------
+int main( int argc, const char** argv )
+{
+    size_t count = uniset::getArgPInt("--count", argc, argv, "", 100000);
+    size_t bufsize = uniset::getArgPInt("--buffer-size", argc, argv, "", 16 * 1024 * 1024);
+
+    // чтобы на время замера не влияли потери, буфер берём с запасом
+    BinLog::setThreadBufferSize(bufsize);
+
+    DebugStream log;
+    log.setLogName("perf");
+    log.disableOnScreen();
+    log.signal_stream_event().connect(&on_log);
+    log.level(Debug::INFO);
+
+    const std::string sname("Sensor1_S");
+    const double value = 42.5;
+
+    one_test("disabled <<", count, [&]( size_t i )
+    {
+        if( log.debugging(Debug::LEVEL3) )
+            log.level3() << "(step): sensor " << sname << " id=" << i << " value=" << value << endl;
+    });
+
+    one_test("disabled ublog", count, [&]( size_t i )
+    {
+        ublog((&log), LEVEL3, "(step): sensor {} id={} value={}", sname, i, value);
+    });
+
+    one_test("text <<", count, [&]( size_t i )
+    {
+        log.info() << "(step): sensor " << sname << " id=" << i << " value=" << value << endl;
+    });
+
+    one_test("text ublog", count, [&]( size_t i )
+    {
+        ublog((&log), INFO, "(step): sensor {} id={} value={}", sname, i, value);
+    });
+
+    log.binaryMode(true);
+
+    one_test("binary ublog", count, [&]( size_t i )
+    {
+        ublog((&log), INFO, "(step): sensor {} id={} value={}", sname, i, value);
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    bool ok = BinLog::flush(60000);
+    auto end = std::chrono::steady_clock::now();
+
+    cout << setw(25) << std::left << "binary flush" << ": "
+         << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " msec"
+         << ( ok ? "" : " (timeout)" ) << endl;
+
+    cout << "written: " << BinLog::writtenRecords()
+         << " lost: " << BinLog::lostRecords()
+         << " received: " << received << " bytes" << endl;
+
+    return 0;
+}
+// --------------------------------------------------------------------------
@@ -0,0 +1,181 @@
+// --------------------------------------------------------------------------
+// Замер пропускной способности (кадров в секунду) приёма/обработки запросов
+// в ModbusTCPSession. Клиент отправляет запросы "пачками" (pipelining),
+// не дожидаясь ответа на каждый, и читает ответы.
+// Используется локальное TCP-соединение (127.0.0.1), т.к. ModbusTCPSession
+// требует peerAddress() у сокета.
+// --------------------------------------------------------------------------
+#include <string>
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <cstring>
+#include <ev++.h>
+#include <Poco/Net/ServerSocket.h>
+#include <Poco/Net/StreamSocket.h>
+#include "UniSetTypes.h"
+#include "Exceptions.h"
+#include "modbus/ModbusTCPSession.h"
+// --------------------------------------------------------------------------
+using namespace std;
+using namespace uniset;
+using namespace ModbusRTU;
+// --------------------------------------------------------------------------
+static const ModbusAddr slaveaddr = 0x01;
+static const ModbusData regCount = 10;
+static std::atomic_bool finished = { false };
+// --------------------------------------------------------------------------
+static mbErrCode readOutputRegisters( const ReadOutputMessage& query, ReadOutputRetMessage& reply )
+{
+    for( size_t i = 0; i < query.count; i++ )
+        reply.addData( query.start + i );
+
+    return erNoError;
+}
+// --------------------------------------------------------------------------
+// поток клиента: возвращает количество полученных ответов
+static void client_thread( Poco::Net::StreamSocket sock, size_t count, size_t depth, size_t* result )
+{
+    // готовим "пачку" запросов
+    std::vector<uint8_t> batch;
+
+    for( size_t i = 0; i < depth; i++ )
+    {
+        ReadOutputMessage q(slaveaddr, 0, regCount);
+        ModbusMessage msg = q.transport_msg();
+        msg.makeMBAPHeader(i + 1, true, 0);
+        size_t len = msg.len();
+        msg.swapHead();
+        batch.insert(batch.end(), msg.buf(), msg.buf() + len);
+    }
+
+    // MBAP(6) + addr(1) + func(1) + bcnt(1) + data
+    const size_t replyLen = sizeof(MBAPHeader) + 3 + regCount * sizeof(ModbusData);
+    std::vector<uint8_t> rbuf(replyLen * depth);
+    size_t replies = 0;
+
+    try
+    {
+        while( replies < count )
+        {
+            sock.sendBytes(batch.data(), batch.size());
+
+            size_t need = replyLen * depth;
+            size_t got = 0;
+
+            while( got < need )
+            {
+                int n = sock.receiveBytes(rbuf.data() + got, need - got);
+
+                if( n <= 0 )
+                {
+                    cerr << "(mbtcp-perf-test): connection closed.." << endl;
+                    *result = replies;
+                    finished = true;
+                    return;
+                }
+
+                got += n;
+            }
+
+            replies += depth;
+        }
+    }
+    catch( const std::exception& ex )
+    {
+        cerr << "(mbtcp-perf-test): client: " << ex.what() << endl;
+    }
+
+    *result = replies;
+    finished = true;
+}
+// --------------------------------------------------------------------------
+static void onTimer( ev::timer& t, int revents )
+{
+    if( finished )
+        t.loop.break_loop(ev::ALL);
+}
+// --------------------------------------------------------------------------
+static double one_test( size_t count, size_t depth )
+{
+    Poco::Net::ServerSocket srv(Poco::Net::SocketAddress("127.0.0.1", 0));
+    Poco::Net::StreamSocket client;
+    client.connect(srv.address());
+    client.setNoDelay(true);
+
+    Poco::Net::StreamSocket ss = srv.acceptConnection();
+    ss.setNoDelay(true);
+
+    std::unordered_set<ModbusAddr> vaddr = { slaveaddr };
+    auto sess = make_shared<ModbusTCPSession>(ss, vaddr, 5000);
+    sess->connectReadOutput( sigc::ptr_fun(&readOutputRegisters) );
+    sess->setSessionTimeout(0);
+
+    ev::dynamic_loop loop;
+    ev::timer tm(loop);
+    tm.set<&onTimer>();
+    tm.start(0.05, 0.05);
+
+    sess->run(loop);
+
+    finished = false;
+    size_t replies = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    std::thread cthr(client_thread, client, count, depth, &replies);
+
+    loop.run();
+
+    cthr.join();
+    auto end = std::chrono::steady_clock::now();
+
+    tm.stop();
+    sess->terminate();
+    client.close();
+
+    double sec = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000000.0;
+    return sec > 0 ? replies / sec : 0;
+}
+// --------------------------------------------------------------------------
+int main( int argc, const char** argv )
+{
+    try
+    {
+        size_t count = uniset::getArgPInt("--count", argc, argv, "", 200000);
+        int tnum = uniset::getArgPInt("--tests", argc, argv, "", 5);
+        std::vector<size_t> depths = { 1, 8, 32 };
+
+        for( auto&& depth : depths )
+        {
+            double sum = 0;
+
+            for( int i = 0; i < tnum; i++ )
+                sum += one_test(count, depth);
+
+            std::cerr << "pipeline depth " << depth << ": average "
+                      << (size_t)(sum / tnum) << " frames/sec [" << tnum << " tests, " << count << " frames]" << endl;
+        }
+
+        return 0;
+    }
+    catch( const uniset::SystemError& err )
+    {
+        cerr << "(mbtcp-perf-test): " << err << endl;
+    }
+    catch( const uniset::Exception& ex )
+    {
+        cerr << "(mbtcp-perf-test): " << ex << endl;
+    }
+    catch( const std::exception& e )
+    {
+        cerr << "(mbtcp-perf-test): " << e.what() << endl;
+    }
+    catch(...)
+    {
+        cerr << "(mbtcp-perf-test): catch(...)" << endl;
+    }
+
+    return 1;
+}
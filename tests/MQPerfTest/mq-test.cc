@@ -1,56 +1,215 @@
 #include <string>
 #include <iostream>
+#include <iomanip>
 #include <assert.h>
 #include <thread>
 #include <atomic>
+#include <vector>
 #include "Configuration.h"
 #include "Exceptions.h"
 #include "MQAtomic.h"
 #include "MQMutex.h"
+#include "MQRing.h"
 // --------------------------------------------------------------------------
 using namespace std;
 using namespace uniset;
 // --------------------------------------------------------------------------
-MQAtomic mq; // тестируемая очередь
+// Сравнение очередей сообщений MQMutex, MQAtomic и MQRing
+// в режиме "много писателей - один читатель" (как в UniSetObject).
+// Для MQMutex и MQAtomic на каждое сообщение создаётся VoidMessagePtr (как это делалось в UniSetObject::push),
+// в MQRing сообщение копируется в очередь, а читатель забирает сообщения пачками.
+// --------------------------------------------------------------------------
+static size_t COUNT = 1000000; // сколько сообщений поместить в очередь (всего)
+static size_t WRITERS = 1; // количество пишущих потоков (0 - писать и читать в одном потоке)
+static size_t QSIZE = 10000; // размер очереди
+static size_t BATCH = 100; // размер пачки для MQRing
+// --------------------------------------------------------------------------
+// "адаптеры" для единообразной работы с очередями
+// (писатель ждёт освобождения места, чтобы не терять сообщения)
+static void mq_push( MQMutex& mq, const TransportMessage& tm )
+{
+    while( mq.size() >= mq.getMaxSizeOfMessageQueue() )
+        std::this_thread::yield();
+
+    mq.push( make_shared<VoidMessage>(tm) );
+}
+
+static void mq_push( MQAtomic& mq, const TransportMessage& tm )
+{
+    while( mq.size() >= mq.getMaxSizeOfMessageQueue() )
+        std::this_thread::yield();
+
+    mq.push( make_shared<VoidMessage>(tm) );
+}
+
+static void mq_push( MQRing& mq, const TransportMessage& tm )
+{
+    while( !mq.push(tm) )
+        std::this_thread::yield();
+}
+
+static size_t mq_read( MQMutex& mq )
+{
+    auto m = mq.top();
+    return m ? 1 : 0;
+}
+
+static size_t mq_read( MQAtomic& mq )
+{
+    auto m = mq.top();
+    return m ? 1 : 0;
+}
+
+static size_t mq_read( MQRing& mq )
+{
+    static std::vector<MQRing::Item> buf(BATCH);
+    return mq.pop(buf.data(), buf.size());
+}
+
+static size_t mq_lost( MQRing& )
+{
+    // писатели ждут освобождения места (неудачный push() не считаем потерей)
+    return 0;
+}
 
-const size_t COUNT = 1000000; // сколько сообщений поместить в очередь
+template<typename MQ>
+static size_t mq_lost( MQ& mq )
+{
+    return mq.getCountOfLostMessages();
+}
 // --------------------------------------------------------------------------
-// поток записи
-void mq_write_thread()
+// запись и чтение в одном потоке (порциями по половине очереди):
+// "чистая" стоимость операций, без влияния планировщика
+template<typename MQ>
+static int one_test_nothreads( MQ& mq, size_t& lost )
 {
     SensorMessage smsg(100, 2);
     TransportMessage tm( smsg.transport_msg() );
-    auto vm = make_shared<VoidMessage>(tm);
+    const size_t portion = std::max(QSIZE / 2, (size_t)1);
 
-    msleep(100);
+    auto tstart = std::chrono::steady_clock::now();
+    size_t rnum = 0;
 
-    for( size_t i = 0; i < COUNT; i++ )
+    for( size_t i = 0; i < COUNT; i += portion )
     {
-        mq.push(vm);
+        const size_t num = std::min(portion, COUNT - i);
+
+        for( size_t k = 0; k < num; k++ )
+            mq_push(mq, tm);
+
+        size_t n = 0;
+
+        while( (n = mq_read(mq)) > 0 )
+            rnum += n;
     }
+
+    auto tend = std::chrono::steady_clock::now();
+    lost += (COUNT - std::min(COUNT, rnum));
+    return std::chrono::duration_cast<std::chrono::milliseconds>(tend - tstart).count();
 }
 // --------------------------------------------------------------------------
-int one_test()
+template<typename MQ>
+static int one_test( MQ& mq, size_t& lost )
 {
-    auto wthread = std::thread(mq_write_thread);
+    if( WRITERS == 0 )
+        return one_test_nothreads(mq, lost);
+
+    std::vector<std::thread> writers;
+    std::atomic_bool start = { false };
+    const size_t wcount = COUNT / WRITERS;
 
-    std::chrono::time_point<std::chrono::system_clock> start, end;
-    start = std::chrono::system_clock::now();
+    for( size_t w = 0; w < WRITERS; w++ )
+    {
+        writers.emplace_back([&mq, &start, wcount, w]
+        {
+            SensorMessage smsg(100 + w, 2);
+            TransportMessage tm( smsg.transport_msg() );
+
+            while( !start )
+                std::this_thread::yield();
+
+            for( size_t i = 0; i < wcount; i++ )
+                mq_push(mq, tm);
+        });
+    }
+
+    const size_t total = wcount * WRITERS;
+    const size_t lost0 = mq_lost(mq);
+
+    std::chrono::time_point<std::chrono::steady_clock> tstart, tend;
+    tstart = std::chrono::steady_clock::now();
+    start = true;
 
     size_t rnum = 0;
+    size_t idle = 0;
+    auto tidle = tstart;
 
-    while( rnum < COUNT )
+    // при нескольких писателях MQMutex и MQAtomic могут (редко) терять сообщения
+    // поэтому учитываем потери и на всякий случай не ждём бесконечно
+    while( rnum + (mq_lost(mq) - lost0) < total )
     {
-        auto m = mq.top();
+        size_t n = mq_read(mq);
+
+        if( n > 0 )
+        {
+            rnum += n;
+            idle = 0;
+            continue;
+        }
+
+        if( idle++ == 0 )
+            tidle = std::chrono::steady_clock::now();
+        else if( (idle % 1000) == 0 && std::chrono::steady_clock::now() - tidle > std::chrono::seconds(2) )
+            break;
+    }
+
+    for( auto&& t : writers )
+        t.join();
+
+    // дочитываем остатки (если вышли по таймауту)
+    while( mq_read(mq) > 0 ) {}
+
+    tend = std::chrono::steady_clock::now();
+    lost += (total - std::min(total, rnum));
+    return std::chrono::duration_cast<std::chrono::milliseconds>(tend - tstart).count();
+}
+// --------------------------------------------------------------------------
+template<typename MQ>
+static void run_test( const std::string& name, MQ& mq, int tnum )
+{
+    mq.setMaxSizeOfMessageQueue(QSIZE);
 
-        if( m )
-            rnum++;
+    // сперва просто проверка что очередь работает.
+    {
+        SensorMessage sm(100, 2);
+        TransportMessage tm( sm.transport_msg() );
+        mq_push(mq, tm);
+        assert( mq_read(mq) == 1 );
     }
 
-    wthread.join();
+    vector<int> res;
+    res.reserve(tnum);
+    size_t lost = 0;
+
+    for( int i = 0; i < tnum; i++ )
+        res.push_back(one_test(mq, lost));
+
+    // вычисляем среднее
+    int sum = 0;
+
+    for( auto&& r : res )
+        sum += r;
+
+    float avg = (float)sum / tnum;
+
+    std::cerr << setw(10) << std::left << name
+              << " average elapsed time [" << tnum << "]: " << setw(8) << std::right << avg << " msec for " << COUNT
+              << " (" << setprecision(3) << (avg > 0 ? (COUNT / avg / 1000.0) : 0) << " Mmsg/sec)";
 
-    end = std::chrono::system_clock::now();
-    return std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    if( lost > 0 )
+        std::cerr << " lost: " << lost;
+
+    std::cerr << endl;
 }
 // --------------------------------------------------------------------------
 int main(int argc, const char** argv)
@@ -59,40 +218,32 @@ int main(int argc, const char** argv)
     {
         uniset_init(argc, argv);
 
-        int tnum = 10;
+        int tnum = uniset::getArgPInt("--tests", argc, argv, "", 10);
+        COUNT = std::max(uniset::getArgPInt("--count", argc, argv, "", COUNT), 1);
+        WRITERS = std::max(uniset::getArgPInt("--writers", argc, argv, "", WRITERS), 0);
+        QSIZE = std::max(uniset::getArgPInt("--qsize", argc, argv, "", QSIZE), 1);
+        BATCH = std::max(uniset::getArgPInt("--batch", argc, argv, "", BATCH), 1);
+
+        if( WRITERS > 0 && COUNT < WRITERS )
+            COUNT = WRITERS;
 
-        // чтобы не происходило переполнение
-        mq.setMaxSizeOfMessageQueue(COUNT + 1);
+        std::cerr << "writers=" << WRITERS << " qsize=" << QSIZE << " batch(MQRing)=" << BATCH << endl;
 
-        // сперва просто проверка что очередь работает.
         {
-            SensorMessage sm(100, 2);
-            TransportMessage tm( sm.transport_msg() );
-            auto vm = make_shared<VoidMessage>(tm);
-            mq.push(vm);
-            auto msg = mq.top();
-            assert( msg != nullptr );
-            SensorMessage sm2( msg.get() );
-            assert( sm.id == sm2.id );
+            MQMutex mq;
+            run_test("MQMutex", mq, tnum);
         }
 
-        vector<int> res;
-        res.reserve(tnum);
-
-        for( int i = 0; i < tnum; i++ )
         {
-            res.push_back(one_test());
+            MQAtomic mq;
+            run_test("MQAtomic", mq, tnum);
         }
 
-        // вычисляем среднее
-        int sum = 0;
-
-        for( auto&& r : res )
-            sum += r;
-
-        float avg = (float)sum / tnum;
-
-        std::cerr << "average elapsed time [" << tnum << "]: " << avg << " msec for " << COUNT << endl;
+        {
+            MQRing mq;
+            mq.setLostStrategy(MQRing::lostNewData);
+            run_test("MQRing", mq, tnum);
+        }
 
         return 0;
     }
@@ -0,0 +1,176 @@
+#include <string>
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include "Configuration.h"
+#include "Exceptions.h"
+#include "PassiveTimer.h"
+#include "MQRing.h"
+// --------------------------------------------------------------------------
+using namespace std;
+using namespace uniset;
+// --------------------------------------------------------------------------
+// Сравнение схем ожидания потока обработки сообщений UniSetObject:
+// - "thread": PassiveCondTimer (condition_variable), как по умолчанию;
+// - "evloop": PassiveEpollTimer (eventfd + timerfd + epoll), см. UniSetObject::setEventLoopMode().
+// Писатель помещает сообщения в очередь пачками (burst) и "будит" читателя (terminate()),
+// как это делает UniSetObject::push(). Читатель работает по схеме UniSetObject::callback().
+// Измеряется: пропускная способность, количество пробуждений на сообщение,
+// задержка "push -> обработка" (p50/p99/max) и точность ожидания таймера.
+// --------------------------------------------------------------------------
+static size_t COUNT = 200000; // сколько сообщений всего
+static size_t BURST = 50; // размер пачки от писателя
+static size_t PAUSE_USEC = 200; // пауза между пачками
+static size_t BATCH = 100; // размер пачки для чтения
+static timeout_t TIMER_MSEC = 5; // интервал для проверки точности таймера
+static size_t TIMER_COUNT = 200; // сколько раз проверять таймер
+// --------------------------------------------------------------------------
+static inline long now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+// --------------------------------------------------------------------------
+static long percentile( std::vector<long>& v, double p )
+{
+    if( v.empty() )
+        return 0;
+
+    size_t k = std::min(v.size() - 1, (size_t)(p * v.size()));
+    std::nth_element(v.begin(), v.begin() + k, v.end());
+    return v[k];
+}
+// --------------------------------------------------------------------------
+template<typename Timer>
+static void run_test( const std::string& name )
+{
+    Timer tmr;
+    MQRing mq(10000);
+    mq.setLostStrategy(MQRing::lostNewData);
+
+    std::atomic_bool active = { true };
+    std::vector<long> lat;
+    lat.reserve(COUNT);
+    size_t wakeups = 0;
+
+    // читатель (аналог UniSetObject::callback)
+    std::thread reader([&]
+    {
+        std::vector<MQRing::Item> buf(BATCH);
+
+        auto process = [&]()
+        {
+            size_t n = mq.pop(buf.data(), buf.size());
+            const long t = now_ns();
+
+            for( size_t i = 0; i < n; i++ )
+            {
+                const SensorMessage* sm = reinterpret_cast<const SensorMessage*>(buf[i].get());
+                lat.push_back(t - sm->value);
+            }
+
+            return n;
+        };
+
+        while( active || !mq.empty() )
+        {
+            if( process() > 0 )
+                continue;
+
+            tmr.wait(1000);
+            wakeups++;
+        }
+    });
+
+    SensorMessage sm(100, 0);
+    auto tstart = std::chrono::steady_clock::now();
+
+    for( size_t i = 0; i < COUNT; i += BURST )
+    {
+        const size_t num = std::min(BURST, COUNT - i);
+
+        for( size_t k = 0; k < num; k++ )
+        {
+            sm.value = now_ns();
+
+            while( !mq.push(sm.transport_msg()) )
+                std::this_thread::yield();
+
+            tmr.terminate();
+        }
+
+        if( PAUSE_USEC > 0 )
+            std::this_thread::sleep_for(std::chrono::microseconds(PAUSE_USEC));
+    }
+
+    active = false;
+    tmr.terminate();
+    reader.join();
+
+    auto tend = std::chrono::steady_clock::now();
+    const long msec = std::chrono::duration_cast<std::chrono::milliseconds>(tend - tstart).count();
+
+    // точность ожидания таймера (сообщений нет)
+    std::vector<long> late;
+    late.reserve(TIMER_COUNT);
+
+    for( size_t i = 0; i < TIMER_COUNT; i++ )
+    {
+        const long t0 = now_ns();
+        tmr.wait(TIMER_MSEC);
+        late.push_back( (now_ns() - t0) - (long)TIMER_MSEC * 1000000 );
+    }
+
+    std::cerr << setw(8) << std::left << name
+              << " " << setw(6) << std::right << msec << " msec"
+              << " wakeups/msg=" << setprecision(3) << (lat.empty() ? 0.0 : (double)wakeups / lat.size())
+              << " latency(usec) p50=" << percentile(lat, 0.5) / 1000
+              << " p99=" << percentile(lat, 0.99) / 1000
+              << " max=" << (lat.empty() ? 0 : *std::max_element(lat.begin(), lat.end()) / 1000)
+              << " | timer(" << TIMER_MSEC << "ms) late(usec) p50=" << percentile(late, 0.5) / 1000
+              << " p99=" << percentile(late, 0.99) / 1000
+              << endl;
+}
+// --------------------------------------------------------------------------
+int main(int argc, const char** argv)
+{
+    try
+    {
+        uniset_init(argc, argv);
+
+        COUNT = std::max(uniset::getArgPInt("--count", argc, argv, "", COUNT), 1);
+        BURST = std::max(uniset::getArgPInt("--burst", argc, argv, "", BURST), 1);
+        PAUSE_USEC = std::max(uniset::getArgPInt("--pause-usec", argc, argv, "", PAUSE_USEC), 0);
+        BATCH = std::max(uniset::getArgPInt("--batch", argc, argv, "", BATCH), 1);
+        TIMER_MSEC = std::max(uniset::getArgPInt("--timer-msec", argc, argv, "", TIMER_MSEC), 1);
+        TIMER_COUNT = std::max(uniset::getArgPInt("--timer-count", argc, argv, "", TIMER_COUNT), 1);
+
+        std::cerr << "count=" << COUNT << " burst=" << BURST << " pause=" << PAUSE_USEC << "usec"
+                  << " batch=" << BATCH << endl;
+
+        run_test<PassiveCondTimer>("thread");
+        run_test<PassiveEpollTimer>("evloop");
+        return 0;
+    }
+    catch( const uniset::SystemError& err )
+    {
+        cerr << "(uobj-wait-test): " << err << endl;
+    }
+    catch( const uniset::Exception& ex )
+    {
+        cerr << "(uobj-wait-test): " << ex << endl;
+    }
+    catch( const std::exception& e )
+    {
+        cerr << "(uobj-wait-test): " << e.what() << endl;
+    }
+    catch(...)
+    {
+        cerr << "(uobj-wait-test): catch(...)" << endl;
+    }
+
+    return 1;
+}
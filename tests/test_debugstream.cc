@@ -1,6 +1,11 @@
 #include <catch.hpp>
 // -----------------------------------------------------------------------------
 #include <sstream>
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <memory>
+#include <chrono>
 #include "DebugStream.h"
 // -----------------------------------------------------------------------------
 using namespace std;
@@ -151,3 +156,186 @@ TEST_CASE("Debugstream: labels", "[debugstream][labels]" )
 
 }
 // -----------------------------------------------------------------------------
+TEST_CASE("Debugstream: blog", "[debugstream][blog]" )
+{
+    DebugStream d(Debug::INFO);
+    d.showDateTime(false);
+    d.showLogType(false);
+    d.disableOnScreen();
+    d.signal_stream_event().connect( &test_log_buffer );
+
+    test_log_str.str(""); // clean
+    const std::string s("str");
+    ublog((&d), INFO, "int={} uint={} double={} bool={} char={} cstr={} str={}", -10, 20u, 1.5, true, 'c', "cstr", s);
+    REQUIRE( test_log_str.str() == "int=-10 uint=20 double=1.5 bool=1 char=c cstr=cstr str=str\n" );
+
+    // не хватает аргументов или наоборот лишние
+    test_log_str.str(""); // clean
+    d.blog(Debug::INFO, "a={} b={}", 1);
+    d.blog(Debug::INFO, "a={}", 1, 2);
+    REQUIRE( test_log_str.str() == "a=1 b={}\na=1 2\n" );
+
+    // выключенный уровень
+    test_log_str.str(""); // clean
+    ublog((&d), LEVEL3, "text {}", 1);
+    d.blog(Debug::WARN, "text {}", 2);
+    REQUIRE( test_log_str.str() == "" );
+}
+// -----------------------------------------------------------------------------
+static std::mutex bin_log_mutex;
+static ostringstream bin_log_str;
+
+void bin_log_buffer( const std::string& txt )
+{
+    std::lock_guard<std::mutex> l(bin_log_mutex);
+    bin_log_str << txt;
+}
+
+static std::string bin_log()
+{
+    std::lock_guard<std::mutex> l(bin_log_mutex);
+    return bin_log_str.str();
+}
+
+TEST_CASE("Debugstream: binary mode", "[debugstream][blog][binary]" )
+{
+    DebugStream d(Debug::INFO);
+    d.showDateTime(false);
+    d.showLogType(false);
+    d.disableOnScreen();
+    d.binaryMode(true);
+    REQUIRE( d.isBinaryMode() );
+    d.signal_stream_event().connect( &bin_log_buffer );
+
+    // строки копируются, поэтому после вызова их можно менять
+    std::string s("str1");
+    ublog((&d), INFO, "value={} s={}", 10, s);
+    s = "changed";
+
+    // в вызывающем потоке вывода нет
+    const size_t written = uniset::BinLog::writtenRecords();
+    REQUIRE( written > 0 );
+
+    REQUIRE( uniset::BinLog::flush() );
+    REQUIRE( bin_log() == "value=10 s=str1\n" );
+
+    // запись из нескольких потоков
+    std::vector<std::thread> thr;
+
+    for( size_t t = 0; t < 4; t++ )
+    {
+        thr.emplace_back([&d, t]
+        {
+            for( size_t i = 0; i < 100; i++ )
+                ublog((&d), INFO, "thread{} rec{}", t, i);
+        });
+    }
+
+    for( auto&& t : thr )
+        t.join();
+
+    REQUIRE( uniset::BinLog::flush() );
+
+    const std::string txt = bin_log();
+
+    for( size_t t = 0; t < 4; t++ )
+    {
+        REQUIRE( txt.find("thread" + std::to_string(t) + " rec0\n") != std::string::npos );
+        REQUIRE( txt.find("thread" + std::to_string(t) + " rec99\n") != std::string::npos );
+    }
+
+    // обычный вывод продолжает работать
+    d.info() << "text" << endl;
+    REQUIRE( bin_log().find("text\n") != std::string::npos );
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("Debugstream: binary mode overflow", "[debugstream][blog][binary]" )
+{
+    DebugStream d(Debug::INFO);
+    d.showDateTime(false);
+    d.showLogType(false);
+    d.disableOnScreen();
+    d.binaryMode(true);
+    d.signal_stream_event().connect( &bin_log_buffer );
+
+    {
+        std::lock_guard<std::mutex> l(bin_log_mutex);
+        bin_log_str.str("");
+    }
+
+    // маленький буфер и редкий опрос, чтобы фоновый поток не успевал
+    uniset::BinLog::setThreadBufferSize(4096);
+    uniset::BinLog::setPollTime(1000);
+    const size_t lost = uniset::BinLog::lostRecords();
+
+    std::thread t([&d]
+    {
+        for( size_t i = 0; i < 10000; i++ )
+            ublog((&d), INFO, "rec{}", i);
+
+        // следующая после потерь запись выводится вместе с сообщением о потерях
+        uniset::BinLog::flush();
+        ublog((&d), INFO, "last");
+    });
+
+    t.join();
+
+    uniset::BinLog::setThreadBufferSize(64 * 1024);
+    uniset::BinLog::setPollTime(10);
+
+    REQUIRE( uniset::BinLog::flush() );
+    REQUIRE( uniset::BinLog::lostRecords() > lost );
+    REQUIRE( bin_log().find("(BinLog): lost ") != std::string::npos );
+    REQUIRE( bin_log().find("last\n") != std::string::npos );
+}
+// -----------------------------------------------------------------------------
+TEST_CASE("Debugstream: binary mode, log deleted with pending records", "[debugstream][blog][binary]" )
+{
+    {
+        std::lock_guard<std::mutex> l(bin_log_mutex);
+        bin_log_str.str("");
+    }
+
+    // редкий опрос, чтобы записи остались в буфере к моменту удаления лога
+    uniset::BinLog::setPollTime(1000);
+    const size_t discarded = uniset::BinLog::discardedRecords();
+
+    auto d = std::make_unique<DebugStream>(Debug::INFO);
+    d->showDateTime(false);
+    d->showLogType(false);
+    d->disableOnScreen();
+    d->binaryMode(true);
+    d->signal_stream_event().connect( &bin_log_buffer );
+
+    for( size_t i = 0; i < 10; i++ )
+        ublog(d, INFO, "deleted{}", i);
+
+    // деструктор выводит уже записанное (не дожидаясь очередного опроса буферов)
+    auto t0 = std::chrono::steady_clock::now();
+    d.reset();
+    auto msec = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count();
+    REQUIRE( msec < 500 );
+
+    uniset::BinLog::setPollTime(10);
+
+    const std::string txt = bin_log();
+    size_t printed = 0;
+
+    for( size_t pos = txt.find("deleted"); pos != std::string::npos; pos = txt.find("deleted", pos + 1) )
+        printed++;
+
+    REQUIRE( printed == 10 );
+    REQUIRE( txt.find("deleted9") != std::string::npos );
+    REQUIRE( uniset::BinLog::discardedRecords() == discarded );
+
+    // новый лог (возможно по тому же адресу) чужие записи не получает
+    DebugStream d2(Debug::INFO);
+    d2.disableOnScreen();
+    d2.binaryMode(true);
+    d2.signal_stream_event().connect( &bin_log_buffer );
+    ublog((&d2), INFO, "new log");
+    REQUIRE( uniset::BinLog::flush() );
+    REQUIRE( bin_log().find("new log") != std::string::npos );
+    REQUIRE( uniset::BinLog::discardedRecords() == discarded );
+}
+// -----------------------------------------------------------------------------
@@ -0,0 +1,87 @@
+#include <catch.hpp>
+// --------------------------------------------------------------------------
+#include <vector>
+#include "IdLookupTable.h"
+// --------------------------------------------------------------------------
+using namespace std;
+using namespace uniset;
+// --------------------------------------------------------------------------
+TEST_CASE("IdLookupTable: dense", "[IdLookupTable]" )
+{
+    IdLookupTable<long> t;
+    REQUIRE( t.empty() );
+    REQUIRE( t.find(1).empty() );
+
+    for( long i = 0; i < 100; i++ )
+        t.add(1000 + i, i);
+
+    t.build();
+    REQUIRE( t.isBuilt() );
+    REQUIRE( t.isDense() );
+    REQUIRE( t.size() == 100 );
+
+    for( long i = 0; i < 100; i++ )
+    {
+        auto r = t.find(1000 + i);
+        REQUIRE( r.size() == 1 );
+        REQUIRE( *r.begin() == i );
+        REQUIRE( *t.get(1000 + i) == i );
+    }
+
+    REQUIRE( t.find(999).empty() );
+    REQUIRE( t.find(1100).empty() );
+    REQUIRE( t.find(-1).empty() );
+    REQUIRE( t.get(5000) == nullptr );
+}
+// --------------------------------------------------------------------------
+TEST_CASE("IdLookupTable: sparse", "[IdLookupTable]" )
+{
+    IdLookupTable<long> t;
+
+    // "разреженные" id (поиск двоичным поиском)
+    const vector<ObjectId> ids = { 100000000, 5, 70000, -1, 300000000 };
+
+    for( size_t i = 0; i < ids.size(); i++ )
+        t.add(ids[i], i);
+
+    t.build();
+    REQUIRE_FALSE( t.isDense() );
+
+    for( size_t i = 0; i < ids.size(); i++ )
+    {
+        REQUIRE( t.get(ids[i]) != nullptr );
+        REQUIRE( *t.get(ids[i]) == (long)i );
+    }
+
+    REQUIRE( t.get(6) == nullptr );
+    REQUIRE( t.get(0) == nullptr );
+    REQUIRE( t.get(400000000) == nullptr );
+}
+// --------------------------------------------------------------------------
+TEST_CASE("IdLookupTable: duplicates", "[IdLookupTable]" )
+{
+    // один датчик может быть привязан к нескольким переменным
+    for( size_t factor : { 8, 0 } )
+    {
+        IdLookupTable<long> t;
+        t.add(10, 1);
+        t.add(20, 2);
+        t.add(10, 3);
+        t.add(15, 4);
+        t.add(10, 5);
+        t.build(factor);
+        REQUIRE( t.isDense() == (factor > 0) );
+
+        auto r = t.find(10);
+        REQUIRE( r.size() == 3 );
+
+        // порядок добавления сохраняется
+        vector<long> v(r.begin(), r.end());
+        REQUIRE( v == vector<long>({1, 3, 5}) );
+        REQUIRE( *t.get(10) == 1 );
+        REQUIRE( *t.get(15) == 4 );
+        REQUIRE( *t.get(20) == 2 );
+        REQUIRE( t.find(11).empty() );
+    }
+}
+// --------------------------------------------------------------------------
@@ -0,0 +1,130 @@
+#include <catch.hpp>
+// ---------------------------------------------------------------
+#include <thread>
+#include <chrono>
+#include "LatencyTrace.h"
+// ---------------------------------------------------------------
+using namespace std;
+using namespace uniset;
+// ---------------------------------------------------------------
+TEST_CASE("[LatencyTrace]: sampling", "[latency]")
+{
+    LatencyTrace::reset();
+
+    LatencyTrace::setSampling(0);
+    REQUIRE_FALSE( LatencyTrace::enabled() );
+
+    for( size_t i = 0; i < 100; i++ )
+        REQUIRE( LatencyTrace::start() == 0 );
+
+    REQUIRE( LatencyTrace::started() == 0 );
+
+    LatencyTrace::setSampling(10);
+    REQUIRE( LatencyTrace::enabled() );
+    REQUIRE( LatencyTrace::getSampling() == Approx(10) );
+
+    size_t n = 0;
+
+    for( size_t i = 0; i < 100; i++ )
+    {
+        if( LatencyTrace::start() != 0 )
+            n++;
+    }
+
+    REQUIRE( n == 10 );
+    REQUIRE( LatencyTrace::started() == 10 );
+
+    LatencyTrace::setSampling(100);
+    REQUIRE( LatencyTrace::start() != 0 );
+    REQUIRE( LatencyTrace::start() != 0 );
+
+    LatencyTrace::setSampling(0);
+    LatencyTrace::reset();
+    REQUIRE( LatencyTrace::started() == 0 );
+}
+// ---------------------------------------------------------------
+TEST_CASE("[LatencyTrace]: hops", "[latency]")
+{
+    LatencyTrace::reset();
+
+    // нулевая метка не учитывается
+    LatencyTrace::hop(LatencyTrace::SetValue, 0);
+    REQUIRE( LatencyTrace::stat(LatencyTrace::SetValue).count == 0 );
+
+    const uint32_t t = LatencyTrace::now();
+    REQUIRE( t != 0 );
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    for( size_t i = 0; i < 10; i++ )
+        LatencyTrace::hop(LatencyTrace::Dispatch, t);
+
+    auto st = LatencyTrace::stat(LatencyTrace::Dispatch);
+    REQUIRE( st.count == 10 );
+    REQUIRE( st.max >= 5000 );
+    REQUIRE( st.avg() >= 5000 );
+    REQUIRE( st.avg() <= st.max );
+    REQUIRE( st.percentile(0.5) >= 4096 );
+    REQUIRE( st.percentile(0.99) <= st.max );
+
+    // другие точки не затронуты
+    REQUIRE( LatencyTrace::stat(LatencyTrace::Receive).count == 0 );
+    REQUIRE( LatencyTrace::stat(LatencyTrace::Handled).count == 0 );
+
+    REQUIRE_FALSE( LatencyTrace::report().empty() );
+
+    LatencyTrace::reset();
+    st = LatencyTrace::stat(LatencyTrace::Dispatch);
+    REQUIRE( st.count == 0 );
+    REQUIRE( st.max == 0 );
+    REQUIRE( st.percentile(0.5) == 0 );
+}
+// ---------------------------------------------------------------
+TEST_CASE("[LatencyTrace]: percentile", "[latency]")
+{
+    LatencyTrace::HopStat st;
+    st.buckets[3] = 90; // 4..7 мкс
+    st.buckets[10] = 10; // 512..1023 мкс
+    st.count = 100;
+    st.max = 700;
+
+    REQUIRE( st.percentile(0.5) == 7 );
+    REQUIRE( st.percentile(0.9) == 7 );
+    REQUIRE( st.percentile(0.95) == 700 ); // не больше max
+}
+// ---------------------------------------------------------------
+TEST_CASE("[LatencyTrace]: scope", "[latency]")
+{
+    REQUIRE( LatencyTrace::current() == 0 );
+
+    {
+        LatencyTrace::Scope s1(100);
+        REQUIRE( LatencyTrace::current() == 100 );
+
+        {
+            LatencyTrace::Scope s2(200);
+            REQUIRE( LatencyTrace::current() == 200 );
+
+            // метка не переходит в другой поток
+            uint32_t other = 1;
+            std::thread th([&other] { other = LatencyTrace::current(); });
+            th.join();
+            REQUIRE( other == 0 );
+        }
+
+        REQUIRE( LatencyTrace::current() == 100 );
+    }
+
+    REQUIRE( LatencyTrace::current() == 0 );
+
+    {
+        // метка "забирается" первым значением
+        LatencyTrace::Scope s1(300);
+        REQUIRE( LatencyTrace::take() == 300 );
+        REQUIRE( LatencyTrace::current() == 0 );
+        REQUIRE( LatencyTrace::take() == 0 );
+    }
+
+    REQUIRE( LatencyTrace::current() == 0 );
+}
+// ---------------------------------------------------------------
@@ -0,0 +1,199 @@
+#include <catch.hpp>
+// ---------------------------------------------------------------
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include "LogRing.h"
+// ---------------------------------------------------------------
+using namespace std;
+using namespace uniset;
+// ---------------------------------------------------------------
+static std::string readAll( LogRing& r, LogRing::Cursor& c )
+{
+    std::string ret;
+    LogRing::Slice sl[16];
+
+    while( true )
+    {
+        size_t n = r.read(c, sl, 16);
+
+        if( n == 0 )
+            break;
+
+        size_t sz = 0;
+
+        for( size_t i = 0; i < n; i++ )
+        {
+            ret.append(sl[i].data + (i == 0 ? c.offset : 0), sl[i].len - (i == 0 ? c.offset : 0));
+            sz += sl[i].len - (i == 0 ? c.offset : 0);
+        }
+
+        LogRing::advance(c, sl, n, sz);
+    }
+
+    return ret;
+}
+// ---------------------------------------------------------------
+TEST_CASE("LogRing: read", "[LogRing]" )
+{
+    LogRing r(4096);
+    REQUIRE( r.capacity() == 4096 );
+
+    // записи до создания курсора не видны
+    r.push("old\n");
+
+    auto c = r.cursor();
+    REQUIRE( r.pending(c) == 0 );
+
+    r.push("msg1\n");
+    r.push(std::string("msg2\n"));
+    r.push("", 0); // пустые записи не добавляются
+    REQUIRE( r.pending(c) == 2 );
+    REQUIRE( r.minRecordSize() == 4 );
+    REQUIRE( r.maxRecordSize() == 5 );
+
+    LogRing::Slice sl[8];
+    REQUIRE( r.read(c, sl, 8) == 2 );
+    REQUIRE( std::string(sl[0].data, sl[0].len) == "msg1\n" );
+    REQUIRE( std::string(sl[1].data, sl[1].len) == "msg2\n" );
+
+    // часть первой записи "отправлена"
+    LogRing::advance(c, sl, 2, 3);
+    REQUIRE( c.offset == 3 );
+    REQUIRE( r.pending(c) == 2 );
+
+    // ещё 4 байта: первая запись целиком и 2 байта второй
+    REQUIRE( r.read(c, sl, 8) == 2 );
+    LogRing::advance(c, sl, 2, 4);
+    REQUIRE( c.offset == 2 );
+    REQUIRE( r.pending(c) == 1 );
+
+    REQUIRE( r.read(c, sl, 8) == 1 );
+    REQUIRE( std::string(sl[0].data + c.offset, sl[0].len - c.offset) == "g2\n" );
+    LogRing::advance(c, sl, 1, 3);
+    REQUIRE( c.offset == 0 );
+    REQUIRE( r.pending(c) == 0 );
+    REQUIRE( r.read(c, sl, 8) == 0 );
+    REQUIRE( r.sync(c) == 0 );
+}
+// ---------------------------------------------------------------
+TEST_CASE("LogRing: wrap and lost records", "[LogRing]" )
+{
+    LogRing r(4096);
+    auto c1 = r.cursor();
+    auto c2 = r.cursor();
+
+    // c1 читает всё, c2 "отстаёт"
+    std::string expected;
+
+    for( size_t i = 0; i < 1000; i++ )
+    {
+        std::string s = "record " + std::to_string(i) + "\n";
+        r.push(s);
+        expected += s;
+
+        if( i % 10 == 0 )
+        {
+            REQUIRE( r.sync(c1) == 0 );
+            std::string ret = readAll(r, c1);
+            REQUIRE( ret == expected );
+            expected.clear();
+        }
+    }
+
+    REQUIRE( r.sync(c1) == 0 );
+    REQUIRE( readAll(r, c1) == expected );
+
+    // у "отстающего" часть записей затёрта
+    size_t lost = r.sync(c2);
+    REQUIRE( lost > 0 );
+    REQUIRE( r.pending(c2) == 1000 - lost );
+
+    std::string ret = readAll(r, c2);
+    REQUIRE( ret.find("record " + std::to_string(lost) + "\n") == 0 );
+    REQUIRE( ret.rfind("record 999\n") == ret.size() - 11 );
+    REQUIRE( r.pending(c2) == 0 );
+}
+// ---------------------------------------------------------------
+TEST_CASE("LogRing: long record", "[LogRing]" )
+{
+    LogRing r(4096);
+    auto c = r.cursor();
+
+    // слишком длинная запись обрезается до capacity()/4
+    r.push(std::string(10000, 'x'));
+    LogRing::Slice sl[2];
+    REQUIRE( r.read(c, sl, 2) == 1 );
+    REQUIRE( sl[0].len < r.capacity() / 4 );
+    REQUIRE( sl[0].len > 0 );
+}
+// ---------------------------------------------------------------
+TEST_CASE("LogRing: writer thread", "[LogRing]" )
+{
+    LogRing r(8192);
+    auto c = r.cursor();
+    const size_t num = 200000;
+    std::atomic_bool finished = { false };
+
+    std::thread writer([&]
+    {
+        for( size_t i = 0; i < num; i++ )
+            r.push(std::to_string(i) + ";");
+
+        finished = true;
+    });
+
+    size_t received = 0;
+    size_t lost = 0;
+    long last = -1;
+    bool ordered = true;
+    LogRing::Slice sl[32];
+
+    while( true )
+    {
+        bool done = finished;
+        lost += r.sync(c);
+        size_t n = r.read(c, sl, 32);
+
+        if( n == 0 )
+        {
+            if( done )
+                break;
+
+            continue;
+        }
+
+        std::vector<std::string> recs;
+
+        for( size_t i = 0; i < n; i++ )
+            recs.emplace_back(sl[i].data, sl[i].len);
+
+        const uint64_t start = sl[0].pos;
+        LogRing::advance(c, sl, n, 1 << 30);
+
+        // данные затёрты во время чтения - не учитываем
+        if( !r.valid(start) )
+            continue;
+
+        for( const auto& s : recs )
+        {
+            long v = std::stol(s);
+
+            if( v <= last )
+                ordered = false;
+
+            last = v;
+            received++;
+        }
+    }
+
+    writer.join();
+
+    REQUIRE( ordered );
+    REQUIRE( received > 0 );
+    // записи, затёртые во время чтения, не учитываются ни там, ни там
+    REQUIRE( received + lost <= num );
+    REQUIRE( last == (long)(num - 1) );
+}
+// ---------------------------------------------------------------
@@ -0,0 +1,287 @@
+#include <catch.hpp>
+// --------------------------------------------------------------------------
+#include <thread>
+#include <vector>
+#include "MQRing.h"
+#include "MessageType.h"
+#include "Configuration.h"
+// --------------------------------------------------------------------------
+using namespace std;
+using namespace uniset;
+// --------------------------------------------------------------------------
+static bool pushMessage( MQRing& mq, long id )
+{
+    SensorMessage sm(id, id);
+    sm.consumer = id; // чтобы хоть как-то идентифицировать сообщений, используем поле consumer
+    return mq.push( sm.transport_msg() );
+}
+// --------------------------------------------------------------------------
+TEST_CASE( "MQRing: setup", "[mqueue][mqring]" )
+{
+    MQRing mq;
+
+    mq.setMaxSizeOfMessageQueue(10);
+    REQUIRE( mq.getMaxSizeOfMessageQueue() == 10 );
+    REQUIRE( mq.empty() );
+    REQUIRE( mq.size() == 0 );
+}
+// --------------------------------------------------------------------------
+TEST_CASE( "MQRing: simple push/top", "[mqueue][mqring]" )
+{
+    REQUIRE( uniset_conf() != nullptr );
+
+    MQRing mq;
+
+    REQUIRE( pushMessage(mq, 100) );
+    REQUIRE( mq.size() == 1 );
+
+    auto msg = mq.top();
+    REQUIRE( msg != nullptr );
+    REQUIRE( msg->consumer == 100 );
+    REQUIRE( msg->type == Message::SensorInfo );
+
+    SensorMessage sm(msg.get());
+    REQUIRE( sm.id == 100 );
+    REQUIRE( sm.value == 100 );
+
+    REQUIRE( mq.top() == nullptr );
+    REQUIRE( mq.empty() );
+}
+// --------------------------------------------------------------------------
+TEST_CASE( "MQRing: pointer messages", "[mqueue][mqring]" )
+{
+    REQUIRE( uniset_conf() != nullptr );
+
+    MQRing mq;
+
+    REQUIRE( pushMessage(mq, 100) );
+
+    // текстовое сообщение не помещается в TransportMessage и хранится "по указателю"
+    uniset::ProducerInfo pi;
+    pi.id = 10;
+    pi.node = 0;
+    uniset::Timespec ts;
+    ts.sec = 0;
+    ts.nsec = 0;
+    TextMessage txt("hello", 1, ts, pi);
+    auto vm = txt.toLocalVoidMessage();
+    REQUIRE( mq.push(vm) );
+
+    REQUIRE( pushMessage(mq, 110) );
+
+    // порядок сохраняется
+    MQRing::Item items[5];
+    REQUIRE( mq.pop(items, 5) == 3 );
+    REQUIRE( items[0].get()->consumer == 100 );
+    REQUIRE( items[1].get() == vm.get() );
+    REQUIRE( items[1].get()->type == Message::TextMessage );
+    REQUIRE( reinterpret_cast<const TextMessage*>(items[1].get())->txt == "hello" );
+    REQUIRE( items[2].get()->consumer == 110 );
+    REQUIRE( items[2].ext == nullptr );
+}
+// --------------------------------------------------------------------------
+TEST_CASE( "MQRing: batch pop", "[mqueue][mqring]" )
+{
+    REQUIRE( uniset_conf() != nullptr );
+
+    MQRing mq(10);
+
+    for( long i = 0; i < 7; i++ )
+        REQUIRE( pushMessage(mq, 100 + i) );
+
+    MQRing::Item items[4];
+    REQUIRE( mq.pop(items, 4) == 4 );
+
+    for( long i = 0; i < 4; i++ )
+        REQUIRE( items[i].get()->consumer == 100 + i );
+
+    REQUIRE( mq.size() == 3 );
+    REQUIRE( mq.pop(items, 4) == 3 );
+
+    for( long i = 0; i < 3; i++ )
+        REQUIRE( items[i].get()->consumer == 104 + i );
+
+    REQUIRE( mq.pop(items, 4) == 0 );
+    REQUIRE( mq.getMaxQueueMessages() == 7 );
+
+    // переход через "конец" буфера
+    for( long i = 0; i < 8; i++ )
+        REQUIRE( pushMessage(mq, 200 + i) );
+
+    REQUIRE( mq.pop(items, 4) == 4 );
+    REQUIRE( items[0].get()->consumer == 200 );
+    REQUIRE( mq.pop(items, 4) == 4 );
+    REQUIRE( items[3].get()->consumer == 207 );
+}
+// --------------------------------------------------------------------------
+TEST_CASE( "MQRing: overflow (lost old data)", "[mqueue][mqring]" )
+{
+    REQUIRE( uniset_conf() != nullptr );
+
+    MQRing mq;
+    mq.setMaxSizeOfMessageQueue(2);
+    mq.setLostStrategy( MQRing::lostOldData );
+
+    REQUIRE( pushMessage(mq, 100) );
+    REQUIRE( pushMessage(mq, 110) );
+    REQUIRE( pushMessage(mq, 120) );
+    REQUIRE( mq.size() == 2 );
+
+    auto msg = mq.top();
+    REQUIRE( msg != nullptr );
+    REQUIRE( msg->consumer == 110 );
+
+    msg = mq.top();
+    REQUIRE( msg != nullptr );
+    REQUIRE( msg->consumer == 120 );
+
+    REQUIRE( mq.top() == nullptr );
+    REQUIRE( mq.getCountOfLostMessages() == 1 );
+}
+// --------------------------------------------------------------------------
+TEST_CASE( "MQRing: overflow (lost new data)", "[mqueue][mqring]" )
+{
+    REQUIRE( uniset_conf() != nullptr );
+
+    MQRing mq;
+    mq.setMaxSizeOfMessageQueue(2);
+    mq.setLostStrategy( MQRing::lostNewData );
+
+    REQUIRE( pushMessage(mq, 100) );
+    REQUIRE( pushMessage(mq, 110) );
+    REQUIRE_FALSE( pushMessage(mq, 120) );
+    REQUIRE_FALSE( pushMessage(mq, 130) );
+    REQUIRE( mq.size() == 2 );
+    REQUIRE( mq.getCountOfLostMessages() == 2 );
+
+    auto msg = mq.top();
+    REQUIRE( msg != nullptr );
+    REQUIRE( msg->consumer == 100 );
+
+    msg = mq.top();
+    REQUIRE( msg != nullptr );
+    REQUIRE( msg->consumer == 110 );
+
+    REQUIRE( mq.top() == nullptr );
+
+    // место освободилось
+    REQUIRE( pushMessage(mq, 140) );
+    msg = mq.top();
+    REQUIRE( msg != nullptr );
+    REQUIRE( msg->consumer == 140 );
+}
+// --------------------------------------------------------------------------
+TEST_CASE( "MQRing: large queue (std::deque)", "[mqueue][mqring]" )
+{
+    REQUIRE( uniset_conf() != nullptr );
+
+    MQRing mq(10);
+    REQUIRE( mq.isLockFree() );
+
+    // кольцевой буфер такого размера не создаётся
+    const size_t qsize = MQRing::MaxRingSize + 1;
+    mq.setMaxSizeOfMessageQueue(qsize);
+    REQUIRE_FALSE( mq.isLockFree() );
+    REQUIRE( mq.getMaxSizeOfMessageQueue() == qsize );
+    REQUIRE( mq.empty() );
+
+    for( long i = 0; i < 7; i++ )
+        REQUIRE( pushMessage(mq, 100 + i) );
+
+    REQUIRE( mq.size() == 7 );
+
+    MQRing::Item items[4];
+    REQUIRE( mq.pop(items, 4) == 4 );
+
+    for( long i = 0; i < 4; i++ )
+        REQUIRE( items[i].get()->consumer == 100 + i );
+
+    auto msg = mq.top();
+    REQUIRE( msg != nullptr );
+    REQUIRE( msg->consumer == 104 );
+    REQUIRE( mq.pop(items, 4) == 2 );
+    REQUIRE( mq.empty() );
+    REQUIRE( mq.getMaxQueueMessages() == 7 );
+
+    // переполнение
+    for( size_t i = 0; i < qsize; i++ )
+        REQUIRE( pushMessage(mq, 1) );
+
+    mq.setLostStrategy( MQRing::lostNewData );
+    REQUIRE_FALSE( pushMessage(mq, 200) );
+    REQUIRE( mq.getCountOfLostMessages() == 1 );
+
+    mq.setLostStrategy( MQRing::lostOldData );
+    REQUIRE( pushMessage(mq, 300) );
+    REQUIRE( mq.getCountOfLostMessages() == 2 );
+    REQUIRE( mq.size() == qsize );
+    REQUIRE( mq.getMaxQueueMessages() == qsize );
+
+    // обратно на кольцевой буфер
+    mq.setMaxSizeOfMessageQueue(10);
+    REQUIRE( mq.isLockFree() );
+    REQUIRE( mq.empty() );
+}
+// --------------------------------------------------------------------------
+TEST_CASE( "MQRing: many writers", "[mqueue][mqring]" )
+{
+    REQUIRE( uniset_conf() != nullptr );
+
+    const size_t nwriters = 4;
+    const size_t count = 50000;
+
+    MQRing mq(100);
+    mq.setLostStrategy( MQRing::lostNewData );
+
+    std::vector<std::thread> writers;
+
+    for( size_t w = 0; w < nwriters; w++ )
+    {
+        writers.emplace_back([&mq, w, count]
+        {
+            SensorMessage sm(w, 0);
+
+            for( size_t i = 0; i < count; i++ )
+            {
+                sm.value = i;
+                auto tm = sm.transport_msg();
+
+                // ждём пока освободится место
+                while( !mq.push(tm) )
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    // от каждого писателя сообщения должны приходить по порядку, без потерь
+    std::vector<long> last(nwriters, -1);
+    MQRing::Item items[64];
+    size_t total = 0;
+
+    while( total < nwriters * count )
+    {
+        size_t n = mq.pop(items, 64);
+
+        for( size_t i = 0; i < n; i++ )
+        {
+            const SensorMessage* sm = reinterpret_cast<const SensorMessage*>(items[i].get());
+            REQUIRE( sm->id < (long)nwriters );
+            REQUIRE( sm->value == last[sm->id] + 1 );
+            last[sm->id] = sm->value;
+        }
+
+        total += n;
+    }
+
+    for( auto&& t : writers )
+        t.join();
+
+    REQUIRE( mq.empty() );
+
+    for( auto&& l : last )
+        REQUIRE( l == (long)count - 1 );
+
+    // статистика не может превышать размер очереди (читатель работал параллельно с писателями)
+    REQUIRE( mq.getMaxQueueMessages() <= mq.getMaxSizeOfMessageQueue() );
+}
+// --------------------------------------------------------------------------
@@ -0,0 +1,98 @@
+#include <catch.hpp>
+
+#include <unistd.h>
+#include "PassiveTimer.h"
+#include "UniSetTypes.h"
+using namespace std;
+using namespace uniset;
+// --------------------------------------------------------------------------
+TEST_CASE("PassiveEpollTimer: wait", "[PassiveTimer][PassiveEpollTimer]" )
+{
+    PassiveEpollTimer tmr;
+
+    PassiveTimer ptTime;
+    REQUIRE( tmr.wait(300) );
+    REQUIRE( ptTime.getCurrent() >= 300 );
+    REQUIRE( ptTime.getCurrent() <= 340 );
+
+    // точность не привязана к UniSetTimer::MinQuantityTime
+    ptTime.reset();
+    tmr.wait(2);
+    REQUIRE( ptTime.getCurrent() >= 2 );
+    REQUIRE( ptTime.getCurrent() < 10 );
+
+    ptTime.reset();
+    tmr.wait(0);
+    REQUIRE( ptTime.getCurrent() < 10 );
+}
+// --------------------------------------------------------------------------
+TEST_CASE("PassiveEpollTimer: waitup", "[PassiveTimer][PassiveEpollTimer]" )
+{
+    PassiveEpollTimer tmr;
+
+    std::thread thr([&tmr]
+    {
+        msleep(500);
+        tmr.terminate();
+    });
+
+    PassiveTimer ptTime;
+    tmr.wait(UniSetTimer::WaitUpTime);
+
+    REQUIRE( ptTime.getCurrent() >= 500 );
+    REQUIRE( ptTime.getCurrent() <= 540 );
+    thr.join();
+}
+// --------------------------------------------------------------------------
+TEST_CASE("PassiveEpollTimer: terminate before wait", "[PassiveTimer][PassiveEpollTimer]" )
+{
+    PassiveEpollTimer tmr;
+
+    // серия "звонков" склеивается в один
+    for( int i = 0; i < 10; i++ )
+        tmr.terminate();
+
+    REQUIRE( tmr.getDoorbells() == 1 );
+
+    // "звонок" не теряется
+    PassiveTimer ptTime;
+    tmr.wait(300);
+    REQUIRE( ptTime.getCurrent() < 100 );
+    REQUIRE( tmr.getWakeups() == 1 );
+
+    // и сбрасывается
+    ptTime.reset();
+    tmr.wait(50);
+    REQUIRE( ptTime.getCurrent() >= 50 );
+    REQUIRE( tmr.getWakeups() == 1 );
+}
+// --------------------------------------------------------------------------
+TEST_CASE("PassiveEpollTimer: fd events", "[PassiveTimer][PassiveEpollTimer]" )
+{
+    PassiveEpollTimer tmr;
+
+    int fds[2];
+    REQUIRE( pipe(fds) == 0 );
+    REQUIRE( tmr.addFd(fds[0]) );
+
+    tmr.wait(0);
+    REQUIRE( tmr.fdEvents().empty() );
+
+    char c = 'x';
+    REQUIRE( write(fds[1], &c, 1) == 1 );
+
+    PassiveTimer ptTime;
+    tmr.wait(300);
+    REQUIRE( ptTime.getCurrent() < 100 );
+    REQUIRE( tmr.fdEvents().size() == 1 );
+    REQUIRE( tmr.fdEvents()[0].fd == fds[0] );
+    REQUIRE( (tmr.fdEvents()[0].events & EPOLLIN) );
+
+    REQUIRE( tmr.removeFd(fds[0]) );
+    tmr.wait(0);
+    REQUIRE( tmr.fdEvents().empty() );
+
+    close(fds[0]);
+    close(fds[1]);
+}
+// --------------------------------------------------------------------------